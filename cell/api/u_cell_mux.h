@@ -59,6 +59,42 @@ extern "C" {
 # define U_CELL_MUX_MAX_CHANNELS 4
 #endif
 
+#ifndef U_CELL_MUX_TX_WEIGHT_DEFAULT
+/** The default transmit weight of a multiplexer channel, see
+ * uCellMuxSetTxWeight().
+ */
+# define U_CELL_MUX_TX_WEIGHT_DEFAULT 1
+#endif
+
+#ifndef U_CELL_MUX_TX_WEIGHT_AT
+/** The default transmit weight of the AT channel, see
+ * uCellMuxSetTxWeight().
+ */
+# define U_CELL_MUX_TX_WEIGHT_AT 2
+#endif
+
+#ifndef U_CELL_MUX_TX_WEIGHT_GNSS
+/** The default transmit weight of the GNSS channel, see
+ * uCellMuxSetTxWeight().
+ */
+# define U_CELL_MUX_TX_WEIGHT_GNSS 2
+#endif
+
+/** Transmit statistics for a multiplexer channel, see
+ * uCellMuxGetTxStatistics().
+ */
+typedef struct {
+    size_t queueLengthFrames;    /**< the number of frames waiting to be sent. */
+    size_t queueLengthMaxFrames; /**< the largest that queueLengthFrames has been. */
+    size_t numFrames;            /**< the number of frames sent. */
+    size_t numInformationBytes;  /**< the number of information-field bytes sent,
+                                      i.e. user data. */
+    int32_t latencyAverageMs;    /**< the average time from a frame being queued
+                                      to it having been sent. */
+    int32_t latencyMaxMs;        /**< the longest time from a frame being queued
+                                      to it having been sent. */
+} uCellMuxTxStatistics_t;
+
 /* ----------------------------------------------------------------
  * FUNCTIONS:  WORKAROUND FOR LINKER ISSUE
  * -------------------------------------------------------------- */
@@ -208,6 +244,43 @@ int32_t uCellMuxAddChannel(uDeviceHandle_t cellHandle,
 uDeviceSerial_t *pUCellMuxChannelGetDeviceSerial(uDeviceHandle_t cellHandle,
                                                  int32_t channel);
 
+/** Set the transmit weight of a multiplexer channel.  When more than
+ * one channel has data to send, frames are sent from the channels
+ * in turn, each channel being allowed to send up to its weight in
+ * maximum-length frames (or, equivalently, more shorter ones) on each
+ * turn; e.g. while a PPP channel of weight 1 is busy, a channel of
+ * weight 2 can have up to twice the throughput and an AT command
+ * need wait behind no more than one maximum-length frame of PPP
+ * data, rather than behind the whole of a PPP write.  Control frames are
+ * always sent first.  The weight is set to #U_CELL_MUX_TX_WEIGHT_AT
+ * for the AT channel, #U_CELL_MUX_TX_WEIGHT_GNSS for the GNSS
+ * channel or otherwise #U_CELL_MUX_TX_WEIGHT_DEFAULT when the channel
+ * is opened.
+ *
+ * @param cellHandle  the handle of the cellular instance.
+ * @param channel     the channel number, which must be open;
+ *                    #U_CELL_MUX_CHANNEL_ID_GNSS may be used.
+ * @param weight      the weight, must be at least 1.
+ * @return            zero on success or negative error code on
+ *                    failure.
+ */
+int32_t uCellMuxSetTxWeight(uDeviceHandle_t cellHandle, int32_t channel,
+                            int32_t weight);
+
+/** Get the transmit statistics of a multiplexer channel; the
+ * statistics are reset when the channel is opened.
+ *
+ * @param cellHandle        the handle of the cellular instance.
+ * @param channel           the channel number, which must be open;
+ *                          #U_CELL_MUX_CHANNEL_ID_GNSS may be used.
+ * @param[out] pStatistics  a place to put the statistics, cannot
+ *                          be NULL.
+ * @return                  zero on success or negative error code
+ *                          on failure.
+ */
+int32_t uCellMuxGetTxStatistics(uDeviceHandle_t cellHandle, int32_t channel,
+                                uCellMuxTxStatistics_t *pStatistics);
+
 /** Remove a multiplexer channel.  Note that this does NOT free
  * memory to ensure thread safety; memory is free'd when the cellular
  * instance is closed (or see uCellMuxFree()).
@@ -227,29 +227,13 @@ int32_t uCellFileRead(uDeviceHandle_t cellHandle,
             // Read the size
             indicatedReadSize = uAtClientReadInt(atHandle);
             readSize = indicatedReadSize;
-            if (readSize > (int32_t) dataSize) {
-                readSize = (int32_t) dataSize;
+            if (indicatedReadSize >= 0) {
+                // Read out the bit we want, the rest is poured away
+                readSize = uCellPrivateReadQuotedData(atHandle, pData, dataSize,
+                                                      // Cast in two stages to keep Lint happy
+                                                      (size_t) (unsigned) indicatedReadSize,
+                                                      false);
             }
-            // Don't stop for anything!
-            uAtClientIgnoreStopTag(atHandle);
-            // Get the leading quote mark out of the way
-            uAtClientReadBytes(atHandle, NULL, 1, true);
-            // Now read out all the actual data,
-            // first the bit we want
-            readSize = uAtClientReadBytes(atHandle, pData,
-                                          // Cast in two stages to keep Lint happy
-                                          (size_t)  (unsigned) readSize,
-                                          true);
-            if (indicatedReadSize > readSize) {
-                //...and then the rest poured away to NULL
-                uAtClientReadBytes(atHandle, NULL,
-                                   // Cast in two stages to keep Lint happy
-                                   (size_t) (unsigned) (indicatedReadSize - readSize),
-                                   true);
-            }
-            // Make sure to wait for the stop tag before
-            // we finish
-            uAtClientRestoreStopTag(atHandle);
             uAtClientResponseStop(atHandle);
             if (uAtClientUnlock(atHandle) == 0) {
                 errorCode = readSize;
@@ -313,29 +297,13 @@ int32_t uCellFileBlockRead(uDeviceHandle_t cellHandle,
                 // Read the size
                 indicatedReadSize = uAtClientReadInt(atHandle);
                 readSize = indicatedReadSize;
-                if (readSize > (int32_t) dataSize) {
-                    readSize = (int32_t) dataSize;
-                }
-                // Don't stop for anything!
-                uAtClientIgnoreStopTag(atHandle);
-                // Get the leading quote mark out of the way
-                uAtClientReadBytes(atHandle, NULL, 1, true);
-                // Now read out all the actual data,
-                // first the bit we want
-                readSize = uAtClientReadBytes(atHandle, pData,
-                                              // Cast in two stages to keep Lint happy
-                                              (size_t) (unsigned) readSize,
-                                              true);
-                if (indicatedReadSize > readSize) {
-                    //...and then the rest poured away to NULL
-                    uAtClientReadBytes(atHandle, NULL,
-                                       // Cast in two stages to keep Lint happy
-                                       (size_t) (unsigned) (indicatedReadSize - readSize),
-                                       true);
+                if (indicatedReadSize >= 0) {
+                    // Read out the bit we want, the rest is poured away
+                    readSize = uCellPrivateReadQuotedData(atHandle, pData, dataSize,
+                                                          // Cast in two stages to keep Lint happy
+                                                          (size_t) (unsigned) indicatedReadSize,
+                                                          false);
                 }
-                // Make sure to wait for the stop tag before
-                // we finish
-                uAtClientRestoreStopTag(atHandle);
                 uAtClientResponseStop(atHandle);
                 if (uAtClientUnlock(atHandle) == 0) {
                     errorCode = readSize;
@@ -35,17 +35,36 @@
  *     that any flow control information is handled independently
  *     of the user data.
  * 4.  Then the ring-buffer is parsed for non-channel-0 [i.e. user]
- *     CMUX frames and the information fields of these frames are
- *     copied into the data buffers of the individual channels.  If
- *     there is no room for the information-field data in the buffers
- *     then, assuming that CTS flow control is NOT enabled (if it is
- *     enabled then any overflow-data is simply discarded), a "stall" is
- *     indicated; the data is left in the ring-buffer and the far end
- *     is sent a flow-control-off.
+ *     CMUX frames.  The information fields of these frames are NOT
+ *     copied: each channel has its own read handle into the ring
+ *     buffer and the decoder gives the channel a "span", the position
+ *     and length of the information field in the ring buffer, which
+ *     the reader of the channel copies straight into the buffer that
+ *     is passed to read().  If a channel is not being read, and so is
+ *     holding on to space in the ring buffer that the other channels
+ *     need, it is "stalled" and only then are its information fields
+ *     copied out of the ring buffer, into the receive buffer of the
+ *     channel.  The receive buffer of a channel counts for both: if
+ *     there is no room for the information-field data then, assuming
+ *     that discard on overflow is NOT enabled (if it is enabled then
+ *     any overflow-data is simply discarded), a "stall" of the decoder
+ *     is indicated; the data is left in the ring-buffer and the far
+ *     end is sent a flow-control-off.
  * 5.  When user data is read from the virtual serial port, if we had
  *     flow-controlled-off the far end then it is flow-controlled-on
  *     again and decoding of any existing data in the buffers is
  *     re-triggered.
+ *
+ * In the other direction there is no task: a write() to a virtual
+ * serial port encodes the data as CMUX frames into a short queue
+ * for the channel and then, until its frames have gone, whichever
+ * writer gets the transmit mutex asks the scheduler which frame
+ * should be sent next, from any channel, and sends it.  The
+ * scheduler sends control frames first and then takes frames from
+ * the other channels in turn, deficit round robin, so that a large
+ * write on one channel (e.g. PPP) cannot hold up a small write on
+ * another (e.g. an AT command) for longer than it takes to send a
+ * frame or two.
  */
 
 #ifdef U_CFG_OVERRIDE
@@ -249,10 +268,15 @@ static int32_t sendEvent(uCellMuxPrivateContext_t *pContext,
                 do {
                     errorCode = uPortEventQueueSendIrq(pContext->eventQueueHandle, &trampolineData,
                                                        sizeof(trampolineData));
-                    uPortTaskBlock(U_CFG_OS_YIELD_MS);
                     irqSupported = (errorCode != (int32_t) U_ERROR_COMMON_NOT_IMPLEMENTED) &&
                                    (errorCode != (int32_t) U_ERROR_COMMON_NOT_SUPPORTED);
-                } while (irqSupported && (uPortGetTickTimeMs() - startTime < delayMs));
+                    if (irqSupported && (errorCode != 0)) {
+                        // Only wait if the queue was full, not every
+                        // time, since this is called for every frame
+                        uPortTaskBlock(U_CFG_OS_YIELD_MS);
+                    }
+                } while (irqSupported && (errorCode != 0) &&
+                         (uPortGetTickTimeMs() - startTime < delayMs));
 
                 if (!irqSupported) {
                     // If IRQ is not supported, just gotta do the normal send
@@ -266,14 +290,11 @@ static int32_t sendEvent(uCellMuxPrivateContext_t *pContext,
     return errorCode;
 }
 
-// The innards of serialGetReceiveSize(), brought out separately
-// here so that cmuxReceiveCallback() can use it.
-static int32_t serialGetReceiveSizeInnards(struct uDeviceSerial_t *pDeviceSerial)
+// Get the number of bytes in the receive buffer of a channel, i.e.
+// not counting those still in the ring buffer.
+static size_t rxBufferDataSize(const volatile uCellMuxPrivateTraffic_t *pTraffic)
 {
-    int32_t size = 0;
-    uCellMuxPrivateChannelContext_t *pChannelContext = (uCellMuxPrivateChannelContext_t *)
-                                                       pUInterfaceContext(pDeviceSerial);
-    uCellMuxPrivateTraffic_t *pTraffic = &(pChannelContext->traffic);
+    size_t size = 0;
     const char *pRxBufferWrite = pTraffic->pRxBufferWrite;
 
     if (pTraffic->pRxBufferRead < pRxBufferWrite) {
@@ -291,16 +312,111 @@ static int32_t serialGetReceiveSizeInnards(struct uDeviceSerial_t *pDeviceSerial
     return size;
 }
 
+// Read up to length bytes of the spans of a channel out of the
+// ring buffer, moving the read handle of the channel on; pBuffer
+// may be NULL to throw the data away.  mutexRx of the channel
+// should be locked before this is called.
+static size_t rxSpansRead(uRingBuffer_t *pRingBuffer,
+                          uCellMuxPrivateRxReader_t *pRxReader,
+                          char *pBuffer, size_t length)
+{
+    size_t totalRead = 0;
+    uCellMuxPrivateRxSpan_t *pSpan;
+    size_t thisSize = 1;
+
+    while ((totalRead < length) && (pRxReader->numSpans > 0) && (thisSize > 0)) {
+        pSpan = &(pRxReader->span[pRxReader->spanIndex]);
+        // Skip whatever is in front of the span: frame headers
+        // and the information fields of other channels
+        uRingBufferCommitReadHandle(pRingBuffer, pRxReader->readHandle,
+                                    pSpan->position - pRxReader->position);
+        pRxReader->position = pSpan->position;
+        thisSize = pSpan->length;
+        if (thisSize > length - totalRead) {
+            thisSize = length - totalRead;
+        }
+        if (pBuffer != NULL) {
+            thisSize = uRingBufferReadHandle(pRingBuffer, pRxReader->readHandle,
+                                             pBuffer + totalRead, thisSize);
+        } else {
+            thisSize = uRingBufferCommitReadHandle(pRingBuffer, pRxReader->readHandle,
+                                                   thisSize);
+        }
+        pRxReader->position += thisSize;
+        pRxReader->spanBytes -= thisSize;
+        pSpan->position += thisSize;
+        pSpan->length -= thisSize;
+        totalRead += thisSize;
+        if (pSpan->length == 0) {
+            pRxReader->spanIndex = (pRxReader->spanIndex + 1) % U_CELL_MUX_PRIVATE_RX_SPANS_MAX;
+            pRxReader->numSpans--;
+        }
+    }
+
+    return totalRead;
+}
+
+// Copy the oldest span of a channel out of the ring buffer and into
+// the receive buffer of the channel, which will have room for it
+// since spans are counted against the receive buffer; this is what
+// is done for a channel that is stalled.  mutexRx of the channel
+// should be locked before this is called.
+static void rxSpanCopy(uRingBuffer_t *pRingBuffer, uCellMuxPrivateTraffic_t *pTraffic)
+{
+    uCellMuxPrivateRxReader_t *pRxReader = pTraffic->pRxReader;
+    char *pRxBufferEnd = pTraffic->pRxBufferStart + pTraffic->rxBufferSizeBytes;
+    size_t length = pRxReader->span[pRxReader->spanIndex].length;
+    size_t thisSize = 1;
+
+    // Write in at most two pieces, either side of the wrap
+    while ((length > 0) && (thisSize > 0)) {
+        thisSize = pRxBufferEnd - pTraffic->pRxBufferWrite;
+        if (pTraffic->pRxBufferWrite < pTraffic->pRxBufferRead) {
+            thisSize = pTraffic->pRxBufferRead - pTraffic->pRxBufferWrite - 1;
+        }
+        if (thisSize > length) {
+            thisSize = length;
+        }
+        thisSize = rxSpansRead(pRingBuffer, pRxReader, pTraffic->pRxBufferWrite, thisSize);
+        length -= thisSize;
+        pTraffic->pRxBufferWrite += thisSize;
+        if (pTraffic->pRxBufferWrite >= pRxBufferEnd) {
+            pTraffic->pRxBufferWrite = pTraffic->pRxBufferStart;
+        }
+    }
+}
+
+// The innards of serialGetReceiveSize(), brought out separately
+// here so that cmuxReceiveCallback() can use it.
+static int32_t serialGetReceiveSizeInnards(struct uDeviceSerial_t *pDeviceSerial)
+{
+    uCellMuxPrivateChannelContext_t *pChannelContext = (uCellMuxPrivateChannelContext_t *)
+                                                       pUInterfaceContext(pDeviceSerial);
+    uCellMuxPrivateTraffic_t *pTraffic = &(pChannelContext->traffic);
+    size_t size = rxBufferDataSize(pTraffic);
+
+    if (pTraffic->pRxReader != NULL) {
+        size += pTraffic->pRxReader->spanBytes;
+    }
+
+    return (int32_t) size;
+}
+
 // The innards of serialRead(), brough out separately here so that
 // sendCommandCheckResponse() can do a read from inside the mutex lock.
-static int32_t serialReadInnards(volatile uCellMuxPrivateTraffic_t *pTraffic,
+static int32_t serialReadInnards(volatile uCellMuxPrivateChannelContext_t *pChannelContext,
                                  void *pBuffer, size_t sizeBytes)
 {
+    volatile uCellMuxPrivateTraffic_t *pTraffic = &(pChannelContext->traffic);
     int32_t totalRead = 0;
     uint8_t *pDataPtr = pBuffer;
     size_t thisSize;
     const char *pRxBufferWrite;
 
+    U_PORT_MUTEX_LOCK(pChannelContext->mutexRx);
+
+    // Anything that had to be copied into the receive buffer
+    // is older than what is in the ring buffer so take that first
     pRxBufferWrite = pTraffic->pRxBufferWrite;
     if (pTraffic->pRxBufferRead < pRxBufferWrite) {
         // Read pointer is behind write, just take as much
@@ -322,8 +438,6 @@ static int32_t serialReadInnards(volatile uCellMuxPrivateTraffic_t *pTraffic,
             thisSize = sizeBytes;
         }
         memcpy(pDataPtr, pTraffic->pRxBufferRead, thisSize);
-        pDataPtr += thisSize;
-        sizeBytes -= thisSize;
         totalRead = thisSize;
         // Move the read pointer on, wrapping as necessary
         pTraffic->pRxBufferRead += thisSize;
@@ -333,119 +447,246 @@ static int32_t serialReadInnards(volatile uCellMuxPrivateTraffic_t *pTraffic,
         }
         // If there is still room in the user buffer then
         // carry on taking up to the write pointer
-        if (sizeBytes > 0) {
+        if (sizeBytes > thisSize) {
             thisSize = pRxBufferWrite - pTraffic->pRxBufferRead;
-            if (thisSize > sizeBytes) {
-                thisSize = sizeBytes;
+            if (thisSize > sizeBytes - totalRead) {
+                thisSize = sizeBytes - totalRead;
             }
-            memcpy(pDataPtr, pTraffic->pRxBufferRead, thisSize);
+            memcpy(pDataPtr + totalRead, pTraffic->pRxBufferRead, thisSize);
             totalRead += thisSize;
             // Move the read pointer on
             pTraffic->pRxBufferRead += thisSize;
         }
     }
 
+    // Then take what we can straight out of the ring buffer
+    if (pTraffic->pRxReader != NULL) {
+        totalRead += rxSpansRead(&(pChannelContext->pContext->ringBuffer),
+                                 pTraffic->pRxReader, (char *) pDataPtr + totalRead,
+                                 sizeBytes - totalRead);
+    }
+
+    U_PORT_MUTEX_UNLOCK(pChannelContext->mutexRx);
+
     return totalRead;
 }
 
+// Write an encoded frame to the stream, all or nothing; mutexTx
+// should be locked before this is called.
+static int32_t txFrameWrite(uCellMuxPrivateContext_t *pContext,
+                            const char *pBuffer, size_t length)
+{
+    int32_t errorCode = (int32_t) U_ERROR_COMMON_SUCCESS;
+    int32_t thisLengthWritten;
+    size_t lengthWritten = 0;
+    int32_t startTimeMs = uPortGetTickTimeMs();
+
+    while ((lengthWritten < length) && (errorCode == 0)) {
+        thisLengthWritten = uPortUartWrite(pContext->underlyingStreamHandle,
+                                           pBuffer + lengthWritten,
+                                           length - lengthWritten);
+        if (thisLengthWritten >= 0) {
+            lengthWritten += thisLengthWritten;
+            if ((lengthWritten < length) &&
+                (uPortGetTickTimeMs() - startTimeMs >= U_CELL_MUX_WRITE_TIMEOUT_MS)) {
+                errorCode = (int32_t) U_ERROR_COMMON_TIMEOUT;
+            }
+        } else {
+            errorCode = thisLengthWritten;
+        }
+    }
+
+    return errorCode;
+}
+
+// Send the next frame, from whichever channel the scheduler picks,
+// returning true if a frame was sent (or, at least, has gone);
+// mutexTx should be locked before this is called.  mutexTxScheduler
+// is only held while the queue is being looked at, so that writers
+// can add frames while one is being sent.
+static bool txSend(uCellMuxPrivateContext_t *pContext)
+{
+    uCellMuxPrivateTxScheduler_t *pScheduler = &(pContext->txScheduler);
+    uCellMuxPrivateTxQueue_t *pQueue = NULL;
+    uCellMuxPrivateTxFrame_t *pFrame = NULL;
+    int32_t errorCode;
+    int32_t latencyMs;
+
+    U_PORT_MUTEX_LOCK(pContext->mutexTxScheduler);
+    errorCode = uCellMuxPrivateTxSchedule(pScheduler);
+    if (errorCode >= 0) {
+        pQueue = &(pScheduler->queue[errorCode]);
+        pFrame = &(pQueue->frame[pQueue->frameIndex]);
+    }
+    U_PORT_MUTEX_UNLOCK(pContext->mutexTxScheduler);
+
+    if (pFrame != NULL) {
+        // The frame stays where it is until it has been sent;
+        // no-one else can send it since we have mutexTx
+        errorCode = txFrameWrite(pContext, pFrame->buffer, pFrame->length);
+#ifdef U_CELL_MUX_ENABLE_USER_TX_DEBUG
+        if (errorCode == 0) {
+            // Note: don't normally need debug prints for user writes as they
+            // are not very interesting (the control stuff is printed separately)
+            // but if you _really_ need it you can enable the code here
+            uPortLog("U_CELL_CMUX_%d: sent %d byte(s): ", pQueue->channel,
+                     pFrame->length);
+            for (size_t x = 0; x < pFrame->length; x++) {
+                char y = pFrame->buffer[x];
+#ifndef U_CELL_MUX_HEX_DEBUG
+                if (isprint((int32_t) y)) {
+                    uPortLog("%c", y);
+                } else {
+#endif
+                    uPortLog("[%02x]", y);
+#ifndef U_CELL_MUX_HEX_DEBUG
+                }
+#endif
+            }
+            uPortLog(".\n");
+        }
+#endif
+
+        U_PORT_MUTEX_LOCK(pContext->mutexTxScheduler);
+        if (errorCode == 0) {
+            latencyMs = uPortGetTickTimeMs() - pFrame->queuedTimeMs;
+            pQueue->statistics.numFrames++;
+            pQueue->statistics.numInformationBytes += pFrame->informationLengthBytes;
+            pQueue->latencyTotalMs += latencyMs;
+            if (latencyMs > pQueue->statistics.latencyMaxMs) {
+                pQueue->statistics.latencyMaxMs = latencyMs;
+            }
+        } else {
+            // The frame is lost; the writer will find out
+            pQueue->errorCode = errorCode;
+        }
+        pQueue->frameIndex++;
+        if (pQueue->frameIndex >= sizeof(pQueue->frame) / sizeof(pQueue->frame[0])) {
+            pQueue->frameIndex = 0;
+        }
+        pQueue->numFrames--;
+        pQueue->sequenceDone++;
+        U_PORT_MUTEX_UNLOCK(pContext->mutexTxScheduler);
+    }
+
+    return (pFrame != NULL);
+}
+
 // The innards of serialWrite(), brough out separately here so that
 // controlChannelInformation() can respond to MSC commands.
 static int32_t serialWriteInnards(struct uDeviceSerial_t *pDeviceSerial,
                                   const void *pBuffer, size_t sizeBytes)
 {
-    int32_t sizeOrErrorCode = (int32_t) U_ERROR_COMMON_NO_MEMORY;
+    int32_t sizeOrErrorCode = (int32_t) U_ERROR_COMMON_SUCCESS;
     uCellMuxPrivateChannelContext_t *pChannelContext = (uCellMuxPrivateChannelContext_t *)
                                                        pUInterfaceContext(pDeviceSerial);
-    uCellPrivateInstance_t *pInstance = pChannelContext->pContext->pInstance;
-    char *pBufferEncoded;
-    size_t chunkSize = U_CELL_MUX_PRIVATE_INFORMATION_LENGTH_MAX_BYTES;
+    uCellMuxPrivateContext_t *pContext = pChannelContext->pContext;
+    uCellPrivateInstance_t *pInstance = pContext->pInstance;
+    uCellMuxPrivateTxQueue_t *pQueue = pChannelContext->traffic.pTxQueue;
+    uCellMuxPrivateTxFrame_t *pFrame;
+    size_t numFramesMax = sizeof(pQueue->frame) / sizeof(pQueue->frame[0]);
     size_t thisChunkSize;
-    size_t sizeWritten = 0;
-    int32_t thisLengthWritten;
-    size_t lengthWritten;
+    size_t sizeQueued = 0;
+    size_t sequence;
+    bool done = (sizeBytes == 0);
+    bool sent;
     int32_t startTimeMs;
     bool activityPinIsSet = false;
 
-    // Encode the CMUX frame in chunks of the maximum information
-    // length using a temporary buffer
-    if (chunkSize > sizeBytes) {
-        chunkSize = sizeBytes;
+    if (pInstance->pinDtrPowerSaving >= 0) {
+        activityPinIsSet = true;
+        uCellPrivateSetPinDtr(pInstance, true);
     }
-    pBufferEncoded = (char *) pUPortMalloc(chunkSize + U_CELL_MUX_PRIVATE_FRAME_OVERHEAD_MAX_BYTES);
-    if (pBufferEncoded != NULL) {
-        sizeOrErrorCode = (int32_t) U_ERROR_COMMON_SUCCESS;
-        if (pInstance->pinDtrPowerSaving >= 0) {
-            activityPinIsSet = true;
-            uCellPrivateSetPinDtr(pInstance, true);
-        }
-        startTimeMs = uPortGetTickTimeMs();
-        while ((sizeWritten < sizeBytes) && (sizeOrErrorCode >= 0) &&
-               (uPortGetTickTimeMs() - startTimeMs < U_CELL_MUX_WRITE_TIMEOUT_MS)) {
-            // Encode a chunk as UIH
-            thisChunkSize = sizeBytes - sizeWritten;
+
+    U_PORT_MUTEX_LOCK(pContext->mutexTxScheduler);
+    pQueue->errorCode = (int32_t) U_ERROR_COMMON_SUCCESS;
+    sequence = pQueue->sequenceQueued;
+    U_PORT_MUTEX_UNLOCK(pContext->mutexTxScheduler);
+
+    startTimeMs = uPortGetTickTimeMs();
+    while (!done && (sizeOrErrorCode >= 0) &&
+           (uPortGetTickTimeMs() - startTimeMs < U_CELL_MUX_WRITE_TIMEOUT_MS)) {
+
+        U_PORT_MUTEX_LOCK(pContext->mutexTxScheduler);
+
+        // Encode as many chunks of the maximum information length
+        // as UIH as there is room for in the queue
+        while ((sizeQueued < sizeBytes) && (pQueue->numFrames < numFramesMax) &&
+               (sizeOrErrorCode >= 0)) {
+            thisChunkSize = sizeBytes - sizeQueued;
             if (thisChunkSize > U_CELL_MUX_PRIVATE_INFORMATION_LENGTH_MAX_BYTES) {
                 thisChunkSize = U_CELL_MUX_PRIVATE_INFORMATION_LENGTH_MAX_BYTES;
             }
+            pFrame = &(pQueue->frame[(pQueue->frameIndex + pQueue->numFrames) % numFramesMax]);
             sizeOrErrorCode = uCellMuxPrivateEncode(pChannelContext->channel,
                                                     U_CELL_MUX_PRIVATE_FRAME_TYPE_UIH,
-                                                    false, ((const char *) pBuffer) + sizeWritten,
-                                                    thisChunkSize, pBufferEncoded);
+                                                    false, ((const char *) pBuffer) + sizeQueued,
+                                                    thisChunkSize, pFrame->buffer);
             if (sizeOrErrorCode >= 0) {
-                lengthWritten = 0;
-                while ((sizeOrErrorCode >= 0) && (lengthWritten < (size_t) sizeOrErrorCode) &&
-                       (uPortGetTickTimeMs() - startTimeMs < U_CELL_MUX_WRITE_TIMEOUT_MS)) {
-                    if (!pChannelContext->traffic.txIsFlowControlledOff) {
-                        // Send the data
-                        thisLengthWritten = uPortUartWrite(pChannelContext->pContext->underlyingStreamHandle,
-                                                           pBufferEncoded + lengthWritten,
-                                                           sizeOrErrorCode - lengthWritten);
-                        if (thisLengthWritten >= 0) {
-                            lengthWritten += thisLengthWritten;
-                        } else {
-                            sizeOrErrorCode = thisLengthWritten;
-                        }
-                    } else {
-                        uPortTaskBlock(10);
-                    }
-                }
-#ifdef U_CELL_MUX_ENABLE_USER_TX_DEBUG
-                if (sizeOrErrorCode >= 0) {
-                    // Note: don't normally need debug prints for user writes as they
-                    // are not very interesting (the control stuff is printed separately)
-                    // but if you _really_ need it you can enable the code here
-                    uPortLog("U_CELL_CMUX_%d: sent %d byte(s): ", pChannelContext->channel,
-                             lengthWritten);
-                    for (size_t x = 0; x < lengthWritten; x++) {
-                        char y = *(pBufferEncoded + x);
-#ifndef U_CELL_MUX_HEX_DEBUG
-                        if (isprint((int32_t) y)) {
-                            uPortLog("%c", y);
-                        } else {
-#endif
-                            uPortLog("[%02x]", y);
-#ifndef U_CELL_MUX_HEX_DEBUG
-                        }
-#endif
-                    }
-                    uPortLog(".\n");
+                pFrame->length = (size_t) sizeOrErrorCode;
+                pFrame->informationLengthBytes = thisChunkSize;
+                pFrame->queuedTimeMs = uPortGetTickTimeMs();
+                pQueue->numFrames++;
+                if (pQueue->numFrames > pQueue->statistics.queueLengthMaxFrames) {
+                    pQueue->statistics.queueLengthMaxFrames = pQueue->numFrames;
                 }
-#endif
-                // Keep track of the amount of user information written
-                sizeWritten += thisChunkSize;
+                pQueue->sequenceQueued++;
+                sequence = pQueue->sequenceQueued;
+                sizeQueued += thisChunkSize;
             }
         }
-
-        if (activityPinIsSet) {
-            uCellPrivateSetPinDtr(pInstance, false);
+        // Done when all of our frames have gone
+        done = (sizeQueued == sizeBytes) && ((int32_t) (pQueue->sequenceDone - sequence) >= 0);
+        if (pQueue->errorCode < 0) {
+            sizeOrErrorCode = pQueue->errorCode;
+            done = false;
         }
 
-        sizeOrErrorCode = (int32_t) U_ERROR_COMMON_TIMEOUT;
-        if (sizeWritten == sizeBytes) {
-            sizeOrErrorCode = (int32_t) sizeBytes;
+        U_PORT_MUTEX_UNLOCK(pContext->mutexTxScheduler);
+
+        if (!done && (sizeOrErrorCode >= 0)) {
+            // Send whatever the scheduler says should go next,
+            // which may well be from another channel; if someone
+            // else is sending, only wait a short while before
+            // checking again since they may be sending ours
+            sent = true;
+            if (uPortMutexTryLock(pContext->mutexTx, 1) == 0) {
+                sent = txSend(pContext);
+                uPortMutexUnlock(pContext->mutexTx);
+            }
+            if (!sent) {
+                // Nothing could go: either someone else has sent
+                // our frames already or we are flow controlled off,
+                // in which case wait a little
+                U_PORT_MUTEX_LOCK(pContext->mutexTxScheduler);
+                sent = (pQueue->numFrames == 0);
+                U_PORT_MUTEX_UNLOCK(pContext->mutexTxScheduler);
+                if (!sent) {
+                    uPortTaskBlock(10);
+                }
+            }
         }
+    }
+
+    if (!done) {
+        // Don't leave anything of ours behind
+        U_PORT_MUTEX_LOCK(pContext->mutexTx);
+        U_PORT_MUTEX_LOCK(pContext->mutexTxScheduler);
+        pQueue->sequenceDone += pQueue->numFrames;
+        pQueue->frameIndex = 0;
+        pQueue->numFrames = 0;
+        U_PORT_MUTEX_UNLOCK(pContext->mutexTxScheduler);
+        U_PORT_MUTEX_UNLOCK(pContext->mutexTx);
+    }
+
+    if (activityPinIsSet) {
+        uCellPrivateSetPinDtr(pInstance, false);
+    }
 
-        // Free memory
-        uPortFree(pBufferEncoded);
+    if (done) {
+        sizeOrErrorCode = (int32_t) sizeBytes;
+    } else if (sizeOrErrorCode >= 0) {
+        sizeOrErrorCode = (int32_t) U_ERROR_COMMON_TIMEOUT;
     }
 
     return sizeOrErrorCode;
@@ -492,7 +733,7 @@ static int32_t sendCommandCheckResponse(uDeviceSerial_t *pDeviceSerial,
     int32_t startTimeMs;
 
     // Flush out any existing information field data
-    while (serialReadInnards(pTraffic, buffer, sizeof(buffer)) > 0) {}
+    while (serialReadInnards(pChannelContext, buffer, sizeof(buffer)) > 0) {}
     // Encode the command
     length = uCellMuxPrivateEncode(pChannelContext->channel, pFrameSend->type,
                                    true, pFrameSend->information,
@@ -500,8 +741,13 @@ static int32_t sendCommandCheckResponse(uDeviceSerial_t *pDeviceSerial,
                                    buffer);
     if (length >= 0) {
         pTraffic->wantedResponseFrameType = pFrameCheck->type;
-        errorCode = uPortUartWrite(pChannelContext->pContext->underlyingStreamHandle, buffer, length);
-        if (errorCode == length) {
+        // Send it straight away, in between any frames that the
+        // scheduler is sending
+        U_PORT_MUTEX_LOCK(pChannelContext->pContext->mutexTx);
+        errorCode = txFrameWrite(pChannelContext->pContext, buffer, length);
+        U_PORT_MUTEX_UNLOCK(pChannelContext->pContext->mutexTx);
+        if (errorCode == 0) {
+            errorCode = length;
 #ifdef U_CELL_MUX_ENABLE_DEBUG
             uPortLog("U_CELL_CMUX_%d: tx %d byte(s): ", pChannelContext->channel, errorCode);
             for (int32_t x = 0; x < errorCode; x++) {
@@ -527,7 +773,7 @@ static int32_t sendCommandCheckResponse(uDeviceSerial_t *pDeviceSerial,
 #endif
                 if (pFrameCheck->informationLengthBytes > 0) {
                     // Need to look for the right information field contents also
-                    length = serialReadInnards(pTraffic, buffer, sizeof(buffer));
+                    length = serialReadInnards(pChannelContext, buffer, sizeof(buffer));
                     pTmp = buffer;
                     while ((length >= (int32_t) pFrameCheck->informationLengthBytes) &&
                            (memcmp(pTmp, pFrameCheck->information,
@@ -663,6 +909,15 @@ static void serialClose(struct uDeviceSerial_t *pDeviceSerial)
         }
 
         pChannelContext->state = U_CELL_MUX_PRIVATE_CHANNEL_STATE_NULL;
+        // Let go of anything waiting in the ring buffer and stop
+        // the decoder giving us any more
+        U_PORT_MUTEX_LOCK(pChannelContext->mutexRx);
+        pTraffic->rxBufferSizeBytes = 0;
+        if (pTraffic->pRxReader != NULL) {
+            rxSpansRead(&(pChannelContext->pContext->ringBuffer), pTraffic->pRxReader,
+                        NULL, pTraffic->pRxReader->spanBytes);
+        }
+        U_PORT_MUTEX_UNLOCK(pChannelContext->mutexRx);
         if (pTraffic->rxBufferIsMalloced) {
             uPortFree(pTraffic->pRxBufferStart);
         }
@@ -677,6 +932,26 @@ static void serialClose(struct uDeviceSerial_t *pDeviceSerial)
     }
 }
 
+// Re-trigger decoding of any received data we didn't previously
+// have room to process.  We do a try send if we can so that we don't
+// get stuck: if there are already events in the queue then they
+// will do the trick.
+static void retriggerDecode(uCellMuxPrivateContext_t *pContext)
+{
+    int32_t x;
+
+    x = uPortUartEventTrySend(pContext->underlyingStreamHandle,
+                              U_DEVICE_SERIAL_EVENT_BITMASK_DATA_RECEIVED, 0);
+    if ((x == (int32_t) U_ERROR_COMMON_NOT_IMPLEMENTED) ||
+        (x == (int32_t) U_ERROR_COMMON_NOT_SUPPORTED)) {
+        uPortUartEventSend(pContext->underlyingStreamHandle,
+                           U_DEVICE_SERIAL_EVENT_BITMASK_DATA_RECEIVED);
+    }
+#ifdef U_CELL_MUX_ENABLE_DEBUG
+    uPortLog("U_CELL_CMUX: decoding retriggered.\n");
+#endif
+}
+
 // Get the number of bytes waiting in a CMUX receive buffer.
 static int32_t serialGetReceiveSize(struct uDeviceSerial_t *pDeviceSerial)
 {
@@ -704,7 +979,6 @@ static int32_t serialRead(struct uDeviceSerial_t *pDeviceSerial,
     uCellMuxPrivateChannelContext_t *pChannelContext = (uCellMuxPrivateChannelContext_t *)
                                                        pUInterfaceContext(pDeviceSerial);
     uCellMuxPrivateTraffic_t *pTraffic;
-    int32_t x;
 
     if ((pChannelContext != NULL) && !pChannelContext->markedForDeletion) {
 
@@ -714,7 +988,7 @@ static int32_t serialRead(struct uDeviceSerial_t *pDeviceSerial,
             sizeOrErrorCode = (int32_t) U_CELL_ERROR_NOT_CONNECTED;
             if (U_CELL_MUX_IS_OPEN(pChannelContext->state)) {
                 pTraffic = &(pChannelContext->traffic);
-                sizeOrErrorCode = serialReadInnards(pTraffic, pBuffer, sizeBytes);
+                sizeOrErrorCode = serialReadInnards(pChannelContext, pBuffer, sizeBytes);
 #if defined(U_CELL_MUX_ENABLE_DEBUG) || defined(U_CELL_MUX_ENABLE_USER_RX_DEBUG)
                 if (sizeOrErrorCode > 0) {
                     uPortLog("U_CELL_CMUX_%d: app read %d byte(s).\n", pChannelContext->channel,
@@ -743,26 +1017,25 @@ static int32_t serialRead(struct uDeviceSerial_t *pDeviceSerial,
                     uPortLog(".\n");
                 }
 #endif
+                // Don't tell the far end again on every read while its
+                // acknowledgement is on the way, only if it looks lost
                 if (pTraffic->rxIsFlowControlledOff &&
+                    (!pTraffic->rxFlowOnSent ||
+                     (uPortGetTickTimeMs() - pTraffic->rxFlowOnTimeMs > U_CELL_MUX_PRIVATE_RX_FLOW_ON_RETRY_MS)) &&
                     (((pTraffic->rxBufferSizeBytes - serialGetReceiveSizeInnards(pDeviceSerial)) * 100) /
                      pTraffic->rxBufferSizeBytes > U_CELL_MUX_PRIVATE_RX_FLOW_ON_THRESHOLD_PERCENT)) {
+                    pTraffic->rxFlowOnSent = true;
+                    pTraffic->rxFlowOnTimeMs = uPortGetTickTimeMs();
                     sendFlowControl(pChannelContext->pContext, pChannelContext->channel, false);
                     // The rxIsFlowControlledOff flag gets reset down in
                     // controlChannelInformation() when the acknowledgement arrives
-                    // Re-trigger decoding of any received data we didn't previously
-                    // have room to process.  We do a try send if we can so that we don't
-                    // get stuck: if there are already events in the queue then they
-                    // will do the trick.
-                    x = uPortUartEventTrySend(pChannelContext->pContext->underlyingStreamHandle,
-                                              U_DEVICE_SERIAL_EVENT_BITMASK_DATA_RECEIVED, 0);
-                    if ((x == (int32_t) U_ERROR_COMMON_NOT_IMPLEMENTED) ||
-                        (x == (int32_t) U_ERROR_COMMON_NOT_SUPPORTED)) {
-                        uPortUartEventSend(pChannelContext->pContext->underlyingStreamHandle,
-                                           U_DEVICE_SERIAL_EVENT_BITMASK_DATA_RECEIVED);
-                    }
-#ifdef U_CELL_MUX_ENABLE_DEBUG
-                    uPortLog("U_CELL_CMUX: decoding retriggered.\n");
-#endif
+                    pChannelContext->pContext->rxStarved = false;
+                    retriggerDecode(pChannelContext->pContext);
+                } else if ((sizeOrErrorCode > 0) && pChannelContext->pContext->rxStarved) {
+                    // What we have read may have been holding up space in
+                    // the ring buffer that the decoder was waiting for
+                    pChannelContext->pContext->rxStarved = false;
+                    retriggerDecode(pChannelContext->pContext);
                 }
             }
         }
@@ -1074,6 +1347,28 @@ static uint8_t getChannelGnss(const uCellPrivateInstance_t *pInstance)
     return channel;
 }
 
+// Empty a transmit queue and set it up for the given channel,
+// resetting the statistics and setting the default weight.
+static void txQueueReset(uCellMuxPrivateContext_t *pContext,
+                         uCellMuxPrivateTxQueue_t *pQueue, uint8_t channel,
+                         const volatile bool *pIsFlowControlledOff)
+{
+    size_t weight = U_CELL_MUX_TX_WEIGHT_DEFAULT;
+
+    if (channel == U_CELL_MUX_PRIVATE_CHANNEL_ID_AT) {
+        weight = U_CELL_MUX_TX_WEIGHT_AT;
+    } else if (channel == pContext->channelGnss) {
+        weight = U_CELL_MUX_TX_WEIGHT_GNSS;
+    }
+
+    U_PORT_MUTEX_LOCK(pContext->mutexTxScheduler);
+    memset(pQueue, 0, sizeof(*pQueue));
+    pQueue->channel = channel;
+    pQueue->pIsFlowControlledOff = pIsFlowControlledOff;
+    pQueue->quantumBytes = weight * U_CELL_MUX_PRIVATE_TX_FRAME_LENGTH_MAX_BYTES;
+    U_PORT_MUTEX_UNLOCK(pContext->mutexTxScheduler);
+}
+
 // Open a CMUX channel.
 static int32_t openChannel(uCellMuxPrivateContext_t *pContext,
                            uint8_t channel, size_t receiveBufferSizeBytes)
@@ -1100,6 +1395,7 @@ static int32_t openChannel(uCellMuxPrivateContext_t *pContext,
                         uPortMutexDelete(pChannelContext->mutex);
                         uPortMutexDelete(pChannelContext->mutexUserDataWrite);
                         uPortMutexDelete(pChannelContext->mutexUserDataRead);
+                        uPortMutexDelete(pChannelContext->mutexRx);
                         uDeviceSerialDelete(pContext->pDeviceSerial[x]);
                         index = x;
                     }
@@ -1118,10 +1414,17 @@ static int32_t openChannel(uCellMuxPrivateContext_t *pContext,
                     if (errorCode == 0) {
                         errorCode = uPortMutexCreate(&(pChannelContext->mutexUserDataWrite));
                     }
+                    if (errorCode == 0) {
+                        errorCode = uPortMutexCreate(&(pChannelContext->mutexRx));
+                    }
                     if (errorCode == 0) {
                         pContext->pDeviceSerial[index] = pDeviceSerial;
                     }  else {
                         // Clean up on error
+                        if (pChannelContext->mutexRx != NULL) {
+                            uPortMutexDelete(pChannelContext->mutexRx);
+                            pChannelContext->mutexRx = NULL;
+                        }
                         if (pChannelContext->mutexUserDataWrite != NULL) {
                             uPortMutexDelete(pChannelContext->mutexUserDataWrite);
                             pChannelContext->mutexUserDataWrite = NULL;
@@ -1148,6 +1451,10 @@ static int32_t openChannel(uCellMuxPrivateContext_t *pContext,
                 pChannelContext->channel = channel;
                 pChannelContext->markedForDeletion = false;
                 memset(&(pChannelContext->traffic), 0, sizeof(pChannelContext->traffic));
+                pChannelContext->traffic.pRxReader = &(pContext->rxReader[index]);
+                pChannelContext->traffic.pTxQueue = &(pContext->txScheduler.queue[index]);
+                txQueueReset(pContext, pChannelContext->traffic.pTxQueue, channel,
+                             &(pChannelContext->traffic.txIsFlowControlledOff));
                 memset(&(pChannelContext->eventCallback), 0, sizeof(pChannelContext->eventCallback));
                 errorCode = pDeviceSerial->open(pDeviceSerial, NULL, receiveBufferSizeBytes);
                 // Don't clean up on error here - the serial device will be re-used if
@@ -1261,7 +1568,18 @@ static void cmuxDecodeControl(uCellMuxPrivateContext_t *pContext)
         parserContext.informationLengthBytes = sizeof(pContext->scratch);
         while ((parserContext.bufferIndex < parserContext.bufferSize) &&
                (errorCode != (int32_t) U_ERROR_COMMON_TIMEOUT)) {
-            errorCode = uCellMuxPrivateParseCmux(NULL, &parserContext);
+            errorCode = uCellMuxPrivateParseCmux(&parserContext);
+            if ((errorCode == (int32_t) U_ERROR_COMMON_TIMEOUT) &&
+                (parserContext.bufferSize >= sizeof(pContext->holdingBuffer))) {
+                // The holding buffer is big enough for any control
+                // channel frame so, if it is full and the frame at the
+                // start of it is still not complete, that is not a
+                // control channel frame, it is user data that happens
+                // to look like one: move past it, otherwise we would
+                // wait forever for the rest of it
+                parserContext.bufferIndex++;
+                errorCode = (int32_t) U_ERROR_COMMON_NOT_FOUND;
+            }
             if (errorCode == 0) {
                 pDeviceSerial = pUCellMuxPrivateGetDeviceSerial(pContext, parserContext.address);
                 pChannelContext = (uCellMuxPrivateChannelContext_t *) pUInterfaceContext(pDeviceSerial);
@@ -1323,6 +1641,47 @@ static void cmuxDecodeControl(uCellMuxPrivateContext_t *pContext)
     }
 }
 
+// Once the decoder has moved on, bring the read handle of each
+// channel that has nothing waiting in the ring buffer up with it and
+// copy out the information fields of any channel that has fallen
+// too far behind, so that it does not hold on to space in the ring
+// buffer that the other channels need.
+static void rxReadersUpdate(uCellMuxPrivateContext_t *pContext)
+{
+    uCellMuxPrivateRxReader_t *pRxReader;
+    uCellMuxPrivateChannelContext_t *pChannelContext;
+    bool locked;
+
+    for (size_t x = 0; x < sizeof(pContext->rxReader) / sizeof(pContext->rxReader[0]); x++) {
+        pRxReader = &(pContext->rxReader[x]);
+        pChannelContext = (uCellMuxPrivateChannelContext_t *) pUInterfaceContext(
+                              pContext->pDeviceSerial[x]);
+        locked = (pChannelContext != NULL) && !pChannelContext->markedForDeletion;
+        if (locked) {
+            // Not U_PORT_MUTEX_LOCK()/U_PORT_MUTEX_UNLOCK() since their
+            // braces would not pair up across the conditionals here
+            uPortMutexLock(pChannelContext->mutexRx);
+            while ((pRxReader->numSpans > 0) &&
+                   (pContext->readPosition - pRxReader->position > U_CELL_MUX_PRIVATE_RX_SPAN_LAG_MAX_BYTES)) {
+#ifdef U_CELL_MUX_ENABLE_DEBUG
+                uPortLog("U_CELL_CMUX_%d: stalled, copying %d byte(s) of I-field.\n",
+                         pChannelContext->channel,
+                         pRxReader->span[pRxReader->spanIndex].length);
+#endif
+                rxSpanCopy(&(pContext->ringBuffer), &(pChannelContext->traffic));
+            }
+        }
+        if (pRxReader->numSpans == 0) {
+            uRingBufferCommitReadHandle(&(pContext->ringBuffer), pRxReader->readHandle,
+                                        pContext->readPosition - pRxReader->position);
+            pRxReader->position = pContext->readPosition;
+        }
+        if (locked) {
+            uPortMutexUnlock(pChannelContext->mutexRx);
+        }
+    }
+}
+
 // Decode received CMUX frames, just the non-control-channel ones, from
 // the ring buffer.
 static void cmuxDecode(uCellMuxPrivateContext_t *pContext, uint32_t eventBitMap)
@@ -1332,13 +1691,18 @@ static void cmuxDecode(uCellMuxPrivateContext_t *pContext, uint32_t eventBitMap)
     uDeviceSerial_t *pDeviceSerial;
     uCellMuxPrivateChannelContext_t *pChannelContext;
     uCellMuxPrivateTraffic_t *pTraffic;
-    U_RING_BUFFER_PARSER_f parserList[] = {uCellMuxPrivateParseCmux, NULL};
-    size_t offset;
+    uCellMuxPrivateRxReader_t *pRxReader;
+    uCellMuxPrivateRxSpan_t *pSpan;
+    // Static as the ring buffer remembers the progress of
+    // the parser against the list
+    static const uRingBufferBlockParser_t parserList[] = {
+        {uCellMuxPrivateParseCmuxBlock, "\xf9", 1, sizeof(uCellMuxPrivateParserState_t)},
+        {NULL, NULL, 0, 0}
+    };
     bool stalled = false;
     size_t bufferLength;
     size_t discardLength;
     size_t x;
-    const char *pRxBufferRead;
 
     if (pContext != NULL) {
         // Try to decode new CMUX messages from the ring buffer
@@ -1347,13 +1711,12 @@ static void cmuxDecode(uCellMuxPrivateContext_t *pContext, uint32_t eventBitMap)
             memset(&parserContext, 0, sizeof(parserContext));
             parserContext.type = U_CELL_MUX_PRIVATE_FRAME_TYPE_NONE;
             parserContext.address = U_CELL_MUX_PRIVATE_ADDRESS_ANY;
-            // Initial decode, which does NOT copy-out the information field
-            // because we don't know if we have enough room in the buffers
-            errorCodeOrLength = uRingBufferParseHandle(&(pContext->ringBuffer),
-                                                       pContext->readHandle,
-                                                       parserList, &parserContext);
+            // Decode, which does NOT copy-out the information field:
+            // that is left in the ring buffer for the channel to read
+            errorCodeOrLength = uRingBufferParseBlockHandle(&(pContext->ringBuffer),
+                                                            pContext->readHandle,
+                                                            parserList, &parserContext);
             if (errorCodeOrLength > 0) {
-                discardLength = 0;
                 pDeviceSerial = pUCellMuxPrivateGetDeviceSerial(pContext, parserContext.address);
                 pChannelContext = (uCellMuxPrivateChannelContext_t *) pUInterfaceContext(pDeviceSerial);
                 if ((pChannelContext != NULL) &&
@@ -1379,87 +1742,48 @@ static void cmuxDecode(uCellMuxPrivateContext_t *pContext, uint32_t eventBitMap)
                             case U_CELL_MUX_PRIVATE_FRAME_TYPE_UIH:
                             //fall-through
                             case U_CELL_MUX_PRIVATE_FRAME_TYPE_UI:
-                                if (pTraffic->rxBufferSizeBytes > 0) {
+                                U_PORT_MUTEX_LOCK(pChannelContext->mutexRx);
+                                pRxReader = pTraffic->pRxReader;
+                                if ((pTraffic->rxBufferSizeBytes > 0) && (pRxReader != NULL)) {
                                     // We have user information, work out how much we can cope with
                                     // -1 below to avoid pointer wrap
+                                    discardLength = 0;
                                     bufferLength  = pTraffic->rxBufferSizeBytes - serialGetReceiveSizeInnards(pDeviceSerial) - 1;
-                                    if (bufferLength > sizeof(pContext->scratch)) {
-                                        bufferLength = sizeof(pContext->scratch);
-                                    }
                                     if (parserContext.informationLengthBytes > bufferLength) {
                                         discardLength = parserContext.informationLengthBytes - bufferLength;
                                         parserContext.informationLengthBytes = bufferLength;
                                     }
                                     if ((discardLength == 0) || pTraffic->discardOnOverflow) {
-                                        // Re-parse the buffer to actually get the information field
-                                        parserContext.pInformation = pContext->scratch;
-                                        uRingBufferParseHandle(&(pContext->ringBuffer),
-                                                               pContext->readHandle,
-                                                               parserList, &parserContext);
-                                        if (parserContext.informationLengthBytes > bufferLength) {
-                                            parserContext.informationLengthBytes = bufferLength;
-                                        }
 #ifdef U_CELL_MUX_ENABLE_DEBUG
-                                        uPortLog("U_CELL_CMUX_%d: writing %d byte(s) of decode I-field, buffer %d/%d.\n",
+                                        uPortLog("U_CELL_CMUX_%d: %d byte(s) of I-field for the reader, buffer %d/%d.\n",
                                                  pChannelContext->channel,
                                                  parserContext.informationLengthBytes,
                                                  serialGetReceiveSizeInnards(pDeviceSerial),
                                                  pTraffic->rxBufferSizeBytes);
 #endif
-                                        //  Move the user's information-field bytes into the main buffer
-                                        pRxBufferRead = pTraffic->pRxBufferRead;
-                                        if (pTraffic->pRxBufferWrite >= pRxBufferRead) {
-                                            // Write pointer is equal to or ahead of read,
-                                            // start by adding up to the end of the buffer
-                                            offset = pTraffic->pRxBufferStart +
-                                                     pTraffic->rxBufferSizeBytes - pTraffic->pRxBufferWrite;
-                                            if (offset > parserContext.informationLengthBytes) {
-                                                offset = parserContext.informationLengthBytes;
+                                        if (parserContext.informationLengthBytes > 0) {
+                                            if (pRxReader->numSpans >= U_CELL_MUX_PRIVATE_RX_SPANS_MAX) {
+                                                // No more room to keep track: the oldest
+                                                // has to be copied out of the ring buffer
+                                                rxSpanCopy(&(pContext->ringBuffer), pTraffic);
                                             }
-                                            memcpy(pTraffic->pRxBufferWrite, pContext->scratch, offset);
-                                            parserContext.informationLengthBytes -= offset;
-                                            // Move the write pointer on, wrapping as necessary
-                                            pTraffic->pRxBufferWrite += offset;
-                                            if (pTraffic->pRxBufferWrite >= pTraffic->pRxBufferStart +
-                                                pTraffic->rxBufferSizeBytes) {
-                                                pTraffic->pRxBufferWrite = pTraffic->pRxBufferStart;
-                                            }
-                                            // If there is still stuff to write, continue writing
-                                            // up to just before the read pointer
-                                            if (parserContext.informationLengthBytes > 0) {
-                                                x = pRxBufferRead - pTraffic->pRxBufferWrite;
-                                                if (x > 0) {
-                                                    x--;
-                                                }
-                                                if (x > parserContext.informationLengthBytes) {
-                                                    x = parserContext.informationLengthBytes;
-                                                }
-                                                memcpy(pTraffic->pRxBufferWrite, pContext->scratch + offset, x);
-                                                pTraffic->pRxBufferWrite += x;
-                                            }
-                                        } else {
-                                            // Write pointer is behind read, just write as much as we can
-                                            x = pRxBufferRead - pTraffic->pRxBufferWrite;
-                                            if (x > parserContext.informationLengthBytes) {
-                                                x = parserContext.informationLengthBytes;
-                                            }
-                                            memcpy(pTraffic->pRxBufferWrite, pContext->scratch, x);
-                                            pTraffic->pRxBufferWrite += x;
-                                        }
-                                        // Wrap the write pointer if necessary
-                                        if (pTraffic->pRxBufferWrite >= pTraffic->pRxBufferStart +
-                                            pTraffic->rxBufferSizeBytes) {
-                                            pTraffic->pRxBufferWrite = pTraffic->pRxBufferStart;
+                                            // Give the reader the information field where it is
+                                            // in the ring buffer; any that would overflow is
+                                            // simply left out of the span
+                                            x = (pRxReader->spanIndex + pRxReader->numSpans) %
+                                                U_CELL_MUX_PRIVATE_RX_SPANS_MAX;
+                                            pSpan = &(pRxReader->span[x]);
+                                            pSpan->position = pContext->readPosition + parserContext.informationOffset;
+                                            pSpan->length = parserContext.informationLengthBytes;
+                                            pRxReader->spanBytes += pSpan->length;
+                                            pRxReader->numSpans++;
                                         }
-                                        // Having decoded what we can, do any discarding
-                                        if (discardLength > 0) {
-                                            uRingBufferReadHandle(&(pContext->ringBuffer), pContext->readHandle,
-                                                                  NULL, discardLength);
 #ifdef U_CELL_MUX_ENABLE_DEBUG
+                                        if (discardLength > 0) {
                                             uPortLog("U_CELL_CMUX_%d: discarded %d byte(s) of I-field.\n",
                                                      pChannelContext->channel, discardLength);
-#endif
                                         }
+#endif
                                     } else {
                                         // Not enough room to decode more of the information field
                                         // on this channel, we are stalled
@@ -1468,7 +1792,10 @@ static void cmuxDecode(uCellMuxPrivateContext_t *pContext, uint32_t eventBitMap)
 #endif
                                         stalled = true;
                                     }
+                                }
+                                U_PORT_MUTEX_UNLOCK(pChannelContext->mutexRx);
 
+                                if (pTraffic->rxBufferSizeBytes > 0) {
                                     // After all that, check if the channel's receive buffer is
                                     // sufficiently full that we should flow control off this channel
                                     if (!pTraffic->rxIsFlowControlledOff &&
@@ -1476,6 +1803,7 @@ static void cmuxDecode(uCellMuxPrivateContext_t *pContext, uint32_t eventBitMap)
                                          pTraffic->rxBufferSizeBytes) < U_CELL_MUX_PRIVATE_RX_FLOW_OFF_THRESHOLD_PERCENT) {
                                         sendFlowControl(pContext, parserContext.address, true);
                                         pTraffic->rxIsFlowControlledOff = true;
+                                        pTraffic->rxFlowOnSent = false;
                                     }
 
                                     // Call the  event callback a user may have set for this
@@ -1499,14 +1827,18 @@ static void cmuxDecode(uCellMuxPrivateContext_t *pContext, uint32_t eventBitMap)
                 }
 
                 if (!stalled) {
-                    // Remove any suff we have not already discarded from the ring-buffer
-                    // if we've processed it
+                    // Move the decoder past the frame (or the
+                    // rubbish); the channels have their own read
+                    // handles for what is theirs
                     uRingBufferReadHandle(&(pContext->ringBuffer), pContext->readHandle,
-                                          NULL, errorCodeOrLength - discardLength);
+                                          NULL, errorCodeOrLength);
+                    pContext->readPosition += errorCodeOrLength;
                 }
             }
         }
 
+        rxReadersUpdate(pContext);
+
         // If there is still data in any of the channel buffers and there is an event
         // callback then call it again here, in case the application had become
         // stuck with no buffer space to pull it into and needs the hint that there is
@@ -1547,11 +1879,18 @@ static void cmuxReceiveCallback(const uAtClientStreamHandle_t *pStream,
                 // user data stuck in the ring buffer _could_ prevent incoming
                 // control information from being decoded.  The ring buffer is
                 // deliberately large to prevent that happening, but just so's you know...
+                // rxStarved is set before the ring buffer is checked and
+                // cleared if there turns out to be room, so that a channel
+                // that makes room in the meantime can't miss it
+                pContext->rxStarved = true;
                 y = uRingBufferAvailableSize(&(pContext->ringBuffer));
+                receiveSizeOrError = uPortUartGetReceiveSize(pStream->handle.int32);
+                if (receiveSizeOrError <= (int32_t) y) {
+                    pContext->rxStarved = false;
+                }
                 if (y > sizeof(pContext->holdingBuffer) - pContext->holdingBufferIndex) {
                     y = sizeof(pContext->holdingBuffer) - pContext->holdingBufferIndex;
                 }
-                receiveSizeOrError = uPortUartGetReceiveSize(pStream->handle.int32);
                 if (receiveSizeOrError > (int32_t) y) {
                     receiveSizeOrError = y;
                 }
@@ -1636,14 +1975,32 @@ int32_t uCellMuxPrivateEnable(uCellPrivateInstance_t *pInstance)
                                                                      U_CELL_MUX_CALLBACK_TASK_STACK_SIZE_BYTES,
                                                                      U_CELL_MUX_CALLBACK_TASK_PRIORITY,
                                                                      U_CELL_MUX_CALLBACK_QUEUE_LENGTH);
+                    if ((pContext->eventQueueHandle >= 0) &&
+                        ((uPortMutexCreate(&(pContext->mutexTx)) != 0) ||
+                         (uPortMutexCreate(&(pContext->mutexTxScheduler)) != 0))) {
+                        // Clean up on error
+                        if (pContext->mutexTx != NULL) {
+                            uPortMutexDelete(pContext->mutexTx);
+                        }
+                        uPortEventQueueClose(pContext->eventQueueHandle);
+                        pContext->eventQueueHandle = -1;
+                    }
                     if (pContext->eventQueueHandle >= 0) {
+                        // One read handle for the decoder and one
+                        // for each channel
                         if (uRingBufferCreateWithReadHandle(&(pContext->ringBuffer),
                                                             pContext->linearBuffer,
-                                                            sizeof(pContext->linearBuffer), 1) == 0) {
+                                                            sizeof(pContext->linearBuffer),
+                                                            1 + U_CELL_MUX_MAX_CHANNELS) == 0) {
                             uRingBufferSetReadRequiresHandle(&(pContext->ringBuffer), true);
                             pContext->readHandle = uRingBufferTakeReadHandle(&(pContext->ringBuffer));
+                            for (size_t x = 0; x < sizeof(pContext->rxReader) / sizeof(pContext->rxReader[0]); x++) {
+                                pContext->rxReader[x].readHandle = uRingBufferTakeReadHandle(&(pContext->ringBuffer));
+                            }
                         } else {
                             // Clean up on error
+                            uPortMutexDelete(pContext->mutexTxScheduler);
+                            uPortMutexDelete(pContext->mutexTx);
                             uPortEventQueueClose(pContext->eventQueueHandle);
                             uPortFree(pInstance->pMuxContext);
                             pInstance->pMuxContext = NULL;
@@ -1668,6 +2025,14 @@ int32_t uCellMuxPrivateEnable(uCellPrivateInstance_t *pInstance)
                     uAtClientLock(atHandle);
                     uAtClientStreamGetExt(atHandle, &stream);
                     uRingBufferFlushHandle(&(pContext->ringBuffer), pContext->readHandle);
+                    pContext->readPosition = 0;
+                    for (size_t x = 0; x < sizeof(pContext->rxReader) / sizeof(pContext->rxReader[0]); x++) {
+                        uRingBufferFlushHandle(&(pContext->ringBuffer), pContext->rxReader[x].readHandle);
+                        pContext->rxReader[x].position = 0;
+                        pContext->rxReader[x].spanIndex = 0;
+                        pContext->rxReader[x].numSpans = 0;
+                        pContext->rxReader[x].spanBytes = 0;
+                    }
                     pContext->underlyingStreamHandle = stream.handle.int32;
                     uAtClientCommandStart(atHandle, "AT+CMUX=");
                     // Only basic mode and only UIH frames are supported by any
@@ -2046,6 +2411,103 @@ uDeviceSerial_t *pUCellMuxChannelGetDeviceSerial(uDeviceHandle_t cellHandle,
     return pDeviceSerial;
 }
 
+// Set the transmit weight of a multiplexer channel.
+int32_t uCellMuxSetTxWeight(uDeviceHandle_t cellHandle, int32_t channel,
+                            int32_t weight)
+{
+    int32_t errorCode = (int32_t) U_ERROR_COMMON_NOT_INITIALISED;
+    uCellPrivateInstance_t *pInstance;
+    uCellMuxPrivateContext_t *pContext;
+    uDeviceSerial_t *pDeviceSerial;
+    uCellMuxPrivateChannelContext_t *pChannelContext;
+
+    if (gUCellPrivateMutex != NULL) {
+
+        U_PORT_MUTEX_LOCK(gUCellPrivateMutex);
+
+        errorCode = (int32_t) U_ERROR_COMMON_INVALID_PARAMETER;
+        pInstance = pUCellPrivateGetInstance(cellHandle);
+        if ((pInstance != NULL) && (weight > 0) &&
+            ((channel <= U_CELL_MUX_PRIVATE_ADDRESS_MAX) ||
+             (channel == U_CELL_MUX_CHANNEL_ID_GNSS))) {
+            errorCode = (int32_t) U_CELL_ERROR_NOT_CONNECTED;
+            if (pInstance->pMuxContext != NULL) {
+                pContext = (uCellMuxPrivateContext_t *) pInstance->pMuxContext;
+                if (pContext->savedAtHandle != NULL) {
+                    if (channel == U_CELL_MUX_CHANNEL_ID_GNSS) {
+                        channel = pContext->channelGnss;
+                    }
+                    pDeviceSerial = pUCellMuxPrivateGetDeviceSerial(pContext,
+                                                                    (uint8_t) channel);
+                    if (pDeviceSerial != NULL) {
+                        pChannelContext = (uCellMuxPrivateChannelContext_t *) pUInterfaceContext(pDeviceSerial);
+                        U_PORT_MUTEX_LOCK(pContext->mutexTxScheduler);
+                        pChannelContext->traffic.pTxQueue->quantumBytes = ((size_t) weight) *
+                                                                          U_CELL_MUX_PRIVATE_TX_FRAME_LENGTH_MAX_BYTES;
+                        U_PORT_MUTEX_UNLOCK(pContext->mutexTxScheduler);
+                        errorCode = (int32_t) U_ERROR_COMMON_SUCCESS;
+                    }
+                }
+            }
+        }
+
+        U_PORT_MUTEX_UNLOCK(gUCellPrivateMutex);
+    }
+
+    return errorCode;
+}
+
+// Get the transmit statistics of a multiplexer channel.
+int32_t uCellMuxGetTxStatistics(uDeviceHandle_t cellHandle, int32_t channel,
+                                uCellMuxTxStatistics_t *pStatistics)
+{
+    int32_t errorCode = (int32_t) U_ERROR_COMMON_NOT_INITIALISED;
+    uCellPrivateInstance_t *pInstance;
+    uCellMuxPrivateContext_t *pContext;
+    uDeviceSerial_t *pDeviceSerial;
+    uCellMuxPrivateTxQueue_t *pQueue;
+
+    if (gUCellPrivateMutex != NULL) {
+
+        U_PORT_MUTEX_LOCK(gUCellPrivateMutex);
+
+        errorCode = (int32_t) U_ERROR_COMMON_INVALID_PARAMETER;
+        pInstance = pUCellPrivateGetInstance(cellHandle);
+        if ((pInstance != NULL) && (pStatistics != NULL) &&
+            ((channel <= U_CELL_MUX_PRIVATE_ADDRESS_MAX) ||
+             (channel == U_CELL_MUX_CHANNEL_ID_GNSS))) {
+            errorCode = (int32_t) U_CELL_ERROR_NOT_CONNECTED;
+            if (pInstance->pMuxContext != NULL) {
+                pContext = (uCellMuxPrivateContext_t *) pInstance->pMuxContext;
+                if (pContext->savedAtHandle != NULL) {
+                    if (channel == U_CELL_MUX_CHANNEL_ID_GNSS) {
+                        channel = pContext->channelGnss;
+                    }
+                    pDeviceSerial = pUCellMuxPrivateGetDeviceSerial(pContext,
+                                                                    (uint8_t) channel);
+                    if (pDeviceSerial != NULL) {
+                        pQueue = ((uCellMuxPrivateChannelContext_t *) pUInterfaceContext(
+                                      pDeviceSerial))->traffic.pTxQueue;
+                        U_PORT_MUTEX_LOCK(pContext->mutexTxScheduler);
+                        *pStatistics = pQueue->statistics;
+                        pStatistics->queueLengthFrames = pQueue->numFrames;
+                        if (pQueue->statistics.numFrames > 0) {
+                            pStatistics->latencyAverageMs = (int32_t) (pQueue->latencyTotalMs /
+                                                                       pQueue->statistics.numFrames);
+                        }
+                        U_PORT_MUTEX_UNLOCK(pContext->mutexTxScheduler);
+                        errorCode = (int32_t) U_ERROR_COMMON_SUCCESS;
+                    }
+                }
+            }
+        }
+
+        U_PORT_MUTEX_UNLOCK(gUCellPrivateMutex);
+    }
+
+    return errorCode;
+}
+
 // Remove a multiplexer channel.
 int32_t uCellMuxRemoveChannel(uDeviceHandle_t cellHandle,
                               uDeviceSerial_t *pDeviceSerial)
@@ -2124,6 +2586,7 @@ void uCellMuxFree(uDeviceHandle_t cellHandle)
                         uPortMutexDelete(pChannelContext->mutexUserDataWrite);
                         uPortMutexDelete(pChannelContext->mutexUserDataRead);
                         uPortMutexDelete(pChannelContext->mutex);
+                        uPortMutexDelete(pChannelContext->mutexRx);
                         uDeviceSerialDelete(pContext->pDeviceSerial[x]);
                         pContext->pDeviceSerial[x] = NULL;
                     } else {
@@ -33,7 +33,7 @@
 #include "stddef.h"    // NULL, size_t etc.
 #include "stdint.h"    // int32_t etc.
 #include "stdbool.h"
-#include "string.h"    // memcpy()
+#include "string.h"    // memcpy(), memmove()
 
 #include "u_compiler.h" // U_INLINE
 
@@ -48,6 +48,7 @@
 
 #include "u_ringbuffer.h"
 #include "u_interface.h"
+#include "u_crc.h"
 
 #include "u_at_client.h"
 
@@ -99,27 +100,6 @@ typedef struct uCellMuxStringList_t {
  * VARIABLES
  * -------------------------------------------------------------- */
 
-/** Table for FCS generation, reversed, 8-bit, poly 0x07.
- */
-static const uint8_t gFcsTable[256] = {
-    0x00, 0x91, 0xE3, 0x72, 0x07, 0x96, 0xE4, 0x75, 0x0E, 0x9F, 0xED, 0x7C, 0x09, 0x98, 0xEA, 0x7B,
-    0x1C, 0x8D, 0xFF, 0x6E, 0x1B, 0x8A, 0xF8, 0x69, 0x12, 0x83, 0xF1, 0x60, 0x15, 0x84, 0xF6, 0x67,
-    0x38, 0xA9, 0xDB, 0x4A, 0x3F, 0xAE, 0xDC, 0x4D, 0x36, 0xA7, 0xD5, 0x44, 0x31, 0xA0, 0xD2, 0x43,
-    0x24, 0xB5, 0xC7, 0x56, 0x23, 0xB2, 0xC0, 0x51, 0x2A, 0xBB, 0xC9, 0x58, 0x2D, 0xBC, 0xCE, 0x5F,
-    0x70, 0xE1, 0x93, 0x02, 0x77, 0xE6, 0x94, 0x05, 0x7E, 0xEF, 0x9D, 0x0C, 0x79, 0xE8, 0x9A, 0x0B,
-    0x6C, 0xFD, 0x8F, 0x1E, 0x6B, 0xFA, 0x88, 0x19, 0x62, 0xF3, 0x81, 0x10, 0x65, 0xF4, 0x86, 0x17,
-    0x48, 0xD9, 0xAB, 0x3A, 0x4F, 0xDE, 0xAC, 0x3D, 0x46, 0xD7, 0xA5, 0x34, 0x41, 0xD0, 0xA2, 0x33,
-    0x54, 0xC5, 0xB7, 0x26, 0x53, 0xC2, 0xB0, 0x21, 0x5A, 0xCB, 0xB9, 0x28, 0x5D, 0xCC, 0xBE, 0x2F,
-    0xE0, 0x71, 0x03, 0x92, 0xE7, 0x76, 0x04, 0x95, 0xEE, 0x7F, 0x0D, 0x9C, 0xE9, 0x78, 0x0A, 0x9B,
-    0xFC, 0x6D, 0x1F, 0x8E, 0xFB, 0x6A, 0x18, 0x89, 0xF2, 0x63, 0x11, 0x80, 0xF5, 0x64, 0x16, 0x87,
-    0xD8, 0x49, 0x3B, 0xAA, 0xDF, 0x4E, 0x3C, 0xAD, 0xD6, 0x47, 0x35, 0xA4, 0xD1, 0x40, 0x32, 0xA3,
-    0xC4, 0x55, 0x27, 0xB6, 0xC3, 0x52, 0x20, 0xB1, 0xCA, 0x5B, 0x29, 0xB8, 0xCD, 0x5C, 0x2E, 0xBF,
-    0x90, 0x01, 0x73, 0xE2, 0x97, 0x06, 0x74, 0xE5, 0x9E, 0x0F, 0x7D, 0xEC, 0x99, 0x08, 0x7A, 0xEB,
-    0x8C, 0x1D, 0x6F, 0xFE, 0x8B, 0x1A, 0x68, 0xF9, 0x82, 0x13, 0x61, 0xF0, 0x85, 0x14, 0x66, 0xF7,
-    0xA8, 0x39, 0x4B, 0xDA, 0xAF, 0x3E, 0x4C, 0xDD, 0xA6, 0x37, 0x45, 0xD4, 0xA1, 0x30, 0x42, 0xD3,
-    0xB4, 0x25, 0x57, 0xC6, 0xB3, 0x22, 0x50, 0xC1, 0xBA, 0x2B, 0x59, 0xC8, 0xBD, 0x2C, 0x5E, 0xCF
-};
-
 /** The valid frame types when decoding a frame.
  */
 static const uCellMuxPrivateFrameType_t gFrameTypeDecode[] = {U_CELL_MUX_PRIVATE_FRAME_TYPE_SABM_COMMAND,
@@ -134,19 +114,17 @@ static const uCellMuxPrivateFrameType_t gFrameTypeDecode[] = {U_CELL_MUX_PRIVATE
  * STATIC FUNCTIONS
  * -------------------------------------------------------------- */
 
+// Return true if a transmit queue has a frame that may be sent.
+static bool txQueueIsReady(const uCellMuxPrivateTxQueue_t *pQueue)
+{
+    return (pQueue->numFrames > 0) &&
+           ((pQueue->pIsFlowControlledOff == NULL) || !*(pQueue->pIsFlowControlledOff));
+}
+
 // Calculate the FCS for a frame sent by CMUX, ref. 3GPP 27.010 Annex B.
 static uint8_t calculateFcs(const char *pBuffer, size_t length)
 {
-    const uint8_t *pOutput = (uint8_t *) pBuffer;
-    uint8_t fcs = 0xFF;
-
-    while (length > 0) {
-        fcs = gFcsTable[fcs ^ *pOutput];
-        pOutput++;
-        length--;
-    }
-
-    return (0xFF - fcs);
+    return (0xFF - uCrc8Reflected(pBuffer, length, 0xFF));
 }
 
 // Return true if the frame type is a command when encoding a frame.
@@ -171,59 +149,6 @@ static bool isValidTypeDecode(uCellMuxPrivateFrameType_t type)
     return isValid;
 }
 
-// Get the number of bytes available: if parseHandle is NULL then the
-// buffer from pContext will be used as the source, else the ring-buffer
-// will be used as the source.
-U_INLINE static size_t bytesAvailable(uParseHandle_t parseHandle,
-                                      uCellMuxPrivateParserContext_t *pContext)
-{
-    size_t sizeBytes;
-
-    if (parseHandle == NULL) {
-        sizeBytes = pContext->bufferSize - pContext->bufferIndex;
-    } else {
-        sizeBytes = uRingBufferBytesAvailableUnprotected(parseHandle);
-    }
-
-    return sizeBytes;
-}
-
-// Get the next byte: if parseHandle is NULL then the pContext buffer
-// will be used as the source and pContext->bufferIndex will be advanced,
-// else the ring-buffer will be used as the source.
-U_INLINE static bool getByte(uParseHandle_t parseHandle,
-                             uCellMuxPrivateParserContext_t *pContext,
-                             uint8_t *pValue)
-{
-    bool success = false;
-
-    if (parseHandle == NULL) {
-        if (pContext->bufferIndex < pContext->bufferSize) {
-            *pValue = *(pContext->pBuffer + pContext->bufferIndex);
-            pContext->bufferIndex++;
-            success = true;
-        }
-    } else {
-        success = uRingBufferGetByteUnprotected(parseHandle, pValue);
-    }
-
-    return success;
-}
-
-// Get the discard size: if parseHandle is non-NULL then the ring
-// buffer function will be called, else this will return 0 because
-// that is always the right answer for the linear buffer case.
-U_INLINE static size_t getDiscard(uParseHandle_t parseHandle)
-{
-    size_t discardBytes = 0;
-
-    if (parseHandle != NULL) {
-        discardBytes = uRingBufferBytesDiscardUnprotected(parseHandle);
-    }
-
-    return discardBytes;
-}
-
 /* ----------------------------------------------------------------
  * PUBLIC FUNCTIONS: 3GPP 27.010 CMUX ENCODE/DECODE
  * -------------------------------------------------------------- */
@@ -298,90 +223,201 @@ int32_t uCellMuxPrivateEncode(uint8_t address, uCellMuxPrivateFrameType_t type,
     return errorCodeOrSize;
 }
 
-// Parse a buffer for a CMUX frame.
-int32_t uCellMuxPrivateParseCmux(uParseHandle_t parseHandle, void *pUserParam)
+// Parse a linear buffer for a CMUX frame.
+int32_t uCellMuxPrivateParseCmux(uCellMuxPrivateParserContext_t *pContext)
 {
-    uCellMuxPrivateParserContext_t *pContextParser = (uCellMuxPrivateParserContext_t *) pUserParam;
-    uint8_t x = 0;
-
-    if (bytesAvailable(parseHandle, pContextParser) < U_CELL_MUX_PRIVATE_FRAME_MIN_LENGTH_BYTES) {
-        return U_ERROR_COMMON_TIMEOUT;
-    }
-    getByte(parseHandle, pContextParser, &x);
-    if (U_CELL_MUX_PRIVATE_FRAME_MARKER != x) {  // = 0xF9
-        return U_ERROR_COMMON_NOT_FOUND;
-    }
-    uint8_t fcs = 0xFF;
-    // Next should be address but we might have caught a closing
-    // frame marker so accept an opening frame marker if there is one:
-    // This would mess-up if we ever had an address of 62 (0xF9 >> 2)
-    // but thankfully we never go that high
-    getByte(parseHandle, pContextParser, &x);
-    if (U_CELL_MUX_PRIVATE_FRAME_MARKER == x) {
-        getByte(parseHandle, pContextParser, &x);
-        // Re-check that we have the minimum length, since the check at
-        // the start of this function would not have included the extra flag
-        if (bytesAvailable(parseHandle, pContextParser) < U_CELL_MUX_PRIVATE_FRAME_MIN_LENGTH_BYTES - 1) {
-            return U_ERROR_COMMON_TIMEOUT;
+    int32_t errorCode = (int32_t) U_ERROR_COMMON_TIMEOUT;
+    uCellMuxPrivateParserState_t state = {0};
+    size_t informationLengthBytes = pContext->informationLengthBytes;
+    size_t available = pContext->bufferSize - pContext->bufferIndex;
+    const char *pFrame = pContext->pBuffer + pContext->bufferIndex;
+    int32_t x;
+
+    if (available >= U_CELL_MUX_PRIVATE_FRAME_MIN_LENGTH_BYTES) {
+        x = uCellMuxPrivateParseCmuxBlock(&state, pFrame, available, pContext);
+        if (x > 0) {
+            pContext->bufferIndex += x;
+            if ((pContext->pInformation != NULL) && (informationLengthBytes > 0)) {
+                if (informationLengthBytes > pContext->informationLengthBytes) {
+                    informationLengthBytes = pContext->informationLengthBytes;
+                }
+                memmove(pContext->pInformation, pFrame + pContext->informationOffset,
+                        informationLengthBytes);
+            }
+            errorCode = (int32_t) U_ERROR_COMMON_SUCCESS;
+        } else if (x != (int32_t) U_ERROR_COMMON_TIMEOUT) {
+            // Move on by a byte and try again next time
+            pContext->bufferIndex++;
+            errorCode = (int32_t) U_ERROR_COMMON_NOT_FOUND;
         }
     }
-    uint8_t address = x >> 2;
-    bool commandResponse = ((x & U_CELL_MUX_PRIVATE_COMMAND_RESPONSE_BIT_MASK) ==
-                            U_CELL_MUX_PRIVATE_COMMAND_RESPONSE_BIT_MASK);
-    if (((x & U_CELL_MUX_PRIVATE_EXTENSION_BIT_MASK) != U_CELL_MUX_PRIVATE_EXTENSION_BIT_MASK) ||
-        !((pContextParser->address == U_CELL_MUX_PRIVATE_ADDRESS_ANY) ||
-          (pContextParser->address == address))) {
-        return U_ERROR_COMMON_NOT_FOUND;
-    }
-    fcs = gFcsTable[fcs ^ x];
-    getByte(parseHandle, pContextParser, &x); // control
-    uCellMuxPrivateFrameType_t type = x & ~U_CELL_MUX_PRIVATE_POLL_FINAL_BIT_MASK;
-    bool pollFinal = ((x & U_CELL_MUX_PRIVATE_POLL_FINAL_BIT_MASK) != 0);
-    if (!isValidTypeDecode(type)) {
-        return U_ERROR_COMMON_NOT_FOUND;
-    }
-    fcs = gFcsTable[fcs ^ x];
-    getByte(parseHandle, pContextParser, &x); // first byte of I-field length
-    uint16_t informationLengthBytes = x >> 1;
-    fcs = gFcsTable[fcs ^ x];
-    if ((x & U_CELL_MUX_PRIVATE_EXTENSION_BIT_MASK) == 0) {
-        getByte(parseHandle, pContextParser, &x); // second byte of I-field length
-        informationLengthBytes += ((uint16_t) x) << 7;
-        fcs = gFcsTable[fcs ^ x];
-    }
-    // +2 below for FCS and closing flag
-    if (bytesAvailable(parseHandle, pContextParser) < (size_t) informationLengthBytes + 2) {
-        return U_ERROR_COMMON_TIMEOUT;
-    }
-    for (size_t y = 0; y < informationLengthBytes; y++) {
-        getByte(parseHandle, pContextParser, &x);
-        if ((pContextParser->pInformation != NULL) && (y < pContextParser->informationLengthBytes)) {
-            *(pContextParser->pInformation + y) = (char) x;
-        }
-        if (type != U_CELL_MUX_PRIVATE_FRAME_TYPE_UIH) {
-            fcs = gFcsTable[fcs ^ x];
+
+    return errorCode;
+}
+
+// Block parser for CMUX frames.
+int32_t uCellMuxPrivateParseCmuxBlock(void *pState, const char *pData,
+                                      size_t length, void *pUserParam)
+{
+    int32_t errorCodeOrLength = (int32_t) U_ERROR_COMMON_TIMEOUT;
+    uCellMuxPrivateParserState_t *pParser = (uCellMuxPrivateParserState_t *) pState;
+    uCellMuxPrivateParserContext_t *pContext = (uCellMuxPrivateParserContext_t *) pUserParam;
+    const uint8_t *pByte = (const uint8_t *) pData;
+    size_t x = 0;
+    size_t y;
+    uint8_t by;
+
+    while ((x < length) && (errorCodeOrLength == (int32_t) U_ERROR_COMMON_TIMEOUT)) {
+        if ((pParser->headerLength > 0) && (pParser->count >= pParser->headerLength) &&
+            (pParser->count < pParser->headerLength + pParser->informationLengthBytes)) {
+            // In the information field: skip over as much as is here,
+            // which is only included in the FCS if this is not UIH
+            y = pParser->headerLength + pParser->informationLengthBytes - pParser->count;
+            if (y > length - x) {
+                y = length - x;
+            }
+            if (pParser->type != U_CELL_MUX_PRIVATE_FRAME_TYPE_UIH) {
+                pParser->fcs = uCrc8Reflected((const char *) pByte + x, y, pParser->fcs);
+            }
+            pParser->count += y;
+            x += y;
+        } else {
+            by = pByte[x];
+            if ((pParser->headerLength == 0) || (pParser->count < pParser->headerLength)) {
+                switch (pParser->count) {
+                    case 0:
+                        if (by != U_CELL_MUX_PRIVATE_FRAME_MARKER) {
+                            errorCodeOrLength = (int32_t) U_ERROR_COMMON_NOT_FOUND;
+                        }
+                        pParser->fcs = 0xFF;
+                        break;
+                    case 1:
+                        // Address; if this is a frame marker then we've
+                        // caught a closing flag, the next byte will be
+                        // the opening flag we are after.  A frame for
+                        // an address we don't want is rejected here,
+                        // rather than once it is complete, so that a
+                        // caller with a buffer shorter than a frame
+                        // (e.g. the control channel) is not left
+                        // waiting for the rest of it
+                        pParser->address = by >> 2;
+                        if ((by == U_CELL_MUX_PRIVATE_FRAME_MARKER) ||
+                            ((by & U_CELL_MUX_PRIVATE_EXTENSION_BIT_MASK) == 0) ||
+                            !((pContext->address == U_CELL_MUX_PRIVATE_ADDRESS_ANY) ||
+                              (pContext->address == pParser->address))) {
+                            errorCodeOrLength = (int32_t) U_ERROR_COMMON_NOT_FOUND;
+                        }
+                        pParser->commandResponse = ((by & U_CELL_MUX_PRIVATE_COMMAND_RESPONSE_BIT_MASK) ==
+                                                    U_CELL_MUX_PRIVATE_COMMAND_RESPONSE_BIT_MASK);
+                        break;
+                    case 2:
+                        // Control
+                        pParser->type = (uCellMuxPrivateFrameType_t) (by & ~U_CELL_MUX_PRIVATE_POLL_FINAL_BIT_MASK);
+                        pParser->pollFinal = ((by & U_CELL_MUX_PRIVATE_POLL_FINAL_BIT_MASK) != 0);
+                        if (!isValidTypeDecode(pParser->type)) {
+                            errorCodeOrLength = (int32_t) U_ERROR_COMMON_NOT_FOUND;
+                        }
+                        break;
+                    case 3:
+                        // First byte of the information field length
+                        pParser->informationLengthBytes = by >> 1;
+                        pParser->headerLength = 5;
+                        if ((by & U_CELL_MUX_PRIVATE_EXTENSION_BIT_MASK) != 0) {
+                            pParser->headerLength = 4;
+                        }
+                        break;
+                    default:
+                        // Second byte of the information field length
+                        pParser->informationLengthBytes += ((size_t) by) << 7;
+                        break;
+                }
+                if (pParser->count > 0) {
+                    pParser->fcs = uCrc8Reflected((const char *) &by, 1, pParser->fcs);
+                }
+            } else if (pParser->count == pParser->headerLength + pParser->informationLengthBytes) {
+                // 0xCF is the reversed order of 11110011
+                if (uCrc8Reflected((const char *) &by, 1, pParser->fcs) != 0xCF) {
+                    errorCodeOrLength = (int32_t) U_ERROR_COMMON_NOT_FOUND;
+                }
+            } else if (by != U_CELL_MUX_PRIVATE_FRAME_MARKER) {
+                // No closing flag
+                errorCodeOrLength = (int32_t) U_ERROR_COMMON_NOT_FOUND;
+            } else {
+                pContext->address = pParser->address;
+                pContext->commandResponse = pParser->commandResponse;
+                pContext->type = pParser->type;
+                pContext->pollFinal = pParser->pollFinal;
+                pContext->informationLengthBytes = pParser->informationLengthBytes;
+                pContext->informationOffset = pParser->headerLength;
+                errorCodeOrLength = (int32_t) (x + 1);
+            }
+            pParser->count++;
+            x++;
         }
     }
-    getByte(parseHandle, pContextParser, &x);
-    // 0xCF is the reversed order of 11110011
-    if (gFcsTable[fcs ^ x] != 0xCF) {
-        return U_ERROR_COMMON_NOT_FOUND;
-    }
-    getByte(parseHandle, pContextParser, &x);
-    if (U_CELL_MUX_PRIVATE_FRAME_MARKER != x) {  // = 0xF9
-        return U_ERROR_COMMON_NOT_FOUND;
+
+    return errorCodeOrLength;
+}
+
+/* ----------------------------------------------------------------
+ * PUBLIC FUNCTIONS: TRANSMIT SCHEDULING
+ * -------------------------------------------------------------- */
+
+// Decide which queue should send the next frame.
+int32_t uCellMuxPrivateTxSchedule(uCellMuxPrivateTxScheduler_t *pScheduler)
+{
+    int32_t indexOrErrorCode = (int32_t) U_ERROR_COMMON_NOT_FOUND;
+    size_t numQueues = sizeof(pScheduler->queue) / sizeof(pScheduler->queue[0]);
+    uCellMuxPrivateTxQueue_t *pQueue;
+    size_t frameLength;
+    bool backlogged = true;
+
+    // Control frames go first
+    for (size_t x = 0; (x < numQueues) && (indexOrErrorCode < 0); x++) {
+        pQueue = &(pScheduler->queue[x]);
+        if ((pQueue->channel == U_CELL_MUX_PRIVATE_CHANNEL_ID_CONTROL) &&
+            txQueueIsReady(pQueue)) {
+            indexOrErrorCode = (int32_t) x;
+        }
     }
-    // We can only claim a decoded CMUX frame if
-    // there was nothing that needed discarding first.
-    if (getDiscard(parseHandle) == 0) {
-        pContextParser->address = address;
-        pContextParser->commandResponse = commandResponse;
-        pContextParser->type = type;
-        pContextParser->pollFinal = pollFinal;
-        pContextParser->informationLengthBytes = informationLengthBytes;
+
+    // Then deficit round robin for the rest: keep going around
+    // until a queue has enough credit, which will happen within
+    // a round or two provided that the quanta are not silly
+    while ((indexOrErrorCode < 0) && backlogged) {
+        backlogged = false;
+        for (size_t x = 0; (x < numQueues) && (indexOrErrorCode < 0); x++) {
+            pQueue = &(pScheduler->queue[pScheduler->index]);
+            if (pQueue->channel != U_CELL_MUX_PRIVATE_CHANNEL_ID_CONTROL) {
+                if (txQueueIsReady(pQueue) && (pQueue->quantumBytes > 0)) {
+                    backlogged = true;
+                    if (!pScheduler->quantumGiven) {
+                        pQueue->deficitBytes += pQueue->quantumBytes;
+                        pScheduler->quantumGiven = true;
+                    }
+                    frameLength = pQueue->frame[pQueue->frameIndex].length;
+                    if (pQueue->deficitBytes >= frameLength) {
+                        // Stay with this queue: it may have
+                        // credit for the next frame too
+                        pQueue->deficitBytes -= frameLength;
+                        indexOrErrorCode = (int32_t) pScheduler->index;
+                    }
+                } else if (pQueue->numFrames == 0) {
+                    // An empty queue keeps no credit
+                    pQueue->deficitBytes = 0;
+                }
+            }
+            if (indexOrErrorCode < 0) {
+                pScheduler->index++;
+                if (pScheduler->index >= numQueues) {
+                    pScheduler->index = 0;
+                }
+                pScheduler->quantumGiven = false;
+            }
+        }
     }
 
-    return (int32_t) U_ERROR_COMMON_SUCCESS;
+    return indexOrErrorCode;
 }
 
 /* ----------------------------------------------------------------
@@ -496,11 +532,17 @@ void uCellMuxPrivateRemoveContext(uCellPrivateInstance_t *pInstance)
                     uPortMutexDelete(pChannelContext->mutex);
                     uPortMutexDelete(pChannelContext->mutexUserDataWrite);
                     uPortMutexDelete(pChannelContext->mutexUserDataRead);
+                    uPortMutexDelete(pChannelContext->mutexRx);
                     uDeviceSerialDelete(pContext->pDeviceSerial[x]);
                 }
             }
+            for (size_t x = 0; x < sizeof(pContext->rxReader) / sizeof(pContext->rxReader[0]); x++) {
+                uRingBufferGiveReadHandle(&(pContext->ringBuffer), pContext->rxReader[x].readHandle);
+            }
             uRingBufferGiveReadHandle(&(pContext->ringBuffer), pContext->readHandle);
             uRingBufferDelete(&(pContext->ringBuffer));
+            uPortMutexDelete(pContext->mutexTxScheduler);
+            uPortMutexDelete(pContext->mutexTx);
             uPortEventQueueClose(pContext->eventQueueHandle);
             uPortFree(pInstance->pMuxContext);
             pInstance->pMuxContext = NULL;
@@ -102,11 +102,48 @@ extern "C" {
 
 #ifndef U_CELL_MUX_PRIVATE_BUFFER_LENGTH_BYTES
 /** The length of the raw buffer, enough to store at least
- * one maximum-length CMUX frame on each channel.
+ * one maximum-length CMUX frame on each channel, twice over:
+ * information fields are read by the channels from where they
+ * sit in this buffer, so room is needed for those that are waiting
+ * to be read as well as for those still arriving.
  */
 # define U_CELL_MUX_PRIVATE_BUFFER_LENGTH_BYTES ((U_CELL_MUX_PRIVATE_INFORMATION_LENGTH_MAX_BYTES +  \
                                                   U_CELL_MUX_PRIVATE_FRAME_OVERHEAD_MAX_BYTES)       \
-                                                  * U_CELL_MUX_MAX_CHANNELS)
+                                                  * U_CELL_MUX_MAX_CHANNELS * 2)
+#endif
+
+#ifndef U_CELL_MUX_PRIVATE_RX_SPANS_MAX
+/** The maximum number of received information fields that may be
+ * waiting, in place in the raw buffer, to be read by a channel; if
+ * another arrives, the oldest is copied into the receive buffer of
+ * the channel.
+ */
+# define U_CELL_MUX_PRIVATE_RX_SPANS_MAX 8
+#endif
+
+#ifndef U_CELL_MUX_PRIVATE_RX_SPAN_LAG_MAX_BYTES
+/** How far, in bytes of the multiplexed stream, the reader of a
+ * channel may fall behind the decoder while there are information
+ * fields waiting for it in the raw buffer; beyond this the channel
+ * is considered stalled and the information fields waiting for it
+ * are copied into its receive buffer so that the space they occupy
+ * in the raw buffer can be re-used.
+ */
+# define U_CELL_MUX_PRIVATE_RX_SPAN_LAG_MAX_BYTES (U_CELL_MUX_PRIVATE_BUFFER_LENGTH_BYTES / 2)
+#endif
+
+/** The maximum length of an encoded CMUX frame that this MCU sends
+ * on a channel.
+ */
+#define U_CELL_MUX_PRIVATE_TX_FRAME_LENGTH_MAX_BYTES (U_CELL_MUX_PRIVATE_INFORMATION_LENGTH_MAX_BYTES + \
+                                                      U_CELL_MUX_PRIVATE_FRAME_OVERHEAD_MAX_BYTES)
+
+#ifndef U_CELL_MUX_PRIVATE_TX_QUEUE_LENGTH_FRAMES
+/** The number of encoded CMUX frames that may be waiting to be
+ * sent on each channel; a writer with more than this to send waits
+ * for the scheduler to make room.
+ */
+# define U_CELL_MUX_PRIVATE_TX_QUEUE_LENGTH_FRAMES 2
 #endif
 
 #ifndef U_CELL_MUX_PRIVATE_CONTROL_CHANNEL_INFORMATION_LENGTH_BYTES
@@ -180,6 +217,13 @@ extern "C" {
 # define U_CELL_MUX_PRIVATE_RX_FLOW_OFF_THRESHOLD_PERCENT 40
 #endif
 
+#ifndef U_CELL_MUX_PRIVATE_RX_FLOW_ON_RETRY_MS
+/** Having told the far end that it can send us data again, how
+ * long to wait for it to acknowledge that before telling it again.
+ */
+# define U_CELL_MUX_PRIVATE_RX_FLOW_ON_RETRY_MS 1000
+#endif
+
 /* ----------------------------------------------------------------
  * TYPES
  * -------------------------------------------------------------- */
@@ -246,8 +290,103 @@ typedef struct {
                               process will set it to the next byte to be decoded from
                               pBuffer, which may be bufferSize if an error is being
                               returned. */
+    size_t informationOffset; /**< the decoding process will set this to the offset
+                                   of the information field from the start of the
+                                   decoded CMUX frame, so that it may be read
+                                   directly from a ring buffer. */
 } uCellMuxPrivateParserContext_t;
 
+/** The state of uCellMuxPrivateParseCmuxBlock() while a CMUX frame
+ * is arriving.
+ */
+typedef struct {
+    size_t count;        /**< the number of bytes of the frame seen so far. */
+    size_t headerLength; /**< opening flag to length field inclusive, zero
+                              until the length field has been seen. */
+    uint8_t fcs;
+    uint8_t address;
+    bool commandResponse;
+    uCellMuxPrivateFrameType_t type;
+    bool pollFinal;
+    size_t informationLengthBytes;
+} uCellMuxPrivateParserState_t;
+
+/** An information field that is waiting, in place in the ring buffer
+ * of a #uCellMuxPrivateContext_t, to be read by a channel.
+ */
+typedef struct {
+    size_t position; /**< the position of the unread part of the
+                          information field in the multiplexed stream,
+                          counted in bytes from when the ring buffer
+                          was last flushed. */
+    size_t length;   /**< the number of bytes of the information field
+                          still to be read. */
+} uCellMuxPrivateRxSpan_t;
+
+/** The view that a channel has of the ring buffer of a
+ * #uCellMuxPrivateContext_t: the decoder adds a span for each
+ * information field that arrives for the channel and the reader of
+ * the channel copies the information fields from the ring buffer
+ * straight into the buffer it is reading into, moving readHandle
+ * on as it goes.  While there are no spans the decoder keeps
+ * readHandle up with it, so that it does not hold on to data in the
+ * ring buffer.  Should be accessed only with mutexRx of the channel
+ * locked.
+ */
+typedef struct {
+    int32_t readHandle; /**< the read handle of the channel. */
+    size_t position;    /**< the position of readHandle in the
+                             multiplexed stream. */
+    uCellMuxPrivateRxSpan_t span[U_CELL_MUX_PRIVATE_RX_SPANS_MAX]; /**< the spans, in order of
+                                                                        arrival, starting at
+                                                                        spanIndex and wrapping. */
+    size_t spanIndex;   /**< the index of the oldest span in span[]. */
+    size_t numSpans;    /**< the number of spans in span[]. */
+    size_t spanBytes;   /**< the total length of the spans. */
+} uCellMuxPrivateRxReader_t;
+
+/** An encoded CMUX frame waiting to be sent.
+ */
+typedef struct {
+    char buffer[U_CELL_MUX_PRIVATE_TX_FRAME_LENGTH_MAX_BYTES]; /**< the encoded frame. */
+    size_t length;                 /**< the number of bytes at buffer. */
+    size_t informationLengthBytes; /**< the length of the information field
+                                        in the frame. */
+    int32_t queuedTimeMs;          /**< when the frame was queued. */
+} uCellMuxPrivateTxFrame_t;
+
+/** The frames waiting to be sent on a channel and the credit that
+ * the channel has with the scheduler, see uCellMuxPrivateTxSchedule().
+ */
+typedef struct {
+    uint8_t channel; /**< the channel that the queue belongs to. */
+    const volatile bool *pIsFlowControlledOff; /**< points to txIsFlowControlledOff in the
+                                                    traffic of the channel, may be NULL. */
+    uCellMuxPrivateTxFrame_t frame[U_CELL_MUX_PRIVATE_TX_QUEUE_LENGTH_FRAMES]; /**< the frames, in order,
+                                                                                    starting at frameIndex
+                                                                                    and wrapping. */
+    size_t frameIndex;      /**< the index of the oldest frame in frame[]. */
+    size_t numFrames;       /**< the number of frames in frame[]. */
+    size_t quantumBytes;    /**< the credit added to deficitBytes on each round. */
+    size_t deficitBytes;    /**< the credit remaining to the queue in this round. */
+    size_t sequenceQueued;  /**< incremented for each frame queued. */
+    size_t sequenceDone;    /**< incremented for each frame sent or thrown away. */
+    int32_t errorCode;      /**< set if sending a frame from the queue failed. */
+    int64_t latencyTotalMs; /**< the sum of the latencies of the frames sent. */
+    uCellMuxTxStatistics_t statistics; /**< queueLengthFrames is not kept here,
+                                            it is numFrames. */
+} uCellMuxPrivateTxQueue_t;
+
+/** The state of the transmit scheduler, see uCellMuxPrivateTxSchedule().
+ */
+typedef struct {
+    uCellMuxPrivateTxQueue_t queue[U_CELL_MUX_MAX_CHANNELS]; /**< one for each entry
+                                                                  in pDeviceSerial. */
+    size_t index;      /**< the queue that the round has reached. */
+    bool quantumGiven; /**< true if the queue at index has been given
+                            its quantum for this round. */
+} uCellMuxPrivateTxScheduler_t;
+
 /** The context data for CMUX mode.
  */
 typedef struct {
@@ -268,7 +407,14 @@ typedef struct {
     size_t holdingBufferIndex;                                    /**< where we are in holdingBuffer.*/
     char scratch[U_CELL_MUX_PRIVATE_SCRATCH_BUFFER_LENGTH_BYTES]; /** a scratch buffer that may be used like
                                                                       a stack variable. */
-    int32_t readHandle;
+    int32_t readHandle; /**< the read handle of the decoder. */
+    size_t readPosition; /**< the position of readHandle in the multiplexed stream. */
+    volatile bool rxStarved; /**< true if received data is waiting for room in ringBuffer,
+                                  which a channel reading from ringBuffer may make. */
+    uCellMuxPrivateRxReader_t rxReader[U_CELL_MUX_MAX_CHANNELS]; /**< one for each entry in pDeviceSerial. */
+    uPortMutexHandle_t mutexTx; /**< held while a frame is being written to the stream. */
+    uPortMutexHandle_t mutexTxScheduler; /**< protects txScheduler. */
+    uCellMuxPrivateTxScheduler_t txScheduler; /**< the frames waiting to be sent. */
     int32_t eventQueueHandle; /** an event queue to carry callbacks from the channels. */
 } uCellMuxPrivateContext_t;
 
@@ -283,7 +429,13 @@ typedef struct {
 /** Structure to hold stuff to do with data transfer for a channel.
  */
 typedef struct {
-    char *pRxBufferStart;     /**< this buffer stores the UIH information fields received. */
+    uCellMuxPrivateRxReader_t *pRxReader; /**< the information fields received that are
+                                               still in the ring buffer. */
+    uCellMuxPrivateTxQueue_t *pTxQueue; /**< the frames waiting to be sent. */
+    char *pRxBufferStart;     /**< this buffer stores the UIH information fields received
+                                   that had to be copied out of the ring buffer, which
+                                   are always older than those at pRxReader; the
+                                   total of the two is limited to rxBufferSizeBytes. */
     bool rxBufferIsMalloced;
     size_t rxBufferSizeBytes;
     char *pRxBufferWrite;
@@ -294,6 +446,9 @@ typedef struct {
     bool discardOnOverflow;
     bool txIsFlowControlledOff; /**< remote-end doesn't want us to send to it. */
     bool rxIsFlowControlledOff; /**< we don't want the remote-end to send stuff to us. */
+    bool rxFlowOnSent; /**< we have told the remote-end it can send again but it has
+                            not yet acknowledged that. */
+    int32_t rxFlowOnTimeMs; /**< when rxFlowOnSent was last set. */
 } uCellMuxPrivateTraffic_t;
 
 /** The context data for a single CMUX channel.
@@ -306,6 +461,8 @@ typedef struct {
     uPortMutexHandle_t mutex;
     uPortMutexHandle_t mutexUserDataWrite;
     uPortMutexHandle_t mutexUserDataRead;
+    uPortMutexHandle_t mutexRx; /**< protects the receive side of traffic
+                                     between the decoder and the reader. */
     uCellMuxPrivateTraffic_t traffic;
     uCellMuxPrivateEventCallback_t eventCallback;
 } uCellMuxPrivateChannelContext_t;
@@ -499,35 +656,73 @@ int32_t uCellMuxPrivateEncode(uint8_t address, uCellMuxPrivateFrameType_t type,
                               bool pollFinal, const char *pInformation,
                               size_t informationLengthBytes, char *pBuffer);
 
-/** Parse [a ring-buffer] for a CMUX frame.  The function signature is such that
- * this can be used as a ring-buffer parser; pUserParam MUST be a pointer
- * to a structure of type #uCellMuxPrivateParserContext_t.  However, if
- * parseHandle is NULL, data will be taken out of the linear buffer in
- * #uCellMuxPrivateParserContext_t instead, allowing the buffer to be parsed
- * (e.g. for control frames) instead of the ring-buffer, see
- * uCellMuxPrivateParseCmux().  On entry the type field in
- * #uCellMuxPrivateParserContext_t should be set to
- * #U_CELL_MUX_PRIVATE_FRAME_TYPE_NONE, on return it will be set to the decoded
- * CMUX frame type if one was found.  The address field of
- * #uCellMuxPrivateParserContext_t may be set to a specific address if only
+/** Parse a linear buffer for a CMUX frame, e.g. for control frames;
+ * a ring buffer should be parsed with uCellMuxPrivateParseCmuxBlock()
+ * instead.  The data is taken from the pBuffer field of pContext, starting
+ * at bufferIndex, which is moved on past a decoded CMUX frame or, if there
+ * is no CMUX frame at bufferIndex, by one byte.  On entry the type field
+ * of pContext should be set to #U_CELL_MUX_PRIVATE_FRAME_TYPE_NONE, on
+ * return it will be set to the decoded CMUX frame type if one was found.
+ * The address field of pContext may be set to a specific address if only
  * that address is of interest, else it should be set to
- * #U_CELL_MUX_PRIVATE_ADDRESS_ANY and this will be replaced by the address of
- * the decoded CMUX frame when one is found.
+ * #U_CELL_MUX_PRIVATE_ADDRESS_ANY and this will be replaced by the address
+ * of the decoded CMUX frame when one is found.  If pInformation is
+ * non-NULL the information field is copied there, up to the
+ * informationLengthBytes given.
+ *
+ * @param[in,out] pContext the parser context, cannot be NULL.
+ * @return                 zero on success, else #U_ERROR_COMMON_NOT_FOUND
+ *                         if nothing was found or #U_ERROR_COMMON_TIMEOUT if
+ *                         a sniff of a thing was found but not enough to
+ *                         decode.
+ */
+int32_t uCellMuxPrivateParseCmux(uCellMuxPrivateParserContext_t *pContext);
+
+/** Block parser for CMUX frames, for use with uRingBufferParseBlockHandle(),
+ * the sync byte being the 0xF9 frame marker and the state being a
+ * #uCellMuxPrivateParserState_t.  pUserParam MUST be a pointer to a
+ * structure of type #uCellMuxPrivateParserContext_t, set up as for
+ * uCellMuxPrivateParseCmux() except that pBuffer is not used and the
+ * information field is never copied to pInformation: read it from the
+ * ring buffer at informationOffset instead.
+ *
+ * @param[in,out] pState the state of the parser.
+ * @param[in] pData      the next block of data.
+ * @param length         the number of bytes at pData.
+ * @param[out] pUserParam a pointer to a #uCellMuxPrivateParserContext_t.
+ * @return               the number of bytes of pData that completed a
+ *                       CMUX frame, else #U_ERROR_COMMON_NOT_FOUND if this
+ *                       is not a CMUX frame or #U_ERROR_COMMON_TIMEOUT if
+ *                       more data is needed.
+ */
+int32_t uCellMuxPrivateParseCmuxBlock(void *pState, const char *pData,
+                                      size_t length, void *pUserParam);
+
+/* ----------------------------------------------------------------
+ * FUNCTIONS: TRANSMIT SCHEDULING (SEE U_CELL_MUX_PRIVATE.C)
+ * -------------------------------------------------------------- */
+
+/** Decide which queue of the transmit scheduler should send the next
+ * frame.  The control channel always goes first; the other channels
+ * are served by deficit round robin: on each round a queue with
+ * frames waiting is given quantumBytes of credit and may send frames
+ * while the encoded length of the frame at the head of the queue is
+ * no more than its credit.  A queue that is flow controlled off is
+ * skipped, keeping its credit; a queue that is empty loses its credit.
+ * The frame is not removed from the queue (and the caller should
+ * not remove it until it has been sent).
+ *
+ * Note: mutexTxScheduler of the context that pScheduler belongs to,
+ * if there is one, should be locked before this is called.
  *
- * @param parseHandle    the parse handle of the ring buffer to read from,
- *                       NULL to use the pBuffer field of the second parameter
- *                       instead.
- * @param[in] pUserParam the user parameter, a void * in order to match
- *                       the function signature of a generic ring-buffer parser
- *                       so that this function can be used with
- *                       uRingBufferParseHandle() however it _must_ be a pointer
- *                       to a structure of type #uCellMuxPrivateParserContext_t.
- * @return               a positive integer on success, else
- *                       #U_ERROR_COMMON_NOT_FOUND if nothing was found or
- *                       #U_ERROR_COMMON_TIMEOUT if a sniff of a thing was found
- *                       but not enough to decode.
- */
-int32_t uCellMuxPrivateParseCmux(uParseHandle_t parseHandle, void *pUserParam);
+ * @param[in,out] pScheduler the scheduler, cannot be NULL.
+ * @return                   the index into the queue array of
+ *                           pScheduler of the queue that should send
+ *                           the next frame, else
+ *                           #U_ERROR_COMMON_NOT_FOUND if there is
+ *                           nothing that can be sent.
+ */
+int32_t uCellMuxPrivateTxSchedule(uCellMuxPrivateTxScheduler_t *pScheduler);
 
 /* ----------------------------------------------------------------
  * FUNCTIONS: MISC (SEE U_CELL_MUX_PRIVATE.C)
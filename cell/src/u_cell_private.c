@@ -47,6 +47,8 @@
 
 #include "u_at_client.h"
 
+#include "u_hex_bin_convert.h"
+
 #include "u_sock.h"
 
 #include "u_security.h"
@@ -1688,6 +1690,91 @@ int32_t uCellPrivateGetIdStr(uAtClientHandle_t  atHandle,
     return errorCodeOrSize;
 }
 
+// Read a quoted binary or hex-encoded data field zero-copy.
+int32_t uCellPrivateReadQuotedData(uAtClientHandle_t atHandle,
+                                   char *pData, size_t dataSize,
+                                   size_t indicatedSize, bool isHex)
+{
+    int32_t errorCodeOrSize = 0;
+    size_t toRead = indicatedSize;
+    size_t written = 0;
+    const char *pSpan;
+    size_t spanLength;
+    size_t x;
+    char nibbles[2];
+    size_t numNibbles = 0;
+
+    if (pData == NULL) {
+        dataSize = 0;
+    }
+    if (isHex) {
+        toRead *= 2;
+    }
+
+    // The data may contain anything so don't stop for anything!
+    uAtClientIgnoreStopTag(atHandle);
+    // Get the leading quote mark out of the way
+    uAtClientReadBytes(atHandle, NULL, 1, true);
+    while ((toRead > 0) && (errorCodeOrSize >= 0)) {
+        errorCodeOrSize = uAtClientReadBytesSpan(atHandle, &pSpan, toRead);
+        if (errorCodeOrSize == 0) {
+            // Can only happen if we've hit a stop tag, which
+            // shouldn't be possible, but just in case
+            errorCodeOrSize = (int32_t) U_CELL_ERROR_AT;
+        }
+        if (errorCodeOrSize > 0) {
+            spanLength = (size_t) errorCodeOrSize;
+            toRead -= spanLength;
+            if (!isHex) {
+                x = spanLength;
+                if (x > dataSize - written) {
+                    x = dataSize - written;
+                }
+                if (x > 0) {
+                    memcpy(pData + written, pSpan, x);
+                    written += x;
+                }
+            } else {
+                // A hex pair may be split across two spans
+                while (spanLength > 0) {
+                    if ((numNibbles > 0) || (spanLength == 1)) {
+                        nibbles[numNibbles] = *pSpan;
+                        numNibbles++;
+                        pSpan++;
+                        spanLength--;
+                        if (numNibbles == sizeof(nibbles)) {
+                            if (written < dataSize) {
+                                written += uHexToBin(nibbles, sizeof(nibbles),
+                                                     pData + written);
+                            }
+                            numNibbles = 0;
+                        }
+                    } else {
+                        x = spanLength / 2;
+                        if (x > dataSize - written) {
+                            x = dataSize - written;
+                        }
+                        if (x > 0) {
+                            written += uHexToBin(pSpan, x * 2, pData + written);
+                        }
+                        x = (spanLength / 2) * 2;
+                        pSpan += x;
+                        spanLength -= x;
+                    }
+                }
+            }
+        }
+    }
+    // Make sure to wait for the stop tag before we finish
+    uAtClientRestoreStopTag(atHandle);
+
+    if (errorCodeOrSize >= 0) {
+        errorCodeOrSize = (int32_t) written;
+    }
+
+    return errorCodeOrSize;
+}
+
 // Updates the module related settings for the given instance.
 void uCellPrivateModuleSpecificSetting(uCellPrivateInstance_t *pInstance)
 {
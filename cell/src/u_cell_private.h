@@ -995,6 +995,33 @@ int32_t uCellPrivateGetIdStr(uAtClientHandle_t atHandle,
                              const char *pCmd, char *pBuffer,
                              size_t bufferSize);
 
+/** Read the quoted binary or hex-encoded data field of a response
+ * such as +USORD, +USORF or +URDFILE, taking the data straight from
+ * the AT client receive buffer, i.e. without an intermediate copy or
+ * a hex buffer.  Should be called with the AT client locked, after
+ * uAtClientResponseStart() and after any preceding parameters have
+ * been read; the leading quote mark is consumed here and the stop tag
+ * is restored before returning so that uAtClientResponseStop() will
+ * take care of the trailing quote mark.  Where the module indicates
+ * more data than there is room for in pData the remainder is read
+ * and thrown away.
+ *
+ * @param atHandle      the handle of the AT client that is talking
+ *                      to the module.
+ * @param[out] pData    a pointer to dataSize bytes of storage into
+ *                      which the (decoded) data will be written; may
+ *                      be NULL if dataSize is zero.
+ * @param dataSize      the amount of storage at pData.
+ * @param indicatedSize the number of data bytes the module indicated
+ *                      it would send, AFTER hex decoding.
+ * @param isHex         true if the data is hex-encoded.
+ * @return              on success the number of bytes written to
+ *                      pData, else negative error code.
+ */
+int32_t uCellPrivateReadQuotedData(uAtClientHandle_t atHandle,
+                                   char *pData, size_t dataSize,
+                                   size_t indicatedSize, bool isHex);
+
 /** Updates the module related settings for the given instance.
  *
  * Note:  gUCellPrivateMutex should be locked before this is called.
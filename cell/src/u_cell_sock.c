@@ -1353,8 +1353,6 @@ int32_t uCellSockReceiveFrom(uDeviceHandle_t cellHandle,
     int32_t x;
     int32_t port = -1;
     int32_t receivedSize = -1;
-    int32_t readLength;
-    char *pHexBuffer = NULL;
 
     buffer[0] = 0;  // In case of slip-ups
 
@@ -1446,48 +1444,11 @@ int32_t uCellSockReceiveFrom(uDeviceHandle_t cellHandle,
                         dataSizeBytes = receivedSize;
                     }
                     if (receivedSize > 0) {
-                        if (pInstance->socketsHexMode) {
-                            // In hex mode we need a buffer to dump
-                            // the hex into and then we can decode it
-                            negErrnoLocalOrSize = -U_SOCK_ENOMEM;
-                            //lint -e{647} Suppress suspicious truncation
-                            pHexBuffer = (char *) pUPortMalloc(receivedSize * 2 + 1);  // +1 for terminator
-                        }
-                        if (!pInstance->socketsHexMode || (pHexBuffer != NULL)) {
-                            if (pHexBuffer != NULL) {
-                                // In hex mode we can read in the whole string
-                                //lint -e{647} Suppress suspicious truncation
-                                readLength = uAtClientReadString(atHandle, pHexBuffer,
-                                                                 receivedSize * 2 + 1, false);
-                                if (readLength > 0) {
-                                    x = (int32_t) dataSizeBytes * 2;
-                                    if (readLength > x) {
-                                        readLength = x;
-                                    }
-                                    uHexToBin(pHexBuffer, readLength, (char *) pData);
-                                }
-                                // Free memory
-                                uPortFree(pHexBuffer);
-                            } else {
-                                // Binary mode, don't stop for anything!
-                                uAtClientIgnoreStopTag(atHandle);
-                                // Get the leading quote mark out of the way
-                                uAtClientReadBytes(atHandle, NULL, 1, true);
-                                // Now read out all the actual data,
-                                // first the bit we want
-                                uAtClientReadBytes(atHandle, (char *) pData,
-                                                   dataSizeBytes, true);
-                                if (receivedSize > (int32_t) dataSizeBytes) {
-                                    //...and then the rest poured away to NULL
-                                    uAtClientReadBytes(atHandle, NULL,
-                                                       receivedSize -
-                                                       dataSizeBytes, true);
-                                }
-                                // Make sure to wait for the stop tag before
-                                // we finish
-                                uAtClientRestoreStopTag(atHandle);
-                            }
-                        }
+                        // Read the data, the bit we want and then
+                        // the rest poured away
+                        uCellPrivateReadQuotedData(atHandle, (char *) pData,
+                                                   dataSizeBytes, receivedSize,
+                                                   pInstance->socketsHexMode);
                     }
                     uAtClientResponseStop(atHandle);
                     // BEFORE unlocking, work out what's happened.
@@ -1683,8 +1644,6 @@ int32_t uCellSockRead(uDeviceHandle_t cellHandle,
     int32_t thisWantedReceiveSize;
     int32_t thisActualReceiveSize;
     int32_t totalReceivedSize = 0;
-    int32_t readLength;
-    char *pHexBuffer = NULL;
 
     // Find the instance
     pInstance = pUCellPrivateGetInstance(cellHandle);
@@ -1763,46 +1722,13 @@ int32_t uCellSockRead(uDeviceHandle_t cellHandle,
                             thisActualReceiveSize = (int32_t) dataSizeBytes;
                         }
                         if (thisActualReceiveSize > 0) {
-                            if (pInstance->socketsHexMode) {
-                                // In hex mode we need a buffer to dump
-                                // the hex into and then we can decode it
-                                negErrnoLocalOrSize = -U_SOCK_ENOMEM;
-                                //lint -e{647} Suppress suspicious truncation
-                                pHexBuffer = (char *) pUPortMalloc(thisActualReceiveSize * 2 + 1);  // +1 for terminator
-                            }
-                            if (!pInstance->socketsHexMode || (pHexBuffer != NULL)) {
-                                negErrnoLocalOrSize = U_SOCK_ENONE;
-                                if (pHexBuffer != NULL) {
-                                    // In hex mode we can read in the whole string
-                                    //lint -e{647} Suppress suspicious truncation
-                                    readLength = uAtClientReadString(atHandle, pHexBuffer,
-                                                                     thisActualReceiveSize * 2 + 1,
-                                                                     false);
-                                    if (readLength > 0) {
-                                        x = ((int32_t) dataSizeBytes) * 2;
-                                        if (readLength > x) {
-                                            readLength = x;
-                                        }
-                                        uHexToBin(pHexBuffer, readLength,
-                                                  (char *) pData + totalReceivedSize);
-                                    }
-                                    // Free memory
-                                    uPortFree(pHexBuffer);
-                                } else {
-                                    // Binary mode, don't stop for anything!
-                                    uAtClientIgnoreStopTag(atHandle);
-                                    // Get the leading quote mark out of the way
-                                    uAtClientReadBytes(atHandle, NULL, 1, true);
-                                    // Now read out the available data
-                                    uAtClientReadBytes(atHandle,
+                            // Read out the available data
+                            uCellPrivateReadQuotedData(atHandle,
                                                        (char *) pData +
                                                        totalReceivedSize,
-                                                       thisActualReceiveSize, true);
-                                    // Make sure we wait for the stop tag before
-                                    // going around again
-                                    uAtClientRestoreStopTag(atHandle);
-                                }
-                            }
+                                                       thisActualReceiveSize,
+                                                       thisActualReceiveSize,
+                                                       pInstance->socketsHexMode);
                         }
                         uAtClientResponseStop(atHandle);
                         // BEFORE unlocking, work out what's happened.
@@ -106,6 +106,26 @@
 # define U_CELL_MUX_PRIVATE_TEST_FILL_CHAR 0xFF
 #endif
 
+#ifndef U_CELL_MUX_PRIVATE_TEST_RING_BUFFER_SIZE_BYTES
+/** The size of ring buffer to use when testing the block parser.
+ */
+# define U_CELL_MUX_PRIVATE_TEST_RING_BUFFER_SIZE_BYTES 1024
+#endif
+
+#ifndef U_CELL_MUX_PRIVATE_TEST_RING_BUFFER_NUM_FRAMES
+/** The number of frames to push through the ring buffer when
+ * testing the block parser.
+ */
+# define U_CELL_MUX_PRIVATE_TEST_RING_BUFFER_NUM_FRAMES 200
+#endif
+
+#ifndef U_CELL_MUX_PRIVATE_TEST_TX_SCHEDULE_NUM_FRAMES
+/** The number of frames to schedule when testing the share of
+ * the transmit scheduler.
+ */
+# define U_CELL_MUX_PRIVATE_TEST_TX_SCHEDULE_NUM_FRAMES 300
+#endif
+
 /* ----------------------------------------------------------------
  * TYPES
  * -------------------------------------------------------------- */
@@ -145,6 +165,34 @@ const char *pBool(bool isTrue)
     return isTrue ? "true" : "false";
 }
 
+// Add a frame of the given encoded length to a transmit queue.
+static bool txQueueAdd(uCellMuxPrivateTxQueue_t *pQueue, size_t length)
+{
+    size_t numFramesMax = sizeof(pQueue->frame) / sizeof(pQueue->frame[0]);
+    bool success = false;
+
+    if (pQueue->numFrames < numFramesMax) {
+        pQueue->frame[(pQueue->frameIndex + pQueue->numFrames) % numFramesMax].length = length;
+        pQueue->numFrames++;
+        success = true;
+    }
+
+    return success;
+}
+
+// Remove the frame at the head of a transmit queue, returning
+// its length.
+static size_t txQueueRemove(uCellMuxPrivateTxQueue_t *pQueue)
+{
+    size_t length = pQueue->frame[pQueue->frameIndex].length;
+
+    pQueue->frameIndex = (pQueue->frameIndex + 1) % (sizeof(pQueue->frame) /
+                                                     sizeof(pQueue->frame[0]));
+    pQueue->numFrames--;
+
+    return length;
+}
+
 /* ----------------------------------------------------------------
  * PUBLIC FUNCTIONS
  * -------------------------------------------------------------- */
@@ -224,7 +272,7 @@ U_PORT_TEST_FUNCTION("[cellMuxPrivate]", "cellMuxPrivateBackToBack")
             z = (int32_t) U_ERROR_COMMON_NOT_FOUND;
             while ((parserContext.bufferIndex < parserContext.bufferSize) &&
                    (z < 0) && (z != (int32_t) U_ERROR_COMMON_TIMEOUT)) {
-                z = uCellMuxPrivateParseCmux(NULL, &parserContext);
+                z = uCellMuxPrivateParseCmux(&parserContext);
             }
 
             if (parserContext.informationLengthBytes != informationLength) {
@@ -277,6 +325,24 @@ U_PORT_TEST_FUNCTION("[cellMuxPrivate]", "cellMuxPrivateBackToBack")
         uPortTaskBlock(U_CFG_OS_YIELD_MS);
     }
 
+    // Give the decoder half of a long frame for an address other
+    // than the one it is looking for: it should be rejected straight
+    // away rather than waiting for the rest, which would never fit
+    // into a buffer the size of the control channel's
+    memset(pInformation, U_CELL_MUX_PRIVATE_TEST_FILL_CHAR, U_CELL_MUX_PRIVATE_INFORMATION_LENGTH_MAX_BYTES);
+    z = uCellMuxPrivateEncode(2, U_CELL_MUX_PRIVATE_FRAME_TYPE_UIH, false, pInformation,
+                              U_CELL_MUX_PRIVATE_INFORMATION_LENGTH_MAX_BYTES,
+                              parserContext.pBuffer);
+    U_PORT_TEST_ASSERT(z > 0);
+    parserContext.bufferSize = z / 2;
+    parserContext.bufferIndex = 0;
+    parserContext.address = U_CELL_MUX_PRIVATE_CHANNEL_ID_CONTROL;
+    parserContext.type = U_CELL_MUX_PRIVATE_FRAME_TYPE_NONE;
+    parserContext.pInformation = NULL;
+    parserContext.informationLengthBytes = 0;
+    U_PORT_TEST_ASSERT(uCellMuxPrivateParseCmux(&parserContext) == (int32_t) U_ERROR_COMMON_NOT_FOUND);
+    U_PORT_TEST_ASSERT(parserContext.bufferIndex == 1);
+
     // Free memory
     uPortFree(parserContext.pBuffer);
     uPortFree(pInformation);
@@ -291,4 +357,271 @@ U_PORT_TEST_FUNCTION("[cellMuxPrivate]", "cellMuxPrivateBackToBack")
     uTestUtilResourceCheck(U_TEST_PREFIX, NULL, true);
 }
 
+/** Test the CMUX block parser on frames arriving in dribs and drabs
+ * through a ring buffer, with rubbish in between.
+ *
+ * IMPORTANT: see notes in u_cfg_test_platform_specific.h for the
+ * naming rules that must be followed when using the
+ * U_PORT_TEST_FUNCTION() macro.
+ */
+U_PORT_TEST_FUNCTION("[cellMuxPrivate]", "cellMuxPrivateRingBuffer")
+{
+    static const uRingBufferBlockParser_t parserList[] = {
+        {uCellMuxPrivateParseCmuxBlock, "\xf9", 1, sizeof(uCellMuxPrivateParserState_t)},
+        {NULL, NULL, 0, 0}
+    };
+    int32_t resourceCount;
+    uRingBuffer_t ringBuffer;
+    char *pLinearBuffer;
+    char *pStream;
+    char *pInformation;
+    size_t streamLength = 0;
+    size_t streamIndex = 0;
+    size_t informationLength;
+    size_t chunkLength;
+    size_t x;
+    int32_t readHandle;
+    int32_t numFramesDecoded = 0;
+    int32_t errorCodeOrLength;
+    uCellMuxPrivateParserContext_t parserContext;
+
+    // Obtain the initial resource count
+    resourceCount = uTestUtilGetDynamicResourceCount();
+
+    U_PORT_TEST_ASSERT(uPortInit() == 0);
+
+    pLinearBuffer = (char *) pUPortMalloc(U_CELL_MUX_PRIVATE_TEST_RING_BUFFER_SIZE_BYTES);
+    U_PORT_TEST_ASSERT(pLinearBuffer != NULL);
+    pStream = (char *) pUPortMalloc(U_CELL_MUX_PRIVATE_TEST_RING_BUFFER_NUM_FRAMES *
+                                    (U_CELL_MUX_PRIVATE_FRAME_OVERHEAD_MAX_BYTES + 200 + 3));
+    U_PORT_TEST_ASSERT(pStream != NULL);
+    pInformation = (char *) pUPortMalloc(200);
+    U_PORT_TEST_ASSERT(pInformation != NULL);
+    U_PORT_TEST_ASSERT(uRingBufferCreateWithReadHandle(&ringBuffer, pLinearBuffer,
+                                                       U_CELL_MUX_PRIVATE_TEST_RING_BUFFER_SIZE_BYTES,
+                                                       1) == 0);
+    uRingBufferSetReadRequiresHandle(&ringBuffer, true);
+    readHandle = uRingBufferTakeReadHandle(&ringBuffer);
+    U_PORT_TEST_ASSERT(readHandle > 0);
+
+    // Build a stream of UIH frames, the information field of frame
+    // N being (N % 200) bytes of N, with a bit of rubbish, including
+    // an occasional stray frame marker, between frames
+    for (size_t y = 0; y < U_CELL_MUX_PRIVATE_TEST_RING_BUFFER_NUM_FRAMES; y++) {
+        informationLength = y % 200;
+        memset(pInformation, (int) y, informationLength);
+        errorCodeOrLength = uCellMuxPrivateEncode((uint8_t) (y % 4), U_CELL_MUX_PRIVATE_FRAME_TYPE_UIH,
+                                                  false, pInformation, informationLength,
+                                                  pStream + streamLength);
+        U_PORT_TEST_ASSERT(errorCodeOrLength > 0);
+        streamLength += errorCodeOrLength;
+        *(pStream + streamLength) = 'x';
+        streamLength++;
+        if ((y % 3) == 0) {
+            *(pStream + streamLength) = (char) 0xf9;
+            streamLength++;
+        }
+    }
+
+    // Feed the stream into the ring buffer in odd-sized chunks,
+    // parsing as we go
+    for (size_t y = 0; streamIndex < streamLength; y++) {
+        chunkLength = (y % 37) + 1;
+        if (chunkLength > streamLength - streamIndex) {
+            chunkLength = streamLength - streamIndex;
+        }
+        U_PORT_TEST_ASSERT(uRingBufferAdd(&ringBuffer, pStream + streamIndex, chunkLength));
+        streamIndex += chunkLength;
+        do {
+            memset(&parserContext, 0, sizeof(parserContext));
+            parserContext.type = U_CELL_MUX_PRIVATE_FRAME_TYPE_NONE;
+            parserContext.address = U_CELL_MUX_PRIVATE_ADDRESS_ANY;
+            errorCodeOrLength = uRingBufferParseBlockHandle(&ringBuffer, readHandle,
+                                                            parserList, &parserContext);
+            if ((errorCodeOrLength > 0) &&
+                (parserContext.type != U_CELL_MUX_PRIVATE_FRAME_TYPE_NONE)) {
+                // Check the frame and its information field
+                x = numFramesDecoded % 200;
+                U_PORT_TEST_ASSERT(parserContext.type == U_CELL_MUX_PRIVATE_FRAME_TYPE_UIH);
+                U_PORT_TEST_ASSERT(parserContext.address == numFramesDecoded % 4);
+                U_PORT_TEST_ASSERT(parserContext.informationLengthBytes == x);
+                U_PORT_TEST_ASSERT(uRingBufferPeekHandle(&ringBuffer, readHandle, pInformation,
+                                                         x, parserContext.informationOffset) == x);
+                for (size_t z = 0; z < x; z++) {
+                    U_PORT_TEST_ASSERT(*(pInformation + z) == (char) numFramesDecoded);
+                }
+                numFramesDecoded++;
+            }
+            if (errorCodeOrLength > 0) {
+                // Remove the frame or the rubbish
+                U_PORT_TEST_ASSERT(uRingBufferReadHandle(&ringBuffer, readHandle, NULL,
+                                                         errorCodeOrLength) == errorCodeOrLength);
+            }
+        } while (errorCodeOrLength > 0);
+        U_PORT_TEST_ASSERT(errorCodeOrLength == (int32_t) U_ERROR_COMMON_TIMEOUT);
+    }
+    U_TEST_PRINT_LINE("%d CMUX frame(s) decoded from a %d byte stream.",
+                      numFramesDecoded, streamLength);
+    U_PORT_TEST_ASSERT(numFramesDecoded == U_CELL_MUX_PRIVATE_TEST_RING_BUFFER_NUM_FRAMES);
+
+    uRingBufferGiveReadHandle(&ringBuffer, readHandle);
+    uRingBufferDelete(&ringBuffer);
+    uPortFree(pInformation);
+    uPortFree(pStream);
+    uPortFree(pLinearBuffer);
+
+    uPortDeinit();
+
+    // Check for resource leaks
+    resourceCount = uTestUtilGetDynamicResourceCount() - resourceCount;
+    U_TEST_PRINT_LINE("we have leaked %d resources(s).", resourceCount);
+    U_PORT_TEST_ASSERT(resourceCount <= 0);
+    // Printed for information: asserting happens in the postamble
+    uTestUtilResourceCheck(U_TEST_PREFIX, NULL, true);
+}
+
+/** Test the CMUX transmit scheduler: control frames first, the
+ * other channels sharing according to their weights, no-one waiting
+ * long behind a busy channel and flow control being respected.
+ *
+ * IMPORTANT: see notes in u_cfg_test_platform_specific.h for the
+ * naming rules that must be followed when using the
+ * U_PORT_TEST_FUNCTION() macro.
+ */
+U_PORT_TEST_FUNCTION("[cellMuxPrivate]", "cellMuxPrivateTxSchedule")
+{
+    int32_t resourceCount;
+    uCellMuxPrivateTxScheduler_t *pScheduler;
+    uCellMuxPrivateTxQueue_t *pControl;
+    uCellMuxPrivateTxQueue_t *pAt;
+    uCellMuxPrivateTxQueue_t *pPpp;
+    uCellMuxPrivateTxQueue_t *pGnss;
+    volatile bool gnssIsFlowControlledOff = true;
+    size_t bytesSent[4] = {0};
+    int32_t index;
+    size_t x;
+
+    // Obtain the initial resource count
+    resourceCount = uTestUtilGetDynamicResourceCount();
+
+    U_PORT_TEST_ASSERT(uPortInit() == 0);
+
+    U_PORT_TEST_ASSERT(U_CELL_MUX_MAX_CHANNELS >= 4);
+    pScheduler = (uCellMuxPrivateTxScheduler_t *) pUPortMalloc(sizeof(*pScheduler));
+    U_PORT_TEST_ASSERT(pScheduler != NULL);
+    memset(pScheduler, 0, sizeof(*pScheduler));
+    // Deliberately not in channel order
+    pPpp = &(pScheduler->queue[0]);
+    pPpp->channel = U_CELL_MUX_PRIVATE_CHANNEL_ID_PPP;
+    pPpp->quantumBytes = U_CELL_MUX_PRIVATE_TX_FRAME_LENGTH_MAX_BYTES;
+    pControl = &(pScheduler->queue[1]);
+    pControl->channel = U_CELL_MUX_PRIVATE_CHANNEL_ID_CONTROL;
+    pAt = &(pScheduler->queue[2]);
+    pAt->channel = U_CELL_MUX_PRIVATE_CHANNEL_ID_AT;
+    pAt->quantumBytes = U_CELL_MUX_PRIVATE_TX_FRAME_LENGTH_MAX_BYTES * 2;
+    pGnss = &(pScheduler->queue[3]);
+    pGnss->channel = 3;
+    pGnss->quantumBytes = U_CELL_MUX_PRIVATE_TX_FRAME_LENGTH_MAX_BYTES;
+    pGnss->pIsFlowControlledOff = &gnssIsFlowControlledOff;
+
+    // Nothing to send
+    U_PORT_TEST_ASSERT(uCellMuxPrivateTxSchedule(pScheduler) == (int32_t) U_ERROR_COMMON_NOT_FOUND);
+
+    // The GNSS channel is flow controlled off so, even with
+    // something to send, there is still nothing to send
+    U_PORT_TEST_ASSERT(txQueueAdd(pGnss, 20));
+    U_PORT_TEST_ASSERT(uCellMuxPrivateTxSchedule(pScheduler) == (int32_t) U_ERROR_COMMON_NOT_FOUND);
+
+    // Keep the AT and PPP queues full of maximum-length frames: AT,
+    // with twice the weight, should get twice the share, to within
+    // a quantum
+    U_TEST_PRINT_LINE("testing share.");
+    for (x = 0; x < U_CELL_MUX_PRIVATE_TEST_TX_SCHEDULE_NUM_FRAMES; x++) {
+        while (txQueueAdd(pAt, U_CELL_MUX_PRIVATE_TX_FRAME_LENGTH_MAX_BYTES)) {}
+        while (txQueueAdd(pPpp, U_CELL_MUX_PRIVATE_TX_FRAME_LENGTH_MAX_BYTES)) {}
+        index = uCellMuxPrivateTxSchedule(pScheduler);
+        U_PORT_TEST_ASSERT((index == 0) || (index == 2));
+        bytesSent[index] += txQueueRemove(&(pScheduler->queue[index]));
+    }
+    U_TEST_PRINT_LINE("AT sent %d byte(s), PPP sent %d byte(s).", bytesSent[2], bytesSent[0]);
+    U_PORT_TEST_ASSERT(bytesSent[2] + bytesSent[0] == U_CELL_MUX_PRIVATE_TEST_TX_SCHEDULE_NUM_FRAMES *
+                       U_CELL_MUX_PRIVATE_TX_FRAME_LENGTH_MAX_BYTES);
+    U_PORT_TEST_ASSERT(bytesSent[2] <= (bytesSent[0] * 2) + pAt->quantumBytes);
+    U_PORT_TEST_ASSERT(bytesSent[2] + pAt->quantumBytes >= bytesSent[0] * 2);
+
+    // A control frame always goes next
+    U_TEST_PRINT_LINE("testing control channel priority.");
+    U_PORT_TEST_ASSERT(txQueueAdd(pControl, 10));
+    U_PORT_TEST_ASSERT(uCellMuxPrivateTxSchedule(pScheduler) == 1);
+    txQueueRemove(pControl);
+
+    // Let the AT queue empty while PPP stays busy, then add one AT
+    // frame: it should go after no more than one PPP frame
+    U_TEST_PRINT_LINE("testing latency behind a busy channel.");
+    for (x = 0; x < U_CELL_MUX_PRIVATE_TEST_TX_SCHEDULE_NUM_FRAMES; x++) {
+        while (txQueueAdd(pPpp, U_CELL_MUX_PRIVATE_TX_FRAME_LENGTH_MAX_BYTES)) {}
+        index = uCellMuxPrivateTxSchedule(pScheduler);
+        U_PORT_TEST_ASSERT(index >= 0);
+        txQueueRemove(&(pScheduler->queue[index]));
+    }
+    U_PORT_TEST_ASSERT(pAt->numFrames == 0);
+    for (size_t y = 0; y < 10; y++) {
+        U_PORT_TEST_ASSERT(txQueueAdd(pAt, 20));
+        x = 0;
+        do {
+            while (txQueueAdd(pPpp, U_CELL_MUX_PRIVATE_TX_FRAME_LENGTH_MAX_BYTES)) {}
+            index = uCellMuxPrivateTxSchedule(pScheduler);
+            U_PORT_TEST_ASSERT(index >= 0);
+            txQueueRemove(&(pScheduler->queue[index]));
+            if (index == 0) {
+                x++;
+            }
+        } while (index != 2);
+        U_PORT_TEST_ASSERT(x <= 1);
+        // Give PPP a go on its own for a while
+        for (size_t z = 0; z < y; z++) {
+            while (txQueueAdd(pPpp, U_CELL_MUX_PRIVATE_TX_FRAME_LENGTH_MAX_BYTES)) {}
+            U_PORT_TEST_ASSERT(uCellMuxPrivateTxSchedule(pScheduler) == 0);
+            txQueueRemove(pPpp);
+        }
+    }
+
+    // Release flow control on the GNSS channel and its frame
+    // should go out within a round
+    U_TEST_PRINT_LINE("testing flow control.");
+    gnssIsFlowControlledOff = false;
+    x = 0;
+    do {
+        while (txQueueAdd(pPpp, U_CELL_MUX_PRIVATE_TX_FRAME_LENGTH_MAX_BYTES)) {}
+        index = uCellMuxPrivateTxSchedule(pScheduler);
+        U_PORT_TEST_ASSERT(index >= 0);
+        txQueueRemove(&(pScheduler->queue[index]));
+        x++;
+    } while (index != 3);
+    U_PORT_TEST_ASSERT(x <= 2);
+    U_PORT_TEST_ASSERT(pGnss->numFrames == 0);
+
+    // Only PPP left, it gets everything and, once empty, nothing
+    for (x = 0; x < 10; x++) {
+        U_PORT_TEST_ASSERT(uCellMuxPrivateTxSchedule(pScheduler) == 0);
+        txQueueRemove(pPpp);
+        if (pPpp->numFrames == 0) {
+            break;
+        }
+    }
+    U_PORT_TEST_ASSERT(uCellMuxPrivateTxSchedule(pScheduler) == (int32_t) U_ERROR_COMMON_NOT_FOUND);
+    U_PORT_TEST_ASSERT(pPpp->deficitBytes == 0);
+
+    uPortFree(pScheduler);
+
+    uPortDeinit();
+
+    // Check for resource leaks
+    resourceCount = uTestUtilGetDynamicResourceCount() - resourceCount;
+    U_TEST_PRINT_LINE("we have leaked %d resources(s).", resourceCount);
+    U_PORT_TEST_ASSERT(resourceCount <= 0);
+    // Printed for information: asserting happens in the postamble
+    uTestUtilResourceCheck(U_TEST_PREFIX, NULL, true);
+}
+
 // End of file
@@ -124,6 +124,36 @@
 #define U_ATOMIC_GET(pPtr) __atomic_load_n(pPtr, __ATOMIC_SEQ_CST)
 #endif
 
+/** U_ATOMIC_LOAD_ACQUIRE: return the value of a variable atomically,
+ * with acquire ordering, i.e. no reads or writes that follow may be
+ * moved ahead of it; pair with U_ATOMIC_STORE_RELEASE().
+ */
+#ifdef _MSC_VER
+/** Microsoft Visual C++ definition; fetches (of volatiles) are
+ * atomic, and have acquire semantics, on x86_64.
+ */
+# define U_ATOMIC_LOAD_ACQUIRE(pPtr) *pPtr
+#else
+/** Default (GCC) definition.
+ */
+#define U_ATOMIC_LOAD_ACQUIRE(pPtr) __atomic_load_n(pPtr, __ATOMIC_ACQUIRE)
+#endif
+
+/** U_ATOMIC_STORE_RELEASE: set the value of a variable atomically,
+ * with release ordering, i.e. no reads or writes that precede it
+ * may be moved after it; pair with U_ATOMIC_LOAD_ACQUIRE().
+ */
+#ifdef _MSC_VER
+/** Microsoft Visual C++ definition; stores (to volatiles) are
+ * atomic, and have release semantics, on x86_64.
+ */
+# define U_ATOMIC_STORE_RELEASE(pPtr, value) *pPtr = value
+#else
+/** Default (GCC) definition.
+ */
+#define U_ATOMIC_STORE_RELEASE(pPtr, value) __atomic_store_n(pPtr, value, __ATOMIC_RELEASE)
+#endif
+
 /** U_ATOMIC_INCREMENT: increment a variable atomically and return
  * its new value.
  */
@@ -427,6 +427,39 @@ extern "C" {
 # define U_AT_CLIENT_ACTIVITY_PIN_HYSTERESIS_INTERVAL_MS 10
 #endif
 
+#ifndef U_AT_CLIENT_PIPELINE_WINDOW_MAX
+/** The maximum value that may be passed to
+ * uAtClientPipelineWindowSet(), i.e. the maximum number of
+ * pipelined AT commands that may be awaiting a response at any
+ * one time.
+ */
+# define U_AT_CLIENT_PIPELINE_WINDOW_MAX 16
+#endif
+
+#ifndef U_AT_CLIENT_STATS_MAX_NUM_COMMANDS
+/** The maximum number of different AT commands for which
+ * statistics are kept, see uAtClientStatsStart(); once this
+ * number is reached any further AT commands are lumped together
+ * in a single entry.
+ */
+# define U_AT_CLIENT_STATS_MAX_NUM_COMMANDS 32
+#endif
+
+#ifndef U_AT_CLIENT_STATS_COMMAND_MAX_LENGTH_BYTES
+/** The number of characters of an AT command, as passed to
+ * uAtClientCommandStart(), that are used to identify it in the
+ * statistics, including room for a null terminator.
+ */
+# define U_AT_CLIENT_STATS_COMMAND_MAX_LENGTH_BYTES 16
+#endif
+
+/** The number of buckets in the latency histogram of each AT
+ * command: bucket 0 counts latencies of 0 ms, bucket n counts
+ * latencies from 2^(n - 1) ms up to (2^n) - 1 ms and the last
+ * bucket also counts everything larger.
+ */
+#define U_AT_CLIENT_STATS_NUM_HISTOGRAM_BUCKETS 16
+
 /* ----------------------------------------------------------------
  * TYPES
  * -------------------------------------------------------------- */
@@ -477,6 +510,70 @@ typedef struct {
     int32_t code;
 } uAtClientDeviceError_t;
 
+/** Callback for a pipelined AT command, see
+ * uAtClientCommandStopPipelined().  This is called exactly once
+ * for each pipelined AT command, with the AT client locked.
+ * If a response prefix was given and it has been found then
+ * errorCode will be zero and the callback should read the
+ * parameters of the response with uAtClientReadInt() etc.; the
+ * AT client will then take care of the final `OK` or `ERROR`.
+ * Otherwise errorCode is the outcome of the AT command: zero for
+ * `OK`, #U_ERROR_COMMON_NOT_FOUND if a prefix was expected but the
+ * AT command ended without one, else a negative error code, in
+ * which case the callback must not read from the AT client.
+ *
+ * @param atHandle      the handle of the AT client.
+ * @param errorCode     the outcome, as described above.
+ * @param pParameter    the pParameter that was passed to
+ *                      uAtClientCommandStopPipelined().
+ */
+typedef void (*uAtClientPipelineCallback_t)(uAtClientHandle_t atHandle,
+                                            int32_t errorCode,
+                                            void *pParameter);
+
+/** The statistics for one AT command, see uAtClientStatsCommandGet().
+ * The latency of an AT command is the time from uAtClientCommandStart()
+ * to uAtClientResponseStop() (or uAtClientUnlock(), if
+ * uAtClientResponseStop() was not called), which will include any
+ * delay set with uAtClientDelaySet() but excludes time spent in URC
+ * handlers.  The byte counts are those passing through the stream
+ * while the AT command was in progress, hence a response that
+ * arrives along with some URCs will include the URCs.
+ */
+typedef struct {
+    char command[U_AT_CLIENT_STATS_COMMAND_MAX_LENGTH_BYTES]; /**< the start of the AT
+                                                                   command, e.g. "AT+USORD=",
+                                                                   null terminated; an
+                                                                   empty string is the
+                                                                   entry that collects
+                                                                   all of the AT commands
+                                                                   that did not fit. */
+    int32_t count;               /**< the number of times the AT command was sent. */
+    int64_t latencyTotalMs;      /**< the total latency. */
+    int32_t latencyMinMs;        /**< the smallest latency. */
+    int32_t latencyMaxMs;        /**< the largest latency. */
+    /** The number of AT commands in each latency bucket, see
+     * #U_AT_CLIENT_STATS_NUM_HISTOGRAM_BUCKETS. */
+    int32_t latencyHistogram[U_AT_CLIENT_STATS_NUM_HISTOGRAM_BUCKETS];
+    int64_t bytesSent;           /**< the number of bytes sent. */
+    int64_t bytesReceived;       /**< the number of bytes received. */
+    int32_t numTimeouts;         /**< the number of times the AT command timed out. */
+    int32_t numDeviceErrors;     /**< the number of times the AT server returned an error. */
+} uAtClientStatsCommand_t;
+
+/** The overall statistics of an AT client, see uAtClientStatsGet().
+ */
+typedef struct {
+    int64_t durationMs;          /**< the time since the statistics were started or reset. */
+    int32_t numCommands;         /**< the number of entries in use, see
+                                      uAtClientStatsCommandGet(). */
+    int64_t bytesSent;           /**< the total number of bytes sent. */
+    int64_t bytesReceived;       /**< the total number of bytes received. */
+    int32_t numUrcs;             /**< the number of URCs handled. */
+    int64_t urcHandlerTotalMs;   /**< the total time spent in URC handlers. */
+    int32_t urcHandlerMaxMs;     /**< the longest time spent in one URC handler. */
+} uAtClientStats_t;
+
 /* ----------------------------------------------------------------
  * PUBLIC FUNCTIONS: INITIALISATION AND CONFIGURATION
  * -------------------------------------------------------------- */
@@ -797,6 +894,34 @@ int32_t uAtClientDelayGet(const uAtClientHandle_t atHandle);
 void uAtClientDelaySet(uAtClientHandle_t atHandle,
                        int32_t delayMs);
 
+/** Set the pipeline window: the maximum number of AT commands,
+ * sent with uAtClientCommandStopPipelined(), that may be awaiting
+ * a response at any one time.  The default is 1, i.e. each AT
+ * command waits for its response before the next can be sent,
+ * and no memory is required; a larger window requires a small
+ * amount of heap.  This may not be called while pipelined AT
+ * commands are outstanding.
+ *
+ * Only use a window larger than 1 with AT commands that the
+ * module is able to queue (most modules can, since the UART
+ * simply buffers the incoming characters) and bear in mind that
+ * the delay set by uAtClientDelaySet() is NOT applied between AT
+ * commands while there are pipelined AT commands outstanding.
+ *
+ * @param atHandle  the handle of the AT client.
+ * @param window    the window, 1 to #U_AT_CLIENT_PIPELINE_WINDOW_MAX.
+ * @return          zero on success else negative error code.
+ */
+int32_t uAtClientPipelineWindowSet(uAtClientHandle_t atHandle,
+                                   size_t window);
+
+/** Get the pipeline window.
+ *
+ * @param atHandle  the handle of the AT client.
+ * @return          the pipeline window.
+ */
+size_t uAtClientPipelineWindowGet(const uAtClientHandle_t atHandle);
+
 /* ----------------------------------------------------------------
  * PUBLIC FUNCTIONS: SEND AN AT COMMAND
  * -------------------------------------------------------------- */
@@ -835,7 +960,10 @@ int32_t uAtClientLockExtend(uAtClientHandle_t atHandle);
 
 /** Unlock the stream.  This MUST be called to release
  * the AT client lock, otherwise the AT client will hang
- * on a subsequent call to uAtClientLock().
+ * on a subsequent call to uAtClientLock().  If there are
+ * pipelined AT commands outstanding (see
+ * uAtClientCommandStopPipelined()) their responses are
+ * waited for first.
  *
  * @param atHandle  the handle of the AT client.
  * @return          the last error that happened on the
@@ -995,6 +1123,65 @@ void uAtClientCommandStop(uAtClientHandle_t atHandle);
  */
 void uAtClientCommandStopReadResponse(uAtClientHandle_t atHandle);
 
+/** As uAtClientCommandStop() but, rather than the caller
+ * going on to read the response, the response is handled
+ * later by pCallback, allowing the next AT command to be sent
+ * before this one has been responded to: while the number of
+ * AT commands awaiting a response is less than the window set
+ * by uAtClientPipelineWindowSet() this returns immediately,
+ * otherwise it first handles the response to the oldest
+ * outstanding AT command.  Responses are matched to AT commands
+ * in the order the AT commands were sent.  For example:
+ *
+ * ```
+ * uAtClientLock(client);
+ * for (x = 0; x < 100; x++) {
+ *     uAtClientCommandStart(client, "AT+THING=");
+ *     uAtClientWriteInt(client, x);
+ *     uAtClientCommandStopPipelined(client, "+THING:", callback, &(results[x]));
+ * }
+ * uAtClientUnlock(client);  <-- waits for any outstanding responses
+ * ```
+ *
+ * Any outstanding responses are handled by uAtClientPipelineFlush()
+ * or uAtClientUnlock(); a non-pipelined AT command must not be sent
+ * until that has happened.  An `ERROR` response only affects the
+ * AT command it belongs to but if a response times out then the
+ * remaining responses can no longer be matched to their AT
+ * commands and so all outstanding AT commands are failed with the
+ * same error, without waiting.
+ *
+ * @param atHandle        the handle of the AT client.
+ * @param[in] pPrefix     the prefix of the information response
+ *                        expected, e.g. "+THING:", NULL if the AT
+ *                        command is expected to return just `OK`
+ *                        or `ERROR`; the string must remain valid
+ *                        until pCallback has been called.
+ * @param[in] pCallback   the callback that handles the response,
+ *                        see #uAtClientPipelineCallback_t; may be
+ *                        NULL.
+ * @param[in] pParameter  a parameter that will be passed to
+ *                        pCallback.
+ */
+void uAtClientCommandStopPipelined(uAtClientHandle_t atHandle,
+                                   const char *pPrefix,
+                                   uAtClientPipelineCallback_t pCallback,
+                                   void *pParameter);
+
+/** Wait for the responses to all outstanding pipelined AT commands,
+ * see uAtClientCommandStopPipelined().  This is called by
+ * uAtClientUnlock(), it need only be called explicitly if a
+ * non-pipelined AT command is to follow within the same lock.
+ * If any of the pipelined AT commands failed the AT client is
+ * left in error, just as for a failed non-pipelined AT command.
+ *
+ * @param atHandle  the handle of the AT client.
+ * @return          zero if all of the pipelined AT commands since the
+ *                  last flush succeeded, else the first negative
+ *                  error code that occurred.
+ */
+int32_t uAtClientPipelineFlush(uAtClientHandle_t atHandle);
+
 /** Start waiting for the response to an AT command that
  * is more than a simple `OK` or `ERROR` (which would be
  * handled by calling uAtClientCommandStopReadResponse()).
@@ -1130,6 +1317,51 @@ int32_t uAtClientReadBytes(uAtClientHandle_t atHandle,
                            char *pBuffer, size_t lengthBytes,
                            bool standalone);
 
+/** Read bytes from the received AT response stream without
+ * copying them: a pointer to the bytes is returned, pointing
+ * into the receive buffer of the AT client, allowing them to
+ * be decoded or forwarded in place.  This is intended for large
+ * payloads, e.g. those of `+USORD`, `+USORF` or `+URDBLOCK`,
+ * where the bytes would otherwise be copied out one by one.
+ *
+ * Since the bytes must be contiguous in the receive buffer,
+ * fewer than lengthBytes may be returned if lengthBytes is
+ * larger than the receive buffer (see uAtClientAddExt()); call
+ * this function repeatedly until all of the bytes you need
+ * have been read.  If the bytes are not yet all in the receive
+ * buffer this function will wait for them, up to the AT timeout;
+ * if some, but not all, arrive within the timeout then those
+ * that did arrive are returned.
+ *
+ * As with uAtClientReadBytes(), a stop tag (e.g. `\r\n` or `OK`)
+ * is obeyed, if one is found within the bytes, but for binary
+ * data you should call uAtClientIgnoreStopTag() first.  A stop
+ * tag may be split across calls: if the bytes end with what could
+ * be the start of a stop tag, the rest of which has not yet
+ * arrived, those bytes are held back until the next call, hence
+ * fewer than lengthBytes may be returned even when all of them
+ * are in the receive buffer; should the held-back bytes be all
+ * that there is, this function waits, up to the AT timeout, for
+ * what follows them.
+ *
+ * IMPORTANT: *ppSpan remains valid ONLY until the next call
+ * to any AT client function for this atHandle (in particular,
+ * the next read will likely move or overwrite the contents
+ * of the receive buffer); do not keep hold of it.
+ *
+ * @param atHandle      the handle of the AT client.
+ * @param[out] ppSpan   a place to put a pointer to the bytes
+ *                      read; cannot be NULL.  Set to NULL if
+ *                      no bytes are read.
+ * @param lengthBytes   the number of bytes wanted.
+ * @return              the number of bytes at *ppSpan, which
+ *                      may be fewer than lengthBytes (see above),
+ *                      or negative error code.
+ */
+int32_t uAtClientReadBytesSpan(uAtClientHandle_t atHandle,
+                               const char **ppSpan,
+                               size_t lengthBytes);
+
 /** Read binary data received as a hex string from from the
  *  AT response
  *
@@ -1239,6 +1471,9 @@ int32_t uAtClientWaitCharacter(uAtClientHandle_t atHandle,
  * If the URC is found when parsing AT responses the
  * handler is called.  If a handler is already set for the
  * given prefix then the new setting is ignored.
+ * The URC prefixes are compiled into a prefix tree so that
+ * the cost of matching a URC depends on the length of the
+ * prefix, not on the number of URC handlers that are set.
  * In a URC handler you only need to be concerned with reading
  * the parameters of interest, don't worry about locking/
  * unlocking or about any trailing parameters unless they
@@ -1497,6 +1732,72 @@ int32_t uAtClientUrcDirect(uAtClientHandle_t atHandle,
                                              void *),
                            void *pHandlerParam);
 
+/* ----------------------------------------------------------------
+ * PUBLIC FUNCTIONS: STATISTICS
+ * -------------------------------------------------------------- */
+
+/** Start keeping statistics for an AT client: per AT command
+ * counts, latencies, a latency histogram, bytes sent/received,
+ * timeouts and device errors, plus time spent in URC handlers;
+ * they can be read at any time with uAtClientStatsGet() and
+ * uAtClientStatsCommandGet().  The statistics require around
+ * #U_AT_CLIENT_STATS_MAX_NUM_COMMANDS * 130 bytes of heap, which
+ * is only allocated when this function is called; when statistics
+ * are not being kept the overhead is negligible.  If statistics
+ * are already being kept this does nothing.
+ *
+ * @param atHandle  the handle of the AT client.
+ * @return          zero on success else negative error code.
+ */
+int32_t uAtClientStatsStart(uAtClientHandle_t atHandle);
+
+/** Stop keeping statistics for an AT client, freeing the memory
+ * they occupied.
+ *
+ * @param atHandle  the handle of the AT client.
+ */
+void uAtClientStatsStop(uAtClientHandle_t atHandle);
+
+/** Reset the statistics of an AT client to zero; statistics
+ * continue to be kept.
+ *
+ * @param atHandle  the handle of the AT client.
+ */
+void uAtClientStatsReset(uAtClientHandle_t atHandle);
+
+/** Get the overall statistics of an AT client.
+ *
+ * @param atHandle     the handle of the AT client.
+ * @param[out] pStats  a place to put the statistics; cannot be NULL.
+ * @return             on success the number of AT command entries,
+ *                     i.e. pStats->numCommands, which may be read with
+ *                     uAtClientStatsCommandGet(), else negative error
+ *                     code, e.g. if uAtClientStatsStart() has not been
+ *                     called.
+ */
+int32_t uAtClientStatsGet(uAtClientHandle_t atHandle,
+                          uAtClientStats_t *pStats);
+
+/** Get the statistics for one AT command.
+ *
+ * @param atHandle            the handle of the AT client.
+ * @param index               the index of the entry, from zero to one
+ *                            less than the value returned by
+ *                            uAtClientStatsGet().
+ * @param[out] pCommandStats  a place to put the statistics; cannot
+ *                            be NULL.
+ * @return                    zero on success else negative error code.
+ */
+int32_t uAtClientStatsCommandGet(uAtClientHandle_t atHandle,
+                                 size_t index,
+                                 uAtClientStatsCommand_t *pCommandStats);
+
+/** Print the statistics of an AT client to the log.
+ *
+ * @param atHandle  the handle of the AT client.
+ */
+void uAtClientStatsPrint(uAtClientHandle_t atHandle);
+
 /* ----------------------------------------------------------------
  * PUBLIC FUNCTIONS: MISC
  * -------------------------------------------------------------- */
@@ -330,6 +330,24 @@ typedef struct uAtClientUrc_t {
     struct uAtClientUrc_t *pNext;
 } uAtClientUrc_t;
 
+/** A node in the prefix trie that is compiled from the list of
+ * URC handlers so that a URC can be matched in a time proportional
+ * to the length of its prefix, rather than to the number of URC
+ * handlers.  The nodes of a trie are held in a single array with
+ * node zero as the root; the children of a node are a list of
+ * siblings, linked by array index, where an index of zero means
+ * "none" (since the root can never be a child).
+ */
+typedef struct {
+    uAtClientUrc_t *pUrc;  /** The URC whose prefix ends at this node, NULL if there is none. */
+    uint16_t firstChild;   /** Index of the first child of this node, zero if there is none. */
+    uint16_t nextSibling;  /** Index of the next sibling of this node, zero if there is none. */
+    uint16_t order;        /** The position of pUrc in the URC list, lowest being the most
+                               recently added, used to resolve overlapping prefixes in the
+                               same way as a search of the list would. */
+    char character;        /** The character that leads to this node from its parent. */
+} uAtClientUrcTrieNode_t;
+
 /** The definition of a tag.
  */
 typedef struct {
@@ -409,6 +427,49 @@ typedef struct {
     int32_t hysteresisMs;
 } uAtClientActivityPin_t;
 
+/** The statistics of the AT command in progress.
+ */
+typedef struct {
+    int32_t index; /** Index into uAtClientStatsContext_t.command[], -1 if none. */
+    int32_t startTimeMs;
+    int64_t bytesSentStart;
+    int64_t bytesReceivedStart;
+    bool timedOut;
+} uAtClientStatsCurrent_t;
+
+/** Struct holding the statistics of an AT client.
+ */
+typedef struct {
+    uAtClientStats_t client;
+    int32_t startTimeMs;
+    uAtClientStatsCommand_t command[U_AT_CLIENT_STATS_MAX_NUM_COMMANDS];
+    uAtClientStatsCurrent_t current;
+} uAtClientStatsContext_t;
+
+/** An AT command sent with uAtClientCommandStopPipelined() that
+ * is awaiting a response.
+ */
+typedef struct {
+    const char *pPrefix;
+    uAtClientPipelineCallback_t pCallback;
+    void *pCallbackParam;
+    int32_t sentTimeMs;
+    uAtClientStatsCurrent_t stats;
+} uAtClientPipelineEntry_t;
+
+/** Struct defining the queue of pipelined AT commands; pEntry is
+ * a circular buffer of window entries, only allocated if window
+ * is greater than 1.
+ */
+typedef struct {
+    uAtClientPipelineEntry_t *pEntry;
+    size_t window;
+    size_t readIndex;
+    size_t count;
+    uErrorCode_t error; /** The first error since the last flush. */
+    bool outOfStep; /** Set if responses can no longer be matched to commands. */
+} uAtClientPipeline_t;
+
 /** Struct defining a stack of mutexes.
  */
 typedef struct {
@@ -443,6 +504,7 @@ typedef struct uAtClientInstance_t {
     uAtClientTag_t stopTag; /** The stop tag for the current scope. */
     uAtClientUrc_t *pUrcList; /** Linked-list anchor for URC handlers. */
     uAtClientUrc_t *pUrcRead;  /** Pointer used when reading the URC handlers. */
+    uAtClientUrcTrieNode_t *pUrcTrie; /** Prefix trie compiled from pUrcList, used when matching URCs. */
     int32_t lastResponseStopMs; /** The time the last response ended in milliseconds. */
     int32_t lockTimeMs; /** The time when the stream was locked. */
     int32_t lastTxTimeMs; /** The time when the last transmit activity was carried out, set to -1 initially. */
@@ -468,6 +530,8 @@ typedef struct uAtClientInstance_t {
                                    as its fourth parameter. */
     uAtClientWakeUp_t *pWakeUp; /** Pointer to a wake-up handler structure. */
     uAtClientActivityPin_t *pActivityPin; /** Pointer to an activity pin structure. */
+    uAtClientPipeline_t pipeline; /** Pipelined AT commands awaiting a response. */
+    uAtClientStatsContext_t *pStats; /** Statistics, NULL if they are not being kept. */
     struct uAtClientInstance_t *pNext;
 } uAtClientInstance_t;
 
@@ -881,12 +945,19 @@ static void removeClient(uAtClientInstance_t *pClient)
             break;
     }
 
-    // Free any URC handlers it had.
+    // Free any URC handlers it had, and the trie built from them
     while (pClient->pUrcList != NULL) {
         pUrc = pClient->pUrcList;
         pClient->pUrcList = pUrc->pNext;
         uPortFree(pUrc);
     }
+    uPortFree(pClient->pUrcTrie);
+
+    // Free the pipeline queue
+    uPortFree(pClient->pipeline.pEntry);
+
+    // Free any statistics
+    uPortFree(pClient->pStats);
 
     // Remove any activity pin
     uPortFree(pClient->pActivityPin);
@@ -971,6 +1042,123 @@ static int32_t urcHandlerGetNext(uAtClientInstance_t *pClient,
     return count;
 }
 
+// Find the child of the given trie node that is reached with
+// the given character, returning its index or zero if there
+// is no such child.
+static uint16_t urcTrieChild(const uAtClientUrcTrieNode_t *pTrie,
+                             uint16_t node, char character)
+{
+    uint16_t child = pTrie[node].firstChild;
+
+    while ((child != 0) && (pTrie[child].character != character)) {
+        child = pTrie[child].nextSibling;
+    }
+
+    return child;
+}
+
+// Compile a prefix trie from the given list of URCs, returning
+// the trie (which must be freed with uPortFree()), or NULL if
+// the list is empty or there is not enough memory.
+static uAtClientUrcTrieNode_t *pUrcTrieBuild(uAtClientUrc_t *pUrcList)
+{
+    uAtClientUrcTrieNode_t *pTrie = NULL;
+    uAtClientUrc_t *pUrc;
+    size_t numNodesMax = 1; // The root
+    uint16_t numNodes = 1;
+    uint16_t order = 0;
+    uint16_t node;
+    uint16_t child;
+
+    // The worst case is that no prefixes share a character
+    for (pUrc = pUrcList; pUrc != NULL; pUrc = pUrc->pNext) {
+        numNodesMax += pUrc->prefixLength;
+    }
+    if ((pUrcList != NULL) && (numNodesMax <= UINT16_MAX)) {
+        pTrie = (uAtClientUrcTrieNode_t *) pUPortMalloc(numNodesMax * sizeof(*pTrie));
+    }
+    if (pTrie != NULL) {
+        memset(pTrie, 0, sizeof(*pTrie));
+        // The list is in most-recently-added-first order,
+        // which is what order records
+        for (pUrc = pUrcList; pUrc != NULL; pUrc = pUrc->pNext) {
+            node = 0;
+            for (size_t x = 0; x < pUrc->prefixLength; x++) {
+                child = urcTrieChild(pTrie, node, *(pUrc->pPrefix + x));
+                if (child == 0) {
+                    // Add a new child at the head of the siblings
+                    child = numNodes;
+                    numNodes++;
+                    memset(&(pTrie[child]), 0, sizeof(pTrie[child]));
+                    pTrie[child].character = *(pUrc->pPrefix + x);
+                    pTrie[child].nextSibling = pTrie[node].firstChild;
+                    pTrie[node].firstChild = child;
+                }
+                node = child;
+            }
+            if (pTrie[node].pUrc == NULL) {
+                pTrie[node].pUrc = pUrc;
+                pTrie[node].order = order;
+            }
+            order++;
+        }
+    }
+
+    return pTrie;
+}
+
+// Find the URC whose prefix is at the start of pData, walking
+// no further than length characters.  Where more than one
+// prefix matches, the most recently added URC wins, which is
+// how a search of the URC list would behave.
+static uAtClientUrc_t *pUrcTrieMatch(const uAtClientUrcTrieNode_t *pTrie,
+                                     const char *pData, size_t length)
+{
+    uAtClientUrc_t *pUrc = NULL;
+    uint16_t order = 0;
+    uint16_t node = 0;
+
+    if (pTrie != NULL) {
+        // An empty prefix, were anyone to register one, matches anything
+        pUrc = pTrie[0].pUrc;
+        order = pTrie[0].order;
+        for (size_t x = 0; x < length; x++) {
+            node = urcTrieChild(pTrie, node, *(pData + x));
+            if (node == 0) {
+                break;
+            }
+            if ((pTrie[node].pUrc != NULL) &&
+                ((pUrc == NULL) || (pTrie[node].order < order))) {
+                pUrc = pTrie[node].pUrc;
+                order = pTrie[node].order;
+            }
+        }
+    }
+
+    return pUrc;
+}
+
+// Remove the given URC from a trie; the node(s) that led to it
+// are left in place, they will be dropped the next time the
+// trie is built.
+static void urcTrieRemove(uAtClientUrcTrieNode_t *pTrie,
+                          const uAtClientUrc_t *pUrc)
+{
+    uint16_t node = 0;
+
+    if (pTrie != NULL) {
+        for (size_t x = 0; x < pUrc->prefixLength; x++) {
+            node = urcTrieChild(pTrie, node, *(pUrc->pPrefix + x));
+            if (node == 0) {
+                break;
+            }
+        }
+        if (pTrie[node].pUrc == pUrc) {
+            pTrie[node].pUrc = NULL;
+        }
+    }
+}
+
 // Check if an asynchronous event should be processed
 // for the given AT client.
 static bool processAsync(int32_t magicNumber)
@@ -1106,19 +1294,31 @@ static uPortMutexHandle_t streamTryLock(const uAtClientInstance_t *pClient,
     return streamMutex;
 }
 
-// Find one character buffer inside another.
+// Find one character buffer inside another; memchr() is used to
+// hop between candidates for the first character since the C
+// library will usually have a word-at-a-time or vectorised
+// version of it.
 static const char *pMemStr(const char *pBuffer,
                            size_t bufferLength,
                            const char *pFind,
                            size_t findLength)
 {
     const char *pPos = NULL;
+    const char *pEnd = pBuffer + bufferLength;
+    const char *pCandidate;
 
-    if (bufferLength >= findLength) {
-        for (size_t x = 0; (pPos == NULL) &&
-             (x < (bufferLength - findLength) + 1); x++) {
-            if (memcmp(pBuffer + x, pFind, findLength) == 0) {
-                pPos = pBuffer + x;
+    if (findLength == 0) {
+        pPos = pBuffer;
+    } else {
+        while ((pPos == NULL) && ((size_t) (pEnd - pBuffer) >= findLength)) {
+            pCandidate = (const char *) memchr(pBuffer, *pFind,
+                                               (pEnd - pBuffer) - (findLength - 1));
+            if (pCandidate == NULL) {
+                pBuffer = pEnd;
+            } else if (memcmp(pCandidate + 1, pFind + 1, findLength - 1) == 0) {
+                pPos = pCandidate;
+            } else {
+                pBuffer = pCandidate + 1;
             }
         }
     }
@@ -1126,6 +1326,74 @@ static const char *pMemStr(const char *pBuffer,
     return pPos;
 }
 
+// Return the number of characters, up to maxLength, from the read
+// position of the receive buffer onwards which are none of the
+// numStop characters at pStop, without bringing more data into
+// the buffer; each memchr() search is bounded by the last.
+static size_t bufferSpan(const uAtClientReceiveBuffer_t *pReceiveBuffer,
+                         const char *pStop, size_t numStop,
+                         size_t maxLength)
+{
+    const char *pStart = U_AT_CLIENT_DATA_BUFFER_PTR(pReceiveBuffer) +
+                         pReceiveBuffer->readIndex;
+    const char *pFound;
+    size_t length = pReceiveBuffer->length - pReceiveBuffer->readIndex;
+
+    if (length > maxLength) {
+        length = maxLength;
+    }
+
+    for (size_t x = 0; (x < numStop) && (length > 0); x++) {
+        pFound = (const char *) memchr(pStart, *(pStop + x), length);
+        if (pFound != NULL) {
+            length = pFound - pStart;
+        }
+    }
+
+    return length;
+}
+
+// Return the position of the stop tag in the first length bytes
+// from the read position of the receive buffer, or length if it is
+// not there, without bringing more data into the buffer; the search
+// goes as far beyond length as a stop tag beginning within length
+// could reach.  If the data in the buffer ends with what could be
+// the start of a stop tag beginning within length, the number of
+// bytes of it within length is written to pPartialLength, else zero.
+static size_t stopTagPosition(const uAtClientInstance_t *pClient,
+                              size_t length, size_t *pPartialLength)
+{
+    const uAtClientReceiveBuffer_t *pReceiveBuffer = pClient->pReceiveBuffer;
+    const uAtClientTagDef_t *pTagDef = pClient->stopTag.pTagDef;
+    const char *pStart = U_AT_CLIENT_DATA_BUFFER_PTR(pReceiveBuffer) +
+                         pReceiveBuffer->readIndex;
+    size_t searchLength = pReceiveBuffer->length - pReceiveBuffer->readIndex;
+    size_t position = length;
+    const char *pTag;
+
+    *pPartialLength = 0;
+    if (searchLength > length + pTagDef->length - 1) {
+        searchLength = length + pTagDef->length - 1;
+    }
+    pTag = pMemStr(pStart, searchLength, pTagDef->pString, pTagDef->length);
+    if (pTag != NULL) {
+        if ((size_t) (pTag - pStart) < length) {
+            position = pTag - pStart;
+        }
+    } else {
+        // Check the end of the data for the longest start of a
+        // stop tag that begins within length
+        for (size_t x = pTagDef->length - 1; (x > 0) && (*pPartialLength == 0); x--) {
+            if ((x <= searchLength) && (searchLength - x < length) &&
+                (memcmp(pStart + searchLength - x, pTagDef->pString, x) == 0)) {
+                *pPartialLength = length - (searchLength - x);
+            }
+        }
+    }
+
+    return position;
+}
+
 // Print out AT commands and responses.
 static void printAt(uAtClientInstance_t *pClient,
                     const char *pAt, size_t length, bool sending)
@@ -1194,6 +1462,93 @@ static void printAt(uAtClientInstance_t *pClient,
     }
 }
 
+// Open the statistics of an AT command that is being started.
+static void statsCommandOpen(uAtClientInstance_t *pClient,
+                             const char *pCommand)
+{
+    uAtClientStatsContext_t *pStats = pClient->pStats;
+    uAtClientStatsCommand_t *pCommandStats;
+    int32_t index = -1;
+
+    if (pStats != NULL) {
+        for (int32_t x = 0; (x < pStats->client.numCommands) && (index < 0); x++) {
+            if (strncmp(pStats->command[x].command, pCommand,
+                        sizeof(pStats->command[x].command) - 1) == 0) {
+                index = x;
+            }
+        }
+        if (index < 0) {
+            // Not found: add an entry, keeping the last one
+            // for everything that doesn't fit
+            index = pStats->client.numCommands;
+            if (index >= U_AT_CLIENT_STATS_MAX_NUM_COMMANDS - 1) {
+                index = U_AT_CLIENT_STATS_MAX_NUM_COMMANDS - 1;
+                pCommand = "";
+            }
+            if (index == pStats->client.numCommands) {
+                pCommandStats = &(pStats->command[index]);
+                memset(pCommandStats, 0, sizeof(*pCommandStats));
+                strncpy(pCommandStats->command, pCommand,
+                        sizeof(pCommandStats->command) - 1);
+                pCommandStats->latencyMinMs = INT_MAX;
+                pStats->client.numCommands++;
+            }
+        }
+        pStats->current.index = index;
+        pStats->current.startTimeMs = uPortGetTickTimeMs();
+        pStats->current.bytesSentStart = pStats->client.bytesSent;
+        pStats->current.bytesReceivedStart = pStats->client.bytesReceived;
+        pStats->current.timedOut = false;
+    }
+}
+
+// Close the statistics of the AT command in progress, if there is one.
+static void statsCommandClose(uAtClientInstance_t *pClient)
+{
+    uAtClientStatsContext_t *pStats = pClient->pStats;
+    uAtClientStatsCommand_t *pCommandStats;
+    int32_t latencyMs;
+    size_t bucket = 0;
+
+    if ((pStats != NULL) && (pStats->current.index >= 0) &&
+        (pStats->current.index < pStats->client.numCommands)) {
+        pCommandStats = &(pStats->command[pStats->current.index]);
+        latencyMs = uPortGetTickTimeMs() - pStats->current.startTimeMs;
+        if (latencyMs < 0) {
+            latencyMs = 0;
+        }
+        pCommandStats->count++;
+        pCommandStats->latencyTotalMs += latencyMs;
+        if (latencyMs < pCommandStats->latencyMinMs) {
+            pCommandStats->latencyMinMs = latencyMs;
+        }
+        if (latencyMs > pCommandStats->latencyMaxMs) {
+            pCommandStats->latencyMaxMs = latencyMs;
+        }
+        // Log-scale histogram: the bucket is one more than the
+        // position of the most significant bit of the latency
+        while ((latencyMs > 0) &&
+               (bucket < U_AT_CLIENT_STATS_NUM_HISTOGRAM_BUCKETS - 1)) {
+            latencyMs >>= 1;
+            bucket++;
+        }
+        pCommandStats->latencyHistogram[bucket]++;
+        pCommandStats->bytesSent += pStats->client.bytesSent -
+                                    pStats->current.bytesSentStart;
+        pCommandStats->bytesReceived += pStats->client.bytesReceived -
+                                        pStats->current.bytesReceivedStart;
+        if (pStats->current.timedOut) {
+            pCommandStats->numTimeouts++;
+        }
+        if (pClient->deviceError.type != U_AT_CLIENT_DEVICE_ERROR_TYPE_NO_ERROR) {
+            pCommandStats->numDeviceErrors++;
+        }
+    }
+    if (pStats != NULL) {
+        pStats->current.index = -1;
+    }
+}
+
 // Set error.
 static void setError(uAtClientInstance_t *pClient,
                      uErrorCode_t error)
@@ -1229,6 +1584,10 @@ static void consecutiveTimeout(uAtClientInstance_t *pClient)
 {
     uAtClientCallback_t cb = {0}; // Keep Valgrind happy (otherwise the last four bytes will be uninitialised)
 
+    if (pClient->pStats != NULL) {
+        pClient->pStats->current.timedOut = true;
+    }
+
     U_PORT_MUTEX_LOCK(gMutexEventQueue);
 
     pClient->numConsecutiveAtTimeouts++;
@@ -1546,6 +1905,9 @@ static bool bufferFill(uAtClientInstance_t *pClient,
             // available in the buffer for the AT client as
             // there may be an intercept function in the way
             pReceiveBuffer->lengthBuffered += readLength;
+            if (pClient->pStats != NULL) {
+                pClient->pStats->client.bytesReceived += readLength;
+            }
             // length starts out as the amount of data that has not yet
             // been successfully processed by the intercept function
             length += readLength;
@@ -1830,12 +2192,36 @@ static void setScope(uAtClientInstance_t *pClient,
 static bool consumeToString(uAtClientInstance_t *pClient,
                             const char *pString)
 {
+    uAtClientReceiveBuffer_t *pReceiveBuffer = pClient->pReceiveBuffer;
     size_t index = 0;
     size_t length = strlen(pString);
     int32_t character = 0;
+    const char *pStart;
+    const char *pFound;
 
     while ((character >= 0) &&
            (index < length)) {
+        if (index == 0) {
+            // Nothing matched yet: rather than reading one
+            // character at a time, skip over what is already
+            // buffered to the next place that pString could
+            // start, leaving the matching to the loop below
+            pStart = U_AT_CLIENT_DATA_BUFFER_PTR(pReceiveBuffer) +
+                     pReceiveBuffer->readIndex;
+            pFound = pMemStr(pStart, pReceiveBuffer->length - pReceiveBuffer->readIndex,
+                             pString, length);
+            if (pFound != NULL) {
+                pReceiveBuffer->readIndex += pFound - pStart;
+            } else {
+                // Not there in full but the start of it might
+                // be in the last few characters of the buffer
+                if (pReceiveBuffer->length - pReceiveBuffer->readIndex >= length) {
+                    pReceiveBuffer->readIndex = pReceiveBuffer->length - (length - 1);
+                }
+                pReceiveBuffer->readIndex += bufferSpan(pReceiveBuffer, pString, 1,
+                                                        length);
+            }
+        }
         character = bufferReadChar(pClient);
         if (character >= 0) {
             if (character == *(pString + index)) {
@@ -1903,42 +2289,51 @@ static void informationResponseStop(uAtClientInstance_t *pClient)
 // up to CR/LF.
 static bool bufferMatchOneUrc(uAtClientInstance_t *pClient)
 {
-    size_t prefixLength = 0;
+    uAtClientReceiveBuffer_t *pReceiveBuffer = pClient->pReceiveBuffer;
+    uAtClientUrc_t *pUrc;
     bool found = false;
     int32_t now;
     uErrorCode_t savedError;
 
     bufferRewind(pClient);
 
-    for (uAtClientUrc_t *pUrc = pClient->pUrcList;
-         !found && (pUrc != NULL);
-         pUrc = pUrc->pNext) {
-        prefixLength = pUrc->prefixLength;
-        if (pClient->pReceiveBuffer->length >= prefixLength) {
-            // Do the check ignoring nulls at the start in case
-            // a URC is emitted near power-on which can suffer from
-            // such nulls
-            if (bufferMatch(pClient, pUrc->pPrefix, prefixLength, true)) {
-                setScope(pClient, U_AT_CLIENT_SCOPE_INFORMATION);
-                now = uPortGetTickTimeMs();
-                // Before heading off into URCness, save
-                // the current error state and reset
-                // it so that the URC doesn't suffer the error
-                savedError = pClient->error;
-                pClient->error = U_ERROR_COMMON_SUCCESS;
-                if (processAsync(pClient->magicNumber) && pUrc->pHandler) {
-                    pUrc->pHandler(pClient, pUrc->pHandlerParam);
-                }
-                informationResponseStop(pClient);
-                // Put the error state back again
-                pClient->error = savedError;
-                // Put the error state back again
-                // Add the amount of time spent in the URC
-                // world to the start time
-                pClient->lockTimeMs += uPortGetTickTimeMs() - now;
-                found = true;
+    // Walk the prefix trie over what is in the buffer: this
+    // costs no more than the length of the longest prefix,
+    // however many URC handlers there are
+    pUrc = pUrcTrieMatch(pClient->pUrcTrie,
+                         U_AT_CLIENT_DATA_BUFFER_PTR(pReceiveBuffer) +
+                         pReceiveBuffer->readIndex,
+                         pReceiveBuffer->length - pReceiveBuffer->readIndex);
+    if (pUrc != NULL) {
+        // Consume the prefix
+        pReceiveBuffer->readIndex += pUrc->prefixLength;
+        setScope(pClient, U_AT_CLIENT_SCOPE_INFORMATION);
+        now = uPortGetTickTimeMs();
+        // Before heading off into URCness, save
+        // the current error state and reset
+        // it so that the URC doesn't suffer the error
+        savedError = pClient->error;
+        pClient->error = U_ERROR_COMMON_SUCCESS;
+        if (processAsync(pClient->magicNumber) && pUrc->pHandler) {
+            pUrc->pHandler(pClient, pUrc->pHandlerParam);
+        }
+        informationResponseStop(pClient);
+        // Put the error state back again
+        pClient->error = savedError;
+        // Add the amount of time spent in the URC
+        // world to the start time
+        now = uPortGetTickTimeMs() - now;
+        pClient->lockTimeMs += now;
+        if (pClient->pStats != NULL) {
+            pClient->pStats->client.numUrcs++;
+            pClient->pStats->client.urcHandlerTotalMs += now;
+            if (now > pClient->pStats->client.urcHandlerMaxMs) {
+                pClient->pStats->client.urcHandlerMaxMs = now;
             }
+            // Not part of the latency of any AT command
+            pClient->pStats->current.startTimeMs += now;
         }
+        found = true;
     }
 
     return found;
@@ -1952,57 +2347,90 @@ static int32_t readString(uAtClientInstance_t *pClient,
                           bool ignoreStopTag)
 {
     uAtClientTag_t *pStopTag = &(pClient->stopTag);
+    uAtClientReceiveBuffer_t *pReceiveBuffer = pClient->pReceiveBuffer;
     int32_t lengthRead = 0;
     int32_t matchPos = 0;
     bool delimiterFound = false;
     bool inQuotes = false;
+    char stop[3];
+    size_t numStop;
+    size_t span;
     int32_t c;
 
     while (((lengthBytes == 0) || (lengthRead < ((int32_t) lengthBytes - 1) + matchPos)) &&
            (pClient->error == U_ERROR_COMMON_SUCCESS) &&
            !delimiterFound &&
            (ignoreStopTag || !pStopTag->found)) {
-        c = bufferReadChar(pClient);
-        if (c == -1) {
-            // Error
-            setError(pClient, U_ERROR_COMMON_DEVICE_ERROR);
-        } else if (!inQuotes && (c == pClient->delimiter)) {
-            // Reached delimiter
-            delimiterFound = true;
-        } else if (c == '\"') {
-            // Switch into or out of quotes
-            matchPos = 0;
-            inQuotes = !inQuotes;
+        span = 0;
+        if (matchPos == 0) {
+            // Take in one go any run of buffered characters
+            // which can't be a quote, a delimiter or the start
+            // of a stop tag, e.g. the body of a hex string
+            stop[0] = '\"';
+            numStop = 1;
+            if (!inQuotes) {
+                stop[numStop] = pClient->delimiter;
+                numStop++;
+                if (!ignoreStopTag && (pStopTag->pTagDef->length > 0)) {
+                    stop[numStop] = *(pStopTag->pTagDef->pString);
+                    numStop++;
+                }
+            }
+            span = bufferSpan(pReceiveBuffer, stop, numStop,
+                              (lengthBytes == 0) ? (size_t) -1 :
+                              (lengthBytes - 1) - (size_t) lengthRead);
+        }
+        if (span > 0) {
+            if (pString != NULL) {
+                memcpy(pString + lengthRead,
+                       U_AT_CLIENT_DATA_BUFFER_PTR(pReceiveBuffer) + pReceiveBuffer->readIndex,
+                       span);
+            }
+            pReceiveBuffer->readIndex += span;
+            lengthRead += (int32_t) span;
         } else {
-            if (!inQuotes && !ignoreStopTag &&
-                (pStopTag->pTagDef->length > 0)) {
-                // It could be a stop tag
-                if (c == *(pStopTag->pTagDef->pString + matchPos)) {
-                    matchPos++;
-                } else {
-                    // If it wasn't a stop tag, reset
-                    // the match position and check again
-                    // in case it is the start of a new stop tag
-                    matchPos = 0;
-                    if (c == *(pStopTag->pTagDef->pString)) {
+            c = bufferReadChar(pClient);
+            if (c == -1) {
+                // Error
+                setError(pClient, U_ERROR_COMMON_DEVICE_ERROR);
+            } else if (!inQuotes && (c == pClient->delimiter)) {
+                // Reached delimiter
+                delimiterFound = true;
+            } else if (c == '\"') {
+                // Switch into or out of quotes
+                matchPos = 0;
+                inQuotes = !inQuotes;
+            } else {
+                if (!inQuotes && !ignoreStopTag &&
+                    (pStopTag->pTagDef->length > 0)) {
+                    // It could be a stop tag
+                    if (c == *(pStopTag->pTagDef->pString + matchPos)) {
                         matchPos++;
+                    } else {
+                        // If it wasn't a stop tag, reset
+                        // the match position and check again
+                        // in case it is the start of a new stop tag
+                        matchPos = 0;
+                        if (c == *(pStopTag->pTagDef->pString)) {
+                            matchPos++;
+                        }
                     }
+                    if (matchPos == (int32_t) pStopTag->pTagDef->length) {
+                        pStopTag->found = true;
+                        // Remove tag from string if it was matched
+                        lengthRead -= (int32_t) pStopTag->pTagDef->length - 1;
+                    }
+                } else {
+                    // Not anything
+                    matchPos = 0;
                 }
-                if (matchPos == (int32_t) pStopTag->pTagDef->length) {
-                    pStopTag->found = true;
-                    // Remove tag from string if it was matched
-                    lengthRead -= (int32_t) pStopTag->pTagDef->length - 1;
-                }
-            } else {
-                // Not anything
-                matchPos = 0;
-            }
-            if (!pStopTag->found) {
-                if (pString != NULL) {
-                    // Add the character to the string
-                    *(pString + lengthRead) = (char) c;
+                if (!pStopTag->found) {
+                    if (pString != NULL) {
+                        // Add the character to the string
+                        *(pString + lengthRead) = (char) c;
+                    }
+                    lengthRead++;
                 }
-                lengthRead++;
             }
         }
     }
@@ -2175,7 +2603,8 @@ static bool processResponse(uAtClientInstance_t *pClient,
                         // between it and where we are now to read
                         pTmp = pMemStr(U_AT_CLIENT_DATA_BUFFER_PTR(pClient->pReceiveBuffer) +
                                        pClient->pReceiveBuffer->readIndex,
-                                       pClient->pReceiveBuffer->length,
+                                       pClient->pReceiveBuffer->length -
+                                       pClient->pReceiveBuffer->readIndex,
                                        U_AT_CLIENT_CRLF, U_AT_CLIENT_CRLF_LENGTH_BYTES);
                         if ((pTmp != NULL) &&
                             (pTmp - U_AT_CLIENT_DATA_BUFFER_PTR(pClient->pReceiveBuffer)) > 0) {
@@ -2258,6 +2687,7 @@ static size_t write(uAtClientInstance_t *pClient,
     uAtClientTag_t savedStopTag;
     bool savedDelimiterRequired;
     uAtClientDeviceError_t savedDeviceError;
+    uAtClientStatsCurrent_t savedStatsCurrent = {0};
     uDeviceSerial_t *pDeviceSerial;
 
     while (((pData < pDataEnd) || andFlush) &&
@@ -2289,6 +2719,10 @@ static size_t write(uAtClientInstance_t *pClient,
             savedStopTag = pClient->stopTag;
             savedDelimiterRequired = pClient->delimiterRequired;
             savedDeviceError = pClient->deviceError;
+            if (pClient->pStats != NULL) {
+                savedStatsCurrent = pClient->pStats->current;
+                pClient->pStats->current.index = -1;
+            }
             // Reset the scope, stopTag and delimiterRequired
             pClient->scope = U_AT_CLIENT_SCOPE_NONE;
             pClient->stopTag.pTagDef = &gNoStopTag;
@@ -2313,6 +2747,9 @@ static size_t write(uAtClientInstance_t *pClient,
             pClient->stopTag = savedStopTag;
             pClient->delimiterRequired = savedDelimiterRequired;
             pClient->deviceError = savedDeviceError;
+            if (pClient->pStats != NULL) {
+                pClient->pStats->current = savedStatsCurrent;
+            }
             // Set the adjusted lock time, allowing for potential
             // wrap in uPortGetTickTimeMs()
             wakeUpDurationMs = uPortGetTickTimeMs() - wakeUpDurationMs;
@@ -2373,6 +2810,9 @@ static size_t write(uAtClientInstance_t *pClient,
                     pDataToWrite += thisLengthWritten;
                     lengthToWrite -= thisLengthWritten;
                     pClient->lastTxTimeMs = uPortGetTickTimeMs();
+                    if (pClient->pStats != NULL) {
+                        pClient->pStats->client.bytesSent += thisLengthWritten;
+                    }
                 } else {
                     setError(pClient, U_ERROR_COMMON_DEVICE_ERROR);
                 }
@@ -2505,6 +2945,95 @@ static void unlockNoDataCheck(uAtClientInstance_t *pClient,
     uPortMutexUnlock(streamMutex);
 }
 
+// Handle the response to a pipelined AT command and call its
+// callback.  The client mutex must NOT be locked when this is
+// called since the response may be interleaved with URCs.
+static void pipelineComplete(uAtClientInstance_t *pClient,
+                             const uAtClientPipelineEntry_t *pEntry)
+{
+    uAtClientPipeline_t *pPipeline = &(pClient->pipeline);
+    int32_t errorCode = (int32_t) pPipeline->error;
+    bool callbackCalled = false;
+
+    if (pClient->pStats != NULL) {
+        // Pick up the statistics of this command: bytesSentStart
+        // was stored as the number of bytes sent by it
+        pClient->pStats->current = pEntry->stats;
+        pClient->pStats->current.bytesSentStart = pClient->pStats->client.bytesSent -
+                                                  pEntry->stats.bytesSentStart;
+        pClient->pStats->current.bytesReceivedStart = pClient->pStats->client.bytesReceived;
+    }
+
+    if (!pPipeline->outOfStep) {
+        clearError(pClient);
+        // The AT timeout runs from when this command was sent
+        pClient->lockTimeMs = pEntry->sentTimeMs;
+        errorCode = uAtClientResponseStart((uAtClientHandle_t) pClient,
+                                           pEntry->pPrefix);
+        if ((pEntry->pPrefix != NULL) && (errorCode == 0) &&
+            (pEntry->pCallback != NULL)) {
+            // Let the callback read the information response
+            pEntry->pCallback((uAtClientHandle_t) pClient, errorCode,
+                              pEntry->pCallbackParam);
+            callbackCalled = true;
+        }
+        uAtClientResponseStop((uAtClientHandle_t) pClient);
+        if (pEntry->pPrefix == NULL) {
+            // Without a prefix uAtClientResponseStart() returns
+            // U_ERROR_COMMON_NOT_FOUND, which says nothing about
+            // the AT command: its outcome is the AT client error
+            errorCode = (int32_t) pClient->error;
+        }
+        if (pClient->error != U_ERROR_COMMON_SUCCESS) {
+            errorCode = (int32_t) pClient->error;
+            if (pPipeline->error == U_ERROR_COMMON_SUCCESS) {
+                pPipeline->error = pClient->error;
+            }
+            if (pClient->deviceError.type == U_AT_CLIENT_DEVICE_ERROR_TYPE_NO_ERROR) {
+                // Not an error reported by the module, e.g. a
+                // timeout, so we can no longer be sure which
+                // response belongs to which command
+                pPipeline->outOfStep = true;
+            }
+        }
+    }
+
+    if (!callbackCalled && (pEntry->pCallback != NULL)) {
+        pEntry->pCallback((uAtClientHandle_t) pClient, errorCode,
+                          pEntry->pCallbackParam);
+    }
+
+    // In case uAtClientResponseStop() was never reached
+    statsCommandClose(pClient);
+
+    if (!pPipeline->outOfStep) {
+        // The error is recorded in the pipeline, clear it from
+        // the AT client so that the next command can proceed
+        clearError(pClient);
+    }
+}
+
+// Handle the response to the oldest outstanding pipelined
+// AT command.  The client mutex must NOT be locked when this
+// is called.
+static void pipelineProcessOne(uAtClientInstance_t *pClient)
+{
+    uAtClientPipeline_t *pPipeline = &(pClient->pipeline);
+    uAtClientPipelineEntry_t entry;
+
+    if (pPipeline->count > 0) {
+        // Take a copy and free the entry before calling
+        // the callback, just in case
+        entry = pPipeline->pEntry[pPipeline->readIndex];
+        pPipeline->readIndex++;
+        if (pPipeline->readIndex >= pPipeline->window) {
+            pPipeline->readIndex = 0;
+        }
+        pPipeline->count--;
+        pipelineComplete(pClient, &entry);
+    }
+}
+
 // Convert a string which should contain
 // something like "7587387289371387" (and
 // be null-terminated) into a uint64_t
@@ -2514,6 +3043,9 @@ static uint64_t stringToUint64(const char *pBuffer)
 {
     uint64_t uint64 = 0;
 
+    while ((*pBuffer != 0) && ((*pBuffer < '0') || (*pBuffer > '9'))) {
+        pBuffer++;
+    }
     while (*pBuffer >= '0' && *pBuffer <= '9') {
         uint64 = (uint64 * 10) + (*pBuffer++ - '0');
     }
@@ -2661,7 +3193,8 @@ static void urcCallback(const uAtClientStreamHandle_t *pStream,
                                     // If no bufferMatch was found, look for CR/LF
                                 } else if (pMemStr(U_AT_CLIENT_DATA_BUFFER_PTR(pReceiveBuffer) +
                                                    pReceiveBuffer->readIndex,
-                                                   pReceiveBuffer->length,
+                                                   pReceiveBuffer->length -
+                                                   pReceiveBuffer->readIndex,
                                                    U_AT_CLIENT_CRLF, U_AT_CLIENT_CRLF_LENGTH_BYTES) != NULL) {
                                     // Consume everything up to the CR/LF
                                     consumeToString(pClient, U_AT_CLIENT_CRLF);
@@ -2813,6 +3346,7 @@ static uAtClientHandle_t clientAdd(const uAtClientStreamHandle_t *pStream,
                         pClient->delimiter = U_AT_CLIENT_DEFAULT_DELIMITER;
                         mutexStackInit(&(pClient->lockedStreamMutexStack));
                         pClient->delayMs = U_AT_CLIENT_DEFAULT_DELAY_MS;
+                        pClient->pipeline.window = 1;
                         clearError(pClient);
                         // This will also set stopTag
                         setScope(pClient, U_AT_CLIENT_SCOPE_NONE);
@@ -3241,6 +3775,50 @@ void uAtClientDelaySet(uAtClientHandle_t atHandle,
     }
 }
 
+// Set the pipeline window.
+int32_t uAtClientPipelineWindowSet(uAtClientHandle_t atHandle,
+                                   size_t window)
+{
+    int32_t errorCode = (int32_t) U_ERROR_COMMON_INVALID_PARAMETER;
+    uAtClientInstance_t *pClient = (uAtClientInstance_t *) atHandle;
+    uAtClientPipeline_t *pPipeline = &(pClient->pipeline);
+    uAtClientPipelineEntry_t *pEntry = NULL;
+
+    U_AT_CLIENT_LOCK_CLIENT_MUTEX(pClient);
+
+    if ((window > 0) && (window <= U_AT_CLIENT_PIPELINE_WINDOW_MAX)) {
+        errorCode = (int32_t) U_ERROR_COMMON_BUSY;
+        if (pPipeline->count == 0) {
+            errorCode = (int32_t) U_ERROR_COMMON_SUCCESS;
+            if (window != pPipeline->window) {
+                if (window > 1) {
+                    errorCode = (int32_t) U_ERROR_COMMON_NO_MEMORY;
+                    pEntry = (uAtClientPipelineEntry_t *) pUPortMalloc(window *
+                                                                      sizeof(*pEntry));
+                }
+                if ((window == 1) || (pEntry != NULL)) {
+                    uPortFree(pPipeline->pEntry);
+                    pPipeline->pEntry = pEntry;
+                    pPipeline->window = window;
+                    pPipeline->readIndex = 0;
+                    errorCode = (int32_t) U_ERROR_COMMON_SUCCESS;
+                }
+            }
+        }
+    }
+
+    U_AT_CLIENT_UNLOCK_CLIENT_MUTEX(pClient);
+
+    return errorCode;
+}
+
+// Get the pipeline window.
+//lint -e{818} suppress "could be declared as pointing to const": it is!
+size_t uAtClientPipelineWindowGet(const uAtClientHandle_t atHandle)
+{
+    return ((uAtClientInstance_t *) atHandle)->pipeline.window;
+}
+
 /* ----------------------------------------------------------------
  * PUBLIC FUNCTIONS: SEND AN AT COMMAND
  * -------------------------------------------------------------- */
@@ -3311,8 +3889,16 @@ int32_t uAtClientUnlock(uAtClientHandle_t atHandle)
     int32_t sendErrorCode;
     uDeviceSerial_t *pDeviceSerial;
 
+    // Deal with any outstanding pipelined commands; this
+    // must be done without the client mutex locked
+    if (pClient != NULL) {
+        uAtClientPipelineFlush(atHandle);
+    }
+
     U_AT_CLIENT_LOCK_CLIENT_MUTEX(pClient);
 
+    statsCommandClose(pClient);
+
     streamMutex = mutexStackPop(&(pClient->lockedStreamMutexStack));
     if (streamMutex != NULL) {
         unlockNoDataCheck(pClient, streamMutex);
@@ -3388,8 +3974,10 @@ void uAtClientCommandStart(uAtClientHandle_t atHandle,
 
     if (pClient->error == U_ERROR_COMMON_SUCCESS) {
         // Wait for delay period if required, constructed this way
-        // to be safe if uPortGetTickTimeMs() wraps
-        if (pClient->delayMs > 0) {
+        // to be safe if uPortGetTickTimeMs() wraps; there is no
+        // delay while pipelined commands are outstanding as the
+        // last response is not from the previous command
+        if ((pClient->delayMs > 0) && (pClient->pipeline.count == 0)) {
             while (uPortGetTickTimeMs() - pClient->lastResponseStopMs < pClient->delayMs) {
                 uPortTaskBlock(10);
             }
@@ -3400,6 +3988,9 @@ void uAtClientCommandStart(uAtClientHandle_t atHandle,
         // Note: allow pCommand to be NULL here only
         // because that is useful during testing
         if (pCommand != NULL) {
+            // If the last command was never stopped, close it
+            statsCommandClose(pClient);
+            statsCommandOpen(pClient, pCommand);
             write(pClient, pCommand, strlen(pCommand), false);
         }
     }
@@ -3556,6 +4147,85 @@ void uAtClientCommandStopReadResponse(uAtClientHandle_t atHandle)
     uAtClientResponseStop(atHandle);
 }
 
+// Stop the outgoing part, leaving the response to a callback.
+void uAtClientCommandStopPipelined(uAtClientHandle_t atHandle,
+                                   const char *pPrefix,
+                                   uAtClientPipelineCallback_t pCallback,
+                                   void *pParameter)
+{
+    uAtClientInstance_t *pClient = (uAtClientInstance_t *) atHandle;
+    uAtClientPipeline_t *pPipeline = &(pClient->pipeline);
+    uAtClientPipelineEntry_t entry;
+    size_t x;
+
+    // IMPORTANT: this can't lock pClient->mutex as it
+    // may handle responses, which may contain URCs.
+
+    uAtClientCommandStop(atHandle);
+
+    entry.pPrefix = pPrefix;
+    entry.pCallback = pCallback;
+    entry.pCallbackParam = pParameter;
+    entry.sentTimeMs = uPortGetTickTimeMs();
+    entry.stats.index = -1;
+    if (pClient->pStats != NULL) {
+        // The statistics of this command travel with it
+        entry.stats = pClient->pStats->current;
+        entry.stats.bytesSentStart = pClient->pStats->client.bytesSent -
+                                     entry.stats.bytesSentStart;
+        pClient->pStats->current.index = -1;
+    }
+    if ((pClient->error != U_ERROR_COMMON_SUCCESS) || pPipeline->outOfStep) {
+        // Failed to send, or we're already in trouble:
+        // just report it
+        if (pPipeline->error == U_ERROR_COMMON_SUCCESS) {
+            pPipeline->error = pClient->error;
+        }
+        pPipeline->outOfStep = true;
+        pipelineComplete(pClient, &entry);
+    } else if (pPipeline->pEntry == NULL) {
+        // Window of 1: just stop and wait
+        pipelineComplete(pClient, &entry);
+    } else {
+        x = pPipeline->readIndex + pPipeline->count;
+        if (x >= pPipeline->window) {
+            x -= pPipeline->window;
+        }
+        pPipeline->pEntry[x] = entry;
+        pPipeline->count++;
+        // If the window is now full, make room for the next one
+        while (pPipeline->count >= pPipeline->window) {
+            pipelineProcessOne(pClient);
+        }
+    }
+}
+
+// Wait for the responses to all outstanding pipelined commands.
+int32_t uAtClientPipelineFlush(uAtClientHandle_t atHandle)
+{
+    uAtClientInstance_t *pClient = (uAtClientInstance_t *) atHandle;
+    uAtClientPipeline_t *pPipeline = &(pClient->pipeline);
+    uErrorCode_t error;
+
+    // IMPORTANT: this can't lock pClient->mutex as it
+    // handles responses, which may contain URCs.
+
+    while (pPipeline->count > 0) {
+        pipelineProcessOne(pClient);
+    }
+
+    error = pPipeline->error;
+    pPipeline->error = U_ERROR_COMMON_SUCCESS;
+    pPipeline->outOfStep = false;
+    if (error != U_ERROR_COMMON_SUCCESS) {
+        // Leave the AT client in error, as would happen
+        // for a non-pipelined command
+        setError(pClient, error);
+    }
+
+    return (int32_t) error;
+}
+
 // Start the response part.
 int32_t uAtClientResponseStart(uAtClientHandle_t atHandle,
                                const char *pPrefix)
@@ -3751,6 +4421,110 @@ int32_t uAtClientReadBytes(uAtClientHandle_t atHandle,
     return lengthRead;
 }
 
+// Read bytes in place.
+int32_t uAtClientReadBytesSpan(uAtClientHandle_t atHandle,
+                               const char **ppSpan,
+                               size_t lengthBytes)
+{
+    uAtClientInstance_t *pClient = (uAtClientInstance_t *) atHandle;
+    uAtClientReceiveBuffer_t *pReceiveBuffer = pClient->pReceiveBuffer;
+    uAtClientTag_t *pStopTag = &(pClient->stopTag);
+    int32_t lengthRead = -1;
+    size_t available;
+    size_t tagPosition;
+    size_t partialLength = 0;
+    const char *pSpan;
+#if U_CFG_ENABLE_LOGGING
+    char timestampBuffer[U_AT_CLIENT_PRINT_TIMESTAMP_BUFFER_SIZE_BYTES];
+#endif
+
+    U_AT_CLIENT_LOCK_CLIENT_MUTEX(pClient);
+
+    *ppSpan = NULL;
+    if ((pClient->error == U_ERROR_COMMON_SUCCESS) && !pStopTag->found) {
+        // A span can be no larger than the receive buffer
+        if (lengthBytes > pReceiveBuffer->dataBufferSize) {
+            lengthBytes = pReceiveBuffer->dataBufferSize;
+        }
+        available = pReceiveBuffer->length - pReceiveBuffer->readIndex;
+        if (available < lengthBytes) {
+            // Not enough in the buffer: move what is unread
+            // down to the start of the buffer, so that there is
+            // room for the rest to follow it contiguously, and
+            // wait for it.  Doing the move here, before the span
+            // is handed out, means that the span can't be moved
+            // from under the caller.
+            bufferRewind(pClient);
+            while ((available < lengthBytes) &&
+                   (pReceiveBuffer->lengthBuffered < pReceiveBuffer->dataBufferSize) &&
+                   bufferFill(pClient, true)) {
+                available = pReceiveBuffer->length - pReceiveBuffer->readIndex;
+            }
+        }
+        if (available > 0) {
+            pClient->numConsecutiveAtTimeouts = 0;
+            if (available > lengthBytes) {
+                available = lengthBytes;
+            }
+            tagPosition = available;
+            if (pStopTag->pTagDef->length > 0) {
+                // Check for the stop tag, which may run on
+                // beyond the bytes of the span
+                tagPosition = stopTagPosition(pClient, available, &partialLength);
+                if ((tagPosition == available) && (partialLength == available)) {
+                    // The span is nothing but what could be the
+                    // start of a stop tag: wait for the rest, if it
+                    // is coming, to find out whether it is one
+                    bufferRewind(pClient);
+                    while ((tagPosition == available) && (partialLength == available) &&
+                           (pReceiveBuffer->lengthBuffered < pReceiveBuffer->dataBufferSize) &&
+                           bufferFill(pClient, true)) {
+                        tagPosition = stopTagPosition(pClient, available, &partialLength);
+                    }
+                    if (partialLength == available) {
+                        // Nothing more came: it is data
+                        partialLength = 0;
+                    }
+                }
+                // Hold back what could be the start of a stop
+                // tag until the next call, when the rest of
+                // it, if it is one, will be here
+                available -= partialLength;
+            }
+            pSpan = U_AT_CLIENT_DATA_BUFFER_PTR(pReceiveBuffer) +
+                    pReceiveBuffer->readIndex;
+            if (tagPosition < available) {
+                // Return only what comes before the stop tag,
+                // consuming it
+                pStopTag->found = true;
+                available = tagPosition;
+                pReceiveBuffer->readIndex += pStopTag->pTagDef->length;
+            }
+            pReceiveBuffer->readIndex += available;
+            if (available > 0) {
+                *ppSpan = pSpan;
+            }
+            lengthRead = (int32_t) available;
+        } else {
+            // Timeout
+            if (pClient->debugOn) {
+                uPortLog("U_AT_CLIENT_%d-%d%s: timeout.\n",
+                         pClient->stream.type, U_AT_CLIENT_HANDLE_FOR_PRINT(pClient),
+                         pPrintTimestamp(" ", NULL, timestampBuffer, sizeof(timestampBuffer)));
+            }
+            setError(pClient, U_ERROR_COMMON_DEVICE_ERROR);
+            consecutiveTimeout(pClient);
+        }
+    } else if (pClient->error == U_ERROR_COMMON_SUCCESS) {
+        // Stop tag already found, nothing more to read
+        lengthRead = 0;
+    }
+
+    U_AT_CLIENT_UNLOCK_CLIENT_MUTEX(pClient);
+
+    return lengthRead;
+}
+
 int32_t uAtClientReadHexData(uAtClientHandle_t atHandle,
                              uint8_t *pData,
                              uint8_t lengthBytes)
@@ -3791,6 +4565,8 @@ void uAtClientResponseStop(uAtClientHandle_t atHandle)
 
     pClient->lastResponseStopMs = uPortGetTickTimeMs();
 
+    statsCommandClose(pClient);
+
     U_AT_CLIENT_UNLOCK_CLIENT_MUTEX(pClient);
 }
 
@@ -3997,6 +4773,7 @@ int32_t uAtClientSetUrcHandler(uAtClientHandle_t atHandle,
 {
     uAtClientInstance_t *pClient = (uAtClientInstance_t *) atHandle;
     uAtClientUrc_t *pUrc = NULL;
+    uAtClientUrcTrieNode_t *pUrcTrie;
     uErrorCode_t errorCode = U_ERROR_COMMON_INVALID_PARAMETER;
     size_t prefixLength;
     char *pDest;
@@ -4056,6 +4833,18 @@ int32_t uAtClientSetUrcHandler(uAtClientHandle_t atHandle,
         pUrc->pNext = pClient->pUrcList;
         pClient->pUrcList = pUrc;
 
+        // Re-compile the prefix trie that URCs are matched against
+        pUrcTrie = pUrcTrieBuild(pClient->pUrcList);
+        if (pUrcTrie != NULL) {
+            uPortFree(pClient->pUrcTrie);
+            pClient->pUrcTrie = pUrcTrie;
+        } else {
+            // Can't match it, so can't have it
+            pClient->pUrcList = pUrc->pNext;
+            uPortFree(pUrc);
+            errorCode = U_ERROR_COMMON_NO_MEMORY;
+        }
+
         U_PORT_MUTEX_UNLOCK(pClient->urcPermittedMutex);
     }
 
@@ -4086,6 +4875,13 @@ void uAtClientRemoveUrcHandler(uAtClientHandle_t atHandle,
             } else {
                 pClient->pUrcList = pCurrent->pNext;
             }
+            // Removing from the trie can't fail, whereas
+            // re-compiling it might, so just do that
+            urcTrieRemove(pClient->pUrcTrie, pCurrent);
+            if (pClient->pUrcList == NULL) {
+                uPortFree(pClient->pUrcTrie);
+                pClient->pUrcTrie = NULL;
+            }
 
             U_PORT_MUTEX_UNLOCK(pClient->urcPermittedMutex);
 
@@ -4284,6 +5080,150 @@ int32_t uAtClientUrcDirect(uAtClientHandle_t atHandle,
     return errorCode;
 }
 
+/* ----------------------------------------------------------------
+ * PUBLIC FUNCTIONS: STATISTICS
+ * -------------------------------------------------------------- */
+
+// Start keeping statistics.
+int32_t uAtClientStatsStart(uAtClientHandle_t atHandle)
+{
+    int32_t errorCode = (int32_t) U_ERROR_COMMON_SUCCESS;
+    uAtClientInstance_t *pClient = (uAtClientInstance_t *) atHandle;
+
+    U_AT_CLIENT_LOCK_CLIENT_MUTEX(pClient);
+
+    if (pClient->pStats == NULL) {
+        errorCode = (int32_t) U_ERROR_COMMON_NO_MEMORY;
+        pClient->pStats = (uAtClientStatsContext_t *) pUPortMalloc(sizeof(*(pClient->pStats)));
+        if (pClient->pStats != NULL) {
+            memset(pClient->pStats, 0, sizeof(*(pClient->pStats)));
+            pClient->pStats->startTimeMs = uPortGetTickTimeMs();
+            pClient->pStats->current.index = -1;
+            errorCode = (int32_t) U_ERROR_COMMON_SUCCESS;
+        }
+    }
+
+    U_AT_CLIENT_UNLOCK_CLIENT_MUTEX(pClient);
+
+    return errorCode;
+}
+
+// Stop keeping statistics.
+void uAtClientStatsStop(uAtClientHandle_t atHandle)
+{
+    uAtClientInstance_t *pClient = (uAtClientInstance_t *) atHandle;
+
+    U_AT_CLIENT_LOCK_CLIENT_MUTEX(pClient);
+
+    uPortFree(pClient->pStats);
+    pClient->pStats = NULL;
+
+    U_AT_CLIENT_UNLOCK_CLIENT_MUTEX(pClient);
+}
+
+// Reset the statistics.
+void uAtClientStatsReset(uAtClientHandle_t atHandle)
+{
+    uAtClientInstance_t *pClient = (uAtClientInstance_t *) atHandle;
+
+    U_AT_CLIENT_LOCK_CLIENT_MUTEX(pClient);
+
+    if (pClient->pStats != NULL) {
+        memset(pClient->pStats, 0, sizeof(*(pClient->pStats)));
+        pClient->pStats->startTimeMs = uPortGetTickTimeMs();
+        pClient->pStats->current.index = -1;
+    }
+
+    U_AT_CLIENT_UNLOCK_CLIENT_MUTEX(pClient);
+}
+
+// Get the overall statistics.
+int32_t uAtClientStatsGet(uAtClientHandle_t atHandle,
+                          uAtClientStats_t *pStats)
+{
+    int32_t errorCodeOrNumCommands = (int32_t) U_ERROR_COMMON_NOT_INITIALISED;
+    uAtClientInstance_t *pClient = (uAtClientInstance_t *) atHandle;
+
+    U_AT_CLIENT_LOCK_CLIENT_MUTEX(pClient);
+
+    if (pClient->pStats != NULL) {
+        errorCodeOrNumCommands = (int32_t) U_ERROR_COMMON_INVALID_PARAMETER;
+        if (pStats != NULL) {
+            *pStats = pClient->pStats->client;
+            pStats->durationMs = uPortGetTickTimeMs() - pClient->pStats->startTimeMs;
+            errorCodeOrNumCommands = pStats->numCommands;
+        }
+    }
+
+    U_AT_CLIENT_UNLOCK_CLIENT_MUTEX(pClient);
+
+    return errorCodeOrNumCommands;
+}
+
+// Get the statistics for one AT command.
+int32_t uAtClientStatsCommandGet(uAtClientHandle_t atHandle,
+                                 size_t index,
+                                 uAtClientStatsCommand_t *pCommandStats)
+{
+    int32_t errorCode = (int32_t) U_ERROR_COMMON_NOT_INITIALISED;
+    uAtClientInstance_t *pClient = (uAtClientInstance_t *) atHandle;
+
+    U_AT_CLIENT_LOCK_CLIENT_MUTEX(pClient);
+
+    if (pClient->pStats != NULL) {
+        errorCode = (int32_t) U_ERROR_COMMON_INVALID_PARAMETER;
+        if ((pCommandStats != NULL) &&
+            (index < (size_t) pClient->pStats->client.numCommands)) {
+            *pCommandStats = pClient->pStats->command[index];
+            if (pCommandStats->count == 0) {
+                pCommandStats->latencyMinMs = 0;
+            }
+            errorCode = (int32_t) U_ERROR_COMMON_SUCCESS;
+        }
+    }
+
+    U_AT_CLIENT_UNLOCK_CLIENT_MUTEX(pClient);
+
+    return errorCode;
+}
+
+// Print the statistics.
+void uAtClientStatsPrint(uAtClientHandle_t atHandle)
+{
+    uAtClientStats_t stats;
+    uAtClientStatsCommand_t commandStats;
+    int32_t numCommands;
+
+    numCommands = uAtClientStatsGet(atHandle, &stats);
+    if (numCommands >= 0) {
+        uPortLog("U_AT_CLIENT: statistics over %d ms: %d byte(s) sent,"
+                 " %d byte(s) received, %d URC(s) taking %d ms in total,"
+                 " longest %d ms.\n", (int32_t) stats.durationMs,
+                 (int32_t) stats.bytesSent, (int32_t) stats.bytesReceived,
+                 stats.numUrcs, (int32_t) stats.urcHandlerTotalMs,
+                 stats.urcHandlerMaxMs);
+        for (int32_t x = 0; x < numCommands; x++) {
+            if (uAtClientStatsCommandGet(atHandle, x, &commandStats) == 0) {
+                uPortLog("U_AT_CLIENT:   \"%s\": %d, latency min/average/max"
+                         " %d/%d/%d ms, %d/%d byte(s) sent/received, %d"
+                         " timeout(s), %d error(s).\n",
+                         commandStats.command[0] != 0 ? commandStats.command : "(others)",
+                         commandStats.count, commandStats.latencyMinMs,
+                         (int32_t) (commandStats.count > 0 ?
+                                    commandStats.latencyTotalMs / commandStats.count : 0),
+                         commandStats.latencyMaxMs, (int32_t) commandStats.bytesSent,
+                         (int32_t) commandStats.bytesReceived,
+                         commandStats.numTimeouts, commandStats.numDeviceErrors);
+                uPortLog("U_AT_CLIENT:     latency histogram:");
+                for (size_t y = 0; y < U_AT_CLIENT_STATS_NUM_HISTOGRAM_BUCKETS; y++) {
+                    uPortLog(" %d", commandStats.latencyHistogram[y]);
+                }
+                uPortLog(".\n");
+            }
+        }
+    }
+}
+
 /* ----------------------------------------------------------------
  * PUBLIC FUNCTIONS: MISC
  * -------------------------------------------------------------- */
@@ -0,0 +1,1226 @@
+/*
+ * Copyright 2019-2024 u-blox
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* Only #includes of u_* and the C standard library are allowed here,
+ * no platform stuff and no OS stuff.  Anything required from
+ * the platform/OS must be brought in through u_port* to maintain
+ * portability.
+ */
+
+/** @file
+ * @brief Capture and replay of AT traffic for the AT client; see
+ * u_at_client_replay.h for a description of the transcript format.
+ */
+
+#ifdef U_CFG_OVERRIDE
+# include "u_cfg_override.h" // For a customer's configuration override
+#endif
+
+#include "stddef.h"    // NULL, size_t etc.
+#include "stdint.h"    // int32_t etc.
+#include "stdbool.h"
+#include "stdlib.h"    // qsort()
+#include "string.h"    // memcpy(), memcmp(), memchr(), strlen()
+#include "stdio.h"     // snprintf()
+#include "ctype.h"     // isalnum()
+
+#include "u_error_common.h"
+
+#include "u_port_clib_platform_specific.h" /* Integer stdio, must be included
+                                              before the other port files if
+                                              any print or scan function is used. */
+#include "u_port.h"
+#include "u_port_os.h"
+#include "u_port_heap.h"
+#include "u_port_debug.h"
+
+#include "u_interface.h"
+#include "u_device_serial.h"
+
+#include "u_at_client.h"
+
+#include "u_at_client_replay.h"
+
+/* ----------------------------------------------------------------
+ * COMPILE-TIME MACROS
+ * -------------------------------------------------------------- */
+
+/** The length of the longest response prefix that will be derived
+ * from a recorded AT command, e.g. "+UMQTTC:", including the
+ * terminator.
+ */
+#define U_AT_CLIENT_REPLAY_PREFIX_MAX_LENGTH_BYTES 32
+
+/** The longest a transcript line written by the capture can be:
+ * direction, time, spaces, the data with every byte escaped as
+ * "\xHH" and a terminator.
+ */
+#define U_AT_CLIENT_REPLAY_CAPTURE_LINE_MAX_LENGTH_BYTES (16 + \
+                                                          (U_AT_CLIENT_REPLAY_CAPTURE_LINE_MAX_DATA_LENGTH_BYTES * 4))
+
+/** How long to wait, beyond the recorded time of the last record,
+ * for the tail of a timed replay to be consumed.
+ */
+#define U_AT_CLIENT_REPLAY_TAIL_GUARD_MS 1000
+
+/* ----------------------------------------------------------------
+ * TYPES
+ * -------------------------------------------------------------- */
+
+/** The state of a capture.
+ */
+typedef struct {
+    uAtClientHandle_t atHandle;
+    uAtClientReplayCapturePrint_t *pPrint;
+    void *pParam;
+    int32_t lastTimeMs;
+    char txData[U_AT_CLIENT_REPLAY_CAPTURE_LINE_MAX_DATA_LENGTH_BYTES];
+    size_t txLength;
+    char line[U_AT_CLIENT_REPLAY_CAPTURE_LINE_MAX_LENGTH_BYTES];
+} uAtClientReplayCapture_t;
+
+/** The context of the virtual serial device that plays the
+ * transcript back: TX records are matched against what the AT
+ * client writes, RX records are released to the AT client once
+ * everything it transmitted before them has been written and,
+ * if timed, once their recorded time has come.
+ */
+typedef struct {
+    const uAtClientReplayTranscript_t *pTranscript;
+    bool timed;
+    int32_t startTimeMs;
+    int32_t *pTimeMs; /**< when each record was written or released,
+                           -1 until then. */
+    size_t txRecord; /**< the TX record next to be written. */
+    size_t txPos;
+    bool txMismatch; /**< true if txRecord has already mismatched. */
+    size_t rxRecord; /**< the RX record next to be read. */
+    size_t rxPos;
+    void (*pEventCallback)(struct uDeviceSerial_t *, uint32_t, void *);
+    void *pEventCallbackParam;
+    bool eventPending; /**< set when the AT client asks for an event. */
+    bool inEventCallback;
+    size_t numMismatches;
+    int64_t bytesWritten;
+    int64_t bytesRead;
+} uAtClientReplayDevice_t;
+
+/** An AT command to be replayed, worked out from the transcript
+ * before the replay starts so that the effort is not measured.
+ */
+typedef struct {
+    size_t txFirst; /**< the first TX record of the command. */
+    size_t txEnd;   /**< one beyond the last TX record of the command. */
+    char prompt;    /**< the prompt character if the command sends
+                         data after a prompt, else 0. */
+    size_t dataFirst;
+    size_t dataEnd;
+    char prefix[U_AT_CLIENT_REPLAY_PREFIX_MAX_LENGTH_BYTES]; /**< empty if
+                                                                  the response
+                                                                  lines have
+                                                                  no prefix. */
+    size_t numLines;  /**< the number of information response lines. */
+    size_t numParams; /**< the most parameters on any of those lines. */
+} uAtClientReplayOp_t;
+
+/* ----------------------------------------------------------------
+ * VARIABLES
+ * -------------------------------------------------------------- */
+
+/** The one and only capture.
+ */
+static uAtClientReplayCapture_t *gpCapture = NULL;
+
+/* ----------------------------------------------------------------
+ * STATIC FUNCTIONS: CAPTURE
+ * -------------------------------------------------------------- */
+
+// Escape data into a transcript line, returning the length written.
+static size_t escape(const char *pData, size_t length, char *pLine)
+{
+    size_t x = 0;
+    char c;
+
+    for (size_t y = 0; y < length; y++) {
+        c = pData[y];
+        if (c == '\r') {
+            pLine[x++] = '\\';
+            pLine[x++] = 'r';
+        } else if (c == '\n') {
+            pLine[x++] = '\\';
+            pLine[x++] = 'n';
+        } else if (c == '\\') {
+            pLine[x++] = '\\';
+            pLine[x++] = '\\';
+        } else if ((c >= 0x20) && (c < 0x7f)) {
+            pLine[x++] = c;
+        } else {
+            x += snprintf(pLine + x, 5, "\\x%02X", (unsigned char) c);
+        }
+    }
+    pLine[x] = 0;
+
+    return x;
+}
+
+// Emit captured data as one or more transcript lines.
+static void captureEmit(uAtClientReplayCapture_t *pCapture, bool isTx,
+                        const char *pData, size_t length)
+{
+    size_t thisLength;
+    int32_t timeMs;
+    int32_t x;
+
+    while (length > 0) {
+        thisLength = length;
+        if (thisLength > U_AT_CLIENT_REPLAY_CAPTURE_LINE_MAX_DATA_LENGTH_BYTES) {
+            thisLength = U_AT_CLIENT_REPLAY_CAPTURE_LINE_MAX_DATA_LENGTH_BYTES;
+        }
+        timeMs = uPortGetTickTimeMs();
+        x = snprintf(pCapture->line, sizeof(pCapture->line), "%c %d ",
+                     isTx ? '>' : '<', (int) (timeMs - pCapture->lastTimeMs));
+        pCapture->lastTimeMs = timeMs;
+        escape(pData, thisLength, pCapture->line + x);
+        if (pCapture->pPrint != NULL) {
+            pCapture->pPrint(pCapture->line, pCapture->pParam);
+        } else {
+            uPortLog("%s\n", pCapture->line);
+        }
+        pData += thisLength;
+        length -= thisLength;
+    }
+}
+
+// Emit any transmitted data that has been held back.
+static void captureFlushTx(uAtClientReplayCapture_t *pCapture)
+{
+    captureEmit(pCapture, true, pCapture->txData, pCapture->txLength);
+    pCapture->txLength = 0;
+}
+
+// The transmit intercept: transmitted data is collected until
+// a flush, so that an AT command usually ends up on one line,
+// and passed on unchanged.
+static const char *pCaptureTx(uAtClientHandle_t atHandle,
+                              const char **ppData, size_t *pLength,
+                              void *pContext)
+{
+    uAtClientReplayCapture_t *pCapture = (uAtClientReplayCapture_t *) pContext;
+    const char *pData = NULL;
+    size_t thisLength;
+
+    (void) atHandle;
+
+    if (ppData == NULL) {
+        captureFlushTx(pCapture);
+        *pLength = 0;
+    } else {
+        pData = *ppData;
+        for (size_t x = 0; x < *pLength; x += thisLength) {
+            thisLength = sizeof(pCapture->txData) - pCapture->txLength;
+            if (thisLength > *pLength - x) {
+                thisLength = *pLength - x;
+            }
+            memcpy(pCapture->txData + pCapture->txLength, pData + x, thisLength);
+            pCapture->txLength += thisLength;
+            if (pCapture->txLength == sizeof(pCapture->txData)) {
+                captureFlushTx(pCapture);
+            }
+        }
+        *ppData += *pLength;
+    }
+
+    return pData;
+}
+
+// The receive intercept: received data is emitted as it arrives
+// and passed on unchanged.
+static char *pCaptureRx(uAtClientHandle_t atHandle,
+                        char **ppData, size_t *pLength,
+                        void *pContext)
+{
+    uAtClientReplayCapture_t *pCapture = (uAtClientReplayCapture_t *) pContext;
+    char *pData = NULL;
+
+    (void) atHandle;
+
+    if (*pLength > 0) {
+        captureFlushTx(pCapture);
+        captureEmit(pCapture, false, *ppData, *pLength);
+        pData = *ppData;
+        *ppData += *pLength;
+    }
+
+    return pData;
+}
+
+/* ----------------------------------------------------------------
+ * STATIC FUNCTIONS: TRANSCRIPT PARSING
+ * -------------------------------------------------------------- */
+
+// Convert a hex digit, returning -1 if it is not one.
+static int32_t hexDigit(char c)
+{
+    int32_t value = -1;
+
+    if ((c >= '0') && (c <= '9')) {
+        value = c - '0';
+    } else if ((c >= 'A') && (c <= 'F')) {
+        value = c - 'A' + 10;
+    } else if ((c >= 'a') && (c <= 'f')) {
+        value = c - 'a' + 10;
+    }
+
+    return value;
+}
+
+// Unescape the data of a transcript line into pOut, returning
+// the length or negative error code.
+static int32_t unescape(const char *pText, size_t length, char *pOut)
+{
+    int32_t lengthOrError = 0;
+    int32_t high;
+    int32_t low;
+    size_t x = 0;
+
+    while ((x < length) && (lengthOrError >= 0)) {
+        if (pText[x] != '\\') {
+            pOut[lengthOrError] = pText[x];
+            lengthOrError++;
+            x++;
+        } else if (x + 1 >= length) {
+            lengthOrError = (int32_t) U_ERROR_COMMON_INVALID_PARAMETER;
+        } else {
+            switch (pText[x + 1]) {
+                case 'r':
+                    pOut[lengthOrError] = '\r';
+                    break;
+                case 'n':
+                    pOut[lengthOrError] = '\n';
+                    break;
+                case '\\':
+                    pOut[lengthOrError] = '\\';
+                    break;
+                case 'x':
+                    high = -1;
+                    low = -1;
+                    if (x + 3 < length) {
+                        high = hexDigit(pText[x + 2]);
+                        low = hexDigit(pText[x + 3]);
+                    }
+                    if ((high >= 0) && (low >= 0)) {
+                        pOut[lengthOrError] = (char) ((high << 4) | low);
+                        x += 2;
+                    } else {
+                        lengthOrError = (int32_t) U_ERROR_COMMON_INVALID_PARAMETER;
+                    }
+                    break;
+                default:
+                    lengthOrError = (int32_t) U_ERROR_COMMON_INVALID_PARAMETER;
+                    break;
+            }
+            if (lengthOrError >= 0) {
+                lengthOrError++;
+                x += 2;
+            }
+        }
+    }
+
+    return lengthOrError;
+}
+
+// Parse a single transcript line, one that is not blank or
+// a comment, putting any data at pStorage and returning the
+// amount of storage used or negative error code.
+static int32_t parseLine(const char *pLine, size_t length, char *pStorage,
+                         uAtClientReplayTranscript_t *pTranscript)
+{
+    int32_t errorOrLength = (int32_t) U_ERROR_COMMON_INVALID_PARAMETER;
+    uAtClientReplayRecord_t *pRecord;
+    const char *pEnd = pLine + length;
+    const char *pData = pLine + 2;
+    int32_t deltaMs = 0;
+
+    if ((length > 2) && (pLine[1] == ' ')) {
+        if (pLine[0] == 'U') {
+            if (pTranscript->numUrcs < sizeof(pTranscript->pUrcPrefix) /
+                sizeof(pTranscript->pUrcPrefix[0])) {
+                memcpy(pStorage, pLine + 2, length - 2);
+                pStorage[length - 2] = 0;
+                pTranscript->pUrcPrefix[pTranscript->numUrcs] = pStorage;
+                pTranscript->numUrcs++;
+                errorOrLength = (int32_t) (length - 1);
+            } else {
+                errorOrLength = (int32_t) U_ERROR_COMMON_NO_MEMORY;
+            }
+        } else if ((pLine[0] == '>') || (pLine[0] == '<')) {
+            // Can't use strtol() as the line is not terminated
+            while ((pData < pEnd) && (*pData >= '0') && (*pData <= '9') &&
+                   (deltaMs < 10000000)) {
+                deltaMs = (deltaMs * 10) + (*pData - '0');
+                pData++;
+            }
+            if ((pData > pLine + 2) && (pData < pEnd) && (*pData == ' ')) {
+                pData++;
+                errorOrLength = unescape(pData, pEnd - pData, pStorage);
+                if (errorOrLength > 0) {
+                    pRecord = pTranscript->pRecord + pTranscript->numRecords;
+                    pRecord->isTx = (pLine[0] == '>');
+                    pRecord->deltaMs = deltaMs;
+                    pRecord->pData = pStorage;
+                    pRecord->length = (size_t) errorOrLength;
+                    pTranscript->numRecords++;
+                } else if (errorOrLength == 0) {
+                    errorOrLength = (int32_t) U_ERROR_COMMON_INVALID_PARAMETER;
+                }
+            }
+        }
+    }
+
+    return errorOrLength;
+}
+
+/* ----------------------------------------------------------------
+ * STATIC FUNCTIONS: THE REPLAY DEVICE
+ * -------------------------------------------------------------- */
+
+// Move txRecord on to the next TX record from the given one.
+static size_t nextTx(const uAtClientReplayTranscript_t *pTranscript, size_t record)
+{
+    while ((record < pTranscript->numRecords) && !pTranscript->pRecord[record].isTx) {
+        record++;
+    }
+
+    return record;
+}
+
+// Move rxRecord on to the next RX record from the given one.
+static size_t nextRx(const uAtClientReplayTranscript_t *pTranscript, size_t record)
+{
+    while ((record < pTranscript->numRecords) && pTranscript->pRecord[record].isTx) {
+        record++;
+    }
+
+    return record;
+}
+
+// Determine if an RX record may be read by the AT client yet,
+// releasing it if so.
+static bool replayDeviceReleased(uAtClientReplayDevice_t *pContext, size_t record)
+{
+    const uAtClientReplayRecord_t *pRecord = pContext->pTranscript->pRecord + record;
+    bool released = (pContext->pTimeMs[record] >= 0);
+    int32_t previousTimeMs = pContext->startTimeMs;
+    int32_t timeMs;
+
+    if (!released && (pContext->txRecord > record)) {
+        // Everything the AT client was to send before this
+        // has been sent
+        timeMs = uPortGetTickTimeMs();
+        if (pContext->timed) {
+            if (record > 0) {
+                previousTimeMs = pContext->pTimeMs[record - 1];
+            }
+            if ((previousTimeMs >= 0) &&
+                (timeMs - previousTimeMs >= pRecord->deltaMs)) {
+                // Use the due time rather than now so that
+                // lateness in reading doesn't accumulate
+                pContext->pTimeMs[record] = previousTimeMs + pRecord->deltaMs;
+                released = true;
+            }
+        } else {
+            pContext->pTimeMs[record] = timeMs;
+            released = true;
+        }
+    }
+
+    return released;
+}
+
+// Get the number of bytes waiting in the replay device.
+static int32_t replayDeviceGetReceiveSize(struct uDeviceSerial_t *pDeviceSerial)
+{
+    uAtClientReplayDevice_t *pContext = (uAtClientReplayDevice_t *)
+                                        pUInterfaceContext(pDeviceSerial);
+    const uAtClientReplayTranscript_t *pTranscript = pContext->pTranscript;
+    size_t record = pContext->rxRecord;
+    int32_t sizeBytes = 0;
+
+    if ((record < pTranscript->numRecords) && replayDeviceReleased(pContext, record)) {
+        sizeBytes = (int32_t) (pTranscript->pRecord[record].length - pContext->rxPos);
+        record = nextRx(pTranscript, record + 1);
+        while ((record < pTranscript->numRecords) &&
+               replayDeviceReleased(pContext, record)) {
+            sizeBytes += (int32_t) pTranscript->pRecord[record].length;
+            record = nextRx(pTranscript, record + 1);
+        }
+    }
+
+    return sizeBytes;
+}
+
+// Read from the replay device.
+static int32_t replayDeviceRead(struct uDeviceSerial_t *pDeviceSerial,
+                                void *pBuffer, size_t sizeBytes)
+{
+    uAtClientReplayDevice_t *pContext = (uAtClientReplayDevice_t *)
+                                        pUInterfaceContext(pDeviceSerial);
+    const uAtClientReplayTranscript_t *pTranscript = pContext->pTranscript;
+    const uAtClientReplayRecord_t *pRecord;
+    size_t readLength = 0;
+    size_t thisLength;
+
+    while ((readLength < sizeBytes) &&
+           (pContext->rxRecord < pTranscript->numRecords) &&
+           replayDeviceReleased(pContext, pContext->rxRecord)) {
+        pRecord = pTranscript->pRecord + pContext->rxRecord;
+        thisLength = pRecord->length - pContext->rxPos;
+        if (thisLength > sizeBytes - readLength) {
+            thisLength = sizeBytes - readLength;
+        }
+        memcpy(((char *) pBuffer) + readLength, pRecord->pData + pContext->rxPos,
+               thisLength);
+        pContext->rxPos += thisLength;
+        readLength += thisLength;
+        if (pContext->rxPos >= pRecord->length) {
+            pContext->rxPos = 0;
+            pContext->rxRecord = nextRx(pTranscript, pContext->rxRecord + 1);
+        }
+    }
+    pContext->bytesRead += readLength;
+
+    return (int32_t) readLength;
+}
+
+// Write to the replay device, matching what is written against
+// the TX records of the transcript.
+static int32_t replayDeviceWrite(struct uDeviceSerial_t *pDeviceSerial,
+                                 const void *pBuffer, size_t sizeBytes)
+{
+    uAtClientReplayDevice_t *pContext = (uAtClientReplayDevice_t *)
+                                        pUInterfaceContext(pDeviceSerial);
+    const uAtClientReplayTranscript_t *pTranscript = pContext->pTranscript;
+    const uAtClientReplayRecord_t *pRecord;
+    const char *pData = (const char *) pBuffer;
+    size_t x = 0;
+    size_t thisLength;
+
+    while ((x < sizeBytes) && (pContext->txRecord < pTranscript->numRecords)) {
+        pRecord = pTranscript->pRecord + pContext->txRecord;
+        thisLength = pRecord->length - pContext->txPos;
+        if (thisLength > sizeBytes - x) {
+            thisLength = sizeBytes - x;
+        }
+        if (!pContext->txMismatch &&
+            (memcmp(pData + x, pRecord->pData + pContext->txPos, thisLength) != 0)) {
+            pContext->numMismatches++;
+            pContext->txMismatch = true;
+        }
+        pContext->txPos += thisLength;
+        x += thisLength;
+        if (pContext->txPos >= pRecord->length) {
+            pContext->pTimeMs[pContext->txRecord] = uPortGetTickTimeMs();
+            pContext->txPos = 0;
+            pContext->txMismatch = false;
+            pContext->txRecord = nextTx(pTranscript, pContext->txRecord + 1);
+        }
+    }
+    if (x < sizeBytes) {
+        // Written beyond the end of the transcript
+        pContext->numMismatches++;
+    }
+    pContext->bytesWritten += sizeBytes;
+
+    return (int32_t) sizeBytes;
+}
+
+// Set the event callback of the replay device; it is only ever
+// called from replayDevicePoll().
+static int32_t replayDeviceEventCallbackSet(struct uDeviceSerial_t *pDeviceSerial,
+                                            uint32_t filter,
+                                            void (*pFunction)(struct uDeviceSerial_t *,
+                                                              uint32_t,
+                                                              void *),
+                                            void *pParam,
+                                            size_t stackSizeBytes,
+                                            int32_t priority)
+{
+    uAtClientReplayDevice_t *pContext = (uAtClientReplayDevice_t *)
+                                        pUInterfaceContext(pDeviceSerial);
+
+    (void) filter;
+    (void) stackSizeBytes;
+    (void) priority;
+
+    pContext->pEventCallback = pFunction;
+    pContext->pEventCallbackParam = pParam;
+
+    return 0;
+}
+
+// Remove the event callback of the replay device.
+static void replayDeviceEventCallbackRemove(struct uDeviceSerial_t *pDeviceSerial)
+{
+    uAtClientReplayDevice_t *pContext = (uAtClientReplayDevice_t *)
+                                        pUInterfaceContext(pDeviceSerial);
+
+    pContext->pEventCallback = NULL;
+    pContext->pEventCallbackParam = NULL;
+}
+
+// Send an event from the replay device: the AT client does this
+// when it leaves unread data in its buffer; the event is delivered
+// by replayDevicePoll().
+static int32_t replayDeviceEventSend(struct uDeviceSerial_t *pDeviceSerial,
+                                     uint32_t eventBitMap)
+{
+    uAtClientReplayDevice_t *pContext = (uAtClientReplayDevice_t *)
+                                        pUInterfaceContext(pDeviceSerial);
+
+    if (eventBitMap & U_DEVICE_SERIAL_EVENT_BITMASK_DATA_RECEIVED) {
+        pContext->eventPending = true;
+    }
+
+    return 0;
+}
+
+// The "try" version of replayDeviceEventSend().
+static int32_t replayDeviceEventTrySend(struct uDeviceSerial_t *pDeviceSerial,
+                                        uint32_t eventBitMap, int32_t delayMs)
+{
+    (void) delayMs;
+
+    return replayDeviceEventSend(pDeviceSerial, eventBitMap);
+}
+
+// Determine if we are in the event callback of the replay device.
+static bool replayDeviceEventIsCallback(struct uDeviceSerial_t *pDeviceSerial)
+{
+    uAtClientReplayDevice_t *pContext = (uAtClientReplayDevice_t *)
+                                        pUInterfaceContext(pDeviceSerial);
+
+    return pContext->inEventCallback;
+}
+
+// Populate the vector table of the replay device.
+static void replayDeviceInit(struct uDeviceSerial_t *pDeviceSerial)
+{
+    pDeviceSerial->getReceiveSize = replayDeviceGetReceiveSize;
+    pDeviceSerial->read = replayDeviceRead;
+    pDeviceSerial->write = replayDeviceWrite;
+    pDeviceSerial->eventCallbackSet = replayDeviceEventCallbackSet;
+    pDeviceSerial->eventCallbackRemove = replayDeviceEventCallbackRemove;
+    pDeviceSerial->eventSend = replayDeviceEventSend;
+    pDeviceSerial->eventTrySend = replayDeviceEventTrySend;
+    pDeviceSerial->eventIsCallback = replayDeviceEventIsCallback;
+}
+
+// Called between AT commands: if there is data waiting, i.e. URCs,
+// or the AT client has asked for an event, let the AT client know,
+// which will process them in this task, exactly as a UART event task
+// would.  Returns true if the AT client took some data.
+static bool replayDevicePoll(struct uDeviceSerial_t *pDeviceSerial)
+{
+    uAtClientReplayDevice_t *pContext = (uAtClientReplayDevice_t *)
+                                        pUInterfaceContext(pDeviceSerial);
+    int64_t bytesRead = pContext->bytesRead;
+
+    if ((pContext->pEventCallback != NULL) &&
+        (pContext->eventPending || (replayDeviceGetReceiveSize(pDeviceSerial) > 0))) {
+        pContext->eventPending = false;
+        pContext->inEventCallback = true;
+        pContext->pEventCallback(pDeviceSerial,
+                                 U_DEVICE_SERIAL_EVENT_BITMASK_DATA_RECEIVED,
+                                 pContext->pEventCallbackParam);
+        pContext->inEventCallback = false;
+    }
+
+    return (pContext->bytesRead > bytesRead);
+}
+
+// Skip the device on to the given TX record, counting anything
+// skipped as a mismatch.
+static void replayDeviceTxSeek(uAtClientReplayDevice_t *pContext, size_t record)
+{
+    const uAtClientReplayTranscript_t *pTranscript = pContext->pTranscript;
+
+    while (pContext->txRecord < record) {
+        if (!pContext->txMismatch) {
+            pContext->numMismatches++;
+        }
+        pContext->pTimeMs[pContext->txRecord] = uPortGetTickTimeMs();
+        pContext->txPos = 0;
+        pContext->txMismatch = false;
+        pContext->txRecord = nextTx(pTranscript, pContext->txRecord + 1);
+    }
+}
+
+/* ----------------------------------------------------------------
+ * STATIC FUNCTIONS: REPLAY
+ * -------------------------------------------------------------- */
+
+// Count a URC.
+static void urcHandler(uAtClientHandle_t atHandle, void *pParameters)
+{
+    (void) atHandle;
+
+    (*((size_t *) pParameters))++;
+}
+
+// Copy the data of a range of records to pBuffer, returning
+// the length.
+static size_t recordsCopy(const uAtClientReplayTranscript_t *pTranscript,
+                          size_t first, size_t end, char *pBuffer)
+{
+    size_t length = 0;
+    const uAtClientReplayRecord_t *pRecord;
+
+    for (size_t x = first; x < end; x++) {
+        pRecord = pTranscript->pRecord + x;
+        memcpy(pBuffer + length, pRecord->pData, pRecord->length);
+        length += pRecord->length;
+    }
+
+    return length;
+}
+
+// Determine if a response line is a final result code.
+static bool lineIsFinal(const char *pLine, size_t length)
+{
+    return ((length == 2) && (memcmp(pLine, "OK", 2) == 0)) ||
+           ((length == 5) && (memcmp(pLine, "ERROR", 5) == 0)) ||
+           ((length >= 10) && ((memcmp(pLine, "+CME ERROR", 10) == 0) ||
+                               (memcmp(pLine, "+CMS ERROR", 10) == 0)));
+}
+
+// Determine if a response line is blank, a URC or an echo, rather
+// than an information response.
+static bool lineIsIgnored(const uAtClientReplayTranscript_t *pTranscript,
+                          const char *pLine, size_t length)
+{
+    bool ignored = (length == 0) ||
+                   ((length >= 2) && (memcmp(pLine, "AT", 2) == 0));
+    size_t prefixLength;
+
+    for (size_t x = 0; (x < pTranscript->numUrcs) && !ignored; x++) {
+        prefixLength = strlen(pTranscript->pUrcPrefix[x]);
+        ignored = (length >= prefixLength) &&
+                  (memcmp(pLine, pTranscript->pUrcPrefix[x], prefixLength) == 0);
+    }
+
+    return ignored;
+}
+
+// Count the parameters on a response line.
+static size_t lineNumParams(const char *pLine, size_t length)
+{
+    size_t numParams = 1;
+    bool inQuotes = false;
+
+    for (size_t x = 0; x < length; x++) {
+        if (pLine[x] == '"') {
+            inQuotes = !inQuotes;
+        } else if ((pLine[x] == ',') && !inQuotes) {
+            numParams++;
+        }
+    }
+
+    return numParams;
+}
+
+// Work out how to read a response, i.e. the number of information
+// response lines and parameters, from the response data.
+static void opResponse(const uAtClientReplayTranscript_t *pTranscript,
+                       uAtClientReplayOp_t *pOp, const char *pResponse,
+                       size_t length)
+{
+    size_t prefixLength = strlen(pOp->prefix);
+    size_t numBareLines = 0;
+    size_t numBareParams = 0;
+    const char *pEnd = pResponse + length;
+    const char *pLineEnd;
+    size_t lineLength;
+    size_t numParams;
+    bool done = false;
+
+    while ((pResponse < pEnd) && !done) {
+        pLineEnd = (const char *) memchr(pResponse, '\n', pEnd - pResponse);
+        if (pLineEnd == NULL) {
+            pLineEnd = pEnd;
+        }
+        lineLength = pLineEnd - pResponse;
+        if ((lineLength > 0) && (pResponse[lineLength - 1] == '\r')) {
+            lineLength--;
+        }
+        if (lineIsFinal(pResponse, lineLength)) {
+            // Anything after the final result code is URCs
+            done = true;
+        } else if ((prefixLength > 0) && (lineLength >= prefixLength) &&
+                   (memcmp(pResponse, pOp->prefix, prefixLength) == 0)) {
+            // This is checked before lineIsIgnored() since a
+            // response may look like a URC, e.g. "+CEREG:"
+            pOp->numLines++;
+            numParams = lineNumParams(pResponse + prefixLength,
+                                      lineLength - prefixLength);
+            if (numParams > pOp->numParams) {
+                pOp->numParams = numParams;
+            }
+        } else if (!lineIsIgnored(pTranscript, pResponse, lineLength)) {
+            numBareLines++;
+            numParams = lineNumParams(pResponse, lineLength);
+            if (numParams > numBareParams) {
+                numBareParams = numParams;
+            }
+        }
+        pResponse = pLineEnd + 1;
+    }
+
+    if ((pOp->numLines == 0) && (numBareLines > 0)) {
+        // A response without a prefix, e.g. that to AT+CGSN
+        pOp->prefix[0] = 0;
+        pOp->numLines = numBareLines;
+        pOp->numParams = numBareParams;
+    }
+}
+
+// Derive the response prefix of an AT command, e.g. "+USORD:"
+// from "AT+USORD=0,5".
+static void opPrefix(uAtClientReplayOp_t *pOp, const char *pCommand, size_t length)
+{
+    size_t x = 0;
+
+    if ((length > 3) && (pCommand[2] == '+')) {
+        pOp->prefix[x] = '+';
+        x++;
+        while ((x + 2 < length) && (x < sizeof(pOp->prefix) - 2) &&
+               isalnum((unsigned char) pCommand[x + 2])) {
+            pOp->prefix[x] = pCommand[x + 2];
+            x++;
+        }
+        pOp->prefix[x] = ':';
+        x++;
+    }
+    pOp->prefix[x] = 0;
+}
+
+// Work out the AT commands to replay from the transcript; returns
+// the number of operations, which may be zero, or negative error
+// code. pBuffer must be big enough to hold the whole transcript.
+static int32_t opsCreate(const uAtClientReplayTranscript_t *pTranscript,
+                         uAtClientReplayOp_t *pOp, char *pBuffer)
+{
+    size_t numOps = 0;
+    size_t record = nextTx(pTranscript, 0);
+    size_t rxEnd;
+    size_t length;
+
+    while (record < pTranscript->numRecords) {
+        memset(pOp, 0, sizeof(*pOp));
+        pOp->txFirst = record;
+        pOp->txEnd = nextRx(pTranscript, record);
+        length = recordsCopy(pTranscript, pOp->txFirst, pOp->txEnd, pBuffer);
+        rxEnd = nextTx(pTranscript, pOp->txEnd);
+        if ((length > 2) && (pBuffer[length - 1] == '\r') &&
+            ((pBuffer[0] == 'A') || (pBuffer[0] == 'a'))) {
+            opPrefix(pOp, pBuffer, length - 1);
+            length = recordsCopy(pTranscript, pOp->txEnd, rxEnd, pBuffer);
+            if ((length > 0) && (rxEnd < pTranscript->numRecords) &&
+                ((pBuffer[length - 1] == '@') || (pBuffer[length - 1] == '>'))) {
+                // Data is sent after a prompt, the response follows that
+                pOp->prompt = pBuffer[length - 1];
+                pOp->dataFirst = rxEnd;
+                pOp->dataEnd = nextRx(pTranscript, rxEnd);
+                rxEnd = nextTx(pTranscript, pOp->dataEnd);
+                length = recordsCopy(pTranscript, pOp->dataEnd, rxEnd, pBuffer);
+            }
+            opResponse(pTranscript, pOp, pBuffer, length);
+            pOp++;
+            numOps++;
+        }
+        // Anything else transmitted is not something that can be
+        // replayed, it will be counted as a mismatch when the
+        // replay device skips over it
+        record = rxEnd;
+    }
+
+    return (int32_t) numOps;
+}
+
+// Wait until the AT command of an operation is due, processing
+// any URCs that arrive meanwhile.
+static void opWait(struct uDeviceSerial_t *pDeviceSerial,
+                   const uAtClientReplayOp_t *pOp)
+{
+    uAtClientReplayDevice_t *pContext = (uAtClientReplayDevice_t *)
+                                        pUInterfaceContext(pDeviceSerial);
+    const uAtClientReplayTranscript_t *pTranscript = pContext->pTranscript;
+    int32_t previousTimeMs = pContext->startTimeMs;
+    bool due = false;
+    bool progress;
+
+    while (!due) {
+        progress = replayDevicePoll(pDeviceSerial);
+        if (pContext->timed) {
+            if (pOp->txFirst > 0) {
+                previousTimeMs = pContext->pTimeMs[pOp->txFirst - 1];
+            }
+            due = (previousTimeMs >= 0) &&
+                  (uPortGetTickTimeMs() - previousTimeMs >=
+                   pTranscript->pRecord[pOp->txFirst].deltaMs);
+            if (!due) {
+                uPortTaskBlock(1);
+            }
+        } else {
+            // Keep going until the AT client has dealt with all of
+            // the URCs that came before this AT command
+            due = (pContext->rxRecord > pOp->txFirst) || !progress;
+        }
+    }
+}
+
+// Perform an operation, returning zero on success else negative
+// error code.
+static int32_t opDo(uAtClientHandle_t atHandle,
+                    const uAtClientReplayTranscript_t *pTranscript,
+                    const uAtClientReplayOp_t *pOp, char *pBuffer)
+{
+    size_t length;
+    const char *pPrefix = NULL;
+
+    if (pOp->prefix[0] != 0) {
+        pPrefix = pOp->prefix;
+    }
+
+    uAtClientLock(atHandle);
+    // The command is sent exactly as recorded, less the
+    // delimiter which uAtClientCommandStop() adds
+    length = recordsCopy(pTranscript, pOp->txFirst, pOp->txEnd, pBuffer);
+    pBuffer[length - 1] = 0;
+    uAtClientCommandStart(atHandle, pBuffer);
+    if (pOp->prompt != 0) {
+        uAtClientCommandStop(atHandle);
+        if (uAtClientWaitCharacter(atHandle, pOp->prompt) == 0) {
+            length = recordsCopy(pTranscript, pOp->dataFirst, pOp->dataEnd, pBuffer);
+            uAtClientWriteBytes(atHandle, pBuffer, length, true);
+        }
+        if (pOp->numLines == 0) {
+            uAtClientResponseStart(atHandle, NULL);
+        }
+    } else if (pOp->numLines == 0) {
+        uAtClientCommandStopReadResponse(atHandle);
+    } else {
+        uAtClientCommandStop(atHandle);
+    }
+    for (size_t x = 0; x < pOp->numLines; x++) {
+        uAtClientResponseStart(atHandle, pPrefix);
+        for (size_t y = 0; y < pOp->numParams; y++) {
+            uAtClientReadString(atHandle, pBuffer,
+                                U_AT_CLIENT_REPLAY_RESPONSE_MAX_LENGTH_BYTES,
+                                false);
+        }
+    }
+    if ((pOp->prompt != 0) || (pOp->numLines > 0)) {
+        uAtClientResponseStop(atHandle);
+    }
+
+    return uAtClientUnlock(atHandle);
+}
+
+// For qsort().
+static int compareInt32(const void *pA, const void *pB)
+{
+    int32_t a = *((const int32_t *) pA);
+    int32_t b = *((const int32_t *) pB);
+
+    return (a > b) - (a < b);
+}
+
+/* ----------------------------------------------------------------
+ * PUBLIC FUNCTIONS: CAPTURE
+ * -------------------------------------------------------------- */
+
+// Start capturing.
+int32_t uAtClientReplayCaptureStart(uAtClientHandle_t atHandle,
+                                    uAtClientReplayCapturePrint_t *pPrint,
+                                    void *pParam)
+{
+    int32_t errorCode = (int32_t) U_ERROR_COMMON_INVALID_PARAMETER;
+
+    if ((atHandle != NULL) && (gpCapture == NULL)) {
+        errorCode = (int32_t) U_ERROR_COMMON_NO_MEMORY;
+        gpCapture = (uAtClientReplayCapture_t *) pUPortMalloc(sizeof(*gpCapture));
+        if (gpCapture != NULL) {
+            memset(gpCapture, 0, sizeof(*gpCapture));
+            gpCapture->atHandle = atHandle;
+            gpCapture->pPrint = pPrint;
+            gpCapture->pParam = pParam;
+            gpCapture->lastTimeMs = uPortGetTickTimeMs();
+            uAtClientStreamInterceptTx(atHandle, pCaptureTx, gpCapture);
+            uAtClientStreamInterceptRx(atHandle, pCaptureRx, gpCapture);
+            errorCode = (int32_t) U_ERROR_COMMON_SUCCESS;
+        }
+    }
+
+    return errorCode;
+}
+
+// Stop capturing.
+void uAtClientReplayCaptureStop(uAtClientHandle_t atHandle)
+{
+    if ((gpCapture != NULL) && (gpCapture->atHandle == atHandle)) {
+        uAtClientStreamInterceptTx(atHandle, NULL, NULL);
+        uAtClientStreamInterceptRx(atHandle, NULL, NULL);
+        captureFlushTx(gpCapture);
+        uPortFree(gpCapture);
+        gpCapture = NULL;
+    }
+}
+
+/* ----------------------------------------------------------------
+ * PUBLIC FUNCTIONS: TRANSCRIPTS
+ * -------------------------------------------------------------- */
+
+// Parse a transcript.
+int32_t uAtClientReplayTranscriptParse(const char *pText, size_t length,
+                                       uAtClientReplayTranscript_t *pTranscript)
+{
+    int32_t errorCodeOrNumRecords = (int32_t) U_ERROR_COMMON_INVALID_PARAMETER;
+    const char *pEnd = pText + length;
+    const char *pLineEnd;
+    size_t maxNumRecords = 1;
+    size_t storageUsed = 0;
+    size_t lineLength;
+    int32_t x;
+
+    if ((pText != NULL) && (pTranscript != NULL)) {
+        memset(pTranscript, 0, sizeof(*pTranscript));
+        // Every record has a line of its own: count them so that
+        // the records can be allocated in one go; the data can never
+        // be longer than the text it came from
+        for (const char *pChar = pText; pChar < pEnd; pChar++) {
+            if (*pChar == '\n') {
+                maxNumRecords++;
+            }
+        }
+        errorCodeOrNumRecords = (int32_t) U_ERROR_COMMON_NO_MEMORY;
+        pTranscript->pRecord = (uAtClientReplayRecord_t *) pUPortMalloc(maxNumRecords *
+                                                                        sizeof(uAtClientReplayRecord_t));
+        pTranscript->pStorage = (char *) pUPortMalloc(length + 1);
+        if ((pTranscript->pRecord != NULL) && (pTranscript->pStorage != NULL)) {
+            errorCodeOrNumRecords = (int32_t) U_ERROR_COMMON_SUCCESS;
+            while ((pText < pEnd) && (errorCodeOrNumRecords >= 0)) {
+                pLineEnd = (const char *) memchr(pText, '\n', pEnd - pText);
+                if (pLineEnd == NULL) {
+                    pLineEnd = pEnd;
+                }
+                lineLength = pLineEnd - pText;
+                if ((lineLength > 0) && (pText[lineLength - 1] == '\r')) {
+                    lineLength--;
+                }
+                if ((lineLength > 0) && (pText[0] != '#')) {
+                    x = parseLine(pText, lineLength, pTranscript->pStorage + storageUsed,
+                                  pTranscript);
+                    if (x >= 0) {
+                        storageUsed += x;
+                    } else {
+                        errorCodeOrNumRecords = x;
+                    }
+                }
+                pText = pLineEnd + 1;
+            }
+            if (errorCodeOrNumRecords >= 0) {
+                errorCodeOrNumRecords = (int32_t) pTranscript->numRecords;
+            }
+        }
+        if (errorCodeOrNumRecords < 0) {
+            uAtClientReplayTranscriptFree(pTranscript);
+        }
+    }
+
+    return errorCodeOrNumRecords;
+}
+
+// Free a transcript.
+void uAtClientReplayTranscriptFree(uAtClientReplayTranscript_t *pTranscript)
+{
+    if (pTranscript != NULL) {
+        uPortFree(pTranscript->pRecord);
+        uPortFree(pTranscript->pStorage);
+        memset(pTranscript, 0, sizeof(*pTranscript));
+    }
+}
+
+/* ----------------------------------------------------------------
+ * PUBLIC FUNCTIONS: REPLAY
+ * -------------------------------------------------------------- */
+
+// Play a transcript back.
+int32_t uAtClientReplayRun(const uAtClientReplayTranscript_t *pTranscript,
+                           bool timed, uAtClientReplayResults_t *pResults)
+{
+    int32_t errorCode = (int32_t) U_ERROR_COMMON_INVALID_PARAMETER;
+    uAtClientStreamHandle_t stream = U_AT_CLIENT_STREAM_HANDLE_DEFAULTS;
+    uAtClientHandle_t atHandle = NULL;
+    uDeviceSerial_t *pDeviceSerial = NULL;
+    uAtClientReplayDevice_t *pContext = NULL;
+    uAtClientReplayOp_t *pOps = NULL;
+    char *pBuffer = NULL;
+    size_t bufferLength = U_AT_CLIENT_REPLAY_RESPONSE_MAX_LENGTH_BYTES;
+    int32_t numOps = 0;
+    int32_t startTimeMs;
+    int32_t timeMs;
+    int32_t endTimeMs;
+    bool progress;
+
+    if ((pTranscript != NULL) && (pResults != NULL)) {
+        memset(pResults, 0, sizeof(*pResults));
+        errorCode = (int32_t) U_ERROR_COMMON_NO_MEMORY;
+        // Somewhere to assemble commands and responses and to read
+        // parameters into: the whole transcript will always do
+        for (size_t x = 0; x < pTranscript->numRecords; x++) {
+            bufferLength += pTranscript->pRecord[x].length;
+        }
+        pBuffer = (char *) pUPortMalloc(bufferLength + 1);
+        // There can't be more AT commands than there are records
+        pOps = (uAtClientReplayOp_t *) pUPortMalloc((pTranscript->numRecords + 1) *
+                                                    sizeof(uAtClientReplayOp_t));
+        pDeviceSerial = pUDeviceSerialCreate(replayDeviceInit,
+                                             sizeof(uAtClientReplayDevice_t));
+        if (pDeviceSerial != NULL) {
+            pContext = (uAtClientReplayDevice_t *) pUInterfaceContext(pDeviceSerial);
+            memset(pContext, 0, sizeof(*pContext));
+        }
+        if ((pBuffer != NULL) && (pOps != NULL) && (pContext != NULL)) {
+            pContext->pTranscript = pTranscript;
+            pContext->timed = timed;
+            pContext->pTimeMs = (int32_t *) pUPortMalloc((pTranscript->numRecords + 1) *
+                                                         sizeof(int32_t));
+            numOps = opsCreate(pTranscript, pOps, pBuffer);
+            pResults->pLatencyMs = (int32_t *) pUPortMalloc((numOps + 1) * sizeof(int32_t));
+            if ((pContext->pTimeMs != NULL) && (pResults->pLatencyMs != NULL)) {
+                for (size_t x = 0; x < pTranscript->numRecords; x++) {
+                    pContext->pTimeMs[x] = -1;
+                }
+                pContext->txRecord = nextTx(pTranscript, 0);
+                pContext->rxRecord = nextRx(pTranscript, 0);
+                stream.handle.pDeviceSerial = pDeviceSerial;
+                stream.type = U_AT_CLIENT_STREAM_TYPE_VIRTUAL_SERIAL;
+                atHandle = uAtClientAddExt(&stream, NULL,
+                                           U_AT_CLIENT_REPLAY_AT_BUFFER_LENGTH_BYTES);
+            }
+        }
+
+        if (atHandle != NULL) {
+            errorCode = (int32_t) U_ERROR_COMMON_SUCCESS;
+            for (size_t x = 0; (x < pTranscript->numUrcs) && (errorCode == 0); x++) {
+                errorCode = uAtClientSetUrcHandler(atHandle, pTranscript->pUrcPrefix[x],
+                                                   urcHandler, &(pResults->numUrcs));
+            }
+            if (!timed) {
+                // Take away all of the deliberate delays so that
+                // only processing time is measured
+                uAtClientTimeoutSet(atHandle, U_AT_CLIENT_REPLAY_FAST_TIMEOUT_MS);
+                uAtClientTimeoutUrcSet(atHandle, 0);
+                uAtClientDelaySet(atHandle, 0);
+                uAtClientReadRetryDelaySet(atHandle, 0);
+            }
+        }
+
+        if (errorCode == 0) {
+            startTimeMs = uPortGetTickTimeMs();
+            pContext->startTimeMs = startTimeMs;
+            for (int32_t x = 0; x < numOps; x++) {
+                replayDeviceTxSeek(pContext, pOps[x].txFirst);
+                opWait(pDeviceSerial, pOps + x);
+                timeMs = uPortGetTickTimeMs();
+                if (opDo(atHandle, pTranscript, pOps + x, pBuffer) < 0) {
+                    pResults->numDeviceErrors++;
+                }
+                pResults->pLatencyMs[x] = uPortGetTickTimeMs() - timeMs;
+                pResults->numCommands++;
+            }
+            // Let the AT client have whatever is left, e.g. URCs
+            // that arrived after the last AT command
+            replayDeviceTxSeek(pContext, pTranscript->numRecords);
+            endTimeMs = uPortGetTickTimeMs();
+            if (timed && (pTranscript->numRecords > 0)) {
+                for (size_t x = pContext->rxRecord; x < pTranscript->numRecords; x++) {
+                    endTimeMs += pTranscript->pRecord[x].deltaMs;
+                }
+                endTimeMs += U_AT_CLIENT_REPLAY_TAIL_GUARD_MS;
+            }
+            do {
+                progress = replayDevicePoll(pDeviceSerial);
+                if (timed && !progress) {
+                    uPortTaskBlock(1);
+                }
+            } while ((pContext->rxRecord < pTranscript->numRecords) &&
+                     (progress || (timed && (uPortGetTickTimeMs() < endTimeMs))));
+            pResults->durationMs = uPortGetTickTimeMs() - startTimeMs;
+            pResults->numMismatches = pContext->numMismatches;
+            pResults->bytesSent = pContext->bytesWritten;
+            pResults->bytesReceived = pContext->bytesRead;
+        }
+
+        if (atHandle != NULL) {
+            uAtClientRemove(atHandle);
+        }
+        if (pDeviceSerial != NULL) {
+            uPortFree(pContext->pTimeMs);
+            uDeviceSerialDelete(pDeviceSerial);
+        }
+        uPortFree(pOps);
+        uPortFree(pBuffer);
+        if (errorCode < 0) {
+            uAtClientReplayResultsFree(pResults);
+        }
+    }
+
+    return errorCode;
+}
+
+// Get a latency percentile.
+int32_t uAtClientReplayLatencyPercentile(uAtClientReplayResults_t *pResults,
+                                         int32_t perMille)
+{
+    int32_t errorCodeOrLatencyMs = (int32_t) U_ERROR_COMMON_INVALID_PARAMETER;
+    size_t x;
+
+    if ((pResults != NULL) && (pResults->pLatencyMs != NULL) &&
+        (pResults->numCommands > 0) && (perMille >= 0) && (perMille <= 1000)) {
+        qsort(pResults->pLatencyMs, pResults->numCommands, sizeof(int32_t),
+              compareInt32);
+        // Nearest rank
+        x = (((size_t) perMille * pResults->numCommands) + 999) / 1000;
+        if (x > 0) {
+            x--;
+        }
+        errorCodeOrLatencyMs = pResults->pLatencyMs[x];
+    }
+
+    return errorCodeOrLatencyMs;
+}
+
+// Free results.
+void uAtClientReplayResultsFree(uAtClientReplayResults_t *pResults)
+{
+    if (pResults != NULL) {
+        uPortFree(pResults->pLatencyMs);
+        pResults->pLatencyMs = NULL;
+    }
+}
+
+// End of file
@@ -0,0 +1,233 @@
+/*
+ * Copyright 2019-2024 u-blox
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _U_AT_CLIENT_REPLAY_H_
+#define _U_AT_CLIENT_REPLAY_H_
+
+/* Only header files representing a direct and unavoidable
+ * dependency between the API of this module and the API
+ * of another module should be included here; otherwise
+ * please keep #includes to your .c files. */
+
+/** @file
+ * @brief Capture and replay of AT traffic, so that the CPU cost
+ * and latency of the AT client can be measured, and regressions
+ * found, without a module attached.
+ *
+ * A transcript is plain text, one record per line:
+ *
+ * ```
+ * # A comment.
+ * U +UUSORD:
+ * > 0 AT+USORD=0,5\r
+ * < 23 \r\n+USORD: 0,5,"48656C6C6F"\r\n\r\nOK\r\n
+ * ```
+ *
+ * - "U" lines list the URC prefixes that are to be counted as URCs;
+ *   the capture cannot know these, they should be added by hand.
+ * - ">" records are what the AT client transmitted, "<" records
+ *   what it received; the number that follows is the time in
+ *   milliseconds since the previous record was captured and the
+ *   rest of the line is the data, with "\r", "\n", "\\" and "\xHH"
+ *   as escapes.
+ *
+ * uAtClientReplayCaptureStart() writes transcript lines, using the
+ * transmit and receive intercepts of the AT client, while
+ * uAtClientReplayRun() plays a parsed transcript back into a new
+ * AT client through a virtual serial device, issuing each recorded
+ * AT command in turn and reading the response it gets.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ----------------------------------------------------------------
+ * COMPILE-TIME MACROS
+ * -------------------------------------------------------------- */
+
+#ifndef U_AT_CLIENT_REPLAY_MAX_NUM_URCS
+/** The maximum number of URC prefixes a transcript may list.
+ */
+# define U_AT_CLIENT_REPLAY_MAX_NUM_URCS 16
+#endif
+
+#ifndef U_AT_CLIENT_REPLAY_CAPTURE_LINE_MAX_DATA_LENGTH_BYTES
+/** The maximum amount of data carried by one record written by
+ * uAtClientReplayCaptureStart(); longer transmissions and
+ * receptions are split across several records.
+ */
+# define U_AT_CLIENT_REPLAY_CAPTURE_LINE_MAX_DATA_LENGTH_BYTES 64
+#endif
+
+#ifndef U_AT_CLIENT_REPLAY_RESPONSE_MAX_LENGTH_BYTES
+/** The longest response parameter uAtClientReplayRun() will read;
+ * anything longer is still consumed but is not kept.
+ */
+# define U_AT_CLIENT_REPLAY_RESPONSE_MAX_LENGTH_BYTES 2048
+#endif
+
+#ifndef U_AT_CLIENT_REPLAY_AT_BUFFER_LENGTH_BYTES
+/** The size of the receive buffer of the AT client created by
+ * uAtClientReplayRun(), the same as a cellular module would use.
+ */
+# define U_AT_CLIENT_REPLAY_AT_BUFFER_LENGTH_BYTES (U_AT_CLIENT_BUFFER_OVERHEAD_BYTES + 1024)
+#endif
+
+#ifndef U_AT_CLIENT_REPLAY_FAST_TIMEOUT_MS
+/** The AT timeout used by uAtClientReplayRun() when the recorded
+ * timing is not being reproduced: all of the response data is
+ * available immediately so there is no point in waiting for long.
+ */
+# define U_AT_CLIENT_REPLAY_FAST_TIMEOUT_MS 1000
+#endif
+
+/* ----------------------------------------------------------------
+ * TYPES
+ * -------------------------------------------------------------- */
+
+/** A record in a transcript.
+ */
+typedef struct {
+    bool isTx;       /**< true if the data was transmitted by the AT client. */
+    int32_t deltaMs; /**< the time since the previous record when captured. */
+    char *pData;     /**< the data, not terminated. */
+    size_t length;   /**< the amount of data at pData. */
+} uAtClientReplayRecord_t;
+
+/** A parsed transcript.
+ */
+typedef struct {
+    uAtClientReplayRecord_t *pRecord; /**< the records. */
+    size_t numRecords;                /**< the number of records at pRecord. */
+    char *pUrcPrefix[U_AT_CLIENT_REPLAY_MAX_NUM_URCS]; /**< the URC prefixes. */
+    size_t numUrcs;                   /**< the number of entries in pUrcPrefix. */
+    char *pStorage;                   /**< storage for the decoded data. */
+} uAtClientReplayTranscript_t;
+
+/** The outcome of uAtClientReplayRun().
+ */
+typedef struct {
+    int32_t durationMs;     /**< the wall-clock time taken. */
+    size_t numCommands;     /**< the number of AT commands issued. */
+    size_t numUrcs;         /**< the number of URCs received. */
+    size_t numDeviceErrors; /**< the number of AT commands which got an error. */
+    size_t numMismatches;   /**< the number of AT commands whose transmitted
+                                 data differed from the transcript. */
+    int64_t bytesSent;      /**< the number of bytes the AT client sent. */
+    int64_t bytesReceived;  /**< the number of bytes the AT client received. */
+    int32_t *pLatencyMs;    /**< the latency of each AT command, numCommands
+                                 of them, from the start of the AT command to
+                                 the response having been read; free this with
+                                 uAtClientReplayResultsFree(). */
+} uAtClientReplayResults_t;
+
+/** Where uAtClientReplayCaptureStart() sends each transcript line.
+ *
+ * @param pLine   the line, null-terminated, without a line ending.
+ * @param pParam  the pParam passed to uAtClientReplayCaptureStart().
+ */
+typedef void (uAtClientReplayCapturePrint_t)(const char *pLine, void *pParam);
+
+/* ----------------------------------------------------------------
+ * FUNCTIONS
+ * -------------------------------------------------------------- */
+
+/** Start capturing the AT traffic of an AT client as transcript
+ * lines.  This uses the transmit and receive intercepts of the AT
+ * client, so it cannot be used while something else (e.g. chip to
+ * chip security) is intercepting the stream, and only one AT client
+ * may be captured at a time.  Call this with the AT client locked.
+ *
+ * @param atHandle   the handle of the AT client.
+ * @param pPrint     the function to send each line to; if NULL
+ *                   uPortLog() is used.
+ * @param pParam     a parameter that will be passed to pPrint.
+ * @return           zero on success else negative error code.
+ */
+int32_t uAtClientReplayCaptureStart(uAtClientHandle_t atHandle,
+                                    uAtClientReplayCapturePrint_t *pPrint,
+                                    void *pParam);
+
+/** Stop capturing the AT traffic of an AT client.  Call this with
+ * the AT client locked.
+ *
+ * @param atHandle   the handle of the AT client.
+ */
+void uAtClientReplayCaptureStop(uAtClientHandle_t atHandle);
+
+/** Parse a transcript.
+ *
+ * @param pText            the transcript text, need not be terminated.
+ * @param length           the length of pText.
+ * @param[out] pTranscript a place to put the parsed transcript;
+ *                         cannot be NULL.  When done, free it with
+ *                         uAtClientReplayTranscriptFree().
+ * @return                 the number of records on success else
+ *                         negative error code.
+ */
+int32_t uAtClientReplayTranscriptParse(const char *pText, size_t length,
+                                       uAtClientReplayTranscript_t *pTranscript);
+
+/** Free a transcript parsed by uAtClientReplayTranscriptParse().
+ *
+ * @param pTranscript  the transcript.
+ */
+void uAtClientReplayTranscriptFree(uAtClientReplayTranscript_t *pTranscript);
+
+/** Play a transcript back into a new AT client: each recorded AT
+ * command is issued in turn and its response read, the responses
+ * and any URCs being served from the transcript by a virtual serial
+ * device.  uAtClientInit() must have been called.
+ *
+ * @param[in] pTranscript  the transcript.
+ * @param timed            if true the recorded timing is reproduced,
+ *                         i.e. responses and URCs arrive as long after
+ *                         the AT command as they did when captured and
+ *                         AT commands are not issued early, else
+ *                         everything is played back as fast as
+ *                         possible.
+ * @param[out] pResults    a place to put the results; cannot be NULL.
+ *                         When done, free it with
+ *                         uAtClientReplayResultsFree().
+ * @return                 zero on success else negative error code.
+ */
+int32_t uAtClientReplayRun(const uAtClientReplayTranscript_t *pTranscript,
+                           bool timed, uAtClientReplayResults_t *pResults);
+
+/** Get a latency percentile from the results of uAtClientReplayRun().
+ *
+ * @param[in] pResults  the results; the latencies in it will be sorted.
+ * @param perMille      the percentile in tenths of a percent, e.g. 999
+ *                      for the 99.9th percentile.
+ * @return              the latency in milliseconds or negative error code.
+ */
+int32_t uAtClientReplayLatencyPercentile(uAtClientReplayResults_t *pResults,
+                                         int32_t perMille);
+
+/** Free the results of uAtClientReplayRun().
+ *
+ * @param pResults  the results.
+ */
+void uAtClientReplayResultsFree(uAtClientReplayResults_t *pResults);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _U_AT_CLIENT_REPLAY_H_
+
+// End of file
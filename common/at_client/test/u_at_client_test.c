@@ -34,7 +34,7 @@
 #include "stddef.h"    // NULL, size_t etc.
 #include "stdint.h"    // int32_t etc.
 #include "stdbool.h"
-#include "stdlib.h"    // rand()
+#include "stdlib.h"    // rand(), atoi()
 #include "string.h"    // strlen(), memcmp()
 #include "stdio.h"     // snprintf()
 #include "ctype.h"     // isprint()
@@ -55,11 +55,15 @@
 #include "u_port_debug.h"
 #include "u_port_uart.h"
 
+#include "u_interface.h"
+#include "u_device_serial.h"
+
 #include "u_test_util_resource_check.h"
 
 #include "u_at_client.h"
 #include "u_at_client_test.h"
 #include "u_at_client_test_data.h"
+#include "u_at_client_replay.h"
 
 /* ----------------------------------------------------------------
  * COMPILE-TIME MACROS
@@ -136,6 +140,79 @@
  * we need room for initial and trailing line endings. */
 #define U_AT_CLIENT_TEST_AT_BUFFER_LENGTH_BYTES (256 + 4 + U_AT_CLIENT_BUFFER_OVERHEAD_BYTES)
 
+#ifndef U_AT_CLIENT_TEST_URC_DISPATCH_NUM_LINES
+/** The number of URC lines to push through the AT client for
+ * each run of the URC dispatch benchmark.
+ */
+# define U_AT_CLIENT_TEST_URC_DISPATCH_NUM_LINES 10000
+#endif
+
+/** The maximum number of URC handlers used in the URC
+ * dispatch benchmark.
+ */
+#define U_AT_CLIENT_TEST_URC_DISPATCH_MAX_NUM_HANDLERS 200
+
+/** The amount of binary data to read with uAtClientReadBytesSpan(),
+ * deliberately more than will fit into the receive buffer.
+ */
+#define U_AT_CLIENT_TEST_SPAN_DATA_LENGTH_BYTES 1000
+
+#ifndef U_AT_CLIENT_TEST_PIPELINE_NUM_COMMANDS
+/** The number of AT commands to send in the pipelining benchmark.
+ */
+# define U_AT_CLIENT_TEST_PIPELINE_NUM_COMMANDS 100
+#endif
+
+#ifndef U_AT_CLIENT_TEST_PIPELINE_LATENCY_MS
+/** The time the simulated modem takes to respond to each AT
+ * command in the pipelining benchmark.
+ */
+# define U_AT_CLIENT_TEST_PIPELINE_LATENCY_MS 10
+#endif
+
+/** The number of responses the simulated modem can have queued;
+ * must be at least U_AT_CLIENT_PIPELINE_WINDOW_MAX.
+ */
+#define U_AT_CLIENT_TEST_MODEM_MAX_NUM_RESPONSES 32
+
+#ifndef U_AT_CLIENT_TEST_PARSE_RATE_NUM_PASSES
+/** The number of times the recorded AT traffic is parsed in the
+ * parse rate benchmark.
+ */
+# define U_AT_CLIENT_TEST_PARSE_RATE_NUM_PASSES 1000
+#endif
+
+/** The receive buffer size used in the parse rate benchmark: big
+ * enough to take a whole pass of the recorded AT traffic so that
+ * the time measured is that of parsing rather than of waiting
+ * on the stream.
+ */
+#define U_AT_CLIENT_TEST_PARSE_RATE_AT_BUFFER_LENGTH_BYTES (4096 + U_AT_CLIENT_BUFFER_OVERHEAD_BYTES)
+
+/** The amount of binary data carried, hex-encoded, by the "+USORF"
+ * line in the parse rate benchmark, as it would be by a socket in
+ * hex mode.
+ */
+#define U_AT_CLIENT_TEST_PARSE_RATE_HEX_DATA_LENGTH_BYTES 1024
+
+/** Storage for the AT traffic replayed by the parse rate benchmark.
+ */
+#define U_AT_CLIENT_TEST_PARSE_RATE_TRANSCRIPT_LENGTH_BYTES 8192
+
+/** The line rate that the parse rate benchmark compares against:
+ * 921600 baud, 10 bits per byte.
+ */
+#define U_AT_CLIENT_TEST_PARSE_RATE_LINE_RATE_BYTES_PER_SECOND (921600 / 10)
+
+/** The number of AT commands captured from the simulated modem
+ * and replayed in the atClientReplay test.
+ */
+#define U_AT_CLIENT_TEST_REPLAY_NUM_COMMANDS 20
+
+/** Storage for the transcript captured in the atClientReplay test.
+ */
+#define U_AT_CLIENT_TEST_REPLAY_CAPTURE_LENGTH_BYTES 4096
+
 /* ----------------------------------------------------------------
  * TYPES
  * -------------------------------------------------------------- */
@@ -152,10 +229,125 @@ typedef struct {
     int32_t responseLastError;
 } uAtClientTestCheckCommandResponse_t;
 
+/** Context for a virtual serial device which, rather than talking
+ * to real hardware, generates a stream of URC lines from memory,
+ * followed by "OK", and throws away anything written to it.  If
+ * pResponse is not NULL it is sent instead of the final "OK".
+ */
+typedef struct {
+    size_t numHandlers;    /**< the number of URC handlers to spread the lines across. */
+    size_t numLines;       /**< the number of URC lines still to generate. */
+    size_t lineIndex;      /**< the number of URC lines generated so far. */
+    char line[32];         /**< storage for a generated line. */
+    const char *pLine;     /**< the line currently being read. */
+    size_t lineLength;     /**< the length of the line at pLine. */
+    size_t linePos;        /**< how far through pLine the reader has got. */
+    const char *pResponse; /**< a fixed response to send, may be NULL. */
+    size_t responseLength; /**< the length of pResponse. */
+    bool okSent;           /**< true once the final "OK" has been generated. */
+} uAtClientTestUrcSerialContext_t;
+
+/** A response queued by the simulated modem.
+ */
+typedef struct {
+    int32_t readyTimeMs;  /**< the time at which the response "arrives". */
+    char text[32];        /**< the response. */
+    size_t length;        /**< the length of text[]. */
+} uAtClientTestModemResponse_t;
+
+/** Context for a virtual serial device which simulates a modem:
+ * it answers each "AT+UTSTP=n" command with "+UTSTP: 2n" and
+ * "OK", or with "ERROR" if n ends in 9, and "AT" with "OK", but only
+ * U_AT_CLIENT_TEST_PIPELINE_LATENCY_MS after the command was
+ * received.  Commands are queued, as they would be by a real
+ * modem, so a new command may arrive before the last one has
+ * been answered.
+ */
+typedef struct {
+    char command[32];     /**< the command being received. */
+    size_t commandLength; /**< the length of command[]. */
+    uAtClientTestModemResponse_t response[U_AT_CLIENT_TEST_MODEM_MAX_NUM_RESPONSES];
+    size_t responseRead;  /**< the index of the oldest response in response[]. */
+    size_t responseCount; /**< the number of responses in response[]. */
+    size_t responsePos;   /**< how far through the oldest response the reader has got. */
+    bool overflow;        /**< set if response[] overflowed. */
+    size_t bytesWritten;  /**< the total number of bytes written to the modem. */
+    size_t bytesRead;     /**< the total number of bytes read from the modem. */
+} uAtClientTestModemContext_t;
+
+/** Storage for the outcome of a pipelined AT command.
+ */
+typedef struct {
+    int32_t errorCode;
+    int32_t value;
+    size_t numCalls;
+} uAtClientTestPipelineResult_t;
+
 /* ----------------------------------------------------------------
  * VARIABLES
  * -------------------------------------------------------------- */
 
+/** The counts of URCs received by urcDispatchHandler(), one for
+ * each handler.
+ */
+static size_t gUrcDispatchCount[U_AT_CLIENT_TEST_URC_DISPATCH_MAX_NUM_HANDLERS];
+
+/** The binary data read by the atClientReadBytesSpan test.
+ */
+static char gSpanData[U_AT_CLIENT_TEST_SPAN_DATA_LENGTH_BYTES];
+
+/** The response containing gSpanData, sent by the virtual serial
+ * device in the atClientReadBytesSpan test.
+ */
+static char gSpanResponse[U_AT_CLIENT_TEST_SPAN_DATA_LENGTH_BYTES + 64];
+
+/** The results of the atClientPipeline test.
+ */
+static uAtClientTestPipelineResult_t gPipelineResult[U_AT_CLIENT_TEST_PIPELINE_NUM_COMMANDS];
+
+/** The hex string carried by the "+USORF" line in the parse rate
+ * benchmark.
+ */
+static char gParseRateHex[(U_AT_CLIENT_TEST_PARSE_RATE_HEX_DATA_LENGTH_BYTES * 2) + 1];
+
+/** The AT traffic replayed by the parse rate benchmark.
+ */
+static char gParseRateTranscript[U_AT_CLIENT_TEST_PARSE_RATE_TRANSCRIPT_LENGTH_BYTES];
+
+/** A transcript for the atClientReplay test: a socket is opened,
+ * written to after a prompt, read when the URC says there is data,
+ * read again with an error and closed, the close URC arriving
+ * in the same chunk as the "OK".
+ */
+static const char gReplayTranscript[] = "# A socket session\n"
+                                        "U +UUSORD:\n"
+                                        "U +UUSOCL:\n"
+                                        "> 0 AT+USOCR=6\\r\n"
+                                        "< 5 \\r\\n+USOCR: 0\\r\\n\\r\\nOK\\r\\n\n"
+                                        "> 2 AT+USOCO=0,\"10.20.30.40\",5000\\r\n"
+                                        "< 40 \\r\\nOK\\r\\n\n"
+                                        "> 1 AT+USOWR=0,5\\r\n"
+                                        "< 3 \\r\\n@\n"
+                                        "> 50 Hel\\x00o\n"
+                                        "< 12 \\r\\n+USOWR: 0,5\\r\\n\\r\\nOK\\r\\n\n"
+                                        "< 30 \\r\\n+UUSORD: 0,5\\r\\n\n"
+                                        "> 1 AT+USORD=0,5\\r\n"
+                                        "< 4 \\r\\n+USORD: 0,5,\"Hel\\\\o\"\\r\\n\\r\\nOK\\r\\n\n"
+                                        "> 1 AT+USORD=0,5\\r\n"
+                                        "< 4 \\r\\nERROR\\r\\n\n"
+                                        "> 1 AT+CGSN\\r\n"
+                                        "< 2 \\r\\n004999010640000\\r\\n\\r\\nOK\\r\\n\n"
+                                        "> 1 AT+USOCL=0\\r\n"
+                                        "< 3 \\r\\nOK\\r\\n\\r\\n+UUSOCL: 0\\r\\n\n";
+
+/** The transcript captured in the atClientReplay test.
+ */
+static char gReplayCapture[U_AT_CLIENT_TEST_REPLAY_CAPTURE_LENGTH_BYTES];
+
+/** The length of gReplayCapture.
+ */
+static size_t gReplayCaptureLength = 0;
+
 /** Handle for the AT client UART stream.
  */
 static int32_t gUartAHandle = -1;
@@ -1023,6 +1215,433 @@ int32_t uAtClientTestCheckParam(uAtClientHandle_t atClientHandle,
     return lastError;
 }
 
+/* ----------------------------------------------------------------
+ * STATIC FUNCTIONS: A URC-GENERATING VIRTUAL SERIAL DEVICE
+ * -------------------------------------------------------------- */
+
+// Make sure that there is a line to read in a URC serial device,
+// returning false if there is nothing more to be had.
+static bool urcSerialNextLine(uAtClientTestUrcSerialContext_t *pContext)
+{
+    if (pContext->linePos >= pContext->lineLength) {
+        pContext->linePos = 0;
+        pContext->lineLength = 0;
+        if (pContext->numLines > 0) {
+            pContext->pLine = pContext->line;
+            pContext->lineLength = snprintf(pContext->line, sizeof(pContext->line),
+                                            "+UTST%03d: %d\r\n",
+                                            (int) (pContext->lineIndex % pContext->numHandlers),
+                                            (int) pContext->lineIndex);
+            pContext->lineIndex++;
+            pContext->numLines--;
+        } else if (!pContext->okSent) {
+            if (pContext->pResponse != NULL) {
+                pContext->pLine = pContext->pResponse;
+                pContext->lineLength = pContext->responseLength;
+            } else {
+                pContext->pLine = pContext->line;
+                pContext->lineLength = snprintf(pContext->line, sizeof(pContext->line), "OK\r\n");
+            }
+            pContext->okSent = true;
+        }
+    }
+
+    return pContext->linePos < pContext->lineLength;
+}
+
+// Get the number of bytes waiting to be read from a URC serial device.
+static int32_t urcSerialGetReceiveSize(struct uDeviceSerial_t *pDeviceSerial)
+{
+    uAtClientTestUrcSerialContext_t *pContext = (uAtClientTestUrcSerialContext_t *)
+                                                pUInterfaceContext(pDeviceSerial);
+    int32_t sizeBytes = 0;
+
+    if (urcSerialNextLine(pContext)) {
+        sizeBytes = (int32_t) (pContext->lineLength - pContext->linePos);
+    }
+
+    return sizeBytes;
+}
+
+// Read from a URC serial device.
+static int32_t urcSerialRead(struct uDeviceSerial_t *pDeviceSerial,
+                             void *pBuffer, size_t sizeBytes)
+{
+    uAtClientTestUrcSerialContext_t *pContext = (uAtClientTestUrcSerialContext_t *)
+                                                pUInterfaceContext(pDeviceSerial);
+    size_t readLength = 0;
+    size_t thisLength;
+
+    while ((readLength < sizeBytes) && urcSerialNextLine(pContext)) {
+        thisLength = pContext->lineLength - pContext->linePos;
+        if (thisLength > sizeBytes - readLength) {
+            thisLength = sizeBytes - readLength;
+        }
+        memcpy(((char *) pBuffer) + readLength, pContext->pLine + pContext->linePos,
+               thisLength);
+        pContext->linePos += thisLength;
+        readLength += thisLength;
+    }
+
+    return (int32_t) readLength;
+}
+
+// Write to a URC serial device: the data is thrown away.
+static int32_t urcSerialWrite(struct uDeviceSerial_t *pDeviceSerial,
+                              const void *pBuffer, size_t sizeBytes)
+{
+    (void) pDeviceSerial;
+    (void) pBuffer;
+
+    return (int32_t) sizeBytes;
+}
+
+// Set an event callback on a URC serial device: since all of the
+// reading is done synchronously the callback is never called.
+static int32_t urcSerialEventCallbackSet(struct uDeviceSerial_t *pDeviceSerial,
+                                         uint32_t filter,
+                                         void (*pFunction)(struct uDeviceSerial_t *,
+                                                           uint32_t,
+                                                           void *),
+                                         void *pParam,
+                                         size_t stackSizeBytes,
+                                         int32_t priority)
+{
+    (void) pDeviceSerial;
+    (void) filter;
+    (void) pFunction;
+    (void) pParam;
+    (void) stackSizeBytes;
+    (void) priority;
+
+    return 0;
+}
+
+// Populate the vector table of a URC serial device.
+static void urcSerialInit(struct uDeviceSerial_t *pDeviceSerial)
+{
+    pDeviceSerial->getReceiveSize = urcSerialGetReceiveSize;
+    pDeviceSerial->read = urcSerialRead;
+    pDeviceSerial->write = urcSerialWrite;
+    pDeviceSerial->eventCallbackSet = urcSerialEventCallbackSet;
+}
+
+// The URC handler for the URC dispatch benchmark: just counts.
+static void urcDispatchHandler(uAtClientHandle_t atClientHandle,
+                               void *pParameters)
+{
+    (void) atClientHandle;
+
+    (*((size_t *) pParameters))++;
+}
+
+/* ----------------------------------------------------------------
+ * STATIC FUNCTIONS: A SIMULATED MODEM
+ * -------------------------------------------------------------- */
+
+// Act on a complete command received by the simulated modem.
+static void modemCommand(uAtClientTestModemContext_t *pContext)
+{
+    uAtClientTestModemResponse_t *pResponse;
+    int32_t x;
+
+    if (pContext->responseCount >= sizeof(pContext->response) / sizeof(pContext->response[0])) {
+        pContext->overflow = true;
+    } else {
+        pResponse = &(pContext->response[(pContext->responseRead + pContext->responseCount) %
+                                         (sizeof(pContext->response) / sizeof(pContext->response[0]))]);
+        pResponse->readyTimeMs = uPortGetTickTimeMs() + U_AT_CLIENT_TEST_PIPELINE_LATENCY_MS;
+        pContext->command[pContext->commandLength] = 0;
+        if ((strncmp(pContext->command, "AT+UTSTP=", 9) == 0) &&
+            ((x = atoi(pContext->command + 9)) % 10 != 9)) {
+            pResponse->length = snprintf(pResponse->text, sizeof(pResponse->text),
+                                         "\r\n+UTSTP: %d\r\n\r\nOK\r\n", (int) (x * 2));
+        } else if (strcmp(pContext->command, "AT") == 0) {
+            pResponse->length = snprintf(pResponse->text, sizeof(pResponse->text),
+                                         "\r\nOK\r\n");
+        } else {
+            pResponse->length = snprintf(pResponse->text, sizeof(pResponse->text),
+                                         "\r\nERROR\r\n");
+        }
+        pContext->responseCount++;
+    }
+}
+
+// Return a pointer to the oldest response of the simulated modem,
+// if it has "arrived", else NULL.
+static uAtClientTestModemResponse_t *pModemResponse(uAtClientTestModemContext_t *pContext)
+{
+    uAtClientTestModemResponse_t *pResponse = NULL;
+
+    if ((pContext->responseCount > 0) &&
+        (uPortGetTickTimeMs() - pContext->response[pContext->responseRead].readyTimeMs >= 0)) {
+        pResponse = &(pContext->response[pContext->responseRead]);
+    }
+
+    return pResponse;
+}
+
+// Get the number of bytes waiting to be read from the simulated modem.
+static int32_t modemGetReceiveSize(struct uDeviceSerial_t *pDeviceSerial)
+{
+    uAtClientTestModemContext_t *pContext = (uAtClientTestModemContext_t *)
+                                            pUInterfaceContext(pDeviceSerial);
+    uAtClientTestModemResponse_t *pResponse = pModemResponse(pContext);
+    int32_t sizeBytes = 0;
+
+    if (pResponse != NULL) {
+        sizeBytes = (int32_t) (pResponse->length - pContext->responsePos);
+    }
+
+    return sizeBytes;
+}
+
+// Read from the simulated modem.
+static int32_t modemRead(struct uDeviceSerial_t *pDeviceSerial,
+                         void *pBuffer, size_t sizeBytes)
+{
+    uAtClientTestModemContext_t *pContext = (uAtClientTestModemContext_t *)
+                                            pUInterfaceContext(pDeviceSerial);
+    uAtClientTestModemResponse_t *pResponse;
+    size_t readLength = 0;
+    size_t thisLength;
+
+    while ((readLength < sizeBytes) &&
+           ((pResponse = pModemResponse(pContext)) != NULL)) {
+        thisLength = pResponse->length - pContext->responsePos;
+        if (thisLength > sizeBytes - readLength) {
+            thisLength = sizeBytes - readLength;
+        }
+        memcpy(((char *) pBuffer) + readLength, pResponse->text + pContext->responsePos,
+               thisLength);
+        pContext->responsePos += thisLength;
+        readLength += thisLength;
+        if (pContext->responsePos >= pResponse->length) {
+            pContext->responsePos = 0;
+            pContext->responseRead = (pContext->responseRead + 1) %
+                                     (sizeof(pContext->response) / sizeof(pContext->response[0]));
+            pContext->responseCount--;
+        }
+    }
+    pContext->bytesRead += readLength;
+
+    return (int32_t) readLength;
+}
+
+// Write to the simulated modem.
+static int32_t modemWrite(struct uDeviceSerial_t *pDeviceSerial,
+                          const void *pBuffer, size_t sizeBytes)
+{
+    uAtClientTestModemContext_t *pContext = (uAtClientTestModemContext_t *)
+                                            pUInterfaceContext(pDeviceSerial);
+    char character;
+
+    for (size_t x = 0; x < sizeBytes; x++) {
+        character = *(((const char *) pBuffer) + x);
+        if (character == '\r') {
+            modemCommand(pContext);
+            pContext->commandLength = 0;
+        } else if ((character != '\n') &&
+                   (pContext->commandLength < sizeof(pContext->command) - 1)) {
+            pContext->command[pContext->commandLength] = character;
+            pContext->commandLength++;
+        }
+    }
+    pContext->bytesWritten += sizeBytes;
+
+    return (int32_t) sizeBytes;
+}
+
+// Populate the vector table of the simulated modem; the event
+// callback is the same as that of a URC serial device.
+static void modemInit(struct uDeviceSerial_t *pDeviceSerial)
+{
+    pDeviceSerial->getReceiveSize = modemGetReceiveSize;
+    pDeviceSerial->read = modemRead;
+    pDeviceSerial->write = modemWrite;
+    pDeviceSerial->eventCallbackSet = urcSerialEventCallbackSet;
+}
+
+// The callback for a pipelined AT command in the pipelining benchmark.
+static void pipelineCallback(uAtClientHandle_t atClientHandle,
+                             int32_t errorCode, void *pParameter)
+{
+    uAtClientTestPipelineResult_t *pResult = (uAtClientTestPipelineResult_t *) pParameter;
+
+    pResult->errorCode = errorCode;
+    if (errorCode == 0) {
+        pResult->value = uAtClientReadInt(atClientHandle);
+    }
+    pResult->numCalls++;
+}
+
+// The callback for a pipelined AT command that has no prefix.
+static void pipelineCallbackNoPrefix(uAtClientHandle_t atClientHandle,
+                                     int32_t errorCode, void *pParameter)
+{
+    uAtClientTestPipelineResult_t *pResult = (uAtClientTestPipelineResult_t *) pParameter;
+
+    (void) atClientHandle;
+    pResult->errorCode = errorCode;
+    pResult->numCalls++;
+}
+
+/* ----------------------------------------------------------------
+ * STATIC FUNCTIONS: REPLAY OF RECORDED AT TRAFFIC
+ * -------------------------------------------------------------- */
+
+// Return true if an entry in gAtClientTestSet1 can be used by
+// the parse rate benchmark, i.e. it gets "OK", has no URC and
+// has only parameters that are read in the ordinary way.
+static bool parseRateEntryIsUsable(const uAtClientTestCommandResponse_t *pEntry)
+{
+    bool usable = (pEntry->response.type == U_AT_CLIENT_TEST_RESPONSE_OK) &&
+                  (pEntry->pUrc == NULL);
+    const uAtClientTestResponseLine_t *pLine;
+
+    for (size_t l = 0; usable && (l < pEntry->response.numLines); l++) {
+        pLine = &(pEntry->response.lines[l]);
+        for (size_t p = 0; usable && (p < pLine->numParameters); p++) {
+            usable = (pLine->parameters[p].type == U_AT_CLIENT_TEST_PARAMETER_INT32) ||
+                     (pLine->parameters[p].type == U_AT_CLIENT_TEST_PARAMETER_UINT64) ||
+                     (pLine->parameters[p].type == U_AT_CLIENT_TEST_PARAMETER_STRING);
+        }
+    }
+
+    return usable;
+}
+
+// Append the response an AT server would send for an entry in
+// gAtClientTestSet1 to pBuffer, returning the number of bytes
+// appended or zero if there is not room.
+static size_t parseRateAddEntry(char *pBuffer, size_t bufferLength,
+                                const uAtClientTestCommandResponse_t *pEntry)
+{
+    const uAtClientTestResponseLine_t *pLine;
+    size_t length = 2;
+    size_t x;
+
+    // Work out the length first: CR/LF, the lines, then OK CR/LF
+    for (size_t l = 0; l < pEntry->response.numLines; l++) {
+        pLine = &(pEntry->response.lines[l]);
+        if (pLine->pPrefix != NULL) {
+            length += strlen(pLine->pPrefix) + 1;
+        }
+        for (size_t p = 0; p < pLine->numParameters; p++) {
+            length += pLine->parametersRaw[p].length + ((p > 0) ? 1 : 0);
+        }
+        length += 2;
+    }
+    length += 4;
+
+    if (length <= bufferLength) {
+        x = 0;
+        memcpy(pBuffer + x, "\r\n", 2);
+        x += 2;
+        for (size_t l = 0; l < pEntry->response.numLines; l++) {
+            pLine = &(pEntry->response.lines[l]);
+            if (pLine->pPrefix != NULL) {
+                memcpy(pBuffer + x, pLine->pPrefix, strlen(pLine->pPrefix));
+                x += strlen(pLine->pPrefix);
+                *(pBuffer + x) = ' ';
+                x++;
+            }
+            for (size_t p = 0; p < pLine->numParameters; p++) {
+                if (p > 0) {
+                    *(pBuffer + x) = ',';
+                    x++;
+                }
+                memcpy(pBuffer + x, pLine->parametersRaw[p].pBytes,
+                       pLine->parametersRaw[p].length);
+                x += pLine->parametersRaw[p].length;
+            }
+            memcpy(pBuffer + x, "\r\n", 2);
+            x += 2;
+        }
+        memcpy(pBuffer + x, "OK\r\n", 4);
+    } else {
+        length = 0;
+    }
+
+    return length;
+}
+
+// Read the parameters of one response line in the parse rate
+// benchmark, without printing anything, returning the number
+// that did not match.
+static size_t parseRateCheckLine(uAtClientHandle_t atClientHandle,
+                                 const uAtClientTestResponseLine_t *pLine,
+                                 char *pBuffer, size_t bufferLength)
+{
+    const uAtClientTestParameter_t *pParameter;
+    size_t numErrors = 0;
+    uint64_t uint64;
+    int32_t x;
+
+    for (size_t p = 0; p < pLine->numParameters; p++) {
+        pParameter = &(pLine->parameters[p]);
+        switch (pParameter->type) {
+            case U_AT_CLIENT_TEST_PARAMETER_INT32:
+                if (uAtClientReadInt(atClientHandle) != pParameter->parameter.int32) {
+                    numErrors++;
+                }
+                break;
+            case U_AT_CLIENT_TEST_PARAMETER_UINT64:
+                if ((uAtClientReadUint64(atClientHandle, &uint64) != 0) ||
+                    (uint64 != pParameter->parameter.uint64)) {
+                    numErrors++;
+                }
+                break;
+            case U_AT_CLIENT_TEST_PARAMETER_STRING:
+                x = uAtClientReadString(atClientHandle, pBuffer,
+                                        ((pParameter->length > 0) &&
+                                         (pParameter->length < bufferLength)) ?
+                                        pParameter->length : bufferLength, false);
+                if ((x < 0) || (strcmp(pBuffer, pParameter->parameter.pString) != 0)) {
+                    numErrors++;
+                }
+                break;
+            default:
+                numErrors++;
+                break;
+        }
+    }
+
+    return numErrors;
+}
+
+// Collect the lines of a transcript captured in the atClientReplay
+// test; anything that doesn't fit is dropped, which the test will
+// notice.
+static void replayCapturePrint(const char *pLine, void *pParam)
+{
+    size_t length = strlen(pLine);
+
+    (void) pParam;
+
+    if (gReplayCaptureLength + length + 1 <= sizeof(gReplayCapture)) {
+        memcpy(gReplayCapture + gReplayCaptureLength, pLine, length);
+        gReplayCaptureLength += length;
+        gReplayCapture[gReplayCaptureLength] = '\n';
+        gReplayCaptureLength++;
+    }
+}
+
+// Sum the lengths of the TX or RX records of a transcript.
+static int64_t replayLength(const uAtClientReplayTranscript_t *pTranscript,
+                            bool isTx)
+{
+    int64_t length = 0;
+
+    for (size_t x = 0; x < pTranscript->numRecords; x++) {
+        if (pTranscript->pRecord[x].isTx == isTx) {
+            length += pTranscript->pRecord[x].length;
+        }
+    }
+
+    return length;
+}
+
 /* ----------------------------------------------------------------
  * PUBLIC FUNCTIONS: TESTS
  * -------------------------------------------------------------- */
@@ -1043,6 +1662,752 @@ U_PORT_TEST_FUNCTION("[atClient]", "atClientInitialisation")
     uTestUtilResourceCheck(U_TEST_PREFIX, NULL, true);
 }
 
+/** Measure the cost of dispatching URCs with 5, 50 and 200 URC
+ * handlers registered; a virtual serial device generates the
+ * URCs from memory so that no hardware is required.  The URC
+ * lines are spread evenly across the handlers and each handler
+ * must receive exactly its share.
+ */
+U_PORT_TEST_FUNCTION("[atClient]", "atClientUrcDispatch")
+{
+    uAtClientHandle_t atClientHandle;
+    uAtClientStreamHandle_t stream;
+    uDeviceSerial_t *pDeviceSerial;
+    uAtClientTestUrcSerialContext_t *pContext;
+    const size_t numHandlersList[] = {5, 50, U_AT_CLIENT_TEST_URC_DISPATCH_MAX_NUM_HANDLERS};
+    size_t numHandlers;
+    char prefix[16];
+    int32_t startTimeMs;
+    int32_t durationMs;
+    int32_t resourceCount;
+
+    // Whatever called us likely initialised the
+    // port so deinitialise it here to obtain the
+    // correct initial heap size
+    uPortDeinit();
+    resourceCount = uTestUtilGetDynamicResourceCount();
+    U_PORT_TEST_ASSERT(uPortInit() == 0);
+    U_PORT_TEST_ASSERT(uAtClientInit() == 0);
+
+    pDeviceSerial = pUDeviceSerialCreate(urcSerialInit,
+                                         sizeof(uAtClientTestUrcSerialContext_t));
+    U_PORT_TEST_ASSERT(pDeviceSerial != NULL);
+    pContext = (uAtClientTestUrcSerialContext_t *) pUInterfaceContext(pDeviceSerial);
+
+    stream.handle.pDeviceSerial = pDeviceSerial;
+    stream.type = U_AT_CLIENT_STREAM_TYPE_VIRTUAL_SERIAL;
+    atClientHandle = uAtClientAddExt(&stream, NULL, U_AT_CLIENT_TEST_AT_BUFFER_LENGTH_BYTES);
+    U_PORT_TEST_ASSERT(atClientHandle != NULL);
+    // Take away all of the deliberate delays so that only
+    // processing time is measured
+    uAtClientDelaySet(atClientHandle, 0);
+    uAtClientReadRetryDelaySet(atClientHandle, 0);
+
+    for (size_t x = 0; x < sizeof(numHandlersList) / sizeof(numHandlersList[0]); x++) {
+        numHandlers = numHandlersList[x];
+        memset(gUrcDispatchCount, 0, sizeof(gUrcDispatchCount));
+        for (size_t y = 0; y < numHandlers; y++) {
+            snprintf(prefix, sizeof(prefix), "+UTST%03d:", (int) y);
+            U_PORT_TEST_ASSERT(uAtClientSetUrcHandler(atClientHandle, prefix,
+                                                      urcDispatchHandler,
+                                                      &(gUrcDispatchCount[y])) == 0);
+        }
+
+        memset(pContext, 0, sizeof(*pContext));
+        pContext->numHandlers = numHandlers;
+        pContext->numLines = U_AT_CLIENT_TEST_URC_DISPATCH_NUM_LINES;
+
+        // All of the URCs arrive while waiting for the "OK"
+        startTimeMs = uPortGetTickTimeMs();
+        uAtClientLock(atClientHandle);
+        uAtClientCommandStart(atClientHandle, "AT");
+        uAtClientCommandStopReadResponse(atClientHandle);
+        U_PORT_TEST_ASSERT(uAtClientUnlock(atClientHandle) == 0);
+        durationMs = uPortGetTickTimeMs() - startTimeMs;
+
+        U_TEST_PRINT_LINE("%d URC handler(s): %d URCs dispatched in %d ms,"
+                          " %d ns per URC.", (int) numHandlers,
+                          U_AT_CLIENT_TEST_URC_DISPATCH_NUM_LINES, durationMs,
+                          (int32_t) (((int64_t) durationMs) * 1000000 /
+                                     U_AT_CLIENT_TEST_URC_DISPATCH_NUM_LINES));
+        for (size_t y = 0; y < numHandlers; y++) {
+            U_PORT_TEST_ASSERT(gUrcDispatchCount[y] ==
+                               (U_AT_CLIENT_TEST_URC_DISPATCH_NUM_LINES / numHandlers) +
+                               ((y < U_AT_CLIENT_TEST_URC_DISPATCH_NUM_LINES % numHandlers) ? 1 : 0));
+        }
+
+        // Remove the handlers again, in the opposite order,
+        // to exercise removal from the middle of things
+        for (size_t y = numHandlers; y > 0; y--) {
+            snprintf(prefix, sizeof(prefix), "+UTST%03d:", (int) (y - 1));
+            uAtClientRemoveUrcHandler(atClientHandle, prefix);
+        }
+        U_PORT_TEST_ASSERT(uAtClientUrcHandlerGetFirst(atClientHandle, NULL, NULL, NULL) < 0);
+    }
+
+    uAtClientRemove(atClientHandle);
+    uAtClientDeinit();
+    uDeviceSerialDelete(pDeviceSerial);
+    uPortDeinit();
+
+    // Check for resource leaks
+    uTestUtilResourceCheck(U_TEST_PREFIX, NULL, true);
+    resourceCount = uTestUtilGetDynamicResourceCount() - resourceCount;
+    U_TEST_PRINT_LINE("we have leaked %d resources(s).", resourceCount);
+    U_PORT_TEST_ASSERT(resourceCount <= 0);
+}
+
+/** Read a binary response larger than the receive buffer using
+ * uAtClientReadBytesSpan(), checking that the spans, reassembled,
+ * match what was sent, then a text response with a span that ends
+ * part of the way into the stop tag; a virtual serial device
+ * provides the responses from memory so that no hardware is
+ * required.
+ */
+U_PORT_TEST_FUNCTION("[atClient]", "atClientReadBytesSpan")
+{
+    uAtClientHandle_t atClientHandle;
+    uAtClientStreamHandle_t stream;
+    uDeviceSerial_t *pDeviceSerial;
+    uAtClientTestUrcSerialContext_t *pContext;
+    char *pBuffer;
+    const char *pSpan = NULL;
+    size_t length;
+    int32_t x;
+    int32_t numSpans = 0;
+    int32_t resourceCount;
+
+    // Whatever called us likely initialised the
+    // port so deinitialise it here to obtain the
+    // correct initial heap size
+    uPortDeinit();
+    resourceCount = uTestUtilGetDynamicResourceCount();
+    U_PORT_TEST_ASSERT(uPortInit() == 0);
+    U_PORT_TEST_ASSERT(uAtClientInit() == 0);
+
+    // Binary data including nulls and something that looks
+    // like the end of a response
+    for (size_t y = 0; y < sizeof(gSpanData); y++) {
+        gSpanData[y] = (char) (y * 7);
+    }
+    memcpy(gSpanData + (sizeof(gSpanData) / 2), "\r\nOK\r\n", 6);
+    length = snprintf(gSpanResponse, sizeof(gSpanResponse), "\r\n+USORD: 0,%d,\"",
+                      (int) sizeof(gSpanData));
+    memcpy(gSpanResponse + length, gSpanData, sizeof(gSpanData));
+    length += sizeof(gSpanData);
+    length += snprintf(gSpanResponse + length, sizeof(gSpanResponse) - length,
+                       "\"\r\nOK\r\n");
+
+    pBuffer = (char *) pUPortMalloc(sizeof(gSpanData));
+    U_PORT_TEST_ASSERT(pBuffer != NULL);
+    memset(pBuffer, 0xFF, sizeof(gSpanData));
+
+    pDeviceSerial = pUDeviceSerialCreate(urcSerialInit,
+                                         sizeof(uAtClientTestUrcSerialContext_t));
+    U_PORT_TEST_ASSERT(pDeviceSerial != NULL);
+    pContext = (uAtClientTestUrcSerialContext_t *) pUInterfaceContext(pDeviceSerial);
+    memset(pContext, 0, sizeof(*pContext));
+    pContext->pResponse = gSpanResponse;
+    pContext->responseLength = length;
+
+    stream.handle.pDeviceSerial = pDeviceSerial;
+    stream.type = U_AT_CLIENT_STREAM_TYPE_VIRTUAL_SERIAL;
+    atClientHandle = uAtClientAddExt(&stream, NULL, U_AT_CLIENT_TEST_AT_BUFFER_LENGTH_BYTES);
+    U_PORT_TEST_ASSERT(atClientHandle != NULL);
+    uAtClientDelaySet(atClientHandle, 0);
+    uAtClientReadRetryDelaySet(atClientHandle, 0);
+
+    uAtClientLock(atClientHandle);
+    uAtClientCommandStart(atClientHandle, "AT+USORD=");
+    uAtClientWriteInt(atClientHandle, 0);
+    uAtClientWriteInt(atClientHandle, (int32_t) sizeof(gSpanData));
+    uAtClientCommandStop(atClientHandle);
+    uAtClientResponseStart(atClientHandle, "+USORD:");
+    uAtClientSkipParameters(atClientHandle, 1);
+    U_PORT_TEST_ASSERT(uAtClientReadInt(atClientHandle) == (int32_t) sizeof(gSpanData));
+    uAtClientIgnoreStopTag(atClientHandle);
+    U_PORT_TEST_ASSERT(uAtClientReadBytes(atClientHandle, NULL, 1, true) == 1);
+    length = 0;
+    while (length < sizeof(gSpanData)) {
+        x = uAtClientReadBytesSpan(atClientHandle, &pSpan,
+                                   sizeof(gSpanData) - length);
+        U_PORT_TEST_ASSERT(x > 0);
+        U_PORT_TEST_ASSERT(pSpan != NULL);
+        U_PORT_TEST_ASSERT(length + x <= sizeof(gSpanData));
+        memcpy(pBuffer + length, pSpan, x);
+        length += x;
+        numSpans++;
+    }
+    uAtClientRestoreStopTag(atClientHandle);
+    uAtClientResponseStop(atClientHandle);
+    U_PORT_TEST_ASSERT(uAtClientUnlock(atClientHandle) == 0);
+
+    U_TEST_PRINT_LINE("%d byte(s) read in %d span(s).", (int) length, (int) numSpans);
+    // Must have needed more than one span for the test to be valid
+    U_PORT_TEST_ASSERT(numSpans > 1);
+    U_PORT_TEST_ASSERT(memcmp(pBuffer, gSpanData, sizeof(gSpanData)) == 0);
+
+    // Now with the stop tag obeyed, asking for a span that ends
+    // part of the way into the stop tag: none of the stop tag
+    // should be returned and it should still be found
+    length = snprintf(gSpanResponse, sizeof(gSpanResponse),
+                      "\r\n+USORD: 0,6,abcdef\r\nOK\r\n");
+    memset(pContext, 0, sizeof(*pContext));
+    pContext->pResponse = gSpanResponse;
+    pContext->responseLength = length;
+    uAtClientLock(atClientHandle);
+    uAtClientCommandStart(atClientHandle, "AT+USORD=");
+    uAtClientWriteInt(atClientHandle, 0);
+    uAtClientWriteInt(atClientHandle, 6);
+    uAtClientCommandStop(atClientHandle);
+    uAtClientResponseStart(atClientHandle, "+USORD:");
+    uAtClientSkipParameters(atClientHandle, 1);
+    U_PORT_TEST_ASSERT(uAtClientReadInt(atClientHandle) == 6);
+    U_PORT_TEST_ASSERT(uAtClientReadBytesSpan(atClientHandle, &pSpan, 3) == 3);
+    U_PORT_TEST_ASSERT(memcmp(pSpan, "abc", 3) == 0);
+    U_PORT_TEST_ASSERT(uAtClientReadBytesSpan(atClientHandle, &pSpan, 4) == 3);
+    U_PORT_TEST_ASSERT(memcmp(pSpan, "def", 3) == 0);
+    U_PORT_TEST_ASSERT(uAtClientReadBytesSpan(atClientHandle, &pSpan, 4) == 0);
+    U_PORT_TEST_ASSERT(pSpan == NULL);
+    uAtClientResponseStop(atClientHandle);
+    U_PORT_TEST_ASSERT(uAtClientUnlock(atClientHandle) == 0);
+
+    uPortFree(pBuffer);
+    uAtClientRemove(atClientHandle);
+    uAtClientDeinit();
+    uDeviceSerialDelete(pDeviceSerial);
+    uPortDeinit();
+
+    // Check for resource leaks
+    uTestUtilResourceCheck(U_TEST_PREFIX, NULL, true);
+    resourceCount = uTestUtilGetDynamicResourceCount() - resourceCount;
+    U_TEST_PRINT_LINE("we have leaked %d resources(s).", resourceCount);
+    U_PORT_TEST_ASSERT(resourceCount <= 0);
+}
+
+/** Measure the throughput of AT commands sent to a simulated modem
+ * that takes U_AT_CLIENT_TEST_PIPELINE_LATENCY_MS to respond to
+ * each one, without and with pipelining; every tenth AT command
+ * gets "ERROR" and that must affect only that AT command.  AT
+ * commands without a prefix are also pipelined.
+ */
+U_PORT_TEST_FUNCTION("[atClient]", "atClientPipeline")
+{
+    uAtClientHandle_t atClientHandle;
+    uAtClientStreamHandle_t stream;
+    uDeviceSerial_t *pDeviceSerial;
+    uAtClientTestModemContext_t *pContext;
+    const size_t windowList[] = {1, 4, U_AT_CLIENT_PIPELINE_WINDOW_MAX};
+    int32_t durationMs[sizeof(windowList) / sizeof(windowList[0])];
+    int32_t startTimeMs;
+    int32_t resourceCount;
+
+    // Whatever called us likely initialised the
+    // port so deinitialise it here to obtain the
+    // correct initial heap size
+    uPortDeinit();
+    resourceCount = uTestUtilGetDynamicResourceCount();
+    U_PORT_TEST_ASSERT(uPortInit() == 0);
+    U_PORT_TEST_ASSERT(uAtClientInit() == 0);
+
+    pDeviceSerial = pUDeviceSerialCreate(modemInit,
+                                         sizeof(uAtClientTestModemContext_t));
+    U_PORT_TEST_ASSERT(pDeviceSerial != NULL);
+    pContext = (uAtClientTestModemContext_t *) pUInterfaceContext(pDeviceSerial);
+    memset(pContext, 0, sizeof(*pContext));
+
+    stream.handle.pDeviceSerial = pDeviceSerial;
+    stream.type = U_AT_CLIENT_STREAM_TYPE_VIRTUAL_SERIAL;
+    atClientHandle = uAtClientAddExt(&stream, NULL, U_AT_CLIENT_TEST_AT_BUFFER_LENGTH_BYTES);
+    U_PORT_TEST_ASSERT(atClientHandle != NULL);
+    U_PORT_TEST_ASSERT(uAtClientPipelineWindowGet(atClientHandle) == 1);
+    U_PORT_TEST_ASSERT(uAtClientPipelineWindowSet(atClientHandle, 0) < 0);
+    U_PORT_TEST_ASSERT(uAtClientPipelineWindowSet(atClientHandle,
+                                                  U_AT_CLIENT_PIPELINE_WINDOW_MAX + 1) < 0);
+    // Take away the delay between commands, which would
+    // otherwise dominate
+    uAtClientDelaySet(atClientHandle, 0);
+    uAtClientReadRetryDelaySet(atClientHandle, 0);
+
+    for (size_t x = 0; x < sizeof(windowList) / sizeof(windowList[0]); x++) {
+        U_PORT_TEST_ASSERT(uAtClientPipelineWindowSet(atClientHandle, windowList[x]) == 0);
+        U_PORT_TEST_ASSERT(uAtClientPipelineWindowGet(atClientHandle) == windowList[x]);
+        memset(gPipelineResult, 0, sizeof(gPipelineResult));
+
+        startTimeMs = uPortGetTickTimeMs();
+        uAtClientLock(atClientHandle);
+        for (size_t y = 0; y < U_AT_CLIENT_TEST_PIPELINE_NUM_COMMANDS; y++) {
+            uAtClientCommandStart(atClientHandle, "AT+UTSTP=");
+            uAtClientWriteInt(atClientHandle, (int32_t) y);
+            uAtClientCommandStopPipelined(atClientHandle, "+UTSTP:",
+                                          pipelineCallback, &(gPipelineResult[y]));
+        }
+        // The errors are reported at the end
+        U_PORT_TEST_ASSERT(uAtClientUnlock(atClientHandle) < 0);
+        durationMs[x] = uPortGetTickTimeMs() - startTimeMs;
+
+        U_TEST_PRINT_LINE("window %d: %d AT commands in %d ms, %d AT commands"
+                          " per second.", (int) windowList[x],
+                          U_AT_CLIENT_TEST_PIPELINE_NUM_COMMANDS, durationMs[x],
+                          (int32_t) ((((int64_t) U_AT_CLIENT_TEST_PIPELINE_NUM_COMMANDS) * 1000) /
+                                     (durationMs[x] > 0 ? durationMs[x] : 1)));
+        U_PORT_TEST_ASSERT(!pContext->overflow);
+        for (size_t y = 0; y < U_AT_CLIENT_TEST_PIPELINE_NUM_COMMANDS; y++) {
+            U_PORT_TEST_ASSERT(gPipelineResult[y].numCalls == 1);
+            if (y % 10 == 9) {
+                U_PORT_TEST_ASSERT(gPipelineResult[y].errorCode < 0);
+            } else {
+                U_PORT_TEST_ASSERT(gPipelineResult[y].errorCode == 0);
+                U_PORT_TEST_ASSERT(gPipelineResult[y].value == (int32_t) (y * 2));
+            }
+        }
+
+        // A normal AT command must still work afterwards
+        uAtClientLock(atClientHandle);
+        uAtClientCommandStart(atClientHandle, "AT+UTSTP=");
+        uAtClientWriteInt(atClientHandle, 1);
+        uAtClientCommandStop(atClientHandle);
+        uAtClientResponseStart(atClientHandle, "+UTSTP:");
+        U_PORT_TEST_ASSERT(uAtClientReadInt(atClientHandle) == 2);
+        uAtClientResponseStop(atClientHandle);
+        U_PORT_TEST_ASSERT(uAtClientUnlock(atClientHandle) == 0);
+    }
+
+    // Pipelining must have made a significant difference
+    U_PORT_TEST_ASSERT(durationMs[(sizeof(windowList) / sizeof(windowList[0])) - 1] <
+                       durationMs[0] / 2);
+
+    // Without a prefix the callback gets the outcome of the AT
+    // command: zero for "OK", negative for "ERROR"
+    memset(gPipelineResult, 0, sizeof(gPipelineResult));
+    uAtClientLock(atClientHandle);
+    uAtClientCommandStart(atClientHandle, "AT");
+    uAtClientCommandStopPipelined(atClientHandle, NULL, pipelineCallbackNoPrefix,
+                                  &(gPipelineResult[0]));
+    uAtClientCommandStart(atClientHandle, "AT+UTSTP=");
+    uAtClientWriteInt(atClientHandle, 9);
+    uAtClientCommandStopPipelined(atClientHandle, NULL, pipelineCallbackNoPrefix,
+                                  &(gPipelineResult[1]));
+    uAtClientCommandStart(atClientHandle, "AT");
+    uAtClientCommandStopPipelined(atClientHandle, NULL, pipelineCallbackNoPrefix,
+                                  &(gPipelineResult[2]));
+    U_PORT_TEST_ASSERT(uAtClientUnlock(atClientHandle) < 0);
+    for (size_t y = 0; y < 3; y++) {
+        U_PORT_TEST_ASSERT(gPipelineResult[y].numCalls == 1);
+    }
+    U_PORT_TEST_ASSERT(gPipelineResult[0].errorCode == 0);
+    U_PORT_TEST_ASSERT(gPipelineResult[1].errorCode < 0);
+    U_PORT_TEST_ASSERT(gPipelineResult[2].errorCode == 0);
+
+    U_PORT_TEST_ASSERT(uAtClientPipelineWindowSet(atClientHandle, 1) == 0);
+    uAtClientRemove(atClientHandle);
+    uAtClientDeinit();
+    uDeviceSerialDelete(pDeviceSerial);
+    uPortDeinit();
+
+    // Check for resource leaks
+    uTestUtilResourceCheck(U_TEST_PREFIX, NULL, true);
+    resourceCount = uTestUtilGetDynamicResourceCount() - resourceCount;
+    U_TEST_PRINT_LINE("we have leaked %d resources(s).", resourceCount);
+    U_PORT_TEST_ASSERT(resourceCount <= 0);
+}
+
+/** Check the statistics kept by the AT client, using the simulated
+ * modem from the atClientPipeline test.
+ */
+U_PORT_TEST_FUNCTION("[atClient]", "atClientStats")
+{
+    uAtClientHandle_t atClientHandle;
+    uAtClientStreamHandle_t stream;
+    uDeviceSerial_t *pDeviceSerial;
+    uAtClientTestModemContext_t *pContext;
+    uAtClientStats_t stats;
+    uAtClientStatsCommand_t commandStats;
+    int64_t bytesSent = 0;
+    int64_t bytesReceived = 0;
+    int32_t count;
+    int32_t resourceCount;
+
+    // Whatever called us likely initialised the
+    // port so deinitialise it here to obtain the
+    // correct initial heap size
+    uPortDeinit();
+    resourceCount = uTestUtilGetDynamicResourceCount();
+    U_PORT_TEST_ASSERT(uPortInit() == 0);
+    U_PORT_TEST_ASSERT(uAtClientInit() == 0);
+
+    pDeviceSerial = pUDeviceSerialCreate(modemInit,
+                                         sizeof(uAtClientTestModemContext_t));
+    U_PORT_TEST_ASSERT(pDeviceSerial != NULL);
+    pContext = (uAtClientTestModemContext_t *) pUInterfaceContext(pDeviceSerial);
+    memset(pContext, 0, sizeof(*pContext));
+
+    stream.handle.pDeviceSerial = pDeviceSerial;
+    stream.type = U_AT_CLIENT_STREAM_TYPE_VIRTUAL_SERIAL;
+    atClientHandle = uAtClientAddExt(&stream, NULL, U_AT_CLIENT_TEST_AT_BUFFER_LENGTH_BYTES);
+    U_PORT_TEST_ASSERT(atClientHandle != NULL);
+    uAtClientDelaySet(atClientHandle, 0);
+    uAtClientReadRetryDelaySet(atClientHandle, 0);
+
+    U_PORT_TEST_ASSERT(uAtClientStatsGet(atClientHandle, &stats) < 0);
+    U_PORT_TEST_ASSERT(uAtClientStatsStart(atClientHandle) == 0);
+    U_PORT_TEST_ASSERT(uAtClientStatsGet(atClientHandle, &stats) == 0);
+
+    // 20 commands, two of which will get "ERROR", then
+    // 5 commands which the simulated modem doesn't
+    // understand at all, one of them pipelined
+    for (size_t x = 0; x < 20; x++) {
+        uAtClientLock(atClientHandle);
+        uAtClientCommandStart(atClientHandle, "AT+UTSTP=");
+        uAtClientWriteInt(atClientHandle, (int32_t) x);
+        uAtClientCommandStop(atClientHandle);
+        uAtClientResponseStart(atClientHandle, "+UTSTP:");
+        uAtClientReadInt(atClientHandle);
+        uAtClientResponseStop(atClientHandle);
+        uAtClientUnlock(atClientHandle);
+    }
+    for (size_t x = 0; x < 5; x++) {
+        uAtClientLock(atClientHandle);
+        uAtClientCommandStart(atClientHandle, "ATI");
+        if (x == 0) {
+            uAtClientCommandStopPipelined(atClientHandle, NULL, NULL, NULL);
+        } else {
+            uAtClientCommandStopReadResponse(atClientHandle);
+        }
+        U_PORT_TEST_ASSERT(uAtClientUnlock(atClientHandle) < 0);
+    }
+
+    uAtClientStatsPrint(atClientHandle);
+    U_PORT_TEST_ASSERT(uAtClientStatsGet(atClientHandle, &stats) == 2);
+    U_PORT_TEST_ASSERT(stats.numCommands == 2);
+    U_PORT_TEST_ASSERT(stats.bytesSent == (int64_t) pContext->bytesWritten);
+    U_PORT_TEST_ASSERT(stats.bytesReceived == (int64_t) pContext->bytesRead);
+    U_PORT_TEST_ASSERT(stats.numUrcs == 0);
+    U_PORT_TEST_ASSERT(stats.durationMs >= 25 * U_AT_CLIENT_TEST_PIPELINE_LATENCY_MS);
+    for (size_t x = 0; x < 2; x++) {
+        U_PORT_TEST_ASSERT(uAtClientStatsCommandGet(atClientHandle, x, &commandStats) == 0);
+        if (x == 0) {
+            U_PORT_TEST_ASSERT(strcmp(commandStats.command, "AT+UTSTP=") == 0);
+            U_PORT_TEST_ASSERT(commandStats.count == 20);
+            U_PORT_TEST_ASSERT(commandStats.numDeviceErrors == 2);
+        } else {
+            U_PORT_TEST_ASSERT(strcmp(commandStats.command, "ATI") == 0);
+            U_PORT_TEST_ASSERT(commandStats.count == 5);
+            U_PORT_TEST_ASSERT(commandStats.numDeviceErrors == 5);
+        }
+        U_PORT_TEST_ASSERT(commandStats.numTimeouts == 0);
+        U_PORT_TEST_ASSERT(commandStats.latencyMinMs >= U_AT_CLIENT_TEST_PIPELINE_LATENCY_MS);
+        U_PORT_TEST_ASSERT(commandStats.latencyMaxMs >= commandStats.latencyMinMs);
+        U_PORT_TEST_ASSERT(commandStats.latencyTotalMs >= ((int64_t) commandStats.count) *
+                           commandStats.latencyMinMs);
+        count = 0;
+        for (size_t y = 0; y < U_AT_CLIENT_STATS_NUM_HISTOGRAM_BUCKETS; y++) {
+            count += commandStats.latencyHistogram[y];
+        }
+        U_PORT_TEST_ASSERT(count == commandStats.count);
+        bytesSent += commandStats.bytesSent;
+        bytesReceived += commandStats.bytesReceived;
+    }
+    U_PORT_TEST_ASSERT(uAtClientStatsCommandGet(atClientHandle, 2, &commandStats) < 0);
+    U_PORT_TEST_ASSERT(bytesSent == stats.bytesSent);
+    U_PORT_TEST_ASSERT(bytesReceived == stats.bytesReceived);
+
+    uAtClientStatsReset(atClientHandle);
+    U_PORT_TEST_ASSERT(uAtClientStatsGet(atClientHandle, &stats) == 0);
+    U_PORT_TEST_ASSERT(stats.bytesSent == 0);
+    uAtClientStatsStop(atClientHandle);
+    U_PORT_TEST_ASSERT(uAtClientStatsGet(atClientHandle, &stats) < 0);
+
+    uAtClientRemove(atClientHandle);
+    uAtClientDeinit();
+    uDeviceSerialDelete(pDeviceSerial);
+    uPortDeinit();
+
+    // Check for resource leaks
+    uTestUtilResourceCheck(U_TEST_PREFIX, NULL, true);
+    resourceCount = uTestUtilGetDynamicResourceCount() - resourceCount;
+    U_TEST_PRINT_LINE("we have leaked %d resources(s).", resourceCount);
+    U_PORT_TEST_ASSERT(resourceCount <= 0);
+}
+
+/** Measure how fast the AT client can parse recorded AT traffic:
+ * the responses in gAtClientTestSet1, plus a "+USORF" line carrying
+ * hex-mode socket data, are replayed from memory by a virtual serial
+ * device and every parameter is read back and checked.  The rate
+ * is compared with that of a 921600 baud UART.
+ */
+U_PORT_TEST_FUNCTION("[atClient]", "atClientParseRate")
+{
+    uAtClientHandle_t atClientHandle;
+    uAtClientStreamHandle_t stream;
+    uDeviceSerial_t *pDeviceSerial;
+    uAtClientTestUrcSerialContext_t *pContext;
+    const uAtClientTestCommandResponse_t *pEntry;
+    char *pBuffer;
+    size_t length = 0;
+    size_t numErrors = 0;
+    size_t numResponses = 0;
+    int32_t startTimeMs;
+    int32_t durationMs;
+    int64_t bytesPerSecond;
+    int32_t resourceCount;
+
+    // Whatever called us likely initialised the
+    // port so deinitialise it here to obtain the
+    // correct initial heap size
+    uPortDeinit();
+    resourceCount = uTestUtilGetDynamicResourceCount();
+    U_PORT_TEST_ASSERT(uPortInit() == 0);
+    U_PORT_TEST_ASSERT(uAtClientInit() == 0);
+
+    // Assemble the traffic: all of the usable responses
+    // from the test data then a big hex-mode socket read
+    for (size_t x = 0; x < gAtClientTestSetSize1; x++) {
+        pEntry = &(gAtClientTestSet1[x]);
+        if (parseRateEntryIsUsable(pEntry)) {
+            length += parseRateAddEntry(gParseRateTranscript + length,
+                                        sizeof(gParseRateTranscript) - length,
+                                        pEntry);
+            numResponses++;
+        }
+    }
+    for (size_t x = 0; x < sizeof(gParseRateHex) - 1; x++) {
+        gParseRateHex[x] = "0123456789ABCDEF"[(x * 7) & 0x0f];
+    }
+    gParseRateHex[sizeof(gParseRateHex) - 1] = 0;
+    length += snprintf(gParseRateTranscript + length,
+                       sizeof(gParseRateTranscript) - length,
+                       "\r\n+USORF: 0,\"10.20.30.40\",5000,%d,\"%s\"\r\nOK\r\n",
+                       U_AT_CLIENT_TEST_PARSE_RATE_HEX_DATA_LENGTH_BYTES, gParseRateHex);
+    U_PORT_TEST_ASSERT(length < sizeof(gParseRateTranscript));
+    U_PORT_TEST_ASSERT(length <= U_AT_CLIENT_TEST_PARSE_RATE_AT_BUFFER_LENGTH_BYTES -
+                       U_AT_CLIENT_BUFFER_OVERHEAD_BYTES);
+    U_TEST_PRINT_LINE("replaying %d response(s), %d byte(s), %d times.",
+                      (int) numResponses + 1, (int) length,
+                      U_AT_CLIENT_TEST_PARSE_RATE_NUM_PASSES);
+
+    pBuffer = (char *) pUPortMalloc(sizeof(gParseRateHex));
+    U_PORT_TEST_ASSERT(pBuffer != NULL);
+
+    pDeviceSerial = pUDeviceSerialCreate(urcSerialInit,
+                                         sizeof(uAtClientTestUrcSerialContext_t));
+    U_PORT_TEST_ASSERT(pDeviceSerial != NULL);
+    pContext = (uAtClientTestUrcSerialContext_t *) pUInterfaceContext(pDeviceSerial);
+    memset(pContext, 0, sizeof(*pContext));
+    pContext->pResponse = gParseRateTranscript;
+    pContext->responseLength = length;
+
+    stream.handle.pDeviceSerial = pDeviceSerial;
+    stream.type = U_AT_CLIENT_STREAM_TYPE_VIRTUAL_SERIAL;
+    atClientHandle = uAtClientAddExt(&stream, NULL, U_AT_CLIENT_TEST_PARSE_RATE_AT_BUFFER_LENGTH_BYTES);
+    U_PORT_TEST_ASSERT(atClientHandle != NULL);
+    uAtClientDelaySet(atClientHandle, 0);
+    uAtClientReadRetryDelaySet(atClientHandle, 0);
+
+    startTimeMs = uPortGetTickTimeMs();
+    for (size_t pass = 0; pass < U_AT_CLIENT_TEST_PARSE_RATE_NUM_PASSES; pass++) {
+        // Rewind the virtual serial device to the start of the traffic
+        pContext->okSent = false;
+        for (size_t x = 0; x < gAtClientTestSetSize1; x++) {
+            pEntry = &(gAtClientTestSet1[x]);
+            if (parseRateEntryIsUsable(pEntry)) {
+                uAtClientLock(atClientHandle);
+                uAtClientCommandStart(atClientHandle, "AT");
+                if (pEntry->response.numLines > 0) {
+                    uAtClientCommandStop(atClientHandle);
+                    for (size_t l = 0; l < pEntry->response.numLines; l++) {
+                        uAtClientResponseStart(atClientHandle,
+                                               pEntry->response.lines[l].pPrefix);
+                        numErrors += parseRateCheckLine(atClientHandle,
+                                                        &(pEntry->response.lines[l]),
+                                                        pBuffer, sizeof(gParseRateHex));
+                    }
+                    uAtClientResponseStop(atClientHandle);
+                } else {
+                    uAtClientCommandStopReadResponse(atClientHandle);
+                }
+                if (uAtClientUnlock(atClientHandle) != 0) {
+                    numErrors++;
+                }
+            }
+        }
+        uAtClientLock(atClientHandle);
+        uAtClientCommandStart(atClientHandle, "AT+USORF=");
+        uAtClientWriteInt(atClientHandle, 0);
+        uAtClientWriteInt(atClientHandle, U_AT_CLIENT_TEST_PARSE_RATE_HEX_DATA_LENGTH_BYTES);
+        uAtClientCommandStop(atClientHandle);
+        uAtClientResponseStart(atClientHandle, "+USORF:");
+        uAtClientSkipParameters(atClientHandle, 3);
+        if ((uAtClientReadInt(atClientHandle) != U_AT_CLIENT_TEST_PARSE_RATE_HEX_DATA_LENGTH_BYTES) ||
+            (uAtClientReadString(atClientHandle, pBuffer, sizeof(gParseRateHex),
+                                 false) != (int32_t) sizeof(gParseRateHex) - 1) ||
+            (strcmp(pBuffer, gParseRateHex) != 0)) {
+            numErrors++;
+        }
+        uAtClientResponseStop(atClientHandle);
+        if (uAtClientUnlock(atClientHandle) != 0) {
+            numErrors++;
+        }
+    }
+    durationMs = uPortGetTickTimeMs() - startTimeMs;
+    if (durationMs <= 0) {
+        durationMs = 1;
+    }
+
+    bytesPerSecond = ((int64_t) length) * U_AT_CLIENT_TEST_PARSE_RATE_NUM_PASSES * 1000 /
+                     durationMs;
+    U_TEST_PRINT_LINE("parsed %d byte(s) in %d ms: %d bytes/s, %d.%02d times the"
+                      " rate of a 921600 baud UART.",
+                      (int) (length * U_AT_CLIENT_TEST_PARSE_RATE_NUM_PASSES),
+                      (int) durationMs, (int) bytesPerSecond,
+                      (int) (bytesPerSecond / U_AT_CLIENT_TEST_PARSE_RATE_LINE_RATE_BYTES_PER_SECOND),
+                      (int) ((bytesPerSecond * 100 / U_AT_CLIENT_TEST_PARSE_RATE_LINE_RATE_BYTES_PER_SECOND) % 100));
+    U_TEST_PRINT_LINE("%d parameter(s) did not match.", (int) numErrors);
+    U_PORT_TEST_ASSERT(numErrors == 0);
+
+    uPortFree(pBuffer);
+    uAtClientRemove(atClientHandle);
+    uAtClientDeinit();
+    uDeviceSerialDelete(pDeviceSerial);
+    uPortDeinit();
+
+    // Check for resource leaks
+    uTestUtilResourceCheck(U_TEST_PREFIX, NULL, true);
+    resourceCount = uTestUtilGetDynamicResourceCount() - resourceCount;
+    U_TEST_PRINT_LINE("we have leaked %d resources(s).", resourceCount);
+    U_PORT_TEST_ASSERT(resourceCount <= 0);
+}
+
+/** Check capture and replay of AT traffic: a transcript is played
+ * back as fast as possible and then with its recorded timing, then
+ * the traffic to and from the simulated modem of the atClientPipeline
+ * test is captured and the capture is played back.
+ */
+U_PORT_TEST_FUNCTION("[atClient]", "atClientReplay")
+{
+    uAtClientHandle_t atClientHandle;
+    uAtClientStreamHandle_t stream;
+    uDeviceSerial_t *pDeviceSerial;
+    uAtClientTestModemContext_t *pContext;
+    uAtClientReplayTranscript_t transcript;
+    uAtClientReplayResults_t results;
+    int32_t totalDeltaMs = 0;
+    int32_t numErrors = 0;
+    int32_t x;
+    int32_t resourceCount;
+
+    // Whatever called us likely initialised the
+    // port so deinitialise it here to obtain the
+    // correct initial heap size
+    uPortDeinit();
+    resourceCount = uTestUtilGetDynamicResourceCount();
+    U_PORT_TEST_ASSERT(uPortInit() == 0);
+    U_PORT_TEST_ASSERT(uAtClientInit() == 0);
+
+    // Rubbish must be rejected
+    U_PORT_TEST_ASSERT(uAtClientReplayTranscriptParse("> 0\n", 4, &transcript) < 0);
+    U_PORT_TEST_ASSERT(uAtClientReplayTranscriptParse("> x AT\n", 7, &transcript) < 0);
+    U_PORT_TEST_ASSERT(uAtClientReplayTranscriptParse("< 0 \\q\n", 8, &transcript) < 0);
+    U_PORT_TEST_ASSERT(uAtClientReplayTranscriptParse("AT\n", 3, &transcript) < 0);
+
+    U_PORT_TEST_ASSERT(uAtClientReplayTranscriptParse(gReplayTranscript,
+                                                      sizeof(gReplayTranscript) - 1,
+                                                      &transcript) == 17);
+    U_PORT_TEST_ASSERT(transcript.numUrcs == 2);
+    U_PORT_TEST_ASSERT(transcript.pRecord[6].isTx);
+    U_PORT_TEST_ASSERT(transcript.pRecord[6].deltaMs == 50);
+    U_PORT_TEST_ASSERT(transcript.pRecord[6].length == 5);
+    U_PORT_TEST_ASSERT(memcmp(transcript.pRecord[6].pData, "Hel\0o", 5) == 0);
+    for (size_t y = 0; y < transcript.numRecords; y++) {
+        totalDeltaMs += transcript.pRecord[y].deltaMs;
+    }
+
+    for (size_t timed = 0; timed < 2; timed++) {
+        U_PORT_TEST_ASSERT(uAtClientReplayRun(&transcript, (timed != 0), &results) == 0);
+        U_TEST_PRINT_LINE("%s replay: %d AT command(s), %d URC(s), %d error(s),"
+                          " %d mismatch(es) in %d ms, latency median %d ms,"
+                          " max %d ms.", timed ? "timed" : "fast",
+                          (int) results.numCommands, (int) results.numUrcs,
+                          (int) results.numDeviceErrors, (int) results.numMismatches,
+                          (int) results.durationMs,
+                          (int) uAtClientReplayLatencyPercentile(&results, 500),
+                          (int) uAtClientReplayLatencyPercentile(&results, 1000));
+        U_PORT_TEST_ASSERT(results.numCommands == 7);
+        U_PORT_TEST_ASSERT(results.numUrcs == 2);
+        U_PORT_TEST_ASSERT(results.numDeviceErrors == 1);
+        U_PORT_TEST_ASSERT(results.numMismatches == 0);
+        U_PORT_TEST_ASSERT(results.bytesSent == replayLength(&transcript, true));
+        U_PORT_TEST_ASSERT(results.bytesReceived == replayLength(&transcript, false));
+        U_PORT_TEST_ASSERT(uAtClientReplayLatencyPercentile(&results, 0) >= 0);
+        U_PORT_TEST_ASSERT(uAtClientReplayLatencyPercentile(&results, 1001) < 0);
+        if (timed) {
+            // Nothing can have happened sooner than it did originally
+            U_PORT_TEST_ASSERT(results.durationMs >= totalDeltaMs);
+            U_PORT_TEST_ASSERT(uAtClientReplayLatencyPercentile(&results, 1000) >= 40);
+        }
+        uAtClientReplayResultsFree(&results);
+    }
+    uAtClientReplayTranscriptFree(&transcript);
+
+    // Capture from the simulated modem
+    pDeviceSerial = pUDeviceSerialCreate(modemInit,
+                                         sizeof(uAtClientTestModemContext_t));
+    U_PORT_TEST_ASSERT(pDeviceSerial != NULL);
+    pContext = (uAtClientTestModemContext_t *) pUInterfaceContext(pDeviceSerial);
+    memset(pContext, 0, sizeof(*pContext));
+    stream.handle.pDeviceSerial = pDeviceSerial;
+    stream.type = U_AT_CLIENT_STREAM_TYPE_VIRTUAL_SERIAL;
+    atClientHandle = uAtClientAddExt(&stream, NULL, U_AT_CLIENT_TEST_AT_BUFFER_LENGTH_BYTES);
+    U_PORT_TEST_ASSERT(atClientHandle != NULL);
+    uAtClientDelaySet(atClientHandle, 0);
+
+    gReplayCaptureLength = 0;
+    uAtClientLock(atClientHandle);
+    U_PORT_TEST_ASSERT(uAtClientReplayCaptureStart(atClientHandle, replayCapturePrint,
+                                                   NULL) == 0);
+    U_PORT_TEST_ASSERT(uAtClientReplayCaptureStart(atClientHandle, replayCapturePrint,
+                                                   NULL) < 0);
+    uAtClientUnlock(atClientHandle);
+    for (size_t y = 0; y < U_AT_CLIENT_TEST_REPLAY_NUM_COMMANDS; y++) {
+        uAtClientLock(atClientHandle);
+        uAtClientCommandStart(atClientHandle, "AT+UTSTP=");
+        uAtClientWriteInt(atClientHandle, (int32_t) y);
+        uAtClientCommandStop(atClientHandle);
+        uAtClientResponseStart(atClientHandle, "+UTSTP:");
+        uAtClientReadInt(atClientHandle);
+        uAtClientResponseStop(atClientHandle);
+        if (uAtClientUnlock(atClientHandle) < 0) {
+            numErrors++;
+        }
+    }
+    uAtClientLock(atClientHandle);
+    uAtClientReplayCaptureStop(atClientHandle);
+    uAtClientUnlock(atClientHandle);
+    U_TEST_PRINT_LINE("captured %d byte(s) of transcript.", (int) gReplayCaptureLength);
+    uAtClientRemove(atClientHandle);
+    uDeviceSerialDelete(pDeviceSerial);
+
+    // Play the capture back
+    x = uAtClientReplayTranscriptParse(gReplayCapture, gReplayCaptureLength,
+                                       &transcript);
+    U_PORT_TEST_ASSERT(x >= U_AT_CLIENT_TEST_REPLAY_NUM_COMMANDS * 2);
+    U_PORT_TEST_ASSERT(uAtClientReplayRun(&transcript, false, &results) == 0);
+    U_PORT_TEST_ASSERT(results.numCommands == U_AT_CLIENT_TEST_REPLAY_NUM_COMMANDS);
+    U_PORT_TEST_ASSERT(results.numDeviceErrors == (size_t) numErrors);
+    U_PORT_TEST_ASSERT(results.numMismatches == 0);
+    uAtClientReplayResultsFree(&results);
+    uAtClientReplayTranscriptFree(&transcript);
+
+    uAtClientDeinit();
+    uPortDeinit();
+
+    // Check for resource leaks
+    uTestUtilResourceCheck(U_TEST_PREFIX, NULL, true);
+    resourceCount = uTestUtilGetDynamicResourceCount() - resourceCount;
+    U_TEST_PRINT_LINE("we have leaked %d resources(s).", resourceCount);
+    U_PORT_TEST_ASSERT(resourceCount <= 0);
+}
+
 #if (U_CFG_TEST_UART_A >= 0)
 /** Add an AT client then try getting and setting all of the
  * configuration items.  Requires one UART with no
@@ -125,8 +125,6 @@
  * VARIABLES
  * -------------------------------------------------------------- */
 
-#if (U_CFG_TEST_UART_A >= 0) && (U_CFG_TEST_UART_B >= 0)
-
 /** A URC consisting of a single int32_t, to be referenced in
  * gAtClientTestSet1 or gAtClientTestSet2.
  */
@@ -186,6 +184,8 @@ static const uAtClientTestResponseLine_t gAtClientUrc5 = {"+URC5:", 5,
     }
 };
 
+#if (U_CFG_TEST_UART_A >= 0) && (U_CFG_TEST_UART_B >= 0)
+
 /** Parameters for skip params test, first iteration,
  * to be referenced in gAtClientTestSet2.
  */
@@ -1110,9 +1110,9 @@ static int32_t handleMiscUseLast(uAtClientHandle_t atClientHandle,
  * EXTERNED VARIABLES: gAtClientTestSet1 AND gAtClientTestSet2
  * -------------------------------------------------------------- */
 
-#if (U_CFG_TEST_UART_A >= 0) && (U_CFG_TEST_UART_B >= 0)
-
-/** Loopback test data for the AT client, requires two UARTs.
+/** Loopback test data for the AT client, requires two UARTs,
+ * though the responses are also replayed from memory by the
+ * atClientParseRate test.
  * NOTE: if you change the number of references to URCs here then
  * don't forget to change U_AT_CLIENT_TEST_NUM_URCS_SET_1 to match.
  */
@@ -1864,6 +1864,8 @@ const uAtClientTestCommandResponse_t gAtClientTestSet1[] = {
  */
 const size_t gAtClientTestSetSize1 = sizeof(gAtClientTestSet1) / sizeof(gAtClientTestSet1[0]);
 
+#if (U_CFG_TEST_UART_A >= 0) && (U_CFG_TEST_UART_B >= 0)
+
 /** Echo test data for the AT client, bringing together the
  * gAtClientTestEcho* items defined above; requires two UARTs.
  * NOTE: if you change the number of references to URCs here then
@@ -205,9 +205,9 @@ typedef struct {
  * VARIABLES
  * -------------------------------------------------------------- */
 
-#if (U_CFG_TEST_UART_A >= 0) && (U_CFG_TEST_UART_B >= 0)
-
-/** Loopback test data for the AT client, requires two UARTs.
+/** Loopback test data for the AT client, requires two UARTs,
+ * though the responses are also replayed from memory by the
+ * atClientParseRate test.
  */
 extern const uAtClientTestCommandResponse_t gAtClientTestSet1[];
 
@@ -216,6 +216,8 @@ extern const uAtClientTestCommandResponse_t gAtClientTestSet1[];
  */
 extern const size_t gAtClientTestSetSize1;
 
+#if (U_CFG_TEST_UART_A >= 0) && (U_CFG_TEST_UART_B >= 0)
+
 /** Echo test data for the AT client, requires two UARTs.
  */
 extern const uAtClientTestEcho_t gAtClientTestSet2[];
@@ -56,10 +56,75 @@ extern "C" {
  */
 #define U_SPARTN_MESSAGE_LENGTH_MAX_BYTES (4 + 8 + 1024 + 64 + 4)
 
+/** The maximum length of a SPARTN message header: FRAME START plus
+ * the longest PAYLOAD DESCRIPTION (i.e. 32-bit GNSS time tag and
+ * ENCRYPT/AUTH).
+ */
+#define U_SPARTN_HEADER_LENGTH_MAX_BYTES (4 + 8)
+
 /* ----------------------------------------------------------------
  * TYPES
  * -------------------------------------------------------------- */
 
+/** A SPARTN message, as returned by uSpartnStreamFeed().
+ */
+typedef struct {
+    const char *pMessage;        /**< the whole message, TF001 to TF018,
+                                      NULL if no message was found; this
+                                      points either into the data passed
+                                      to uSpartnStreamFeed() or, where the
+                                      message was split across calls,
+                                      into the buffer passed to
+                                      uSpartnStreamInit(), and is valid
+                                      until the next call to
+                                      uSpartnStreamFeed(). */
+    size_t messageLength;        /**< the length of the whole message. */
+    const char *pPayload;        /**< the payload (TF016), inside
+                                      pMessage; still encrypted if
+                                      encrypted is true. */
+    size_t payloadLength;        /**< the length of the payload (TF003). */
+    uint32_t timeTag;            /**< the GNSS time tag (TF009), 16 or
+                                      32 bits long, see timeTag32. */
+    uint8_t type;                /**< the message type (TF002). */
+    uint8_t subtype;             /**< the message sub-type (TF007). */
+    uint8_t solutionId;          /**< the solution ID (TF010). */
+    uint8_t solutionProcessorId; /**< the solution processor ID (TF011). */
+    bool timeTag32;              /**< true if the GNSS time tag is
+                                      32 bits long (TF008). */
+    bool encrypted;              /**< true if the message is encrypted
+                                      and authenticated (TF004). */
+} uSpartnMessage_t;
+
+/** The state of a SPARTN message candidate, as checked by
+ * uSpartnCandidateFeed(): set it to all zero when a candidate
+ * begins.  count and length may be read, e.g. to give up on a
+ * candidate that would be too long, and, once a candidate has
+ * completed, so may the header; otherwise the contents should
+ * be treated as private.
+ */
+typedef struct {
+    size_t count;         /**< the number of bytes of the candidate seen. */
+    size_t headerLength;  /**< the length of the header once known, else 0. */
+    size_t length;        /**< the length of the candidate once known, else 0. */
+    size_t crcOffset;     /**< the offset of the message CRC once known. */
+    uint32_t crc;         /**< the running message CRC. */
+    uint8_t crcType;      /**< the message CRC type, a #uSpartnCrcType_t. */
+    uint8_t header[U_SPARTN_HEADER_LENGTH_MAX_BYTES]; /**< the header so far. */
+} uSpartnCandidate_t;
+
+/** The state of a SPARTN stream decoder: the contents should be
+ * treated as private, they are only exposed so that a stream decoder
+ * can be declared statically or on the stack.
+ */
+typedef struct {
+    uSpartnCandidate_t candidate;
+    /* Stream state. */
+    char *pBuffer;
+    size_t bufferLength;  /**< bytes of the candidate in pBuffer. */
+    size_t pendingOffset; /**< if non-zero, bytes in pBuffer from here
+                               must be looked at before any new data. */
+} uSpartnStream_t;
+
 /* ----------------------------------------------------------------
  * PUBLIC FUNCTIONS
  * -------------------------------------------------------------- */
@@ -145,6 +210,105 @@ int32_t uSpartnDetect(const char *pBuffer, size_t bufferLengthBytes,
 int32_t uSpartnValidate(const char *pBuffer, size_t bufferLengthBytes,
                         const char **ppMessage);
 
+/** Check a SPARTN message candidate a piece at a time, without
+ * keeping any of it: this is the step on which the stream decoder
+ * is built and is exposed for code that finds SPARTN messages among
+ * other things, e.g. the GNSS framer, and so has its own buffering.
+ * The first byte passed for a candidate must be the preamble (TF001,
+ * 0x73), with the candidate set to all zero; thereafter pass
+ * the bytes that follow, in pieces of any size, until a value other
+ * than #U_ERROR_COMMON_TIMEOUT is returned.  The frame CRC is checked
+ * as soon as the first four bytes have arrived and the message CRC
+ * is calculated as the data arrives, so each byte is looked at once.
+ *
+ * @param[in,out] pCandidate a pointer to the candidate; cannot be NULL.
+ * @param[in] pData          the next piece of the candidate; may be
+ *                           NULL if length is zero.
+ * @param length             the number of bytes at pData.
+ * @return                   if the candidate is a valid SPARTN message,
+ *                           which has completed within pData, the
+ *                           number of bytes of pData that completed it
+ *                           (the length of the whole message is then
+ *                           in the length field of pCandidate), else
+ *                           #U_ERROR_COMMON_TIMEOUT if more data is
+ *                           needed, #U_ERROR_COMMON_NOT_FOUND if the
+ *                           candidate is not a valid SPARTN message or
+ *                           another negative error code.
+ */
+int32_t uSpartnCandidateFeed(uSpartnCandidate_t *pCandidate, const char *pData,
+                             size_t length);
+
+/** Initialise a SPARTN stream decoder.  Where uSpartnValidate()
+ * needs a whole message in one buffer, the stream decoder can be
+ * given data in chunks of any size, e.g. as they arrive over MQTT
+ * or L-band, and returns each valid message as it completes: the
+ * frame CRC is checked as soon as the first four bytes of a message
+ * have arrived and the message CRC is calculated as the data arrives,
+ * so no data is looked at twice unless what looked like the start
+ * of a message turns out not to be.  A message that arrives entirely
+ * within one chunk is not copied, the decoder returns a pointer to
+ * it in the chunk; the bytes of a message that is split across chunks
+ * are copied, once, into the buffer given here.  Either way the
+ * message may be passed straight on, e.g. to a GNSS chip with
+ * uGnssMsgSend().  A stream decoder needs no resources of its own
+ * and so there is no "deinit"; it may be re-initialised at any time.
+ *
+ * @param[out] pStream  a pointer to the stream decoder; cannot be NULL.
+ * @param[in] pBuffer   a buffer for messages that are split across
+ *                      chunks, must remain valid while the stream
+ *                      decoder is in use; cannot be NULL.
+ * @param bufferSize    the number of bytes at pBuffer, must be at
+ *                      least #U_SPARTN_MESSAGE_LENGTH_MAX_BYTES.
+ * @return              zero on success else negative error code.
+ */
+int32_t uSpartnStreamInit(uSpartnStream_t *pStream, char *pBuffer,
+                          size_t bufferSize);
+
+/** Forget any partial message, e.g. because the next data will not
+ * follow on from the last (a reconnected socket, a change of L-band
+ * frequency).
+ *
+ * @param[in,out] pStream a pointer to the stream decoder; cannot be NULL.
+ */
+void uSpartnStreamReset(uSpartnStream_t *pStream);
+
+/** Feed a chunk of data to a SPARTN stream decoder.  The data is
+ * consumed up to and including the end of the first valid message
+ * that completes, which is returned in pMessage, or all of it if no
+ * message completes; call this function again with the remaining
+ * data until there is none left and no message is returned, for
+ * instance:
+ *
+ * ```
+ * uSpartnMessage_t message;
+ * int32_t x;
+ *
+ * do {
+ *     x = uSpartnStreamFeed(&stream, pData, length, &message);
+ *     if (message.pMessage != NULL) {
+ *         // Do something with the message here
+ *     }
+ *     pData += x;
+ *     length -= x;
+ * } while ((length > 0) || (message.pMessage != NULL));
+ * ```
+ *
+ * Bytes that are not part of a valid message are skipped.
+ *
+ * @param[in,out] pStream a pointer to the stream decoder; cannot be NULL.
+ * @param[in] pData       the chunk of data; may be NULL if length is zero.
+ * @param length          the number of bytes at pData.
+ * @param[out] pMessage   a place to put the message; cannot be NULL.
+ *                        The pMessage field is set to NULL if no message
+ *                        was completed.
+ * @return                the number of bytes of pData consumed, which
+ *                        may be zero if a message was returned from
+ *                        data already taken in, else negative error
+ *                        code.
+ */
+int32_t uSpartnStreamFeed(uSpartnStream_t *pStream, const char *pData,
+                          size_t length, uSpartnMessage_t *pMessage);
+
 #ifdef __cplusplus
 }
 #endif
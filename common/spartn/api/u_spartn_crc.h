@@ -110,6 +110,23 @@ uint32_t uSpartnCrc24(const char *pData, size_t size);
  */
 uint32_t uSpartnCrc32(const char *pData, size_t size);
 
+/** Add a block of data to a running CRC of the given type, allowing
+ * the CRC of a message that arrives in pieces to be calculated as
+ * it arrives.  Start with a crc of zero: for instance
+ * uSpartnCrcUpdate(U_SPARTN_CRC_TYPE_24, 0, pData, size) returns
+ * the same value as uSpartnCrc24(pData, size), and feeding the
+ * result back in with the next block continues the calculation.
+ *
+ * @param type   the CRC type, #U_SPARTN_CRC_TYPE_4 to
+ *               #U_SPARTN_CRC_TYPE_32.
+ * @param crc    the CRC so far, zero for the first block.
+ * @param pData  a pointer to the data to be added.
+ * @param size   the number of bytes pointed to by pData.
+ * @return       the CRC, including the data at pData.
+ */
+uint32_t uSpartnCrcUpdate(uSpartnCrcType_t type, uint32_t crc,
+                          const char *pData, size_t size);
+
 #ifdef __cplusplus
 }
 #endif
@@ -93,7 +93,7 @@
 #include "stddef.h"    // NULL, size_t etc.
 #include "stdint.h"    // int32_t etc.
 #include "stdbool.h"
-#include "string.h"    // memcpy()
+#include "string.h"    // memcpy(), memmove(), memset(), memchr()
 
 #include "u_error_common.h"
 
@@ -110,6 +110,15 @@
  */
 #define U_SPARTN_HEADER_LENGTH_MIN_BYTES (4 + 4)
 
+/** The length of the FRAME START part of a SPARTN message header,
+ * after which the frame CRC (TF006) can be checked.
+ */
+#define U_SPARTN_FRAME_START_LENGTH_BYTES 4
+
+/** The SPARTN preamble (TF001).
+ */
+#define U_SPARTN_PREAMBLE 0x73
+
 /* ----------------------------------------------------------------
  * TYPES
  * -------------------------------------------------------------- */
@@ -118,6 +127,12 @@
  * VARIABLES
  * -------------------------------------------------------------- */
 
+/** The lengths of the AUTHENTICATION field (TF017), indexed by the
+ * authentication length field (TF015); values of TF015 beyond the
+ * end of this table are not supported.
+ */
+static const uint8_t gAuthLengthBytes[] = {64 / 8, 96 / 8, 128 / 8, 256 / 8, 512 / 8};
+
 /* ----------------------------------------------------------------
  * STATIC FUNCTIONS
  * -------------------------------------------------------------- */
@@ -272,6 +287,218 @@ static int32_t decodeHeader(const char *pBuffer, size_t bufferLengthBytes,
     return sizeOrErrorCode;
 }
 
+// Reset the candidate part of a stream decoder.
+static void streamCandidateReset(uSpartnStream_t *pStream)
+{
+    memset(&(pStream->candidate), 0, sizeof(pStream->candidate));
+}
+
+// Work out the length of a candidate once the last byte of its
+// header has been seen, returning false if the message is not
+// supported.
+static bool candidateLength(uSpartnCandidate_t *pCandidate, uint8_t lastHeaderByte)
+{
+    bool supported = true;
+    const uint8_t *pHeader = pCandidate->header;
+    size_t authLength = 0;
+
+    pCandidate->crcOffset = pCandidate->headerLength;
+    // Add the 10-bit payload length (TF003)
+    pCandidate->crcOffset += ((((size_t) pHeader[1]) & 0x01) << 9) +
+                             (((size_t) pHeader[2]) << 1) +
+                             ((((size_t) pHeader[3]) & 0x80) >> 7);
+    if ((pHeader[3] & 0x40) && (((lastHeaderByte & 0x38) >> 3) > 1)) {
+        // Encrypted (TF004) and with an authentication indicator
+        // (TF014) that means there is an AUTHENTICATION field, the
+        // length of which is given by TF015
+        if ((lastHeaderByte & 0x07) < sizeof(gAuthLengthBytes)) {
+            authLength = gAuthLengthBytes[lastHeaderByte & 0x07];
+        } else {
+            supported = false;
+        }
+    }
+    pCandidate->crcOffset += authLength;
+    pCandidate->length = pCandidate->crcOffset + pCandidate->crcType + 1;
+
+    return supported;
+}
+
+// Continue a candidate, the first byte of which is the preamble;
+// returns U_ERROR_COMMON_TIMEOUT if more data is needed,
+// U_ERROR_COMMON_NOT_FOUND if the candidate is not a valid
+// message, else the number of bytes of pByte that completed it.
+static int32_t candidateFeed(uSpartnCandidate_t *pCandidate, const uint8_t *pByte,
+                             size_t length)
+{
+    int32_t errorCodeOrLength = (int32_t) U_ERROR_COMMON_TIMEOUT;
+    uint8_t *pHeader = pCandidate->header;
+    uint8_t frameStart[U_SPARTN_FRAME_START_LENGTH_BYTES - 1];
+    size_t x = 0;
+    size_t y;
+    uint8_t by;
+
+    while ((x < length) && (errorCodeOrLength == (int32_t) U_ERROR_COMMON_TIMEOUT)) {
+        if ((pCandidate->length > 0) && (pCandidate->count < pCandidate->crcOffset)) {
+            // Length known, up to the message CRC: run the CRC
+            // over as much as is here
+            y = pCandidate->crcOffset - pCandidate->count;
+            if (y > length - x) {
+                y = length - x;
+            }
+            pCandidate->crc = uSpartnCrcUpdate((uSpartnCrcType_t) pCandidate->crcType,
+                                               pCandidate->crc, (const char *) pByte + x, y);
+            pCandidate->count += y;
+            x += y;
+        } else {
+            by = pByte[x];
+            if (pCandidate->length == 0) {
+                // In the header, which is never longer than
+                // U_SPARTN_HEADER_LENGTH_MAX_BYTES
+                pHeader[pCandidate->count] = by;
+                if (pCandidate->count == U_SPARTN_FRAME_START_LENGTH_BYTES - 1) {
+                    // Have all of the FRAME START: check the frame
+                    // CRC (TF006), which is over TF002 to TF005 with
+                    // zero-fill where TF006 itself sits
+                    frameStart[0] = pHeader[1];
+                    frameStart[1] = pHeader[2];
+                    frameStart[2] = by & 0xF0;
+                    if (uSpartnCrc4((const char *) frameStart, sizeof(frameStart)) != (by & 0x0F)) {
+                        errorCodeOrLength = (int32_t) U_ERROR_COMMON_NOT_FOUND;
+                    } else {
+                        // The message CRC type (TF005), the values of
+                        // which match uSpartnCrcType_t
+                        pCandidate->crcType = (uint8_t) ((by & 0x30) >> 4);
+                    }
+                } else if (pCandidate->count >= U_SPARTN_FRAME_START_LENGTH_BYTES) {
+                    if (pCandidate->count == U_SPARTN_FRAME_START_LENGTH_BYTES) {
+                        // The header is longer if the GNSS time tag is
+                        // 32-bit (TF008) and if the message is
+                        // encrypted (TF004)
+                        pCandidate->headerLength = U_SPARTN_HEADER_LENGTH_MIN_BYTES;
+                        if (by & 0x08) {
+                            pCandidate->headerLength += 2;
+                        }
+                        if (pHeader[3] & 0x40) {
+                            pCandidate->headerLength += 2;
+                        }
+                    }
+                    if (pCandidate->count + 1 == pCandidate->headerLength) {
+                        if (candidateLength(pCandidate, by)) {
+                            // Start the message CRC, which is over
+                            // all but the preamble
+                            pCandidate->crc = uSpartnCrcUpdate((uSpartnCrcType_t) pCandidate->crcType,
+                                                               0, (const char *) pHeader + 1,
+                                                               pCandidate->headerLength - 1);
+                        } else {
+                            errorCodeOrLength = (int32_t) U_ERROR_COMMON_NOT_FOUND;
+                        }
+                    }
+                }
+            } else {
+                // The message CRC, most significant byte first
+                y = pCandidate->length - 1 - pCandidate->count;
+                if (by != (uint8_t) (pCandidate->crc >> (8 * y))) {
+                    errorCodeOrLength = (int32_t) U_ERROR_COMMON_NOT_FOUND;
+                } else if (y == 0) {
+                    errorCodeOrLength = (int32_t) (x + 1);
+                }
+            }
+            pCandidate->count++;
+            x++;
+        }
+    }
+
+    return errorCodeOrLength;
+}
+
+// Fill in a message from the header of the completed candidate.
+static void streamMessage(const uSpartnStream_t *pStream, const char *pData,
+                          uSpartnMessage_t *pMessage)
+{
+    const uSpartnCandidate_t *pCandidate = &(pStream->candidate);
+    const uint8_t *pHeader = pCandidate->header;
+    uint64_t bits = 0;
+    size_t timeTagLengthBits = 16;
+
+    pMessage->pMessage = pData;
+    pMessage->messageLength = pCandidate->length;
+    pMessage->pPayload = pData + pCandidate->headerLength;
+    // The 10-bit payload length (TF003): there may be an
+    // AUTHENTICATION field between the payload and the CRC
+    pMessage->payloadLength = ((((size_t) pHeader[1]) & 0x01) << 9) +
+                              (((size_t) pHeader[2]) << 1) +
+                              ((((size_t) pHeader[3]) & 0x80) >> 7);
+    pMessage->type = pHeader[1] >> 1;
+    pMessage->encrypted = ((pHeader[3] & 0x40) != 0);
+    // The PAYLOAD DESCRIPTION is not byte-aligned: get it into a
+    // 64-bit word, MSB first, which holds all of it; bytes beyond
+    // the end of the header are zero
+    for (size_t x = U_SPARTN_FRAME_START_LENGTH_BYTES; x < sizeof(pCandidate->header); x++) {
+        bits = (bits << 8) | pHeader[x];
+    }
+    // MST4 (TF007), TT1 (TF008), T16/32 (TF009), SID7 (TF010), PID4 (TF011)
+    pMessage->subtype = (uint8_t) (bits >> 60);
+    pMessage->timeTag32 = (((bits >> 59) & 0x01) != 0);
+    if (pMessage->timeTag32) {
+        timeTagLengthBits = 32;
+    }
+    bits <<= 5;
+    pMessage->timeTag = (uint32_t) (bits >> (64 - timeTagLengthBits));
+    bits <<= timeTagLengthBits;
+    pMessage->solutionId = (uint8_t) (bits >> (64 - 7));
+    pMessage->solutionProcessorId = (uint8_t) ((bits >> (64 - 7 - 4)) & 0x0F);
+}
+
+// Look again at the bytes left in the buffer from a candidate that
+// turned out not to be a message; returns true if a message was found.
+static bool streamPending(uSpartnStream_t *pStream, uSpartnMessage_t *pMessage)
+{
+    bool found = false;
+    const char *pPreamble;
+    size_t x;
+    int32_t errorCodeOrLength;
+
+    pPreamble = (const char *) memchr(pStream->pBuffer + pStream->pendingOffset,
+                                      U_SPARTN_PREAMBLE,
+                                      pStream->bufferLength - pStream->pendingOffset);
+    pStream->pendingOffset = 0;
+    if (pPreamble != NULL) {
+        // Move the new candidate to the start of the buffer
+        x = pPreamble - pStream->pBuffer;
+        pStream->bufferLength -= x;
+        memmove(pStream->pBuffer, pPreamble, pStream->bufferLength);
+        errorCodeOrLength = candidateFeed(&(pStream->candidate),
+                                          (const uint8_t *) pStream->pBuffer,
+                                          pStream->bufferLength);
+        if (errorCodeOrLength > 0) {
+            // A message entirely within the buffer; anything after
+            // it is still pending
+            found = true;
+            streamMessage(pStream, pStream->pBuffer, pMessage);
+            streamCandidateReset(pStream);
+            if ((size_t) errorCodeOrLength < pStream->bufferLength) {
+                pStream->pendingOffset = (size_t) errorCodeOrLength;
+            } else {
+                pStream->bufferLength = 0;
+            }
+        } else if (errorCodeOrLength == (int32_t) U_ERROR_COMMON_NOT_FOUND) {
+            // Not this one either: try from the next byte
+            streamCandidateReset(pStream);
+            if (pStream->bufferLength > 1) {
+                pStream->pendingOffset = 1;
+            } else {
+                pStream->bufferLength = 0;
+            }
+        }
+        // Otherwise the candidate continues into new data and
+        // the buffer holds all of it so far
+    } else {
+        pStream->bufferLength = 0;
+    }
+
+    return found;
+}
+
 /* ----------------------------------------------------------------
  * PUBLIC FUNCTIONS
  * -------------------------------------------------------------- */
@@ -352,4 +579,123 @@ int32_t uSpartnValidate(const char *pBuffer, size_t bufferLengthBytes,
     return sizeOrErrorCode;
 }
 
+// Check a SPARTN message candidate a piece at a time.
+int32_t uSpartnCandidateFeed(uSpartnCandidate_t *pCandidate, const char *pData,
+                             size_t length)
+{
+    int32_t errorCodeOrLength = (int32_t) U_ERROR_COMMON_INVALID_PARAMETER;
+
+    if ((pCandidate != NULL) && ((pData != NULL) || (length == 0))) {
+        errorCodeOrLength = candidateFeed(pCandidate, (const uint8_t *) pData, length);
+    }
+
+    return errorCodeOrLength;
+}
+
+// Initialise a SPARTN stream decoder.
+int32_t uSpartnStreamInit(uSpartnStream_t *pStream, char *pBuffer,
+                          size_t bufferSize)
+{
+    int32_t errorCode = (int32_t) U_ERROR_COMMON_INVALID_PARAMETER;
+
+    if ((pStream != NULL) && (pBuffer != NULL) &&
+        (bufferSize >= U_SPARTN_MESSAGE_LENGTH_MAX_BYTES)) {
+        memset(pStream, 0, sizeof(*pStream));
+        pStream->pBuffer = pBuffer;
+        errorCode = (int32_t) U_ERROR_COMMON_SUCCESS;
+    }
+
+    return errorCode;
+}
+
+// Forget any partial message.
+void uSpartnStreamReset(uSpartnStream_t *pStream)
+{
+    if (pStream != NULL) {
+        streamCandidateReset(pStream);
+        pStream->bufferLength = 0;
+        pStream->pendingOffset = 0;
+    }
+}
+
+// Feed a chunk of data to a SPARTN stream decoder.
+int32_t uSpartnStreamFeed(uSpartnStream_t *pStream, const char *pData,
+                          size_t length, uSpartnMessage_t *pMessage)
+{
+    int32_t errorCodeOrConsumed = (int32_t) U_ERROR_COMMON_INVALID_PARAMETER;
+    const char *pPreamble;
+    bool found = false;
+    size_t consumed = 0;
+    size_t x;
+    int32_t y;
+
+    if ((pStream != NULL) && (pStream->pBuffer != NULL) && (pMessage != NULL) &&
+        ((pData != NULL) || (length == 0))) {
+        memset(pMessage, 0, sizeof(*pMessage));
+        while (!found && ((pStream->pendingOffset > 0) || (consumed < length))) {
+            if (pStream->pendingOffset > 0) {
+                // Bytes taken in earlier must be looked at again first
+                found = streamPending(pStream, pMessage);
+            } else if (pStream->candidate.count > 0) {
+                // Continue a candidate begun in an earlier call, all
+                // of which is in the buffer: a message is never
+                // longer than the buffer
+                y = candidateFeed(&(pStream->candidate), (const uint8_t *) pData + consumed,
+                                  length - consumed);
+                if (y > 0) {
+                    found = true;
+                    memcpy(pStream->pBuffer + pStream->bufferLength, pData + consumed, y);
+                    streamMessage(pStream, pStream->pBuffer, pMessage);
+                    consumed += y;
+                    streamCandidateReset(pStream);
+                    pStream->bufferLength = 0;
+                } else if (y == (int32_t) U_ERROR_COMMON_TIMEOUT) {
+                    memcpy(pStream->pBuffer + pStream->bufferLength, pData + consumed,
+                           length - consumed);
+                    pStream->bufferLength = pStream->candidate.count;
+                    consumed = length;
+                } else {
+                    // Not a message after all: look again from its
+                    // second byte, then go on with the new data, none
+                    // of which is yet consumed
+                    streamCandidateReset(pStream);
+                    if (pStream->bufferLength > 1) {
+                        pStream->pendingOffset = 1;
+                    } else {
+                        pStream->bufferLength = 0;
+                    }
+                }
+            } else {
+                // Look for the start of a message
+                pPreamble = (const char *) memchr(pData + consumed, U_SPARTN_PREAMBLE,
+                                                  length - consumed);
+                consumed = length;
+                if (pPreamble != NULL) {
+                    x = pPreamble - pData;
+                    y = candidateFeed(&(pStream->candidate), (const uint8_t *) pPreamble,
+                                      length - x);
+                    if (y > 0) {
+                        // All in this chunk: no need to copy it
+                        found = true;
+                        streamMessage(pStream, pPreamble, pMessage);
+                        consumed = x + y;
+                        streamCandidateReset(pStream);
+                    } else if (y == (int32_t) U_ERROR_COMMON_TIMEOUT) {
+                        // Runs off the end of the chunk: keep what
+                        // there is of it
+                        memcpy(pStream->pBuffer, pPreamble, length - x);
+                        pStream->bufferLength = length - x;
+                    } else {
+                        streamCandidateReset(pStream);
+                        consumed = x + 1;
+                    }
+                }
+            }
+        }
+        errorCodeOrConsumed = (int32_t) consumed;
+    }
+
+    return errorCodeOrConsumed;
+}
+
 // End of file
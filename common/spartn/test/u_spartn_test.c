@@ -35,7 +35,7 @@
 #include "stdint.h"    // int32_t etc.
 #include "stdbool.h"
 #include "stdlib.h"    // rand()
-#include "string.h"    // memcmp()/memset()
+#include "string.h"    // memcmp()/memset()/memcpy()/memmove()
 
 #include "u_cfg_sw.h"
 #include "u_cfg_os_platform_specific.h"
@@ -82,6 +82,27 @@
 # define U_SPARTN_TEST_BUFFER_SIZE_BYTES (U_SPARTN_MESSAGE_LENGTH_MAX_BYTES + U_SPARTN_TEST_BUFFER_EXTRA_SIZE_BYTES)
 #endif
 
+#ifndef U_SPARTN_TEST_STREAM_CHUNK_MAX_BYTES
+/** The largest chunk to give to the stream decoder in the
+ * spartnStream test.
+ */
+# define U_SPARTN_TEST_STREAM_CHUNK_MAX_BYTES 100
+#endif
+
+#ifndef U_SPARTN_TEST_STREAM_BENCHMARK_CHUNK_BYTES
+/** The size of chunk to use in spartnStreamBenchmark, about
+ * what might arrive in one go from an L-band receiver.
+ */
+# define U_SPARTN_TEST_STREAM_BENCHMARK_CHUNK_BYTES 32
+#endif
+
+#ifndef U_SPARTN_TEST_STREAM_BENCHMARK_NUM_PASSES
+/** The number of times to pass the test data through in
+ * spartnStreamBenchmark.
+ */
+# define U_SPARTN_TEST_STREAM_BENCHMARK_NUM_PASSES 20
+#endif
+
 /* ----------------------------------------------------------------
  * TYPES
  * -------------------------------------------------------------- */
@@ -224,6 +245,42 @@ static const char gpSpartnMessage[] = {
 
 #endif // __ZEPHYR__
 
+/** An encrypted SPARTN message with a 32-bit GNSS time tag, a
+ * 37-byte payload, a 256-bit AUTHENTICATION field (AI3 = 2,
+ * AL3 = 3) and a CRC-16: gUSpartnTestData contains no message
+ * with an AUTHENTICATION field.
+ */
+static const char gSpartnMessageAuth[] = {
+    0x73, 0x02, 0x12, 0xD8, 0x28, 0x91, 0xA2, 0xB3, 0xC0, 0x53, 0x12, 0x53, 0xDC, 0x04, 0x65, 0xAA,
+    0x1F, 0xAD, 0x1D, 0x5A, 0xDA, 0xE5, 0xAC, 0x1B, 0x1E, 0x5F, 0x13, 0x70, 0x79, 0x6C, 0xFD, 0x10,
+    0xFF, 0x19, 0xAF, 0x60, 0x1D, 0x04, 0xAC, 0xB4, 0x1D, 0x02, 0x2B, 0x46, 0x78, 0x73, 0x3A, 0xF2,
+    0xDF, 0x5F, 0xAE, 0xB7, 0x08, 0x59, 0xD1, 0xEE, 0x39, 0x10, 0xCB, 0x48, 0x95, 0xB5, 0xCC, 0x89,
+    0x29, 0x11, 0xFF, 0x06, 0xB6, 0x62, 0x2E, 0xDF, 0x3C, 0xF9, 0x35, 0xFD, 0x4B, 0x94, 0x28, 0xCA,
+    0x09, 0xB6, 0xBF
+};
+
+/** The lengths of the AUTHENTICATION field (TF017) in bits, indexed
+ * by the authentication length field (TF015).
+ */
+static const size_t gAuthLengthBits[] = {64, 96, 128, 256, 512};
+
+/** The offsets of the messages in gUSpartnTestData, found
+ * using uSpartnValidate().
+ */
+static size_t *gpMessageOffset = NULL;
+
+/** Buffer for the stream decoder.
+ */
+static char *gpStreamBuffer = NULL;
+
+/** Buffer for test data mixed with rubbish.
+ */
+static char *gpData = NULL;
+
+/** Seed for testRandom().
+ */
+static uint32_t gRandom = 0;
+
 /* ----------------------------------------------------------------
  * STATIC FUNCTIONS
  * -------------------------------------------------------------- */
@@ -249,6 +306,100 @@ static crc24 crc_octets(unsigned char *octets, size_t len)
     return crc & 0xFFFFFFL;
 }
 
+// A pseudo-random number that is the same on all platforms.
+static uint32_t testRandom()
+{
+    gRandom = (gRandom * 1103515245UL + 12345) & 0x7fffffff;
+    return gRandom >> 16;
+}
+
+// Get a field of a SPARTN message a bit at a time.
+static uint32_t bitsGet(const char *pData, size_t offsetBits, size_t numBits)
+{
+    uint32_t value = 0;
+
+    for (size_t x = offsetBits; x < offsetBits + numBits; x++) {
+        value = (value << 1) | ((((uint8_t) * (pData + (x >> 3))) >> (7 - (x & 7))) & 1);
+    }
+
+    return value;
+}
+
+// Find the offsets of the messages in gUSpartnTestData.
+static void messageOffsetsGet()
+{
+    const char *pData = gUSpartnTestData;
+    const char *pMessage;
+    int32_t messageLength;
+    size_t count = 0;
+
+    gpMessageOffset = (size_t *) pUPortMalloc(gUSpartnTestDataNumMessages *
+                                              sizeof(*gpMessageOffset));
+    U_PORT_TEST_ASSERT(gpMessageOffset != NULL);
+    do {
+        messageLength = uSpartnValidate(pData, gUSpartnTestDataSize - (pData - gUSpartnTestData),
+                                        &pMessage);
+        if (messageLength > 0) {
+            U_PORT_TEST_ASSERT(count < gUSpartnTestDataNumMessages);
+            gpMessageOffset[count] = pMessage - gUSpartnTestData;
+            count++;
+            pData = pMessage + messageLength;
+        }
+    } while (messageLength > 0);
+    U_PORT_TEST_ASSERT(count == gUSpartnTestDataNumMessages);
+}
+
+// Check a message from the stream decoder against the expected
+// message.
+static void messageCheck(const uSpartnMessage_t *pMessage, const char *pExpected)
+{
+    size_t headerLengthBits = 64;
+    size_t timeTagLengthBits = 16;
+    size_t authLength = 0;
+    size_t authLengthIndex;
+
+    U_PORT_TEST_ASSERT(pMessage->pMessage != NULL);
+    U_PORT_TEST_ASSERT(uSpartnValidate(pExpected, pMessage->messageLength,
+                                       NULL) == (int32_t) pMessage->messageLength);
+    U_PORT_TEST_ASSERT(memcmp(pMessage->pMessage, pExpected, pMessage->messageLength) == 0);
+    // Decode the header fields the slow way
+    U_PORT_TEST_ASSERT(pMessage->type == bitsGet(pExpected, 8, 7));
+    U_PORT_TEST_ASSERT(pMessage->payloadLength == bitsGet(pExpected, 15, 10));
+    U_PORT_TEST_ASSERT(pMessage->encrypted == (bitsGet(pExpected, 25, 1) == 1));
+    U_PORT_TEST_ASSERT(pMessage->subtype == bitsGet(pExpected, 32, 4));
+    U_PORT_TEST_ASSERT(pMessage->timeTag32 == (bitsGet(pExpected, 36, 1) == 1));
+    if (pMessage->timeTag32) {
+        timeTagLengthBits = 32;
+        headerLengthBits += 16;
+    }
+    U_PORT_TEST_ASSERT(pMessage->timeTag == bitsGet(pExpected, 37, timeTagLengthBits));
+    U_PORT_TEST_ASSERT(pMessage->solutionId == bitsGet(pExpected, 37 + timeTagLengthBits, 7));
+    U_PORT_TEST_ASSERT(pMessage->solutionProcessorId == bitsGet(pExpected,
+                                                                44 + timeTagLengthBits, 4));
+    if (pMessage->encrypted) {
+        if (bitsGet(pExpected, headerLengthBits + 10, 3) > 1) {
+            authLengthIndex = bitsGet(pExpected, headerLengthBits + 13, 3);
+            U_PORT_TEST_ASSERT(authLengthIndex < sizeof(gAuthLengthBits) / sizeof(gAuthLengthBits[0]));
+            authLength = gAuthLengthBits[authLengthIndex] / 8;
+        }
+        headerLengthBits += 16;
+    }
+    U_PORT_TEST_ASSERT(pMessage->pPayload == pMessage->pMessage + (headerLengthBits / 8));
+    U_PORT_TEST_ASSERT(pMessage->messageLength == (headerLengthBits / 8) + pMessage->payloadLength +
+                       authLength + bitsGet(pExpected, 26, 2) + 1);
+}
+
+// Free the memory used by the stream tests.
+static void streamFree()
+{
+    uPortFree(gpMessageOffset);
+    gpMessageOffset = NULL;
+    uPortFree(gpStreamBuffer);
+    gpStreamBuffer = NULL;
+    uPortFree(gpData);
+    gpData = NULL;
+}
+
 /* ----------------------------------------------------------------
  * PUBLIC FUNCTIONS: TESTS
  * -------------------------------------------------------------- */
@@ -309,6 +460,25 @@ U_PORT_TEST_FUNCTION("[spartn]", "spartnCrc")
     U_TEST_PRINT_LINE("CRC-24: calculated 0x%08x, expected 0x%08x.", calculated, expected);
     U_PORT_TEST_ASSERT(calculated == expected);
 
+    // A CRC calculated in pieces with uSpartnCrcUpdate() must match
+    // the one calculated in one go
+    U_TEST_PRINT_LINE("testing running CRCs.");
+    for (int32_t x = (int32_t) U_SPARTN_CRC_TYPE_8; x <= (int32_t) U_SPARTN_CRC_TYPE_4; x++) {
+        if (x != (int32_t) U_SPARTN_CRC_TYPE_MAX_NUM) {
+            expected = uSpartnCrcUpdate((uSpartnCrcType_t) x, 0, gpInput, sizeof(gpInput));
+            for (size_t y = 0; y <= sizeof(gpInput); y++) {
+                calculated = uSpartnCrcUpdate((uSpartnCrcType_t) x, 0, gpInput, y);
+                calculated = uSpartnCrcUpdate((uSpartnCrcType_t) x, calculated,
+                                              gpInput + y, sizeof(gpInput) - y);
+                U_PORT_TEST_ASSERT(calculated == expected);
+            }
+        }
+    }
+    U_PORT_TEST_ASSERT(uSpartnCrcUpdate(U_SPARTN_CRC_TYPE_24, 0, gpInput,
+                                        sizeof(gpInput)) == uSpartnCrc24(gpInput, sizeof(gpInput)));
+    U_PORT_TEST_ASSERT(uSpartnCrcUpdate(U_SPARTN_CRC_TYPE_32, 0, gpInput,
+                                        sizeof(gpInput)) == uSpartnCrc32(gpInput, sizeof(gpInput)));
+
     // Check for resource leaks
     uTestUtilResourceCheck(U_TEST_PREFIX, NULL, true);
     resourceCount = uTestUtilGetDynamicResourceCount() - resourceCount;
@@ -454,12 +624,330 @@ U_PORT_TEST_FUNCTION("[spartn]", "spartnMessage")
 
 #endif // __ZEPHYR__
 
+/** Test the SPARTN stream decoder, feeding it the test data in
+ * chunks of various sizes, with and without rubbish mixed in, and
+ * the candidate step that it is built on.
+ */
+U_PORT_TEST_FUNCTION("[spartn]", "spartnStream")
+{
+    int32_t resourceCount;
+    uSpartnStream_t stream;
+    uSpartnMessage_t message;
+    uSpartnCandidate_t candidate;
+    const char *pData;
+    size_t length;
+    size_t chunkLength;
+    size_t dataLength;
+    size_t messageLength;
+    size_t count;
+    size_t copied;
+    int32_t x;
+
+    // Whatever called us likely initialised the
+    // port so deinitialise it here to obtain the
+    // correct initial heap size
+    uPortDeinit();
+    resourceCount = uTestUtilGetDynamicResourceCount();
+
+    U_TEST_PRINT_LINE("testing SPARTN stream decoding.");
+
+    messageOffsetsGet();
+    gpStreamBuffer = (char *) pUPortMalloc(U_SPARTN_MESSAGE_LENGTH_MAX_BYTES);
+    U_PORT_TEST_ASSERT(gpStreamBuffer != NULL);
+
+    // Parameter checking
+    U_PORT_TEST_ASSERT(uSpartnStreamInit(NULL, gpStreamBuffer,
+                                         U_SPARTN_MESSAGE_LENGTH_MAX_BYTES) < 0);
+    U_PORT_TEST_ASSERT(uSpartnStreamInit(&stream, NULL, U_SPARTN_MESSAGE_LENGTH_MAX_BYTES) < 0);
+    U_PORT_TEST_ASSERT(uSpartnStreamInit(&stream, gpStreamBuffer,
+                                         U_SPARTN_MESSAGE_LENGTH_MAX_BYTES - 1) < 0);
+    U_PORT_TEST_ASSERT(uSpartnStreamInit(&stream, gpStreamBuffer,
+                                         U_SPARTN_MESSAGE_LENGTH_MAX_BYTES) == 0);
+    U_PORT_TEST_ASSERT(uSpartnStreamFeed(&stream, NULL, 1, &message) < 0);
+    U_PORT_TEST_ASSERT(uSpartnStreamFeed(&stream, gUSpartnTestData, 1, NULL) < 0);
+    U_PORT_TEST_ASSERT(uSpartnStreamFeed(&stream, NULL, 0, &message) == 0);
+    U_PORT_TEST_ASSERT(message.pMessage == NULL);
+
+    // Feed the test data in one go, then a byte at a time, then
+    // in random chunks; chunkLength of zero means random
+    for (size_t pass = 0; pass < 3; pass++) {
+        chunkLength = gUSpartnTestDataSize;
+        if (pass == 1) {
+            chunkLength = 1;
+        } else if (pass == 2) {
+            chunkLength = 0;
+        }
+        uSpartnStreamReset(&stream);
+        pData = gUSpartnTestData;
+        count = 0;
+        copied = 0;
+        while (pData < gUSpartnTestData + gUSpartnTestDataSize) {
+            length = chunkLength;
+            if (length == 0) {
+                length = (testRandom() % U_SPARTN_TEST_STREAM_CHUNK_MAX_BYTES) + 1;
+            }
+            if (length > (size_t) (gUSpartnTestData + gUSpartnTestDataSize - pData)) {
+                length = gUSpartnTestData + gUSpartnTestDataSize - pData;
+            }
+            do {
+                x = uSpartnStreamFeed(&stream, pData, length, &message);
+                U_PORT_TEST_ASSERT(x >= 0);
+                if (message.pMessage != NULL) {
+                    U_PORT_TEST_ASSERT(count < gUSpartnTestDataNumMessages);
+                    messageCheck(&message, gUSpartnTestData + gpMessageOffset[count]);
+                    if (message.pMessage == gpStreamBuffer) {
+                        copied++;
+                    } else {
+                        // Not copied: must be where it is in the test data
+                        U_PORT_TEST_ASSERT(message.pMessage == gUSpartnTestData +
+                                           gpMessageOffset[count]);
+                    }
+                    count++;
+                }
+                pData += x;
+                length -= x;
+            } while ((length > 0) || (message.pMessage != NULL));
+        }
+        U_TEST_PRINT_LINE("%d message(s) found, %d of them copied.", count, copied);
+        U_PORT_TEST_ASSERT(count == gUSpartnTestDataNumMessages);
+        if (pass == 0) {
+            U_PORT_TEST_ASSERT(copied == 0);
+        }
+    }
+
+    // The candidate step on which the stream decoder is built: a
+    // message fed to it a byte at a time completes on its last byte,
+    // a corrupted one does not complete
+    memset(&candidate, 0, sizeof(candidate));
+    U_PORT_TEST_ASSERT(uSpartnCandidateFeed(NULL, gUSpartnTestData, 1) < 0);
+    U_PORT_TEST_ASSERT(uSpartnCandidateFeed(&candidate, NULL, 1) < 0);
+    for (size_t y = 0; y < gUSpartnTestDataNumMessages; y++) {
+        pData = gUSpartnTestData + gpMessageOffset[y];
+        messageLength = (size_t) uSpartnValidate(pData, U_SPARTN_MESSAGE_LENGTH_MAX_BYTES, NULL);
+        memset(&candidate, 0, sizeof(candidate));
+        x = (int32_t) U_ERROR_COMMON_TIMEOUT;
+        for (length = 0; (length < messageLength) && (x == (int32_t) U_ERROR_COMMON_TIMEOUT);
+             length++) {
+            x = uSpartnCandidateFeed(&candidate, pData + length, 1);
+        }
+        U_PORT_TEST_ASSERT(x == 1);
+        U_PORT_TEST_ASSERT(length == messageLength);
+        U_PORT_TEST_ASSERT(candidate.length == messageLength);
+        memcpy(gpStreamBuffer, pData, messageLength);
+        gpStreamBuffer[messageLength - 1] ^= 0x01;
+        memset(&candidate, 0, sizeof(candidate));
+        U_PORT_TEST_ASSERT(uSpartnCandidateFeed(&candidate, gpStreamBuffer,
+                                                messageLength) == (int32_t) U_ERROR_COMMON_NOT_FOUND);
+    }
+
+    // A message with an AUTHENTICATION field, whole and then a
+    // byte at a time
+    U_PORT_TEST_ASSERT(uSpartnValidate(gSpartnMessageAuth, sizeof(gSpartnMessageAuth),
+                                       NULL) == sizeof(gSpartnMessageAuth));
+    for (size_t pass = 0; pass < 2; pass++) {
+        chunkLength = sizeof(gSpartnMessageAuth);
+        if (pass == 1) {
+            chunkLength = 1;
+        }
+        uSpartnStreamReset(&stream);
+        pData = gSpartnMessageAuth;
+        count = 0;
+        while (pData < gSpartnMessageAuth + sizeof(gSpartnMessageAuth)) {
+            length = chunkLength;
+            do {
+                x = uSpartnStreamFeed(&stream, pData, length, &message);
+                U_PORT_TEST_ASSERT(x >= 0);
+                if (message.pMessage != NULL) {
+                    U_PORT_TEST_ASSERT(message.messageLength == sizeof(gSpartnMessageAuth));
+                    messageCheck(&message, gSpartnMessageAuth);
+                    count++;
+                }
+                pData += x;
+                length -= x;
+            } while ((length > 0) || (message.pMessage != NULL));
+        }
+        U_PORT_TEST_ASSERT(count == 1);
+    }
+
+    // Now put rubbish, rich in preambles, and a corrupted copy of
+    // each message before each message: the stream decoder should
+    // find only the real messages
+    gpData = (char *) pUPortMalloc(gUSpartnTestDataSize * 3);
+    U_PORT_TEST_ASSERT(gpData != NULL);
+    dataLength = 0;
+    for (size_t y = 0; y < gUSpartnTestDataNumMessages; y++) {
+        pData = gUSpartnTestData + gpMessageOffset[y];
+        messageLength = (size_t) uSpartnValidate(pData, U_SPARTN_MESSAGE_LENGTH_MAX_BYTES, NULL);
+        length = testRandom() % 20;
+        for (size_t z = 0; z < length; z++) {
+            *(gpData + dataLength) = (char) testRandom();
+            if ((testRandom() & 3) == 0) {
+                *(gpData + dataLength) = 0x73;
+            }
+            dataLength++;
+        }
+        // The corrupted copy, damaged somewhere after the frame CRC,
+        // so that it is not thrown out until its end, and cut
+        // short half of the time
+        memcpy(gpData + dataLength, pData, messageLength);
+        *(gpData + dataLength + 4 + (testRandom() % (messageLength - 4))) ^= 0x10;
+        if ((testRandom() & 1) == 0) {
+            dataLength += messageLength / 2;
+        } else {
+            dataLength += messageLength;
+        }
+        memcpy(gpData + dataLength, pData, messageLength);
+        dataLength += messageLength;
+    }
+    U_PORT_TEST_ASSERT(dataLength <= gUSpartnTestDataSize * 3);
+    uSpartnStreamReset(&stream);
+    pData = gpData;
+    count = 0;
+    while (pData < gpData + dataLength) {
+        length = (testRandom() % U_SPARTN_TEST_STREAM_CHUNK_MAX_BYTES) + 1;
+        if (length > (size_t) (gpData + dataLength - pData)) {
+            length = gpData + dataLength - pData;
+        }
+        do {
+            x = uSpartnStreamFeed(&stream, pData, length, &message);
+            U_PORT_TEST_ASSERT(x >= 0);
+            if (message.pMessage != NULL) {
+                U_PORT_TEST_ASSERT(count < gUSpartnTestDataNumMessages);
+                messageCheck(&message, gUSpartnTestData + gpMessageOffset[count]);
+                count++;
+            }
+            pData += x;
+            length -= x;
+        } while ((length > 0) || (message.pMessage != NULL));
+    }
+    U_TEST_PRINT_LINE("%d message(s) found among %d byte(s) of rubbish.", count,
+                      dataLength - gUSpartnTestDataSize);
+    U_PORT_TEST_ASSERT(count == gUSpartnTestDataNumMessages);
+
+    streamFree();
+
+    // Check for resource leaks
+    uTestUtilResourceCheck(U_TEST_PREFIX, NULL, true);
+    resourceCount = uTestUtilGetDynamicResourceCount() - resourceCount;
+    U_TEST_PRINT_LINE("we have leaked %d resources(s).", resourceCount);
+    U_PORT_TEST_ASSERT(resourceCount <= 0);
+}
+
+/** Benchmark finding the SPARTN messages in data that arrives in
+ * chunks: first by gathering the chunks into a buffer and calling
+ * uSpartnValidate() on it as each arrives, then with the stream
+ * decoder.
+ */
+U_PORT_TEST_FUNCTION("[spartn]", "spartnStreamBenchmark")
+{
+    int32_t resourceCount;
+    uSpartnStream_t stream;
+    uSpartnMessage_t message;
+    const char *pData;
+    const char *pMessage;
+    size_t length;
+    size_t bufferLength;
+    size_t countValidate = 0;
+    size_t count = 0;
+    int32_t startTimeMs;
+    int32_t timeMs;
+    int32_t x;
+
+    // Whatever called us likely initialised the
+    // port so deinitialise it here to obtain the
+    // correct initial heap size
+    uPortDeinit();
+    resourceCount = uTestUtilGetDynamicResourceCount();
+
+    // Big enough for a whole message, plus a chunk
+    gpData = (char *) pUPortMalloc(U_SPARTN_MESSAGE_LENGTH_MAX_BYTES +
+                                   U_SPARTN_TEST_STREAM_BENCHMARK_CHUNK_BYTES);
+    U_PORT_TEST_ASSERT(gpData != NULL);
+    gpStreamBuffer = (char *) pUPortMalloc(U_SPARTN_MESSAGE_LENGTH_MAX_BYTES);
+    U_PORT_TEST_ASSERT(gpStreamBuffer != NULL);
+    U_PORT_TEST_ASSERT(uSpartnStreamInit(&stream, gpStreamBuffer,
+                                         U_SPARTN_MESSAGE_LENGTH_MAX_BYTES) == 0);
+
+    U_TEST_PRINT_LINE("passing %d byte(s) of SPARTN %d time(s), in chunks of %d byte(s).",
+                      gUSpartnTestDataSize, U_SPARTN_TEST_STREAM_BENCHMARK_NUM_PASSES,
+                      U_SPARTN_TEST_STREAM_BENCHMARK_CHUNK_BYTES);
+
+    // Before
+    startTimeMs = uPortGetTickTimeMs();
+    for (size_t pass = 0; pass < U_SPARTN_TEST_STREAM_BENCHMARK_NUM_PASSES; pass++) {
+        bufferLength = 0;
+        for (pData = gUSpartnTestData; pData < gUSpartnTestData + gUSpartnTestDataSize;
+             pData += length) {
+            length = U_SPARTN_TEST_STREAM_BENCHMARK_CHUNK_BYTES;
+            if (length > (size_t) (gUSpartnTestData + gUSpartnTestDataSize - pData)) {
+                length = gUSpartnTestData + gUSpartnTestDataSize - pData;
+            }
+            memcpy(gpData + bufferLength, pData, length);
+            bufferLength += length;
+            do {
+                x = uSpartnValidate(gpData, bufferLength, &pMessage);
+                if (x > 0) {
+                    countValidate++;
+                    // Throw away the message and anything before it
+                    bufferLength -= (pMessage - gpData) + x;
+                    memmove(gpData, pMessage + x, bufferLength);
+                } else if (((x == (int32_t) U_ERROR_COMMON_NOT_FOUND) &&
+                            (bufferLength >= U_SPARTN_HEADER_LENGTH_MAX_BYTES)) ||
+                           (bufferLength >= U_SPARTN_MESSAGE_LENGTH_MAX_BYTES)) {
+                    // Not a message (NOT_FOUND may also mean too
+                    // little header), or not one that can fit: move
+                    // on a byte and look again
+                    bufferLength--;
+                    memmove(gpData, gpData + 1, bufferLength);
+                    x = 1;
+                }
+            } while ((x > 0) && (bufferLength > 0));
+        }
+    }
+    timeMs = uPortGetTickTimeMs() - startTimeMs;
+    U_TEST_PRINT_LINE("uSpartnValidate(): %d message(s) in %d ms.", countValidate, timeMs);
+
+    // After
+    startTimeMs = uPortGetTickTimeMs();
+    for (size_t pass = 0; pass < U_SPARTN_TEST_STREAM_BENCHMARK_NUM_PASSES; pass++) {
+        uSpartnStreamReset(&stream);
+        for (pData = gUSpartnTestData; pData < gUSpartnTestData + gUSpartnTestDataSize;) {
+            length = U_SPARTN_TEST_STREAM_BENCHMARK_CHUNK_BYTES;
+            if (length > (size_t) (gUSpartnTestData + gUSpartnTestDataSize - pData)) {
+                length = gUSpartnTestData + gUSpartnTestDataSize - pData;
+            }
+            do {
+                x = uSpartnStreamFeed(&stream, pData, length, &message);
+                if (message.pMessage != NULL) {
+                    count++;
+                }
+                pData += x;
+                length -= x;
+            } while ((length > 0) || (message.pMessage != NULL));
+        }
+    }
+    timeMs = uPortGetTickTimeMs() - startTimeMs;
+    U_TEST_PRINT_LINE("uSpartnStreamFeed(): %d message(s) in %d ms.", count, timeMs);
+    U_PORT_TEST_ASSERT(count == gUSpartnTestDataNumMessages *
+                       U_SPARTN_TEST_STREAM_BENCHMARK_NUM_PASSES);
+    U_PORT_TEST_ASSERT(countValidate == count);
+
+    streamFree();
+
+    // Check for resource leaks
+    uTestUtilResourceCheck(U_TEST_PREFIX, NULL, true);
+    resourceCount = uTestUtilGetDynamicResourceCount() - resourceCount;
+    U_TEST_PRINT_LINE("we have leaked %d resources(s).", resourceCount);
+    U_PORT_TEST_ASSERT(resourceCount <= 0);
+}
+
 /** Clean-up to be run at the end of this round of tests, just
  * in case there were test failures which would have resulted
  * in the deinitialisation being skipped.
  */
 U_PORT_TEST_FUNCTION("[spartn]", "spartnCleanUp")
 {
+    streamFree();
     uPortDeinit();
     // Printed for information: asserting happens in the postamble
     uTestUtilResourceCheck(U_TEST_PREFIX, NULL, true);
@@ -56,6 +56,14 @@ extern "C" {
  * TYPES
  * -------------------------------------------------------------- */
 
+/** A part of a UBX message body, for uUbxProtocolEncodeParts()
+ * and uUbxProtocolEncodeHeader().
+ */
+typedef struct {
+    const char *pData; /**< the data; may be NULL only if length is zero. */
+    size_t length;     /**< the number of bytes at pData. */
+} uUbxProtocolPart_t;
+
 /* ----------------------------------------------------------------
  * PUBLIC FUNCTIONS
  * -------------------------------------------------------------- */
@@ -151,6 +159,74 @@ int32_t uUbxProtocolEncode(int32_t messageClass, int32_t messageId,
                            const char *pMessageBody, size_t messageBodyLengthBytes,
                            char *pBuffer);
 
+/** Encode a UBX protocol message whose body is in several parts,
+ * e.g. a fixed header followed by a block of data held elsewhere,
+ * gathering the parts into the encoded message as it goes; this
+ * avoids the caller having to first assemble the body in a buffer
+ * of its own.
+ *
+ * @param messageClass            the UBX protocol message class.
+ * @param messageId               the UBX protocol message ID.
+ * @param[in] pParts              the parts of the message body, in
+ *                                order; may be NULL if numParts is
+ *                                zero.
+ * @param numParts                the number of entries at pParts.
+ * @param[out] pBuffer            a buffer in which the encoded
+ *                                message is to be stored; the total
+ *                                length of the parts plus
+ *                                #U_UBX_PROTOCOL_OVERHEAD_LENGTH_BYTES
+ *                                must be allowed.
+ * @return                        on success the number of bytes written
+ *                                to pBuffer, else negative error code.
+ */
+int32_t uUbxProtocolEncodeParts(int32_t messageClass, int32_t messageId,
+                                const uUbxProtocolPart_t *pParts, size_t numParts,
+                                char *pBuffer);
+
+/** Encode just the header and checksum of a UBX protocol message
+ * whose body is in one or more parts, without touching the body:
+ * the message may then be sent as the header, followed by each
+ * part, followed by the checksum, without copying the body at all.
+ *
+ * @param messageClass            the UBX protocol message class.
+ * @param messageId               the UBX protocol message ID.
+ * @param[in] pParts              the parts of the message body, in
+ *                                order; may be NULL if numParts is
+ *                                zero.
+ * @param numParts                the number of entries at pParts.
+ * @param[out] pHeader            a place to put the header, room for
+ *                                #U_UBX_PROTOCOL_HEADER_LENGTH_BYTES
+ *                                must be allowed; cannot be NULL.
+ * @param[out] pChecksum          a place to put the two bytes of
+ *                                checksum; cannot be NULL.
+ * @return                        on success the total length of the
+ *                                message, header, body and checksum,
+ *                                else negative error code.
+ */
+int32_t uUbxProtocolEncodeHeader(int32_t messageClass, int32_t messageId,
+                                 const uUbxProtocolPart_t *pParts, size_t numParts,
+                                 char *pHeader, char *pChecksum);
+
+/** Calculate the 8-bit Fletcher checksum used by the UBX protocol,
+ * which covers the class, ID, length and body of a message.  The
+ * calculation may be carried out a piece at a time by passing the
+ * return value of one call in as checksum to the next.  Where the
+ * compiler offers SSE2 the checksum is calculated 16 bytes at a time
+ * (this may be prevented by defining
+ * U_UBX_PROTOCOL_CHECKSUM_SIMD_DISABLE), otherwise eight bytes
+ * at a time.
+ *
+ * @param[in] pData  a pointer to the data; may be NULL only if length
+ *                   is zero.
+ * @param length     the number of bytes at pData.
+ * @param checksum   the checksum so far, zero for the first piece.
+ * @return           the checksum: CK_A in the lower byte and CK_B in
+ *                   the upper byte, i.e. the order in which they
+ *                   appear in a message if written little-endian.
+ */
+uint16_t uUbxProtocolChecksum(const char *pData, size_t length,
+                              uint16_t checksum);
+
 /** Decode a UBX protocol message.  Call this function with a buffer
  * and it will return the first valid UBX format message it finds
  * in the buffer. ppBufferOut will be set to the first position in
@@ -31,7 +31,7 @@
 #include "stddef.h"    // NULL, size_t etc.
 #include "stdint.h"    // int32_t etc.
 #include "stdbool.h"
-#include "string.h"    // memcpy()
+#include "string.h"    // memcpy(), memmove()
 
 #include "u_error_common.h"
 
@@ -41,6 +41,14 @@
  * COMPILE-TIME MACROS
  * -------------------------------------------------------------- */
 
+#if !defined(U_UBX_PROTOCOL_CHECKSUM_SIMD_DISABLE) && \
+    (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2)))
+/** Use SSE2 for the checksum.
+ */
+# define U_UBX_PROTOCOL_CHECKSUM_SSE2
+# include "emmintrin.h"
+#endif
+
 /* ----------------------------------------------------------------
  * TYPES
  * -------------------------------------------------------------- */
@@ -53,6 +61,56 @@
  * STATIC FUNCTIONS
  * -------------------------------------------------------------- */
 
+#ifdef U_UBX_PROTOCOL_CHECKSUM_SSE2
+// Add up the four 32-bit lanes of an SSE2 register.
+static uint32_t sse2Sum(__m128i value)
+{
+    value = _mm_add_epi32(value, _mm_shuffle_epi32(value, 0x4e));
+    value = _mm_add_epi32(value, _mm_shuffle_epi32(value, 0xb1));
+
+    return (uint32_t) _mm_cvtsi128_si32(value);
+}
+#endif
+
+// Write the header of a UBX message, returning a pointer to the
+// byte after it.
+static char *headerEncode(int32_t messageClass, int32_t messageId,
+                          size_t messageBodyLengthBytes, char *pBuffer)
+{
+    // Use a uint8_t pointer for maths, more certain of its behaviour than char
+    uint8_t *pWrite = (uint8_t *) pBuffer;
+
+    *pWrite++ = 0xb5;
+    *pWrite++ = 0x62;
+    *pWrite++ = (uint8_t) messageClass;
+    *pWrite++ = (uint8_t) messageId;
+    *pWrite++ = (uint8_t) (messageBodyLengthBytes & (uint8_t) 0xff);
+    *pWrite++ = (uint8_t) (messageBodyLengthBytes >> 8);
+
+    return (char *) pWrite;
+}
+
+// Return the total length of the parts of a message body, -1 if
+// the parts are not valid.
+static int32_t partsLength(const uUbxProtocolPart_t *pParts, size_t numParts)
+{
+    int32_t length = -1;
+
+    if ((pParts != NULL) || (numParts == 0)) {
+        length = 0;
+        for (size_t x = 0; (x < numParts) && (length >= 0); x++) {
+            if ((pParts->pData == NULL) && (pParts->length > 0)) {
+                length = -1;
+            } else {
+                length += (int32_t) pParts->length;
+            }
+            pParts++;
+        }
+    }
+
+    return length;
+}
+
 /* ----------------------------------------------------------------
  * PUBLIC FUNCTIONS
  * -------------------------------------------------------------- */
@@ -166,49 +224,143 @@ uint64_t uUbxProtocolUint64Encode(uint64_t uint64)
 int32_t uUbxProtocolEncode(int32_t messageClass, int32_t messageId,
                            const char *pMessage, size_t messageBodyLengthBytes,
                            char *pBuffer)
+{
+    uUbxProtocolPart_t part;
+
+    part.pData = pMessage;
+    part.length = messageBodyLengthBytes;
+
+    return uUbxProtocolEncodeParts(messageClass, messageId, &part, 1, pBuffer);
+}
+
+// Encode a UBX protocol message with a body in parts.
+int32_t uUbxProtocolEncodeParts(int32_t messageClass, int32_t messageId,
+                                const uUbxProtocolPart_t *pParts, size_t numParts,
+                                char *pBuffer)
 {
     int32_t errorCodeOrLength = (int32_t) U_ERROR_COMMON_INVALID_PARAMETER;
-    // Use a uint8_t pointer for maths, more certain of its behaviour than char
-    uint8_t *pWrite = (uint8_t *) pBuffer;
-    int32_t ca = 0;
-    int32_t cb = 0;
-
-    if (((messageBodyLengthBytes == 0) || (pMessage != NULL)) &&
-        (pBuffer != NULL)) {
-
-        // Complete the header
-        *pWrite++ = 0xb5;
-        *pWrite++ = 0x62;
-        *pWrite++ = (uint8_t) messageClass;
-        *pWrite++ = (uint8_t) messageId;
-        *pWrite++ = (uint8_t) (messageBodyLengthBytes & (uint8_t) 0xff);
-        *pWrite++ = (uint8_t) (messageBodyLengthBytes >> 8);
-
-        if (pMessage != NULL) {
-            // Copy in the message body
-            memcpy(pWrite, pMessage, messageBodyLengthBytes);
-            pWrite += messageBodyLengthBytes;
+    int32_t bodyLength = partsLength(pParts, numParts);
+    char *pWrite;
+    uint16_t checksum;
+
+    if ((bodyLength >= 0) && (pBuffer != NULL)) {
+        pWrite = headerEncode(messageClass, messageId, bodyLength, pBuffer);
+        // The checksum covers the variable elements of the header
+        // and the body; run it over each part as it is copied in,
+        // while the part is in cache
+        checksum = uUbxProtocolChecksum(pBuffer + 2, U_UBX_PROTOCOL_HEADER_LENGTH_BYTES - 2, 0);
+        for (size_t x = 0; x < numParts; x++) {
+            if (pParts->length > 0) {
+                memcpy(pWrite, pParts->pData, pParts->length);
+                checksum = uUbxProtocolChecksum(pWrite, pParts->length, checksum);
+                pWrite += pParts->length;
+            }
+            pParts++;
         }
+        // Write in the checksum
+        *pWrite++ = (char) (checksum & 0xff);
+        *pWrite = (char) (checksum >> 8);
 
-        // Work out the CRC over the variable elements of the
-        // header and the body
-        pBuffer += 2;
-        for (size_t x = 0; x < messageBodyLengthBytes + 4; x++) {
-            ca += (uint8_t) *pBuffer; // *NOPAD*
-            cb += ca;
-            pBuffer++;
-        }
+        errorCodeOrLength = (int32_t) (U_UBX_PROTOCOL_OVERHEAD_LENGTH_BYTES + bodyLength);
+    }
 
-        // Write in the CRC
-        *pWrite++ = (uint8_t) (ca & (uint8_t) 0xff);
-        *pWrite = (uint8_t) (cb & (uint8_t) 0xff);
+    return errorCodeOrLength;
+}
+
+// Encode the header and checksum of a UBX protocol message.
+int32_t uUbxProtocolEncodeHeader(int32_t messageClass, int32_t messageId,
+                                 const uUbxProtocolPart_t *pParts, size_t numParts,
+                                 char *pHeader, char *pChecksum)
+{
+    int32_t errorCodeOrLength = (int32_t) U_ERROR_COMMON_INVALID_PARAMETER;
+    int32_t bodyLength = partsLength(pParts, numParts);
+    uint16_t checksum;
+
+    if ((bodyLength >= 0) && (pHeader != NULL) && (pChecksum != NULL)) {
+        headerEncode(messageClass, messageId, bodyLength, pHeader);
+        checksum = uUbxProtocolChecksum(pHeader + 2, U_UBX_PROTOCOL_HEADER_LENGTH_BYTES - 2, 0);
+        for (size_t x = 0; x < numParts; x++) {
+            checksum = uUbxProtocolChecksum(pParts->pData, pParts->length, checksum);
+            pParts++;
+        }
+        *pChecksum = (char) (checksum & 0xff);
+        *(pChecksum + 1) = (char) (checksum >> 8);
 
-        errorCodeOrLength = (int32_t) (U_UBX_PROTOCOL_OVERHEAD_LENGTH_BYTES + messageBodyLengthBytes);
+        errorCodeOrLength = (int32_t) (U_UBX_PROTOCOL_OVERHEAD_LENGTH_BYTES + bodyLength);
     }
 
     return errorCodeOrLength;
 }
 
+// Calculate a UBX checksum.
+uint16_t uUbxProtocolChecksum(const char *pData, size_t length,
+                              uint16_t checksum)
+{
+    // Use a uint8_t pointer for maths, more certain of its behaviour than char
+    const uint8_t *pByte = (const uint8_t *) pData;
+    // Only the bottom eight bits of each matter, so these may
+    // be allowed to wrap
+    uint32_t ca = checksum & 0xff;
+    uint32_t cb = checksum >> 8;
+    uint32_t sum;
+    uint32_t weightedSum;
+
+    // Over a block of n bytes d[0] to d[n - 1], the byte at a time
+    // calculation (ca += d[i]; cb += ca) comes to:
+    //   cb += (n * ca) + (n * d[0]) + ((n - 1) * d[1]) + ... + d[n - 1]
+    //   ca += d[0] + d[1] + ... + d[n - 1]
+    // ...which, unlike the byte at a time calculation, has no chain
+    // of dependencies from one byte to the next.
+#ifdef U_UBX_PROTOCOL_CHECKSUM_SSE2
+    if (length >= 16) {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i weightLow = _mm_setr_epi16(16, 15, 14, 13, 12, 11, 10, 9);
+        const __m128i weightHigh = _mm_setr_epi16(8, 7, 6, 5, 4, 3, 2, 1);
+        __m128i sumVector = zero;
+        __m128i sumOfSumsVector = zero;
+        __m128i weightedVector = zero;
+        __m128i data;
+        size_t numBlocks = length >> 4;
+
+        for (size_t x = 0; x < numBlocks; x++) {
+            data = _mm_loadu_si128((const __m128i *) pByte);
+            // The ca going into each block is carried as the sum of
+            // the blocks before it
+            sumOfSumsVector = _mm_add_epi32(sumOfSumsVector, sumVector);
+            sumVector = _mm_add_epi32(sumVector, _mm_sad_epu8(data, zero));
+            weightedVector = _mm_add_epi32(weightedVector,
+                                           _mm_madd_epi16(_mm_unpacklo_epi8(data, zero), weightLow));
+            weightedVector = _mm_add_epi32(weightedVector,
+                                           _mm_madd_epi16(_mm_unpackhi_epi8(data, zero), weightHigh));
+            pByte += 16;
+        }
+        cb += (((uint32_t) numBlocks * ca) + sse2Sum(sumOfSumsVector)) << 4;
+        cb += sse2Sum(weightedVector);
+        ca += sse2Sum(sumVector);
+        length -= numBlocks << 4;
+    }
+#endif
+    while (length >= 8) {
+        sum = (uint32_t) pByte[0] + pByte[1] + pByte[2] + pByte[3] +
+              pByte[4] + pByte[5] + pByte[6] + pByte[7];
+        weightedSum = ((uint32_t) pByte[0] << 3) + (pByte[1] * 7U) + (pByte[2] * 6U) +
+                      (pByte[3] * 5U) + ((uint32_t) pByte[4] << 2) + (pByte[5] * 3U) +
+                      ((uint32_t) pByte[6] << 1) + pByte[7];
+        cb += (ca << 3) + weightedSum;
+        ca += sum;
+        pByte += 8;
+        length -= 8;
+    }
+    while (length > 0) {
+        ca += *pByte;
+        cb += ca;
+        pByte++;
+        length--;
+    }
+
+    return (uint16_t) ((ca & 0xff) | ((cb & 0xff) << 8));
+}
+
 // Decode a UBX protocol message.
 int32_t uUbxProtocolDecode(const char *pBufferIn, size_t bufferLengthBytes,
                            int32_t *pMessageClass, int32_t *pMessageId,
@@ -222,8 +374,9 @@ int32_t uUbxProtocolDecode(const char *pBufferIn, size_t bufferLengthBytes,
     bool updateCrc = false;
     size_t expectedMessageByteCount = 0;
     size_t messageByteCount = 0;
-    int32_t ca = 0;
-    int32_t cb = 0;
+    size_t y;
+    size_t z;
+    uint16_t checksum = 0;
 
     for (size_t x = 0; (x < bufferLengthBytes) &&
          (overheadByteCount < U_UBX_PROTOCOL_OVERHEAD_LENGTH_BYTES); x++) {
@@ -250,8 +403,7 @@ int32_t uUbxProtocolDecode(const char *pBufferIn, size_t bufferLengthBytes,
                 if (pMessageClass != NULL) {
                     *pMessageClass = *pInput;
                 }
-                ca = 0;
-                cb = 0;
+                checksum = 0;
                 updateCrc = true;
                 overheadByteCount++;
                 break;
@@ -283,17 +435,31 @@ int32_t uUbxProtocolDecode(const char *pBufferIn, size_t bufferLengthBytes,
                 break;
             case 6:
                 if (messageByteCount < expectedMessageByteCount) {
-                    // Store the next byte of the message and
-                    // update CRC
+                    // Deal with as much of the message body as
+                    // is here in one go
+                    y = expectedMessageByteCount - messageByteCount;
+                    if (y > bufferLengthBytes - x) {
+                        y = bufferLengthBytes - x;
+                    }
+                    // Update the CRC before storing since it is allowed
+                    // to decode back into pBufferIn
+                    checksum = uUbxProtocolChecksum((const char *) pInput, y, checksum);
                     if ((pMessage != NULL) && (messageByteCount < maxMessageLengthBytes)) {
-                        *pMessage++ = (char) *pInput; // *NOPAD*
+                        z = y;
+                        if (z > maxMessageLengthBytes - messageByteCount) {
+                            z = maxMessageLengthBytes - messageByteCount;
+                        }
+                        memmove(pMessage, pInput, z);
+                        pMessage += z;
                     }
-                    updateCrc = true;
-                    messageByteCount++;
+                    messageByteCount += y;
+                    // Move on to the last byte dealt with, the loop
+                    // moves on from there
+                    pInput += y - 1;
+                    x += y - 1;
                 } else {
                     // First byte of CRC, check it
-                    ca &= 0xff;
-                    if ((uint8_t) ca == *pInput) {
+                    if ((uint8_t) checksum == *pInput) {
                         overheadByteCount++;
                     } else {
                         // Not a valid message, start again
@@ -303,8 +469,7 @@ int32_t uUbxProtocolDecode(const char *pBufferIn, size_t bufferLengthBytes,
                 break;
             case 7:
                 // Second byte of CRC, check it
-                cb &= 0xff;
-                if ((uint8_t) cb == *pInput) {
+                if ((uint8_t) (checksum >> 8) == *pInput) {
                     overheadByteCount++;
                 } else {
                     // Not a valid message, start again
@@ -317,8 +482,7 @@ int32_t uUbxProtocolDecode(const char *pBufferIn, size_t bufferLengthBytes,
         }
 
         if (updateCrc) {
-            ca += *pInput;
-            cb += ca;
+            checksum = uUbxProtocolChecksum((const char *) pInput, 1, checksum);
             updateCrc = false;
         }
 
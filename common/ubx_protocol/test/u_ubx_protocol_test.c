@@ -68,6 +68,13 @@
 # define U_UBX_PROTOCOL_TEST_MAX_BODY_SIZE 1024
 #endif
 
+#ifndef U_UBX_PROTOCOL_TEST_BENCHMARK_NUM_PASSES
+/** The number of times to checksum a maximum-size body in
+ * ubxProtocolChecksumBenchmark.
+ */
+# define U_UBX_PROTOCOL_TEST_BENCHMARK_NUM_PASSES 1000
+#endif
+
 /* ----------------------------------------------------------------
  * TYPES
  * -------------------------------------------------------------- */
@@ -80,6 +87,22 @@
  * STATIC FUNCTIONS
  * -------------------------------------------------------------- */
 
+// The UBX protocol checksum calculated a byte at a time, the
+// way it is written in the interface manual, as a reference.
+static uint16_t checksumReference(const char *pData, size_t length,
+                                  uint16_t checksum)
+{
+    uint8_t ca = (uint8_t) checksum;
+    uint8_t cb = (uint8_t) (checksum >> 8);
+
+    for (size_t x = 0; x < length; x++) {
+        ca += (uint8_t) *(pData + x);
+        cb += ca;
+    }
+
+    return (uint16_t) ca | (uint16_t) ((uint16_t) cb << 8);
+}
+
 /* ----------------------------------------------------------------
  * PUBLIC FUNCTIONS: TESTS
  * -------------------------------------------------------------- */
@@ -172,6 +195,194 @@ U_PORT_TEST_FUNCTION("[ubxProtocol]", "ubxProtocolBackToBack")
     uPortFree(pBuffer);
 }
 
+/** Test the checksum calculation and the scatter/gather encoders.
+ */
+U_PORT_TEST_FUNCTION("[ubxProtocol]", "ubxProtocolChecksum")
+{
+    char *pBodyIn;
+    char *pBuffer;
+    char *pBufferParts;
+    char header[U_UBX_PROTOCOL_HEADER_LENGTH_BYTES];
+    char checksum[2];
+    uUbxProtocolPart_t parts[3];
+    uint16_t expected;
+    uint16_t calculated;
+    size_t y;
+    int32_t classOut;
+    int32_t idOut;
+    const char *pTmp;
+
+    pBodyIn = (char *) pUPortMalloc(U_UBX_PROTOCOL_TEST_MAX_BODY_SIZE);
+    U_PORT_TEST_ASSERT(pBodyIn != NULL);
+    pBuffer = (char *) pUPortMalloc(U_UBX_PROTOCOL_TEST_MAX_BODY_SIZE +
+                                    U_UBX_PROTOCOL_OVERHEAD_LENGTH_BYTES);
+    U_PORT_TEST_ASSERT(pBuffer != NULL);
+    pBufferParts = (char *) pUPortMalloc(U_UBX_PROTOCOL_TEST_MAX_BODY_SIZE +
+                                         U_UBX_PROTOCOL_OVERHEAD_LENGTH_BYTES);
+    U_PORT_TEST_ASSERT(pBufferParts != NULL);
+
+    // Fill the body with something that doesn't repeat too soon and
+    // has plenty of bytes with the top bit set, which would show up
+    // any problems with sign extension or lane overflow
+    y = 0x5a;
+    for (size_t x = 0; x < U_UBX_PROTOCOL_TEST_MAX_BODY_SIZE; x++) {
+        y = (y * 1103515245 + 12345) & 0x7fffffff;
+        //lint -e(613) Suppress possible nullness in pBodyIn, it is checked above
+        *(pBodyIn + x) = (char) (y >> 16);
+    }
+
+    // Every length up to a bit more than a few SIMD blocks, at every
+    // alignment and with a non-zero starting checksum, in one go
+    for (size_t length = 0; length < 100; length++) {
+        for (size_t offset = 0; offset < 16; offset++) {
+            expected = checksumReference(pBodyIn + offset, length, 0);
+            U_PORT_TEST_ASSERT(uUbxProtocolChecksum(pBodyIn + offset, length, 0) == expected);
+            expected = checksumReference(pBodyIn + offset, length, 0xa55a);
+            U_PORT_TEST_ASSERT(uUbxProtocolChecksum(pBodyIn + offset, length, 0xa55a) == expected);
+        }
+    }
+    // The whole body, with a large block count, and then in pieces
+    // of all sizes
+    expected = checksumReference(pBodyIn, U_UBX_PROTOCOL_TEST_MAX_BODY_SIZE, 0);
+    U_PORT_TEST_ASSERT(uUbxProtocolChecksum(pBodyIn, U_UBX_PROTOCOL_TEST_MAX_BODY_SIZE,
+                                            0) == expected);
+    for (size_t piece = 1; piece < 70; piece++) {
+        calculated = 0;
+        for (size_t x = 0; x < U_UBX_PROTOCOL_TEST_MAX_BODY_SIZE; x += piece) {
+            y = U_UBX_PROTOCOL_TEST_MAX_BODY_SIZE - x;
+            if (y > piece) {
+                y = piece;
+            }
+            calculated = uUbxProtocolChecksum(pBodyIn + x, y, calculated);
+        }
+        U_PORT_TEST_ASSERT(calculated == expected);
+    }
+    // Zero length must leave the checksum alone, NULL or not
+    U_PORT_TEST_ASSERT(uUbxProtocolChecksum(NULL, 0, 0x1234) == 0x1234);
+
+    // Check that the encoders agree with the checksum function and
+    // that encoding in parts gives the same answer as encoding in one
+    for (size_t x = 0; x < U_UBX_PROTOCOL_TEST_MAX_BODY_SIZE; x += 37) {
+        U_PORT_TEST_ASSERT(uUbxProtocolEncode(0x06, 0x8a, pBodyIn, x,
+                                              pBuffer) == (int32_t) x + U_UBX_PROTOCOL_OVERHEAD_LENGTH_BYTES);
+        calculated = uUbxProtocolChecksum(pBuffer + 2, x + U_UBX_PROTOCOL_HEADER_LENGTH_BYTES - 2, 0);
+        U_PORT_TEST_ASSERT(*(pBuffer + x + U_UBX_PROTOCOL_HEADER_LENGTH_BYTES) == (char) calculated);
+        U_PORT_TEST_ASSERT(*(pBuffer + x + U_UBX_PROTOCOL_HEADER_LENGTH_BYTES + 1) ==
+                           (char) (calculated >> 8));
+        // Split the body in three, the middle part maybe empty
+        parts[0].pData = pBodyIn;
+        parts[0].length = x / 3;
+        parts[1].pData = pBodyIn + parts[0].length;
+        parts[1].length = (x / 7) & ~1;
+        parts[2].pData = parts[1].pData + parts[1].length;
+        parts[2].length = x - parts[0].length - parts[1].length;
+        //lint -e(668) Suppress possible nullness in pBufferParts, it is checked above
+        memset(pBufferParts, 0xff, U_UBX_PROTOCOL_TEST_MAX_BODY_SIZE +
+               U_UBX_PROTOCOL_OVERHEAD_LENGTH_BYTES);
+        U_PORT_TEST_ASSERT(uUbxProtocolEncodeParts(0x06, 0x8a, parts, 3,
+                                                   pBufferParts) == (int32_t) x + U_UBX_PROTOCOL_OVERHEAD_LENGTH_BYTES);
+        U_PORT_TEST_ASSERT(memcmp(pBufferParts, pBuffer, x + U_UBX_PROTOCOL_OVERHEAD_LENGTH_BYTES) == 0);
+        //lint -e(650) Suppress constant out of range; it isn't
+        U_PORT_TEST_ASSERT(*(pBufferParts + x + U_UBX_PROTOCOL_OVERHEAD_LENGTH_BYTES) == (char) 0xff);
+        // Header and checksum only
+        memset(header, 0, sizeof(header));
+        memset(checksum, 0, sizeof(checksum));
+        U_PORT_TEST_ASSERT(uUbxProtocolEncodeHeader(0x06, 0x8a, parts, 3, header,
+                                                    checksum) == (int32_t) x + U_UBX_PROTOCOL_OVERHEAD_LENGTH_BYTES);
+        U_PORT_TEST_ASSERT(memcmp(header, pBuffer, sizeof(header)) == 0);
+        U_PORT_TEST_ASSERT(memcmp(checksum, pBuffer + x + U_UBX_PROTOCOL_HEADER_LENGTH_BYTES,
+                                  sizeof(checksum)) == 0);
+        // Decode in place, and then decode into a buffer too
+        // short for the body: the message should still be found
+        // and its full length returned
+        U_PORT_TEST_ASSERT(uUbxProtocolDecode(pBufferParts, x + U_UBX_PROTOCOL_OVERHEAD_LENGTH_BYTES,
+                                              &classOut, &idOut, pBufferParts,
+                                              x, &pTmp) == (int32_t) x);
+        U_PORT_TEST_ASSERT(classOut == 0x06);
+        U_PORT_TEST_ASSERT(idOut == 0x8a);
+        U_PORT_TEST_ASSERT(memcmp(pBufferParts, pBodyIn, x) == 0);
+        memset(pBufferParts, 0xff, x);
+        U_PORT_TEST_ASSERT(uUbxProtocolDecode(pBuffer, x + U_UBX_PROTOCOL_OVERHEAD_LENGTH_BYTES,
+                                              &classOut, &idOut, pBufferParts,
+                                              x / 2, &pTmp) == (int32_t) x);
+        U_PORT_TEST_ASSERT(memcmp(pBufferParts, pBodyIn, x / 2) == 0);
+        for (size_t z = x / 2; z < x; z++) {
+            //lint -e(650) Suppress constant out of range; it isn't
+            U_PORT_TEST_ASSERT(*(pBufferParts + z) == (char) 0xff);
+        }
+    }
+
+    // Invalid parts
+    parts[0].pData = NULL;
+    parts[0].length = 1;
+    U_PORT_TEST_ASSERT(uUbxProtocolEncodeParts(0x06, 0x8a, parts, 1, pBuffer) < 0);
+    U_PORT_TEST_ASSERT(uUbxProtocolEncodeHeader(0x06, 0x8a, parts, 1, header, checksum) < 0);
+    U_PORT_TEST_ASSERT(uUbxProtocolEncodeParts(0x06, 0x8a, NULL, 1, pBuffer) < 0);
+    U_PORT_TEST_ASSERT(uUbxProtocolEncodeHeader(0x06, 0x8a, parts, 0, NULL, checksum) < 0);
+    U_PORT_TEST_ASSERT(uUbxProtocolEncodeHeader(0x06, 0x8a, parts, 0, header, NULL) < 0);
+    // ...but an empty part, or no parts, is fine
+    parts[0].length = 0;
+    U_PORT_TEST_ASSERT(uUbxProtocolEncodeParts(0x06, 0x8a, parts, 1,
+                                               pBuffer) == U_UBX_PROTOCOL_OVERHEAD_LENGTH_BYTES);
+    U_PORT_TEST_ASSERT(uUbxProtocolEncodeParts(0x06, 0x8a, NULL, 0,
+                                               pBufferParts) == U_UBX_PROTOCOL_OVERHEAD_LENGTH_BYTES);
+    U_PORT_TEST_ASSERT(memcmp(pBuffer, pBufferParts, U_UBX_PROTOCOL_OVERHEAD_LENGTH_BYTES) == 0);
+
+    // Free memory
+    uPortFree(pBodyIn);
+    uPortFree(pBuffer);
+    uPortFree(pBufferParts);
+}
+
+/** Benchmark the UBX protocol checksum: first a byte at a time,
+ * then with uUbxProtocolChecksum().
+ */
+U_PORT_TEST_FUNCTION("[ubxProtocol]", "ubxProtocolChecksumBenchmark")
+{
+    char *pBodyIn;
+    int32_t startTimeMs;
+    int32_t timeMs;
+    int32_t totalBytes = U_UBX_PROTOCOL_TEST_MAX_BODY_SIZE *
+                         U_UBX_PROTOCOL_TEST_BENCHMARK_NUM_PASSES;
+    uint16_t checksum = 0;
+    uint16_t checksumReferenceValue = 0;
+
+    pBodyIn = (char *) pUPortMalloc(U_UBX_PROTOCOL_TEST_MAX_BODY_SIZE);
+    U_PORT_TEST_ASSERT(pBodyIn != NULL);
+    for (size_t x = 0; x < U_UBX_PROTOCOL_TEST_MAX_BODY_SIZE; x++) {
+        //lint -e(613) Suppress possible nullness in pBodyIn, it is checked above
+        *(pBodyIn + x) = (char) (x * 7);
+    }
+
+    U_TEST_PRINT_LINE("checksumming %d bytes %d time(s).",
+                      U_UBX_PROTOCOL_TEST_MAX_BODY_SIZE,
+                      U_UBX_PROTOCOL_TEST_BENCHMARK_NUM_PASSES);
+
+    // Before: chaining the checksum from one pass to the next
+    // stops the compiler hoisting it out of the loop
+    startTimeMs = uPortGetTickTimeMs();
+    for (size_t x = 0; x < U_UBX_PROTOCOL_TEST_BENCHMARK_NUM_PASSES; x++) {
+        checksumReferenceValue = checksumReference(pBodyIn, U_UBX_PROTOCOL_TEST_MAX_BODY_SIZE,
+                                                   checksumReferenceValue);
+    }
+    timeMs = uPortGetTickTimeMs() - startTimeMs;
+    U_TEST_PRINT_LINE("a byte at a time: %d ms, %d kbytes/second.", timeMs,
+                      timeMs > 0 ? (int32_t) (((int64_t) totalBytes) / timeMs) : 0);
+
+    // After
+    startTimeMs = uPortGetTickTimeMs();
+    for (size_t x = 0; x < U_UBX_PROTOCOL_TEST_BENCHMARK_NUM_PASSES; x++) {
+        checksum = uUbxProtocolChecksum(pBodyIn, U_UBX_PROTOCOL_TEST_MAX_BODY_SIZE,
+                                        checksum);
+    }
+    timeMs = uPortGetTickTimeMs() - startTimeMs;
+    U_TEST_PRINT_LINE("uUbxProtocolChecksum(): %d ms, %d kbytes/second.", timeMs,
+                      timeMs > 0 ? (int32_t) (((int64_t) totalBytes) / timeMs) : 0);
+    U_PORT_TEST_ASSERT(checksum == checksumReferenceValue);
+
+    uPortFree(pBodyIn);
+}
+
 /** Clean-up to be run at the end of this round of tests, just
  * in case there were test failures which would have resulted
  * in the deinitialisation being skipped.
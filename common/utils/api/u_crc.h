@@ -0,0 +1,147 @@
+/*
+ * Copyright 2019-2024 u-blox
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _U_CRC_H_
+#define _U_CRC_H_
+
+/* Only header files representing a direct and unavoidable
+ * dependency between the API of this module and the API
+ * of another module should be included here; otherwise
+ * please keep #includes to your .c files. */
+
+/** \addtogroup __utils
+ *  @{
+ */
+
+/** @file
+ * @brief This header file defines the CRC functions shared by the
+ * protocol code of ubxlib: the SPARTN CRC-8, CRC-16, CRC-24 and
+ * CRC-32, the RTCM3 CRC-24Q and the 3GPP 27.010 (CMUX) FCS.
+ *
+ * All of the functions work on the raw CRC register: no initial
+ * value is loaded, nothing is reflected and there is no final XOR,
+ * the caller passes in its initial value as crc and applies any
+ * final XOR itself.  This allows a CRC to be calculated a piece
+ * at a time, passing the return value of one call in as crc to
+ * the next.
+ *
+ * By default the functions work a byte at a time, using a table of
+ * 256 entries per polynomial, each entry the width of the CRC (so
+ * 256 bytes for the CRC-8 and 512 bytes for the CRC-16), or four
+ * bytes wide for the CRC-24Q and CRC-32.  Where flash is plentiful,
+ * define U_CRC_SLICING_BY_8_ENABLE to have all but uCrc8Reflected(),
+ * which is only ever used on a few bytes of header, work eight bytes
+ * at a time ("slicing-by-8"), which is several times faster but needs
+ * eight times the table space; the Linux and Windows ports do this.
+ * Each function only brings in its own tables, so a linker that
+ * discards unused data sections will drop the tables of any
+ * polynomial that is not used.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ----------------------------------------------------------------
+ * COMPILE-TIME MACROS
+ * -------------------------------------------------------------- */
+
+/* ----------------------------------------------------------------
+ * TYPES
+ * -------------------------------------------------------------- */
+
+/* ----------------------------------------------------------------
+ * VARIABLES
+ * -------------------------------------------------------------- */
+
+/* ----------------------------------------------------------------
+ * FUNCTIONS
+ * -------------------------------------------------------------- */
+
+/** Add a block of data to an 8-bit CRC with polynomial 0x07, most
+ * significant bit first, as used by SPARTN.
+ *
+ * @param[in] pData  a pointer to the data; may be NULL only if size
+ *                   is zero.
+ * @param size       the number of bytes at pData.
+ * @param crc        the CRC so far, the initial value for the
+ *                   first block.
+ * @return           the CRC, including the data at pData.
+ */
+uint8_t uCrc8(const char *pData, size_t size, uint8_t crc);
+
+/** Add a block of data to an 8-bit CRC with polynomial 0x07,
+ * least significant bit first (i.e. reflected), as used for the
+ * FCS of 3GPP 27.010 (CMUX), which starts with 0xFF and has a final
+ * XOR of 0xFF.  This is calculated a byte at a time.
+ *
+ * @param[in] pData  a pointer to the data; may be NULL only if size
+ *                   is zero.
+ * @param size       the number of bytes at pData.
+ * @param crc        the CRC so far, the initial value for the
+ *                   first block.
+ * @return           the CRC, including the data at pData.
+ */
+uint8_t uCrc8Reflected(const char *pData, size_t size, uint8_t crc);
+
+/** Add a block of data to a 16-bit CRC with polynomial 0x1021, most
+ * significant bit first (CRC-16-CCITT), as used by SPARTN.
+ *
+ * @param[in] pData  a pointer to the data; may be NULL only if size
+ *                   is zero.
+ * @param size       the number of bytes at pData.
+ * @param crc        the CRC so far, the initial value for the
+ *                   first block.
+ * @return           the CRC, including the data at pData.
+ */
+uint16_t uCrc16(const char *pData, size_t size, uint16_t crc);
+
+/** Add a block of data to a 24-bit CRC with polynomial 0x864CFB,
+ * most significant bit first: this is both the CRC-24Q of RTCM3
+ * and the CRC-24 of SPARTN.
+ *
+ * @param[in] pData  a pointer to the data; may be NULL only if size
+ *                   is zero.
+ * @param size       the number of bytes at pData.
+ * @param crc        the CRC so far, in the lower 24 bits, the
+ *                   initial value for the first block.
+ * @return           the CRC, including the data at pData, in the
+ *                   lower 24 bits.
+ */
+uint32_t uCrc24q(const char *pData, size_t size, uint32_t crc);
+
+/** Add a block of data to a 32-bit CRC with polynomial 0x04C11DB7,
+ * most significant bit first, as used by SPARTN (which starts with
+ * 0xFFFFFFFF and has a final XOR of 0xFFFFFFFF).
+ *
+ * @param[in] pData  a pointer to the data; may be NULL only if size
+ *                   is zero.
+ * @param size       the number of bytes at pData.
+ * @param crc        the CRC so far, the initial value for the
+ *                   first block.
+ * @return           the CRC, including the data at pData.
+ */
+uint32_t uCrc32(const char *pData, size_t size, uint32_t crc);
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @}*/
+
+#endif // _U_CRC_H_
+
+// End of file
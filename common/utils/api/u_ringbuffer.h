@@ -29,7 +29,8 @@
 /** @file
  * @brief Ring buffer wrapper API for linear buffer.
  * All functions except uRingBufferCreate() and uRingBufferDelete()
- * are thread-safe.
+ * are thread-safe; a ring buffer created with uRingBufferCreateSpsc()
+ * is instead lock-free, for one producer and one consumer only.
  */
 
 #ifdef __cplusplus
@@ -99,8 +100,46 @@ typedef struct {
                                          as a result of add or forced add
                                          being unable to write into the
                                          ring buffer. */
+    bool isSpsc;                    /**< true if the ring buffer was created
+                                         with uRingBufferCreateSpsc(), in
+                                         which case pDataWrite and the
+                                         "normal" read pointer are accessed
+                                         atomically rather than under
+                                         the mutex. */
+    size_t mirrorSize;              /**< the number of bytes at the end of
+                                         the linear buffer, after the ring,
+                                         that mirror the start of the ring;
+                                         see uRingBufferSetMirror(). */
+    void **ppParseProgress;         /**< the progress of uRingBufferParseBlockHandle()
+                                         for each read pointer, an array of
+                                         maxNumReadPointers entries, allocated
+                                         on first use. */
+    const char *pDataReadSlowest;   /**< the position of the slowest of
+                                         the read pointers that an add must
+                                         not overrun, NULL if there are none;
+                                         only valid if slowestValid is true. */
+    size_t numAtSlowest;            /**< the number of read pointers at
+                                         pDataReadSlowest. */
+    bool slowestValid;              /**< false if pDataReadSlowest must be
+                                         worked out again. */
+    size_t statHighWaterNormalBytes; /**< storage for the most data that
+                                          has been waiting at the "normal"
+                                          read pointer. */
+    size_t *statHighWaterBytes;     /**< storage for the most data that has
+                                         been waiting at each of the read
+                                         pointers, an array like
+                                         statReadLossBytes, zeroth entry
+                                         unused. */
 } uRingBuffer_t;
 
+/** A contiguous region of data in a ring buffer, as returned by
+ * uRingBufferPeekSpans()/uRingBufferPeekSpansHandle().
+ */
+typedef struct {
+    const char *pData; /**< the start of the region, NULL if empty. */
+    size_t length;     /**< the number of bytes at pData. */
+} uRingBufferSpan_t;
+
 typedef void *uParseHandle_t; //!< Parser handle.
 
 /** Parser function prototype, used with uRingBufferParseHandle().
@@ -113,6 +152,51 @@ typedef void *uParseHandle_t; //!< Parser handle.
  */
 typedef int32_t (*U_RING_BUFFER_PARSER_f)(uParseHandle_t parseHandle, void *pUserParam);
 
+/** Block parser function prototype, used with uRingBufferParseBlockHandle().
+ *
+ * Unlike a #U_RING_BUFFER_PARSER_f, which is run from the start of a
+ * candidate message each time it is called, a block parser is given
+ * the data of a candidate message a block at a time, starting with the
+ * sync byte that began the candidate, and keeps whatever it needs
+ * (header seen, length known, running checksum, etc.) in pState
+ * between calls, so that each byte is only examined once, however
+ * slowly the message arrives.
+ *
+ * @param[in,out] pState  the state of this parser for the current
+ *                        candidate message, stateSize bytes (see
+ *                        #uRingBufferBlockParser_t), zeroed when the
+ *                        candidate begins.
+ * @param[in] pData       the next block of the candidate message.
+ * @param length          the number of bytes at pData, at least one.
+ * @param[out] pUserParam the user parameter passed to
+ *                        uRingBufferParseBlockHandle(); this is only
+ *                        valid for the duration of that call, hence the
+ *                        outcome of parsing (message ID etc.) should be
+ *                        kept in pState and only written here when the
+ *                        message is complete.
+ * @return                #U_ERROR_COMMON_TIMEOUT if all of pData was
+ *                        consumed and more is needed to conclude,
+ *                        #U_ERROR_COMMON_NOT_FOUND if this is not a
+ *                        message for this parser or, if the message
+ *                        is complete, the number of bytes of pData that
+ *                        completed it.
+ */
+typedef int32_t (*U_RING_BUFFER_BLOCK_PARSER_f)(void *pState, const char *pData,
+                                                size_t length, void *pUserParam);
+
+/** A block parser, as passed to uRingBufferParseBlockHandle().
+ */
+typedef struct {
+    U_RING_BUFFER_BLOCK_PARSER_f pParser; /**< the parser; NULL marks the
+                                               end of a list of parsers. */
+    const char *pSyncBytes;               /**< the bytes that may begin a
+                                               message for this parser. */
+    size_t numSyncBytes;                  /**< the number of bytes at
+                                               pSyncBytes. */
+    size_t stateSize;                     /**< the amount of state the
+                                               parser needs, may be zero. */
+} uRingBufferBlockParser_t;
+
 /* ----------------------------------------------------------------
  * VARIABLES
  * -------------------------------------------------------------- */
@@ -148,6 +232,41 @@ void uRingBufferDump(uRingBuffer_t *pRingBuffer);
 int32_t uRingBufferCreate(uRingBuffer_t *pRingBuffer, char *pLinearBuffer,
                           size_t size);
 
+/** Create a new ring buffer from a linear buffer for use by a
+ * single producer and a single consumer, e.g. a task filling the
+ * ring buffer with data from a UART and another task reading that
+ * data out.  The API is the same as for a ring buffer created with
+ * uRingBufferCreate() but the write pointer and the read pointer
+ * are accessed atomically, with acquire/release ordering, so that
+ * uRingBufferAdd(), uRingBufferForceAdd(), uRingBufferRead(),
+ * uRingBufferPeek(), uRingBufferDataSize(), uRingBufferAvailableSize(),
+ * uRingBufferFlush() and uRingBufferFlushValue() need not lock the
+ * mutex of the ring buffer.  The rules are that:
+ *
+ * - only one task may call uRingBufferAdd()/uRingBufferForceAdd(),
+ * - only one task may call uRingBufferRead(), uRingBufferPeek(),
+ *   uRingBufferFlush() and uRingBufferFlushValue(),
+ * - uRingBufferDataSize() and uRingBufferAvailableSize() may
+ *   be called by either,
+ * - since the producer may not move the read pointer,
+ *   uRingBufferForceAdd() behaves exactly as uRingBufferAdd(),
+ *   i.e. if there is not room the data is not added, and hence
+ *   uRingBufferStatReadLoss() will always return zero,
+ * - uRingBufferReset() may only be called when neither the
+ *   producer nor the consumer is active,
+ * - read handles cannot be used.
+ *
+ * @param[in] pRingBuffer   a pointer to a ring buffer, cannot be NULL.
+ * @param[in] pLinearBuffer a pointer to the linear buffer.
+ * @param size              the size of the linear buffer in bytes; the
+ *                          ring buffer will be of maximum size this
+ *                          number minus one as one byte is used to
+ *                          prevent pointer-wrap.
+ * @return                  zero on success else negative error code.
+ */
+int32_t uRingBufferCreateSpsc(uRingBuffer_t *pRingBuffer, char *pLinearBuffer,
+                              size_t size);
+
 /** Delete a ring buffer.
  *
  * @param[in] pRingBuffer   a pointer to the ring buffer, cannot be NULL.
@@ -271,6 +390,16 @@ size_t uRingBufferStatReadLoss(uRingBuffer_t *pRingBuffer);
  */
 size_t uRingBufferStatAddLoss(uRingBuffer_t *pRingBuffer);
 
+/** Get the most data that has been waiting to be read with
+ * uRingBufferRead() at any one time, a measure of how close the
+ * reader has come to losing data.  For a ring buffer created with
+ * uRingBufferCreateSpsc() this may only be called by the producer.
+ *
+ * @param[in] pRingBuffer a pointer to the ring buffer, cannot be NULL.
+ * @return                the high-water mark in bytes.
+ */
+size_t uRingBufferStatHighWater(uRingBuffer_t *pRingBuffer);
+
 /* ----------------------------------------------------------------
  * FUNCTIONS: MULTIPLE READERS
  * -------------------------------------------------------------- */
@@ -455,6 +584,104 @@ void uRingBufferFlushHandle(uRingBuffer_t *pRingBuffer, int32_t handle);
 size_t uRingBufferStatReadLossHandle(uRingBuffer_t *pRingBuffer,
                                      int32_t handle);
 
+/** Like uRingBufferStatHighWater() but for a read handle: the most
+ * data that has been waiting at the given read handle at any one
+ * time since it was taken.
+ *
+ * @param[in] pRingBuffer a pointer to the ring buffer, cannot be NULL.
+ * @param handle          a read handle, as originally returned by
+ *                        uRingBufferTakeReadHandle().
+ * @return                the high-water mark in bytes.
+ */
+size_t uRingBufferStatHighWaterHandle(uRingBuffer_t *pRingBuffer,
+                                      int32_t handle);
+
+/* ----------------------------------------------------------------
+ * FUNCTIONS: SPANS
+ * -------------------------------------------------------------- */
+
+/** Get the data in a ring buffer, without copying it, as up to two
+ * contiguous regions: the first from the read pointer up to the end
+ * of the ring (or of the mirror, see uRingBufferSetMirror()), the
+ * second, if the data wraps, from the start of the ring; when done,
+ * call uRingBufferCommitRead() to move the read pointer on by the
+ * amount consumed.  The regions remain valid until then provided
+ * that nothing is allowed to overwrite them, i.e. uRingBufferForceAdd()
+ * is not used on this ring buffer or, if the read is through a
+ * handle, the handle has been locked with uRingBufferLockReadHandle().
+ *
+ * @param[in] pRingBuffer a pointer to the ring buffer, cannot be NULL.
+ * @param[out] pSpans     a pointer to an array of TWO spans, cannot be
+ *                        NULL; the length of any span that is not
+ *                        populated will be zero.
+ * @return                the number of bytes available for reading,
+ *                        i.e. the total length of the spans.
+ */
+size_t uRingBufferPeekSpans(uRingBuffer_t *pRingBuffer,
+                            uRingBufferSpan_t *pSpans);
+
+/** Move the read pointer of a ring buffer on, e.g. after having
+ * consumed data obtained with uRingBufferPeekSpans(); this is
+ * the same as calling uRingBufferRead() with pData NULL.
+ *
+ * @param[in] pRingBuffer a pointer to the ring buffer, cannot be NULL.
+ * @param length          the number of bytes to move the read
+ *                        pointer on by.
+ * @return                the number of bytes the read pointer was
+ *                        moved on by, which will be less than
+ *                        length if there was less data than that.
+ */
+size_t uRingBufferCommitRead(uRingBuffer_t *pRingBuffer, size_t length);
+
+/** Like uRingBufferPeekSpans() but for a read handle, as returned by
+ * uRingBufferTakeReadHandle().
+ *
+ * @param[in] pRingBuffer a pointer to the ring buffer, cannot be NULL.
+ * @param handle          the read handle.
+ * @param[out] pSpans     a pointer to an array of TWO spans, cannot be
+ *                        NULL; the length of any span that is not
+ *                        populated will be zero.
+ * @return                the number of bytes available for reading,
+ *                        i.e. the total length of the spans.
+ */
+size_t uRingBufferPeekSpansHandle(uRingBuffer_t *pRingBuffer, int32_t handle,
+                                  uRingBufferSpan_t *pSpans);
+
+/** Like uRingBufferCommitRead() but for a read handle; this is the
+ * same as calling uRingBufferReadHandle() with pData NULL.
+ *
+ * @param[in] pRingBuffer a pointer to the ring buffer, cannot be NULL.
+ * @param handle          the read handle.
+ * @param length          the number of bytes to move the read
+ *                        pointer on by.
+ * @return                the number of bytes the read pointer was
+ *                        moved on by.
+ */
+size_t uRingBufferCommitReadHandle(uRingBuffer_t *pRingBuffer, int32_t handle,
+                                   size_t length);
+
+/** Reserve a mirror tail: the last mirrorSize bytes of the linear
+ * buffer are taken away from the ring and, from then on, anything
+ * written to the first mirrorSize bytes of the ring is also written
+ * there.  The effect is that any mirrorSize bytes of data, wherever
+ * they are in the ring, can be read contiguously; uRingBufferPeekSpans()
+ * will return a single span unless the data wraps by more than
+ * mirrorSize bytes, so a parser that sets mirrorSize to the
+ * largest frame it handles will never see a frame split in two.
+ * The cost is that of copying the mirrored bytes on add.  Any data
+ * in the ring buffer is discarded: call this straight after
+ * creating the ring buffer.  The ring buffer must not be in use
+ * by any other task while this function is called.
+ *
+ * @param[in] pRingBuffer a pointer to the ring buffer, cannot be NULL.
+ * @param mirrorSize      the size of the mirror tail in bytes, must
+ *                        be less than half of the size of the linear
+ *                        buffer passed to the create function; use
+ *                        zero to remove the mirror.
+ * @return                zero on success else negative error code.
+ */
+int32_t uRingBufferSetMirror(uRingBuffer_t *pRingBuffer, size_t mirrorSize);
+
 /* ----------------------------------------------------------------
  * FUNCTIONS: PARSER
  * -------------------------------------------------------------- */
@@ -473,6 +700,42 @@ size_t uRingBufferStatReadLossHandle(uRingBuffer_t *pRingBuffer,
 size_t uRingBufferParseHandle(uRingBuffer_t *pRingBuffer, int32_t handle,
                               U_RING_BUFFER_PARSER_f *pParserList, void *pUserParam);
 
+/** Run a set of block parsers over the contents of the ring buffer;
+ * this is an alternative to uRingBufferParseHandle() which scales
+ * better with message length and with the rate at which data arrives.
+ * Bytes that cannot begin a message (i.e. are not a sync byte of any
+ * of the parsers) are skipped over without the parsers being involved.
+ * When a candidate message is begun, the parsers whose sync bytes
+ * match are fed its data, block by block; if the data runs out before
+ * a parser has concluded then #U_ERROR_COMMON_TIMEOUT is returned and
+ * the progress made is remembered against the read pointer, so that
+ * the next call continues where this one left off, provided that
+ * the read pointer has not been moved in the meantime.  If more than
+ * one parser completes a message within the same block, the one
+ * earliest in the list wins.
+ *
+ * @param[in] pRingBuffer a pointer to the ring buffer, cannot be NULL.
+ * @param handle          a read handle, as originally returned by
+ *                        uRingBufferTakeReadHandle(), or 0 for the
+ *                        "normal" read pointer.
+ * @param[in] pParserList a pointer to a list of no more than 32 parsers,
+ *                        terminated by an entry where pParser is NULL;
+ *                        this must remain valid, and should be the same
+ *                        list each time for a given handle, since
+ *                        progress is lost if it changes.
+ * @param[in] pUserParam  a user parameter to pass to each parser in the
+ *                        list.
+ * @return                the length of the message found at the read
+ *                        pointer or, if the read pointer is not at a
+ *                        message, the number of bytes that should be
+ *                        discarded to get to the next candidate, else
+ *                        #U_ERROR_COMMON_TIMEOUT if more data is needed
+ *                        or negative error code.
+ */
+int32_t uRingBufferParseBlockHandle(uRingBuffer_t *pRingBuffer, int32_t handle,
+                                    const uRingBufferBlockParser_t *pParserList,
+                                    void *pUserParam);
+
 /** Get a byte from the ring buffer while in a parser function.
  *
  * IMPORTANT: unlike all of the other ring-buffer functions, this function
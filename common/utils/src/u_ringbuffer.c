@@ -34,7 +34,7 @@
 #include "stdio.h"    // snprintf()
 
 #include "u_cfg_sw.h"
-#include "u_compiler.h" // For U_INLINE
+#include "u_compiler.h" // For U_INLINE and U_ATOMIC_XXX()
 
 #include "u_error_common.h"
 #include "u_assert.h"
@@ -56,6 +56,17 @@
  */
 #define U_RINGBUFFER_PREFIX "U_RINGBUFFER: "
 
+/** The maximum number of parsers that may be passed to
+ * uRingBufferParseBlockHandle(), the number of bits in activeBitmap
+ * of #uRingBufferParseProgress_t.
+ */
+#define U_RINGBUFFER_BLOCK_PARSER_MAX_NUM 32
+
+/** Round a size up to a multiple of eight so that each block
+ * parser's state is suitably aligned.
+ */
+#define U_RINGBUFFER_ALIGN_SIZE(x) (((x) + 7) & ~((size_t) 7))
+
 /* ----------------------------------------------------------------
  * TYPES
  * -------------------------------------------------------------- */
@@ -70,6 +81,24 @@ typedef struct {
     size_t bytesDiscard;
 } uRingBufferParseContext_t;
 
+/** The progress of uRingBufferParseBlockHandle() on a read pointer;
+ * the state of each parser follows this structure, at an offset
+ * of U_RINGBUFFER_ALIGN_SIZE(sizeof(uRingBufferParseProgress_t)).
+ */
+typedef struct {
+    const uRingBufferBlockParser_t *pParserList; /**< the parsers this is for. */
+    size_t numParsers;
+    int32_t syncByte;       /**< the sync byte if all of the parsers share
+                                 just the one, else -1. */
+    uint32_t syncBitmap[256 / 32]; /**< bit set for each sync byte. */
+    bool inCandidate;       /**< true if the read pointer is at the start
+                                 of a candidate message. */
+    size_t bytesFed;        /**< the number of bytes of the candidate
+                                 message passed to the parsers so far. */
+    uint32_t activeBitmap;  /**< the parsers still interested in the
+                                 candidate message. */
+} uRingBufferParseProgress_t;
+
 /* ----------------------------------------------------------------
  * PROTOTYPES
  * -------------------------------------------------------------- */
@@ -118,6 +147,142 @@ static U_INLINE const char *pPtrOffset(const char *pData, size_t offset,
     return pData;
 }
 
+// Lock the mutex of a ring buffer, unless it is an SPSC one.
+static U_INLINE void lockUnlessSpsc(const uRingBuffer_t *pRingBuffer)
+{
+    if (!pRingBuffer->isSpsc) {
+        uPortMutexLock((uPortMutexHandle_t) pRingBuffer->mutex);
+    }
+}
+
+// Unlock the mutex of a ring buffer, unless it is an SPSC one.
+static U_INLINE void unlockUnlessSpsc(const uRingBuffer_t *pRingBuffer)
+{
+    if (!pRingBuffer->isSpsc) {
+        uPortMutexUnlock((uPortMutexHandle_t) pRingBuffer->mutex);
+    }
+}
+
+// Get a read pointer; this is atomic since, for an SPSC ring
+// buffer, the consumer may be moving it without the mutex.
+static U_INLINE const char *pLoadRead(const uRingBuffer_t *pRingBuffer,
+                                      size_t index)
+{
+    return U_ATOMIC_LOAD_ACQUIRE(&(pRingBuffer->pDataRead[index]));
+}
+
+// Get the write pointer; this is atomic since, for an SPSC ring
+// buffer, the producer may be moving it without the mutex.
+static U_INLINE char *pLoadWrite(const uRingBuffer_t *pRingBuffer)
+{
+    return U_ATOMIC_LOAD_ACQUIRE(&(pRingBuffer->pDataWrite));
+}
+
+// Copy data just written to the start of the ring into the mirror
+// tail, if there is one; the data at pStart must not wrap.
+static U_INLINE void mirror(uRingBuffer_t *pRingBuffer, const char *pStart,
+                            size_t length)
+{
+    size_t offset = pStart - pRingBuffer->pBuffer;
+
+    if (offset < pRingBuffer->mirrorSize) {
+        if (length > pRingBuffer->mirrorSize - offset) {
+            length = pRingBuffer->mirrorSize - offset;
+        }
+        memcpy(pRingBuffer->pBuffer + pRingBuffer->size + offset, pStart, length);
+    }
+}
+
+// Forget any block parsing progress on a read pointer, to be
+// called whenever that read pointer is moved.
+static U_INLINE void parseProgressReset(uRingBuffer_t *pRingBuffer,
+                                        size_t index)
+{
+    uRingBufferParseProgress_t *pProgress;
+
+    if (pRingBuffer->ppParseProgress != NULL) {
+        pProgress = (uRingBufferParseProgress_t *) pRingBuffer->ppParseProgress[index];
+        if (pProgress != NULL) {
+            pProgress->inCandidate = false;
+        }
+    }
+}
+
+// Return true if the read pointer at index must not be overrun by
+// an add, i.e. it is in use and can be read from; the "normal" read
+// pointer, when it can't be read, is instead pushed along by adds.
+static U_INLINE bool isTracked(const uRingBuffer_t *pRingBuffer, size_t index)
+{
+    return (pRingBuffer->pDataRead[index] != NULL) &&
+           ((index > 0) || !pRingBuffer->readHandleRequired);
+}
+
+// Work out which is the slowest of the tracked read pointers, i.e.
+// the one with the most data waiting, and how many are there; this
+// is only done when the last read pointer at the slowest position
+// moves on, so the cost is spread across the reads.  The ring
+// buffer's mutex should be locked before this is called.
+static void slowestFind(uRingBuffer_t *pRingBuffer)
+{
+    size_t used;
+    size_t usedMax = 0;
+
+    pRingBuffer->pDataReadSlowest = NULL;
+    pRingBuffer->numAtSlowest = 0;
+    for (size_t x = 0; x < pRingBuffer->maxNumReadPointers; x++) {
+        if (isTracked(pRingBuffer, x)) {
+            used = ptrDiff(pRingBuffer->pDataRead[x], pRingBuffer->pDataWrite,
+                           pRingBuffer->size);
+            if ((pRingBuffer->numAtSlowest == 0) || (used > usedMax)) {
+                pRingBuffer->pDataReadSlowest = pRingBuffer->pDataRead[x];
+                pRingBuffer->numAtSlowest = 1;
+                usedMax = used;
+            } else if (used == usedMax) {
+                pRingBuffer->numAtSlowest++;
+            }
+        }
+    }
+    pRingBuffer->slowestValid = true;
+}
+
+// Record the amount of data waiting at a read pointer in its
+// high-water mark.
+static U_INLINE void highWaterUpdate(uRingBuffer_t *pRingBuffer, size_t index)
+{
+    size_t *pHighWater = &(pRingBuffer->statHighWaterNormalBytes);
+    size_t dataSize;
+
+    if (index > 0) {
+        pHighWater = &(pRingBuffer->statHighWaterBytes[index]);
+    }
+    dataSize = ptrDiff(pLoadRead(pRingBuffer, index), pLoadWrite(pRingBuffer),
+                       pRingBuffer->size);
+    if (dataSize > *pHighWater) {
+        *pHighWater = dataSize;
+    }
+}
+
+// To be called when a read pointer, which must not be NULL, is about
+// to be moved on or given back.  Since the data waiting at a read
+// pointer only grows until it is moved, this is the moment to update
+// its high-water mark.  And if it was one of the slowest read pointers
+// there is now one fewer of those; once there are none they must be
+// found again.  The ring buffer's mutex should be locked before this
+// is called; not for an SPSC ring buffer, where the consumer moves
+// the read pointer without the mutex.
+static void readPointerMoving(uRingBuffer_t *pRingBuffer, size_t index)
+{
+    highWaterUpdate(pRingBuffer, index);
+    if (pRingBuffer->slowestValid &&
+        (pRingBuffer->pDataRead[index] == pRingBuffer->pDataReadSlowest) &&
+        isTracked(pRingBuffer, index)) {
+        pRingBuffer->numAtSlowest--;
+        if (pRingBuffer->numAtSlowest == 0) {
+            pRingBuffer->slowestValid = false;
+        }
+    }
+}
+
 // The ring buffer's mutex should be locked before this is called
 static void bufferReset(uRingBuffer_t *pRingBuffer)
 {
@@ -129,10 +294,12 @@ static void bufferReset(uRingBuffer_t *pRingBuffer)
         if (pRingBuffer->pDataRead[x] != NULL) {
             pRingBuffer->pDataRead[x] = pRingBuffer->pBuffer;
         }
+        parseProgressReset(pRingBuffer, x);
     }
     pRingBuffer->pDataWrite = pRingBuffer->pBuffer;
     // The default handle-less read pointer can always be set
     pRingBuffer->pDataRead[0] = pRingBuffer->pDataWrite;
+    pRingBuffer->slowestValid = false;
 }
 
 static int32_t createCommon(uRingBuffer_t *pRingBuffer, char *pLinearBuffer, size_t size)
@@ -143,84 +310,190 @@ static int32_t createCommon(uRingBuffer_t *pRingBuffer, char *pLinearBuffer, siz
     return uPortMutexCreate((uPortMutexHandle_t *) &pRingBuffer->mutex);
 }
 
-// The ring buffer's mutex should be locked before this is called
+// The ring buffer's mutex should be locked before this is called,
+// unless this is an SPSC ring buffer and we are the consumer.
 static size_t read(uRingBuffer_t *pRingBuffer, int32_t handle, char *pData,
                    size_t length, size_t offset, bool destructive)
 {
     size_t bytesRead = 0;
     size_t available;
+    size_t contiguous;
     const char *pSource;
+    char *pWrite;
 
     if ((handle >= 0) && (handle < (int32_t) pRingBuffer->maxNumReadPointers) &&
         (pRingBuffer->pDataRead[handle] != NULL)) {
 
-        pSource = pPtrOffset(pRingBuffer->pDataRead[handle], offset,
-                             pRingBuffer->pBuffer, pRingBuffer->size);
-        available = ptrDiff(pSource, pRingBuffer->pDataWrite, pRingBuffer->size);
-        if (length > available) {
-            length = available;
+        // Get the write pointer once so that, for an SPSC
+        // ring buffer, we work on a consistent view of it
+        pWrite = pLoadWrite(pRingBuffer);
+        pSource = pRingBuffer->pDataRead[handle];
+        available = ptrDiff(pSource, pWrite, pRingBuffer->size);
+        if (offset < available) {
+            available -= offset;
+            pSource = pPtrOffset(pSource, offset, pRingBuffer->pBuffer,
+                                 pRingBuffer->size);
+            if (length > available) {
+                length = available;
+            }
+            // Copy in at most two pieces, either side of the wrap
+            contiguous = (pRingBuffer->pBuffer + pRingBuffer->size) - pSource;
+            if (contiguous > length) {
+                contiguous = length;
+            }
+            if (pData != NULL) {
+                memcpy(pData, pSource, contiguous);
+                memcpy(pData + contiguous, pRingBuffer->pBuffer, length - contiguous);
+            }
+            pSource = pPtrOffset(pSource, length, pRingBuffer->pBuffer,
+                                 pRingBuffer->size);
+            bytesRead = length;
+            if (destructive && (length > 0)) {
+                if (!pRingBuffer->isSpsc) {
+                    readPointerMoving(pRingBuffer, handle);
+                }
+                parseProgressReset(pRingBuffer, handle);
+                // Release the space only once the data has been copied out
+                U_ATOMIC_STORE_RELEASE(&(pRingBuffer->pDataRead[handle]), pSource);
+            }
         }
+    }
 
-        while (bytesRead < length) {
-            if (pData != NULL) {
-                *pData = *pSource;
-                pData++;
+    return bytesRead;
+}
+
+// The ring buffer's mutex should be locked before this is called,
+// unless this is an SPSC ring buffer and we are the consumer; pSpans
+// must have been emptied.
+static size_t peekSpans(const uRingBuffer_t *pRingBuffer, int32_t handle,
+                        uRingBufferSpan_t *pSpans)
+{
+    size_t available = 0;
+    size_t contiguous;
+    const char *pSource;
+
+    if ((handle >= 0) && (handle < (int32_t) pRingBuffer->maxNumReadPointers) &&
+        (pRingBuffer->pDataRead[handle] != NULL)) {
+        pSource = pRingBuffer->pDataRead[handle];
+        available = ptrDiff(pSource, pLoadWrite(pRingBuffer), pRingBuffer->size);
+        if (available > 0) {
+            // The first span may run on into the mirror tail
+            contiguous = (pRingBuffer->pBuffer + pRingBuffer->size +
+                          pRingBuffer->mirrorSize) - pSource;
+            if (contiguous > available) {
+                contiguous = available;
+            }
+            pSpans[0].pData = pSource;
+            pSpans[0].length = contiguous;
+            if (available > contiguous) {
+                pSpans[1].pData = pPtrOffset(pSource, contiguous, pRingBuffer->pBuffer,
+                                             pRingBuffer->size);
+                pSpans[1].length = available - contiguous;
             }
-            pSource = pPtrInc(pSource, pRingBuffer->pBuffer, pRingBuffer->size);
-            bytesRead++;
         }
-        if (destructive) {
-            pRingBuffer->pDataRead[handle] = pSource;
+    }
+
+    return available;
+}
+
+// Make room for length bytes of data ahead of the read pointer at
+// index, if it is in use, returning false if that can't be done.
+// The ring buffer's mutex should be locked before this is called,
+// unless this is an SPSC ring buffer and we are the producer, in
+// which case destructive must be false.
+static bool makeRoom(uRingBuffer_t *pRingBuffer, size_t index,
+                     size_t length, bool destructive)
+{
+    bool roomMade = true;
+    size_t lost;
+    size_t used;
+    const char *pRead = pLoadRead(pRingBuffer, index);
+
+    if (pRead != NULL) {
+        used = ptrDiff(pRead, pRingBuffer->pDataWrite, pRingBuffer->size);
+        used++; // Account for the fact that we can't have the pointers overlap
+        if (used + length > pRingBuffer->size) {
+            // If we're on the "normal" read pointer (0) and it can't be used (because
+            // of the readHandleRequired flag) OR we are being destructive (so a
+            // forced add) and this data read pointer is not locked, then we
+            // throw away enough data to make it fit.
+            if (((index == 0) && pRingBuffer->readHandleRequired) ||
+                (destructive && ((index == 0) || (pRingBuffer->dataReadLockBitmap & (1ULL << (index - 1))) == 0))) {
+                lost = read(pRingBuffer, index, NULL, used + length - pRingBuffer->size, 0, true);
+                if (index == 0) {
+                    pRingBuffer->statReadLossNormalBytes += lost;
+                } else {
+                    pRingBuffer->statReadLossBytes[index] += lost;
+                }
+            } else {
+                roomMade = false;
+            }
         }
     }
 
-    return bytesRead;
+    return roomMade;
 }
 
-// The ring buffer's mutex should be locked before this is called
+// The ring buffer's mutex should be locked before this is called,
+// unless this is an SPSC ring buffer and we are the producer, in
+// which case destructive must be false.
 static bool add(uRingBuffer_t *pRingBuffer, const char *pData,
                 size_t length, bool destructive)
 {
     bool dataFitsInBuffer = true;
-    size_t lost;
-    size_t used;
+    size_t x = 0;
+    size_t contiguous;
+    char *pWrite;
 
     if (length >= pRingBuffer->size) {
         dataFitsInBuffer = false;
     } else {
-        for (size_t x = 0; (x < pRingBuffer->maxNumReadPointers) &&
+        if (!pRingBuffer->isSpsc) {
+            if (pRingBuffer->readHandleRequired) {
+                // The "normal" read pointer can't be read from and
+                // so isn't tracked: just push it along
+                makeRoom(pRingBuffer, 0, length, destructive);
+                x = 1;
+            }
+            if (!pRingBuffer->slowestValid) {
+                slowestFind(pRingBuffer);
+            }
+            if ((pRingBuffer->pDataReadSlowest == NULL) ||
+                (ptrDiff(pRingBuffer->pDataReadSlowest, pRingBuffer->pDataWrite,
+                         pRingBuffer->size) + 1 + length <= pRingBuffer->size)) {
+                // If there is room ahead of the slowest read pointer
+                // there is room ahead of all of them
+                x = pRingBuffer->maxNumReadPointers;
+            }
+        }
+        // Otherwise, go through the read pointers one by one
+        for (; (x < pRingBuffer->maxNumReadPointers) &&
              (dataFitsInBuffer || destructive); x++) {
-            if (pRingBuffer->pDataRead[x] != NULL) {
-                used = ptrDiff(pRingBuffer->pDataRead[x], pRingBuffer->pDataWrite, pRingBuffer->size);
-                used++; // Account for the fact that we can't have the pointers overlap
-                if (used + length > pRingBuffer->size) {
-                    // If we're on the "normal" read pointer (0) and it can't be used (because
-                    // of the readHandleRequired flag) OR we are being destructive (so a
-                    // forced add) and this data read pointer is not locked, then we
-                    // throw away enough data to make it fit.
-                    if (((x == 0) && pRingBuffer->readHandleRequired) ||
-                        (destructive && ((x == 0) || (pRingBuffer->dataReadLockBitmap & (1ULL << (x - 1))) == 0))) {
-                        lost = read(pRingBuffer, x, NULL, used + length - pRingBuffer->size, 0, true);
-                        if (x == 0) {
-                            pRingBuffer->statReadLossNormalBytes += lost;
-                        } else {
-                            pRingBuffer->statReadLossBytes[x] += lost;
-                        }
-                    } else {
-                        dataFitsInBuffer = false;
-                    }
-                }
+            if (!makeRoom(pRingBuffer, x, length, destructive)) {
+                dataFitsInBuffer = false;
             }
         }
     }
 
     if (dataFitsInBuffer) {
-        while (length > 0) {
-            *(pRingBuffer->pDataWrite) = *pData;
-            pRingBuffer->pDataWrite = (char *) pPtrInc(pRingBuffer->pDataWrite, pRingBuffer->pBuffer,
-                                                       pRingBuffer->size);
-            length--;
-            pData++;
+        // Copy in at most two pieces, either side of the wrap
+        pWrite = pRingBuffer->pDataWrite;
+        contiguous = (pRingBuffer->pBuffer + pRingBuffer->size) - pWrite;
+        if (contiguous > length) {
+            contiguous = length;
+        }
+        memcpy(pWrite, pData, contiguous);
+        mirror(pRingBuffer, pWrite, contiguous);
+        memcpy(pRingBuffer->pBuffer, pData + contiguous, length - contiguous);
+        mirror(pRingBuffer, pRingBuffer->pBuffer, length - contiguous);
+        pWrite = (char *) pPtrOffset(pWrite, length, pRingBuffer->pBuffer,
+                                     pRingBuffer->size);
+        // Only make the data visible once it is all there
+        U_ATOMIC_STORE_RELEASE(&(pRingBuffer->pDataWrite), pWrite);
+        if (pRingBuffer->isSpsc) {
+            // The consumer can't keep the high-water mark, it
+            // doesn't own the mutex, so the producer does it
+            highWaterUpdate(pRingBuffer, 0);
         }
     } else {
         pRingBuffer->statAddLossBytes += length;
@@ -259,28 +532,38 @@ static size_t availableSize(const uRingBuffer_t *pRingBuffer, bool max)
     size_t size = 0;
     size_t y = 0;
     bool foundADataReadPointer = false;
+    char *pWrite;
 
     if (pRingBuffer->pBuffer != NULL) {
 
-        U_PORT_MUTEX_LOCK((uPortMutexHandle_t) pRingBuffer->mutex);
+        lockUnlessSpsc(pRingBuffer);
 
+        pWrite = pLoadWrite(pRingBuffer);
         size = pRingBuffer->size;
-        for (size_t x = 0; x < pRingBuffer->maxNumReadPointers; x++) {
-            // If a read handle is required we ignore the data behind
-            // the "normal" read pointer as it's not possible to get
-            // at it
-            if ((pRingBuffer->pDataRead[x] != NULL) &&
-                ((x > 0) || !pRingBuffer->readHandleRequired)) {
-                // If we're doing max then we only take into account
-                // locked data buffer pointers and we ignore 0 since
-                // it is not lockable
-                if (!max || ((x > 0) && (pRingBuffer->dataReadLockBitmap & (1ULL << (x - 1))))) {
-                    y = pRingBuffer->size - ptrDiff(pRingBuffer->pDataRead[x], pRingBuffer->pDataWrite,
-                                                    pRingBuffer->size);
-                    if (y < size) {
-                        size = y;
+        if (!max && pRingBuffer->slowestValid) {
+            // The amount of room is set by the slowest read pointer
+            if (pRingBuffer->pDataReadSlowest != NULL) {
+                size -= ptrDiff(pRingBuffer->pDataReadSlowest, pWrite, pRingBuffer->size);
+                foundADataReadPointer = true;
+            }
+        } else {
+            for (size_t x = 0; x < pRingBuffer->maxNumReadPointers; x++) {
+                // If a read handle is required we ignore the data behind
+                // the "normal" read pointer as it's not possible to get
+                // at it
+                if ((pRingBuffer->pDataRead[x] != NULL) &&
+                    ((x > 0) || !pRingBuffer->readHandleRequired)) {
+                    // If we're doing max then we only take into account
+                    // locked data buffer pointers and we ignore 0 since
+                    // it is not lockable
+                    if (!max || ((x > 0) && (pRingBuffer->dataReadLockBitmap & (1ULL << (x - 1))))) {
+                        y = pRingBuffer->size - ptrDiff(pLoadRead(pRingBuffer, x), pWrite,
+                                                        pRingBuffer->size);
+                        if (y < size) {
+                            size = y;
+                        }
+                        foundADataReadPointer = true;
                     }
-                    foundADataReadPointer = true;
                 }
             }
         }
@@ -289,7 +572,7 @@ static size_t availableSize(const uRingBuffer_t *pRingBuffer, bool max)
             // If we didn't find a single data read pointer,
             // and we're not doing max, report what is in the
             // buffer anyway
-            size = pRingBuffer->size - ptrDiff(pRingBuffer->pBuffer, pRingBuffer->pDataWrite,
+            size = pRingBuffer->size - ptrDiff(pRingBuffer->pBuffer, pWrite,
                                                pRingBuffer->size);
         }
         if (size > 0) {
@@ -297,12 +580,214 @@ static size_t availableSize(const uRingBuffer_t *pRingBuffer, bool max)
             size--;
         }
 
-        U_PORT_MUTEX_UNLOCK((uPortMutexHandle_t) pRingBuffer->mutex);
+        unlockUnlessSpsc(pRingBuffer);
     }
 
     return size;
 }
 
+// Get the block parsing progress for a read pointer, allocating
+// it or starting it afresh if the parser list has changed; the ring
+// buffer's mutex should be locked before this is called.
+static uRingBufferParseProgress_t *pParseProgressGet(uRingBuffer_t *pRingBuffer,
+                                                     int32_t handle,
+                                                     const uRingBufferBlockParser_t *pParserList)
+{
+    uRingBufferParseProgress_t *pProgress = NULL;
+    size_t numParsers = 0;
+    size_t size = U_RINGBUFFER_ALIGN_SIZE(sizeof(uRingBufferParseProgress_t));
+    const uRingBufferBlockParser_t *pParser;
+    uint8_t syncByte;
+
+    if (pRingBuffer->ppParseProgress == NULL) {
+        pRingBuffer->ppParseProgress = (void **) pUPortMalloc(pRingBuffer->maxNumReadPointers *
+                                                              sizeof(void *));
+        if (pRingBuffer->ppParseProgress != NULL) {
+            memset(pRingBuffer->ppParseProgress, 0,
+                   pRingBuffer->maxNumReadPointers * sizeof(void *));
+        }
+    }
+    if (pRingBuffer->ppParseProgress != NULL) {
+        pProgress = (uRingBufferParseProgress_t *) pRingBuffer->ppParseProgress[handle];
+        if ((pProgress != NULL) && (pProgress->pParserList != pParserList)) {
+            uPortFree(pProgress);
+            pProgress = NULL;
+            pRingBuffer->ppParseProgress[handle] = NULL;
+        }
+        if (pProgress == NULL) {
+            for (pParser = pParserList; pParser->pParser != NULL; pParser++) {
+                size += U_RINGBUFFER_ALIGN_SIZE(pParser->stateSize);
+                numParsers++;
+            }
+            if (numParsers <= U_RINGBUFFER_BLOCK_PARSER_MAX_NUM) {
+                pProgress = (uRingBufferParseProgress_t *) pUPortMalloc(size);
+            }
+            if (pProgress != NULL) {
+                memset(pProgress, 0, sizeof(*pProgress));
+                pProgress->pParserList = pParserList;
+                pProgress->numParsers = numParsers;
+                pProgress->syncByte = -1;
+                for (pParser = pParserList; pParser->pParser != NULL; pParser++) {
+                    for (size_t x = 0; x < pParser->numSyncBytes; x++) {
+                        syncByte = (uint8_t) pParser->pSyncBytes[x];
+                        if (pProgress->syncByte < 0) {
+                            pProgress->syncByte = syncByte;
+                        } else if (pProgress->syncByte != syncByte) {
+                            // More than one, can't use memchr()
+                            pProgress->syncByte = 256;
+                        }
+                        pProgress->syncBitmap[syncByte >> 5] |= 1UL << (syncByte & 0x1f);
+                    }
+                }
+                if (pProgress->syncByte > 0xFF) {
+                    pProgress->syncByte = -1;
+                }
+                pRingBuffer->ppParseProgress[handle] = pProgress;
+            }
+        }
+    }
+
+    return pProgress;
+}
+
+// Find the offset of the first sync byte at or after offset in
+// the given spans, returning the total length of the spans if
+// there is none.
+static size_t findSync(const uRingBufferParseProgress_t *pProgress,
+                       const uRingBufferSpan_t *pSpans, size_t offset)
+{
+    size_t start = 0;
+    size_t length;
+    const uint8_t *pData;
+    const uint8_t *pFound = NULL;
+
+    for (size_t x = 0; (x < 2) && (pFound == NULL); x++) {
+        if (offset < start + pSpans[x].length) {
+            pData = (const uint8_t *) pSpans[x].pData + (offset - start);
+            length = start + pSpans[x].length - offset;
+            if (pProgress->syncByte >= 0) {
+                pFound = (const uint8_t *) memchr(pData, pProgress->syncByte, length);
+            } else {
+                for (; (length > 0) && (pFound == NULL); pData++, length--) {
+                    if (pProgress->syncBitmap[*pData >> 5] & (1UL << (*pData & 0x1f))) {
+                        pFound = pData;
+                    }
+                }
+            }
+            if (pFound != NULL) {
+                offset = start + (pFound - (const uint8_t *) pSpans[x].pData);
+            } else {
+                offset = start + pSpans[x].length;
+            }
+        }
+        start += pSpans[x].length;
+    }
+
+    return offset;
+}
+
+// Begin a candidate message with the given first byte.
+static void candidateBegin(uRingBufferParseProgress_t *pProgress, char first)
+{
+    const uRingBufferBlockParser_t *pParser = pProgress->pParserList;
+    char *pState = ((char *) pProgress) +
+                   U_RINGBUFFER_ALIGN_SIZE(sizeof(uRingBufferParseProgress_t));
+
+    pProgress->activeBitmap = 0;
+    for (size_t x = 0; x < pProgress->numParsers; x++, pParser++) {
+        if ((pParser->numSyncBytes > 0) &&
+            (memchr(pParser->pSyncBytes, first, pParser->numSyncBytes) != NULL)) {
+            pProgress->activeBitmap |= 1UL << x;
+            memset(pState, 0, pParser->stateSize);
+        }
+        pState += U_RINGBUFFER_ALIGN_SIZE(pParser->stateSize);
+    }
+    pProgress->bytesFed = 0;
+    pProgress->inCandidate = true;
+}
+
+// Feed a block of a candidate message to the parsers that are
+// still active, returning the number of bytes of the block that
+// completed a message or U_ERROR_COMMON_TIMEOUT.
+static int32_t candidateFeed(uRingBufferParseProgress_t *pProgress,
+                             const char *pData, size_t length,
+                             void *pUserParam)
+{
+    int32_t errorCodeOrLength = (int32_t) U_ERROR_COMMON_TIMEOUT;
+    const uRingBufferBlockParser_t *pParser = pProgress->pParserList;
+    char *pState = ((char *) pProgress) +
+                   U_RINGBUFFER_ALIGN_SIZE(sizeof(uRingBufferParseProgress_t));
+    int32_t x;
+
+    for (size_t y = 0; (y < pProgress->numParsers) && (errorCodeOrLength < 0); y++, pParser++) {
+        if (pProgress->activeBitmap & (1UL << y)) {
+            x = pParser->pParser(pState, pData, length, pUserParam);
+            if ((x > 0) && (x <= (int32_t) length)) {
+                errorCodeOrLength = x;
+            } else if (x != (int32_t) U_ERROR_COMMON_TIMEOUT) {
+                pProgress->activeBitmap &= ~(1UL << y);
+            }
+        }
+        pState += U_RINGBUFFER_ALIGN_SIZE(pParser->stateSize);
+    }
+
+    return errorCodeOrLength;
+}
+
+// Run the block parsers over the data at a read pointer; the ring
+// buffer's mutex should be locked before this is called.
+static int32_t parseBlock(uRingBuffer_t *pRingBuffer, int32_t handle,
+                          uRingBufferParseProgress_t *pProgress,
+                          void *pUserParam)
+{
+    int32_t errorCodeOrLength = (int32_t) U_ERROR_COMMON_TIMEOUT;
+    uRingBufferSpan_t spans[2] = {0};
+    size_t available;
+    size_t start = 0;
+    size_t offset;
+
+    available = peekSpans(pRingBuffer, handle, spans);
+    if (pProgress->inCandidate && (pProgress->bytesFed > available)) {
+        // Shouldn't happen but, just in case, start again
+        pProgress->inCandidate = false;
+    }
+    if ((available > 0) && !pProgress->inCandidate) {
+        offset = findSync(pProgress, spans, 0);
+        if (offset > 0) {
+            // Not at a candidate message: discard up to the next one
+            errorCodeOrLength = (int32_t) offset;
+        } else {
+            candidateBegin(pProgress, *spans[0].pData);
+        }
+    }
+    if (pProgress->inCandidate) {
+        // Feed the parsers whatever they have not yet seen
+        for (size_t x = 0; (x < 2) && (pProgress->activeBitmap != 0) &&
+             (errorCodeOrLength < 0); x++) {
+            if (pProgress->bytesFed < start + spans[x].length) {
+                offset = pProgress->bytesFed - start;
+                errorCodeOrLength = candidateFeed(pProgress, spans[x].pData + offset,
+                                                  spans[x].length - offset, pUserParam);
+                if (errorCodeOrLength > 0) {
+                    errorCodeOrLength += (int32_t) pProgress->bytesFed;
+                } else {
+                    pProgress->bytesFed += spans[x].length - offset;
+                }
+            }
+            start += spans[x].length;
+        }
+        if (errorCodeOrLength > 0) {
+            pProgress->inCandidate = false;
+        } else if (pProgress->activeBitmap == 0) {
+            // Not a message after all: discard up to the next candidate
+            pProgress->inCandidate = false;
+            errorCodeOrLength = (int32_t) findSync(pProgress, spans, 1);
+        }
+    }
+
+    return errorCodeOrLength;
+}
+
 // Hex print for debug purposes.
 static void printHex(const char *pBuffer, size_t size)
 {
@@ -398,6 +883,19 @@ int32_t uRingBufferCreate(uRingBuffer_t *pRingBuffer, char *pLinearBuffer, size_
     return createCommon(pRingBuffer, pLinearBuffer, size);
 }
 
+int32_t uRingBufferCreateSpsc(uRingBuffer_t *pRingBuffer, char *pLinearBuffer, size_t size)
+{
+    int32_t errorCode = uRingBufferCreate(pRingBuffer, pLinearBuffer, size);
+
+    if (errorCode == 0) {
+        // The mutex is still created, for the functions which
+        // are not on the data path, but Add/Read etc. will not use it
+        pRingBuffer->isSpsc = true;
+    }
+
+    return errorCode;
+}
+
 void uRingBufferDelete(uRingBuffer_t *pRingBuffer)
 {
     if ((pRingBuffer != NULL) && (pRingBuffer->mutex != NULL)) {
@@ -406,6 +904,15 @@ void uRingBufferDelete(uRingBuffer_t *pRingBuffer)
             pRingBuffer->pDataRead = NULL;
             uPortFree(pRingBuffer->statReadLossBytes);
             pRingBuffer->statReadLossBytes = NULL;
+            uPortFree(pRingBuffer->statHighWaterBytes);
+            pRingBuffer->statHighWaterBytes = NULL;
+        }
+        if (pRingBuffer->ppParseProgress != NULL) {
+            for (size_t x = 0; x < pRingBuffer->maxNumReadPointers; x++) {
+                uPortFree(pRingBuffer->ppParseProgress[x]);
+            }
+            uPortFree(pRingBuffer->ppParseProgress);
+            pRingBuffer->ppParseProgress = NULL;
         }
         pRingBuffer->maxNumReadPointers = 0;
         uPortMutexDelete((uPortMutexHandle_t) pRingBuffer->mutex);
@@ -420,11 +927,11 @@ bool uRingBufferAdd(uRingBuffer_t *pRingBuffer, const char *pData, size_t length
 
     if (pRingBuffer->pBuffer != NULL) {
 
-        U_PORT_MUTEX_LOCK((uPortMutexHandle_t) pRingBuffer->mutex);
+        lockUnlessSpsc(pRingBuffer);
 
         dataFitsInBuffer = add(pRingBuffer, pData, length, false);
 
-        U_PORT_MUTEX_UNLOCK((uPortMutexHandle_t) pRingBuffer->mutex);
+        unlockUnlessSpsc(pRingBuffer);
     }
 
     return dataFitsInBuffer;
@@ -436,11 +943,13 @@ bool uRingBufferForceAdd(uRingBuffer_t *pRingBuffer, const char *pData, size_t l
 
     if (pRingBuffer->pBuffer != NULL) {
 
-        U_PORT_MUTEX_LOCK((uPortMutexHandle_t) pRingBuffer->mutex);
+        lockUnlessSpsc(pRingBuffer);
 
-        dataFitsInBuffer = add(pRingBuffer, pData, length, true);
+        // The producer of an SPSC ring buffer can't move
+        // the read pointer, so no forcing in that case
+        dataFitsInBuffer = add(pRingBuffer, pData, length, !pRingBuffer->isSpsc);
 
-        U_PORT_MUTEX_UNLOCK((uPortMutexHandle_t) pRingBuffer->mutex);
+        unlockUnlessSpsc(pRingBuffer);
     }
 
     return dataFitsInBuffer;
@@ -452,11 +961,11 @@ size_t uRingBufferRead(uRingBuffer_t *pRingBuffer, char *pData, size_t length)
 
     if ((pRingBuffer->pBuffer != NULL) && !pRingBuffer->readHandleRequired) {
 
-        U_PORT_MUTEX_LOCK((uPortMutexHandle_t) pRingBuffer->mutex);
+        lockUnlessSpsc(pRingBuffer);
 
         bytesRead = read(pRingBuffer, 0, pData, length, 0, true);
 
-        U_PORT_MUTEX_UNLOCK((uPortMutexHandle_t) pRingBuffer->mutex);
+        unlockUnlessSpsc(pRingBuffer);
     }
 
     return bytesRead;
@@ -469,11 +978,11 @@ size_t uRingBufferPeek(uRingBuffer_t *pRingBuffer, char *pData, size_t length,
 
     if ((pRingBuffer->pBuffer != NULL) && !pRingBuffer->readHandleRequired) {
 
-        U_PORT_MUTEX_LOCK((uPortMutexHandle_t) pRingBuffer->mutex);
+        lockUnlessSpsc(pRingBuffer);
 
         bytesRead = read(pRingBuffer, 0, pData, length, offset, false);
 
-        U_PORT_MUTEX_UNLOCK((uPortMutexHandle_t) pRingBuffer->mutex);
+        unlockUnlessSpsc(pRingBuffer);
     }
 
     return bytesRead;
@@ -485,14 +994,14 @@ size_t uRingBufferDataSize(const uRingBuffer_t *pRingBuffer)
 
     if (pRingBuffer->pBuffer != NULL) {
 
-        U_PORT_MUTEX_LOCK((uPortMutexHandle_t) pRingBuffer->mutex);
+        lockUnlessSpsc(pRingBuffer);
 
         if (!pRingBuffer->readHandleRequired) {
             // Only report if the non-handled read can be used
-            dataSize = ptrDiff(pRingBuffer->pDataRead[0], pRingBuffer->pDataWrite, pRingBuffer->size);
+            dataSize = ptrDiff(pLoadRead(pRingBuffer, 0), pLoadWrite(pRingBuffer), pRingBuffer->size);
         }
 
-        U_PORT_MUTEX_UNLOCK((uPortMutexHandle_t) pRingBuffer->mutex);
+        unlockUnlessSpsc(pRingBuffer);
     }
 
     return dataSize;
@@ -507,11 +1016,15 @@ void uRingBufferFlush(uRingBuffer_t *pRingBuffer)
 {
     if (pRingBuffer->pBuffer != NULL) {
 
-        U_PORT_MUTEX_LOCK((uPortMutexHandle_t) pRingBuffer->mutex);
+        lockUnlessSpsc(pRingBuffer);
 
-        pRingBuffer->pDataRead[0] = pRingBuffer->pDataWrite;
+        if (!pRingBuffer->isSpsc) {
+            readPointerMoving(pRingBuffer, 0);
+        }
+        parseProgressReset(pRingBuffer, 0);
+        U_ATOMIC_STORE_RELEASE(&(pRingBuffer->pDataRead[0]), pLoadWrite(pRingBuffer));
 
-        U_PORT_MUTEX_UNLOCK((uPortMutexHandle_t) pRingBuffer->mutex);
+        unlockUnlessSpsc(pRingBuffer);
     }
 }
 
@@ -523,21 +1036,25 @@ void uRingBufferFlushValue(uRingBuffer_t *pRingBuffer, char value, size_t length
 
     if (pRingBuffer->pBuffer != NULL) {
 
-        U_PORT_MUTEX_LOCK((uPortMutexHandle_t) pRingBuffer->mutex);
+        lockUnlessSpsc(pRingBuffer);
 
         pData = pRingBuffer->pDataRead[0];
-        dataSize = ptrDiff(pData, pRingBuffer->pDataWrite, pRingBuffer->size);
+        dataSize = ptrDiff(pData, pLoadWrite(pRingBuffer), pRingBuffer->size);
         if (dataSize >= length) {
             while ((bytesRead < dataSize) && (*pData == value)) {
                 pData = pPtrInc(pData, pRingBuffer->pBuffer, pRingBuffer->size);
                 bytesRead++;
             }
             if (bytesRead >= length) {
-                pRingBuffer->pDataRead[0] = pData;
+                if (!pRingBuffer->isSpsc) {
+                    readPointerMoving(pRingBuffer, 0);
+                }
+                parseProgressReset(pRingBuffer, 0);
+                U_ATOMIC_STORE_RELEASE(&(pRingBuffer->pDataRead[0]), pData);
             }
         }
 
-        U_PORT_MUTEX_UNLOCK((uPortMutexHandle_t) pRingBuffer->mutex);
+        unlockUnlessSpsc(pRingBuffer);
     }
 }
 
@@ -585,6 +1102,25 @@ size_t uRingBufferStatAddLoss(uRingBuffer_t *pRingBuffer)
     return bytesLost;
 }
 
+size_t uRingBufferStatHighWater(uRingBuffer_t *pRingBuffer)
+{
+    size_t highWater = 0;
+
+    if (pRingBuffer->pBuffer != NULL) {
+
+        U_PORT_MUTEX_LOCK((uPortMutexHandle_t) pRingBuffer->mutex);
+
+        // The high-water mark is only updated when the read pointer
+        // moves, so take into account what is waiting now
+        highWaterUpdate(pRingBuffer, 0);
+        highWater = pRingBuffer->statHighWaterNormalBytes;
+
+        U_PORT_MUTEX_UNLOCK((uPortMutexHandle_t) pRingBuffer->mutex);
+    }
+
+    return highWater;
+}
+
 /* ----------------------------------------------------------------
  * PUBLIC FUNCTIONS: MULTIPLE READERS
  * -------------------------------------------------------------- */
@@ -598,13 +1134,16 @@ int32_t uRingBufferCreateWithReadHandle(uRingBuffer_t *pRingBuffer, char *pLinea
     maxNumReadHandles++; // Add one more for the non-handled read
     pRingBuffer->pDataRead = (const char **) pUPortMalloc((maxNumReadHandles) * sizeof(const char *));
     pRingBuffer->statReadLossBytes = (size_t *) pUPortMalloc((maxNumReadHandles) * sizeof(size_t));
+    pRingBuffer->statHighWaterBytes = (size_t *) pUPortMalloc((maxNumReadHandles) * sizeof(size_t));
     if ((pRingBuffer->pDataRead != NULL) && (pRingBuffer->statReadLossBytes != NULL) &&
+        (pRingBuffer->statHighWaterBytes != NULL) &&
         (maxNumReadHandles < (sizeof(pRingBuffer->dataReadLockBitmap) * 8))) {
         pRingBuffer->isMalloced = true;
         pRingBuffer->maxNumReadPointers = maxNumReadHandles;
         for (size_t x = 0; x < pRingBuffer->maxNumReadPointers; x++) {
             pRingBuffer->pDataRead[x] = NULL;
             pRingBuffer->statReadLossBytes[x] = 0;
+            pRingBuffer->statHighWaterBytes[x] = 0;
         }
         errorCode = createCommon(pRingBuffer, pLinearBuffer, size);
     }
@@ -613,6 +1152,8 @@ int32_t uRingBufferCreateWithReadHandle(uRingBuffer_t *pRingBuffer, char *pLinea
         pRingBuffer->pDataRead = NULL;
         uPortFree(pRingBuffer->statReadLossBytes);
         pRingBuffer->statReadLossBytes = NULL;
+        uPortFree(pRingBuffer->statHighWaterBytes);
+        pRingBuffer->statHighWaterBytes = NULL;
         pRingBuffer->maxNumReadPointers = 0;
     }
 
@@ -621,7 +1162,9 @@ int32_t uRingBufferCreateWithReadHandle(uRingBuffer_t *pRingBuffer, char *pLinea
 
 void uRingBufferSetReadRequiresHandle(uRingBuffer_t *pRingBuffer, bool onNotOff)
 {
-    if (pRingBuffer->pBuffer != NULL) {
+    // Not for an SPSC ring buffer, where only the consumer
+    // may move the "normal" read pointer
+    if ((pRingBuffer->pBuffer != NULL) && !pRingBuffer->isSpsc) {
 
         U_PORT_MUTEX_LOCK((uPortMutexHandle_t) pRingBuffer->mutex);
 
@@ -630,8 +1173,11 @@ void uRingBufferSetReadRequiresHandle(uRingBuffer_t *pRingBuffer, bool onNotOff)
             // it off, set the non-handled read
             // pointer so that it gets sensible data
             pRingBuffer->pDataRead[0] = pRingBuffer->pDataWrite;
+            parseProgressReset(pRingBuffer, 0);
         }
         pRingBuffer->readHandleRequired = onNotOff;
+        // The "normal" read pointer is only tracked if it can be read
+        pRingBuffer->slowestValid = false;
 
         U_PORT_MUTEX_UNLOCK((uPortMutexHandle_t) pRingBuffer->mutex);
     }
@@ -658,6 +1204,11 @@ int32_t uRingBufferTakeReadHandle(uRingBuffer_t *pRingBuffer)
             if (pRingBuffer->pDataRead[x] == NULL) {
                 pRingBuffer->pDataRead[x] = pRingBuffer->pDataWrite;
                 pRingBuffer->statReadLossBytes[x] = 0;
+                pRingBuffer->statHighWaterBytes[x] = 0;
+                parseProgressReset(pRingBuffer, x);
+                // The new read pointer has no data waiting but there may
+                // not have been any tracked read pointers before
+                pRingBuffer->slowestValid = false;
                 readHandle = x;
             }
         }
@@ -675,8 +1226,12 @@ void uRingBufferGiveReadHandle(uRingBuffer_t *pRingBuffer, int32_t handle)
         U_PORT_MUTEX_LOCK((uPortMutexHandle_t) pRingBuffer->mutex);
 
         if ((handle >= 1) && (handle < (int32_t) pRingBuffer->maxNumReadPointers)) {
+            if (pRingBuffer->pDataRead[handle] != NULL) {
+                readPointerMoving(pRingBuffer, handle);
+            }
             pRingBuffer->pDataRead[handle] = NULL;
             pRingBuffer->dataReadLockBitmap &= ~(1ULL << (handle - 1));
+            parseProgressReset(pRingBuffer, handle);
         }
 
         U_PORT_MUTEX_UNLOCK((uPortMutexHandle_t) pRingBuffer->mutex);
@@ -781,7 +1336,9 @@ void uRingBufferFlushHandle(uRingBuffer_t *pRingBuffer, int32_t handle)
 
         if ((handle >= 1) && (handle < (int32_t) pRingBuffer->maxNumReadPointers) &&
             (pRingBuffer->pDataRead[handle] != NULL)) {
+            readPointerMoving(pRingBuffer, handle);
             pRingBuffer->pDataRead[handle] = pRingBuffer->pDataWrite;
+            parseProgressReset(pRingBuffer, handle);
         }
 
         U_PORT_MUTEX_UNLOCK((uPortMutexHandle_t) pRingBuffer->mutex);
@@ -808,6 +1365,107 @@ size_t uRingBufferStatReadLossHandle(uRingBuffer_t *pRingBuffer,
     return bytesLost;
 }
 
+size_t uRingBufferStatHighWaterHandle(uRingBuffer_t *pRingBuffer,
+                                      int32_t handle)
+{
+    size_t highWater = 0;
+
+    if (pRingBuffer->pBuffer != NULL) {
+
+        U_PORT_MUTEX_LOCK((uPortMutexHandle_t) pRingBuffer->mutex);
+
+        if ((handle >= 1) && (handle < (int32_t) pRingBuffer->maxNumReadPointers) &&
+            (pRingBuffer->pDataRead[handle] != NULL)) {
+            highWaterUpdate(pRingBuffer, handle);
+            highWater = pRingBuffer->statHighWaterBytes[handle];
+        }
+
+        U_PORT_MUTEX_UNLOCK((uPortMutexHandle_t) pRingBuffer->mutex);
+    }
+
+    return highWater;
+}
+
+/* ----------------------------------------------------------------
+ * PUBLIC FUNCTIONS: SPANS
+ * -------------------------------------------------------------- */
+
+size_t uRingBufferPeekSpans(uRingBuffer_t *pRingBuffer, uRingBufferSpan_t *pSpans)
+{
+    size_t available = 0;
+
+    pSpans[0].pData = NULL;
+    pSpans[0].length = 0;
+    pSpans[1].pData = NULL;
+    pSpans[1].length = 0;
+    if ((pRingBuffer->pBuffer != NULL) && !pRingBuffer->readHandleRequired) {
+
+        lockUnlessSpsc(pRingBuffer);
+
+        available = peekSpans(pRingBuffer, 0, pSpans);
+
+        unlockUnlessSpsc(pRingBuffer);
+    }
+
+    return available;
+}
+
+size_t uRingBufferCommitRead(uRingBuffer_t *pRingBuffer, size_t length)
+{
+    return uRingBufferRead(pRingBuffer, NULL, length);
+}
+
+size_t uRingBufferPeekSpansHandle(uRingBuffer_t *pRingBuffer, int32_t handle,
+                                  uRingBufferSpan_t *pSpans)
+{
+    size_t available = 0;
+
+    pSpans[0].pData = NULL;
+    pSpans[0].length = 0;
+    pSpans[1].pData = NULL;
+    pSpans[1].length = 0;
+    if (pRingBuffer->pBuffer != NULL) {
+
+        U_PORT_MUTEX_LOCK((uPortMutexHandle_t) pRingBuffer->mutex);
+
+        available = peekSpans(pRingBuffer, handle, pSpans);
+
+        U_PORT_MUTEX_UNLOCK((uPortMutexHandle_t) pRingBuffer->mutex);
+    }
+
+    return available;
+}
+
+size_t uRingBufferCommitReadHandle(uRingBuffer_t *pRingBuffer, int32_t handle,
+                                   size_t length)
+{
+    return uRingBufferReadHandle(pRingBuffer, handle, NULL, length);
+}
+
+int32_t uRingBufferSetMirror(uRingBuffer_t *pRingBuffer, size_t mirrorSize)
+{
+    int32_t errorCode = (int32_t) U_ERROR_COMMON_INVALID_PARAMETER;
+    size_t linearBufferSize;
+
+    if (pRingBuffer->pBuffer != NULL) {
+
+        U_PORT_MUTEX_LOCK((uPortMutexHandle_t) pRingBuffer->mutex);
+
+        linearBufferSize = pRingBuffer->size + pRingBuffer->mirrorSize;
+        if ((mirrorSize < linearBufferSize) &&
+            (mirrorSize < linearBufferSize - mirrorSize)) {
+            pRingBuffer->size = linearBufferSize - mirrorSize;
+            pRingBuffer->mirrorSize = mirrorSize;
+            bufferReset(pRingBuffer);
+            errorCode = (int32_t) U_ERROR_COMMON_SUCCESS;
+        }
+
+        U_PORT_MUTEX_UNLOCK((uPortMutexHandle_t) pRingBuffer->mutex);
+    }
+
+    return errorCode;
+}
+
 /* ----------------------------------------------------------------
  * FUNCTIONS: PARSER
  * -------------------------------------------------------------- */
@@ -867,6 +1525,32 @@ size_t uRingBufferParseHandle(uRingBuffer_t *pRingBuffer, int32_t handle,
     return errorCodeOrLength;
 }
 
+int32_t uRingBufferParseBlockHandle(uRingBuffer_t *pRingBuffer, int32_t handle,
+                                    const uRingBufferBlockParser_t *pParserList,
+                                    void *pUserParam)
+{
+    int32_t errorCodeOrLength = (int32_t) U_ERROR_COMMON_INVALID_PARAMETER;
+    uRingBufferParseProgress_t *pProgress;
+
+    if ((pRingBuffer->pBuffer != NULL) && (pParserList != NULL)) {
+
+        U_PORT_MUTEX_LOCK((uPortMutexHandle_t) pRingBuffer->mutex);
+
+        if ((handle >= 0) && (handle < (int32_t) pRingBuffer->maxNumReadPointers) &&
+            (pRingBuffer->pDataRead[handle] != NULL)) {
+            errorCodeOrLength = (int32_t) U_ERROR_COMMON_NO_MEMORY;
+            pProgress = pParseProgressGet(pRingBuffer, handle, pParserList);
+            if (pProgress != NULL) {
+                errorCodeOrLength = parseBlock(pRingBuffer, handle, pProgress, pUserParam);
+            }
+        }
+
+        U_PORT_MUTEX_UNLOCK((uPortMutexHandle_t) pRingBuffer->mutex);
+    }
+
+    return errorCodeOrLength;
+}
+
 bool uRingBufferGetByteUnprotected(uParseHandle_t parseHandle, void *p)
 {
     uRingBufferParseContext_t *pCtx = (uRingBufferParseContext_t *)parseHandle;
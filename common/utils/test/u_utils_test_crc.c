@@ -0,0 +1,371 @@
+/*
+ * Copyright 2019-2024 u-blox
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* Only #includes of u_* and the C standard library are allowed here,
+ * no platform stuff and no OS stuff.  Anything required from
+ * the platform/OS must be brought in through u_port* to maintain
+ * portability.
+ */
+
+/** @file
+ * @brief Test for the CRC API
+ */
+
+#ifdef U_CFG_OVERRIDE
+# include "u_cfg_override.h" // For a customer's configuration override
+#endif
+
+#include "stddef.h"    // NULL, size_t etc.
+#include "stdint.h"    // int32_t etc.
+#include "stdbool.h"
+#include "string.h"    // strlen()
+
+#include "u_cfg_sw.h"
+#include "u_cfg_app_platform_specific.h"
+#include "u_cfg_test_platform_specific.h"
+
+#include "u_error_common.h"
+
+#include "u_port.h"
+#include "u_port_os.h"
+#include "u_port_heap.h"
+#include "u_port_debug.h"
+
+#include "u_test_util_resource_check.h"
+
+#include "u_crc.h"
+
+/* ----------------------------------------------------------------
+ * COMPILE-TIME MACROS
+ * -------------------------------------------------------------- */
+
+/** The string to put at the start of all prints from this test.
+ */
+#define U_TEST_PREFIX "U_CRC_TEST: "
+
+/** Print a whole line, with terminator, prefixed for this test file.
+ */
+#define U_TEST_PRINT_LINE(format, ...) uPortLog(U_TEST_PREFIX format "\n", ##__VA_ARGS__)
+
+#ifndef U_UTILS_TEST_CRC_BUFFER_LENGTH_BYTES
+/** The size of buffer to CRC, about the size of a large SPARTN
+ * message.
+ */
+# define U_UTILS_TEST_CRC_BUFFER_LENGTH_BYTES 1024
+#endif
+
+#ifndef U_UTILS_TEST_CRC_BENCHMARK_NUM_PASSES
+/** The number of times to CRC the buffer, per polynomial, in
+ * utilsCrcBenchmark.
+ */
+# define U_UTILS_TEST_CRC_BENCHMARK_NUM_PASSES 1000
+#endif
+
+/* ----------------------------------------------------------------
+ * TYPES
+ * -------------------------------------------------------------- */
+
+/** A CRC function under test, and what it should do.
+ */
+typedef struct {
+    const char *pName;
+    uint32_t polynomial;
+    size_t width;
+    uint32_t check; /**< the CRC of "123456789", starting from zero. */
+    uint32_t (*pFunction)(const char *pData, size_t size, uint32_t crc);
+} uUtilsTestCrc_t;
+
+/* ----------------------------------------------------------------
+ * STATIC FUNCTION PROTOTYPES
+ * -------------------------------------------------------------- */
+
+static uint32_t crc8(const char *pData, size_t size, uint32_t crc);
+static uint32_t crc16(const char *pData, size_t size, uint32_t crc);
+
+/* ----------------------------------------------------------------
+ * VARIABLES
+ * -------------------------------------------------------------- */
+
+/** The most-significant-bit-first CRCs.
+ */
+static const uUtilsTestCrc_t gCrc[] = {
+    {"CRC-8", 0x07, 8, 0xf4, crc8},
+    {"CRC-16", 0x1021, 16, 0x31c3, crc16},
+    {"CRC-24Q", 0x864cfb, 24, 0xcde703, uCrc24q},
+    {"CRC-32", 0x04c11db7, 32, 0x89a1897f, uCrc32}
+};
+
+/** Buffer of test data.
+ */
+static char *gpBuffer = NULL;
+
+/** A byte-at-a-time table, built by the test, to compare against.
+ */
+static uint32_t gTable[256];
+
+/* ----------------------------------------------------------------
+ * STATIC FUNCTIONS
+ * -------------------------------------------------------------- */
+
+// uCrc8() with the same signature as the 24 and 32 bit ones.
+static uint32_t crc8(const char *pData, size_t size, uint32_t crc)
+{
+    return uCrc8(pData, size, (uint8_t) crc);
+}
+
+// uCrc16() with the same signature as the 24 and 32 bit ones.
+static uint32_t crc16(const char *pData, size_t size, uint32_t crc)
+{
+    return uCrc16(pData, size, (uint16_t) crc);
+}
+
+// Calculate a CRC, most significant bit first, a bit at a time.
+static uint32_t crcReference(uint32_t polynomial, size_t width,
+                             const char *pData, size_t size, uint32_t crc)
+{
+    uint32_t topBit = 1UL << (width - 1);
+    uint32_t mask = (topBit << 1) - 1;
+
+    for (size_t x = 0; x < size; x++) {
+        crc ^= ((uint32_t) (uint8_t) * (pData + x)) << (width - 8);
+        for (size_t y = 0; y < 8; y++) {
+            if (crc & topBit) {
+                crc = (crc << 1) ^ polynomial;
+            } else {
+                crc <<= 1;
+            }
+        }
+        crc &= mask;
+    }
+
+    return crc;
+}
+
+// Calculate the reflected 8-bit CRC a bit at a time.
+static uint8_t crc8ReflectedReference(const char *pData, size_t size, uint8_t crc)
+{
+    for (size_t x = 0; x < size; x++) {
+        crc ^= (uint8_t) * (pData + x);
+        for (size_t y = 0; y < 8; y++) {
+            if (crc & 1) {
+                crc = (uint8_t) ((crc >> 1) ^ 0xe0);
+            } else {
+                crc >>= 1;
+            }
+        }
+    }
+
+    return crc;
+}
+
+// Fill gTable for a byte-at-a-time calculation, the CRC being
+// held in the upper bits of a 32-bit word.
+static void tableBuild(uint32_t polynomial, size_t width)
+{
+    char by;
+
+    for (size_t x = 0; x < sizeof(gTable) / sizeof(gTable[0]); x++) {
+        by = (char) x;
+        gTable[x] = crcReference(polynomial, width, &by, 1, 0) << (32 - width);
+    }
+}
+
+// Calculate a CRC a byte at a time using gTable.
+static uint32_t crcByteAtATime(size_t width, const char *pData,
+                               size_t size, uint32_t crc)
+{
+    const uint8_t *pByte = (const uint8_t *) pData;
+
+    crc <<= 32 - width;
+    for (size_t x = 0; x < size; x++) {
+        crc = (crc << 8) ^ gTable[(crc >> 24) ^ *(pByte + x)];
+    }
+
+    return crc >> (32 - width);
+}
+
+// Fill gpBuffer with pseudo-random data.
+static void bufferFill()
+{
+    uint32_t random = 0x5a;
+
+    for (size_t x = 0; x < U_UTILS_TEST_CRC_BUFFER_LENGTH_BYTES; x++) {
+        random = (random * 1103515245UL + 12345) & 0x7fffffff;
+        *(gpBuffer + x) = (char) (random >> 16);
+    }
+}
+
+/* ----------------------------------------------------------------
+ * PUBLIC FUNCTIONS: TESTS
+ * -------------------------------------------------------------- */
+
+/** Check the CRC functions against the standard check values and
+ * against a bit-at-a-time calculation.
+ */
+U_PORT_TEST_FUNCTION("[utilsCrc]", "utilsCrcBasic")
+{
+    int32_t resourceCount;
+    const char *pCheck = "123456789";
+    const uUtilsTestCrc_t *pCrc;
+    uint32_t mask;
+    uint32_t crc;
+    uint32_t expected;
+    size_t y;
+
+    resourceCount = uTestUtilGetDynamicResourceCount();
+
+    gpBuffer = (char *) pUPortMalloc(U_UTILS_TEST_CRC_BUFFER_LENGTH_BYTES);
+    U_PORT_TEST_ASSERT(gpBuffer != NULL);
+    bufferFill();
+
+    for (size_t c = 0; c < sizeof(gCrc) / sizeof(gCrc[0]); c++) {
+        pCrc = &(gCrc[c]);
+        U_TEST_PRINT_LINE("testing %s.", pCrc->pName);
+        mask = (uint32_t) ((((uint64_t) 1) << pCrc->width) - 1);
+        U_PORT_TEST_ASSERT(pCrc->pFunction(pCheck, strlen(pCheck), 0) == pCrc->check);
+        // Zero length must leave the CRC alone, NULL or not
+        U_PORT_TEST_ASSERT(pCrc->pFunction(NULL, 0, 0x5a & mask) == (0x5a & mask));
+        // Every length up to a few times the block size, at
+        // every alignment and with a non-zero starting CRC
+        for (size_t length = 0; length < 50; length++) {
+            for (size_t offset = 0; offset < 8; offset++) {
+                expected = crcReference(pCrc->polynomial, pCrc->width,
+                                        gpBuffer + offset, length, 0);
+                U_PORT_TEST_ASSERT(pCrc->pFunction(gpBuffer + offset, length, 0) == expected);
+                expected = crcReference(pCrc->polynomial, pCrc->width,
+                                        gpBuffer + offset, length, 0xa5a5a5a5 & mask);
+                U_PORT_TEST_ASSERT(pCrc->pFunction(gpBuffer + offset, length,
+                                                   0xa5a5a5a5 & mask) == expected);
+            }
+        }
+        // The whole buffer, in one go and then in pieces
+        expected = crcReference(pCrc->polynomial, pCrc->width, gpBuffer,
+                                U_UTILS_TEST_CRC_BUFFER_LENGTH_BYTES, 0);
+        U_PORT_TEST_ASSERT(pCrc->pFunction(gpBuffer, U_UTILS_TEST_CRC_BUFFER_LENGTH_BYTES,
+                                           0) == expected);
+        for (size_t piece = 1; piece < 20; piece++) {
+            crc = 0;
+            for (size_t x = 0; x < U_UTILS_TEST_CRC_BUFFER_LENGTH_BYTES; x += piece) {
+                y = U_UTILS_TEST_CRC_BUFFER_LENGTH_BYTES - x;
+                if (y > piece) {
+                    y = piece;
+                }
+                crc = pCrc->pFunction(gpBuffer + x, y, crc);
+            }
+            U_PORT_TEST_ASSERT(crc == expected);
+        }
+    }
+
+    // The reflected 8-bit CRC: the 3GPP 27.010 FCS starts at 0xFF
+    // and is inverted at the end
+    U_TEST_PRINT_LINE("testing reflected CRC-8.");
+    U_PORT_TEST_ASSERT((uint8_t) (0xFF - uCrc8Reflected(pCheck, strlen(pCheck), 0xFF)) == 0x2f);
+    for (size_t length = 0; length < 50; length++) {
+        U_PORT_TEST_ASSERT(uCrc8Reflected(gpBuffer, length,
+                                          0xFF) == crc8ReflectedReference(gpBuffer, length, 0xFF));
+    }
+
+    uPortFree(gpBuffer);
+    gpBuffer = NULL;
+
+    // Check for resource leaks
+    uTestUtilResourceCheck(U_TEST_PREFIX, NULL, true);
+    resourceCount = uTestUtilGetDynamicResourceCount() - resourceCount;
+    U_TEST_PRINT_LINE("we have leaked %d resources(s).", resourceCount);
+    U_PORT_TEST_ASSERT(resourceCount <= 0);
+}
+
+/** Benchmark each CRC: first a byte at a time, then with the
+ * functions of u_crc.
+ */
+U_PORT_TEST_FUNCTION("[utilsCrc]", "utilsCrcBenchmark")
+{
+    int32_t resourceCount;
+    const uUtilsTestCrc_t *pCrc;
+    int32_t startTimeMs;
+    int32_t timeMs;
+    int64_t totalBytes = ((int64_t) U_UTILS_TEST_CRC_BUFFER_LENGTH_BYTES) *
+                         U_UTILS_TEST_CRC_BENCHMARK_NUM_PASSES;
+    int32_t kBytesPerSecond;
+    uint32_t crc;
+    uint32_t crcByteAtATimeValue;
+
+    resourceCount = uTestUtilGetDynamicResourceCount();
+
+    gpBuffer = (char *) pUPortMalloc(U_UTILS_TEST_CRC_BUFFER_LENGTH_BYTES);
+    U_PORT_TEST_ASSERT(gpBuffer != NULL);
+    bufferFill();
+
+    U_TEST_PRINT_LINE("CRCing %d bytes %d time(s) per polynomial.",
+                      U_UTILS_TEST_CRC_BUFFER_LENGTH_BYTES,
+                      U_UTILS_TEST_CRC_BENCHMARK_NUM_PASSES);
+    for (size_t c = 0; c < sizeof(gCrc) / sizeof(gCrc[0]); c++) {
+        pCrc = &(gCrc[c]);
+        tableBuild(pCrc->polynomial, pCrc->width);
+
+        // Before: chaining the CRC from one pass to the next stops
+        // the compiler hoisting it out of the loop
+        crcByteAtATimeValue = 0;
+        startTimeMs = uPortGetTickTimeMs();
+        for (size_t x = 0; x < U_UTILS_TEST_CRC_BENCHMARK_NUM_PASSES; x++) {
+            crcByteAtATimeValue = crcByteAtATime(pCrc->width, gpBuffer,
+                                                 U_UTILS_TEST_CRC_BUFFER_LENGTH_BYTES,
+                                                 crcByteAtATimeValue);
+        }
+        timeMs = uPortGetTickTimeMs() - startTimeMs;
+        kBytesPerSecond = timeMs > 0 ? (int32_t) (totalBytes / timeMs) : 0;
+        U_TEST_PRINT_LINE("%s a byte at a time: %d ms, %d.%03d Mbytes/second.",
+                          pCrc->pName, timeMs, kBytesPerSecond / 1000,
+                          kBytesPerSecond % 1000);
+
+        // After
+        crc = 0;
+        startTimeMs = uPortGetTickTimeMs();
+        for (size_t x = 0; x < U_UTILS_TEST_CRC_BENCHMARK_NUM_PASSES; x++) {
+            crc = pCrc->pFunction(gpBuffer, U_UTILS_TEST_CRC_BUFFER_LENGTH_BYTES, crc);
+        }
+        timeMs = uPortGetTickTimeMs() - startTimeMs;
+        kBytesPerSecond = timeMs > 0 ? (int32_t) (totalBytes / timeMs) : 0;
+        U_TEST_PRINT_LINE("%s u_crc: %d ms, %d.%03d Mbytes/second.",
+                          pCrc->pName, timeMs, kBytesPerSecond / 1000,
+                          kBytesPerSecond % 1000);
+        U_PORT_TEST_ASSERT(crc == crcByteAtATimeValue);
+    }
+
+    uPortFree(gpBuffer);
+    gpBuffer = NULL;
+
+    // Check for resource leaks
+    uTestUtilResourceCheck(U_TEST_PREFIX, NULL, true);
+    resourceCount = uTestUtilGetDynamicResourceCount() - resourceCount;
+    U_TEST_PRINT_LINE("we have leaked %d resources(s).", resourceCount);
+    U_PORT_TEST_ASSERT(resourceCount <= 0);
+}
+
+/** Clean-up to be run at the end of this round of tests, just
+ * in case there were test failures which would have resulted
+ * in the deinitialisation being skipped.
+ */
+U_PORT_TEST_FUNCTION("[utilsCrc]", "utilsCrcCleanUp")
+{
+    uPortFree(gpBuffer);
+    gpBuffer = NULL;
+
+    // Printed for information: asserting happens in the postamble
+    uTestUtilResourceCheck(U_TEST_PREFIX, NULL, true);
+}
+
+// End of file
@@ -34,6 +34,7 @@
 #include "string.h"    // strncpy(), strcmp(), memcpy(), memset()
 
 #include "u_cfg_sw.h"
+#include "u_cfg_os_platform_specific.h"
 #include "u_cfg_app_platform_specific.h"
 #include "u_cfg_test_platform_specific.h"
 
@@ -76,14 +77,102 @@
 # define U_TEST_UTILS_RINGBUFFER_FILL_CHAR 0x5a
 #endif
 
+#ifndef U_TEST_UTILS_RINGBUFFER_SPSC_SIZE
+/** The size of the ring buffer to use in the two-task (single
+ * producer, single consumer) test.
+ */
+# define U_TEST_UTILS_RINGBUFFER_SPSC_SIZE 1024
+#endif
+
+#ifndef U_TEST_UTILS_RINGBUFFER_SPSC_TOTAL_BYTES
+/** The amount of data to push through the ring buffer in the
+ * two-task test.
+ */
+# define U_TEST_UTILS_RINGBUFFER_SPSC_TOTAL_BYTES (1024 * 1024)
+#endif
+
+#ifndef U_TEST_UTILS_RINGBUFFER_SPSC_MAX_CHUNK_BYTES
+/** The largest chunk that the producer adds or the consumer reads
+ * in the two-task test; must be no more than 256.
+ */
+# define U_TEST_UTILS_RINGBUFFER_SPSC_MAX_CHUNK_BYTES 128
+#endif
+
+#ifndef U_TEST_UTILS_RINGBUFFER_SPSC_SPIN_COUNT
+/** How many times the producer or consumer in the two-task test
+ * will try to add/read before blocking to let the other side run.
+ */
+# define U_TEST_UTILS_RINGBUFFER_SPSC_SPIN_COUNT 1000
+#endif
+
+#ifndef U_TEST_UTILS_RINGBUFFER_SPSC_TIMEOUT_MS
+/** Guard timer for the two-task test.
+ */
+# define U_TEST_UTILS_RINGBUFFER_SPSC_TIMEOUT_MS 60000
+#endif
+
+#ifndef U_TEST_UTILS_RINGBUFFER_HANDLES_TOTAL_BYTES
+/** The amount of data to push through the ring buffer for each
+ * number of read handles in the read handle benchmark.
+ */
+# define U_TEST_UTILS_RINGBUFFER_HANDLES_TOTAL_BYTES (1024 * 1024)
+#endif
+
+#ifndef U_TEST_UTILS_RINGBUFFER_HANDLES_CHUNK_BYTES
+/** The size of each add in the read handle benchmark; must be no
+ * more than U_TEST_UTILS_RINGBUFFER_SPSC_MAX_CHUNK_BYTES.
+ */
+# define U_TEST_UTILS_RINGBUFFER_HANDLES_CHUNK_BYTES 64
+#endif
+
+/** The most read handles used in the read handle benchmark.
+ */
+#define U_TEST_UTILS_RINGBUFFER_HANDLES_MAX_NUM 16
+
 /* ----------------------------------------------------------------
  * TYPES
  * -------------------------------------------------------------- */
 
+/** Context for the producer task of the two-task test.
+ */
+typedef struct {
+    uRingBuffer_t *pRingBuffer;
+    uPortSemaphoreHandle_t doneSemaphore;
+    volatile bool abort;
+} uTestUtilsRingBufferSpsc_t;
+
+/** State of the block parsers used in the parser test.
+ */
+typedef struct {
+    size_t count;
+    size_t length;
+} uTestUtilsRingBufferParseBlock_t;
+
+/** What the block parsers in the parser test report.
+ */
+typedef struct {
+    char type;
+    size_t length;
+} uTestUtilsRingBufferParseBlockResult_t;
+
 /* ----------------------------------------------------------------
  * VARIABLES
  * -------------------------------------------------------------- */
 
+/** The linear buffer for the two-task test.
+ */
+static char gSpscLinearBuffer[U_TEST_UTILS_RINGBUFFER_SPSC_SIZE + 1];
+
+/** The data the producer of the two-task test adds from: the
+ * byte at index x has the value x modulo 256, doubled up so that
+ * a chunk can start anywhere in the first 256 bytes.
+ */
+static char gSpscPattern[256 + U_TEST_UTILS_RINGBUFFER_SPSC_MAX_CHUNK_BYTES];
+
+/** The number of bytes passed to the block parsers of the parser test.
+ */
+static size_t gParseBlockBytesFed = 0;
+
 /* ----------------------------------------------------------------
  * STATIC FUNCTIONS
  * -------------------------------------------------------------- */
@@ -108,6 +197,248 @@ static void printBuffer(const char *pTitle, const char *pStr, size_t length)
     uPortTaskBlock(10);
 }
 
+// Cheap pseudo-random chunk length for the two-task test.
+static size_t spscChunkLength(uint32_t *pSeed)
+{
+    *pSeed = (*pSeed * 1103515245UL) + 12345UL;
+    return ((*pSeed >> 16) % U_TEST_UTILS_RINGBUFFER_SPSC_MAX_CHUNK_BYTES) + 1;
+}
+
+// Called by the producer or consumer of the two-task test when
+// there is nothing they can do: spin for a while, then yield, then,
+// in case the other side is of lower priority, block.
+static void spscWait(int32_t *pSpinCount)
+{
+    (*pSpinCount)++;
+    if (*pSpinCount % U_TEST_UTILS_RINGBUFFER_SPSC_SPIN_COUNT == 0) {
+        if (*pSpinCount >= U_TEST_UTILS_RINGBUFFER_SPSC_SPIN_COUNT * 10) {
+            uPortTaskBlock(U_CFG_OS_YIELD_MS);
+            *pSpinCount = 0;
+        } else {
+            uPortTaskBlock(0);
+        }
+    }
+}
+
+// The producer task of the two-task test: adds
+// U_TEST_UTILS_RINGBUFFER_SPSC_TOTAL_BYTES of gSpscPattern, in
+// chunks of varying length, retrying when there is no room.
+static void spscProducerTask(void *pParameters)
+{
+    uTestUtilsRingBufferSpsc_t *pContext = (uTestUtilsRingBufferSpsc_t *) pParameters;
+    size_t bytesAdded = 0;
+    size_t length;
+    uint32_t seed = 1;
+    int32_t spinCount = 0;
+
+    length = spscChunkLength(&seed);
+    while ((bytesAdded < U_TEST_UTILS_RINGBUFFER_SPSC_TOTAL_BYTES) && !pContext->abort) {
+        if (length > U_TEST_UTILS_RINGBUFFER_SPSC_TOTAL_BYTES - bytesAdded) {
+            length = U_TEST_UTILS_RINGBUFFER_SPSC_TOTAL_BYTES - bytesAdded;
+        }
+        if (uRingBufferAdd(pContext->pRingBuffer, gSpscPattern + (bytesAdded & 0xff), length)) {
+            bytesAdded += length;
+            length = spscChunkLength(&seed);
+            spinCount = 0;
+        } else {
+            spscWait(&spinCount);
+        }
+    }
+
+    uPortSemaphoreGive(pContext->doneSemaphore);
+    uPortTaskDelete(NULL);
+}
+
+// Push U_TEST_UTILS_RINGBUFFER_SPSC_TOTAL_BYTES through the given
+// ring buffer from a producer task to this task, checking that it all
+// arrives intact, and return the time taken in milliseconds.
+static int32_t spscRun(uRingBuffer_t *pRingBuffer)
+{
+    uTestUtilsRingBufferSpsc_t context = {0};
+    uPortTaskHandle_t taskHandle = NULL;
+    char buffer[U_TEST_UTILS_RINGBUFFER_SPSC_MAX_CHUNK_BYTES];
+    size_t bytesRead = 0;
+    size_t length;
+    size_t y;
+    uint32_t seed = 2;
+    int32_t spinCount = 0;
+    int32_t startTimeMs;
+    int32_t durationMs;
+    bool dataGood = true;
+
+    context.pRingBuffer = pRingBuffer;
+    U_PORT_TEST_ASSERT(uPortSemaphoreCreate(&(context.doneSemaphore), 0, 1) == 0);
+    startTimeMs = uPortGetTickTimeMs();
+    U_PORT_TEST_ASSERT(uPortTaskCreate(spscProducerTask, "spscProducer",
+                                       U_CFG_TEST_OS_TASK_STACK_SIZE_BYTES,
+                                       (void *) &context,
+                                       U_CFG_TEST_OS_TASK_PRIORITY,
+                                       &taskHandle) == 0);
+    while ((bytesRead < U_TEST_UTILS_RINGBUFFER_SPSC_TOTAL_BYTES) && dataGood &&
+           (uPortGetTickTimeMs() - startTimeMs < U_TEST_UTILS_RINGBUFFER_SPSC_TIMEOUT_MS)) {
+        length = uRingBufferRead(pRingBuffer, buffer, spscChunkLength(&seed));
+        if (length > 0) {
+            for (y = 0; (y < length) && dataGood; y++) {
+                if (buffer[y] != (char) (bytesRead + y)) {
+                    U_TEST_PRINT_LINE("at byte %d expected 0x%02x but got 0x%02x.",
+                                      bytesRead + y, (unsigned char) (bytesRead + y),
+                                      (unsigned char) buffer[y]);
+                    dataGood = false;
+                }
+            }
+            bytesRead += length;
+            spinCount = 0;
+        } else {
+            spscWait(&spinCount);
+        }
+    }
+    durationMs = uPortGetTickTimeMs() - startTimeMs;
+    // Make sure the producer has gone before checking anything
+    context.abort = true;
+    U_PORT_TEST_ASSERT(uPortSemaphoreTake(context.doneSemaphore) == 0);
+    U_PORT_TEST_ASSERT(uPortSemaphoreDelete(context.doneSemaphore) == 0);
+    // Let the task delete itself
+    uPortTaskBlock(U_CFG_OS_YIELD_MS + 10);
+
+    U_PORT_TEST_ASSERT(dataGood);
+    U_PORT_TEST_ASSERT(bytesRead == U_TEST_UTILS_RINGBUFFER_SPSC_TOTAL_BYTES);
+    U_PORT_TEST_ASSERT(uRingBufferDataSize(pRingBuffer) == 0);
+    U_PORT_TEST_ASSERT(uRingBufferStatReadLoss(pRingBuffer) == 0);
+    if (durationMs <= 0) {
+        durationMs = 1;
+    }
+
+    return durationMs;
+}
+
+// Push U_TEST_UTILS_RINGBUFFER_HANDLES_TOTAL_BYTES through the given
+// ring buffer, reading every chunk back out through each of numHandles
+// read handles, one of which is kept lagging behind the others by a
+// chunk, checking the data, and return the time taken in milliseconds.
+static int32_t handlesRun(uRingBuffer_t *pRingBuffer, size_t numHandles)
+{
+    int32_t handle[U_TEST_UTILS_RINGBUFFER_HANDLES_MAX_NUM];
+    char buffer[U_TEST_UTILS_RINGBUFFER_HANDLES_CHUNK_BYTES * 2];
+    size_t bytesAdded = 0;
+    size_t length;
+    int32_t startTimeMs;
+    int32_t durationMs;
+    bool dataGood = true;
+
+    for (size_t x = 0; x < numHandles; x++) {
+        handle[x] = uRingBufferTakeReadHandle(pRingBuffer);
+        U_PORT_TEST_ASSERT(handle[x] >= 0);
+    }
+    startTimeMs = uPortGetTickTimeMs();
+    while ((bytesAdded < U_TEST_UTILS_RINGBUFFER_HANDLES_TOTAL_BYTES) && dataGood) {
+        U_PORT_TEST_ASSERT(uRingBufferAdd(pRingBuffer, gSpscPattern + (bytesAdded & 0xFF),
+                                          U_TEST_UTILS_RINGBUFFER_HANDLES_CHUNK_BYTES));
+        bytesAdded += U_TEST_UTILS_RINGBUFFER_HANDLES_CHUNK_BYTES;
+        for (size_t x = 0; x < numHandles; x++) {
+            if ((x > 0) || ((bytesAdded / U_TEST_UTILS_RINGBUFFER_HANDLES_CHUNK_BYTES) & 1) == 0) {
+                // The first handle reads every other time
+                length = uRingBufferReadHandle(pRingBuffer, handle[x], buffer, sizeof(buffer));
+                if ((length == 0) ||
+                    (memcmp(buffer, gSpscPattern + ((bytesAdded - length) & 0xFF), length) != 0)) {
+                    U_TEST_PRINT_LINE("bad data at handle %d after %d byte(s).", x, bytesAdded);
+                    dataGood = false;
+                }
+            }
+        }
+    }
+    durationMs = uPortGetTickTimeMs() - startTimeMs;
+    U_PORT_TEST_ASSERT(dataGood);
+    for (size_t x = 0; x < numHandles; x++) {
+        U_PORT_TEST_ASSERT(uRingBufferDataSizeHandle(pRingBuffer, handle[x]) == 0);
+        U_PORT_TEST_ASSERT(uRingBufferStatReadLossHandle(pRingBuffer, handle[x]) == 0);
+        length = U_TEST_UTILS_RINGBUFFER_HANDLES_CHUNK_BYTES;
+        if (x == 0) {
+            length *= 2;
+        }
+        U_PORT_TEST_ASSERT(uRingBufferStatHighWaterHandle(pRingBuffer, handle[x]) == length);
+        uRingBufferGiveReadHandle(pRingBuffer, handle[x]);
+    }
+    if (durationMs <= 0) {
+        durationMs = 1;
+    }
+
+    return durationMs;
+}
+
+// Block parser for messages of the form "<n...>", where n is
+// a single digit giving the number of bytes in between.
+static int32_t parseBlockAngle(void *pState, const char *pData, size_t length,
+                               void *pUserParam)
+{
+    int32_t errorCodeOrLength = (int32_t) U_ERROR_COMMON_TIMEOUT;
+    uTestUtilsRingBufferParseBlock_t *pParse = (uTestUtilsRingBufferParseBlock_t *) pState;
+    uTestUtilsRingBufferParseBlockResult_t *pResult = (uTestUtilsRingBufferParseBlockResult_t *) pUserParam;
+
+    gParseBlockBytesFed += length;
+    for (size_t x = 0; (x < length) && (errorCodeOrLength == (int32_t) U_ERROR_COMMON_TIMEOUT); x++) {
+        if (pParse->count == 1) {
+            if ((pData[x] < '0') || (pData[x] > '9')) {
+                errorCodeOrLength = (int32_t) U_ERROR_COMMON_NOT_FOUND;
+            }
+            pParse->length = pData[x] - '0';
+        } else if ((pParse->count > 1) && (pParse->count == pParse->length + 2)) {
+            if (pData[x] == '>') {
+                pResult->type = '<';
+                pResult->length = pParse->count + 1;
+                errorCodeOrLength = (int32_t) (x + 1);
+            } else {
+                errorCodeOrLength = (int32_t) U_ERROR_COMMON_NOT_FOUND;
+            }
+        }
+        pParse->count++;
+    }
+
+    return errorCodeOrLength;
+}
+
+// Block parser for messages of the form "{..}".
+static int32_t parseBlockBrace(void *pState, const char *pData, size_t length,
+                               void *pUserParam)
+{
+    int32_t errorCodeOrLength = (int32_t) U_ERROR_COMMON_TIMEOUT;
+    uTestUtilsRingBufferParseBlock_t *pParse = (uTestUtilsRingBufferParseBlock_t *) pState;
+    uTestUtilsRingBufferParseBlockResult_t *pResult = (uTestUtilsRingBufferParseBlockResult_t *) pUserParam;
+
+    gParseBlockBytesFed += length;
+    for (size_t x = 0; (x < length) && (errorCodeOrLength == (int32_t) U_ERROR_COMMON_TIMEOUT); x++) {
+        if (pParse->count == 3) {
+            if (pData[x] == '}') {
+                pResult->type = '{';
+                pResult->length = pParse->count + 1;
+                errorCodeOrLength = (int32_t) (x + 1);
+            } else {
+                errorCodeOrLength = (int32_t) U_ERROR_COMMON_NOT_FOUND;
+            }
+        }
+        pParse->count++;
+    }
+
+    return errorCodeOrLength;
+}
+
+// Add a string to a ring buffer and run the block parsers of the
+// parser test over it, returning what uRingBufferParseBlockHandle()
+// returned.
+static int32_t parseBlockAdd(uRingBuffer_t *pRingBuffer, const char *pStr,
+                             uTestUtilsRingBufferParseBlockResult_t *pResult)
+{
+    static const uRingBufferBlockParser_t parserList[] = {
+        {parseBlockAngle, "<", 1, sizeof(uTestUtilsRingBufferParseBlock_t)},
+        {parseBlockBrace, "{", 1, sizeof(uTestUtilsRingBufferParseBlock_t)},
+        {NULL, NULL, 0, 0}
+    };
+
+    U_PORT_TEST_ASSERT(uRingBufferAdd(pRingBuffer, pStr, strlen(pStr)));
+    memset(pResult, 0, sizeof(*pResult));
+
+    return uRingBufferParseBlockHandle(pRingBuffer, 0, parserList, pResult);
+}
+
 /* ----------------------------------------------------------------
  * PUBLIC FUNCTIONS: TESTS
  * -------------------------------------------------------------- */
@@ -882,4 +1213,413 @@ U_PORT_TEST_FUNCTION("[ringbuffer]", "ringbufferBasic")
     U_PORT_TEST_ASSERT(resourceCount <= 0);
 }
 
-// End of file
\ No newline at end of file
+/** Test of a single-producer, single-consumer ring buffer: the
+ * basics first and then data pushed through it by a producer task
+ * to a consumer task, timed against a normal ring buffer.
+ */
+U_PORT_TEST_FUNCTION("[ringbuffer]", "ringbufferSpsc")
+{
+    int32_t resourceCount;
+    uRingBuffer_t ringBuffer = {0};
+    char linearBuffer[U_TEST_UTILS_RINGBUFFER_SIZE + 1];
+    char bufferOut[U_TEST_UTILS_RINGBUFFER_SIZE + 1];
+    char bufferIn[U_TEST_UTILS_RINGBUFFER_SIZE + 1];
+    size_t y;
+    int32_t spscMs;
+    int32_t mutexMs;
+
+    // Whatever called us likely initialised the
+    // port so deinitialise it here to obtain the
+    // correct initial heap size
+    uPortDeinit();
+    resourceCount = uTestUtilGetDynamicResourceCount();
+    U_PORT_TEST_ASSERT(uPortInit() == 0);
+
+    for (size_t x = 0; x < sizeof(bufferIn); x++) {
+        bufferIn[x] = (char) x;
+    }
+    for (size_t x = 0; x < sizeof(gSpscPattern); x++) {
+        gSpscPattern[x] = (char) x;
+    }
+
+    U_TEST_PRINT_LINE("testing SPSC ring buffer basics...");
+    memset(linearBuffer, 0, sizeof(linearBuffer));
+    memset(bufferOut, U_TEST_UTILS_RINGBUFFER_FILL_CHAR, sizeof(bufferOut));
+    U_PORT_TEST_ASSERT(uRingBufferCreateSpsc(&ringBuffer, linearBuffer, sizeof(linearBuffer)) == 0);
+    U_PORT_TEST_ASSERT(uRingBufferDataSize(&ringBuffer) == 0);
+    U_PORT_TEST_ASSERT(uRingBufferAvailableSize(&ringBuffer) == sizeof(linearBuffer) - 1);
+    U_PORT_TEST_ASSERT(uRingBufferRead(&ringBuffer, bufferOut, sizeof(bufferOut)) == 0);
+    U_PORT_TEST_ASSERT(uRingBufferTakeReadHandle(&ringBuffer) < 0);
+    // Add some, read a bit, then add enough to wrap
+    U_PORT_TEST_ASSERT(uRingBufferAdd(&ringBuffer, bufferIn, 6));
+    U_PORT_TEST_ASSERT(uRingBufferDataSize(&ringBuffer) == 6);
+    U_PORT_TEST_ASSERT(uRingBufferPeek(&ringBuffer, bufferOut, 2, 4) == 2);
+    U_PORT_TEST_ASSERT(memcmp(bufferOut, bufferIn + 4, 2) == 0);
+    U_PORT_TEST_ASSERT(uRingBufferPeek(&ringBuffer, bufferOut, 2, 6) == 0);
+    U_PORT_TEST_ASSERT(uRingBufferRead(&ringBuffer, bufferOut, 4) == 4);
+    U_PORT_TEST_ASSERT(memcmp(bufferOut, bufferIn, 4) == 0);
+    U_PORT_TEST_ASSERT(uRingBufferAdd(&ringBuffer, bufferIn + 6, 5));
+    U_PORT_TEST_ASSERT(uRingBufferDataSize(&ringBuffer) == 7);
+    U_PORT_TEST_ASSERT(uRingBufferAvailableSize(&ringBuffer) == sizeof(linearBuffer) - 1 - 7);
+    // A forced add must not move the read pointer so, with no
+    // room, it fails just as a normal add would
+    U_PORT_TEST_ASSERT(!uRingBufferForceAdd(&ringBuffer, bufferIn, 4));
+    U_PORT_TEST_ASSERT(uRingBufferStatAddLoss(&ringBuffer) == 4);
+    U_PORT_TEST_ASSERT(uRingBufferStatReadLoss(&ringBuffer) == 0);
+    U_PORT_TEST_ASSERT(uRingBufferForceAdd(&ringBuffer, bufferIn, 3));
+    y = uRingBufferRead(&ringBuffer, bufferOut, sizeof(bufferOut));
+    U_PORT_TEST_ASSERT(y == 10);
+    U_PORT_TEST_ASSERT(memcmp(bufferOut, bufferIn + 4, 7) == 0);
+    U_PORT_TEST_ASSERT(memcmp(bufferOut + 7, bufferIn, 3) == 0);
+    U_PORT_TEST_ASSERT(uRingBufferDataSize(&ringBuffer) == 0);
+    // Flushes
+    U_PORT_TEST_ASSERT(uRingBufferAdd(&ringBuffer, bufferIn, 5));
+    uRingBufferFlush(&ringBuffer);
+    U_PORT_TEST_ASSERT(uRingBufferDataSize(&ringBuffer) == 0);
+    memset(bufferOut, U_TEST_UTILS_RINGBUFFER_FILL_CHAR, 4);
+    U_PORT_TEST_ASSERT(uRingBufferAdd(&ringBuffer, bufferOut, 4));
+    U_PORT_TEST_ASSERT(uRingBufferAdd(&ringBuffer, bufferIn + 1, 1));
+    uRingBufferFlushValue(&ringBuffer, U_TEST_UTILS_RINGBUFFER_FILL_CHAR, 4);
+    U_PORT_TEST_ASSERT(uRingBufferDataSize(&ringBuffer) == 1);
+    uRingBufferReset(&ringBuffer);
+    U_PORT_TEST_ASSERT(uRingBufferDataSize(&ringBuffer) == 0);
+    uRingBufferDelete(&ringBuffer);
+
+    U_TEST_PRINT_LINE("pushing %d byte(s) through an SPSC ring buffer of size"
+                      " %d byte(s) from one task to another...",
+                      U_TEST_UTILS_RINGBUFFER_SPSC_TOTAL_BYTES,
+                      U_TEST_UTILS_RINGBUFFER_SPSC_SIZE);
+    U_PORT_TEST_ASSERT(uRingBufferCreateSpsc(&ringBuffer, gSpscLinearBuffer,
+                                             sizeof(gSpscLinearBuffer)) == 0);
+    spscMs = spscRun(&ringBuffer);
+    uRingBufferDelete(&ringBuffer);
+    U_TEST_PRINT_LINE("...took %d ms, %d kbytes/s.", spscMs,
+                      (U_TEST_UTILS_RINGBUFFER_SPSC_TOTAL_BYTES / spscMs) * 1000 / 1024);
+
+    U_TEST_PRINT_LINE("doing the same through a normal ring buffer...");
+    U_PORT_TEST_ASSERT(uRingBufferCreate(&ringBuffer, gSpscLinearBuffer,
+                                         sizeof(gSpscLinearBuffer)) == 0);
+    mutexMs = spscRun(&ringBuffer);
+    uRingBufferDelete(&ringBuffer);
+    U_TEST_PRINT_LINE("...took %d ms, %d kbytes/s.", mutexMs,
+                      (U_TEST_UTILS_RINGBUFFER_SPSC_TOTAL_BYTES / mutexMs) * 1000 / 1024);
+
+    uPortDeinit();
+
+    // Check for resource leaks
+    uTestUtilResourceCheck(U_TEST_PREFIX, NULL, true);
+    resourceCount = uTestUtilGetDynamicResourceCount() - resourceCount;
+    U_TEST_PRINT_LINE("we have leaked %d resources(s).", resourceCount);
+    U_PORT_TEST_ASSERT(resourceCount <= 0);
+}
+
+/** Test of getting data out of a ring buffer as contiguous spans,
+ * with and without a mirror tail.
+ */
+U_PORT_TEST_FUNCTION("[ringbuffer]", "ringbufferSpans")
+{
+    int32_t resourceCount;
+    uRingBuffer_t ringBuffer = {0};
+    uRingBufferSpan_t spans[2];
+    char linearBuffer[U_TEST_UTILS_RINGBUFFER_SIZE + 1];
+    char bufferIn[U_TEST_UTILS_RINGBUFFER_SIZE + 1];
+    int32_t handle;
+
+    // Whatever called us likely initialised the
+    // port so deinitialise it here to obtain the
+    // correct initial heap size
+    uPortDeinit();
+    resourceCount = uTestUtilGetDynamicResourceCount();
+    U_PORT_TEST_ASSERT(uPortInit() == 0);
+
+    for (size_t x = 0; x < sizeof(bufferIn); x++) {
+        bufferIn[x] = (char) x;
+    }
+
+    U_TEST_PRINT_LINE("testing spans...");
+    memset(linearBuffer, 0, sizeof(linearBuffer));
+    U_PORT_TEST_ASSERT(uRingBufferPeekSpans(&ringBuffer, spans) == 0);
+    U_PORT_TEST_ASSERT((spans[0].length == 0) && (spans[1].length == 0));
+    U_PORT_TEST_ASSERT(uRingBufferCreate(&ringBuffer, linearBuffer, sizeof(linearBuffer)) == 0);
+    U_PORT_TEST_ASSERT(uRingBufferPeekSpans(&ringBuffer, spans) == 0);
+    U_PORT_TEST_ASSERT((spans[0].length == 0) && (spans[1].length == 0));
+    // Move the read pointer along a little and then add enough to wrap
+    U_PORT_TEST_ASSERT(uRingBufferAdd(&ringBuffer, bufferIn, 6));
+    U_PORT_TEST_ASSERT(uRingBufferCommitRead(&ringBuffer, 4) == 4);
+    U_PORT_TEST_ASSERT(uRingBufferAdd(&ringBuffer, bufferIn, 7));
+    U_PORT_TEST_ASSERT(uRingBufferPeekSpans(&ringBuffer, spans) == 9);
+    U_PORT_TEST_ASSERT(spans[0].pData == linearBuffer + 4);
+    U_PORT_TEST_ASSERT(spans[0].length == 7);
+    U_PORT_TEST_ASSERT(memcmp(spans[0].pData, bufferIn + 4, 2) == 0);
+    U_PORT_TEST_ASSERT(memcmp(spans[0].pData + 2, bufferIn, 5) == 0);
+    U_PORT_TEST_ASSERT(spans[1].pData == linearBuffer);
+    U_PORT_TEST_ASSERT(spans[1].length == 2);
+    U_PORT_TEST_ASSERT(memcmp(spans[1].pData, bufferIn + 5, 2) == 0);
+    // Peeking must not have moved anything
+    U_PORT_TEST_ASSERT(uRingBufferDataSize(&ringBuffer) == 9);
+    U_PORT_TEST_ASSERT(uRingBufferCommitRead(&ringBuffer, 7) == 7);
+    U_PORT_TEST_ASSERT(uRingBufferPeekSpans(&ringBuffer, spans) == 2);
+    U_PORT_TEST_ASSERT(spans[0].pData == linearBuffer);
+    U_PORT_TEST_ASSERT(spans[0].length == 2);
+    U_PORT_TEST_ASSERT(spans[1].length == 0);
+    U_PORT_TEST_ASSERT(uRingBufferCommitRead(&ringBuffer, 100) == 2);
+    U_PORT_TEST_ASSERT(uRingBufferPeekSpans(&ringBuffer, spans) == 0);
+
+    U_TEST_PRINT_LINE("testing spans with a mirror tail...");
+    // Mirror must be less than half the linear buffer
+    U_PORT_TEST_ASSERT(uRingBufferSetMirror(&ringBuffer, (sizeof(linearBuffer) + 1) / 2) < 0);
+    U_PORT_TEST_ASSERT(uRingBufferSetMirror(&ringBuffer, 3) == 0);
+    // The ring is now 8 bytes, so 7 available
+    U_PORT_TEST_ASSERT(uRingBufferAvailableSize(&ringBuffer) == 7);
+    U_PORT_TEST_ASSERT(uRingBufferAdd(&ringBuffer, bufferIn, 5));
+    U_PORT_TEST_ASSERT(uRingBufferCommitRead(&ringBuffer, 5) == 5);
+    // This wraps by three, which the mirror covers, so one span
+    U_PORT_TEST_ASSERT(uRingBufferAdd(&ringBuffer, bufferIn, 6));
+    U_PORT_TEST_ASSERT(uRingBufferPeekSpans(&ringBuffer, spans) == 6);
+    U_PORT_TEST_ASSERT(spans[0].pData == linearBuffer + 5);
+    U_PORT_TEST_ASSERT(spans[0].length == 6);
+    U_PORT_TEST_ASSERT(memcmp(spans[0].pData, bufferIn, 6) == 0);
+    U_PORT_TEST_ASSERT(spans[1].length == 0);
+    // Now wrap by more than the mirror
+    U_PORT_TEST_ASSERT(uRingBufferCommitRead(&ringBuffer, 2) == 2);
+    U_PORT_TEST_ASSERT(uRingBufferAdd(&ringBuffer, bufferIn + 6, 3));
+    U_PORT_TEST_ASSERT(uRingBufferPeekSpans(&ringBuffer, spans) == 7);
+    U_PORT_TEST_ASSERT(spans[0].pData == linearBuffer + 7);
+    U_PORT_TEST_ASSERT(spans[0].length == 4);
+    U_PORT_TEST_ASSERT(memcmp(spans[0].pData, bufferIn + 2, 4) == 0);
+    U_PORT_TEST_ASSERT(spans[1].pData == linearBuffer + 3);
+    U_PORT_TEST_ASSERT(spans[1].length == 3);
+    U_PORT_TEST_ASSERT(memcmp(spans[1].pData, bufferIn + 6, 3) == 0);
+    // Normal reads should be unaffected by the mirror
+    memset(bufferIn, U_TEST_UTILS_RINGBUFFER_FILL_CHAR, sizeof(bufferIn));
+    U_PORT_TEST_ASSERT(uRingBufferRead(&ringBuffer, bufferIn, sizeof(bufferIn)) == 7);
+    for (size_t x = 0; x < 7; x++) {
+        U_PORT_TEST_ASSERT(bufferIn[x] == (char) (x + 2));
+    }
+    for (size_t x = 0; x < sizeof(bufferIn); x++) {
+        bufferIn[x] = (char) x;
+    }
+    // Remove the mirror again
+    U_PORT_TEST_ASSERT(uRingBufferSetMirror(&ringBuffer, 0) == 0);
+    U_PORT_TEST_ASSERT(uRingBufferAvailableSize(&ringBuffer) == sizeof(linearBuffer) - 1);
+    uRingBufferDelete(&ringBuffer);
+
+    U_TEST_PRINT_LINE("testing spans with a read handle...");
+    U_PORT_TEST_ASSERT(uRingBufferCreateWithReadHandle(&ringBuffer, linearBuffer,
+                                                       sizeof(linearBuffer),
+                                                       U_TEST_UTILS_RINGBUFFER_READ_HANDLES_MAX_NUM) == 0);
+    uRingBufferSetReadRequiresHandle(&ringBuffer, true);
+    handle = uRingBufferTakeReadHandle(&ringBuffer);
+    U_PORT_TEST_ASSERT(handle >= 0);
+    U_PORT_TEST_ASSERT(uRingBufferAdd(&ringBuffer, bufferIn, 8));
+    U_PORT_TEST_ASSERT(uRingBufferCommitReadHandle(&ringBuffer, handle, 8) == 8);
+    U_PORT_TEST_ASSERT(uRingBufferAdd(&ringBuffer, bufferIn, 5));
+    U_PORT_TEST_ASSERT(uRingBufferLockReadHandle(&ringBuffer, handle) == 5);
+    U_PORT_TEST_ASSERT(uRingBufferPeekSpansHandle(&ringBuffer, handle, spans) == 5);
+    U_PORT_TEST_ASSERT(spans[0].pData == linearBuffer + 8);
+    U_PORT_TEST_ASSERT(spans[0].length == 3);
+    U_PORT_TEST_ASSERT(memcmp(spans[0].pData, bufferIn, 3) == 0);
+    U_PORT_TEST_ASSERT(spans[1].pData == linearBuffer);
+    U_PORT_TEST_ASSERT(spans[1].length == 2);
+    U_PORT_TEST_ASSERT(memcmp(spans[1].pData, bufferIn + 3, 2) == 0);
+    U_PORT_TEST_ASSERT(uRingBufferCommitReadHandle(&ringBuffer, handle, 5) == 5);
+    uRingBufferUnlockReadHandle(&ringBuffer, handle);
+    U_PORT_TEST_ASSERT(uRingBufferPeekSpansHandle(&ringBuffer, handle, spans) == 0);
+    U_PORT_TEST_ASSERT(uRingBufferPeekSpansHandle(&ringBuffer, handle + 1, spans) == 0);
+    uRingBufferGiveReadHandle(&ringBuffer, handle);
+    uRingBufferDelete(&ringBuffer);
+
+    uPortDeinit();
+
+    // Check for resource leaks
+    uTestUtilResourceCheck(U_TEST_PREFIX, NULL, true);
+    resourceCount = uTestUtilGetDynamicResourceCount() - resourceCount;
+    U_TEST_PRINT_LINE("we have leaked %d resources(s).", resourceCount);
+    U_PORT_TEST_ASSERT(resourceCount <= 0);
+}
+
+U_PORT_TEST_FUNCTION("[ringbuffer]", "ringbufferParseBlock")
+{
+    int32_t resourceCount;
+    uRingBuffer_t ringBuffer = {0};
+    uTestUtilsRingBufferParseBlockResult_t result;
+    uRingBufferBlockParser_t emptyParserList[] = {{NULL, NULL, 0, 0}};
+    char linearBuffer[32 + 1];
+
+    // Whatever called us likely initialised the
+    // port so deinitialise it here to obtain the
+    // correct initial heap size
+    uPortDeinit();
+    resourceCount = uTestUtilGetDynamicResourceCount();
+    U_PORT_TEST_ASSERT(uPortInit() == 0);
+
+    U_PORT_TEST_ASSERT(uRingBufferCreate(&ringBuffer, linearBuffer, sizeof(linearBuffer)) == 0);
+    U_PORT_TEST_ASSERT(uRingBufferParseBlockHandle(&ringBuffer, 0, NULL, &result) < 0);
+    U_PORT_TEST_ASSERT(uRingBufferParseBlockHandle(&ringBuffer, 1, emptyParserList, &result) < 0);
+    U_PORT_TEST_ASSERT(uRingBufferParseBlockHandle(&ringBuffer, 0, emptyParserList,
+                                                   &result) == (int32_t) U_ERROR_COMMON_TIMEOUT);
+
+    U_TEST_PRINT_LINE("testing block parsing of a message that arrives in pieces...");
+    gParseBlockBytesFed = 0;
+    // Rubbish ahead of a sync byte is reported for discard
+    U_PORT_TEST_ASSERT(parseBlockAdd(&ringBuffer, "ab<3", &result) == 2);
+    U_PORT_TEST_ASSERT(uRingBufferRead(&ringBuffer, NULL, 2) == 2);
+    U_PORT_TEST_ASSERT(parseBlockAdd(&ringBuffer, "",
+                                     &result) == (int32_t) U_ERROR_COMMON_TIMEOUT);
+    U_PORT_TEST_ASSERT(parseBlockAdd(&ringBuffer, "xy",
+                                     &result) == (int32_t) U_ERROR_COMMON_TIMEOUT);
+    U_PORT_TEST_ASSERT(parseBlockAdd(&ringBuffer, "z>", &result) == 6);
+    U_PORT_TEST_ASSERT((result.type == '<') && (result.length == 6));
+    // Each byte should have been passed to the parser only once
+    U_PORT_TEST_ASSERT(gParseBlockBytesFed == 6);
+    U_PORT_TEST_ASSERT(uRingBufferRead(&ringBuffer, NULL, 6) == 6);
+
+    U_TEST_PRINT_LINE("testing block parsing of a broken message...");
+    // A broken "<" message followed by a "{" message: everything
+    // up to the next sync byte should be discarded
+    U_PORT_TEST_ASSERT(parseBlockAdd(&ringBuffer, "<2q!{ab}", &result) == 4);
+    U_PORT_TEST_ASSERT(result.type == 0);
+    U_PORT_TEST_ASSERT(uRingBufferRead(&ringBuffer, NULL, 4) == 4);
+    U_PORT_TEST_ASSERT(parseBlockAdd(&ringBuffer, "", &result) == 4);
+    U_PORT_TEST_ASSERT((result.type == '{') && (result.length == 4));
+    U_PORT_TEST_ASSERT(uRingBufferRead(&ringBuffer, NULL, 4) == 4);
+
+    U_TEST_PRINT_LINE("testing block parsing when the read pointer moves...");
+    U_PORT_TEST_ASSERT(parseBlockAdd(&ringBuffer, "<5abc",
+                                     &result) == (int32_t) U_ERROR_COMMON_TIMEOUT);
+    // Reading the sync byte away means that the rest is rubbish
+    U_PORT_TEST_ASSERT(uRingBufferRead(&ringBuffer, NULL, 1) == 1);
+    U_PORT_TEST_ASSERT(parseBlockAdd(&ringBuffer, "de>", &result) == 7);
+    U_PORT_TEST_ASSERT(result.type == 0);
+    U_PORT_TEST_ASSERT(uRingBufferRead(&ringBuffer, NULL, 7) == 7);
+    // ...and likewise for a flush
+    U_PORT_TEST_ASSERT(parseBlockAdd(&ringBuffer, "<5ab",
+                                     &result) == (int32_t) U_ERROR_COMMON_TIMEOUT);
+    uRingBufferFlush(&ringBuffer);
+    U_PORT_TEST_ASSERT(parseBlockAdd(&ringBuffer, "cde>{", &result) == 4);
+    U_PORT_TEST_ASSERT(uRingBufferRead(&ringBuffer, NULL, 4) == 4);
+
+    U_TEST_PRINT_LINE("testing block parsing across the end of the buffer...");
+    // The "{" is at offset 32 and the "<" message wraps
+    U_PORT_TEST_ASSERT(parseBlockAdd(&ringBuffer, "xy}<9123456789>", &result) == 4);
+    U_PORT_TEST_ASSERT((result.type == '{') && (result.length == 4));
+    U_PORT_TEST_ASSERT(uRingBufferRead(&ringBuffer, NULL, 4) == 4);
+    U_PORT_TEST_ASSERT(parseBlockAdd(&ringBuffer, "", &result) == 12);
+    U_PORT_TEST_ASSERT((result.type == '<') && (result.length == 12));
+    U_PORT_TEST_ASSERT(uRingBufferRead(&ringBuffer, NULL, 12) == 12);
+    U_PORT_TEST_ASSERT(uRingBufferDataSize(&ringBuffer) == 0);
+
+    uRingBufferDelete(&ringBuffer);
+
+    uPortDeinit();
+
+    // Check for resource leaks
+    uTestUtilResourceCheck(U_TEST_PREFIX, NULL, true);
+    resourceCount = uTestUtilGetDynamicResourceCount() - resourceCount;
+    U_TEST_PRINT_LINE("we have leaked %d resources(s).", resourceCount);
+    U_PORT_TEST_ASSERT(resourceCount <= 0);
+}
+
+/** Test of the accounting done for a ring buffer with several
+ * read handles, i.e. what limits the amount of room and the
+ * statistics, then a benchmark with 1, 4 and 16 read handles.
+ */
+U_PORT_TEST_FUNCTION("[ringbuffer]", "ringbufferHandles")
+{
+    int32_t resourceCount;
+    uRingBuffer_t ringBuffer = {0};
+    int32_t handle[3];
+    const size_t numHandles[] = {1, 4, U_TEST_UTILS_RINGBUFFER_HANDLES_MAX_NUM};
+    char bufferIn[U_TEST_UTILS_RINGBUFFER_SPSC_SIZE];
+    int32_t durationMs;
+
+    // Whatever called us likely initialised the
+    // port so deinitialise it here to obtain the
+    // correct initial heap size
+    uPortDeinit();
+    resourceCount = uTestUtilGetDynamicResourceCount();
+    U_PORT_TEST_ASSERT(uPortInit() == 0);
+
+    for (size_t x = 0; x < sizeof(gSpscPattern); x++) {
+        gSpscPattern[x] = (char) x;
+    }
+    memset(bufferIn, U_TEST_UTILS_RINGBUFFER_FILL_CHAR, sizeof(bufferIn));
+
+    U_TEST_PRINT_LINE("testing that the slowest read handle sets the room...");
+    U_PORT_TEST_ASSERT(uRingBufferCreateWithReadHandle(&ringBuffer, gSpscLinearBuffer,
+                                                       sizeof(gSpscLinearBuffer),
+                                                       U_TEST_UTILS_RINGBUFFER_HANDLES_MAX_NUM) == 0);
+    // The "normal" read pointer is initially the only one
+    U_PORT_TEST_ASSERT(uRingBufferAdd(&ringBuffer, bufferIn, 100));
+    U_PORT_TEST_ASSERT(uRingBufferAvailableSize(&ringBuffer) == sizeof(gSpscLinearBuffer) - 1 - 100);
+    U_PORT_TEST_ASSERT(uRingBufferRead(&ringBuffer, NULL, 40) == 40);
+    U_PORT_TEST_ASSERT(uRingBufferAvailableSize(&ringBuffer) == sizeof(gSpscLinearBuffer) - 1 - 60);
+    U_PORT_TEST_ASSERT(uRingBufferStatHighWater(&ringBuffer) == 100);
+    uRingBufferSetReadRequiresHandle(&ringBuffer, true);
+    // Now there are no read pointers that can be read from
+    U_PORT_TEST_ASSERT(uRingBufferAvailableSize(&ringBuffer) == sizeof(gSpscLinearBuffer) - 1 - 100);
+    for (size_t x = 0; x < sizeof(handle) / sizeof(handle[0]); x++) {
+        handle[x] = uRingBufferTakeReadHandle(&ringBuffer);
+        U_PORT_TEST_ASSERT(handle[x] >= 0);
+    }
+    U_PORT_TEST_ASSERT(uRingBufferAvailableSize(&ringBuffer) == sizeof(gSpscLinearBuffer) - 1);
+    U_PORT_TEST_ASSERT(uRingBufferAdd(&ringBuffer, bufferIn, 100));
+    U_PORT_TEST_ASSERT(uRingBufferReadHandle(&ringBuffer, handle[0], NULL, 100) == 100);
+    U_PORT_TEST_ASSERT(uRingBufferReadHandle(&ringBuffer, handle[1], NULL, 50) == 50);
+    U_PORT_TEST_ASSERT(uRingBufferAvailableSize(&ringBuffer) == sizeof(gSpscLinearBuffer) - 1 - 100);
+    U_PORT_TEST_ASSERT(uRingBufferReadHandle(&ringBuffer, handle[2], NULL, 100) == 100);
+    U_PORT_TEST_ASSERT(uRingBufferAvailableSize(&ringBuffer) == sizeof(gSpscLinearBuffer) - 1 - 50);
+    U_PORT_TEST_ASSERT(uRingBufferStatHighWaterHandle(&ringBuffer, handle[1]) == 100);
+    // A normal add can't overrun the slowest read handle...
+    U_PORT_TEST_ASSERT(!uRingBufferAdd(&ringBuffer, bufferIn,
+                                       sizeof(gSpscLinearBuffer) - 1 - 49));
+    U_PORT_TEST_ASSERT(uRingBufferStatReadLossHandle(&ringBuffer, handle[1]) == 0);
+    // ...but a forced add can, while the rest are untouched
+    U_PORT_TEST_ASSERT(uRingBufferForceAdd(&ringBuffer, bufferIn,
+                                           sizeof(gSpscLinearBuffer) - 1 - 40));
+    U_PORT_TEST_ASSERT(uRingBufferStatReadLossHandle(&ringBuffer, handle[1]) == 10);
+    U_PORT_TEST_ASSERT(uRingBufferStatReadLossHandle(&ringBuffer, handle[0]) == 0);
+    U_PORT_TEST_ASSERT(uRingBufferStatHighWaterHandle(&ringBuffer, handle[1]) == sizeof(gSpscLinearBuffer) - 1);
+    U_PORT_TEST_ASSERT(uRingBufferStatHighWaterHandle(&ringBuffer, handle[2]) == sizeof(gSpscLinearBuffer) - 1 - 40);
+    U_PORT_TEST_ASSERT(uRingBufferAvailableSize(&ringBuffer) == 0);
+    // Giving back the slowest read handle frees up its room
+    uRingBufferGiveReadHandle(&ringBuffer, handle[1]);
+    U_PORT_TEST_ASSERT(uRingBufferAvailableSize(&ringBuffer) == 40);
+    U_PORT_TEST_ASSERT(uRingBufferReadHandle(&ringBuffer, handle[0], NULL, 10) == 10);
+    U_PORT_TEST_ASSERT(uRingBufferAvailableSize(&ringBuffer) == 40);
+    uRingBufferFlushHandle(&ringBuffer, handle[2]);
+    U_PORT_TEST_ASSERT(uRingBufferAvailableSize(&ringBuffer) == 50);
+    // A read handle taken again starts its statistics afresh
+    handle[1] = uRingBufferTakeReadHandle(&ringBuffer);
+    U_PORT_TEST_ASSERT(uRingBufferStatHighWaterHandle(&ringBuffer, handle[1]) == 0);
+    U_PORT_TEST_ASSERT(uRingBufferStatReadLossHandle(&ringBuffer, handle[1]) == 0);
+    for (size_t x = 0; x < sizeof(handle) / sizeof(handle[0]); x++) {
+        uRingBufferGiveReadHandle(&ringBuffer, handle[x]);
+    }
+
+    for (size_t x = 0; x < sizeof(numHandles) / sizeof(numHandles[0]); x++) {
+        U_TEST_PRINT_LINE("pushing %d byte(s) through a ring buffer of size %d"
+                          " byte(s) with %d read handle(s)...",
+                          U_TEST_UTILS_RINGBUFFER_HANDLES_TOTAL_BYTES,
+                          U_TEST_UTILS_RINGBUFFER_SPSC_SIZE, numHandles[x]);
+        uRingBufferReset(&ringBuffer);
+        durationMs = handlesRun(&ringBuffer, numHandles[x]);
+        U_TEST_PRINT_LINE("...took %d ms, %d kbytes/s added, %d kbytes/s read.",
+                          durationMs,
+                          (U_TEST_UTILS_RINGBUFFER_HANDLES_TOTAL_BYTES / durationMs) * 1000 / 1024,
+                          (U_TEST_UTILS_RINGBUFFER_HANDLES_TOTAL_BYTES / durationMs) *
+                          numHandles[x] * 1000 / 1024);
+    }
+
+    uRingBufferDelete(&ringBuffer);
+
+    uPortDeinit();
+
+    // Check for resource leaks
+    uTestUtilResourceCheck(U_TEST_PREFIX, NULL, true);
+    resourceCount = uTestUtilGetDynamicResourceCount() - resourceCount;
+    U_TEST_PRINT_LINE("we have leaked %d resources(s).", resourceCount);
+    U_PORT_TEST_ASSERT(resourceCount <= 0);
+}
+
+// End of file
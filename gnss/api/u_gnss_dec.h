@@ -24,6 +24,14 @@
 
 #include "u_gnss_dec_ubx_nav_pvt.h"
 #include "u_gnss_dec_ubx_nav_hpposllh.h"
+#include "u_gnss_dec_ubx_nav_dop.h"
+#include "u_gnss_dec_ubx_nav_status.h"
+#include "u_gnss_dec_ubx_nav_timeutc.h"
+#include "u_gnss_dec_ubx_nav_sat.h"
+#include "u_gnss_dec_ubx_nav_sig.h"
+#include "u_gnss_dec_ubx_esf_meas.h"
+#include "u_gnss_dec_ubx_rxm_rawx.h"
+#include "u_gnss_dec_ubx_mon_rf.h"
 
 /** \addtogroup _GNSS
  *  @{
@@ -38,7 +46,8 @@
  * by requesting it to emit the UBX-NAV-HPPOSLLH message.
  *
  * The functions are thread-safe with the exception of
- * uGnssDecSetCallback().
+ * uGnssDecSetCallback(), uGnssDecPoolInit() and
+ * uGnssDecPoolDeinit().
  */
 
 #ifdef __cplusplus
@@ -58,6 +67,14 @@ extern "C" {
 typedef union {
     uGnssDecUbxNavPvt_t           ubxNavPvt;      /**< UBX-NAV-PVT. */
     uGnssDecUbxNavHpposllh_t      ubxNavHpposllh; /**< UBX-NAV-HPPOSLLH. */
+    uGnssDecUbxNavDop_t           ubxNavDop;      /**< UBX-NAV-DOP. */
+    uGnssDecUbxNavStatus_t        ubxNavStatus;   /**< UBX-NAV-STATUS. */
+    uGnssDecUbxNavTimeutc_t       ubxNavTimeutc;  /**< UBX-NAV-TIMEUTC. */
+    uGnssDecUbxNavSat_t           ubxNavSat;      /**< UBX-NAV-SAT. */
+    uGnssDecUbxNavSig_t           ubxNavSig;      /**< UBX-NAV-SIG. */
+    uGnssDecUbxEsfMeas_t          ubxEsfMeas;     /**< UBX-ESF-MEAS. */
+    uGnssDecUbxRxmRawx_t          ubxRxmRawx;     /**< UBX-RXM-RAWX. */
+    uGnssDecUbxMonRf_t            ubxMonRf;       /**< UBX-MON-RF. */
 } uGnssDecUnion_t;
 
 /** The result of attempting to decode a message, returned by
@@ -94,6 +111,16 @@ typedef struct {
                                  be decoded. */
 } uGnssDec_t;
 
+/** A decode slot: storage for one message decoded by
+ * pUGnssDecAlloc() when a pool of slots has been given to it
+ * with uGnssDecPoolInit().
+ */
+typedef struct {
+    uGnssDec_t dec;       /**< the decode result. */
+    uGnssDecUnion_t body; /**< storage for the message body. */
+    bool inUse;           /**< for internal use only, do not touch. */
+} uGnssDecSlot_t;
+
 /** Callback that can be hooked into pUGnssDecAlloc() by
  * uGnssDecSetCallback() to decode message types that are not
  * known to this code.
@@ -155,12 +182,14 @@ typedef int32_t (uGnssDecFunction_t) (uGnssMessageId_t *pId,
  * and must include all headers; no checking of checksums etc. on the
  * end of a known message is performed, hence they may be omitted.
  *
- * Currently only a very limited set of messages (actually just
- * UBX-NAV-PVT and UBX-NAV-HPPOSLLH, the latter useful if you wish
- * to use a high precision GNSS (HPG) device to its full extent) are
- * supported; see the top of the file u_gnss_dec.c for instructions
- * on how to add more decoders, or use uGnssDecSetCallback() to
- * hook-in your own decoders at run-time.
+ * Currently only a subset of UBX messages are supported (UBX-NAV-PVT,
+ * UBX-NAV-HPPOSLLH, the latter useful if you wish to use a high
+ * precision GNSS (HPG) device to its full extent, UBX-NAV-DOP,
+ * UBX-NAV-STATUS, UBX-NAV-TIMEUTC, UBX-NAV-SAT, UBX-NAV-SIG,
+ * UBX-ESF-MEAS, UBX-RXM-RAWX and UBX-MON-RF); see the top of the
+ * file u_gnss_dec.c for instructions on how to add more decoders,
+ * or use uGnssDecSetCallback() to hook-in your own decoders at
+ * run-time.
  *
  * If only a partial decode is possible then the errorCode field of
  * the returned structure will be negative but the protocol type
@@ -171,7 +200,8 @@ typedef int32_t (uGnssDecFunction_t) (uGnssMessageId_t *pId,
  * IMPORTANT: this function will *always* allocate memory for the
  * returned message structure, even in a fail case; it is up to the
  * caller to uGnssDecFree() the pointer when done (and it is always
- * safe to do so, even if the pointer is NULL).
+ * safe to do so, even if the pointer is NULL).  If you would rather
+ * the heap was not used, see uGnssDecInto() or uGnssDecPoolInit().
  *
  * Note: this function will not pass any position that it decodes
  * into a check against any fences associated with any GNSS devices;
@@ -186,13 +216,85 @@ typedef int32_t (uGnssDecFunction_t) (uGnssMessageId_t *pId,
  */
 uGnssDec_t *pUGnssDecAlloc(const char *pBuffer, size_t size);
 
-/** Free the memory returned by pUGnssDecAlloc().
+/** Free the memory returned by pUGnssDecAlloc(), or return it to
+ * the pool if it came from the pool.
  *
  * @param[in] pDec the pointer returned by pUGnssDecAlloc(); may
  *                 be NULL.
  */
 void uGnssDecFree(uGnssDec_t *pDec);
 
+/** As pUGnssDecAlloc() but the result and the decoded message body
+ * are written to storage supplied by the caller, no memory is
+ * allocated; use this if you are decoding messages at a high rate
+ * on a platform where you would rather not exercise the heap.
+ * The storage for the body may be a #uGnssDecUnion_t, which will
+ * fit any message, or just the structure of the message you expect,
+ * e.g. a #uGnssDecUbxNavPvt_t: if the message turns out to need more
+ * than bodySize bytes it will not be decoded and
+ * #U_ERROR_COMMON_NO_MEMORY will be returned.
+ *
+ * The callback set by uGnssDecSetCallback() is NOT called by this
+ * function, since that callback allocates memory.
+ *
+ * Do NOT call uGnssDecFree() on pDec.
+ *
+ * @param[in] pBuffer     the buffer containing the message to be
+ *                        decoded; cannot be NULL.
+ * @param size            the amount of data at pBuffer.
+ * @param[out] pDec       a pointer to a place to put the result,
+ *                        which will be populated as by
+ *                        pUGnssDecAlloc(), with the pBody field
+ *                        set to pBody if the message body was
+ *                        decoded, else NULL; if the message is
+ *                        NMEA then the id field will point into
+ *                        this structure, so it must remain in
+ *                        scope for as long as that is used; cannot
+ *                        be NULL.
+ * @param[out] pBody      a pointer to storage for the decoded message
+ *                        body; may be NULL if you only want the
+ *                        message ID.
+ * @param bodySize        the amount of storage at pBody.
+ * @return                zero on success else negative error code,
+ *                        the same as the errorCode field of pDec.
+ */
+int32_t uGnssDecInto(const char *pBuffer, size_t size,
+                     uGnssDec_t *pDec, void *pBody, size_t bodySize);
+
+/** Give pUGnssDecAlloc() a fixed pool of slots to decode into:
+ * while there is a free slot in the pool pUGnssDecAlloc() will use
+ * it rather than allocating memory from the heap, and uGnssDecFree()
+ * will return the slot to the pool; should all of the slots be in
+ * use pUGnssDecAlloc() will fall back to using the heap.  This is
+ * a single, global, pool; it may be used by several threads at
+ * once.
+ *
+ * Each slot is large enough to hold the largest message that
+ * can be decoded, see #uGnssDecUnion_t, so it is best to size the
+ * pool for the number of decoded messages you hold at any one time.
+ *
+ * @param[in] pSlots  the storage for the pool, which must remain
+ *                    valid until uGnssDecPoolDeinit() returns
+ *                    success; cannot be NULL.
+ * @param numSlots    the number of slots at pSlots; must be greater
+ *                    than zero.
+ * @return            zero on success else negative error code;
+ *                    if there is already a pool then
+ *                    #U_ERROR_COMMON_INVALID_PARAMETER is returned.
+ */
+int32_t uGnssDecPoolInit(uGnssDecSlot_t *pSlots, size_t numSlots);
+
+/** Stop pUGnssDecAlloc() using the pool that was given to it by
+ * uGnssDecPoolInit(); all slots taken from the pool must have been
+ * returned with uGnssDecFree() before this is called.  This should
+ * not be called while pUGnssDecAlloc() may be acting.
+ *
+ * @return zero on success, or if there is no pool, else
+ *         #U_ERROR_COMMON_BUSY if one or more slots of the pool
+ *         are still in use.
+ */
+int32_t uGnssDecPoolDeinit();
+
 /** Get the list of message IDs that pUGnssDecAlloc() can decode;
  * does not include any added by uGnssDecSetCallback().
  *
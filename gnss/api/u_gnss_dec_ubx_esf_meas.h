@@ -0,0 +1,155 @@
+/*
+ * Copyright 2019-2024 u-blox
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _U_GNSS_DEC_UBX_ESF_MEAS_H_
+#define _U_GNSS_DEC_UBX_ESF_MEAS_H_
+
+/* Only header files representing a direct and unavoidable
+ * dependency between the API of this module and the API
+ * of another module should be included here; otherwise
+ * please keep #includes to your .c files. */
+
+/** \addtogroup _GNSS
+ *  @{
+ */
+
+/** @file
+ * @brief This header file defines the types of a UBX-ESF-MEAS
+ * message, external sensor fusion measurements.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ----------------------------------------------------------------
+ * COMPILE-TIME MACROS
+ * -------------------------------------------------------------- */
+
+/** The message class of a UBX-ESF-MEAS message.
+ */
+#define U_GNSS_DEC_UBX_ESF_MEAS_MESSAGE_CLASS 0x10
+
+/** The message ID of a UBX-ESF-MEAS message.
+ */
+#define U_GNSS_DEC_UBX_ESF_MEAS_MESSAGE_ID 0x02
+
+/** The minimum length of the body of a UBX-ESF-MEAS message.
+ */
+#define U_GNSS_DEC_UBX_ESF_MEAS_BODY_MIN_LENGTH 8
+
+/** The length of each repeated block of a UBX-ESF-MEAS message.
+ */
+#define U_GNSS_DEC_UBX_ESF_MEAS_BLOCK_LENGTH 4
+
+#ifndef U_GNSS_DEC_UBX_ESF_MEAS_MEAS_MAX_NUM
+/** The maximum number of measurements that will be decoded from a
+ * UBX-ESF-MEAS message, which sets the size of #uGnssDecUbxEsfMeas_t;
+ * a message can contain no more than 31.  If a message contains
+ * more than this then only the first
+ * #U_GNSS_DEC_UBX_ESF_MEAS_MEAS_MAX_NUM are decoded and the numMeas
+ * field is reduced to match.
+ */
+# define U_GNSS_DEC_UBX_ESF_MEAS_MEAS_MAX_NUM 31
+#endif
+
+/** Bit mask for the #U_GNSS_DEC_UBX_ESF_MEAS_FLAGS_NUM_MEAS field
+ * of #uGnssDecUbxEsfMeasFlags_t.
+ */
+#define U_GNSS_DEC_UBX_ESF_MEAS_FLAGS_NUM_MEAS_MASK (0x1f << U_GNSS_DEC_UBX_ESF_MEAS_FLAGS_NUM_MEAS)
+
+/** Get the data type, e.g. 14 for gyroscope X-axis angular rate,
+ * from the "data" field of #uGnssDecUbxEsfMeasData_t; the values
+ * are those of the interface manual.
+ */
+#define U_GNSS_DEC_UBX_ESF_MEAS_DATA_TYPE(data) ((uint8_t) (((data) >> 24) & 0x3f))
+
+/** Get the data value from the "data" field of
+ * #uGnssDecUbxEsfMeasData_t, sign-extended from 24 bits; for the
+ * data types that are unsigned (e.g. wheel ticks) use only the
+ * bottom 24 bits of the value.
+ */
+#define U_GNSS_DEC_UBX_ESF_MEAS_DATA_FIELD(data) ((int32_t) (((data) & 0x00ffffffUL) ^ 0x00800000UL) - 0x00800000L)
+
+/* ----------------------------------------------------------------
+ * TYPES
+ * -------------------------------------------------------------- */
+
+/** Bit fields of the "flags" field of #uGnssDecUbxEsfMeas_t; use
+ * these to mask specific bits, e.g.
+ *
+ * `if (flags & (1 << U_GNSS_DEC_UBX_ESF_MEAS_FLAGS_CALIB_TTAG_VALID)) {`
+ *
+ * ...would determine if the calibTtag field is valid.  Note that
+ * the field #U_GNSS_DEC_UBX_ESF_MEAS_FLAGS_NUM_MEAS is wider than
+ * a single bit; it is also made available as the numMeas field
+ * of #uGnssDecUbxEsfMeas_t.
+ */
+typedef enum {
+    U_GNSS_DEC_UBX_ESF_MEAS_FLAGS_TIME_MARK_EDGE = 2,    /**< time mark signal
+                                                              was supplied just
+                                                              after a falling
+                                                              edge, else rising. */
+    U_GNSS_DEC_UBX_ESF_MEAS_FLAGS_CALIB_TTAG_VALID = 3,  /**< the calibTtag field
+                                                              is valid. */
+    U_GNSS_DEC_UBX_ESF_MEAS_FLAGS_NUM_MEAS = 11          /**< not a single bit,
+                                                              the start of a 5-bit
+                                                              field, use
+                                                              #U_GNSS_DEC_UBX_ESF_MEAS_FLAGS_NUM_MEAS_MASK
+                                                              to mask it and this
+                                                              to shift it down
+                                                              to get the number
+                                                              of measurements. */
+} uGnssDecUbxEsfMeasFlags_t;
+
+/** One measurement in a UBX-ESF-MEAS message.
+ */
+typedef struct {
+    uint32_t data; /**< the data type in bits 24 to 29 and the data
+                        value in bits 0 to 23; use
+                        #U_GNSS_DEC_UBX_ESF_MEAS_DATA_TYPE() and
+                        #U_GNSS_DEC_UBX_ESF_MEAS_DATA_FIELD() to
+                        extract them. */
+} uGnssDecUbxEsfMeasData_t;
+
+/** UBX-ESF-MEAS message structure; the naming and type of each
+ * element follows that of the interface manual.
+ */
+typedef struct {
+    uint32_t timeTag;    /**< time tag of the measurement generated by
+                              the external sensor. */
+    uint16_t flags;      /**< see #uGnssDecUbxEsfMeasFlags_t. */
+    uint16_t id;         /**< identification number of the data provider. */
+    uint8_t numMeas;     /**< the number of measurements in data, taken
+                              from flags, at most
+                              #U_GNSS_DEC_UBX_ESF_MEAS_MEAS_MAX_NUM. */
+    uGnssDecUbxEsfMeasData_t data[U_GNSS_DEC_UBX_ESF_MEAS_MEAS_MAX_NUM]; /**< the
+                                                                              measurements. */
+    uint32_t calibTtag;  /**< the receiver local time calibrated, in
+                              milliseconds, only present (else zero) if
+                              the #U_GNSS_DEC_UBX_ESF_MEAS_FLAGS_CALIB_TTAG_VALID
+                              bit of flags is set. */
+} uGnssDecUbxEsfMeas_t;
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @}*/
+
+#endif // _U_GNSS_DEC_UBX_ESF_MEAS_H_
+
+// End of file
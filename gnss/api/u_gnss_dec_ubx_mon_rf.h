@@ -0,0 +1,137 @@
+/*
+ * Copyright 2019-2024 u-blox
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _U_GNSS_DEC_UBX_MON_RF_H_
+#define _U_GNSS_DEC_UBX_MON_RF_H_
+
+/* Only header files representing a direct and unavoidable
+ * dependency between the API of this module and the API
+ * of another module should be included here; otherwise
+ * please keep #includes to your .c files. */
+
+/** \addtogroup _GNSS
+ *  @{
+ */
+
+/** @file
+ * @brief This header file defines the types of a UBX-MON-RF
+ * message, RF information.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ----------------------------------------------------------------
+ * COMPILE-TIME MACROS
+ * -------------------------------------------------------------- */
+
+/** The message class of a UBX-MON-RF message.
+ */
+#define U_GNSS_DEC_UBX_MON_RF_MESSAGE_CLASS 0x0a
+
+/** The message ID of a UBX-MON-RF message.
+ */
+#define U_GNSS_DEC_UBX_MON_RF_MESSAGE_ID 0x38
+
+/** The minimum length of the body of a UBX-MON-RF message.
+ */
+#define U_GNSS_DEC_UBX_MON_RF_BODY_MIN_LENGTH 4
+
+/** The length of each repeated block of a UBX-MON-RF message.
+ */
+#define U_GNSS_DEC_UBX_MON_RF_BLOCK_LENGTH 24
+
+#ifndef U_GNSS_DEC_UBX_MON_RF_BLOCKS_MAX_NUM
+/** The maximum number of RF blocks that will be decoded from a
+ * UBX-MON-RF message, which sets the size of #uGnssDecUbxMonRf_t;
+ * if a message contains more than this then only the first
+ * #U_GNSS_DEC_UBX_MON_RF_BLOCKS_MAX_NUM are decoded and the nBlocks
+ * field is reduced to match.
+ */
+# define U_GNSS_DEC_UBX_MON_RF_BLOCKS_MAX_NUM 4
+#endif
+
+/* ----------------------------------------------------------------
+ * TYPES
+ * -------------------------------------------------------------- */
+
+/** Possible values of the "antStatus" field of
+ * #uGnssDecUbxMonRfBlock_t.
+ */
+typedef enum {
+    U_GNSS_DEC_UBX_MON_RF_ANT_STATUS_INIT = 0,
+    U_GNSS_DEC_UBX_MON_RF_ANT_STATUS_DONT_KNOW = 1,
+    U_GNSS_DEC_UBX_MON_RF_ANT_STATUS_OK = 2,
+    U_GNSS_DEC_UBX_MON_RF_ANT_STATUS_SHORT = 3,
+    U_GNSS_DEC_UBX_MON_RF_ANT_STATUS_OPEN = 4
+} uGnssDecUbxMonRfAntStatus_t;
+
+/** Possible values of the "antPower" field of
+ * #uGnssDecUbxMonRfBlock_t.
+ */
+typedef enum {
+    U_GNSS_DEC_UBX_MON_RF_ANT_POWER_OFF = 0,
+    U_GNSS_DEC_UBX_MON_RF_ANT_POWER_ON = 1,
+    U_GNSS_DEC_UBX_MON_RF_ANT_POWER_DONT_KNOW = 2
+} uGnssDecUbxMonRfAntPower_t;
+
+/** The information for one RF block in a UBX-MON-RF message; the
+ * naming and type of each element follows that of the interface
+ * manual.
+ */
+typedef struct {
+    uint8_t blockId;     /**< RF block ID, e.g. 0 for L1 and 1 for L2
+                              or L5. */
+    uint8_t flags;       /**< jamming state in bits 0 and 1: 0 unknown,
+                              1 OK, 2 warning, 3 critical. */
+    uint8_t antStatus;   /**< see #uGnssDecUbxMonRfAntStatus_t. */
+    uint8_t antPower;    /**< see #uGnssDecUbxMonRfAntPower_t. */
+    uint32_t postStatus; /**< POST (power-on self test) status word. */
+    uint16_t noisePerMS; /**< noise level as measured by the GPS core. */
+    uint16_t agcCnt;     /**< AGC monitor, range 0 to 8191. */
+    uint8_t jamInd;      /**< CW jamming indicator, scaled 0 (no CW
+                              jamming) to 255 (strong CW jamming). */
+    int8_t ofsI;         /**< imbalance of the I-part of the complex
+                              signal, scaled -128 to 127. */
+    uint8_t magI;        /**< magnitude of the I-part of the complex
+                              signal, scaled 0 to 255. */
+    int8_t ofsQ;         /**< imbalance of the Q-part of the complex
+                              signal, scaled -128 to 127. */
+    uint8_t magQ;        /**< magnitude of the Q-part of the complex
+                              signal, scaled 0 to 255. */
+} uGnssDecUbxMonRfBlock_t;
+
+/** UBX-MON-RF message structure; the naming and type of each
+ * element follows that of the interface manual.
+ */
+typedef struct {
+    uint8_t version;  /**< message version. */
+    uint8_t nBlocks;  /**< the number of RF blocks in block, at most
+                           #U_GNSS_DEC_UBX_MON_RF_BLOCKS_MAX_NUM. */
+    uGnssDecUbxMonRfBlock_t block[U_GNSS_DEC_UBX_MON_RF_BLOCKS_MAX_NUM]; /**< the
+                                                                              RF blocks. */
+} uGnssDecUbxMonRf_t;
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @}*/
+
+#endif // _U_GNSS_DEC_UBX_MON_RF_H_
+
+// End of file
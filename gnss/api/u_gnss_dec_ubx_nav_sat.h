@@ -0,0 +1,180 @@
+/*
+ * Copyright 2019-2024 u-blox
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _U_GNSS_DEC_UBX_NAV_SAT_H_
+#define _U_GNSS_DEC_UBX_NAV_SAT_H_
+
+/* Only header files representing a direct and unavoidable
+ * dependency between the API of this module and the API
+ * of another module should be included here; otherwise
+ * please keep #includes to your .c files. */
+
+/** \addtogroup _GNSS
+ *  @{
+ */
+
+/** @file
+ * @brief This header file defines the types of a UBX-NAV-SAT
+ * message.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ----------------------------------------------------------------
+ * COMPILE-TIME MACROS
+ * -------------------------------------------------------------- */
+
+/** The message class of a UBX-NAV-SAT message.
+ */
+#define U_GNSS_DEC_UBX_NAV_SAT_MESSAGE_CLASS 0x01
+
+/** The message ID of a UBX-NAV-SAT message.
+ */
+#define U_GNSS_DEC_UBX_NAV_SAT_MESSAGE_ID 0x35
+
+/** The minimum length of the body of a UBX-NAV-SAT message.
+ */
+#define U_GNSS_DEC_UBX_NAV_SAT_BODY_MIN_LENGTH 8
+
+/** The length of each repeated block of a UBX-NAV-SAT message.
+ */
+#define U_GNSS_DEC_UBX_NAV_SAT_BLOCK_LENGTH 12
+
+#ifndef U_GNSS_DEC_UBX_NAV_SAT_SVS_MAX_NUM
+/** The maximum number of satellites that will be decoded from a
+ * UBX-NAV-SAT message, which sets the size of #uGnssDecUbxNavSat_t;
+ * if a message contains more than this then only the first
+ * #U_GNSS_DEC_UBX_NAV_SAT_SVS_MAX_NUM are decoded and the numSvs
+ * field is reduced to match.
+ */
+# define U_GNSS_DEC_UBX_NAV_SAT_SVS_MAX_NUM 64
+#endif
+
+/** Bit mask for the #U_GNSS_DEC_UBX_NAV_SAT_FLAGS_QUALITY_IND field
+ * of #uGnssDecUbxNavSatFlags_t.
+ */
+#define U_GNSS_DEC_UBX_NAV_SAT_FLAGS_QUALITY_IND_MASK (0x07UL << U_GNSS_DEC_UBX_NAV_SAT_FLAGS_QUALITY_IND)
+
+/** Bit mask for the #U_GNSS_DEC_UBX_NAV_SAT_FLAGS_HEALTH field
+ * of #uGnssDecUbxNavSatFlags_t.
+ */
+#define U_GNSS_DEC_UBX_NAV_SAT_FLAGS_HEALTH_MASK (0x03UL << U_GNSS_DEC_UBX_NAV_SAT_FLAGS_HEALTH)
+
+/** Bit mask for the #U_GNSS_DEC_UBX_NAV_SAT_FLAGS_ORBIT_SOURCE field
+ * of #uGnssDecUbxNavSatFlags_t.
+ */
+#define U_GNSS_DEC_UBX_NAV_SAT_FLAGS_ORBIT_SOURCE_MASK (0x07UL << U_GNSS_DEC_UBX_NAV_SAT_FLAGS_ORBIT_SOURCE)
+
+/* ----------------------------------------------------------------
+ * TYPES
+ * -------------------------------------------------------------- */
+
+/** Bit fields of the "flags" field of #uGnssDecUbxNavSatSv_t; use
+ * these to mask specific bits, e.g.
+ *
+ * `if (flags & (1UL << U_GNSS_DEC_UBX_NAV_SAT_FLAGS_SV_USED)) {`
+ *
+ * ...would determine if the satellite is being used for
+ * navigation.  Note that the fields
+ * #U_GNSS_DEC_UBX_NAV_SAT_FLAGS_QUALITY_IND,
+ * #U_GNSS_DEC_UBX_NAV_SAT_FLAGS_HEALTH and
+ * #U_GNSS_DEC_UBX_NAV_SAT_FLAGS_ORBIT_SOURCE are wider than a
+ * single bit.
+ */
+typedef enum {
+    U_GNSS_DEC_UBX_NAV_SAT_FLAGS_QUALITY_IND = 0,   /**< not a single bit,
+                                                         the start of a 3-bit
+                                                         field, use
+                                                         #U_GNSS_DEC_UBX_NAV_SAT_FLAGS_QUALITY_IND_MASK
+                                                         to mask it and this
+                                                         to shift it down:
+                                                         0 for no signal up
+                                                         to 4 or more for code
+                                                         locked and time
+                                                         synchronized, see the
+                                                         interface manual. */
+    U_GNSS_DEC_UBX_NAV_SAT_FLAGS_SV_USED = 3,       /**< the signal of this
+                                                         satellite is being
+                                                         used for navigation. */
+    U_GNSS_DEC_UBX_NAV_SAT_FLAGS_HEALTH = 4,        /**< not a single bit,
+                                                         the start of a 2-bit
+                                                         field, use
+                                                         #U_GNSS_DEC_UBX_NAV_SAT_FLAGS_HEALTH_MASK
+                                                         to mask it and this
+                                                         to shift it down:
+                                                         0 unknown, 1 healthy,
+                                                         2 unhealthy. */
+    U_GNSS_DEC_UBX_NAV_SAT_FLAGS_DIFF_CORR = 6,     /**< differential correction
+                                                         data is available for
+                                                         this satellite. */
+    U_GNSS_DEC_UBX_NAV_SAT_FLAGS_SMOOTHED = 7,      /**< carrier smoothed
+                                                         pseudorange is used. */
+    U_GNSS_DEC_UBX_NAV_SAT_FLAGS_ORBIT_SOURCE = 8,  /**< not a single bit,
+                                                         the start of a 3-bit
+                                                         field, use
+                                                         #U_GNSS_DEC_UBX_NAV_SAT_FLAGS_ORBIT_SOURCE_MASK
+                                                         to mask it and this
+                                                         to shift it down:
+                                                         0 no orbit information,
+                                                         1 ephemeris, 2 almanac,
+                                                         etc., see the interface
+                                                         manual. */
+    U_GNSS_DEC_UBX_NAV_SAT_FLAGS_EPH_AVAIL = 11,    /**< ephemeris is available
+                                                         for this satellite. */
+    U_GNSS_DEC_UBX_NAV_SAT_FLAGS_ALM_AVAIL = 12     /**< almanac is available
+                                                         for this satellite. */
+} uGnssDecUbxNavSatFlags_t;
+
+/** The information for one satellite in a UBX-NAV-SAT message; the
+ * naming and type of each element follows that of the interface
+ * manual.
+ */
+typedef struct {
+    uint8_t gnssId;   /**< GNSS identifier, e.g. 0 for GPS, 2 for Galileo. */
+    uint8_t svId;     /**< satellite identifier. */
+    uint8_t cno;      /**< carrier to noise ratio in dBHz. */
+    int8_t elev;      /**< elevation in degrees, range -90 to +90,
+                           unknown if outside that range. */
+    int16_t azim;     /**< azimuth in degrees, range 0 to 360, unknown
+                           if elevation is out of range. */
+    int16_t prRes;    /**< pseudorange residual in metres times 10. */
+    uint32_t flags;   /**< see #uGnssDecUbxNavSatFlags_t. */
+} uGnssDecUbxNavSatSv_t;
+
+/** UBX-NAV-SAT message structure; the naming and type of each
+ * element follows that of the interface manual.
+ */
+typedef struct {
+    uint32_t iTOW;    /**< GPS time of week of the navigation epoch
+                           in milliseconds. */
+    uint8_t version;  /**< message version. */
+    uint8_t numSvs;   /**< the number of satellites in sv, at most
+                           #U_GNSS_DEC_UBX_NAV_SAT_SVS_MAX_NUM. */
+    uGnssDecUbxNavSatSv_t sv[U_GNSS_DEC_UBX_NAV_SAT_SVS_MAX_NUM]; /**< the
+                                                                       satellites. */
+} uGnssDecUbxNavSat_t;
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @}*/
+
+#endif // _U_GNSS_DEC_UBX_NAV_SAT_H_
+
+// End of file
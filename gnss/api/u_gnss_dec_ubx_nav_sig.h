@@ -0,0 +1,159 @@
+/*
+ * Copyright 2019-2024 u-blox
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _U_GNSS_DEC_UBX_NAV_SIG_H_
+#define _U_GNSS_DEC_UBX_NAV_SIG_H_
+
+/* Only header files representing a direct and unavoidable
+ * dependency between the API of this module and the API
+ * of another module should be included here; otherwise
+ * please keep #includes to your .c files. */
+
+/** \addtogroup _GNSS
+ *  @{
+ */
+
+/** @file
+ * @brief This header file defines the types of a UBX-NAV-SIG
+ * message.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ----------------------------------------------------------------
+ * COMPILE-TIME MACROS
+ * -------------------------------------------------------------- */
+
+/** The message class of a UBX-NAV-SIG message.
+ */
+#define U_GNSS_DEC_UBX_NAV_SIG_MESSAGE_CLASS 0x01
+
+/** The message ID of a UBX-NAV-SIG message.
+ */
+#define U_GNSS_DEC_UBX_NAV_SIG_MESSAGE_ID 0x43
+
+/** The minimum length of the body of a UBX-NAV-SIG message.
+ */
+#define U_GNSS_DEC_UBX_NAV_SIG_BODY_MIN_LENGTH 8
+
+/** The length of each repeated block of a UBX-NAV-SIG message.
+ */
+#define U_GNSS_DEC_UBX_NAV_SIG_BLOCK_LENGTH 16
+
+#ifndef U_GNSS_DEC_UBX_NAV_SIG_SIGS_MAX_NUM
+/** The maximum number of signals that will be decoded from a
+ * UBX-NAV-SIG message, which sets the size of #uGnssDecUbxNavSig_t;
+ * if a message contains more than this then only the first
+ * #U_GNSS_DEC_UBX_NAV_SIG_SIGS_MAX_NUM are decoded and the numSigs
+ * field is reduced to match.
+ */
+# define U_GNSS_DEC_UBX_NAV_SIG_SIGS_MAX_NUM 96
+#endif
+
+/** Bit mask for the #U_GNSS_DEC_UBX_NAV_SIG_SIG_FLAGS_HEALTH field
+ * of #uGnssDecUbxNavSigSigFlags_t.
+ */
+#define U_GNSS_DEC_UBX_NAV_SIG_SIG_FLAGS_HEALTH_MASK (0x03 << U_GNSS_DEC_UBX_NAV_SIG_SIG_FLAGS_HEALTH)
+
+/* ----------------------------------------------------------------
+ * TYPES
+ * -------------------------------------------------------------- */
+
+/** Bit fields of the "sigFlags" field of #uGnssDecUbxNavSigSig_t;
+ * use these to mask specific bits, e.g.
+ *
+ * `if (sigFlags & (1 << U_GNSS_DEC_UBX_NAV_SIG_SIG_FLAGS_PR_USED)) {`
+ *
+ * ...would determine if the pseudorange of the signal is used
+ * in the navigation solution.  Note that the field
+ * #U_GNSS_DEC_UBX_NAV_SIG_SIG_FLAGS_HEALTH is wider than a single
+ * bit.
+ */
+typedef enum {
+    U_GNSS_DEC_UBX_NAV_SIG_SIG_FLAGS_HEALTH = 0,        /**< not a single bit,
+                                                             the start of a 2-bit
+                                                             field, use
+                                                             #U_GNSS_DEC_UBX_NAV_SIG_SIG_FLAGS_HEALTH_MASK
+                                                             to mask it and this
+                                                             to shift it down:
+                                                             0 unknown, 1 healthy,
+                                                             2 unhealthy. */
+    U_GNSS_DEC_UBX_NAV_SIG_SIG_FLAGS_PR_SMOOTHED = 2,   /**< pseudorange has been
+                                                             smoothed. */
+    U_GNSS_DEC_UBX_NAV_SIG_SIG_FLAGS_PR_USED = 3,       /**< pseudorange has been
+                                                             used for this signal. */
+    U_GNSS_DEC_UBX_NAV_SIG_SIG_FLAGS_CR_USED = 4,       /**< carrier range has been
+                                                             used for this signal. */
+    U_GNSS_DEC_UBX_NAV_SIG_SIG_FLAGS_DO_USED = 5,       /**< range rate (Doppler)
+                                                             has been used for this
+                                                             signal. */
+    U_GNSS_DEC_UBX_NAV_SIG_SIG_FLAGS_PR_CORR_USED = 6,  /**< pseudorange corrections
+                                                             have been used for this
+                                                             signal. */
+    U_GNSS_DEC_UBX_NAV_SIG_SIG_FLAGS_CR_CORR_USED = 7,  /**< carrier range
+                                                             corrections have been
+                                                             used for this signal. */
+    U_GNSS_DEC_UBX_NAV_SIG_SIG_FLAGS_DO_CORR_USED = 8   /**< range rate (Doppler)
+                                                             corrections have been
+                                                             used for this signal. */
+} uGnssDecUbxNavSigSigFlags_t;
+
+/** The information for one signal in a UBX-NAV-SIG message; the
+ * naming and type of each element follows that of the interface
+ * manual.
+ */
+typedef struct {
+    uint8_t gnssId;     /**< GNSS identifier, e.g. 0 for GPS, 2 for Galileo. */
+    uint8_t svId;       /**< satellite identifier. */
+    uint8_t sigId;      /**< signal identifier, e.g. 0 for GPS L1C/A. */
+    uint8_t freqId;     /**< GLONASS frequency slot + 7, range 0 to 13. */
+    int16_t prRes;      /**< pseudorange residual in metres times 10. */
+    uint8_t cno;        /**< carrier to noise ratio in dBHz. */
+    uint8_t qualityInd; /**< signal quality indicator: 0 for no signal
+                             up to 5 to 7 for code and carrier locked
+                             and time synchronized, see the interface
+                             manual. */
+    uint8_t corrSource; /**< correction source, e.g. 0 for none, 1 for
+                             SBAS, see the interface manual. */
+    uint8_t ionoModel;  /**< ionospheric model used, e.g. 0 for none,
+                             1 for Klobuchar GPS, see the interface manual. */
+    uint16_t sigFlags;  /**< see #uGnssDecUbxNavSigSigFlags_t. */
+} uGnssDecUbxNavSigSig_t;
+
+/** UBX-NAV-SIG message structure; the naming and type of each
+ * element follows that of the interface manual.
+ */
+typedef struct {
+    uint32_t iTOW;    /**< GPS time of week of the navigation epoch
+                           in milliseconds. */
+    uint8_t version;  /**< message version. */
+    uint8_t numSigs;  /**< the number of signals in sig, at most
+                           #U_GNSS_DEC_UBX_NAV_SIG_SIGS_MAX_NUM. */
+    uGnssDecUbxNavSigSig_t sig[U_GNSS_DEC_UBX_NAV_SIG_SIGS_MAX_NUM]; /**< the
+                                                                          signals. */
+} uGnssDecUbxNavSig_t;
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @}*/
+
+#endif // _U_GNSS_DEC_UBX_NAV_SIG_H_
+
+// End of file
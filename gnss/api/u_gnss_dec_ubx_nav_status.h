@@ -0,0 +1,117 @@
+/*
+ * Copyright 2019-2024 u-blox
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _U_GNSS_DEC_UBX_NAV_STATUS_H_
+#define _U_GNSS_DEC_UBX_NAV_STATUS_H_
+
+/* Only header files representing a direct and unavoidable
+ * dependency between the API of this module and the API
+ * of another module should be included here; otherwise
+ * please keep #includes to your .c files. */
+
+/** \addtogroup _GNSS
+ *  @{
+ */
+
+/** @file
+ * @brief This header file defines the types of a UBX-NAV-STATUS
+ * message.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ----------------------------------------------------------------
+ * COMPILE-TIME MACROS
+ * -------------------------------------------------------------- */
+
+/** The message class of a UBX-NAV-STATUS message.
+ */
+#define U_GNSS_DEC_UBX_NAV_STATUS_MESSAGE_CLASS 0x01
+
+/** The message ID of a UBX-NAV-STATUS message.
+ */
+#define U_GNSS_DEC_UBX_NAV_STATUS_MESSAGE_ID 0x03
+
+/** The minimum length of the body of a UBX-NAV-STATUS message.
+ */
+#define U_GNSS_DEC_UBX_NAV_STATUS_BODY_MIN_LENGTH 16
+
+/* ----------------------------------------------------------------
+ * TYPES
+ * -------------------------------------------------------------- */
+
+/** Possible values of the "gpsFix" field of #uGnssDecUbxNavStatus_t.
+ */
+typedef enum {
+    U_GNSS_DEC_UBX_NAV_STATUS_GPS_FIX_NO_FIX = 0,
+    U_GNSS_DEC_UBX_NAV_STATUS_GPS_FIX_DEAD_RECKONING_ONLY = 1,
+    U_GNSS_DEC_UBX_NAV_STATUS_GPS_FIX_2D = 2,
+    U_GNSS_DEC_UBX_NAV_STATUS_GPS_FIX_3D = 3,
+    U_GNSS_DEC_UBX_NAV_STATUS_GPS_FIX_GPS_PLUS_DEAD_RECKONING = 4,
+    U_GNSS_DEC_UBX_NAV_STATUS_GPS_FIX_TIME_ONLY = 5
+} uGnssDecUbxNavStatusGpsFix_t;
+
+/** Bit fields of the "flags" field of #uGnssDecUbxNavStatus_t; use
+ * these to mask specific bits, e.g.
+ *
+ * `if (flags & (1 << U_GNSS_DEC_UBX_NAV_STATUS_FLAGS_GPS_FIX_OK)) {`
+ *
+ * ...would determine if the fix is within the DOP and accuracy
+ * masks.
+ */
+typedef enum {
+    U_GNSS_DEC_UBX_NAV_STATUS_FLAGS_GPS_FIX_OK = 0, /**< position and velocity
+                                                         valid and within DOP
+                                                         and accuracy masks. */
+    U_GNSS_DEC_UBX_NAV_STATUS_FLAGS_DIFF_SOLN = 1,  /**< differential corrections
+                                                         were applied. */
+    U_GNSS_DEC_UBX_NAV_STATUS_FLAGS_WKN_SET = 2,    /**< week number valid. */
+    U_GNSS_DEC_UBX_NAV_STATUS_FLAGS_TOW_SET = 3     /**< time of week valid. */
+} uGnssDecUbxNavStatusFlags_t;
+
+/** UBX-NAV-STATUS message structure; the naming and type of each
+ * element follows that of the interface manual.
+ */
+typedef struct {
+    uint32_t iTOW;                         /**< GPS time of week of the
+                                                navigation epoch in
+                                                milliseconds. */
+    uGnssDecUbxNavStatusGpsFix_t gpsFix;   /**< the fix type achieved. */
+    uint8_t flags;                         /**< see #uGnssDecUbxNavStatusFlags_t. */
+    uint8_t fixStat;                       /**< fix status information, see
+                                                the interface manual. */
+    uint8_t flags2;                        /**< further information about
+                                                navigation output, e.g.
+                                                power save mode state and
+                                                spoofing detection state,
+                                                see the interface manual. */
+    uint32_t ttff;                         /**< time to first fix in
+                                                milliseconds. */
+    uint32_t msss;                         /**< milliseconds since startup
+                                                or reset. */
+} uGnssDecUbxNavStatus_t;
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @}*/
+
+#endif // _U_GNSS_DEC_UBX_NAV_STATUS_H_
+
+// End of file
@@ -0,0 +1,117 @@
+/*
+ * Copyright 2019-2024 u-blox
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _U_GNSS_DEC_UBX_NAV_TIMEUTC_H_
+#define _U_GNSS_DEC_UBX_NAV_TIMEUTC_H_
+
+/* Only header files representing a direct and unavoidable
+ * dependency between the API of this module and the API
+ * of another module should be included here; otherwise
+ * please keep #includes to your .c files. */
+
+/** \addtogroup _GNSS
+ *  @{
+ */
+
+/** @file
+ * @brief This header file defines the types of a UBX-NAV-TIMEUTC
+ * message.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ----------------------------------------------------------------
+ * COMPILE-TIME MACROS
+ * -------------------------------------------------------------- */
+
+/** The message class of a UBX-NAV-TIMEUTC message.
+ */
+#define U_GNSS_DEC_UBX_NAV_TIMEUTC_MESSAGE_CLASS 0x01
+
+/** The message ID of a UBX-NAV-TIMEUTC message.
+ */
+#define U_GNSS_DEC_UBX_NAV_TIMEUTC_MESSAGE_ID 0x21
+
+/** The minimum length of the body of a UBX-NAV-TIMEUTC message.
+ */
+#define U_GNSS_DEC_UBX_NAV_TIMEUTC_BODY_MIN_LENGTH 20
+
+/** Bit mask for the #U_GNSS_DEC_UBX_NAV_TIMEUTC_VALID_UTC_STANDARD
+ * field of #uGnssDecUbxNavTimeutcValid_t.
+ */
+#define U_GNSS_DEC_UBX_NAV_TIMEUTC_VALID_UTC_STANDARD_MASK (0x0f << U_GNSS_DEC_UBX_NAV_TIMEUTC_VALID_UTC_STANDARD)
+
+/* ----------------------------------------------------------------
+ * TYPES
+ * -------------------------------------------------------------- */
+
+/** Bit fields of the "valid" field of #uGnssDecUbxNavTimeutc_t; use
+ * these to mask specific bits, e.g.
+ *
+ * `if (valid & (1 << U_GNSS_DEC_UBX_NAV_TIMEUTC_VALID_UTC)) {`
+ *
+ * ...would determine if the UTC time is valid.  Note that the
+ * field #U_GNSS_DEC_UBX_NAV_TIMEUTC_VALID_UTC_STANDARD is wider
+ * than a single bit.
+ */
+typedef enum {
+    U_GNSS_DEC_UBX_NAV_TIMEUTC_VALID_TOW = 0,         /**< time of week is
+                                                           valid. */
+    U_GNSS_DEC_UBX_NAV_TIMEUTC_VALID_WKN = 1,         /**< week number is
+                                                           valid. */
+    U_GNSS_DEC_UBX_NAV_TIMEUTC_VALID_UTC = 2,         /**< UTC time is valid,
+                                                           leap seconds are
+                                                           known. */
+    U_GNSS_DEC_UBX_NAV_TIMEUTC_VALID_UTC_STANDARD = 4 /**< not a single bit,
+                                                           the start of a 4-bit
+                                                           field, use
+                                                           #U_GNSS_DEC_UBX_NAV_TIMEUTC_VALID_UTC_STANDARD_MASK
+                                                           to mask it and this
+                                                           to shift it down; the
+                                                           values are those of
+                                                           the interface manual,
+                                                           e.g. 3 for USNO. */
+} uGnssDecUbxNavTimeutcValid_t;
+
+/** UBX-NAV-TIMEUTC message structure; the naming and type of each
+ * element follows that of the interface manual.
+ */
+typedef struct {
+    uint32_t iTOW;  /**< GPS time of week of the navigation epoch
+                         in milliseconds. */
+    uint32_t tAcc;  /**< time accuracy estimate (UTC) in nanoseconds. */
+    int32_t nano;   /**< fraction of second, range -1e9 to 1e9 (UTC),
+                         in nanoseconds. */
+    uint16_t year;  /**< year (UTC). */
+    uint8_t month;  /**< month, range 1 to 12 (UTC). */
+    uint8_t day;    /**< day of month, range 1 to 31 (UTC). */
+    uint8_t hour;   /**< hour of day, range 0 to 23 (UTC). */
+    uint8_t min;    /**< minute of hour, range 0 to 59 (UTC). */
+    uint8_t sec;    /**< seconds of minute, range 0 to 60 (UTC). */
+    uint8_t valid;  /**< validity flags, see #uGnssDecUbxNavTimeutcValid_t. */
+} uGnssDecUbxNavTimeutc_t;
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @}*/
+
+#endif // _U_GNSS_DEC_UBX_NAV_TIMEUTC_H_
+
+// End of file
@@ -0,0 +1,283 @@
+/*
+ * Copyright 2019-2024 u-blox
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _U_GNSS_FRAMER_H_
+#define _U_GNSS_FRAMER_H_
+
+/* Only header files representing a direct and unavoidable
+ * dependency between the API of this module and the API
+ * of another module should be included here; otherwise
+ * please keep #includes to your .c files. */
+
+#include "u_spartn.h"
+#include "u_gnss_type.h"
+
+/** \addtogroup _GNSS
+ *  @{
+ */
+
+/** @file
+ * @brief This header file defines a streaming framer for the
+ * message protocols that pass to and from a GNSS device: UBX, NMEA,
+ * RTCM3 and SPARTN.  It finds where each message begins and ends
+ * in a stream of bytes and which message it is, checking the
+ * checksum/CRC of each; it does not decode message bodies, see
+ * u_gnss_dec.h for that.
+ *
+ * Data may be fed to the framer in chunks of any size, from a byte
+ * at a time upwards: the framer carries the state of a partially
+ * received message (header seen, length known, running checksum)
+ * across calls, so that each byte is examined once, however the
+ * stream is chopped up.  It is used internally, via
+ * uGnssFramerParseBlock(), to find the messages arriving from a
+ * GNSS device but it has no dependency on a GNSS device and may be
+ * used directly on data from a file or a socket, e.g. a log of
+ * a GNSS device's output or a correction stream.
+ *
+ * The framer is not thread-safe: a #uGnssFramer_t should be used
+ * by one thread at a time.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ----------------------------------------------------------------
+ * COMPILE-TIME MACROS
+ * -------------------------------------------------------------- */
+
+#ifndef U_GNSS_FRAMER_NMEA_LENGTH_MAX_BYTES
+/** The longest NMEA sentence, including the "$" and the CR/LF,
+ * that the framer will accept.  NMEA 0183 limits sentences to 82
+ * characters but u-blox proprietary sentences, e.g. PUBX,03, can
+ * be considerably longer.
+ */
+# define U_GNSS_FRAMER_NMEA_LENGTH_MAX_BYTES 1024
+#endif
+
+/** The maximum length of a frame that the framer can find, a
+ * UBX message with a 65535 byte body; a buffer of this size
+ * passed to uGnssFramerInit() is sufficient for any stream.
+ */
+#define U_GNSS_FRAMER_LENGTH_MAX_BYTES (65535 + 8)
+
+/** Form a bit for the protocolsBitmap parameter of
+ * uGnssFramerInit() from a #uGnssFramerProtocol_t.
+ */
+#define U_GNSS_FRAMER_PROTOCOL_BIT(protocol) (1UL << (protocol))
+
+/** A value for the protocolsBitmap parameter of uGnssFramerInit()
+ * that selects all of the protocols the framer knows.
+ */
+#define U_GNSS_FRAMER_PROTOCOLS_ALL ((1UL << U_GNSS_FRAMER_PROTOCOL_MAX_NUM) - 1)
+
+/* ----------------------------------------------------------------
+ * TYPES
+ * -------------------------------------------------------------- */
+
+/** The protocols that the framer knows; the values of the first
+ * three match the equivalents in #uGnssProtocol_t.
+ */
+typedef enum {
+    U_GNSS_FRAMER_PROTOCOL_UBX = 0,    /**< begins 0xB5 0x62. */
+    U_GNSS_FRAMER_PROTOCOL_NMEA = 1,   /**< begins "$". */
+    U_GNSS_FRAMER_PROTOCOL_RTCM = 2,   /**< RTCM3, begins 0xD3. */
+    U_GNSS_FRAMER_PROTOCOL_SPARTN = 3, /**< begins 0x73. */
+    U_GNSS_FRAMER_PROTOCOL_MAX_NUM,
+    U_GNSS_FRAMER_PROTOCOL_NONE        /**< no frame. */
+} uGnssFramerProtocol_t;
+
+/** A frame, as found by uGnssFramerFeed().
+ */
+typedef struct {
+    uGnssFramerProtocol_t protocol; /**< #U_GNSS_FRAMER_PROTOCOL_NONE if
+                                         no frame was found. */
+    union {
+        uint16_t ubx;    /**< message class in the most significant byte
+                              and message ID in the least significant byte. */
+        char nmea[U_GNSS_NMEA_MESSAGE_MATCH_LENGTH_CHARACTERS + 1]; /**< talker
+                                                                         and sentence,
+                                                                         e.g. "GPGGA",
+                                                                         null-terminated. */
+        uint16_t rtcm;   /**< the 12-bit message number, e.g. 1005. */
+        uint16_t spartn; /**< message type (TF002) in the most significant
+                              byte and message sub-type (TF007) in the
+                              least significant byte. */
+    } id;
+    size_t length;       /**< the length of the whole frame: header,
+                              body and checksum/CRC. */
+    const char *pData;   /**< a pointer to the whole frame; this points
+                              either into the data passed to
+                              uGnssFramerFeed() or, where the frame was
+                              split across calls, into the buffer passed
+                              to uGnssFramerInit(), and is valid until
+                              the next call to uGnssFramerFeed().  NULL if
+                              the frame was split across calls and did not
+                              fit into the buffer. */
+} uGnssFramerFrame_t;
+
+/** The state of a framer: the contents should be treated as private,
+ * they are only exposed so that a framer can be declared statically
+ * or on the stack.
+ */
+typedef struct {
+    /* Candidate state: all zero when a candidate begins. */
+    size_t count;         /**< the number of bytes of the candidate seen. */
+    size_t length;        /**< the length of the candidate once known, else 0. */
+    size_t crcOffset;     /**< the offset of the checksum/CRC once known. */
+    uint32_t crc;         /**< the running checksum/CRC. */
+    uint16_t id;          /**< the message ID so far or, for NMEA,
+                               the number of ID characters in scratch. */
+    uint8_t protocol;     /**< a #uGnssFramerProtocol_t, once count > 0. */
+    uint8_t phase;        /**< the NMEA phase. */
+    union {
+        char nmea[U_GNSS_NMEA_MESSAGE_MATCH_LENGTH_CHARACTERS]; /**< NMEA ID. */
+        uSpartnCandidate_t spartn; /**< SPARTN candidate, count and
+                                        length copied to those above. */
+    } scratch;
+    /* Stream state, only used by uGnssFramerFeed(). */
+    uint32_t protocolsBitmap;
+    char *pBuffer;
+    size_t bufferSize;
+    size_t bufferLength;  /**< bytes of the candidate in pBuffer. */
+    size_t pendingOffset; /**< if non-zero, bytes in pBuffer from here
+                               must be framed before any new data. */
+} uGnssFramer_t;
+
+/* ----------------------------------------------------------------
+ * FUNCTIONS
+ * -------------------------------------------------------------- */
+
+/** Initialise a framer.  A framer needs no resources of its own and
+ * so there is no "deinit"; it may be re-initialised at any time.
+ *
+ * A buffer may be provided for the framer to keep the bytes of a
+ * frame that is split across calls to uGnssFramerFeed().  With it
+ * the framer is able to return a pointer to the whole of such a
+ * frame and, if what looked like the start of a frame turns out not
+ * to be, look again for frames among the bytes it had taken in,
+ * exactly as if all of the data had been passed in one call; the
+ * buffer size is then also the longest frame that will be found,
+ * so that a corrupt length field cannot cause more data than that
+ * to be passed over.  #U_GNSS_FRAMER_LENGTH_MAX_BYTES will allow
+ * any frame; if UBX messages of more than a couple of kbytes are
+ * not of interest then 2048 bytes is fine.  Without a buffer,
+ * frames of any length are found, with pData NULL if they were
+ * split across calls, but bytes from earlier calls are not looked
+ * at again, so frames may be missed after corrupt data.
+ *
+ * @param[out] pFramer       a pointer to the framer; cannot be NULL.
+ * @param protocolsBitmap    the protocols to find, a bit-map of
+ *                           #U_GNSS_FRAMER_PROTOCOL_BIT(), e.g.
+ *                           #U_GNSS_FRAMER_PROTOCOLS_ALL.
+ * @param[in] pBuffer        a buffer for frames that are split across
+ *                           calls, must remain valid while the framer
+ *                           is in use; may be NULL.
+ * @param bufferSize         the number of bytes at pBuffer.
+ * @return                   zero on success else negative error code.
+ */
+int32_t uGnssFramerInit(uGnssFramer_t *pFramer, uint32_t protocolsBitmap,
+                        char *pBuffer, size_t bufferSize);
+
+/** Forget any partial frame, e.g. because the next data will not
+ * follow on from the last (a seek in a file, a reconnected socket).
+ *
+ * @param[in,out] pFramer a pointer to the framer; cannot be NULL.
+ */
+void uGnssFramerReset(uGnssFramer_t *pFramer);
+
+/** Feed data to a framer.  The data is consumed up to and including
+ * the end of the first frame that completes, which is returned in
+ * pFrame, or all of it if no frame completes; call this function
+ * again with the remaining data until there is none left and no frame
+ * is returned, for instance:
+ *
+ * ```
+ * uGnssFramerFrame_t frame;
+ * int32_t x;
+ *
+ * do {
+ *     x = uGnssFramerFeed(&framer, pData, length, &frame);
+ *     if (frame.protocol != U_GNSS_FRAMER_PROTOCOL_NONE) {
+ *         // Do something with the frame here
+ *     }
+ *     pData += x;
+ *     length -= x;
+ * } while ((length > 0) || (frame.protocol != U_GNSS_FRAMER_PROTOCOL_NONE));
+ * ```
+ *
+ * Bytes that are not part of any frame are skipped.
+ *
+ * @param[in,out] pFramer a pointer to the framer; cannot be NULL.
+ * @param[in] pData       the data; may be NULL if length is zero.
+ * @param length          the number of bytes at pData.
+ * @param[out] pFrame     a place to put the frame; cannot be NULL.
+ *                        protocol is set to #U_GNSS_FRAMER_PROTOCOL_NONE
+ *                        if no frame was completed.
+ * @return                the number of bytes of pData consumed, which
+ *                        may be zero if a frame was returned from
+ *                        data already taken in, else negative error
+ *                        code.
+ */
+int32_t uGnssFramerFeed(uGnssFramer_t *pFramer, const char *pData,
+                        size_t length, uGnssFramerFrame_t *pFrame);
+
+/** Tell a framer that the data has ended, e.g. at the end of a
+ * file: any partial frame is abandoned and, if the framer has a
+ * buffer, the bytes of it are looked at again for frames that it
+ * may have been hiding.  Call this until no frame is returned.
+ *
+ * @param[in,out] pFramer a pointer to the framer; cannot be NULL.
+ * @param[out] pFrame     a place to put the frame; cannot be NULL.
+ *                        protocol is set to #U_GNSS_FRAMER_PROTOCOL_NONE
+ *                        if there are no more frames.
+ * @return                zero on success else negative error code.
+ */
+int32_t uGnssFramerFlush(uGnssFramer_t *pFramer, uGnssFramerFrame_t *pFrame);
+
+/** The framer as a block parser, for use with
+ * uRingBufferParseBlockHandle(): put this function in a
+ * #uRingBufferBlockParser_t with a stateSize of sizeof(#uGnssFramer_t)
+ * and, as sync bytes, the first bytes of the protocols that are
+ * wanted (0xB5 for UBX, '$' for NMEA, 0xD3 for RTCM, 0x73 for SPARTN).
+ * The ring buffer then does the looking for frames, keeping hold of
+ * the data; this function only frames the candidate that it is given,
+ * hence the stream-related parts of the state are not used.  The
+ * pData field of the frame is not populated.
+ *
+ * @param[in,out] pState  a #uGnssFramer_t, zeroed when the candidate
+ *                        frame begins.
+ * @param[in] pData       the next block of the candidate frame.
+ * @param length          the number of bytes at pData.
+ * @param[out] pUserParam a #uGnssFramerFrame_t, written when the frame
+ *                        is complete.
+ * @return                #U_ERROR_COMMON_TIMEOUT if more data is needed,
+ *                        #U_ERROR_COMMON_NOT_FOUND if this is not a frame
+ *                        else the number of bytes of pData that completed
+ *                        the frame.
+ */
+int32_t uGnssFramerParseBlock(void *pState, const char *pData, size_t length,
+                              void *pUserParam);
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @}*/
+
+#endif // _U_GNSS_FRAMER_H_
+
+// End of file
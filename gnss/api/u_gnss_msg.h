@@ -154,6 +154,72 @@ typedef void (*uGnssMsgReceiveCallback_t)(uDeviceHandle_t gnssHandle,
                                           int32_t errorCodeOrLength,
                                           void *pCallbackParam);
 
+/** A callback which will be called by uGnssMsgReceiveStartSpan()
+ * when a matching message has been received from the GNSS chip.
+ * This is the same as #uGnssMsgReceiveCallback_t except that the
+ * message is passed to the callback as it sits in the internal
+ * ring buffer, in up to two pieces (the second only if the message
+ * wraps around the end of the ring buffer), so there is no need to
+ * copy it out with uGnssMsgReceiveCallbackRead(); this is useful if
+ * the callback only needs a few fields of the message.
+ *
+ * IMPORTANT: the lifetime of the data pointed to by pSpans is the
+ * duration of the callback and no longer; the data must not be
+ * modified, nor may the pointers be kept for use after the callback
+ * has returned.  If an earlier callback for the same message called
+ * uGnssMsgReceiveCallbackExtract() then the spans will cover only
+ * what is left of the message, hence the total length of the spans
+ * should be checked, rather than errorCodeOrLength, before reading
+ * from them.  The same restrictions on the GNSS API calls that may
+ * be made as for #uGnssMsgReceiveCallback_t apply.
+ *
+ * For instance, to get the iTOW field of a UBX-NAV-PVT message,
+ * which begins at offset 6 (i.e. straight after the UBX header),
+ * the callback might be:
+ *
+ * ```
+ * void myCallback(uDeviceHandle_t gnssHandle,
+ *                 const uGnssMessageId_t *pMessageId,
+ *                 int32_t errorCodeOrLength,
+ *                 const uRingBufferSpan_t *pSpans,
+ *                 void *pCallbackParam)
+ * {
+ *     char buffer[4];
+ *     size_t offset = 6;
+ *
+ *     (void) gnssHandle;
+ *     (void) pMessageId;
+ *     (void) errorCodeOrLength;
+ *     if (pSpans[0].length + pSpans[1].length >= offset + sizeof(buffer)) {
+ *         for (size_t x = 0; x < sizeof(buffer); x++, offset++) {
+ *             buffer[x] = (offset < pSpans[0].length) ? pSpans[0].pData[offset] :
+ *                         pSpans[1].pData[offset - pSpans[0].length];
+ *         }
+ *         *((uint32_t *) pCallbackParam) = uUbxProtocolUint32Decode(buffer);
+ *     }
+ * }
+ * ```
+ *
+ * @param gnssHandle             the handle of the GNSS instance.
+ * @param[out] pMessageId        a pointer to the message ID that was
+ *                               detected.
+ * @param errorCodeOrLength      as for #uGnssMsgReceiveCallback_t.
+ * @param[in] pSpans             a pointer to an array of TWO spans
+ *                               which between them hold the message,
+ *                               including headers and checksums etc.;
+ *                               the length of a span that is not
+ *                               needed will be zero, as will both if
+ *                               there is no message to read (e.g. a
+ *                               NACK).
+ * @param[in,out] pCallbackParam the callback parameter that was originally
+ *                               given to uGnssMsgReceiveStartSpan().
+ */
+typedef void (*uGnssMsgReceiveSpanCallback_t)(uDeviceHandle_t gnssHandle,
+                                              const uGnssMessageId_t *pMessageId,
+                                              int32_t errorCodeOrLength,
+                                              const uRingBufferSpan_t *pSpans,
+                                              void *pCallbackParam);
+
 /* ----------------------------------------------------------------
  * FUNCTIONS: MISC
  * -------------------------------------------------------------- */
@@ -371,6 +437,33 @@ int32_t uGnssMsgReceiveStart(uDeviceHandle_t gnssHandle,
                              uGnssMsgReceiveCallback_t pCallback,
                              void *pCallbackParam);
 
+/** As uGnssMsgReceiveStart() but the message is passed to pCallback
+ * in place in the internal ring buffer, with no copying or
+ * allocation; see #uGnssMsgReceiveSpanCallback_t for the rules
+ * pCallback must follow.  Callbacks set with this function and with
+ * uGnssMsgReceiveStart() may be mixed, they are all stopped in the
+ * same way and count towards the same #U_GNSS_MSG_RECEIVER_MAX_NUM.
+ *
+ * IMPORTANT: this does not work for modules connected via an AT
+ * transport, please instead open a Virtual Serial connection for
+ * that case (see uCellMuxAddChannel()).
+ *
+ * @param gnssHandle             the handle of the GNSS instance.
+ * @param[in] pMessageId         a pointer to the message ID to capture;
+ *                               a copy will be taken so this may be
+ *                               on the stack; cannot be NULL.
+ * @param[in] pCallback          the callback to be called when a
+ *                               matching message arrives; cannot be NULL.
+ * @param[in] pCallbackParam     will be passed to pCallback as its last
+ *                               parameter.
+ * @return                       a handle for this asynchronous reader on
+ *                               success, else negative error code.
+ */
+int32_t uGnssMsgReceiveStartSpan(uDeviceHandle_t gnssHandle,
+                                 const uGnssMessageId_t *pMessageId,
+                                 uGnssMsgReceiveSpanCallback_t pCallback,
+                                 void *pCallbackParam);
+
 /** To be called from the pCallback of uGnssMsgReceiveStart() to take
  * a peek at the message data from the internal ring buffer, copying it
  * (including any headers and checksums) into your buffer but NOT REMOVING
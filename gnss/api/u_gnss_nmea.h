@@ -0,0 +1,401 @@
+/*
+ * Copyright 2019-2024 u-blox
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _U_GNSS_NMEA_H_
+#define _U_GNSS_NMEA_H_
+
+/* Only header files representing a direct and unavoidable
+ * dependency between the API of this module and the API
+ * of another module should be included here; otherwise
+ * please keep #includes to your .c files. */
+
+/** \addtogroup _GNSS
+ *  @{
+ */
+
+/** @file
+ * @brief This header file defines a streaming decoder for the NMEA
+ * sentences most often of interest from a GNSS device: GGA, RMC,
+ * GSA, GSV, VTG, GST and ZDA.  Each character is looked at once:
+ * the fields are tokenised and converted to fixed-point integers
+ * as they arrive and written straight into the typed structure of
+ * the sentence, so there is no copy of the sentence, no call to
+ * sscanf() or strtod(), no floating point and no memory allocation.
+ *
+ * Data may be fed to the decoder in chunks of any size, from a byte
+ * at a time upwards, the decoder carrying its state across calls;
+ * this means that it can be given the two spans of a message
+ * passed to a #uGnssMsgReceiveSpanCallback_t (see
+ * uGnssMsgReceiveStartSpan()) in turn, decoding the sentence where
+ * it sits in the ring buffer, e.g.:
+ *
+ * ```
+ * static void callback(uDeviceHandle_t gnssHandle,
+ *                      const uGnssMessageId_t *pMessageId,
+ *                      int32_t errorCodeOrLength,
+ *                      const uRingBufferSpan_t *pSpans,
+ *                      void *pCallbackParam)
+ * {
+ *     uGnssNmea_t *pNmea = (uGnssNmea_t *) pCallbackParam;
+ *     uGnssNmeaSentence_t sentence;
+ *
+ *     for (size_t x = 0; x < 2; x++) {
+ *         uGnssNmeaFeed(pNmea, pSpans[x].pData, pSpans[x].length, &sentence);
+ *         if (sentence.type == U_GNSS_NMEA_SENTENCE_TYPE_GGA) {
+ *             // Do something with sentence.gga
+ *         }
+ *     }
+ * }
+ * ```
+ *
+ * ...or, where the whole sentence is in a buffer, e.g. from
+ * uGnssMsgReceive(), uGnssNmeaDecode() may be used.
+ *
+ * Numeric fields are converted to integers in the units of the
+ * sentence, scaled by a fixed power of ten (e.g. HDOP as
+ * hdopX100), except that latitude and longitude are converted from
+ * degrees and minutes to degrees * 10^7, and lengths from metres
+ * to millimetres, as uGnssPosGet() does.  An empty field leaves
+ * the member zero: the fieldsPresent bit-map of #uGnssNmeaSentence_t
+ * says which fields were present.
+ *
+ * The decoder is not thread-safe: a #uGnssNmea_t should be used
+ * by one thread at a time.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ----------------------------------------------------------------
+ * COMPILE-TIME MACROS
+ * -------------------------------------------------------------- */
+
+#ifndef U_GNSS_NMEA_SENTENCE_LENGTH_MAX_BYTES
+/** The longest NMEA sentence, including the "$" and the checksum,
+ * that the decoder will accept: a sentence that runs on for longer
+ * than this is abandoned.  NMEA 0183 limits sentences to 82
+ * characters, this allows some leeway.
+ */
+# define U_GNSS_NMEA_SENTENCE_LENGTH_MAX_BYTES 128
+#endif
+
+/** The maximum number of satellite IDs in a GSA sentence.
+ */
+#define U_GNSS_NMEA_GSA_SV_MAX_NUM 12
+
+/** The maximum number of satellites in a GSV sentence.
+ */
+#define U_GNSS_NMEA_GSV_SAT_MAX_NUM 4
+
+/** Determine if field number field of a #uGnssNmeaSentence_t was
+ * present (not empty), where field 0 is the field after the
+ * address field (e.g. the time in a GGA sentence).
+ */
+#define U_GNSS_NMEA_FIELD_PRESENT(pSentence, field) ((((pSentence)->fieldsPresent) >> (field)) & 1)
+
+/* ----------------------------------------------------------------
+ * TYPES
+ * -------------------------------------------------------------- */
+
+/** The NMEA sentences that the decoder knows.
+ */
+typedef enum {
+    U_GNSS_NMEA_SENTENCE_TYPE_GGA = 0, /**< position fix. */
+    U_GNSS_NMEA_SENTENCE_TYPE_RMC = 1, /**< recommended minimum data. */
+    U_GNSS_NMEA_SENTENCE_TYPE_GSA = 2, /**< DOP and active satellites. */
+    U_GNSS_NMEA_SENTENCE_TYPE_GSV = 3, /**< satellites in view. */
+    U_GNSS_NMEA_SENTENCE_TYPE_VTG = 4, /**< course over ground and
+                                            ground speed. */
+    U_GNSS_NMEA_SENTENCE_TYPE_GST = 5, /**< pseudorange error statistics. */
+    U_GNSS_NMEA_SENTENCE_TYPE_ZDA = 6, /**< time and date. */
+    U_GNSS_NMEA_SENTENCE_TYPE_MAX_NUM,
+    U_GNSS_NMEA_SENTENCE_TYPE_NONE     /**< no sentence. */
+} uGnssNmeaSentenceType_t;
+
+/** A GGA sentence: time, position and fix related data.
+ */
+typedef struct {
+    int32_t timeMs;                /**< field 0: UTC time of day in
+                                        milliseconds. */
+    int32_t latitudeX1e7;          /**< fields 1 and 2: latitude in
+                                        degrees * 10^7, negative
+                                        for south. */
+    int32_t longitudeX1e7;         /**< fields 3 and 4: longitude in
+                                        degrees * 10^7, negative
+                                        for west. */
+    uint8_t quality;               /**< field 5: quality indicator,
+                                        0 for no fix, 1 for autonomous
+                                        GNSS fix, 2 for differential,
+                                        4 for RTK fixed, 5 for RTK
+                                        float, 6 for dead reckoning. */
+    uint8_t numSv;                 /**< field 6: the number of satellites
+                                        used. */
+    uint16_t hdopX100;             /**< field 7: horizontal dilution of
+                                        precision * 100. */
+    int32_t altitudeMillimetres;   /**< field 8: altitude above mean
+                                        sea level. */
+    int32_t separationMillimetres; /**< field 10: geoid separation. */
+    int32_t diffAgeMs;             /**< field 12: age of differential
+                                        corrections. */
+    uint16_t diffStation;          /**< field 13: ID of the station
+                                        providing differential
+                                        corrections. */
+} uGnssNmeaGga_t;
+
+/** An RMC sentence: recommended minimum data.
+ */
+typedef struct {
+    int32_t timeMs;               /**< field 0: UTC time of day in
+                                       milliseconds. */
+    char status;                  /**< field 1: 'A' for data valid,
+                                       'V' for data invalid. */
+    int32_t latitudeX1e7;         /**< fields 2 and 3: latitude in
+                                       degrees * 10^7, negative
+                                       for south. */
+    int32_t longitudeX1e7;        /**< fields 4 and 5: longitude in
+                                       degrees * 10^7, negative
+                                       for west. */
+    int32_t speedKnotsX1000;      /**< field 6: speed over ground in
+                                       knots * 1000. */
+    int32_t courseX100;           /**< field 7: course over ground in
+                                       degrees * 100. */
+    uint8_t day;                  /**< field 8: day of the month, 1 to 31. */
+    uint8_t month;                /**< field 8: month, 1 to 12. */
+    uint16_t year;                /**< field 8: year, e.g. 2024. */
+    int32_t magneticVariationX100; /**< fields 9 and 10: magnetic
+                                        variation in degrees * 100,
+                                        negative for west. */
+    char posMode;                 /**< field 11: mode indicator, e.g. 'A'
+                                       for autonomous, 'D' for
+                                       differential, 'N' for no fix. */
+    char navStatus;               /**< field 12: navigational status,
+                                       NMEA 4.10 and later. */
+} uGnssNmeaRmc_t;
+
+/** A GSA sentence: DOP and active satellites.
+ */
+typedef struct {
+    char opMode;        /**< field 0: 'M' for manual, 'A' for automatic. */
+    uint8_t navMode;    /**< field 1: 1 for no fix, 2 for 2D, 3 for 3D. */
+    uint8_t numSv;      /**< the number of satellite IDs in svId, the
+                             number of fields 2 to 13 present. */
+    uint8_t svId[U_GNSS_NMEA_GSA_SV_MAX_NUM]; /**< fields 2 to 13: the IDs
+                                                   of the satellites used,
+                                                   in the order they
+                                                   appear. */
+    uint16_t pdopX100;  /**< field 14: position dilution of precision * 100. */
+    uint16_t hdopX100;  /**< field 15: horizontal dilution of precision * 100. */
+    uint16_t vdopX100;  /**< field 16: vertical dilution of precision * 100. */
+    uint8_t systemId;   /**< field 17: GNSS system ID, NMEA 4.10 and later. */
+} uGnssNmeaGsa_t;
+
+/** A satellite in a GSV sentence.
+ */
+typedef struct {
+    uint8_t svId;       /**< satellite ID. */
+    int8_t elevation;   /**< elevation in degrees. */
+    uint16_t azimuth;   /**< azimuth in degrees. */
+    uint8_t cno;        /**< signal strength in dBHz, zero if the
+                             satellite is not being tracked. */
+} uGnssNmeaGsvSat_t;
+
+/** A GSV sentence: satellites in view.
+ */
+typedef struct {
+    uint8_t numMsg;     /**< field 0: the number of GSV sentences
+                             in this set. */
+    uint8_t msgNum;     /**< field 1: the number of this sentence in
+                             the set, starting at 1. */
+    uint8_t numSvInView; /**< field 2: the number of satellites in view. */
+    uint8_t numSat;     /**< the number of satellites in sat. */
+    uGnssNmeaGsvSat_t sat[U_GNSS_NMEA_GSV_SAT_MAX_NUM]; /**< fields 3
+                                                             to 18, in
+                                                             groups of
+                                                             four. */
+    uint8_t signalId;   /**< the last field: signal ID, NMEA 4.10
+                             and later, zero if not present. */
+} uGnssNmeaGsv_t;
+
+/** A VTG sentence: course over ground and ground speed.
+ */
+typedef struct {
+    int32_t courseTrueX100;        /**< field 0: course over ground
+                                        (true) in degrees * 100. */
+    int32_t courseMagneticX100;    /**< field 2: course over ground
+                                        (magnetic) in degrees * 100. */
+    int32_t speedKnotsX1000;       /**< field 4: speed over ground in
+                                        knots * 1000. */
+    int32_t speedKilometresPerHourX1000; /**< field 6: speed over
+                                              ground in kilometres
+                                              per hour * 1000. */
+    char posMode;                  /**< field 8: mode indicator. */
+} uGnssNmeaVtg_t;
+
+/** A GST sentence: pseudorange error statistics.
+ */
+typedef struct {
+    int32_t timeMs;                /**< field 0: UTC time of day in
+                                        milliseconds. */
+    int32_t rangeRmsMillimetres;   /**< field 1: RMS value of the standard
+                                        deviation of the ranges. */
+    int32_t stdMajorMillimetres;   /**< field 2: standard deviation of
+                                        the semi-major axis. */
+    int32_t stdMinorMillimetres;   /**< field 3: standard deviation of
+                                        the semi-minor axis. */
+    int32_t orientationX100;       /**< field 4: orientation of the
+                                        semi-major axis in degrees * 100. */
+    int32_t stdLatitudeMillimetres; /**< field 5: standard deviation of
+                                         latitude error. */
+    int32_t stdLongitudeMillimetres; /**< field 6: standard deviation of
+                                          longitude error. */
+    int32_t stdAltitudeMillimetres; /**< field 7: standard deviation of
+                                         altitude error. */
+} uGnssNmeaGst_t;
+
+/** A ZDA sentence: time and date.
+ */
+typedef struct {
+    int32_t timeMs;          /**< field 0: UTC time of day in
+                                  milliseconds. */
+    uint8_t day;             /**< field 1: day of the month, 1 to 31. */
+    uint8_t month;           /**< field 2: month, 1 to 12. */
+    uint16_t year;           /**< field 3: year, e.g. 2024. */
+    int8_t localZoneHours;   /**< field 4: local time zone hours. */
+    uint8_t localZoneMinutes; /**< field 5: local time zone minutes. */
+} uGnssNmeaZda_t;
+
+/** A decoded NMEA sentence.
+ */
+typedef struct {
+    uGnssNmeaSentenceType_t type; /**< #U_GNSS_NMEA_SENTENCE_TYPE_NONE if
+                                       there is no sentence. */
+    char talker[3];               /**< the talker ID, e.g. "GN",
+                                       null-terminated. */
+    uint32_t fieldsPresent;       /**< bit n is set if field n was present,
+                                       see #U_GNSS_NMEA_FIELD_PRESENT. */
+    union {
+        uGnssNmeaGga_t gga;
+        uGnssNmeaRmc_t rmc;
+        uGnssNmeaGsa_t gsa;
+        uGnssNmeaGsv_t gsv;
+        uGnssNmeaVtg_t vtg;
+        uGnssNmeaGst_t gst;
+        uGnssNmeaZda_t zda;
+    };
+} uGnssNmeaSentence_t;
+
+/** The state of an NMEA decoder: the contents should be treated as
+ * private, they are only exposed so that a decoder can be declared
+ * statically or on the stack.
+ */
+typedef struct {
+    /* Sentence state. */
+    uint8_t phase;         /**< where we are in the sentence. */
+    uint8_t checksum;      /**< the running checksum. */
+    uint8_t checksumReceived; /**< the first digit of the checksum. */
+    uint8_t fieldIndex;    /**< the field being tokenised. */
+    uint16_t count;        /**< the characters of the sentence so far. */
+    char formatter[3];     /**< the sentence formatter, e.g. "GGA". */
+    /* Token state: all zero when a field begins. */
+    int64_t mantissa;      /**< the digits of the field. */
+    uint8_t numDigits;     /**< the number of digits in mantissa. */
+    uint8_t numDecimals;   /**< of which after the decimal point. */
+    uint8_t length;        /**< the number of characters in the field. */
+    bool negative;         /**< a minus sign was seen. */
+    bool point;            /**< a decimal point was seen. */
+    bool notNumeric;       /**< something other than a number was seen. */
+    char character;        /**< the first character of the field. */
+    uGnssNmeaSentence_t sentence; /**< the sentence being decoded. */
+    uint32_t errorCount;   /**< sentences of a known type abandoned
+                                because the checksum was wrong or the
+                                sentence was too long, for information. */
+} uGnssNmea_t;
+
+/* ----------------------------------------------------------------
+ * FUNCTIONS
+ * -------------------------------------------------------------- */
+
+/** Initialise an NMEA decoder.  A decoder needs no resources of
+ * its own and so there is no "deinit"; it may be re-initialised at
+ * any time, e.g. because the next data will not follow on from the
+ * last.
+ *
+ * @param[out] pNmea a pointer to the decoder; cannot be NULL.
+ * @return           zero on success else negative error code.
+ */
+int32_t uGnssNmeaInit(uGnssNmea_t *pNmea);
+
+/** Feed data to an NMEA decoder.  The data is consumed up to and
+ * including the end of the checksum of the first sentence of a
+ * known type that completes, which is returned in pSentence, or all
+ * of it if no sentence completes; call this function again with the
+ * remaining data until there is none left, for instance:
+ *
+ * ```
+ * uGnssNmeaSentence_t sentence;
+ * int32_t x;
+ *
+ * while (length > 0) {
+ *     x = uGnssNmeaFeed(&nmea, pData, length, &sentence);
+ *     if (sentence.type != U_GNSS_NMEA_SENTENCE_TYPE_NONE) {
+ *         // Do something with the sentence here
+ *     }
+ *     pData += x;
+ *     length -= x;
+ * }
+ * ```
+ *
+ * Anything other than a sentence of a known type with a correct
+ * checksum is skipped.
+ *
+ * @param[in,out] pNmea   a pointer to the decoder; cannot be NULL.
+ * @param[in] pData       the data; may be NULL if length is zero.
+ * @param length          the number of bytes at pData.
+ * @param[out] pSentence  a place to put the sentence; cannot be NULL.
+ *                        type is set to #U_GNSS_NMEA_SENTENCE_TYPE_NONE
+ *                        if no sentence was completed.
+ * @return                the number of bytes of pData consumed, else
+ *                        negative error code.
+ */
+int32_t uGnssNmeaFeed(uGnssNmea_t *pNmea, const char *pData,
+                      size_t length, uGnssNmeaSentence_t *pSentence);
+
+/** Decode a single, whole, NMEA sentence, for example from
+ * uGnssMsgReceive() or the callback of uGnssMsgReceiveStart().
+ * The sentence must begin at the start of pBuffer and include
+ * the checksum; the CR/LF on the end may be omitted.
+ *
+ * @param[in] pBuffer     the sentence; cannot be NULL.
+ * @param size            the number of bytes at pBuffer.
+ * @param[out] pSentence  a place to put the sentence; cannot be NULL.
+ * @return                zero on success, #U_ERROR_COMMON_NOT_FOUND
+ *                        if pBuffer does not contain a sentence of a
+ *                        known type with a correct checksum, else
+ *                        negative error code.
+ */
+int32_t uGnssNmeaDecode(const char *pBuffer, size_t size,
+                        uGnssNmeaSentence_t *pSentence);
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @}*/
+
+#endif // _U_GNSS_NMEA_H_
+
+// End of file
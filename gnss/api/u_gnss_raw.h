@@ -0,0 +1,285 @@
+/*
+ * Copyright 2019-2024 u-blox
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _U_GNSS_RAW_H_
+#define _U_GNSS_RAW_H_
+
+/* Only header files representing a direct and unavoidable
+ * dependency between the API of this module and the API
+ * of another module should be included here; otherwise
+ * please keep #includes to your .c files. */
+
+#include "u_gnss_framer.h"
+
+/** \addtogroup _GNSS
+ *  @{
+ */
+
+/** @file
+ * @brief This header file defines a streaming decoder for the raw
+ * measurement messages of a GNSS device, UBX-RXM-RAWX and
+ * UBX-RXM-SFRBX, intended for logging raw measurements or feeding
+ * them to a post-processing filter on the device.
+ *
+ * The decoder is fed a stream of bytes, e.g. as read from a
+ * GNSS device or from a log file, in chunks of any size, or whole
+ * UBX messages, e.g. from the callback of
+ * uGnssMsgReceiveStartSpan().  It writes each epoch of measurements
+ * directly, without allocating memory or copying the message, into
+ * a ring of #uGnssRawEpoch_t supplied by the caller: each
+ * #uGnssRawEpoch_t holds the measurements of a UBX-RXM-RAWX message
+ * in "structure of arrays" form, one array per field indexed by
+ * measurement, so that a filter can sweep a field (e.g. all of the
+ * pseudoranges) without pointer chasing, plus the navigation data
+ * subframes, UBX-RXM-SFRBX, that arrived with that epoch.  Other
+ * messages in the stream are ignored.
+ *
+ * An epoch is complete when its UBX-RXM-RAWX message arrives; any
+ * UBX-RXM-SFRBX messages that arrive between one UBX-RXM-RAWX
+ * message and the next are put into the next epoch.
+ *
+ * The decoder is not thread-safe: a #uGnssRaw_t should be used by
+ * one thread at a time.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ----------------------------------------------------------------
+ * COMPILE-TIME MACROS
+ * -------------------------------------------------------------- */
+
+#ifndef U_GNSS_RAW_MEAS_MAX_NUM
+/** The maximum number of measurements in a #uGnssRawEpoch_t; any
+ * more in a UBX-RXM-RAWX message are dropped, and counted in
+ * #uGnssRawStats_t.
+ */
+# define U_GNSS_RAW_MEAS_MAX_NUM 64
+#endif
+
+#ifndef U_GNSS_RAW_SUBFRAMES_MAX_NUM
+/** The maximum number of navigation data subframes in a
+ * #uGnssRawEpoch_t; any more are dropped, and counted in
+ * #uGnssRawStats_t.
+ */
+# define U_GNSS_RAW_SUBFRAMES_MAX_NUM 32
+#endif
+
+#ifndef U_GNSS_RAW_SUBFRAME_WORDS_MAX_NUM
+/** The maximum number of data words of a navigation data subframe
+ * that are kept; 10 is enough for all current signals.
+ */
+# define U_GNSS_RAW_SUBFRAME_WORDS_MAX_NUM 10
+#endif
+
+/** The message class of a UBX-RXM-SFRBX message.
+ */
+#define U_GNSS_RAW_UBX_RXM_SFRBX_MESSAGE_CLASS 0x02
+
+/** The message ID of a UBX-RXM-SFRBX message.
+ */
+#define U_GNSS_RAW_UBX_RXM_SFRBX_MESSAGE_ID 0x13
+
+/* ----------------------------------------------------------------
+ * TYPES
+ * -------------------------------------------------------------- */
+
+/** One epoch of raw measurements, the contents of a UBX-RXM-RAWX
+ * message plus the UBX-RXM-SFRBX messages that arrived with it.
+ * Each measurement field is an array indexed by measurement,
+ * from 0 to numMeas - 1, and each subframe field an array indexed
+ * by subframe, from 0 to numSubframes - 1; array entries beyond
+ * those counts are not written and so may contain anything.  The
+ * naming, type and units of each field follow those of the
+ * interface manual, see also #uGnssDecUbxRxmRawx_t.
+ */
+typedef struct {
+    double rcvTow;            /**< measurement time of week in receiver
+                                   local time, in seconds. */
+    uint16_t week;            /**< GPS week number in receiver local time. */
+    int8_t leapS;             /**< GPS leap seconds (GPS-UTC). */
+    uint8_t recStat;          /**< see #uGnssDecUbxRxmRawxRecStat_t. */
+    uint8_t numMeas;          /**< the number of measurements. */
+    uint8_t numSubframes;     /**< the number of subframes. */
+    /* Measurements, widest first to keep the arrays aligned */
+    double prMes[U_GNSS_RAW_MEAS_MAX_NUM];      /**< pseudorange in metres. */
+    double cpMes[U_GNSS_RAW_MEAS_MAX_NUM];      /**< carrier phase in cycles. */
+    float doMes[U_GNSS_RAW_MEAS_MAX_NUM];       /**< Doppler in Hz. */
+    uint16_t locktime[U_GNSS_RAW_MEAS_MAX_NUM]; /**< carrier phase locktime
+                                                     in milliseconds. */
+    uint8_t gnssId[U_GNSS_RAW_MEAS_MAX_NUM];    /**< GNSS identifier. */
+    uint8_t svId[U_GNSS_RAW_MEAS_MAX_NUM];      /**< satellite identifier. */
+    uint8_t sigId[U_GNSS_RAW_MEAS_MAX_NUM];     /**< signal identifier. */
+    uint8_t freqId[U_GNSS_RAW_MEAS_MAX_NUM];    /**< GLONASS frequency slot + 7. */
+    uint8_t cno[U_GNSS_RAW_MEAS_MAX_NUM];       /**< carrier to noise ratio
+                                                     in dBHz. */
+    uint8_t prStdev[U_GNSS_RAW_MEAS_MAX_NUM];   /**< pseudorange standard
+                                                     deviation, 0.01 * 2^n
+                                                     metres. */
+    uint8_t cpStdev[U_GNSS_RAW_MEAS_MAX_NUM];   /**< carrier phase standard
+                                                     deviation, 0.004 * n
+                                                     cycles. */
+    uint8_t doStdev[U_GNSS_RAW_MEAS_MAX_NUM];   /**< Doppler standard
+                                                     deviation, 0.002 * 2^n
+                                                     Hz. */
+    uint8_t trkStat[U_GNSS_RAW_MEAS_MAX_NUM];   /**< see
+                                                     #uGnssDecUbxRxmRawxTrkStat_t. */
+    /* Subframes */
+    uint32_t sfDwrd[U_GNSS_RAW_SUBFRAMES_MAX_NUM][U_GNSS_RAW_SUBFRAME_WORDS_MAX_NUM]; /**< the data
+                                                                                          words of
+                                                                                          each
+                                                                                          subframe. */
+    uint8_t sfGnssId[U_GNSS_RAW_SUBFRAMES_MAX_NUM];   /**< GNSS identifier. */
+    uint8_t sfSvId[U_GNSS_RAW_SUBFRAMES_MAX_NUM];     /**< satellite identifier. */
+    uint8_t sfSigId[U_GNSS_RAW_SUBFRAMES_MAX_NUM];    /**< signal identifier. */
+    uint8_t sfFreqId[U_GNSS_RAW_SUBFRAMES_MAX_NUM];   /**< GLONASS frequency
+                                                           slot + 7. */
+    uint8_t sfNumWords[U_GNSS_RAW_SUBFRAMES_MAX_NUM]; /**< the number of words
+                                                           in sfDwrd, at most
+                                                           #U_GNSS_RAW_SUBFRAME_WORDS_MAX_NUM. */
+    uint8_t sfChn[U_GNSS_RAW_SUBFRAMES_MAX_NUM];      /**< tracking channel. */
+} uGnssRawEpoch_t;
+
+/** Statistics kept by the decoder.
+ */
+typedef struct {
+    uint32_t rawxCount;        /**< UBX-RXM-RAWX messages decoded. */
+    uint32_t sfrbxCount;       /**< UBX-RXM-SFRBX messages decoded. */
+    uint32_t badCount;         /**< UBX-RXM-RAWX or UBX-RXM-SFRBX messages
+                                    that were too short to be decoded. */
+    uint32_t epochsDropped;    /**< epochs dropped because the ring of
+                                    epochs was full. */
+    uint32_t measDropped;      /**< measurements dropped because there
+                                    were more than #U_GNSS_RAW_MEAS_MAX_NUM. */
+    uint32_t subframesDropped; /**< subframes dropped because there were
+                                    more than #U_GNSS_RAW_SUBFRAMES_MAX_NUM,
+                                    or the ring of epochs was full. */
+} uGnssRawStats_t;
+
+/** The state of a decoder: the contents should be treated as private,
+ * they are only exposed so that a decoder can be declared statically
+ * or on the stack.
+ */
+typedef struct {
+    uGnssFramer_t framer;
+    uGnssRawEpoch_t *pEpoch;
+    size_t numEpochs;
+    size_t readIndex;   /**< the oldest complete epoch. */
+    size_t numComplete; /**< the number of complete epochs. */
+    bool building;      /**< true if the epoch after the newest
+                             complete one has been begun. */
+    uGnssRawStats_t stats;
+} uGnssRaw_t;
+
+/* ----------------------------------------------------------------
+ * FUNCTIONS
+ * -------------------------------------------------------------- */
+
+/** Initialise a decoder.  A decoder needs no resources of its own
+ * and so there is no "deinit"; it may be re-initialised at any time.
+ *
+ * @param[out] pRaw       a pointer to the decoder; cannot be NULL.
+ * @param[in] pEpochs     the ring of epochs to decode into, which must
+ *                        remain valid while the decoder is in use;
+ *                        cannot be NULL.  Once the ring is full of
+ *                        complete epochs that have not been released,
+ *                        further epochs are dropped.
+ * @param numEpochs       the number of epochs at pEpochs, at least 1.
+ * @param[in] pBuffer     a buffer for messages that are split across
+ *                        calls to uGnssRawFeed(), see uGnssFramerInit(),
+ *                        which must be at least as long as the longest
+ *                        UBX-RXM-RAWX message expected (16 + 32 bytes
+ *                        per measurement, plus 8); may be NULL if only
+ *                        uGnssRawDecode() is to be used.
+ * @param bufferSize      the number of bytes at pBuffer.
+ * @return                zero on success else negative error code.
+ */
+int32_t uGnssRawInit(uGnssRaw_t *pRaw, uGnssRawEpoch_t *pEpochs,
+                     size_t numEpochs, char *pBuffer, size_t bufferSize);
+
+/** Feed a stream of data to a decoder; the data may be chopped up
+ * in any way and may contain messages of any protocol, only those
+ * UBX-RXM-RAWX and UBX-RXM-SFRBX messages with a correct checksum
+ * are decoded.
+ *
+ * @param[in,out] pRaw  a pointer to the decoder; cannot be NULL.
+ * @param[in] pData     the data; may be NULL if length is zero.
+ * @param length        the number of bytes at pData.
+ * @return              on success the number of complete epochs
+ *                      waiting to be read, else negative error code.
+ */
+int32_t uGnssRawFeed(uGnssRaw_t *pRaw, const char *pData, size_t length);
+
+/** Decode a single, whole, UBX message, e.g. as passed to the
+ * callback of uGnssMsgReceiveStartSpan(); the checksum is not
+ * checked and may be omitted.  Messages other than UBX-RXM-RAWX
+ * and UBX-RXM-SFRBX are ignored.
+ *
+ * @param[in,out] pRaw    a pointer to the decoder; cannot be NULL.
+ * @param[in] pMessage    the message, beginning with 0xB5 0x62;
+ *                        cannot be NULL.
+ * @param size            the number of bytes at pMessage.
+ * @return                on success the number of complete epochs
+ *                        waiting to be read, else negative error
+ *                        code, e.g. #U_ERROR_COMMON_TRUNCATED if a
+ *                        UBX-RXM-RAWX or UBX-RXM-SFRBX message was
+ *                        too short to be decoded.
+ */
+int32_t uGnssRawDecode(uGnssRaw_t *pRaw, const char *pMessage, size_t size);
+
+/** Tell a decoder that the data has ended, e.g. at the end of a
+ * log file: any message that the framer was holding back is
+ * decoded and, if there are subframes without an epoch, they are
+ * completed as an epoch with no measurements.
+ *
+ * @param[in,out] pRaw  a pointer to the decoder; cannot be NULL.
+ * @return              on success the number of complete epochs
+ *                      waiting to be read, else negative error code.
+ */
+int32_t uGnssRawFlush(uGnssRaw_t *pRaw);
+
+/** Get the oldest complete epoch, which remains valid, and in the
+ * ring, until uGnssRawEpochRelease() is called.
+ *
+ * @param[in] pRaw  a pointer to the decoder; cannot be NULL.
+ * @return          a pointer to the epoch, NULL if there are no
+ *                  complete epochs.
+ */
+const uGnssRawEpoch_t *pUGnssRawEpochGet(const uGnssRaw_t *pRaw);
+
+/** Release the oldest complete epoch, making room in the ring.
+ *
+ * @param[in,out] pRaw  a pointer to the decoder; cannot be NULL.
+ */
+void uGnssRawEpochRelease(uGnssRaw_t *pRaw);
+
+/** Get the statistics of a decoder.
+ *
+ * @param[in] pRaw     a pointer to the decoder; cannot be NULL.
+ * @param[out] pStats  a place to put the statistics; cannot be NULL.
+ */
+void uGnssRawGetStats(const uGnssRaw_t *pRaw, uGnssRawStats_t *pStats);
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @}*/
+
+#endif // _U_GNSS_RAW_H_
+
+// End of file
@@ -0,0 +1,328 @@
+/*
+ * Copyright 2019-2024 u-blox
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _U_GNSS_RTCM_H_
+#define _U_GNSS_RTCM_H_
+
+/* Only header files representing a direct and unavoidable
+ * dependency between the API of this module and the API
+ * of another module should be included here; otherwise
+ * please keep #includes to your .c files. */
+
+/** \addtogroup _GNSS
+ *  @{
+ */
+
+/** @file
+ * @brief This header file defines a decoder for the body of RTCM3
+ * messages, for those who need to inspect, filter or re-encode a
+ * stream of corrections, e.g. one received from a GNSS base station
+ * or sent by a GNSS device in base-station mode.
+ *
+ * uGnssRtcmDecode() is given a whole RTCM3 message, 0xD3 to CRC, as
+ * found by the framer (see u_gnss_framer.h) or as passed to the
+ * callback of uGnssMsgReceiveStart() with an RTCM message ID.  It
+ * checks the CRC-24Q of the message and decodes:
+ *
+ * - 1005 and 1006: the antenna reference point of a station,
+ * - 1230: the GLONASS code-phase biases of a station,
+ * - the Multiple Signal Messages (MSM) 4, 5, 6 and 7 of all
+ *   constellations, 1074 to 1077 for GPS, 1084 to 1087 for GLONASS,
+ *   1094 to 1097 for Galileo, 1104 to 1107 for SBAS, 1114 to 1117 for
+ *   QZSS, 1124 to 1127 for BeiDou and 1134 to 1137 for NavIC.
+ *
+ * The fields of each message are returned as the integers carried
+ * in the message, without scaling, so that they may be filtered and
+ * written back into a message without loss; the scale of each is
+ * given in the field's comment, with the RTCM data field number
+ * (DFnnn).  The fields of an MSM are returned in "structure of
+ * arrays" form: one array per satellite field, indexed by satellite,
+ * and one array per signal field, indexed by cell (i.e. by
+ * satellite/signal pair), so that a field may be swept for all
+ * satellites or signals without pointer chasing.
+ *
+ * The bit-field extractor that the decoder uses is also exposed,
+ * uGnssRtcmBitsGet(), so that messages this code does not decode
+ * can be picked apart without re-implementing it, as is the CRC,
+ * uGnssRtcmCrc24q().
+ *
+ * These functions are thread-safe.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ----------------------------------------------------------------
+ * COMPILE-TIME MACROS
+ * -------------------------------------------------------------- */
+
+/** The number of bytes of an RTCM3 message before the message
+ * body: 0xD3, six reserved bits and ten bits of length.
+ */
+#define U_GNSS_RTCM_HEADER_LENGTH_BYTES 3
+
+/** The number of bytes of CRC-24Q at the end of an RTCM3 message.
+ */
+#define U_GNSS_RTCM_CRC_LENGTH_BYTES 3
+
+/** The maximum length of the body of an RTCM3 message.
+ */
+#define U_GNSS_RTCM_BODY_LENGTH_MAX_BYTES 1023
+
+/** The maximum number of satellites in an MSM: the number of bits
+ * in the satellite mask.
+ */
+#define U_GNSS_RTCM_MSM_SATELLITES_MAX_NUM 64
+
+/** The maximum number of signals in an MSM: the number of bits in
+ * the signal mask.
+ */
+#define U_GNSS_RTCM_MSM_SIGNALS_MAX_NUM 32
+
+/** The maximum number of cells, satellite/signal pairs, in an MSM:
+ * the maximum size of the cell mask.
+ */
+#define U_GNSS_RTCM_MSM_CELLS_MAX_NUM 64
+
+/** The value of roughRangeMs in #uGnssRtcmMsm_t which indicates that
+ * the rough range of a satellite is not valid.
+ */
+#define U_GNSS_RTCM_MSM_ROUGH_RANGE_INVALID 0xFF
+
+/* ----------------------------------------------------------------
+ * TYPES
+ * -------------------------------------------------------------- */
+
+/** The antenna reference point of a station, RTCM3 message 1005
+ * or 1006.
+ */
+typedef struct {
+    uint16_t stationId;        /**< DF003: reference station ID. */
+    uint8_t itrfYear;          /**< DF021: reserved for ITRF realisation
+                                    year. */
+    bool gps;                  /**< DF022: GPS indicator. */
+    bool glonass;              /**< DF023: GLONASS indicator. */
+    bool galileo;              /**< DF024: Galileo indicator. */
+    bool referenceStation;     /**< DF141: true if this is a physical
+                                    rather than a non-physical/computed
+                                    reference station. */
+    bool singleOscillator;     /**< DF142: single receiver oscillator
+                                    indicator. */
+    uint8_t quarterCycle;      /**< DF364: quarter cycle indicator. */
+    int64_t ecefX;             /**< DF025: antenna reference point
+                                    ECEF-X in units of 0.0001 metres. */
+    int64_t ecefY;             /**< DF026: antenna reference point
+                                    ECEF-Y in units of 0.0001 metres. */
+    int64_t ecefZ;             /**< DF027: antenna reference point
+                                    ECEF-Z in units of 0.0001 metres. */
+    uint16_t antennaHeight;    /**< DF028: antenna height in units of
+                                    0.0001 metres; message 1006 only,
+                                    zero for message 1005. */
+} uGnssRtcmStation_t;
+
+/** The GLONASS code-phase biases of a station, RTCM3 message 1230.
+ */
+typedef struct {
+    uint16_t stationId;        /**< DF003: reference station ID. */
+    bool aligned;              /**< DF421: GLONASS code-phase bias
+                                    indicator. */
+    uint8_t signalMask;        /**< DF422: bit 3 set for L1 C/A, bit 2
+                                    for L1 P, bit 1 for L2 C/A and bit 0
+                                    for L2 P; only the biases of signals
+                                    with a bit set are present. */
+    int16_t l1Ca;              /**< DF423: L1 C/A code-phase bias in
+                                    units of 0.02 metres. */
+    int16_t l1P;               /**< DF424: L1 P code-phase bias in
+                                    units of 0.02 metres. */
+    int16_t l2Ca;              /**< DF425: L2 C/A code-phase bias in
+                                    units of 0.02 metres. */
+    int16_t l2P;               /**< DF426: L2 P code-phase bias in
+                                    units of 0.02 metres. */
+} uGnssRtcmGlonassBias_t;
+
+/** A Multiple Signal Message, MSM4, MSM5, MSM6 or MSM7, of any
+ * constellation.  Satellite fields are arrays indexed from 0 to
+ * numSatellites - 1, signal fields arrays indexed by cell from 0
+ * to numCells - 1; array entries beyond those counts are not
+ * written and so may contain anything.  Where a field is not
+ * carried by the type of MSM it is left at zero; where a field has
+ * a different width in different types of MSM it is noted, and the
+ * fine pseudorange/phase-range and CNR fields of an MSM4/MSM5 are
+ * returned at the scale carried in the message, not the scale of
+ * the MSM6/MSM7.
+ */
+typedef struct {
+    uint8_t msmType;           /**< 4, 5, 6 or 7. */
+    uint16_t stationId;        /**< DF003: reference station ID. */
+    uint32_t epochTime;        /**< GNSS epoch time, 30 bits, in
+                                    milliseconds of the week for all
+                                    but GLONASS, where it is DF416,
+                                    day of week, in the upper three
+                                    bits and DF034, milliseconds of
+                                    the day, in the lower 27 bits. */
+    bool multipleMessage;      /**< DF393: true if more MSMs follow
+                                    for this epoch and station ID. */
+    uint8_t iods;              /**< DF409: issue of data station. */
+    uint8_t clockSteering;     /**< DF411: clock steering indicator. */
+    uint8_t externalClock;     /**< DF412: external clock indicator. */
+    bool smoothing;            /**< DF417: divergence-free smoothing
+                                    indicator. */
+    uint8_t smoothingInterval; /**< DF418: smoothing interval. */
+    uint64_t satelliteMask;    /**< DF394: the most significant bit
+                                    represents satellite ID 1. */
+    uint32_t signalMask;       /**< DF395: the most significant bit
+                                    represents signal ID 1. */
+    uint64_t cellMask;         /**< DF396: numSatellites * numSignals
+                                    bits, right-aligned, the most
+                                    significant of which represents
+                                    the first signal of the first
+                                    satellite. */
+    uint8_t numSatellites;     /**< the number of bits set in
+                                    satelliteMask. */
+    uint8_t numSignals;        /**< the number of bits set in
+                                    signalMask. */
+    uint8_t numCells;          /**< the number of bits set in cellMask. */
+    /** The satellite ID, 1 to 64, of each satellite. */
+    uint8_t satelliteId[U_GNSS_RTCM_MSM_SATELLITES_MAX_NUM];
+    /** The signal ID, 1 to 32, of each signal, indexed from 0 to
+     * numSignals - 1. */
+    uint8_t signalId[U_GNSS_RTCM_MSM_SIGNALS_MAX_NUM];
+    /* Satellite fields */
+    /** DF397: the integer milliseconds of the rough range,
+     * #U_GNSS_RTCM_MSM_ROUGH_RANGE_INVALID if invalid. */
+    uint8_t roughRangeMs[U_GNSS_RTCM_MSM_SATELLITES_MAX_NUM];
+    /** Extended satellite information, MSM5/MSM7 only. */
+    uint8_t extendedInfo[U_GNSS_RTCM_MSM_SATELLITES_MAX_NUM];
+    /** DF398: the rough range modulo 1 millisecond, in units of
+     * 2^-10 milliseconds. */
+    uint16_t roughRangeModuloMs[U_GNSS_RTCM_MSM_SATELLITES_MAX_NUM];
+    /** DF399: the rough phase-range rate in metres/second,
+     * MSM5/MSM7 only. */
+    int16_t roughPhaseRangeRate[U_GNSS_RTCM_MSM_SATELLITES_MAX_NUM];
+    /* Signal fields, indexed by cell */
+    /** The index into the satellite fields of the satellite of
+     * each cell. */
+    uint8_t cellSatellite[U_GNSS_RTCM_MSM_CELLS_MAX_NUM];
+    /** The index into signalId of the signal of each cell. */
+    uint8_t cellSignal[U_GNSS_RTCM_MSM_CELLS_MAX_NUM];
+    /** DF400, in units of 2^-24 milliseconds, for MSM4/MSM5, DF405,
+     * in units of 2^-29 milliseconds, for MSM6/MSM7: the fine
+     * pseudorange. */
+    int32_t finePseudorange[U_GNSS_RTCM_MSM_CELLS_MAX_NUM];
+    /** DF401, in units of 2^-29 milliseconds, for MSM4/MSM5, DF406,
+     * in units of 2^-31 milliseconds, for MSM6/MSM7: the fine
+     * phase-range. */
+    int32_t finePhaseRange[U_GNSS_RTCM_MSM_CELLS_MAX_NUM];
+    /** DF404: the fine phase-range rate in units of 0.0001
+     * metres/second, MSM5/MSM7 only. */
+    int16_t finePhaseRangeRate[U_GNSS_RTCM_MSM_CELLS_MAX_NUM];
+    /** DF402, 4 bits, for MSM4/MSM5, DF407, 10 bits, for MSM6/MSM7:
+     * the phase-range lock time indicator. */
+    uint16_t lockTime[U_GNSS_RTCM_MSM_CELLS_MAX_NUM];
+    /** DF403, in units of 1 dB-Hz, for MSM4/MSM5, DF408, in units of
+     * 2^-4 dB-Hz, for MSM6/MSM7: the carrier to noise ratio. */
+    uint16_t cnr[U_GNSS_RTCM_MSM_CELLS_MAX_NUM];
+    /** DF420: the half-cycle ambiguity indicator. */
+    bool halfCycleAmbiguity[U_GNSS_RTCM_MSM_CELLS_MAX_NUM];
+} uGnssRtcmMsm_t;
+
+/** A decoded RTCM3 message.
+ */
+typedef struct {
+    uint16_t messageType;      /**< DF002: the message type, e.g. 1005. */
+    union {
+        uGnssRtcmStation_t station;         /**< message 1005 or 1006. */
+        uGnssRtcmGlonassBias_t glonassBias; /**< message 1230. */
+        uGnssRtcmMsm_t msm;                 /**< MSM4 to MSM7. */
+    };
+} uGnssRtcmMessage_t;
+
+/* ----------------------------------------------------------------
+ * FUNCTIONS
+ * -------------------------------------------------------------- */
+
+/** Calculate the CRC-24Q of a block of data, as used by RTCM3.
+ * The calculation may be carried out a piece at a time by passing
+ * the return value of one call in as crc to the next.
+ *
+ * @param[in] pData  a pointer to the data; must not be NULL unless
+ *                   length is zero.
+ * @param length     the number of bytes at pData.
+ * @param crc        the CRC so far, zero for the first piece.
+ * @return           the CRC-24Q, in the lower 24 bits.
+ */
+uint32_t uGnssRtcmCrc24q(const char *pData, size_t length, uint32_t crc);
+
+/** Get a bit-field from a buffer in which bit-fields are packed
+ * most significant bit first, as in the body of an RTCM3 message.
+ * The bits must lie within the buffer, i.e. offsetBits + numBits
+ * must not be greater than size * 8, otherwise zero is returned.
+ *
+ * @param[in] pBuffer  a pointer to the buffer; cannot be NULL.
+ * @param size         the number of bytes at pBuffer.
+ * @param offsetBits   the offset of the first bit of the bit-field
+ *                     from the start of pBuffer, in bits.
+ * @param numBits      the number of bits in the bit-field, 1 to 64.
+ * @return             the bit-field, right-aligned.
+ */
+uint64_t uGnssRtcmBitsGet(const char *pBuffer, size_t size,
+                          size_t offsetBits, size_t numBits);
+
+/** As uGnssRtcmBitsGet() but for a two's complement signed bit-field,
+ * which is sign-extended.
+ *
+ * @param[in] pBuffer  a pointer to the buffer; cannot be NULL.
+ * @param size         the number of bytes at pBuffer.
+ * @param offsetBits   the offset of the first bit of the bit-field
+ *                     from the start of pBuffer, in bits.
+ * @param numBits      the number of bits in the bit-field, 1 to 64.
+ * @return             the bit-field, sign-extended.
+ */
+int64_t uGnssRtcmBitsGetSigned(const char *pBuffer, size_t size,
+                               size_t offsetBits, size_t numBits);
+
+/** Decode a whole RTCM3 message.  The messages that can be decoded
+ * are listed at the top of this file; for any other message the
+ * CRC is still checked and the messageType field of pMessage is
+ * still populated, so that a stream of RTCM3 messages can be
+ * filtered by type, but #U_ERROR_COMMON_NOT_SUPPORTED is returned.
+ *
+ * @param[in] pBuffer   a pointer to the message, starting with 0xD3
+ *                      and ending with the CRC; cannot be NULL.
+ * @param size          the number of bytes at pBuffer; may be more
+ *                      than the length of the message, in which
+ *                      case the remainder is ignored.
+ * @param[out] pMessage a place to put the decoded message; cannot
+ *                      be NULL.
+ * @return              the message type on success, else negative
+ *                      error code: #U_ERROR_COMMON_BAD_DATA if the
+ *                      message is not a good RTCM3 message, or is
+ *                      too short for its contents, e.g. because
+ *                      its cell mask is too long.
+ */
+int32_t uGnssRtcmDecode(const char *pBuffer, size_t size,
+                        uGnssRtcmMessage_t *pMessage);
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @}*/
+
+#endif // _U_GNSS_RTCM_H_
+
+// End of file
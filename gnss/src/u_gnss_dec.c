@@ -25,7 +25,15 @@
  * API, used for decoding a useful subset of messages from a GNSS
  * device.
  *
- * To add a new message to the set of message decoders:
+ * UBX messages are decoded by a single, generic, engine,
+ * decodeUbx(), driven by a schema for each message: a table,
+ * generated at compile-time by the U_GNSS_DEC_FIELD() macro, that
+ * gives the type and offset of each field in the message body and
+ * the member of the message structure it is written to.  Messages
+ * that carry a repeated block (e.g. one per satellite) have a
+ * second table for the block, plus a description of where the
+ * count of blocks is found.  To add a new message to the set of
+ * message decoders:
  *
  * 1.  Create a .h file in the "api" directory which defines the
  * message; for example, if you were creating a decoder for the
@@ -36,42 +44,44 @@
  * current UBX-NAV-PVT decoder does, and document them all well,
  * including units, to produce a good set of Doxygen documentation
  * so that the customer doesn't have to keep referring back to the
- * interface manual: see u_gnss_dec_ubx_nav_pvt.h for an example.
+ * interface manual: see u_gnss_dec_ubx_nav_pvt.h for an example,
+ * or u_gnss_dec_ubx_nav_sat.h for a message with repeated blocks.
  * Make sure to follow the usual pattern for the header file gating
  * \#defines and the _MESSAGE_CLASS, _MESSAGE_ID and _BODY_MIN_LENGTH
- * macros.  You may also choose to define helper functions which
- * convert the elements of the structure as defined by the GNSS
- * device interface manual into more friendly structures.
+ * macros (plus _BLOCK_LENGTH and a maximum number of blocks for a
+ * message with repeated blocks).  You may also choose to define
+ * helper functions which convert the elements of the structure as
+ * defined by the GNSS device interface manual into more friendly
+ * structures.
  *
  * 2. \#include this new header file in u_gnss_dec.h, add it to
  * ubxlib.h and add the new message struct to the #uGnssDecUnion_t
- * in this file.
+ * in u_gnss_dec.h.
  *
- * 3. Create the static decode function for the message here,
- * following the naming pattern, e.g. for UBX-XXX-YYY the function
- * would be named ubxXxxYyyAlloc(); the function  must have the
- * function signature of #uGnssDecKnownFunction_t.
+ * 3. Write the schema for the message here, following the naming
+ * pattern, e.g. for UBX-XXX-YYY the field table would be named
+ * gFieldUbxXxxYyy[] and the schema gSchemaUbxXxxYyy, with one
+ * U_GNSS_DEC_FIELD() line for each field of the message body,
+ * giving the offset and type from the interface manual.
  *
- * 4. Add the static function to the gpFunctionList array and add
- * its message ID to the gIdList array, making sure to put it in the
- * same position in both.
+ * 4. Add an entry for the message to U_GNSS_DEC_UBX_MESSAGE_LIST.
  *
  * 5. If in step (1) you chose to include helper functions, add a
  * .c file in this src directory, of the same name as the .h file,
  * which implements the helper functions; see u_gnss_dec_ubx_nav_pvt.c
  * for an example.
  *
- * 6. Add at least one test vector for the function to the
+ * 6. Add at least one test vector for the message to the
  * gTestDataKnownSet array in u_gnss_dec_test.c, using the pattern
  * of gUbxNavPvt as an example, and a spot-test for each helper
  * function if there are any (again, see the handling of UBX-NAV-PVT
  * for an example).
  *
  * Obviously it would be possible to add NMEA messages, or RTCM messages,
- * in the same way, just replacing "ubx" with "nmea" or "rtcm", but note
- * that this code does not use NMEA or RTCM messages and we want to avoid
- * code bloat, hence the uGnssDecSetCallback() hook to allow a customer
- * to add their own decoders at run-time.
+ * in a similar way, but note that this code does not use NMEA or RTCM
+ * messages and we want to avoid code bloat, hence the
+ * uGnssDecSetCallback() hook to allow a customer to add their own
+ * decoders at run-time.
  */
 
 #ifdef U_CFG_OVERRIDE
@@ -104,35 +114,126 @@
  * COMPILE-TIME MACROS
  * -------------------------------------------------------------- */
 
+/** Form a #uGnssDecField_t for the member of the message structure
+ * structType that is at payloadOffset in the message body and is of
+ * UBX type type (U1, I1, X1, U2, I2, X2, U4, I4, X4, R4 or R8).  The
+ * member may be wider than the UBX type (e.g. an enum for a U1) but
+ * should not be narrower.
+ */
+#define U_GNSS_DEC_FIELD(structType, payloadOffset, type, member) {         \
+            payloadOffset, U_GNSS_DEC_TYPE_##type,                          \
+            sizeof(((structType *) 0)->member), offsetof(structType, member) \
+        }
+
+/** The number of elements in an array of #uGnssDecField_t.
+ */
+#define U_GNSS_DEC_NUM_FIELDS(fieldArray) (sizeof(fieldArray) / sizeof(fieldArray[0]))
+
+/** The list of UBX messages that can be decoded: the NAME in
+ * U_GNSS_DEC_UBX_NAME_MESSAGE_CLASS etc. and the schema for each.
+ * gIdList and gpSchemaList are both generated from this, so
+ * that they are always in the same order.
+ */
+#define U_GNSS_DEC_UBX_MESSAGE_LIST(ENTRY)         \
+    ENTRY(NAV_PVT, gSchemaUbxNavPvt)               \
+    ENTRY(NAV_HPPOSLLH, gSchemaUbxNavHpposllh)     \
+    ENTRY(NAV_DOP, gSchemaUbxNavDop)               \
+    ENTRY(NAV_STATUS, gSchemaUbxNavStatus)         \
+    ENTRY(NAV_TIMEUTC, gSchemaUbxNavTimeutc)       \
+    ENTRY(NAV_SAT, gSchemaUbxNavSat)               \
+    ENTRY(NAV_SIG, gSchemaUbxNavSig)               \
+    ENTRY(ESF_MEAS, gSchemaUbxEsfMeas)             \
+    ENTRY(RXM_RAWX, gSchemaUbxRxmRawx)             \
+    ENTRY(MON_RF, gSchemaUbxMonRf)
+
+/** Form an entry of gIdList from an entry of
+ * U_GNSS_DEC_UBX_MESSAGE_LIST.
+ */
+#define U_GNSS_DEC_ID_LIST_ENTRY(name, schema) {                                   \
+            .type = U_GNSS_PROTOCOL_UBX,                                           \
+            .id.ubx = U_GNSS_UBX_MESSAGE(U_GNSS_DEC_UBX_##name##_MESSAGE_CLASS,    \
+                                         U_GNSS_DEC_UBX_##name##_MESSAGE_ID)       \
+        },
+
+/** Form an entry of gpSchemaList from an entry of
+ * U_GNSS_DEC_UBX_MESSAGE_LIST.
+ */
+#define U_GNSS_DEC_SCHEMA_LIST_ENTRY(name, schema) &schema,
+
 /* ----------------------------------------------------------------
  * TYPES
  * -------------------------------------------------------------- */
 
-/** Private version of function that can be hooked into
- * pUGnssDecAlloc() by uGnssDecSetCallback() to decode message types
- * that _are_ known to this code.
- *
- * @param[in] pBuffer             the buffer pointer that was passed to
- *                                pUGnssDecAlloc().
- * @param size                    the number of bytes at pBuffer;
- *                                for a known protocol it _might_
- *                                be that any FCS/check-sum bytes
- *                                on the end have been removed
- *                                by the caller, hence the function
- *                                should not _require_ them to be
- *                                present in the count.
- * @param[out] ppBody             a pointer to a place to put the
- *                                decoded message body, which the
- *                                callback should allocate using
- *                                pUPortMalloc(); will never be NULL.
- * @return                        zero on a successful decode, else
- *                                negative error code, preferably
- *                                from the set suggested for the
- *                                errorCode field of #uGnssDec_t.
+/** The field types of the UBX protocol; the X (bit-field) types
+ * decode as the U type of the same width.
+ */
+typedef enum {
+    U_GNSS_DEC_TYPE_U1,
+    U_GNSS_DEC_TYPE_I1,
+    U_GNSS_DEC_TYPE_U2,
+    U_GNSS_DEC_TYPE_I2,
+    U_GNSS_DEC_TYPE_U4,
+    U_GNSS_DEC_TYPE_I4,
+    U_GNSS_DEC_TYPE_R4,
+    U_GNSS_DEC_TYPE_R8,
+    U_GNSS_DEC_TYPE_MAX_NUM,
+    U_GNSS_DEC_TYPE_X1 = U_GNSS_DEC_TYPE_U1,
+    U_GNSS_DEC_TYPE_X2 = U_GNSS_DEC_TYPE_U2,
+    U_GNSS_DEC_TYPE_X4 = U_GNSS_DEC_TYPE_U4
+} uGnssDecType_t;
+
+/** The description of one field of a message: where it is in the
+ * message body and where it goes in the message structure; use
+ * U_GNSS_DEC_FIELD() to form one.
  */
-typedef int32_t (uGnssDecKnownFunction_t) (const char *pBuffer,
-                                           size_t size,
-                                           uGnssDecUnion_t **ppBody);
+typedef struct {
+    uint16_t payloadOffset; /**< offset of the field in the message body. */
+    uint8_t type;           /**< a #uGnssDecType_t. */
+    uint8_t size;           /**< the size of the structure member. */
+    uint16_t structOffset;  /**< offset of the member in the structure. */
+} uGnssDecField_t;
+
+/** The description of the repeated blocks of a message.
+ */
+typedef struct {
+    const uGnssDecField_t *pField;  /**< the fields of each block, offsets
+                                         relative to the start of the block. */
+    size_t numFields;               /**< the number of elements at pField. */
+    uint16_t payloadOffset;         /**< offset of the first block in the
+                                         message body. */
+    uint16_t length;                /**< the length of a block in the
+                                         message body. */
+    uGnssDecField_t count;          /**< where the number of blocks is in the
+                                         message body and the structure member
+                                         it is written to, after limiting to
+                                         maxNum. */
+    uint8_t countShift;             /**< shift applied to count in the message
+                                         body before countMask. */
+    uint8_t countMask;              /**< mask applied to count in the message
+                                         body after countShift. */
+    uint16_t structOffset;          /**< offset of the array of blocks in the
+                                         structure. */
+    uint16_t structSize;            /**< the size of an element of that array. */
+    uint16_t maxNum;                /**< the number of elements in that array. */
+    const uGnssDecField_t *pTrailerField; /**< any fields after the blocks,
+                                               offsets relative to the end
+                                               of the blocks; decoded if
+                                               present; may be NULL. */
+    size_t numTrailerFields;        /**< the number of elements at
+                                         pTrailerField. */
+} uGnssDecSchemaBlocks_t;
+
+/** The schema of a message.
+ */
+typedef struct {
+    size_t bodySize;                   /**< the size of the message structure. */
+    size_t bodyMinLength;              /**< the minimum length of the
+                                            message body. */
+    const uGnssDecField_t *pField;     /**< the fields of the message body. */
+    size_t numFields;                  /**< the number of elements at pField. */
+    const uGnssDecSchemaBlocks_t *pBlocks; /**< the repeated blocks, NULL if
+                                                there are none. */
+} uGnssDecSchema_t;
 
 /* ----------------------------------------------------------------
  * STATIC VARIABLES: MISC
@@ -146,135 +247,554 @@ static uGnssDecFunction_t *gpCallback = NULL;
  */
 static void *gpCallbackParam = NULL;
 
-/** The list of known message IDs; order is important,
- * MUST be in the same order as gpFunctionList (see further
- * down in this file) and both lists must contain the same number
- * of elements.
+/** Mutex protecting the pool of decode slots, NULL if there is
+ * no pool.
+ */
+static uPortMutexHandle_t gPoolMutex = NULL;
+
+/** The pool of decode slots given to uGnssDecPoolInit().
+ */
+static uGnssDecSlot_t *gpPoolSlot = NULL;
+
+/** The number of slots at gpPoolSlot.
+ */
+static size_t gPoolNumSlots = 0;
+
+/** The size of each #uGnssDecType_t in the message body.
+ */
+static const uint8_t gTypeSize[] = {1, 1, 2, 2, 4, 4, 4, 8};
+
+/** The list of known message IDs; in the same order as
+ * gpSchemaList since both are generated from
+ * U_GNSS_DEC_UBX_MESSAGE_LIST.
  */
 static const uGnssMessageId_t gIdList[] = {
-    {
-        .type = U_GNSS_PROTOCOL_UBX,
-        .id.ubx = U_GNSS_UBX_MESSAGE(U_GNSS_DEC_UBX_NAV_PVT_MESSAGE_CLASS, U_GNSS_DEC_UBX_NAV_PVT_MESSAGE_ID)
-    },
-    {
-        .type = U_GNSS_PROTOCOL_UBX,
-        .id.ubx = U_GNSS_UBX_MESSAGE(U_GNSS_DEC_UBX_NAV_HPPOSLLH_MESSAGE_CLASS, U_GNSS_DEC_UBX_NAV_HPPOSLLH_MESSAGE_ID)
-    }
+    U_GNSS_DEC_UBX_MESSAGE_LIST(U_GNSS_DEC_ID_LIST_ENTRY)
+};
+
+// MORE STATIC VARIABLES after the message schemas...
+
+/* ----------------------------------------------------------------
+ * STATIC VARIABLES: MESSAGE SCHEMAS
+ * -------------------------------------------------------------- */
+
+/** UBX-NAV-PVT.
+ */
+static const uGnssDecField_t gFieldUbxNavPvt[] = {
+    U_GNSS_DEC_FIELD(uGnssDecUbxNavPvt_t, 0, U4, iTOW),
+    U_GNSS_DEC_FIELD(uGnssDecUbxNavPvt_t, 4, U2, year),
+    U_GNSS_DEC_FIELD(uGnssDecUbxNavPvt_t, 6, U1, month),
+    U_GNSS_DEC_FIELD(uGnssDecUbxNavPvt_t, 7, U1, day),
+    U_GNSS_DEC_FIELD(uGnssDecUbxNavPvt_t, 8, U1, hour),
+    U_GNSS_DEC_FIELD(uGnssDecUbxNavPvt_t, 9, U1, min),
+    U_GNSS_DEC_FIELD(uGnssDecUbxNavPvt_t, 10, U1, sec),
+    U_GNSS_DEC_FIELD(uGnssDecUbxNavPvt_t, 11, X1, valid),
+    U_GNSS_DEC_FIELD(uGnssDecUbxNavPvt_t, 12, U4, tAcc),
+    U_GNSS_DEC_FIELD(uGnssDecUbxNavPvt_t, 16, I4, nano),
+    U_GNSS_DEC_FIELD(uGnssDecUbxNavPvt_t, 20, U1, fixType),
+    U_GNSS_DEC_FIELD(uGnssDecUbxNavPvt_t, 21, X1, flags),
+    U_GNSS_DEC_FIELD(uGnssDecUbxNavPvt_t, 22, X1, flags2),
+    U_GNSS_DEC_FIELD(uGnssDecUbxNavPvt_t, 23, U1, numSV),
+    U_GNSS_DEC_FIELD(uGnssDecUbxNavPvt_t, 24, I4, lon),
+    U_GNSS_DEC_FIELD(uGnssDecUbxNavPvt_t, 28, I4, lat),
+    U_GNSS_DEC_FIELD(uGnssDecUbxNavPvt_t, 32, I4, height),
+    U_GNSS_DEC_FIELD(uGnssDecUbxNavPvt_t, 36, I4, hMSL),
+    U_GNSS_DEC_FIELD(uGnssDecUbxNavPvt_t, 40, U4, hAcc),
+    U_GNSS_DEC_FIELD(uGnssDecUbxNavPvt_t, 44, U4, vAcc),
+    U_GNSS_DEC_FIELD(uGnssDecUbxNavPvt_t, 48, I4, velN),
+    U_GNSS_DEC_FIELD(uGnssDecUbxNavPvt_t, 52, I4, velE),
+    U_GNSS_DEC_FIELD(uGnssDecUbxNavPvt_t, 56, I4, velD),
+    U_GNSS_DEC_FIELD(uGnssDecUbxNavPvt_t, 60, I4, gSpeed),
+    U_GNSS_DEC_FIELD(uGnssDecUbxNavPvt_t, 64, I4, headMot),
+    U_GNSS_DEC_FIELD(uGnssDecUbxNavPvt_t, 68, U4, sAcc),
+    U_GNSS_DEC_FIELD(uGnssDecUbxNavPvt_t, 72, U4, headAcc),
+    U_GNSS_DEC_FIELD(uGnssDecUbxNavPvt_t, 76, U2, pDOP),
+    U_GNSS_DEC_FIELD(uGnssDecUbxNavPvt_t, 78, X2, flags3),
+    // 4 reserved bytes here
+    U_GNSS_DEC_FIELD(uGnssDecUbxNavPvt_t, 84, I4, headVeh),
+    U_GNSS_DEC_FIELD(uGnssDecUbxNavPvt_t, 88, I2, magDec),
+    U_GNSS_DEC_FIELD(uGnssDecUbxNavPvt_t, 90, U2, magAcc)
+};
+
+static const uGnssDecSchema_t gSchemaUbxNavPvt = {
+    .bodySize = sizeof(uGnssDecUbxNavPvt_t),
+    .bodyMinLength = U_GNSS_DEC_UBX_NAV_PVT_BODY_MIN_LENGTH,
+    .pField = gFieldUbxNavPvt,
+    .numFields = U_GNSS_DEC_NUM_FIELDS(gFieldUbxNavPvt)
+};
+
+/** UBX-NAV-HPPOSLLH.
+ */
+static const uGnssDecField_t gFieldUbxNavHpposllh[] = {
+    U_GNSS_DEC_FIELD(uGnssDecUbxNavHpposllh_t, 0, U1, version),
+    // 2 reserved bytes here
+    U_GNSS_DEC_FIELD(uGnssDecUbxNavHpposllh_t, 3, X1, flags),
+    U_GNSS_DEC_FIELD(uGnssDecUbxNavHpposllh_t, 4, U4, iTOW),
+    U_GNSS_DEC_FIELD(uGnssDecUbxNavHpposllh_t, 8, I4, lon),
+    U_GNSS_DEC_FIELD(uGnssDecUbxNavHpposllh_t, 12, I4, lat),
+    U_GNSS_DEC_FIELD(uGnssDecUbxNavHpposllh_t, 16, I4, height),
+    U_GNSS_DEC_FIELD(uGnssDecUbxNavHpposllh_t, 20, I4, hMSL),
+    U_GNSS_DEC_FIELD(uGnssDecUbxNavHpposllh_t, 24, I1, lonHp),
+    U_GNSS_DEC_FIELD(uGnssDecUbxNavHpposllh_t, 25, I1, latHp),
+    U_GNSS_DEC_FIELD(uGnssDecUbxNavHpposllh_t, 26, I1, heightHp),
+    U_GNSS_DEC_FIELD(uGnssDecUbxNavHpposllh_t, 27, I1, hMSLHp),
+    U_GNSS_DEC_FIELD(uGnssDecUbxNavHpposllh_t, 28, U4, hAcc),
+    U_GNSS_DEC_FIELD(uGnssDecUbxNavHpposllh_t, 32, U4, vAcc)
+};
+
+static const uGnssDecSchema_t gSchemaUbxNavHpposllh = {
+    .bodySize = sizeof(uGnssDecUbxNavHpposllh_t),
+    .bodyMinLength = U_GNSS_DEC_UBX_NAV_HPPOSLLH_BODY_MIN_LENGTH,
+    .pField = gFieldUbxNavHpposllh,
+    .numFields = U_GNSS_DEC_NUM_FIELDS(gFieldUbxNavHpposllh)
+};
+
+/** UBX-NAV-DOP.
+ */
+static const uGnssDecField_t gFieldUbxNavDop[] = {
+    U_GNSS_DEC_FIELD(uGnssDecUbxNavDop_t, 0, U4, iTOW),
+    U_GNSS_DEC_FIELD(uGnssDecUbxNavDop_t, 4, U2, gDOP),
+    U_GNSS_DEC_FIELD(uGnssDecUbxNavDop_t, 6, U2, pDOP),
+    U_GNSS_DEC_FIELD(uGnssDecUbxNavDop_t, 8, U2, tDOP),
+    U_GNSS_DEC_FIELD(uGnssDecUbxNavDop_t, 10, U2, vDOP),
+    U_GNSS_DEC_FIELD(uGnssDecUbxNavDop_t, 12, U2, hDOP),
+    U_GNSS_DEC_FIELD(uGnssDecUbxNavDop_t, 14, U2, nDOP),
+    U_GNSS_DEC_FIELD(uGnssDecUbxNavDop_t, 16, U2, eDOP)
+};
+
+static const uGnssDecSchema_t gSchemaUbxNavDop = {
+    .bodySize = sizeof(uGnssDecUbxNavDop_t),
+    .bodyMinLength = U_GNSS_DEC_UBX_NAV_DOP_BODY_MIN_LENGTH,
+    .pField = gFieldUbxNavDop,
+    .numFields = U_GNSS_DEC_NUM_FIELDS(gFieldUbxNavDop)
+};
+
+/** UBX-NAV-STATUS.
+ */
+static const uGnssDecField_t gFieldUbxNavStatus[] = {
+    U_GNSS_DEC_FIELD(uGnssDecUbxNavStatus_t, 0, U4, iTOW),
+    U_GNSS_DEC_FIELD(uGnssDecUbxNavStatus_t, 4, U1, gpsFix),
+    U_GNSS_DEC_FIELD(uGnssDecUbxNavStatus_t, 5, X1, flags),
+    U_GNSS_DEC_FIELD(uGnssDecUbxNavStatus_t, 6, X1, fixStat),
+    U_GNSS_DEC_FIELD(uGnssDecUbxNavStatus_t, 7, X1, flags2),
+    U_GNSS_DEC_FIELD(uGnssDecUbxNavStatus_t, 8, U4, ttff),
+    U_GNSS_DEC_FIELD(uGnssDecUbxNavStatus_t, 12, U4, msss)
+};
+
+static const uGnssDecSchema_t gSchemaUbxNavStatus = {
+    .bodySize = sizeof(uGnssDecUbxNavStatus_t),
+    .bodyMinLength = U_GNSS_DEC_UBX_NAV_STATUS_BODY_MIN_LENGTH,
+    .pField = gFieldUbxNavStatus,
+    .numFields = U_GNSS_DEC_NUM_FIELDS(gFieldUbxNavStatus)
+};
+
+/** UBX-NAV-TIMEUTC.
+ */
+static const uGnssDecField_t gFieldUbxNavTimeutc[] = {
+    U_GNSS_DEC_FIELD(uGnssDecUbxNavTimeutc_t, 0, U4, iTOW),
+    U_GNSS_DEC_FIELD(uGnssDecUbxNavTimeutc_t, 4, U4, tAcc),
+    U_GNSS_DEC_FIELD(uGnssDecUbxNavTimeutc_t, 8, I4, nano),
+    U_GNSS_DEC_FIELD(uGnssDecUbxNavTimeutc_t, 12, U2, year),
+    U_GNSS_DEC_FIELD(uGnssDecUbxNavTimeutc_t, 14, U1, month),
+    U_GNSS_DEC_FIELD(uGnssDecUbxNavTimeutc_t, 15, U1, day),
+    U_GNSS_DEC_FIELD(uGnssDecUbxNavTimeutc_t, 16, U1, hour),
+    U_GNSS_DEC_FIELD(uGnssDecUbxNavTimeutc_t, 17, U1, min),
+    U_GNSS_DEC_FIELD(uGnssDecUbxNavTimeutc_t, 18, U1, sec),
+    U_GNSS_DEC_FIELD(uGnssDecUbxNavTimeutc_t, 19, X1, valid)
+};
+
+static const uGnssDecSchema_t gSchemaUbxNavTimeutc = {
+    .bodySize = sizeof(uGnssDecUbxNavTimeutc_t),
+    .bodyMinLength = U_GNSS_DEC_UBX_NAV_TIMEUTC_BODY_MIN_LENGTH,
+    .pField = gFieldUbxNavTimeutc,
+    .numFields = U_GNSS_DEC_NUM_FIELDS(gFieldUbxNavTimeutc)
+};
+
+/** UBX-NAV-SAT.
+ */
+static const uGnssDecField_t gFieldUbxNavSat[] = {
+    U_GNSS_DEC_FIELD(uGnssDecUbxNavSat_t, 0, U4, iTOW),
+    U_GNSS_DEC_FIELD(uGnssDecUbxNavSat_t, 4, U1, version)
+    // numSvs is written by the blocks part of the schema
+};
+
+static const uGnssDecField_t gFieldUbxNavSatSv[] = {
+    U_GNSS_DEC_FIELD(uGnssDecUbxNavSatSv_t, 0, U1, gnssId),
+    U_GNSS_DEC_FIELD(uGnssDecUbxNavSatSv_t, 1, U1, svId),
+    U_GNSS_DEC_FIELD(uGnssDecUbxNavSatSv_t, 2, U1, cno),
+    U_GNSS_DEC_FIELD(uGnssDecUbxNavSatSv_t, 3, I1, elev),
+    U_GNSS_DEC_FIELD(uGnssDecUbxNavSatSv_t, 4, I2, azim),
+    U_GNSS_DEC_FIELD(uGnssDecUbxNavSatSv_t, 6, I2, prRes),
+    U_GNSS_DEC_FIELD(uGnssDecUbxNavSatSv_t, 8, X4, flags)
+};
+
+static const uGnssDecSchemaBlocks_t gBlocksUbxNavSat = {
+    .pField = gFieldUbxNavSatSv,
+    .numFields = U_GNSS_DEC_NUM_FIELDS(gFieldUbxNavSatSv),
+    .payloadOffset = 8,
+    .length = U_GNSS_DEC_UBX_NAV_SAT_BLOCK_LENGTH,
+    .count = U_GNSS_DEC_FIELD(uGnssDecUbxNavSat_t, 5, U1, numSvs),
+    .countShift = 0,
+    .countMask = 0xff,
+    .structOffset = offsetof(uGnssDecUbxNavSat_t, sv),
+    .structSize = sizeof(uGnssDecUbxNavSatSv_t),
+    .maxNum = U_GNSS_DEC_UBX_NAV_SAT_SVS_MAX_NUM
+};
+
+static const uGnssDecSchema_t gSchemaUbxNavSat = {
+    .bodySize = sizeof(uGnssDecUbxNavSat_t),
+    .bodyMinLength = U_GNSS_DEC_UBX_NAV_SAT_BODY_MIN_LENGTH,
+    .pField = gFieldUbxNavSat,
+    .numFields = U_GNSS_DEC_NUM_FIELDS(gFieldUbxNavSat),
+    .pBlocks = &gBlocksUbxNavSat
+};
+
+/** UBX-NAV-SIG.
+ */
+static const uGnssDecField_t gFieldUbxNavSig[] = {
+    U_GNSS_DEC_FIELD(uGnssDecUbxNavSig_t, 0, U4, iTOW),
+    U_GNSS_DEC_FIELD(uGnssDecUbxNavSig_t, 4, U1, version)
+    // numSigs is written by the blocks part of the schema
+};
+
+static const uGnssDecField_t gFieldUbxNavSigSig[] = {
+    U_GNSS_DEC_FIELD(uGnssDecUbxNavSigSig_t, 0, U1, gnssId),
+    U_GNSS_DEC_FIELD(uGnssDecUbxNavSigSig_t, 1, U1, svId),
+    U_GNSS_DEC_FIELD(uGnssDecUbxNavSigSig_t, 2, U1, sigId),
+    U_GNSS_DEC_FIELD(uGnssDecUbxNavSigSig_t, 3, U1, freqId),
+    U_GNSS_DEC_FIELD(uGnssDecUbxNavSigSig_t, 4, I2, prRes),
+    U_GNSS_DEC_FIELD(uGnssDecUbxNavSigSig_t, 6, U1, cno),
+    U_GNSS_DEC_FIELD(uGnssDecUbxNavSigSig_t, 7, U1, qualityInd),
+    U_GNSS_DEC_FIELD(uGnssDecUbxNavSigSig_t, 8, U1, corrSource),
+    U_GNSS_DEC_FIELD(uGnssDecUbxNavSigSig_t, 9, U1, ionoModel),
+    U_GNSS_DEC_FIELD(uGnssDecUbxNavSigSig_t, 10, X2, sigFlags)
+    // 4 reserved bytes here
+};
+
+static const uGnssDecSchemaBlocks_t gBlocksUbxNavSig = {
+    .pField = gFieldUbxNavSigSig,
+    .numFields = U_GNSS_DEC_NUM_FIELDS(gFieldUbxNavSigSig),
+    .payloadOffset = 8,
+    .length = U_GNSS_DEC_UBX_NAV_SIG_BLOCK_LENGTH,
+    .count = U_GNSS_DEC_FIELD(uGnssDecUbxNavSig_t, 5, U1, numSigs),
+    .countShift = 0,
+    .countMask = 0xff,
+    .structOffset = offsetof(uGnssDecUbxNavSig_t, sig),
+    .structSize = sizeof(uGnssDecUbxNavSigSig_t),
+    .maxNum = U_GNSS_DEC_UBX_NAV_SIG_SIGS_MAX_NUM
+};
+
+static const uGnssDecSchema_t gSchemaUbxNavSig = {
+    .bodySize = sizeof(uGnssDecUbxNavSig_t),
+    .bodyMinLength = U_GNSS_DEC_UBX_NAV_SIG_BODY_MIN_LENGTH,
+    .pField = gFieldUbxNavSig,
+    .numFields = U_GNSS_DEC_NUM_FIELDS(gFieldUbxNavSig),
+    .pBlocks = &gBlocksUbxNavSig
+};
+
+/** UBX-ESF-MEAS.
+ */
+static const uGnssDecField_t gFieldUbxEsfMeas[] = {
+    U_GNSS_DEC_FIELD(uGnssDecUbxEsfMeas_t, 0, U4, timeTag),
+    U_GNSS_DEC_FIELD(uGnssDecUbxEsfMeas_t, 4, X2, flags),
+    U_GNSS_DEC_FIELD(uGnssDecUbxEsfMeas_t, 6, U2, id)
+};
+
+static const uGnssDecField_t gFieldUbxEsfMeasData[] = {
+    U_GNSS_DEC_FIELD(uGnssDecUbxEsfMeasData_t, 0, X4, data)
 };
 
-// MORE STATIC VARIABLES after the message decoders...
+static const uGnssDecField_t gFieldUbxEsfMeasTrailer[] = {
+    U_GNSS_DEC_FIELD(uGnssDecUbxEsfMeas_t, 0, U4, calibTtag)
+};
+
+static const uGnssDecSchemaBlocks_t gBlocksUbxEsfMeas = {
+    .pField = gFieldUbxEsfMeasData,
+    .numFields = U_GNSS_DEC_NUM_FIELDS(gFieldUbxEsfMeasData),
+    .payloadOffset = 8,
+    .length = U_GNSS_DEC_UBX_ESF_MEAS_BLOCK_LENGTH,
+    // The number of measurements is in bits 11 to 15 of flags
+    .count = U_GNSS_DEC_FIELD(uGnssDecUbxEsfMeas_t, 4, X2, numMeas),
+    .countShift = U_GNSS_DEC_UBX_ESF_MEAS_FLAGS_NUM_MEAS,
+    .countMask = 0x1f,
+    .structOffset = offsetof(uGnssDecUbxEsfMeas_t, data),
+    .structSize = sizeof(uGnssDecUbxEsfMeasData_t),
+    .maxNum = U_GNSS_DEC_UBX_ESF_MEAS_MEAS_MAX_NUM,
+    .pTrailerField = gFieldUbxEsfMeasTrailer,
+    .numTrailerFields = U_GNSS_DEC_NUM_FIELDS(gFieldUbxEsfMeasTrailer)
+};
+
+static const uGnssDecSchema_t gSchemaUbxEsfMeas = {
+    .bodySize = sizeof(uGnssDecUbxEsfMeas_t),
+    .bodyMinLength = U_GNSS_DEC_UBX_ESF_MEAS_BODY_MIN_LENGTH,
+    .pField = gFieldUbxEsfMeas,
+    .numFields = U_GNSS_DEC_NUM_FIELDS(gFieldUbxEsfMeas),
+    .pBlocks = &gBlocksUbxEsfMeas
+};
+
+/** UBX-RXM-RAWX.
+ */
+static const uGnssDecField_t gFieldUbxRxmRawx[] = {
+    U_GNSS_DEC_FIELD(uGnssDecUbxRxmRawx_t, 0, R8, rcvTow),
+    U_GNSS_DEC_FIELD(uGnssDecUbxRxmRawx_t, 8, U2, week),
+    U_GNSS_DEC_FIELD(uGnssDecUbxRxmRawx_t, 10, I1, leapS),
+    // numMeas is written by the blocks part of the schema
+    U_GNSS_DEC_FIELD(uGnssDecUbxRxmRawx_t, 12, X1, recStat),
+    U_GNSS_DEC_FIELD(uGnssDecUbxRxmRawx_t, 13, U1, version)
+    // 2 reserved bytes here
+};
+
+static const uGnssDecField_t gFieldUbxRxmRawxMeas[] = {
+    U_GNSS_DEC_FIELD(uGnssDecUbxRxmRawxMeas_t, 0, R8, prMes),
+    U_GNSS_DEC_FIELD(uGnssDecUbxRxmRawxMeas_t, 8, R8, cpMes),
+    U_GNSS_DEC_FIELD(uGnssDecUbxRxmRawxMeas_t, 16, R4, doMes),
+    U_GNSS_DEC_FIELD(uGnssDecUbxRxmRawxMeas_t, 20, U1, gnssId),
+    U_GNSS_DEC_FIELD(uGnssDecUbxRxmRawxMeas_t, 21, U1, svId),
+    U_GNSS_DEC_FIELD(uGnssDecUbxRxmRawxMeas_t, 22, U1, sigId),
+    U_GNSS_DEC_FIELD(uGnssDecUbxRxmRawxMeas_t, 23, U1, freqId),
+    U_GNSS_DEC_FIELD(uGnssDecUbxRxmRawxMeas_t, 24, U2, locktime),
+    U_GNSS_DEC_FIELD(uGnssDecUbxRxmRawxMeas_t, 26, U1, cno),
+    U_GNSS_DEC_FIELD(uGnssDecUbxRxmRawxMeas_t, 27, X1, prStdev),
+    U_GNSS_DEC_FIELD(uGnssDecUbxRxmRawxMeas_t, 28, X1, cpStdev),
+    U_GNSS_DEC_FIELD(uGnssDecUbxRxmRawxMeas_t, 29, X1, doStdev),
+    U_GNSS_DEC_FIELD(uGnssDecUbxRxmRawxMeas_t, 30, X1, trkStat)
+    // 1 reserved byte here
+};
+
+static const uGnssDecSchemaBlocks_t gBlocksUbxRxmRawx = {
+    .pField = gFieldUbxRxmRawxMeas,
+    .numFields = U_GNSS_DEC_NUM_FIELDS(gFieldUbxRxmRawxMeas),
+    .payloadOffset = 16,
+    .length = U_GNSS_DEC_UBX_RXM_RAWX_BLOCK_LENGTH,
+    .count = U_GNSS_DEC_FIELD(uGnssDecUbxRxmRawx_t, 11, U1, numMeas),
+    .countShift = 0,
+    .countMask = 0xff,
+    .structOffset = offsetof(uGnssDecUbxRxmRawx_t, meas),
+    .structSize = sizeof(uGnssDecUbxRxmRawxMeas_t),
+    .maxNum = U_GNSS_DEC_UBX_RXM_RAWX_MEAS_MAX_NUM
+};
+
+static const uGnssDecSchema_t gSchemaUbxRxmRawx = {
+    .bodySize = sizeof(uGnssDecUbxRxmRawx_t),
+    .bodyMinLength = U_GNSS_DEC_UBX_RXM_RAWX_BODY_MIN_LENGTH,
+    .pField = gFieldUbxRxmRawx,
+    .numFields = U_GNSS_DEC_NUM_FIELDS(gFieldUbxRxmRawx),
+    .pBlocks = &gBlocksUbxRxmRawx
+};
+
+/** UBX-MON-RF.
+ */
+static const uGnssDecField_t gFieldUbxMonRf[] = {
+    U_GNSS_DEC_FIELD(uGnssDecUbxMonRf_t, 0, U1, version)
+    // nBlocks is written by the blocks part of the schema
+};
+
+static const uGnssDecField_t gFieldUbxMonRfBlock[] = {
+    U_GNSS_DEC_FIELD(uGnssDecUbxMonRfBlock_t, 0, U1, blockId),
+    U_GNSS_DEC_FIELD(uGnssDecUbxMonRfBlock_t, 1, X1, flags),
+    U_GNSS_DEC_FIELD(uGnssDecUbxMonRfBlock_t, 2, U1, antStatus),
+    U_GNSS_DEC_FIELD(uGnssDecUbxMonRfBlock_t, 3, U1, antPower),
+    U_GNSS_DEC_FIELD(uGnssDecUbxMonRfBlock_t, 4, X4, postStatus),
+    // 4 reserved bytes here
+    U_GNSS_DEC_FIELD(uGnssDecUbxMonRfBlock_t, 12, U2, noisePerMS),
+    U_GNSS_DEC_FIELD(uGnssDecUbxMonRfBlock_t, 14, U2, agcCnt),
+    U_GNSS_DEC_FIELD(uGnssDecUbxMonRfBlock_t, 16, U1, jamInd),
+    U_GNSS_DEC_FIELD(uGnssDecUbxMonRfBlock_t, 17, I1, ofsI),
+    U_GNSS_DEC_FIELD(uGnssDecUbxMonRfBlock_t, 18, U1, magI),
+    U_GNSS_DEC_FIELD(uGnssDecUbxMonRfBlock_t, 19, I1, ofsQ),
+    U_GNSS_DEC_FIELD(uGnssDecUbxMonRfBlock_t, 20, U1, magQ)
+    // 3 reserved bytes here
+};
+
+static const uGnssDecSchemaBlocks_t gBlocksUbxMonRf = {
+    .pField = gFieldUbxMonRfBlock,
+    .numFields = U_GNSS_DEC_NUM_FIELDS(gFieldUbxMonRfBlock),
+    .payloadOffset = 4,
+    .length = U_GNSS_DEC_UBX_MON_RF_BLOCK_LENGTH,
+    .count = U_GNSS_DEC_FIELD(uGnssDecUbxMonRf_t, 1, U1, nBlocks),
+    .countShift = 0,
+    .countMask = 0xff,
+    .structOffset = offsetof(uGnssDecUbxMonRf_t, block),
+    .structSize = sizeof(uGnssDecUbxMonRfBlock_t),
+    .maxNum = U_GNSS_DEC_UBX_MON_RF_BLOCKS_MAX_NUM
+};
+
+static const uGnssDecSchema_t gSchemaUbxMonRf = {
+    .bodySize = sizeof(uGnssDecUbxMonRf_t),
+    .bodyMinLength = U_GNSS_DEC_UBX_MON_RF_BODY_MIN_LENGTH,
+    .pField = gFieldUbxMonRf,
+    .numFields = U_GNSS_DEC_NUM_FIELDS(gFieldUbxMonRf),
+    .pBlocks = &gBlocksUbxMonRf
+};
 
 /* ----------------------------------------------------------------
- * STATIC FUNCTIONS: MESSAGE DECODERS
+ * STATIC VARIABLES: MESSAGE SCHEMA LIST
  * -------------------------------------------------------------- */
 
-// Decode a UBX-NAV-PVT message.
-static int32_t ubxNavPvtAlloc(const char *pBuffer, size_t size,
-                              uGnssDecUnion_t **ppBody)
+/** The list of message schemas; in the same order as gIdList
+ * since both are generated from U_GNSS_DEC_UBX_MESSAGE_LIST.
+ */
+static const uGnssDecSchema_t *const gpSchemaList[] = {
+    U_GNSS_DEC_UBX_MESSAGE_LIST(U_GNSS_DEC_SCHEMA_LIST_ENTRY)
+};
+
+/* ----------------------------------------------------------------
+ * STATIC FUNCTIONS: THE DECODE ENGINE
+ * -------------------------------------------------------------- */
+
+// Decode the given fields from pPayload, which is of the given
+// length, into pStruct; fields that are not entirely within
+// length are left alone.
+static void decodeFields(const uGnssDecField_t *pField, size_t numFields,
+                         const char *pPayload, size_t length, char *pStruct)
 {
-    int32_t errorCode = (int32_t) U_ERROR_COMMON_TRUNCATED;
-    uGnssDecUbxNavPvt_t *pBody;
+    const char *pSrc;
+    char *pDst;
+    int64_t integer = 0;
+    double real = 0;
+    uint32_t uint32;
+    uint64_t uint64;
+    float realFloat;
+    bool isReal;
 
-    // No need to check pBuffer or ppBody for NULLity,
-    // we will never give this function NULL for those.
-    if (size >= U_UBX_PROTOCOL_HEADER_LENGTH_BYTES + U_GNSS_DEC_UBX_NAV_PVT_BODY_MIN_LENGTH) {
-        // Move past the header so that we can use payload offsets
-        // throughout, matching the offsets in the interface manual
-        pBuffer += U_UBX_PROTOCOL_HEADER_LENGTH_BYTES;
-        errorCode = (int32_t) U_ERROR_COMMON_NO_MEMORY;
-        pBody = (uGnssDecUbxNavPvt_t *) pUPortMalloc(sizeof(uGnssDecUbxNavPvt_t));
-        if (pBody != NULL) {
-            memset(pBody, 0, sizeof(*pBody));
-            // All good now, unless we hit a field we can't decode,
-            // in which case we _could_ set U_ERROR_COMMON_BAD_DATA,
-            // but, since this message will have been checked for
-            // integrity before it gets here, it is better to trust
-            // that the module emitted stuff correctly: it knows
-            // more about this than we do
-            errorCode = (int32_t) U_ERROR_COMMON_SUCCESS;
-            pBody->iTOW = (int32_t) uUbxProtocolUint32Decode(pBuffer + 0);
-            pBody->year = uUbxProtocolUint16Decode(pBuffer + 4);
-            pBody->month = (uint8_t) *(pBuffer + 6); // *NOPAD* stop AStyle making * look like a multiply
-            pBody->day = (uint8_t) *(pBuffer + 7); // *NOPAD*
-            pBody->hour = (uint8_t) *(pBuffer + 8); // *NOPAD*
-            pBody->min = (uint8_t) *(pBuffer + 9); // *NOPAD*
-            pBody->sec = (uint8_t) *(pBuffer + 10); // *NOPAD*
-            pBody->valid = (uint8_t) *(pBuffer + 11); // *NOPAD*
-            pBody->tAcc = uUbxProtocolUint32Decode(pBuffer + 12);
-            pBody->nano = (int32_t) uUbxProtocolUint32Decode(pBuffer + 16);
-            pBody->fixType = (uGnssDecUbxNavPvtFixType_t) *(pBuffer + 20); // *NOPAD*
-            pBody->flags = (uint8_t) *(pBuffer + 21); // *NOPAD*
-            pBody->flags2 = (uint8_t) *(pBuffer + 22); // *NOPAD*
-            pBody->numSV = (uint8_t) *(pBuffer + 23); // *NOPAD*
-            pBody->lon = (int32_t) uUbxProtocolUint32Decode(pBuffer + 24);
-            pBody->lat = (int32_t) uUbxProtocolUint32Decode(pBuffer + 28);
-            pBody->height = (int32_t) uUbxProtocolUint32Decode(pBuffer + 32);
-            pBody->hMSL = (int32_t) uUbxProtocolUint32Decode(pBuffer + 36);
-            pBody->hAcc = uUbxProtocolUint32Decode(pBuffer + 40);
-            pBody->vAcc = uUbxProtocolUint32Decode(pBuffer + 44);
-            pBody->velN = (int32_t) uUbxProtocolUint32Decode(pBuffer + 48);
-            pBody->velE = (int32_t) uUbxProtocolUint32Decode(pBuffer + 52);
-            pBody->velD = (int32_t) uUbxProtocolUint32Decode(pBuffer + 56);
-            pBody->gSpeed = (int32_t) uUbxProtocolUint32Decode(pBuffer + 60);
-            pBody->headMot = (int32_t) uUbxProtocolUint32Decode(pBuffer + 64);
-            pBody->sAcc = uUbxProtocolUint32Decode(pBuffer + 68);
-            pBody->headAcc = uUbxProtocolUint32Decode(pBuffer + 72);
-            pBody->pDOP = uUbxProtocolUint16Decode(pBuffer + 76);
-            pBody->flags3 = uUbxProtocolUint16Decode(pBuffer + 78);
-            // 4 reserved bytes here
-            pBody->headVeh = (int32_t) uUbxProtocolUint32Decode(pBuffer + 84);
-            pBody->magDec = (int16_t) uUbxProtocolUint16Decode(pBuffer + 88);
-            pBody->magAcc = (int16_t) uUbxProtocolUint16Decode(pBuffer + 90);
-
-            // Populate the pointer that was passed in
-            *ppBody = (uGnssDecUnion_t *) pBody;
+    for (size_t x = 0; x < numFields; x++, pField++) {
+        if ((pField->type < U_GNSS_DEC_TYPE_MAX_NUM) &&
+            (pField->payloadOffset + gTypeSize[pField->type] <= length)) {
+            pSrc = pPayload + pField->payloadOffset;
+            pDst = pStruct + pField->structOffset;
+            isReal = false;
+            switch (pField->type) {
+                case U_GNSS_DEC_TYPE_U1:
+                    integer = (uint8_t) *pSrc; // *NOPAD* stop AStyle making * look like a multiply
+                    break;
+                case U_GNSS_DEC_TYPE_I1:
+                    integer = (int8_t) *pSrc; // *NOPAD*
+                    break;
+                case U_GNSS_DEC_TYPE_U2:
+                    integer = uUbxProtocolUint16Decode(pSrc);
+                    break;
+                case U_GNSS_DEC_TYPE_I2:
+                    integer = (int16_t) uUbxProtocolUint16Decode(pSrc);
+                    break;
+                case U_GNSS_DEC_TYPE_U4:
+                    integer = uUbxProtocolUint32Decode(pSrc);
+                    break;
+                case U_GNSS_DEC_TYPE_I4:
+                    integer = (int32_t) uUbxProtocolUint32Decode(pSrc);
+                    break;
+                case U_GNSS_DEC_TYPE_R4:
+                    uint32 = uUbxProtocolUint32Decode(pSrc);
+                    memcpy(&realFloat, &uint32, sizeof(realFloat));
+                    real = realFloat;
+                    isReal = true;
+                    break;
+                case U_GNSS_DEC_TYPE_R8:
+                    uint64 = uUbxProtocolUint64Decode(pSrc);
+                    memcpy(&real, &uint64, sizeof(real));
+                    isReal = true;
+                    break;
+                default:
+                    break;
+            }
+            if (isReal) {
+                if (pField->size == sizeof(float)) {
+                    realFloat = (float) real;
+                    memcpy(pDst, &realFloat, sizeof(realFloat));
+                } else if (pField->size == sizeof(double)) {
+                    memcpy(pDst, &real, sizeof(real));
+                }
+            } else {
+                // Members are naturally aligned, so they can be
+                // written directly
+                switch (pField->size) {
+                    case 1:
+                        *((uint8_t *) pDst) = (uint8_t) integer;
+                        break;
+                    case 2:
+                        *((uint16_t *) pDst) = (uint16_t) integer;
+                        break;
+                    case 4:
+                        *((uint32_t *) pDst) = (uint32_t) integer;
+                        break;
+                    case 8:
+                        *((uint64_t *) pDst) = (uint64_t) integer;
+                        break;
+                    default:
+                        break;
+                }
+            }
         }
     }
-
-    return errorCode;
 }
 
-// Decode a UBX-NAV-HPPOSLLH message.
-static int32_t ubxNavHpposllhAlloc(const char *pBuffer, size_t size,
-                                   uGnssDecUnion_t **ppBody)
+// Decode the UBX message in pBuffer, which has a header and is of
+// size bytes (possibly without the checksum), according to the
+// schema, writing the result to pBody, which must be at least
+// pSchema->bodySize bytes in size.
+static int32_t decodeUbx(const uGnssDecSchema_t *pSchema,
+                         const char *pBuffer, size_t size, void *pBody)
 {
     int32_t errorCode = (int32_t) U_ERROR_COMMON_TRUNCATED;
-    uGnssDecUbxNavHpposllh_t *pBody;
+    const uGnssDecSchemaBlocks_t *pBlocks = pSchema->pBlocks;
+    size_t length = 0;
+    size_t count;
+    size_t offset;
+    size_t x;
+    uint16_t countRaw = 0;
+    uGnssDecField_t countField;
 
-    // No need to check pBuffer or ppBody for NULLity,
+    // No need to check pBuffer or pBody for NULLity,
     // we will never give this function NULL for those.
-    if (size >= U_UBX_PROTOCOL_HEADER_LENGTH_BYTES + U_GNSS_DEC_UBX_NAV_HPPOSLLH_BODY_MIN_LENGTH) {
+    if (size >= U_UBX_PROTOCOL_HEADER_LENGTH_BYTES) {
+        // Use the length from the header, limited to what we have
+        length = uUbxProtocolUint16Decode(pBuffer + 4);
+        if (length > size - U_UBX_PROTOCOL_HEADER_LENGTH_BYTES) {
+            length = size - U_UBX_PROTOCOL_HEADER_LENGTH_BYTES;
+        }
+    }
+    if ((size >= U_UBX_PROTOCOL_HEADER_LENGTH_BYTES) &&
+        (length >= pSchema->bodyMinLength)) {
         // Move past the header so that we can use payload offsets
         // throughout, matching the offsets in the interface manual
         pBuffer += U_UBX_PROTOCOL_HEADER_LENGTH_BYTES;
-        errorCode = (int32_t) U_ERROR_COMMON_NO_MEMORY;
-        pBody = (uGnssDecUbxNavHpposllh_t *) pUPortMalloc(sizeof(uGnssDecUbxNavHpposllh_t));
-        if (pBody != NULL) {
-            memset(pBody, 0, sizeof(*pBody));
-            // All good now, unless we hit a field we can't decode,
-            // in which case we _could_ set U_ERROR_COMMON_BAD_DATA,
-            // but, since this message will have been checked for
-            // integrity before it gets here, it is better to trust
-            // that the module emitted stuff correctly: it knows
-            // more about this than we do
-            errorCode = (int32_t) U_ERROR_COMMON_SUCCESS;
-            pBody->version = (uint8_t) *(pBuffer + 0); // *NOPAD* stop AStyle making * look like a multiply
-            // 2 reserved bytes here
-            pBody->flags = (uint8_t) *(pBuffer + 3); // *NOPAD*
-            pBody->iTOW = (int32_t) uUbxProtocolUint32Decode(pBuffer + 4);
-            pBody->lon = (int32_t) uUbxProtocolUint32Decode(pBuffer + 8);
-            pBody->lat = (int32_t) uUbxProtocolUint32Decode(pBuffer + 12);
-            pBody->height = (int32_t) uUbxProtocolUint32Decode(pBuffer + 16);
-            pBody->hMSL = (int32_t) uUbxProtocolUint32Decode(pBuffer + 20);
-            pBody->lonHp = (int8_t) *(pBuffer + 24); // *NOPAD*
-            pBody->latHp = (int8_t) *(pBuffer + 25); // *NOPAD*
-            pBody->heightHp = (int8_t) *(pBuffer + 26); // *NOPAD*
-            pBody->hMSLHp = (int8_t) *(pBuffer + 27); // *NOPAD*
-            pBody->hAcc = uUbxProtocolUint32Decode(pBuffer + 28);
-            pBody->vAcc = uUbxProtocolUint32Decode(pBuffer + 32);
-
-            // Populate the pointer that was passed in
-            *ppBody = (uGnssDecUnion_t *) pBody;
+        memset(pBody, 0, pSchema->bodySize);
+        // All good now, unless we hit a field we can't decode,
+        // in which case we _could_ set U_ERROR_COMMON_BAD_DATA,
+        // but, since this message will have been checked for
+        // integrity before it gets here, it is better to trust
+        // that the module emitted stuff correctly: it knows
+        // more about this than we do
+        errorCode = (int32_t) U_ERROR_COMMON_SUCCESS;
+        decodeFields(pSchema->pField, pSchema->numFields,
+                     pBuffer, length, (char *) pBody);
+        if (pBlocks != NULL) {
+            // Get the number of blocks the message says it has,
+            // decoding the count into a local variable
+            countField = pBlocks->count;
+            countField.structOffset = 0;
+            countField.size = sizeof(uint16_t);
+            decodeFields(&countField, 1, pBuffer, length, (char *) &countRaw);
+            count = (countRaw >> pBlocks->countShift) & pBlocks->countMask;
+            offset = pBlocks->payloadOffset;
+            for (x = 0; (x < count) && (x < pBlocks->maxNum); x++) {
+                if (offset + pBlocks->length > length) {
+                    // The message is shorter than it says it is
+                    errorCode = (int32_t) U_ERROR_COMMON_BAD_DATA;
+                    break;
+                }
+                decodeFields(pBlocks->pField, pBlocks->numFields,
+                             pBuffer + offset, pBlocks->length,
+                             (char *) pBody + pBlocks->structOffset + (x * pBlocks->structSize));
+                offset += pBlocks->length;
+            }
+            // Write the number of blocks actually decoded
+            *((uint8_t *) pBody + pBlocks->count.structOffset) = (uint8_t) x;
+            // Anything that follows the blocks
+            offset = pBlocks->payloadOffset + (count * pBlocks->length);
+            if ((pBlocks->pTrailerField != NULL) && (offset < length)) {
+                decodeFields(pBlocks->pTrailerField, pBlocks->numTrailerFields,
+                             pBuffer + offset, length - offset, (char *) pBody);
+            }
         }
     }
 
@@ -282,17 +802,134 @@ static int32_t ubxNavHpposllhAlloc(const char *pBuffer, size_t size,
 }
 
 /* ----------------------------------------------------------------
- * STATIC VARIABLES: MESSAGE DECODER LIST
+ * STATIC FUNCTIONS: MISC
  * -------------------------------------------------------------- */
 
-/** A list of message decode functions; order is important,
- * MUST be in the same order as gIdList and both lists
- * must contain the same number of elements.
- */
-static uGnssDecKnownFunction_t *gpFunctionList[] = {
-    ubxNavPvtAlloc,
-    ubxNavHpposllhAlloc
-};
+// Zero pDec and determine the protocol type and message ID of the
+// message in pBuffer, checking that the header is sound; the
+// error code is returned and also written to pDec.
+static int32_t decodeId(const char *pBuffer, size_t size, uGnssDec_t *pDec)
+{
+    uint8_t *pBufferUint8 = (uint8_t *) pBuffer; // To avoid problems with signed char compares
+    size_t x;
+    size_t y;
+
+    memset(pDec, 0, sizeof(*pDec));
+    pDec->errorCode = (int32_t) U_ERROR_COMMON_EMPTY;
+    pDec->id.type = U_GNSS_PROTOCOL_UNKNOWN;
+    if ((pBufferUint8 != NULL) && (size > 0)) {
+        // Determine the protocol type/message ID and make
+        // sure the header is sound
+        pDec->errorCode = (int32_t) U_ERROR_COMMON_UNKNOWN;
+        if ((*pBufferUint8 == 0xB5) && (size >= 1) && (*(pBufferUint8 + 1) == 0x62)) {
+            // Likely a UBX message
+            pBufferUint8 += 2;
+            pDec->id.type = U_GNSS_PROTOCOL_UBX;
+            pDec->errorCode = (int32_t) U_ERROR_COMMON_TRUNCATED;
+            if (size >= U_UBX_PROTOCOL_HEADER_LENGTH_BYTES) {
+                // Grab the message class and message ID, check the length,
+                // allowing the checksum bytes to be omitted
+                pDec->id.id.ubx = U_GNSS_UBX_MESSAGE(*pBufferUint8, *(pBufferUint8 + 1));
+                pBufferUint8 += 2;
+                y = *pBufferUint8 + ((uint16_t) *(pBufferUint8 + 1) << 8); // *NOPAD*
+                if (size >= y + U_UBX_PROTOCOL_HEADER_LENGTH_BYTES) {
+                    pDec->errorCode = (int32_t) U_ERROR_COMMON_SUCCESS;
+                }
+            }
+        } else if (*pBufferUint8 == '$') {
+            // Likely an NMEA message
+            pBufferUint8++;
+            y = size - 1;
+            pDec->id.type = U_GNSS_PROTOCOL_NMEA;
+            pDec->errorCode = (int32_t) U_ERROR_COMMON_TRUNCATED;
+            for (x = 0; (((*pBufferUint8 >= 'A') && (*pBufferUint8 <= 'Z')) ||
+                         ((*pBufferUint8 >= '0') && (*pBufferUint8 <= '9'))) &&
+                 (x < y) && (x < sizeof(pDec->nmea) - 1); x++) {
+                // Looking for up to U_GNSS_NMEA_MESSAGE_MATCH_LENGTH_CHARACTERS
+                // characters in the range 0-9, A-Z, followed by a comma
+                pDec->nmea[x] = *pBufferUint8;
+                pBufferUint8++;
+            }
+            if ((x < y) && (*pBufferUint8 == ',')) {
+                pDec->id.id.pNmea = pDec->nmea;
+                pDec->errorCode = (int32_t) U_ERROR_COMMON_SUCCESS;
+            }
+            // No need to add a terminator since we zeroed the structure to begin with
+        } else if (*pBufferUint8 == 0xD3) {
+            // Likely an RTCM message
+            pBufferUint8++;
+            pDec->id.type = U_GNSS_PROTOCOL_RTCM;
+            pDec->errorCode = (int32_t) U_ERROR_COMMON_TRUNCATED;
+            // Length is only in the first three bits of the first length byte,
+            // the rest must be zero
+            if ((size >= 1 /* D3 */ + 2 /* length */) &&
+                ((*pBufferUint8 & 0xFC) == 0)) {
+                y = ((uint16_t) (*pBufferUint8 & 0x03) << 8) + *(pBufferUint8 + 1);
+                pBufferUint8 += 2;
+                if (size >= 1 /* D3 */ + 2 /* length */ + 2 /* ID */) {
+                    // Grab the ID from the next two bytes
+                    pDec->id.id.rtcm = (*(pBufferUint8 + 1) >> 4) + (uint16_t) (((uint16_t) * pBufferUint8) <<
+                                                                                4); // *NOPAD*
+                    if (size >= 1 /* D3 */ + 2 /* length */ + y /* length includes the message ID */ ) {
+                        // Check the length, allowing the CRC bytes to be omitted
+                        pDec->errorCode = (int32_t) U_ERROR_COMMON_SUCCESS;
+                    }
+                }
+            }
+        }
+    }
+
+    return pDec->errorCode;
+}
+
+// Find the schema for the given message ID, NULL if there is none.
+static const uGnssDecSchema_t *pSchemaFind(const uGnssMessageId_t *pId)
+{
+    const uGnssDecSchema_t *pSchema = NULL;
+
+    for (size_t x = 0; (pSchema == NULL) && (x < sizeof(gIdList) / sizeof(gIdList[0])); x++) {
+        if (uGnssMsgIdIsWanted((uGnssMessageId_t *) pId, (uGnssMessageId_t *) & (gIdList[x]))) {
+            pSchema = gpSchemaList[x];
+        }
+    }
+
+    return pSchema;
+}
+
+// Take a free slot from the pool, if there is a pool, returning
+// NULL if there is no pool or all of the slots are in use.
+static uGnssDecSlot_t *pPoolTake()
+{
+    uGnssDecSlot_t *pSlot = NULL;
+
+    if (gPoolMutex != NULL) {
+        U_PORT_MUTEX_LOCK(gPoolMutex);
+        for (size_t x = 0; (pSlot == NULL) && (x < gPoolNumSlots); x++) {
+            if (!gpPoolSlot[x].inUse) {
+                pSlot = &(gpPoolSlot[x]);
+                pSlot->inUse = true;
+            }
+        }
+        U_PORT_MUTEX_UNLOCK(gPoolMutex);
+    }
+
+    return pSlot;
+}
+
+// Return the pool slot that pDec is in, NULL if it is not from
+// the pool; gPoolMutex must be locked before this is called.
+static uGnssDecSlot_t *pPoolSlotGet(const uGnssDec_t *pDec)
+{
+    uGnssDecSlot_t *pSlot = NULL;
+
+    for (size_t x = 0; (pSlot == NULL) && (x < gPoolNumSlots); x++) {
+        if (pDec == &(gpPoolSlot[x].dec)) {
+            pSlot = &(gpPoolSlot[x]);
+        }
+    }
+
+    return pSlot;
+}
 
 /* ----------------------------------------------------------------
  * PUBLIC FUNCTIONS
@@ -302,107 +939,106 @@ static uGnssDecKnownFunction_t *gpFunctionList[] = {
 uGnssDec_t *pUGnssDecAlloc(const char *pBuffer, size_t size)
 {
     uGnssDec_t *pDec = NULL;
-    uint8_t *pBufferUint8 = (uint8_t *) pBuffer; // To avoid problems with signed char compares
-    uGnssDecKnownFunction_t *pFunction = NULL;
-    size_t x;
-    size_t y;
+    uGnssDecSlot_t *pSlot;
+    uGnssDecUnion_t *pBody;
+    const uGnssDecSchema_t *pSchema;
 
-    pDec = (uGnssDec_t *) pUPortMalloc(sizeof(uGnssDec_t));
+    // Use a slot from the pool if we can, else the heap
+    pSlot = pPoolTake();
+    if (pSlot != NULL) {
+        pDec = &(pSlot->dec);
+    } else {
+        pDec = (uGnssDec_t *) pUPortMalloc(sizeof(uGnssDec_t));
+    }
     if (pDec != NULL) {
-        memset(pDec, 0, sizeof(*pDec));
-        pDec->errorCode = (int32_t) U_ERROR_COMMON_EMPTY;
-        pDec->id.type = U_GNSS_PROTOCOL_UNKNOWN;
-        if ((pBufferUint8 != NULL) && (size > 0)) {
-            // Determine the protocol type/message ID and make
-            // sure the header is sound
-            pDec->errorCode = (int32_t) U_ERROR_COMMON_UNKNOWN;
-            if ((*pBufferUint8 == 0xB5) && (size >= 1) && (*(pBufferUint8 + 1) == 0x62)) {
-                // Likely a UBX message
-                pBufferUint8 += 2;
-                pDec->id.type = U_GNSS_PROTOCOL_UBX;
-                pDec->errorCode = (int32_t) U_ERROR_COMMON_TRUNCATED;
-                if (size >= U_UBX_PROTOCOL_HEADER_LENGTH_BYTES) {
-                    // Grab the message class and message ID, check the length,
-                    // allowing the checksum bytes to be omitted
-                    pDec->id.id.ubx = U_GNSS_UBX_MESSAGE(*pBufferUint8, *(pBufferUint8 + 1));
-                    pBufferUint8 += 2;
-                    y = *pBufferUint8 + ((uint16_t) *(pBufferUint8 + 1) << 8); // *NOPAD*
-                    if (size >= y + U_UBX_PROTOCOL_HEADER_LENGTH_BYTES) {
-                        pDec->errorCode = (int32_t) U_ERROR_COMMON_SUCCESS;
-                    }
-                }
-            } else if (*pBufferUint8 == '$') {
-                // Likely an NMEA message
-                pBufferUint8++;
-                y = size - 1;
-                pDec->id.type = U_GNSS_PROTOCOL_NMEA;
-                pDec->errorCode = (int32_t) U_ERROR_COMMON_TRUNCATED;
-                for (x = 0; (((*pBufferUint8 >= 'A') && (*pBufferUint8 <= 'Z')) ||
-                             ((*pBufferUint8 >= '0') && (*pBufferUint8 <= '9'))) &&
-                     (x < y) && (x < sizeof(pDec->nmea) - 1); x++) {
-                    // Looking for up to U_GNSS_NMEA_MESSAGE_MATCH_LENGTH_CHARACTERS
-                    // characters in the range 0-9, A-Z, followed by a comma
-                    pDec->nmea[x] = *pBufferUint8;
-                    pBufferUint8++;
+        if (decodeId(pBuffer, size, pDec) == (int32_t) U_ERROR_COMMON_SUCCESS) {
+            // Got a known protocol, an ID and a valid length, see if we have
+            // a decoder for this message ID
+            pDec->errorCode = (int32_t) U_ERROR_COMMON_NOT_SUPPORTED;
+            pSchema = pSchemaFind(&(pDec->id));
+            if (pSchema != NULL) {
+                // Found a matching schema, decode with it
+                pDec->errorCode = (int32_t) U_ERROR_COMMON_NO_MEMORY;
+                if (pSlot != NULL) {
+                    pBody = &(pSlot->body);
+                } else {
+                    pBody = (uGnssDecUnion_t *) pUPortMalloc(pSchema->bodySize);
                 }
-                if ((x < y) && (*pBufferUint8 == ',')) {
-                    pDec->id.id.pNmea = pDec->nmea;
-                    pDec->errorCode = (int32_t) U_ERROR_COMMON_SUCCESS;
-                }
-                // No need to add a terminator since we zeroed the structure to begin with
-            } else if (*pBufferUint8 == 0xD3) {
-                // Likely an RTCM message
-                pBufferUint8++;
-                pDec->id.type = U_GNSS_PROTOCOL_RTCM;
-                pDec->errorCode = (int32_t) U_ERROR_COMMON_TRUNCATED;
-                // Length is only in the first three bits of the first length byte,
-                // the rest must be zero
-                if ((size >= 1 /* D3 */ + 2 /* length */) &&
-                    ((*pBufferUint8 & 0xFC) == 0)) {
-                    y = ((uint16_t) (*pBufferUint8 & 0x03) << 8) + *(pBufferUint8 + 1);
-                    pBufferUint8 += 2;
-                    if (size >= 1 /* D3 */ + 2 /* length */ + 2 /* ID */) {
-                        // Grab the ID from the next two bytes
-                        pDec->id.id.rtcm = (*(pBufferUint8 + 1) >> 4) + (uint16_t) (((uint16_t) * pBufferUint8) <<
-                                                                                    4); // *NOPAD*
-                        if (size >= 1 /* D3 */ + 2 /* length */ + y /* length includes the message ID */ ) {
-                            // Check the length, allowing the CRC bytes to be omitted
-                            pDec->errorCode = (int32_t) U_ERROR_COMMON_SUCCESS;
-                        }
+                if (pBody != NULL) {
+                    pDec->errorCode = decodeUbx(pSchema, pBuffer, size, pBody);
+                    if ((pDec->errorCode == (int32_t) U_ERROR_COMMON_SUCCESS) ||
+                        (pDec->errorCode == (int32_t) U_ERROR_COMMON_BAD_DATA)) {
+                        pDec->pBody = pBody;
+                    } else if (pSlot == NULL) {
+                        // No decode was possible
+                        uPortFree(pBody);
                     }
                 }
             }
-            if (pDec->errorCode == (int32_t) U_ERROR_COMMON_SUCCESS) {
-                // Got a known protocol, an ID and a valid length, see if we have
-                // a decoder for this message ID
-                pDec->errorCode = (int32_t) U_ERROR_COMMON_NOT_SUPPORTED;
-                for (x = 0; (pFunction == NULL) && (x < sizeof(gIdList) / sizeof(gIdList[0])); x++) {
-                    if (uGnssMsgIdIsWanted(&(pDec->id), (uGnssMessageId_t *) & (gIdList[x]))) {
-                        pFunction = gpFunctionList[x];
+        }
+        if ((pBuffer != NULL) && (size > 0) &&
+            (pDec->errorCode != (int32_t) U_ERROR_COMMON_SUCCESS) &&
+            (pDec->pBody == NULL) && (gpCallback != NULL)) {
+            // Couldn't decode the message: let the user callback try
+            pDec->errorCode = gpCallback(&(pDec->id), pBuffer, size, &(pDec->pBody), gpCallbackParam);
+        }
+    }
+
+    return pDec;
+}
+
+// Decode a message buffer into caller-supplied storage.
+int32_t uGnssDecInto(const char *pBuffer, size_t size,
+                     uGnssDec_t *pDec, void *pBody, size_t bodySize)
+{
+    int32_t errorCode = (int32_t) U_ERROR_COMMON_INVALID_PARAMETER;
+    const uGnssDecSchema_t *pSchema;
+
+    if (pDec != NULL) {
+        errorCode = decodeId(pBuffer, size, pDec);
+        if (errorCode == (int32_t) U_ERROR_COMMON_SUCCESS) {
+            errorCode = (int32_t) U_ERROR_COMMON_NOT_SUPPORTED;
+            pSchema = pSchemaFind(&(pDec->id));
+            if (pSchema != NULL) {
+                errorCode = (int32_t) U_ERROR_COMMON_NO_MEMORY;
+                if ((pBody != NULL) && (bodySize >= pSchema->bodySize)) {
+                    errorCode = decodeUbx(pSchema, pBuffer, size, pBody);
+                    if ((errorCode == (int32_t) U_ERROR_COMMON_SUCCESS) ||
+                        (errorCode == (int32_t) U_ERROR_COMMON_BAD_DATA)) {
+                        pDec->pBody = (uGnssDecUnion_t *) pBody;
                     }
                 }
-                if (pFunction != NULL) {
-                    // Found a matching decoder, run it
-                    pDec->errorCode = pFunction(pBuffer, size, &(pDec->pBody));
-                }
-            }
-            if ((pDec->errorCode != (int32_t) U_ERROR_COMMON_SUCCESS) &&
-                (gpCallback != NULL)) {
-                // Couldn't decode the message: let the user callback try
-                pDec->errorCode = gpCallback(&(pDec->id), pBuffer, size, &(pDec->pBody), gpCallbackParam);
             }
         }
+        pDec->errorCode = errorCode;
     }
 
-    return pDec;
+    return errorCode;
 }
 
 // Free the memory returned by pUGnssDecAlloc().
 void uGnssDecFree(uGnssDec_t *pDec)
 {
+    uGnssDecSlot_t *pSlot = NULL;
+
     if (pDec != NULL) {
-        uPortFree(pDec->pBody);
-        uPortFree(pDec);
+        if (gPoolMutex != NULL) {
+            U_PORT_MUTEX_LOCK(gPoolMutex);
+            pSlot = pPoolSlotGet(pDec);
+            if (pSlot != NULL) {
+                // The body will only not be in the slot if it
+                // was allocated by the user callback
+                if (pDec->pBody != &(pSlot->body)) {
+                    uPortFree(pDec->pBody);
+                }
+                pSlot->inUse = false;
+            }
+            U_PORT_MUTEX_UNLOCK(gPoolMutex);
+        }
+        if (pSlot == NULL) {
+            uPortFree(pDec->pBody);
+            uPortFree(pDec);
+        }
     }
 }
 
@@ -416,6 +1052,49 @@ int32_t uGnssDecGetIdList(const uGnssMessageId_t **ppIdList)
     return sizeof(gIdList) / sizeof(gIdList[0]);
 }
 
+// Give pUGnssDecAlloc() a pool of slots to use.
+int32_t uGnssDecPoolInit(uGnssDecSlot_t *pSlots, size_t numSlots)
+{
+    int32_t errorCode = (int32_t) U_ERROR_COMMON_INVALID_PARAMETER;
+
+    if ((gPoolMutex == NULL) && (pSlots != NULL) && (numSlots > 0)) {
+        memset(pSlots, 0, sizeof(*pSlots) * numSlots);
+        gpPoolSlot = pSlots;
+        gPoolNumSlots = numSlots;
+        errorCode = uPortMutexCreate(&gPoolMutex);
+        if (errorCode != 0) {
+            gpPoolSlot = NULL;
+            gPoolNumSlots = 0;
+        }
+    }
+
+    return errorCode;
+}
+
+// Stop pUGnssDecAlloc() using a pool of slots.
+int32_t uGnssDecPoolDeinit()
+{
+    int32_t errorCode = (int32_t) U_ERROR_COMMON_SUCCESS;
+
+    if (gPoolMutex != NULL) {
+        U_PORT_MUTEX_LOCK(gPoolMutex);
+        for (size_t x = 0; (errorCode == 0) && (x < gPoolNumSlots); x++) {
+            if (gpPoolSlot[x].inUse) {
+                errorCode = (int32_t) U_ERROR_COMMON_BUSY;
+            }
+        }
+        U_PORT_MUTEX_UNLOCK(gPoolMutex);
+        if (errorCode == 0) {
+            uPortMutexDelete(gPoolMutex);
+            gPoolMutex = NULL;
+            gpPoolSlot = NULL;
+            gPoolNumSlots = 0;
+        }
+    }
+
+    return errorCode;
+}
+
 // Add a custom decoder.
 void uGnssDecSetCallback(uGnssDecFunction_t *pCallback,
                          void *pCallbackParam)
@@ -0,0 +1,652 @@
+/*
+ * Copyright 2019-2024 u-blox
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* Only #includes of u_* and the C standard library are allowed here,
+ * no platform stuff and no OS stuff.  Anything required from
+ * the platform/OS must be brought in through u_port* to maintain
+ * portability.
+ */
+
+/** @file
+ * @brief Implementation of the streaming framer for UBX, NMEA, RTCM3
+ * and SPARTN.
+ *
+ * There is one state, #uGnssFramer_t, for whichever protocol the
+ * current candidate frame belongs to: the first byte of a candidate
+ * selects the protocol and from then on each byte is examined
+ * exactly once, header bytes one at a time and message bodies a
+ * block at a time, the running checksum/CRC being carried in the
+ * state between blocks; SPARTN candidates are checked by the same
+ * step, uSpartnCandidateFeed(), as the SPARTN stream decoder uses.
+ * This file deliberately depends on nothing but the C library, the
+ * UBX protocol functions and the SPARTN functions, so that it can be
+ * built on its own, e.g. for fuzzing.
+ */
+
+#ifdef U_CFG_OVERRIDE
+# include "u_cfg_override.h" // For a customer's configuration override
+#endif
+
+#include "stddef.h"    // NULL, size_t, offsetof() etc.
+#include "stdint.h"    // int32_t etc.
+#include "stdbool.h"
+#include "string.h"    // memcpy(), memmove(), memset()
+
+#include "u_error_common.h"
+
+#include "u_crc.h"
+#include "u_ubx_protocol.h"
+
+#include "u_spartn.h"
+
+#include "u_gnss_type.h"
+#include "u_gnss_framer.h"
+
+/* ----------------------------------------------------------------
+ * COMPILE-TIME MACROS
+ * -------------------------------------------------------------- */
+
+/** The number of bytes in a UBX message before the body: 0xB5, 0x62,
+ * class, ID and two bytes of length.
+ */
+#define U_GNSS_FRAMER_UBX_HEADER_LENGTH_BYTES 6
+
+/** The number of bytes before the message ID in an RTCM message:
+ * 0xD3, six reserved bits and ten bits of length.
+ */
+#define U_GNSS_FRAMER_RTCM_HEADER_LENGTH_BYTES 3
+
+/** The number of bytes of CRC24Q at the end of an RTCM message.
+ */
+#define U_GNSS_FRAMER_RTCM_CRC_LENGTH_BYTES 3
+
+/* ----------------------------------------------------------------
+ * TYPES
+ * -------------------------------------------------------------- */
+
+/** The phases of an NMEA candidate.
+ */
+typedef enum {
+    U_GNSS_FRAMER_NMEA_PHASE_START = 0,
+    U_GNSS_FRAMER_NMEA_PHASE_ID,
+    U_GNSS_FRAMER_NMEA_PHASE_BODY,
+    U_GNSS_FRAMER_NMEA_PHASE_CRC_HIGH,
+    U_GNSS_FRAMER_NMEA_PHASE_CRC_LOW,
+    U_GNSS_FRAMER_NMEA_PHASE_CR,
+    U_GNSS_FRAMER_NMEA_PHASE_LF
+} uGnssFramerNmeaPhase_t;
+
+/* ----------------------------------------------------------------
+ * VARIABLES
+ * -------------------------------------------------------------- */
+
+/* ----------------------------------------------------------------
+ * STATIC FUNCTIONS
+ * -------------------------------------------------------------- */
+
+// Return the protocol that a byte would begin, or
+// U_GNSS_FRAMER_PROTOCOL_NONE.
+static uGnssFramerProtocol_t syncProtocol(uint8_t by)
+{
+    uGnssFramerProtocol_t protocol = U_GNSS_FRAMER_PROTOCOL_NONE;
+
+    switch (by) {
+        case 0xB5: // = µ
+            protocol = U_GNSS_FRAMER_PROTOCOL_UBX;
+            break;
+        case '$':
+            protocol = U_GNSS_FRAMER_PROTOCOL_NMEA;
+            break;
+        case 0xD3:
+            protocol = U_GNSS_FRAMER_PROTOCOL_RTCM;
+            break;
+        case 0x73:
+            protocol = U_GNSS_FRAMER_PROTOCOL_SPARTN;
+            break;
+        default:
+            break;
+    }
+
+    return protocol;
+}
+
+// Forget the candidate frame, leaving the stream state alone.
+static void candidateReset(uGnssFramer_t *pFramer)
+{
+    memset(pFramer, 0, offsetof(uGnssFramer_t, protocolsBitmap));
+}
+
+// Frame a UBX candidate, the first byte of which has been seen.
+static int32_t frameUbx(uGnssFramer_t *pFramer, const uint8_t *pByte,
+                        size_t length, uGnssFramerFrame_t *pFrame)
+{
+    int32_t errorCodeOrLength = (int32_t) U_ERROR_COMMON_TIMEOUT;
+    size_t x = 0;
+    size_t y;
+    uint8_t cka;
+    uint8_t ckb;
+    uint8_t by;
+
+    while ((x < length) && (errorCodeOrLength == (int32_t) U_ERROR_COMMON_TIMEOUT)) {
+        if ((pFramer->count >= U_GNSS_FRAMER_UBX_HEADER_LENGTH_BYTES) &&
+            (pFramer->count < pFramer->crcOffset)) {
+            // In the body: run the checksum over as much as is here
+            y = pFramer->crcOffset - pFramer->count;
+            if (y > length - x) {
+                y = length - x;
+            }
+            pFramer->crc = uUbxProtocolChecksum((const char *) pByte + x, y,
+                                                (uint16_t) pFramer->crc);
+            pFramer->count += y;
+            x += y;
+        } else {
+            by = pByte[x];
+            switch (pFramer->count) {
+                case 0: // 0xB5, already checked
+                    break;
+                case 1:
+                    if (by != 0x62) { // = b
+                        errorCodeOrLength = (int32_t) U_ERROR_COMMON_NOT_FOUND;
+                    }
+                    break;
+                case 2: // Class
+                    pFramer->id = (uint16_t) (((uint16_t) by) << 8);
+                    break;
+                case 3: // ID
+                    pFramer->id |= by;
+                    break;
+                case 4: // Length, low byte
+                    pFramer->crcOffset = by;
+                    break;
+                case 5: // Length, high byte
+                    pFramer->crcOffset += (((size_t) by) << 8) + U_GNSS_FRAMER_UBX_HEADER_LENGTH_BYTES;
+                    pFramer->length = pFramer->crcOffset + 2;
+                    break;
+                default:
+                    // The two checksum bytes
+                    if (by != (uint8_t) (pFramer->crc >> (8 * (pFramer->count - pFramer->crcOffset)))) {
+                        errorCodeOrLength = (int32_t) U_ERROR_COMMON_NOT_FOUND;
+                    } else if (pFramer->count + 1 == pFramer->length) {
+                        pFrame->protocol = U_GNSS_FRAMER_PROTOCOL_UBX;
+                        pFrame->id.ubx = pFramer->id;
+                        pFrame->length = pFramer->length;
+                        errorCodeOrLength = (int32_t) (x + 1);
+                    }
+                    break;
+            }
+            if ((pFramer->count >= 2) && (pFramer->count < U_GNSS_FRAMER_UBX_HEADER_LENGTH_BYTES)) {
+                // The checksum covers class, ID and length
+                cka = (uint8_t) (pFramer->crc + by);
+                ckb = (uint8_t) ((pFramer->crc >> 8) + cka);
+                pFramer->crc = cka | (((uint32_t) ckb) << 8);
+            }
+            pFramer->count++;
+            x++;
+        }
+    }
+
+    return errorCodeOrLength;
+}
+
+// Frame an NMEA candidate, the "$" of which has been seen.
+static int32_t frameNmea(uGnssFramer_t *pFramer, const uint8_t *pByte,
+                         size_t length, uGnssFramerFrame_t *pFrame)
+{
+    int32_t errorCodeOrLength = (int32_t) U_ERROR_COMMON_TIMEOUT;
+    const char *pHex = "0123456789ABCDEF";
+    size_t idLength = pFramer->id;
+    uint8_t crc = (uint8_t) pFramer->crc;
+    uint8_t phase = pFramer->phase;
+    size_t x;
+    char ch;
+
+    for (x = 0; (x < length) && (errorCodeOrLength == (int32_t) U_ERROR_COMMON_TIMEOUT); x++) {
+        ch = (char) pByte[x];
+        if (pFramer->count + x >= U_GNSS_FRAMER_NMEA_LENGTH_MAX_BYTES) {
+            errorCodeOrLength = (int32_t) U_ERROR_COMMON_NOT_FOUND;
+            break;
+        }
+        switch (phase) {
+            case U_GNSS_FRAMER_NMEA_PHASE_START:
+                // The "$", already checked
+                phase = U_GNSS_FRAMER_NMEA_PHASE_ID;
+                break;
+            case U_GNSS_FRAMER_NMEA_PHASE_ID:
+                crc ^= (uint8_t) ch;
+                if (ch == ',') {
+                    phase = U_GNSS_FRAMER_NMEA_PHASE_BODY;
+                } else if ((idLength >= U_GNSS_NMEA_MESSAGE_MATCH_LENGTH_CHARACTERS) ||
+                           ('0' > ch) || ('Z' < ch) || (('9' < ch) && ('A' > ch))) {
+                    // Too long or not A-Z, 0-9
+                    errorCodeOrLength = (int32_t) U_ERROR_COMMON_NOT_FOUND;
+                } else {
+                    pFramer->scratch.nmea[idLength] = ch;
+                    idLength++;
+                }
+                break;
+            case U_GNSS_FRAMER_NMEA_PHASE_BODY:
+                if ((' ' > ch) || ('~' < ch)) {
+                    // Not in printable range 32 - 126
+                    errorCodeOrLength = (int32_t) U_ERROR_COMMON_NOT_FOUND;
+                } else if (ch == '*') {
+                    phase = U_GNSS_FRAMER_NMEA_PHASE_CRC_HIGH;
+                } else {
+                    crc ^= (uint8_t) ch;
+                }
+                break;
+            case U_GNSS_FRAMER_NMEA_PHASE_CRC_HIGH:
+                if (ch == pHex[(crc >> 4) & 0xF]) {
+                    phase = U_GNSS_FRAMER_NMEA_PHASE_CRC_LOW;
+                } else {
+                    errorCodeOrLength = (int32_t) U_ERROR_COMMON_NOT_FOUND;
+                }
+                break;
+            case U_GNSS_FRAMER_NMEA_PHASE_CRC_LOW:
+                if (ch == pHex[crc & 0xF]) {
+                    phase = U_GNSS_FRAMER_NMEA_PHASE_CR;
+                } else {
+                    errorCodeOrLength = (int32_t) U_ERROR_COMMON_NOT_FOUND;
+                }
+                break;
+            case U_GNSS_FRAMER_NMEA_PHASE_CR:
+                if (ch == '\r') {
+                    phase = U_GNSS_FRAMER_NMEA_PHASE_LF;
+                } else {
+                    errorCodeOrLength = (int32_t) U_ERROR_COMMON_NOT_FOUND;
+                }
+                break;
+            case U_GNSS_FRAMER_NMEA_PHASE_LF:
+                if (ch == '\n') {
+                    pFrame->protocol = U_GNSS_FRAMER_PROTOCOL_NMEA;
+                    memcpy(pFrame->id.nmea, pFramer->scratch.nmea, idLength);
+                    pFrame->id.nmea[idLength] = '\0';
+                    pFrame->length = pFramer->count + x + 1;
+                    errorCodeOrLength = (int32_t) (x + 1);
+                } else {
+                    errorCodeOrLength = (int32_t) U_ERROR_COMMON_NOT_FOUND;
+                }
+                break;
+            default:
+                errorCodeOrLength = (int32_t) U_ERROR_COMMON_NOT_FOUND;
+                break;
+        }
+    }
+
+    pFramer->count += x;
+    pFramer->id = (uint16_t) idLength;
+    pFramer->crc = crc;
+    pFramer->phase = phase;
+
+    return errorCodeOrLength;
+}
+
+// Frame an RTCM candidate, the first byte of which has been seen.
+static int32_t frameRtcm(uGnssFramer_t *pFramer, const uint8_t *pByte,
+                         size_t length, uGnssFramerFrame_t *pFrame)
+{
+    int32_t errorCodeOrLength = (int32_t) U_ERROR_COMMON_TIMEOUT;
+    size_t x = 0;
+    size_t y;
+    uint8_t by;
+
+    while ((x < length) && (errorCodeOrLength == (int32_t) U_ERROR_COMMON_TIMEOUT)) {
+        if ((pFramer->count >= U_GNSS_FRAMER_RTCM_HEADER_LENGTH_BYTES + 2) &&
+            (pFramer->count < pFramer->crcOffset)) {
+            // In the body, after the message ID: run the CRC over as
+            // much as is here
+            y = pFramer->crcOffset - pFramer->count;
+            if (y > length - x) {
+                y = length - x;
+            }
+            pFramer->crc = uCrc24q((const char *) pByte + x, y, pFramer->crc);
+            pFramer->count += y;
+            x += y;
+        } else {
+            by = pByte[x];
+            if ((pFramer->count < U_GNSS_FRAMER_RTCM_HEADER_LENGTH_BYTES) ||
+                (pFramer->count < pFramer->crcOffset)) {
+                // Header or message ID, all covered by the CRC,
+                // which includes the 0xD3
+                switch (pFramer->count) {
+                    case 0: // 0xD3, already checked
+                        break;
+                    case 1:
+                        // Six reserved bits then the top of the length
+                        if ((by & 0xFC) != 0) {
+                            errorCodeOrLength = (int32_t) U_ERROR_COMMON_NOT_FOUND;
+                        }
+                        pFramer->crcOffset = ((size_t) (by & 0x3)) << 8;
+                        break;
+                    case 2:
+                        // Length includes the two-byte message ID and the
+                        // message body, i.e. up to the start of the 3-byte CRC
+                        pFramer->crcOffset += by + U_GNSS_FRAMER_RTCM_HEADER_LENGTH_BYTES;
+                        pFramer->length = pFramer->crcOffset + U_GNSS_FRAMER_RTCM_CRC_LENGTH_BYTES;
+                        break;
+                    case 3:
+                        pFramer->id = (uint16_t) (by << 4);
+                        break;
+                    default:
+                        pFramer->id += (uint16_t) (by >> 4);
+                        break;
+                }
+                pFramer->crc = uCrc24q((const char *) &by, 1, pFramer->crc);
+            } else {
+                // The three CRC bytes, most significant first
+                y = pFramer->length - 1 - pFramer->count;
+                if (by != (uint8_t) (pFramer->crc >> (8 * y))) {
+                    errorCodeOrLength = (int32_t) U_ERROR_COMMON_NOT_FOUND;
+                } else if (y == 0) {
+                    pFrame->protocol = U_GNSS_FRAMER_PROTOCOL_RTCM;
+                    pFrame->id.rtcm = pFramer->id;
+                    pFrame->length = pFramer->length;
+                    errorCodeOrLength = (int32_t) (x + 1);
+                }
+            }
+            pFramer->count++;
+            x++;
+        }
+    }
+
+    return errorCodeOrLength;
+}
+
+// Frame a SPARTN candidate, the first byte of which has been seen.
+static int32_t frameSpartn(uGnssFramer_t *pFramer, const uint8_t *pByte,
+                           size_t length, uGnssFramerFrame_t *pFrame)
+{
+    uSpartnCandidate_t *pCandidate = &(pFramer->scratch.spartn);
+    int32_t errorCodeOrLength;
+
+    errorCodeOrLength = uSpartnCandidateFeed(pCandidate, (const char *) pByte, length);
+    // Keep count and length where frameCandidate() looks for them
+    pFramer->count = pCandidate->count;
+    pFramer->length = pCandidate->length;
+    if (errorCodeOrLength > 0) {
+        pFrame->protocol = U_GNSS_FRAMER_PROTOCOL_SPARTN;
+        // Message type (TF002) and sub-type (TF007)
+        pFrame->id.spartn = (uint16_t) (((pCandidate->header[1] >> 1) << 8) |
+                                        (pCandidate->header[4] >> 4));
+        pFrame->length = pCandidate->length;
+    }
+
+    return errorCodeOrLength;
+}
+
+// Frame a candidate, the data of which begins with the sync byte
+// on the first call for the candidate; the return value is as for
+// a block parser, see uGnssFramerParseBlock().
+static int32_t frameCandidate(uGnssFramer_t *pFramer, const uint8_t *pByte,
+                              size_t length, uGnssFramerFrame_t *pFrame)
+{
+    int32_t errorCodeOrLength = (int32_t) U_ERROR_COMMON_NOT_FOUND;
+
+    if (pFramer->count == 0) {
+        pFramer->protocol = (uint8_t) syncProtocol(*pByte);
+    }
+    switch (pFramer->protocol) {
+        case U_GNSS_FRAMER_PROTOCOL_UBX:
+            errorCodeOrLength = frameUbx(pFramer, pByte, length, pFrame);
+            break;
+        case U_GNSS_FRAMER_PROTOCOL_NMEA:
+            errorCodeOrLength = frameNmea(pFramer, pByte, length, pFrame);
+            break;
+        case U_GNSS_FRAMER_PROTOCOL_RTCM:
+            errorCodeOrLength = frameRtcm(pFramer, pByte, length, pFrame);
+            break;
+        case U_GNSS_FRAMER_PROTOCOL_SPARTN:
+            errorCodeOrLength = frameSpartn(pFramer, pByte, length, pFrame);
+            break;
+        default:
+            break;
+    }
+    if ((errorCodeOrLength == (int32_t) U_ERROR_COMMON_TIMEOUT) &&
+        (pFramer->bufferSize > 0) &&
+        ((pFramer->length > pFramer->bufferSize) || (pFramer->count > pFramer->bufferSize))) {
+        // With a buffer, a frame that would not fit in it is not
+        // of interest: give up now rather than risk missing the
+        // frames that a corrupt length field would take in
+        errorCodeOrLength = (int32_t) U_ERROR_COMMON_NOT_FOUND;
+    }
+
+    return errorCodeOrLength;
+}
+
+// Return true if the given byte begins a frame of a wanted protocol.
+static bool isSync(const uGnssFramer_t *pFramer, uint8_t by)
+{
+    uGnssFramerProtocol_t protocol = syncProtocol(by);
+
+    return (protocol != U_GNSS_FRAMER_PROTOCOL_NONE) &&
+           ((pFramer->protocolsBitmap & U_GNSS_FRAMER_PROTOCOL_BIT(protocol)) != 0);
+}
+
+// Frame the bytes left in the buffer from a candidate that turned
+// out not to be a frame; returns true if a frame was found.
+static bool framePending(uGnssFramer_t *pFramer, uGnssFramerFrame_t *pFrame)
+{
+    bool found = false;
+    size_t x = pFramer->pendingOffset;
+    int32_t errorCodeOrLength;
+
+    while ((x < pFramer->bufferLength) && !isSync(pFramer, (uint8_t) pFramer->pBuffer[x])) {
+        x++;
+    }
+    pFramer->pendingOffset = 0;
+    if (x < pFramer->bufferLength) {
+        // Move the new candidate to the start of the buffer
+        pFramer->bufferLength -= x;
+        memmove(pFramer->pBuffer, pFramer->pBuffer + x, pFramer->bufferLength);
+        errorCodeOrLength = frameCandidate(pFramer, (const uint8_t *) pFramer->pBuffer,
+                                           pFramer->bufferLength, pFrame);
+        if (errorCodeOrLength > 0) {
+            // A frame entirely within the buffer; anything after it
+            // is still pending
+            found = true;
+            pFrame->pData = pFramer->pBuffer;
+            candidateReset(pFramer);
+            if ((size_t) errorCodeOrLength < pFramer->bufferLength) {
+                pFramer->pendingOffset = (size_t) errorCodeOrLength;
+            } else {
+                pFramer->bufferLength = 0;
+            }
+        } else if (errorCodeOrLength == (int32_t) U_ERROR_COMMON_NOT_FOUND) {
+            // Not this one either: try from the next byte
+            candidateReset(pFramer);
+            if (pFramer->bufferLength > 1) {
+                pFramer->pendingOffset = 1;
+            } else {
+                pFramer->bufferLength = 0;
+            }
+        }
+        // Otherwise the candidate continues into new data and
+        // the buffer holds all of it so far
+    } else {
+        pFramer->bufferLength = 0;
+    }
+
+    return found;
+}
+
+/* ----------------------------------------------------------------
+ * PUBLIC FUNCTIONS
+ * -------------------------------------------------------------- */
+
+// Initialise a framer.
+int32_t uGnssFramerInit(uGnssFramer_t *pFramer, uint32_t protocolsBitmap,
+                        char *pBuffer, size_t bufferSize)
+{
+    int32_t errorCode = (int32_t) U_ERROR_COMMON_INVALID_PARAMETER;
+
+    if ((pFramer != NULL) && ((pBuffer != NULL) || (bufferSize == 0))) {
+        memset(pFramer, 0, sizeof(*pFramer));
+        pFramer->protocolsBitmap = protocolsBitmap;
+        pFramer->pBuffer = pBuffer;
+        pFramer->bufferSize = bufferSize;
+        errorCode = (int32_t) U_ERROR_COMMON_SUCCESS;
+    }
+
+    return errorCode;
+}
+
+// Forget any partial frame.
+void uGnssFramerReset(uGnssFramer_t *pFramer)
+{
+    if (pFramer != NULL) {
+        candidateReset(pFramer);
+        pFramer->bufferLength = 0;
+        pFramer->pendingOffset = 0;
+    }
+}
+
+// Feed data to a framer.
+int32_t uGnssFramerFeed(uGnssFramer_t *pFramer, const char *pData,
+                        size_t length, uGnssFramerFrame_t *pFrame)
+{
+    int32_t errorCodeOrConsumed = (int32_t) U_ERROR_COMMON_INVALID_PARAMETER;
+    const uint8_t *pByte = (const uint8_t *) pData;
+    bool found = false;
+    size_t consumed = 0;
+    bool held;
+    size_t x;
+    int32_t y;
+
+    if ((pFramer != NULL) && (pFrame != NULL) && ((pData != NULL) || (length == 0))) {
+        pFrame->protocol = U_GNSS_FRAMER_PROTOCOL_NONE;
+        pFrame->pData = NULL;
+        while (!found && ((pFramer->pendingOffset > 0) || (consumed < length))) {
+            if (pFramer->pendingOffset > 0) {
+                // Bytes taken in earlier must be looked at again first
+                found = framePending(pFramer, pFrame);
+            } else if (pFramer->count > 0) {
+                // Continue a candidate begun in an earlier call; the
+                // buffer holds it if bufferLength matches its count
+                held = (pFramer->bufferLength == pFramer->count);
+                y = frameCandidate(pFramer, pByte + consumed, length - consumed, pFrame);
+                if (y > 0) {
+                    found = true;
+                    if (held && (pFramer->count <= pFramer->bufferSize)) {
+                        memcpy(pFramer->pBuffer + pFramer->bufferLength, pByte + consumed, y);
+                        pFrame->pData = pFramer->pBuffer;
+                    }
+                    consumed += y;
+                    candidateReset(pFramer);
+                    pFramer->bufferLength = 0;
+                } else if (y == (int32_t) U_ERROR_COMMON_TIMEOUT) {
+                    if (held && (pFramer->count <= pFramer->bufferSize)) {
+                        memcpy(pFramer->pBuffer + pFramer->bufferLength, pByte + consumed,
+                               length - consumed);
+                        pFramer->bufferLength = pFramer->count;
+                    } else {
+                        pFramer->bufferLength = 0;
+                    }
+                    consumed = length;
+                } else {
+                    // Not a frame after all: if it is in the buffer, look
+                    // again from its second byte, otherwise just go on
+                    // with the new data, none of which is yet consumed
+                    candidateReset(pFramer);
+                    if (held && (pFramer->bufferLength > 1)) {
+                        pFramer->pendingOffset = 1;
+                    } else {
+                        pFramer->bufferLength = 0;
+                    }
+                }
+            } else {
+                // Look for the start of a frame
+                x = consumed;
+                while ((x < length) && !isSync(pFramer, pByte[x])) {
+                    x++;
+                }
+                consumed = length;
+                if (x < length) {
+                    y = frameCandidate(pFramer, pByte + x, length - x, pFrame);
+                    if (y > 0) {
+                        found = true;
+                        pFrame->pData = pData + x;
+                        consumed = x + y;
+                        candidateReset(pFramer);
+                    } else if (y == (int32_t) U_ERROR_COMMON_TIMEOUT) {
+                        // Runs off the end of the data: keep what there
+                        // is of it, if it fits
+                        pFramer->bufferLength = 0;
+                        if (length - x <= pFramer->bufferSize) {
+                            memcpy(pFramer->pBuffer, pByte + x, length - x);
+                            pFramer->bufferLength = length - x;
+                        }
+                    } else {
+                        candidateReset(pFramer);
+                        consumed = x + 1;
+                    }
+                }
+            }
+        }
+        errorCodeOrConsumed = (int32_t) consumed;
+    }
+
+    return errorCodeOrConsumed;
+}
+
+// Tell a framer that the data has ended.
+int32_t uGnssFramerFlush(uGnssFramer_t *pFramer, uGnssFramerFrame_t *pFrame)
+{
+    int32_t errorCode = (int32_t) U_ERROR_COMMON_INVALID_PARAMETER;
+    bool found = false;
+
+    if ((pFramer != NULL) && (pFrame != NULL)) {
+        pFrame->protocol = U_GNSS_FRAMER_PROTOCOL_NONE;
+        pFrame->pData = NULL;
+        do {
+            if (pFramer->count > 0) {
+                // Abandon the partial frame, looking again from its
+                // second byte if it is in the buffer
+                if ((pFramer->bufferLength == pFramer->count) &&
+                    (pFramer->bufferLength > 1)) {
+                    pFramer->pendingOffset = 1;
+                } else {
+                    pFramer->bufferLength = 0;
+                }
+                candidateReset(pFramer);
+            }
+            while (!found && (pFramer->pendingOffset > 0)) {
+                found = framePending(pFramer, pFrame);
+            }
+        } while (!found && (pFramer->count > 0));
+        errorCode = (int32_t) U_ERROR_COMMON_SUCCESS;
+    }
+
+    return errorCode;
+}
+
+// The framer as a block parser.
+int32_t uGnssFramerParseBlock(void *pState, const char *pData, size_t length,
+                              void *pUserParam)
+{
+    int32_t errorCodeOrLength = (int32_t) U_ERROR_COMMON_INVALID_PARAMETER;
+    uGnssFramerFrame_t *pFrame = (uGnssFramerFrame_t *) pUserParam;
+
+    if ((pState != NULL) && (pData != NULL) && (length > 0) && (pFrame != NULL)) {
+        errorCodeOrLength = frameCandidate((uGnssFramer_t *) pState,
+                                           (const uint8_t *) pData, length, pFrame);
+        if (errorCodeOrLength > 0) {
+            pFrame->pData = NULL;
+        }
+    }
+
+    return errorCodeOrLength;
+}
+
+// End of file
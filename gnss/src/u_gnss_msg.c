@@ -73,6 +73,7 @@
 #include "u_port_os.h"
 #include "u_port_heap.h"
 #include "u_port_debug.h"
+#include "u_port_event_queue.h" // U_PORT_EVENT_QUEUE_MIN_TASK_STACK_SIZE_BYTES
 #include "u_port_uart.h"
 #include "u_port_i2c.h"
 #include "u_port_spi.h"
@@ -108,6 +109,14 @@
 # define U_GNSS_MSG_RECEIVE_TASK_PRIORITY (U_CFG_OS_PRIORITY_MAX - 5)
 #endif
 
+#ifndef U_GNSS_MSG_RECEIVE_EVENT_TASK_STACK_SIZE_BYTES
+/** The stack size of the task in which the transport tells the
+ * asynchronous message receive task that data has arrived; it does
+ * nothing more than give a semaphore so the minimum will do.
+ */
+# define U_GNSS_MSG_RECEIVE_EVENT_TASK_STACK_SIZE_BYTES U_PORT_EVENT_QUEUE_MIN_TASK_STACK_SIZE_BYTES
+#endif
+
 #ifndef U_GNSS_MSG_TASK_STACK_YIELD_TIME_MS
 /** How long the asynchronous message receive task guarantees to give
  * to the rest of the system; if this is made larger the asynchronous
@@ -124,6 +133,27 @@
 # error U_GNSS_MSG_TASK_STACK_YIELD_TIME_MS must be at least as big as U_CFG_OS_YIELD_MS
 #endif
 
+#ifndef U_GNSS_MSG_RECEIVE_TASK_COALESCE_MS
+/** Where the transport is able to tell the asynchronous message
+ * receive task that data has arrived (UART or virtual serial), the
+ * task waits for that rather than polling every
+ * #U_GNSS_MSG_TASK_STACK_YIELD_TIME_MS; this is the minimum time
+ * between the starts of its passes through the received data, so
+ * that a burst of data arriving in dribs and drabs is dealt with
+ * in one go rather than the task being woken for each piece.  A
+ * message arriving when the task has been idle for at least this
+ * long is dealt with immediately.
+ */
+# define U_GNSS_MSG_RECEIVE_TASK_COALESCE_MS 5
+#endif
+
+#ifndef U_GNSS_MSG_RECEIVE_TASK_EVENT_TIMEOUT_MS
+/** The longest the asynchronous message receive task waits for the
+ * transport to say that data has arrived before checking anyway.
+ */
+# define U_GNSS_MSG_RECEIVE_TASK_EVENT_TIMEOUT_MS 1000
+#endif
+
 /* ----------------------------------------------------------------
  * TYPES
  * -------------------------------------------------------------- */
@@ -136,6 +166,40 @@
  * STATIC FUNCTIONS
  * -------------------------------------------------------------- */
 
+// Call the callback of a reader with the message that is at the
+// read pointer of the message receive task.
+static void callReader(uGnssPrivateInstance_t *pInstance,
+                       uGnssPrivateMsgReader_t *pReader,
+                       const uGnssMessageId_t *pMessageId,
+                       int32_t errorCodeOrLength)
+{
+    uGnssPrivateMsgReceive_t *pMsgReceive = pInstance->pMsgReceive;
+    uRingBufferSpan_t spans[2];
+
+    if (pReader->isSpanCallback) {
+        // Hand over what is left of the message in place: the read
+        // handle is locked so nothing can overwrite it until we move on
+        uRingBufferPeekSpansHandle(&(pInstance->ringBuffer),
+                                   pMsgReceive->ringBufferReadHandle, spans);
+        if (spans[0].length >= pMsgReceive->msgBytesLeftToRead) {
+            spans[0].length = pMsgReceive->msgBytesLeftToRead;
+            spans[1].length = 0;
+        } else if (spans[0].length + spans[1].length > pMsgReceive->msgBytesLeftToRead) {
+            spans[1].length = pMsgReceive->msgBytesLeftToRead - spans[0].length;
+        }
+        ((uGnssMsgReceiveSpanCallback_t) pReader->pCallback)(pInstance->gnssHandle,
+                                                             pMessageId,
+                                                             errorCodeOrLength,
+                                                             spans,
+                                                             pReader->pCallbackParam);
+    } else {
+        ((uGnssMsgReceiveCallback_t) pReader->pCallback)(pInstance->gnssHandle,
+                                                         pMessageId,
+                                                         errorCodeOrLength,
+                                                         pReader->pCallbackParam);
+    }
+}
+
 // Task that runs the non-blocking message receive.
 static void msgReceiveTask(void *pParam)
 {
@@ -146,7 +210,9 @@ static void msgReceiveTask(void *pParam)
     int32_t errorCodeOrLength = (int32_t) U_ERROR_COMMON_UNKNOWN;
     int32_t receiveSize;
     int32_t yieldTimeMs;
+    int32_t passStartTimeMs;
     size_t discardSize = 0;
+    size_t numMatched;
     uGnssMessageId_t messageId;
     uGnssPrivateMessageId_t privateMessageId;
     char nmeaId[U_GNSS_NMEA_MESSAGE_MATCH_LENGTH_CHARACTERS + 1];
@@ -164,6 +230,7 @@ static void msgReceiveTask(void *pParam)
         // Note that this does NOT lock gUGnssPrivateMutex: it doesn't need to,
         // provided this task is brought up and torn down in an organised way
 
+        passStartTimeMs = uPortGetTickTimeMs();
         // Pull stuff into the ring buffer
         receiveSize = uGnssPrivateStreamFillRingBuffer(pInstance, 0, 0);
         // Deal with any discard from a previous run around this loop
@@ -195,18 +262,25 @@ static void msgReceiveTask(void *pParam)
 
                         U_PORT_MUTEX_LOCK(pMsgReceive->readerMutexHandle);
 
-                        pReader = pMsgReceive->pReaderList;
-                        while (pReader != NULL) {
-                            if (uGnssPrivateMessageIdIsWanted(&privateMessageId,
-                                                              &(pReader->privateMessageId))) {
-                                // This reader is interested, call the callback
-                                ((uGnssMsgReceiveCallback_t) pReader->pCallback)(pInstance->gnssHandle,
-                                                                                 &messageId,
-                                                                                 errorCodeOrLength,
-                                                                                 pReader->pCallbackParam);
+                        if (pMsgReceive->pReaderIndex != NULL) {
+                            // Let the index tell us who is interested
+                            numMatched = uGnssPrivateMsgIndexMatch(pMsgReceive->pReaderIndex,
+                                                                   &privateMessageId);
+                            for (size_t x = 0; x < numMatched; x++) {
+                                callReader(pInstance, pMsgReceive->pReaderIndex->ppMatched[x],
+                                           &messageId, errorCodeOrLength);
+                            }
+                        } else {
+                            pReader = pMsgReceive->pReaderList;
+                            while (pReader != NULL) {
+                                if (uGnssPrivateMessageIdIsWanted(&privateMessageId,
+                                                                  &(pReader->privateMessageId))) {
+                                    // This reader is interested, call the callback
+                                    callReader(pInstance, pReader, &messageId, errorCodeOrLength);
+                                }
+                                // Next!
+                                pReader = pReader->pNext;
                             }
-                            // Next!
-                            pReader = pReader->pNext;
                         }
 
                         U_PORT_MUTEX_UNLOCK(pMsgReceive->readerMutexHandle);
@@ -220,14 +294,28 @@ static void msgReceiveTask(void *pParam)
             }
         }
 
-        // Relax to let others in; relax for twice as long if we last
-        // received nothing and aren't desperately seeking more data,
-        // in order to allow some data to build up
-        yieldTimeMs = U_GNSS_MSG_TASK_STACK_YIELD_TIME_MS;
-        if ((receiveSize == 0) && (errorCodeOrLength != (int32_t) U_ERROR_COMMON_TIMEOUT))  {
-            yieldTimeMs *= 2;
+        if (pMsgReceive->dataEventIsSet) {
+            // Wait for the transport to tell us that more data has
+            // arrived (the semaphore is also given when we are to
+            // exit) then, if we've not long started the last pass,
+            // let more data build up before the next one
+            uPortSemaphoreTryTake(pMsgReceive->dataEventSemaphoreHandle,
+                                  U_GNSS_MSG_RECEIVE_TASK_EVENT_TIMEOUT_MS);
+            yieldTimeMs = U_GNSS_MSG_RECEIVE_TASK_COALESCE_MS -
+                          (uPortGetTickTimeMs() - passStartTimeMs);
+            if (yieldTimeMs > 0) {
+                uPortTaskBlock(yieldTimeMs);
+            }
+        } else {
+            // Relax to let others in; relax for twice as long if we last
+            // received nothing and aren't desperately seeking more data,
+            // in order to allow some data to build up
+            yieldTimeMs = U_GNSS_MSG_TASK_STACK_YIELD_TIME_MS;
+            if ((receiveSize == 0) && (errorCodeOrLength != (int32_t) U_ERROR_COMMON_TIMEOUT))  {
+                yieldTimeMs *= 2;
+            }
+            uPortTaskBlock(yieldTimeMs);
         }
-        uPortTaskBlock(yieldTimeMs);
     }
 
     // Now we can unlock our ring buffer read handle.  Phew.
@@ -278,15 +366,13 @@ int32_t msgReceiveCallbackRead(uDeviceHandle_t gnssHandle,
     return errorCodeOrLength;
 }
 
-/* ----------------------------------------------------------------
- * PUBLIC FUNCTIONS THAT ARE PRIVATE TO GNSS
- * -------------------------------------------------------------- */
-
-// Start monitoring the output of the GNSS chip for a message.
-int32_t uGnssMsgPrivateReceiveStart(uGnssPrivateInstance_t *pInstance,
-                                    const uGnssPrivateMessageId_t *pPrivateMessageId,
-                                    uGnssMsgReceiveCallback_t pCallback,
-                                    void *pCallbackParam)
+// Start monitoring the output of the GNSS chip for a message,
+// pCallback being a uGnssMsgReceiveSpanCallback_t if isSpanCallback
+// is true, else a uGnssMsgReceiveCallback_t.
+static int32_t receiveStart(uGnssPrivateInstance_t *pInstance,
+                            const uGnssPrivateMessageId_t *pPrivateMessageId,
+                            void *pCallback, bool isSpanCallback,
+                            void *pCallbackParam)
 {
     int32_t errorCodeOrHandle = (int32_t) U_ERROR_COMMON_INVALID_PARAMETER;
     uGnssPrivateMsgReceive_t *pMsgReceive;
@@ -325,6 +411,18 @@ int32_t uGnssMsgPrivateReceiveStart(uGnssPrivateInstance_t *pInstance,
                                     // Create the mutex for task running status
                                     errorCodeOrHandle = uPortMutexCreate(&(pMsgReceive->taskRunningMutexHandle));
                                     if (errorCodeOrHandle == 0) {
+                                        // Create the semaphore the transport gives when data arrives
+                                        errorCodeOrHandle = uPortSemaphoreCreate(&(pMsgReceive->dataEventSemaphoreHandle),
+                                                                                 0, 1);
+                                    }
+                                    if (errorCodeOrHandle == 0) {
+                                        // If the transport can tell us when data
+                                        // arrives the task need not poll
+                                        pMsgReceive->dataEventIsSet =
+                                            (uGnssPrivateStreamDataEventSet(pInstance,
+                                                                            pMsgReceive->dataEventSemaphoreHandle,
+                                                                            U_GNSS_MSG_RECEIVE_EVENT_TASK_STACK_SIZE_BYTES,
+                                                                            U_GNSS_MSG_RECEIVE_TASK_PRIORITY) == 0);
                                         //... and then the task
                                         errorCodeOrHandle = uPortTaskCreate(msgReceiveTask,
                                                                             pTaskName,
@@ -345,6 +443,12 @@ int32_t uGnssMsgPrivateReceiveStart(uGnssPrivateInstance_t *pInstance,
                         }
                         if (errorCodeOrHandle != 0) {
                             // Tidy up if we couldn't get OS resources
+                            if (pMsgReceive->dataEventIsSet) {
+                                uGnssPrivateStreamDataEventRemove(pInstance);
+                            }
+                            if (pMsgReceive->dataEventSemaphoreHandle != NULL) {
+                                uPortSemaphoreDelete(pMsgReceive->dataEventSemaphoreHandle);
+                            }
                             if (pMsgReceive->taskRunningMutexHandle != NULL) {
                                 uPortMutexDelete(pMsgReceive->taskRunningMutexHandle);
                             }
@@ -381,13 +485,18 @@ int32_t uGnssMsgPrivateReceiveStart(uGnssPrivateInstance_t *pInstance,
             pReader->handle = pInstance->pMsgReceive->nextHandle;
             pInstance->pMsgReceive->nextHandle++;
             pReader->privateMessageId = *pPrivateMessageId;
-            pReader->pCallback = (void *) pCallback;
+            pReader->pCallback = pCallback;
+            pReader->isSpanCallback = isSpanCallback;
             pReader->pCallbackParam = pCallbackParam;
             pReader->pNext = pInstance->pMsgReceive->pReaderList;
 
             U_PORT_MUTEX_LOCK(pInstance->pMsgReceive->readerMutexHandle);
 
             pInstance->pMsgReceive->pReaderList = pReader;
+            // Re-index the readers; if there isn't the memory
+            // the task will just have to check each one
+            uPortFree(pInstance->pMsgReceive->pReaderIndex);
+            pInstance->pMsgReceive->pReaderIndex = pUGnssPrivateMsgIndexCreate(pReader);
 
             U_PORT_MUTEX_UNLOCK(pInstance->pMsgReceive->readerMutexHandle);
 
@@ -399,6 +508,20 @@ int32_t uGnssMsgPrivateReceiveStart(uGnssPrivateInstance_t *pInstance,
     return errorCodeOrHandle;
 }
 
+/* ----------------------------------------------------------------
+ * PUBLIC FUNCTIONS THAT ARE PRIVATE TO GNSS
+ * -------------------------------------------------------------- */
+
+// Start monitoring the output of the GNSS chip for a message.
+int32_t uGnssMsgPrivateReceiveStart(uGnssPrivateInstance_t *pInstance,
+                                    const uGnssPrivateMessageId_t *pPrivateMessageId,
+                                    uGnssMsgReceiveCallback_t pCallback,
+                                    void *pCallbackParam)
+{
+    return receiveStart(pInstance, pPrivateMessageId,
+                        (void *) pCallback, false, pCallbackParam);
+}
+
 // Stop monitoring the output of the GNSS chip for a message.
 int32_t uGnssMsgPrivateReceiveStop(uGnssPrivateInstance_t *pInstance,
                                    int32_t asyncHandle)
@@ -433,6 +556,11 @@ int32_t uGnssMsgPrivateReceiveStop(uGnssPrivateInstance_t *pInstance,
                     pCurrent = pPrev->pNext;
                 }
             }
+            uPortFree(pMsgReceive->pReaderIndex);
+            pMsgReceive->pReaderIndex = NULL;
+            if (pMsgReceive->pReaderList != NULL) {
+                pMsgReceive->pReaderIndex = pUGnssPrivateMsgIndexCreate(pMsgReceive->pReaderList);
+            }
 
             U_PORT_MUTEX_UNLOCK(pMsgReceive->readerMutexHandle);
 
@@ -658,6 +786,35 @@ int32_t uGnssMsgReceiveStart(uDeviceHandle_t gnssHandle,
     return errorCodeOrHandle;
 }
 
+// As uGnssMsgReceiveStart() but with the message passed in place.
+int32_t uGnssMsgReceiveStartSpan(uDeviceHandle_t gnssHandle,
+                                 const uGnssMessageId_t *pMessageId,
+                                 uGnssMsgReceiveSpanCallback_t pCallback,
+                                 void *pCallbackParam)
+{
+    int32_t errorCodeOrHandle = (int32_t) U_ERROR_COMMON_NOT_INITIALISED;
+    uGnssPrivateInstance_t *pInstance;
+    uGnssPrivateMessageId_t privateMessageId;
+
+    if (gUGnssPrivateMutex != NULL) {
+
+        U_PORT_MUTEX_LOCK(gUGnssPrivateMutex);
+
+        errorCodeOrHandle = (int32_t) U_ERROR_COMMON_INVALID_PARAMETER;
+        pInstance = pUGnssPrivateGetInstance(gnssHandle);
+        if ((pInstance != NULL) &&
+            (uGnssPrivateMessageIdToPrivate(pMessageId, &privateMessageId) == 0)) {
+            errorCodeOrHandle = receiveStart(pInstance, &privateMessageId,
+                                             (void *) pCallback, true,
+                                             pCallbackParam);
+        }
+
+        U_PORT_MUTEX_UNLOCK(gUGnssPrivateMutex);
+    }
+
+    return errorCodeOrHandle;
+}
+
 // Read a message from the ring buffer into a user's buffer.
 // This function does NOT lock gUGnssPrivateMutex in order
 // that it can be called from pCallback; this is fine since
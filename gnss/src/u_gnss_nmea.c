@@ -0,0 +1,869 @@
+/*
+ * Copyright 2019-2024 u-blox
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* Only #includes of u_* and the C standard library are allowed here,
+ * no platform stuff and no OS stuff.  Anything required from
+ * the platform/OS must be brought in through u_port* to maintain
+ * portability.
+ */
+
+/** @file
+ * @brief Implementation of the streaming NMEA decoder.  Each
+ * character is passed through a small state machine: the address
+ * field selects the sentence type, the characters of each field are
+ * accumulated as a token (the digits as an integer mantissa plus a
+ * count of decimal places) and, at the comma, the token is converted
+ * to the fixed-point units of the member of the sentence structure
+ * that the field belongs to.
+ */
+
+#ifdef U_CFG_OVERRIDE
+# include "u_cfg_override.h" // For a customer's configuration override
+#endif
+
+#include "stddef.h"    // NULL, size_t etc.
+#include "stdint.h"    // int32_t etc.
+#include "stdbool.h"
+#include "string.h"    // memset(), memcmp(), memchr()
+
+#include "u_error_common.h"
+
+#include "u_gnss_nmea.h"
+
+/* ----------------------------------------------------------------
+ * COMPILE-TIME MACROS
+ * -------------------------------------------------------------- */
+
+/** The number of digits of a field that are kept: enough to
+ * fit into an int64_t, more than any NMEA field has.
+ */
+#define U_GNSS_NMEA_DIGITS_MAX_NUM 18
+
+/** The length of the address field: a two-character talker ID
+ * followed by a three-character sentence formatter.
+ */
+#define U_GNSS_NMEA_ADDRESS_LENGTH 5
+
+/* ----------------------------------------------------------------
+ * TYPES
+ * -------------------------------------------------------------- */
+
+/** Where the decoder is in a sentence.
+ */
+typedef enum {
+    U_GNSS_NMEA_PHASE_IDLE = 0,     /**< looking for "$". */
+    U_GNSS_NMEA_PHASE_ADDRESS,      /**< in the address field. */
+    U_GNSS_NMEA_PHASE_FIELDS,       /**< in the data fields. */
+    U_GNSS_NMEA_PHASE_CHECKSUM_1,   /**< expecting the first
+                                         checksum digit. */
+    U_GNSS_NMEA_PHASE_CHECKSUM_2    /**< expecting the second
+                                         checksum digit. */
+} uGnssNmeaPhase_t;
+
+/* ----------------------------------------------------------------
+ * VARIABLES
+ * -------------------------------------------------------------- */
+
+/** The sentence formatter of each #uGnssNmeaSentenceType_t.
+ */
+static const char gFormatter[U_GNSS_NMEA_SENTENCE_TYPE_MAX_NUM][3] = {
+    {'G', 'G', 'A'}, // U_GNSS_NMEA_SENTENCE_TYPE_GGA
+    {'R', 'M', 'C'}, // U_GNSS_NMEA_SENTENCE_TYPE_RMC
+    {'G', 'S', 'A'}, // U_GNSS_NMEA_SENTENCE_TYPE_GSA
+    {'G', 'S', 'V'}, // U_GNSS_NMEA_SENTENCE_TYPE_GSV
+    {'V', 'T', 'G'}, // U_GNSS_NMEA_SENTENCE_TYPE_VTG
+    {'G', 'S', 'T'}, // U_GNSS_NMEA_SENTENCE_TYPE_GST
+    {'Z', 'D', 'A'}  // U_GNSS_NMEA_SENTENCE_TYPE_ZDA
+};
+
+/** Powers of ten, for scaling a token.
+ */
+static const int64_t gPowerOfTen[U_GNSS_NMEA_DIGITS_MAX_NUM + 1] = {
+    1LL, 10LL, 100LL, 1000LL, 10000LL, 100000LL, 1000000LL,
+    10000000LL, 100000000LL, 1000000000LL, 10000000000LL,
+    100000000000LL, 1000000000000LL, 10000000000000LL,
+    100000000000000LL, 1000000000000000LL, 10000000000000000LL,
+    100000000000000000LL, 1000000000000000000LL
+};
+
+/* ----------------------------------------------------------------
+ * STATIC FUNCTIONS: TOKENS
+ * -------------------------------------------------------------- */
+
+// Reset the token, ready for the next field.
+static void tokenReset(uGnssNmea_t *pNmea)
+{
+    pNmea->mantissa = 0;
+    pNmea->numDigits = 0;
+    pNmea->numDecimals = 0;
+    pNmea->length = 0;
+    pNmea->negative = false;
+    pNmea->point = false;
+    pNmea->notNumeric = false;
+    pNmea->character = 0;
+}
+
+// Add a character to the token.
+static void tokenAdd(uGnssNmea_t *pNmea, char character)
+{
+    if (pNmea->length == 0) {
+        pNmea->character = character;
+    }
+    if (pNmea->length < UINT8_MAX) {
+        pNmea->length++;
+    }
+    if ((character >= '0') && (character <= '9')) {
+        if (pNmea->numDigits < U_GNSS_NMEA_DIGITS_MAX_NUM) {
+            pNmea->mantissa = (pNmea->mantissa * 10) + (character - '0');
+            pNmea->numDigits++;
+            if (pNmea->point) {
+                pNmea->numDecimals++;
+            }
+        } else if (!pNmea->point) {
+            // Too big to be anything we know
+            pNmea->notNumeric = true;
+        }
+        // Decimal places beyond what can be kept are dropped
+    } else if ((character == '.') && !pNmea->point) {
+        pNmea->point = true;
+    } else if ((character == '-') && (pNmea->length == 1)) {
+        pNmea->negative = true;
+    } else {
+        pNmea->notNumeric = true;
+    }
+}
+
+// Convert the token to an integer with the given number of decimal
+// places, rounding, false if the token is not a number.
+static bool tokenToFixed(const uGnssNmea_t *pNmea, int32_t decimals,
+                         int64_t *pValue)
+{
+    bool success = false;
+    int64_t value = pNmea->mantissa;
+    int32_t shift = decimals - pNmea->numDecimals;
+
+    if ((pNmea->numDigits > 0) && !pNmea->notNumeric) {
+        if (shift >= 0) {
+            if (pNmea->numDigits + shift <= U_GNSS_NMEA_DIGITS_MAX_NUM) {
+                value *= gPowerOfTen[shift];
+                success = true;
+            }
+        } else {
+            value = (value + (gPowerOfTen[-shift] / 2)) / gPowerOfTen[-shift];
+            success = true;
+        }
+        if (pNmea->negative) {
+            value = -value;
+        }
+        *pValue = value;
+    }
+
+    return success;
+}
+
+// Convert the token to an integer with the given number of decimal
+// places, false if it is not a number or is outside min to max.
+static bool tokenToRanged(const uGnssNmea_t *pNmea, int32_t decimals,
+                          int64_t min, int64_t max, int64_t *pValue)
+{
+    return tokenToFixed(pNmea, decimals, pValue) &&
+           (*pValue >= min) && (*pValue <= max);
+}
+
+// Convert the token to an int32_t with the given number of decimal
+// places.
+static bool tokenToInt32(const uGnssNmea_t *pNmea, int32_t decimals,
+                         int32_t *pValue)
+{
+    int64_t value;
+    bool success = tokenToRanged(pNmea, decimals, INT32_MIN, INT32_MAX, &value);
+
+    if (success) {
+        *pValue = (int32_t) value;
+    }
+
+    return success;
+}
+
+// Convert the token to a uint16_t with the given number of decimal
+// places.
+static bool tokenToUint16(const uGnssNmea_t *pNmea, int32_t decimals,
+                          uint16_t *pValue)
+{
+    int64_t value;
+    bool success = tokenToRanged(pNmea, decimals, 0, UINT16_MAX, &value);
+
+    if (success) {
+        *pValue = (uint16_t) value;
+    }
+
+    return success;
+}
+
+// Convert the token to a uint8_t.
+static bool tokenToUint8(const uGnssNmea_t *pNmea, uint8_t *pValue)
+{
+    int64_t value;
+    bool success = tokenToRanged(pNmea, 0, 0, UINT8_MAX, &value);
+
+    if (success) {
+        *pValue = (uint8_t) value;
+    }
+
+    return success;
+}
+
+// Convert the token to an int8_t.
+static bool tokenToInt8(const uGnssNmea_t *pNmea, int8_t *pValue)
+{
+    int64_t value;
+    bool success = tokenToRanged(pNmea, 0, INT8_MIN, INT8_MAX, &value);
+
+    if (success) {
+        *pValue = (int8_t) value;
+    }
+
+    return success;
+}
+
+// Get a single-character token.
+static bool tokenToCharacter(const uGnssNmea_t *pNmea, char *pValue)
+{
+    bool success = (pNmea->length == 1);
+
+    if (success) {
+        *pValue = pNmea->character;
+    }
+
+    return success;
+}
+
+// Convert a time token, hhmmss.sss, to milliseconds.
+static bool tokenToTimeMs(const uGnssNmea_t *pNmea, int32_t *pValue)
+{
+    int64_t value;
+    bool success = tokenToRanged(pNmea, 3, 0, 235960999, &value);
+    int32_t hours;
+    int32_t minutes;
+    int32_t milliseconds;
+
+    if (success) {
+        hours = (int32_t) (value / 10000000);
+        minutes = (int32_t) ((value / 100000) % 100);
+        milliseconds = (int32_t) (value % 100000);
+        success = (minutes < 60) && (milliseconds < 61000);
+        if (success) {
+            *pValue = (hours * 3600000) + (minutes * 60000) + milliseconds;
+        }
+    }
+
+    return success;
+}
+
+// Convert a date token, ddmmyy, to day, month and year.
+static bool tokenToDate(const uGnssNmea_t *pNmea, uint8_t *pDay,
+                        uint8_t *pMonth, uint16_t *pYear)
+{
+    int64_t value;
+    bool success = tokenToRanged(pNmea, 0, 10100, 311299, &value);
+
+    if (success) {
+        *pDay = (uint8_t) (value / 10000);
+        *pMonth = (uint8_t) ((value / 100) % 100);
+        *pYear = (uint16_t) (2000 + (value % 100));
+        success = (*pDay > 0) && (*pMonth > 0) && (*pMonth <= 12);
+    }
+
+    return success;
+}
+
+// Convert a latitude or longitude token, [d]ddmm.mmmmm, to degrees
+// * 10^7.
+static bool tokenToDegreesX1e7(const uGnssNmea_t *pNmea, int32_t *pValue)
+{
+    int64_t value;
+    // Minutes * 10^7
+    bool success = tokenToRanged(pNmea, 7, 0, 18000LL * 10000000, &value);
+
+    if (success) {
+        // Whole degrees plus the minutes divided by 60, rounded
+        *pValue = (int32_t) (((value / 1000000000) * 10000000) +
+                             (((value % 1000000000) + 30) / 60));
+    }
+
+    return success;
+}
+
+// Apply a hemisphere token to a value: negative leaves the value
+// negated, positive leaves it be.
+static bool tokenToHemisphere(const uGnssNmea_t *pNmea, char positive,
+                              char negative, int32_t *pValue)
+{
+    char character = 0;
+    bool success = tokenToCharacter(pNmea, &character) &&
+                   ((character == positive) || (character == negative));
+
+    if (success && (character == negative)) {
+        *pValue = -*pValue;
+    }
+
+    return success;
+}
+
+/* ----------------------------------------------------------------
+ * STATIC FUNCTIONS: SENTENCES
+ * -------------------------------------------------------------- */
+
+// Decode a field of a GGA sentence.
+static bool ggaField(const uGnssNmea_t *pNmea, size_t field, uGnssNmeaGga_t *pGga)
+{
+    bool success = false;
+
+    switch (field) {
+        case 0:
+            success = tokenToTimeMs(pNmea, &pGga->timeMs);
+            break;
+        case 1:
+            success = tokenToDegreesX1e7(pNmea, &pGga->latitudeX1e7);
+            break;
+        case 2:
+            success = tokenToHemisphere(pNmea, 'N', 'S', &pGga->latitudeX1e7);
+            break;
+        case 3:
+            success = tokenToDegreesX1e7(pNmea, &pGga->longitudeX1e7);
+            break;
+        case 4:
+            success = tokenToHemisphere(pNmea, 'E', 'W', &pGga->longitudeX1e7);
+            break;
+        case 5:
+            success = tokenToUint8(pNmea, &pGga->quality);
+            break;
+        case 6:
+            success = tokenToUint8(pNmea, &pGga->numSv);
+            break;
+        case 7:
+            success = tokenToUint16(pNmea, 2, &pGga->hdopX100);
+            break;
+        case 8:
+            success = tokenToInt32(pNmea, 3, &pGga->altitudeMillimetres);
+            break;
+        case 10:
+            success = tokenToInt32(pNmea, 3, &pGga->separationMillimetres);
+            break;
+        case 12:
+            success = tokenToInt32(pNmea, 3, &pGga->diffAgeMs);
+            break;
+        case 13:
+            success = tokenToUint16(pNmea, 0, &pGga->diffStation);
+            break;
+        case 9:
+        case 11:
+            // The units fields, always "M"
+            success = (pNmea->length == 1);
+            break;
+        default:
+            break;
+    }
+
+    return success;
+}
+
+// Decode a field of an RMC sentence.
+static bool rmcField(const uGnssNmea_t *pNmea, size_t field, uGnssNmeaRmc_t *pRmc)
+{
+    bool success = false;
+
+    switch (field) {
+        case 0:
+            success = tokenToTimeMs(pNmea, &pRmc->timeMs);
+            break;
+        case 1:
+            success = tokenToCharacter(pNmea, &pRmc->status);
+            break;
+        case 2:
+            success = tokenToDegreesX1e7(pNmea, &pRmc->latitudeX1e7);
+            break;
+        case 3:
+            success = tokenToHemisphere(pNmea, 'N', 'S', &pRmc->latitudeX1e7);
+            break;
+        case 4:
+            success = tokenToDegreesX1e7(pNmea, &pRmc->longitudeX1e7);
+            break;
+        case 5:
+            success = tokenToHemisphere(pNmea, 'E', 'W', &pRmc->longitudeX1e7);
+            break;
+        case 6:
+            success = tokenToInt32(pNmea, 3, &pRmc->speedKnotsX1000);
+            break;
+        case 7:
+            success = tokenToInt32(pNmea, 2, &pRmc->courseX100);
+            break;
+        case 8:
+            success = tokenToDate(pNmea, &pRmc->day, &pRmc->month, &pRmc->year);
+            break;
+        case 9:
+            success = tokenToInt32(pNmea, 2, &pRmc->magneticVariationX100);
+            break;
+        case 10:
+            success = tokenToHemisphere(pNmea, 'E', 'W', &pRmc->magneticVariationX100);
+            break;
+        case 11:
+            success = tokenToCharacter(pNmea, &pRmc->posMode);
+            break;
+        case 12:
+            success = tokenToCharacter(pNmea, &pRmc->navStatus);
+            break;
+        default:
+            break;
+    }
+
+    return success;
+}
+
+// Decode a field of a GSA sentence.
+static bool gsaField(const uGnssNmea_t *pNmea, size_t field, uGnssNmeaGsa_t *pGsa)
+{
+    bool success = false;
+
+    switch (field) {
+        case 0:
+            success = tokenToCharacter(pNmea, &pGsa->opMode);
+            break;
+        case 1:
+            success = tokenToUint8(pNmea, &pGsa->navMode);
+            break;
+        case 14:
+            success = tokenToUint16(pNmea, 2, &pGsa->pdopX100);
+            break;
+        case 15:
+            success = tokenToUint16(pNmea, 2, &pGsa->hdopX100);
+            break;
+        case 16:
+            success = tokenToUint16(pNmea, 2, &pGsa->vdopX100);
+            break;
+        case 17:
+            success = tokenToUint8(pNmea, &pGsa->systemId);
+            break;
+        default:
+            if ((field >= 2) && (field < 2 + U_GNSS_NMEA_GSA_SV_MAX_NUM)) {
+                success = tokenToUint8(pNmea, &(pGsa->svId[pGsa->numSv]));
+                if (success) {
+                    pGsa->numSv++;
+                }
+            }
+            break;
+    }
+
+    return success;
+}
+
+// Decode a field of a GSV sentence; the last field may turn out
+// to be the signal ID, rather than a satellite ID, that is sorted
+// out by sentenceEnd().
+static bool gsvField(const uGnssNmea_t *pNmea, size_t field, uGnssNmeaGsv_t *pGsv)
+{
+    bool success = false;
+    uGnssNmeaGsvSat_t *pSat;
+
+    switch (field) {
+        case 0:
+            success = tokenToUint8(pNmea, &pGsv->numMsg);
+            break;
+        case 1:
+            success = tokenToUint8(pNmea, &pGsv->msgNum);
+            break;
+        case 2:
+            success = tokenToUint8(pNmea, &pGsv->numSvInView);
+            break;
+        default:
+            if (field < 3 + (U_GNSS_NMEA_GSV_SAT_MAX_NUM * 4)) {
+                pSat = &(pGsv->sat[(field - 3) / 4]);
+                switch ((field - 3) % 4) {
+                    case 0:
+                        success = tokenToUint8(pNmea, &pSat->svId);
+                        break;
+                    case 1:
+                        success = tokenToInt8(pNmea, &pSat->elevation);
+                        break;
+                    case 2:
+                        success = tokenToUint16(pNmea, 0, &pSat->azimuth);
+                        break;
+                    default:
+                        success = tokenToUint8(pNmea, &pSat->cno);
+                        break;
+                }
+            } else if (field == 3 + (U_GNSS_NMEA_GSV_SAT_MAX_NUM * 4)) {
+                success = tokenToUint8(pNmea, &pGsv->signalId);
+            }
+            break;
+    }
+
+    return success;
+}
+
+// Decode a field of a VTG sentence.
+static bool vtgField(const uGnssNmea_t *pNmea, size_t field, uGnssNmeaVtg_t *pVtg)
+{
+    bool success = false;
+
+    switch (field) {
+        case 0:
+            success = tokenToInt32(pNmea, 2, &pVtg->courseTrueX100);
+            break;
+        case 2:
+            success = tokenToInt32(pNmea, 2, &pVtg->courseMagneticX100);
+            break;
+        case 4:
+            success = tokenToInt32(pNmea, 3, &pVtg->speedKnotsX1000);
+            break;
+        case 6:
+            success = tokenToInt32(pNmea, 3, &pVtg->speedKilometresPerHourX1000);
+            break;
+        case 8:
+            success = tokenToCharacter(pNmea, &pVtg->posMode);
+            break;
+        case 1:
+        case 3:
+        case 5:
+        case 7:
+            // The units fields, "T", "M", "N" and "K"
+            success = (pNmea->length == 1);
+            break;
+        default:
+            break;
+    }
+
+    return success;
+}
+
+// Decode a field of a GST sentence.
+static bool gstField(const uGnssNmea_t *pNmea, size_t field, uGnssNmeaGst_t *pGst)
+{
+    bool success = false;
+
+    switch (field) {
+        case 0:
+            success = tokenToTimeMs(pNmea, &pGst->timeMs);
+            break;
+        case 1:
+            success = tokenToInt32(pNmea, 3, &pGst->rangeRmsMillimetres);
+            break;
+        case 2:
+            success = tokenToInt32(pNmea, 3, &pGst->stdMajorMillimetres);
+            break;
+        case 3:
+            success = tokenToInt32(pNmea, 3, &pGst->stdMinorMillimetres);
+            break;
+        case 4:
+            success = tokenToInt32(pNmea, 2, &pGst->orientationX100);
+            break;
+        case 5:
+            success = tokenToInt32(pNmea, 3, &pGst->stdLatitudeMillimetres);
+            break;
+        case 6:
+            success = tokenToInt32(pNmea, 3, &pGst->stdLongitudeMillimetres);
+            break;
+        case 7:
+            success = tokenToInt32(pNmea, 3, &pGst->stdAltitudeMillimetres);
+            break;
+        default:
+            break;
+    }
+
+    return success;
+}
+
+// Decode a field of a ZDA sentence.
+static bool zdaField(const uGnssNmea_t *pNmea, size_t field, uGnssNmeaZda_t *pZda)
+{
+    bool success = false;
+
+    switch (field) {
+        case 0:
+            success = tokenToTimeMs(pNmea, &pZda->timeMs);
+            break;
+        case 1:
+            success = tokenToUint8(pNmea, &pZda->day);
+            break;
+        case 2:
+            success = tokenToUint8(pNmea, &pZda->month);
+            break;
+        case 3:
+            success = tokenToUint16(pNmea, 0, &pZda->year);
+            break;
+        case 4:
+            success = tokenToInt8(pNmea, &pZda->localZoneHours);
+            break;
+        case 5:
+            success = tokenToUint8(pNmea, &pZda->localZoneMinutes);
+            break;
+        default:
+            break;
+    }
+
+    return success;
+}
+
+// The end of a field: decode the token into the sentence.
+static void fieldEnd(uGnssNmea_t *pNmea)
+{
+    uGnssNmeaSentence_t *pSentence = &(pNmea->sentence);
+    size_t field = pNmea->fieldIndex;
+    bool present = false;
+
+    if ((pNmea->length > 0) && (field < sizeof(pSentence->fieldsPresent) * 8)) {
+        switch (pSentence->type) {
+            case U_GNSS_NMEA_SENTENCE_TYPE_GGA:
+                present = ggaField(pNmea, field, &(pSentence->gga));
+                break;
+            case U_GNSS_NMEA_SENTENCE_TYPE_RMC:
+                present = rmcField(pNmea, field, &(pSentence->rmc));
+                break;
+            case U_GNSS_NMEA_SENTENCE_TYPE_GSA:
+                present = gsaField(pNmea, field, &(pSentence->gsa));
+                break;
+            case U_GNSS_NMEA_SENTENCE_TYPE_GSV:
+                present = gsvField(pNmea, field, &(pSentence->gsv));
+                break;
+            case U_GNSS_NMEA_SENTENCE_TYPE_VTG:
+                present = vtgField(pNmea, field, &(pSentence->vtg));
+                break;
+            case U_GNSS_NMEA_SENTENCE_TYPE_GST:
+                present = gstField(pNmea, field, &(pSentence->gst));
+                break;
+            case U_GNSS_NMEA_SENTENCE_TYPE_ZDA:
+                present = zdaField(pNmea, field, &(pSentence->zda));
+                break;
+            default:
+                break;
+        }
+        if (present) {
+            pSentence->fieldsPresent |= 1UL << field;
+        }
+    }
+    if (pNmea->fieldIndex < UINT8_MAX) {
+        pNmea->fieldIndex++;
+    }
+    tokenReset(pNmea);
+}
+
+// The end of a sentence, with a good checksum: tidy up anything
+// that depended on the number of fields.
+static void sentenceEnd(uGnssNmea_t *pNmea)
+{
+    uGnssNmeaGsv_t *pGsv = &(pNmea->sentence.gsv);
+    size_t numFields = pNmea->fieldIndex;
+    size_t numSat;
+
+    if ((pNmea->sentence.type == U_GNSS_NMEA_SENTENCE_TYPE_GSV) && (numFields > 3)) {
+        numSat = (numFields - 3) / 4;
+        if (numSat > U_GNSS_NMEA_GSV_SAT_MAX_NUM) {
+            numSat = U_GNSS_NMEA_GSV_SAT_MAX_NUM;
+        }
+        pGsv->numSat = (uint8_t) numSat;
+        if (((numFields - 3) % 4 == 1) && (numSat < U_GNSS_NMEA_GSV_SAT_MAX_NUM)) {
+            // An odd field on the end: the signal ID of NMEA 4.10,
+            // which will have been decoded as a satellite ID
+            pGsv->signalId = pGsv->sat[numSat].svId;
+            pGsv->sat[numSat].svId = 0;
+        }
+    }
+}
+
+// Get the value of a hex digit, -1 if it is not one.
+static int32_t hexValue(char character)
+{
+    int32_t value = -1;
+
+    if ((character >= '0') && (character <= '9')) {
+        value = character - '0';
+    } else if ((character >= 'A') && (character <= 'F')) {
+        value = character - 'A' + 10;
+    } else if ((character >= 'a') && (character <= 'f')) {
+        value = character - 'a' + 10;
+    }
+
+    return value;
+}
+
+// Process a character, returning true if it completes a sentence.
+static bool characterProcess(uGnssNmea_t *pNmea, char character)
+{
+    bool complete = false;
+    uGnssNmeaSentence_t *pSentence = &(pNmea->sentence);
+    int32_t hex;
+    size_t x;
+
+    if (character == '$') {
+        // The start of a sentence, wherever we were
+        pNmea->phase = U_GNSS_NMEA_PHASE_ADDRESS;
+        pNmea->checksum = 0;
+        pNmea->count = 1;
+        pNmea->fieldIndex = 0;
+        tokenReset(pNmea);
+        memset(pSentence, 0, sizeof(*pSentence));
+        pSentence->type = U_GNSS_NMEA_SENTENCE_TYPE_NONE;
+    } else {
+        switch (pNmea->phase) {
+            case U_GNSS_NMEA_PHASE_ADDRESS:
+                pNmea->checksum ^= (uint8_t) character;
+                pNmea->count++;
+                if (character == ',') {
+                    pNmea->phase = U_GNSS_NMEA_PHASE_IDLE;
+                    if (pNmea->length == U_GNSS_NMEA_ADDRESS_LENGTH) {
+                        for (x = 0; (x < sizeof(gFormatter) / sizeof(gFormatter[0])) &&
+                             (memcmp(pNmea->formatter, gFormatter[x], sizeof(pNmea->formatter)) != 0); x++) {}
+                        if (x < sizeof(gFormatter) / sizeof(gFormatter[0])) {
+                            pSentence->type = (uGnssNmeaSentenceType_t) x;
+                            pNmea->phase = U_GNSS_NMEA_PHASE_FIELDS;
+                        }
+                    }
+                    tokenReset(pNmea);
+                } else if ((pNmea->length < U_GNSS_NMEA_ADDRESS_LENGTH) &&
+                           (((character >= 'A') && (character <= 'Z')) ||
+                            ((character >= '0') && (character <= '9')))) {
+                    if (pNmea->length < sizeof(pSentence->talker) - 1) {
+                        pSentence->talker[pNmea->length] = character;
+                    } else {
+                        pNmea->formatter[pNmea->length - (sizeof(pSentence->talker) - 1)] = character;
+                    }
+                    pNmea->length++;
+                } else {
+                    // Not a sentence we can decode
+                    pNmea->phase = U_GNSS_NMEA_PHASE_IDLE;
+                }
+                break;
+            case U_GNSS_NMEA_PHASE_FIELDS:
+                pNmea->count++;
+                if ((pNmea->count > U_GNSS_NMEA_SENTENCE_LENGTH_MAX_BYTES) ||
+                    (character == '\r') || (character == '\n')) {
+                    // Too long or no checksum
+                    pNmea->errorCount++;
+                    pNmea->phase = U_GNSS_NMEA_PHASE_IDLE;
+                } else if (character == ',') {
+                    pNmea->checksum ^= (uint8_t) character;
+                    fieldEnd(pNmea);
+                } else if (character == '*') {
+                    fieldEnd(pNmea);
+                    pNmea->phase = U_GNSS_NMEA_PHASE_CHECKSUM_1;
+                } else {
+                    pNmea->checksum ^= (uint8_t) character;
+                    tokenAdd(pNmea, character);
+                }
+                break;
+            case U_GNSS_NMEA_PHASE_CHECKSUM_1:
+                hex = hexValue(character);
+                pNmea->phase = U_GNSS_NMEA_PHASE_IDLE;
+                if (hex >= 0) {
+                    pNmea->checksumReceived = (uint8_t) (hex << 4);
+                    pNmea->phase = U_GNSS_NMEA_PHASE_CHECKSUM_2;
+                } else {
+                    pNmea->errorCount++;
+                }
+                break;
+            case U_GNSS_NMEA_PHASE_CHECKSUM_2:
+                hex = hexValue(character);
+                pNmea->phase = U_GNSS_NMEA_PHASE_IDLE;
+                if ((hex >= 0) && ((pNmea->checksumReceived | hex) == pNmea->checksum)) {
+                    sentenceEnd(pNmea);
+                    complete = true;
+                } else {
+                    pNmea->errorCount++;
+                }
+                break;
+            default:
+                break;
+        }
+    }
+
+    return complete;
+}
+
+/* ----------------------------------------------------------------
+ * PUBLIC FUNCTIONS
+ * -------------------------------------------------------------- */
+
+// Initialise an NMEA decoder.
+int32_t uGnssNmeaInit(uGnssNmea_t *pNmea)
+{
+    int32_t errorCode = (int32_t) U_ERROR_COMMON_INVALID_PARAMETER;
+
+    if (pNmea != NULL) {
+        memset(pNmea, 0, sizeof(*pNmea));
+        pNmea->phase = U_GNSS_NMEA_PHASE_IDLE;
+        pNmea->sentence.type = U_GNSS_NMEA_SENTENCE_TYPE_NONE;
+        errorCode = (int32_t) U_ERROR_COMMON_SUCCESS;
+    }
+
+    return errorCode;
+}
+
+// Feed data to an NMEA decoder.
+int32_t uGnssNmeaFeed(uGnssNmea_t *pNmea, const char *pData,
+                      size_t length, uGnssNmeaSentence_t *pSentence)
+{
+    int32_t errorCodeOrLength = (int32_t) U_ERROR_COMMON_INVALID_PARAMETER;
+    bool complete = false;
+    size_t x = 0;
+    const char *pStart;
+
+    if ((pNmea != NULL) && (pSentence != NULL) && ((pData != NULL) || (length == 0))) {
+        pSentence->type = U_GNSS_NMEA_SENTENCE_TYPE_NONE;
+        while ((x < length) && !complete) {
+            if (pNmea->phase == U_GNSS_NMEA_PHASE_IDLE) {
+                // Nothing matters until the next '$', so skip to it
+                pStart = (const char *) memchr(pData + x, '$', length - x);
+                if (pStart == NULL) {
+                    x = length;
+                    break;
+                }
+                x = pStart - pData;
+            }
+            complete = characterProcess(pNmea, *(pData + x));
+            x++;
+        }
+        if (complete) {
+            *pSentence = pNmea->sentence;
+        }
+        errorCodeOrLength = (int32_t) x;
+    }
+
+    return errorCodeOrLength;
+}
+
+// Decode a single, whole, NMEA sentence.
+int32_t uGnssNmeaDecode(const char *pBuffer, size_t size,
+                        uGnssNmeaSentence_t *pSentence)
+{
+    int32_t errorCode = (int32_t) U_ERROR_COMMON_INVALID_PARAMETER;
+    uGnssNmea_t nmea;
+
+    if ((pBuffer != NULL) && (pSentence != NULL)) {
+        errorCode = (int32_t) U_ERROR_COMMON_NOT_FOUND;
+        pSentence->type = U_GNSS_NMEA_SENTENCE_TYPE_NONE;
+        if ((size > 0) && (*pBuffer == '$')) {
+            uGnssNmeaInit(&nmea);
+            uGnssNmeaFeed(&nmea, pBuffer, size, pSentence);
+            if (pSentence->type != U_GNSS_NMEA_SENTENCE_TYPE_NONE) {
+                errorCode = (int32_t) U_ERROR_COMMON_SUCCESS;
+            }
+        }
+    }
+
+    return errorCode;
+}
+
+// End of file
@@ -76,6 +76,7 @@
 #include "u_gnss_cfg.h"
 #include "u_gnss_cfg_val_key.h"
 #include "u_gnss_cfg_private.h"
+#include "u_gnss_framer.h"
 
 /* ----------------------------------------------------------------
  * COMPILE-TIME MACROS
@@ -282,6 +283,79 @@ static bool rtcmIdMatch(uint16_t rtcmIdActual, uint16_t rtcmIdWanted)
     return (rtcmIdActual == rtcmIdWanted) || (rtcmIdWanted == U_GNSS_RTCM_MESSAGE_ID_ALL);
 }
 
+// Return the key used in the hash table of a message reader index
+// for a UBX or RTCM message ID.
+static uint32_t msgIndexKey(uGnssProtocol_t type, uint16_t id)
+{
+    return (((uint32_t) type) << 16) | id;
+}
+
+// Find the entry for a key in the hash table of a message reader
+// index or, if there is none, the empty entry where it would go;
+// the hash table must not be of zero size.
+static uGnssPrivateMsgIndexEntry_t *pMsgIndexEntry(uGnssPrivateMsgIndex_t *pIndex,
+                                                   uint32_t key)
+{
+    // Fibonacci hashing: the hash table is never more than
+    // half full so this will always find an empty entry
+    size_t x = ((size_t) ((key * 2654435761U) >> 16)) & (pIndex->hashTableSize - 1);
+
+    while ((pIndex->pHashTable[x].pReaders != NULL) &&
+           (pIndex->pHashTable[x].key != key)) {
+        x = (x + 1) & (pIndex->hashTableSize - 1);
+    }
+
+    return &(pIndex->pHashTable[x]);
+}
+
+// Add the readers linked from pReader to those already matched,
+// keeping the matched readers in list order, returning the new
+// number matched.
+static size_t msgIndexCollect(uGnssPrivateMsgIndex_t *pIndex,
+                              size_t numMatched,
+                              uGnssPrivateMsgReader_t *pReader)
+{
+    uGnssPrivateMsgReader_t **ppMatched = pIndex->ppMatched;
+    size_t x;
+
+    while (pReader != NULL) {
+        // Insertion sort: there are rarely more than a few matches
+        x = numMatched;
+        while ((x > 0) && (ppMatched[x - 1]->indexOrder > pReader->indexOrder)) {
+            ppMatched[x] = ppMatched[x - 1];
+            x--;
+        }
+        ppMatched[x] = pReader;
+        numMatched++;
+        pReader = pReader->pNextIndexed;
+    }
+
+    return numMatched;
+}
+
+// Add the readers of the given node of the NMEA trie, and of any
+// nodes below it that match the remainder of pNmea, to those already
+// matched, returning the new number matched.  The recursion is
+// no deeper than U_GNSS_NMEA_MESSAGE_MATCH_LENGTH_CHARACTERS.
+static size_t msgIndexNmeaCollect(uGnssPrivateMsgIndex_t *pIndex,
+                                  size_t numMatched, int32_t node,
+                                  const char *pNmea)
+{
+    uGnssPrivateMsgIndexNode_t *pNodes = pIndex->pNodes;
+
+    // A wanted NMEA ID that ends here matches anything that follows
+    numMatched = msgIndexCollect(pIndex, numMatched, pNodes[node].pReaders);
+    if (*pNmea != 0) {
+        for (int32_t child = pNodes[node].child; child >= 0; child = pNodes[child].sibling) {
+            if ((pNodes[child].character == '?') || (pNodes[child].character == *pNmea)) {
+                numMatched = msgIndexNmeaCollect(pIndex, numMatched, child, pNmea + 1);
+            }
+        }
+    }
+
+    return numMatched;
+}
+
 #ifdef U_GNSS_PRIVATE_DEBUG_PARSING
 // Print out a message ID, only used when debugging message parsing.
 static void printId(uGnssPrivateMessageId_t *pId)
@@ -304,6 +378,25 @@ static void printId(uGnssPrivateMessageId_t *pId)
  * STATIC FUNCTIONS: STREAMING TRANSPORT ONLY
  * -------------------------------------------------------------- */
 
+// Callback for the "data received" event of a UART, set by
+// uGnssPrivateStreamDataEventSet(); pParam is the semaphore to give.
+static void dataEventCallbackUart(int32_t uartHandle, uint32_t eventBitmask,
+                                  void *pParam)
+{
+    (void) uartHandle;
+    (void) eventBitmask;
+    uPortSemaphoreGive((uPortSemaphoreHandle_t) pParam);
+}
+
+// As dataEventCallbackUart() but for a virtual serial device.
+static void dataEventCallbackDeviceSerial(struct uDeviceSerial_t *pDeviceSerial,
+                                          uint32_t eventBitmask, void *pParam)
+{
+    (void) pDeviceSerial;
+    (void) eventBitmask;
+    uPortSemaphoreGive((uPortSemaphoreHandle_t) pParam);
+}
+
 // Read or peek-at the data in the internal ring buffer.
 static int32_t streamGetFromRingBuffer(uGnssPrivateInstance_t *pInstance,
                                        int32_t readHandle,
@@ -737,255 +830,47 @@ static int32_t sendReceiveUbxMessage(uGnssPrivateInstance_t *pInstance,
  * STATIC FUNCTIONS: MESSAGE PARSERS
  * -------------------------------------------------------------- */
 
-/** UBX Parser function.
+/** Block parser function, see U_RING_BUFFER_BLOCK_PARSER_f, which
+ * hands the candidate to the framer and converts what it finds
+ * into a #uGnssPrivateMessageId_t.
  *
- * @param parseHandle    the parse handle of the ring buffer to read from.
- * @param[in] pUserParam the user parameter passed to uRingBufferParseHandle().
- * @return               negative error or success code.
+ * @param[in,out] pState the #uGnssFramer_t state of the parser.
+ * @param[in] pData      the next block of data.
+ * @param length         the number of bytes at pData.
+ * @param[out] pUserParam the #uGnssPrivateMessageId_t to populate
+ *                       when a message is complete.
+ * @return               the number of bytes of pData that completed
+ *                       a message or negative error code.
  */
-static int32_t parseUbx(uParseHandle_t parseHandle, void *pUserParam)
+static int32_t parseFrame(void *pState, const char *pData, size_t length,
+                          void *pUserParam)
 {
+    int32_t errorCodeOrLength;
     uGnssPrivateMessageId_t *pMsgId = (uGnssPrivateMessageId_t *) pUserParam;
-    uint8_t by = 0;
-    if (!uRingBufferGetByteUnprotected(parseHandle, &by)) {
-        return U_ERROR_COMMON_TIMEOUT;
-    }
-    if (0xB5 != by) {
-        return U_ERROR_COMMON_NOT_FOUND;    // = µ, 0xB5
-    }
-    if (!uRingBufferGetByteUnprotected(parseHandle, &by)) {
-        return U_ERROR_COMMON_TIMEOUT;
-    }
-    if (0x62 != by) {
-        return U_ERROR_COMMON_NOT_FOUND;    // = b
-    }
-    if (4 > uRingBufferBytesAvailableUnprotected(parseHandle)) {
-        return U_ERROR_COMMON_TIMEOUT;
-    }
-    uint8_t ckb = 0;
-    uint8_t cka = 0;
-    uint8_t cls, id;
-    uRingBufferGetByteUnprotected(parseHandle, &cls); // cls
-    cka += cls;
-    ckb += cka;
-    uRingBufferGetByteUnprotected(parseHandle, &id); // id
-    cka += id;
-    ckb += cka;
-    pMsgId->id.ubx = (uint16_t) ((((uint16_t) cls) << 8) + id);
-    uRingBufferGetByteUnprotected(parseHandle, &by); // len low
-    cka += by;
-    ckb += cka;
-    uint16_t l = by;
-    uRingBufferGetByteUnprotected(parseHandle, &by); // len high
-    cka += by;
-    ckb += cka;
-    l += (((uint16_t) by) << 8);
-    if (l > uRingBufferBytesAvailableUnprotected(parseHandle)) {
-        return U_ERROR_COMMON_TIMEOUT;
-    }
-    while (l --) {
-        uRingBufferGetByteUnprotected(parseHandle, &by);
-        cka += by;
-        ckb += cka;
-    }
-    cka = cka & 0xFF;
-    ckb = ckb & 0xFF;
-    if (!uRingBufferGetByteUnprotected(parseHandle, &by)) {
-        return U_ERROR_COMMON_TIMEOUT;
-    }
-    if (by != cka) {
-        return U_ERROR_COMMON_NOT_FOUND;
-    }
-    if (!uRingBufferGetByteUnprotected(parseHandle, &by)) {
-        return U_ERROR_COMMON_TIMEOUT;
-    }
-    if (by != ckb) {
-        return U_ERROR_COMMON_NOT_FOUND;
-    }
-    // We can only claim this as a UBX-format message if
-    // there was nothing that needed discarding first.
-    if (uRingBufferBytesDiscardUnprotected(parseHandle) == 0) {
-        pMsgId->type = U_GNSS_PROTOCOL_UBX;
-    }
-    return U_ERROR_COMMON_SUCCESS;
-}
-
-/** NMEA Parser function.
- *
- * @param parseHandle    the parse handle of the ring buffer to read from.
- * @param[in] pUserParam the user parameter passed to uRingBufferParseHandle().
- * @return               negative error or success code.
- */
-static int32_t parseNmea(uParseHandle_t parseHandle, void *pUserParam)
-{
-    uGnssPrivateMessageId_t *pMsgId = (uGnssPrivateMessageId_t *) pUserParam;
-    char ch = 0;
-    const char *hex = "0123456789ABCDEF";
-    if (!uRingBufferGetByteUnprotected(parseHandle, &ch)) {
-        return U_ERROR_COMMON_TIMEOUT;
-    }
-    if ('$' != ch) {
-        return U_ERROR_COMMON_NOT_FOUND;
-    }
-    char crc = 0;
-    int i = 0;
-    while (uRingBufferGetByteUnprotected(parseHandle, &ch)) {
-        crc ^= ch;
-        if (',' == ch) {
-            break;
-        }
-        if (i >= U_GNSS_NMEA_MESSAGE_MATCH_LENGTH_CHARACTERS) {
-            return U_ERROR_COMMON_NOT_FOUND;
-        }
-        if (('0' > ch) || ('Z' < ch) || (('9' < ch) && ('A' > ch))) {
-            return U_ERROR_COMMON_NOT_FOUND;    // A-Z, 0-9
-        }
-        pMsgId->id.nmea[i++] = ch;
-    }
-    pMsgId->id.nmea[i] = '\0';
-    while (uRingBufferGetByteUnprotected(parseHandle, &ch)) {
-        if ((' ' > ch) || ('~' < ch)) {
-            return U_ERROR_COMMON_NOT_FOUND;    // not in printable range 32 - 126
-        }
-        if ('*' == ch) {
-            break;    // *
+    uGnssFramerFrame_t frame;
+
+    errorCodeOrLength = uGnssFramerParseBlock(pState, pData, length, &frame);
+    if (errorCodeOrLength > 0) {
+        // The protocol values of the framer match uGnssProtocol_t
+        pMsgId->type = (uGnssProtocol_t) frame.protocol;
+        switch (frame.protocol) {
+            case U_GNSS_FRAMER_PROTOCOL_UBX:
+                pMsgId->id.ubx = frame.id.ubx;
+                break;
+            case U_GNSS_FRAMER_PROTOCOL_NMEA:
+                memcpy(pMsgId->id.nmea, frame.id.nmea, sizeof(pMsgId->id.nmea));
+                break;
+            case U_GNSS_FRAMER_PROTOCOL_RTCM:
+                pMsgId->id.rtcm = frame.id.rtcm;
+                break;
+            default:
+                // Not expected since SPARTN is not in the sync bytes
+                errorCodeOrLength = (int32_t) U_ERROR_COMMON_NOT_FOUND;
+                break;
         }
-        crc ^= ch;
-    }
-    if (!uRingBufferGetByteUnprotected(parseHandle, &ch)) {
-        return U_ERROR_COMMON_TIMEOUT;
-    }
-    if (hex[(crc >> 4) & 0xF] != ch) {
-        return U_ERROR_COMMON_NOT_FOUND;
-    }
-    if (!uRingBufferGetByteUnprotected(parseHandle, &ch)) {
-        return U_ERROR_COMMON_TIMEOUT;
     }
-    if (hex[crc & 0xF] != ch) {
-        return U_ERROR_COMMON_NOT_FOUND;
-    }
-    if (!uRingBufferGetByteUnprotected(parseHandle, &ch)) {
-        return U_ERROR_COMMON_TIMEOUT;
-    }
-    if ('\r' != ch) {
-        return U_ERROR_COMMON_NOT_FOUND;
-    }
-    if (!uRingBufferGetByteUnprotected(parseHandle, &ch)) {
-        return U_ERROR_COMMON_TIMEOUT;
-    }
-    if ('\n' != ch) {
-        return U_ERROR_COMMON_NOT_FOUND;
-    }
-    // We can only claim this as an NMEA-format message if
-    // there was nothing that needed discarding first.
-    if (uRingBufferBytesDiscardUnprotected(parseHandle) == 0) {
-        pMsgId->type = U_GNSS_PROTOCOL_NMEA;
-    }
-    return U_ERROR_COMMON_SUCCESS;
-}
 
-/** RTCM Parser function.
- *
- * @param parseHandle    the parse handle of the ring buffer to read from.
- * @param[in] pUserParam the user parameter passed to uRingBufferParseHandle().
- * @return               negative error or success code.
- */
-static int32_t parseRtcm(uParseHandle_t parseHandle, void *pUserParam)
-{
-    uGnssPrivateMessageId_t *pMsgId = (uGnssPrivateMessageId_t *) pUserParam;
-    uint8_t by;
-    uint32_t crc = 0;
-    if (!uRingBufferGetByteUnprotected(parseHandle, &by)) {
-        return U_ERROR_COMMON_TIMEOUT;
-    }
-    if (0xD3 != by) {
-        return U_ERROR_COMMON_NOT_FOUND;
-    }
-    // CRC24Q check
-    const uint32_t _crc24qTable[] = {
-        /* 00 */ 0x000000, 0x864cfb, 0x8ad50d, 0x0c99f6, 0x93e6e1, 0x15aa1a, 0x1933ec, 0x9f7f17,
-        /* 08 */ 0xa18139, 0x27cdc2, 0x2b5434, 0xad18cf, 0x3267d8, 0xb42b23, 0xb8b2d5, 0x3efe2e,
-        /* 10 */ 0xc54e89, 0x430272, 0x4f9b84, 0xc9d77f, 0x56a868, 0xd0e493, 0xdc7d65, 0x5a319e,
-        /* 18 */ 0x64cfb0, 0xe2834b, 0xee1abd, 0x685646, 0xf72951, 0x7165aa, 0x7dfc5c, 0xfbb0a7,
-        /* 20 */ 0x0cd1e9, 0x8a9d12, 0x8604e4, 0x00481f, 0x9f3708, 0x197bf3, 0x15e205, 0x93aefe,
-        /* 28 */ 0xad50d0, 0x2b1c2b, 0x2785dd, 0xa1c926, 0x3eb631, 0xb8faca, 0xb4633c, 0x322fc7,
-        /* 30 */ 0xc99f60, 0x4fd39b, 0x434a6d, 0xc50696, 0x5a7981, 0xdc357a, 0xd0ac8c, 0x56e077,
-        /* 38 */ 0x681e59, 0xee52a2, 0xe2cb54, 0x6487af, 0xfbf8b8, 0x7db443, 0x712db5, 0xf7614e,
-        /* 40 */ 0x19a3d2, 0x9fef29, 0x9376df, 0x153a24, 0x8a4533, 0x0c09c8, 0x00903e, 0x86dcc5,
-        /* 48 */ 0xb822eb, 0x3e6e10, 0x32f7e6, 0xb4bb1d, 0x2bc40a, 0xad88f1, 0xa11107, 0x275dfc,
-        /* 50 */ 0xdced5b, 0x5aa1a0, 0x563856, 0xd074ad, 0x4f0bba, 0xc94741, 0xc5deb7, 0x43924c,
-        /* 58 */ 0x7d6c62, 0xfb2099, 0xf7b96f, 0x71f594, 0xee8a83, 0x68c678, 0x645f8e, 0xe21375,
-        /* 60 */ 0x15723b, 0x933ec0, 0x9fa736, 0x19ebcd, 0x8694da, 0x00d821, 0x0c41d7, 0x8a0d2c,
-        /* 68 */ 0xb4f302, 0x32bff9, 0x3e260f, 0xb86af4, 0x2715e3, 0xa15918, 0xadc0ee, 0x2b8c15,
-        /* 70 */ 0xd03cb2, 0x567049, 0x5ae9bf, 0xdca544, 0x43da53, 0xc596a8, 0xc90f5e, 0x4f43a5,
-        /* 78 */ 0x71bd8b, 0xf7f170, 0xfb6886, 0x7d247d, 0xe25b6a, 0x641791, 0x688e67, 0xeec29c,
-        /* 80 */ 0x3347a4, 0xb50b5f, 0xb992a9, 0x3fde52, 0xa0a145, 0x26edbe, 0x2a7448, 0xac38b3,
-        /* 88 */ 0x92c69d, 0x148a66, 0x181390, 0x9e5f6b, 0x01207c, 0x876c87, 0x8bf571, 0x0db98a,
-        /* 90 */ 0xf6092d, 0x7045d6, 0x7cdc20, 0xfa90db, 0x65efcc, 0xe3a337, 0xef3ac1, 0x69763a,
-        /* 98 */ 0x578814, 0xd1c4ef, 0xdd5d19, 0x5b11e2, 0xc46ef5, 0x42220e, 0x4ebbf8, 0xc8f703,
-        /* a0 */ 0x3f964d, 0xb9dab6, 0xb54340, 0x330fbb, 0xac70ac, 0x2a3c57, 0x26a5a1, 0xa0e95a,
-        /* a8 */ 0x9e1774, 0x185b8f, 0x14c279, 0x928e82, 0x0df195, 0x8bbd6e, 0x872498, 0x016863,
-        /* b0 */ 0xfad8c4, 0x7c943f, 0x700dc9, 0xf64132, 0x693e25, 0xef72de, 0xe3eb28, 0x65a7d3,
-        /* b8 */ 0x5b59fd, 0xdd1506, 0xd18cf0, 0x57c00b, 0xc8bf1c, 0x4ef3e7, 0x426a11, 0xc426ea,
-        /* c0 */ 0x2ae476, 0xaca88d, 0xa0317b, 0x267d80, 0xb90297, 0x3f4e6c, 0x33d79a, 0xb59b61,
-        /* c8 */ 0x8b654f, 0x0d29b4, 0x01b042, 0x87fcb9, 0x1883ae, 0x9ecf55, 0x9256a3, 0x141a58,
-        /* d0 */ 0xefaaff, 0x69e604, 0x657ff2, 0xe33309, 0x7c4c1e, 0xfa00e5, 0xf69913, 0x70d5e8,
-        /* d8 */ 0x4e2bc6, 0xc8673d, 0xc4fecb, 0x42b230, 0xddcd27, 0x5b81dc, 0x57182a, 0xd154d1,
-        /* e0 */ 0x26359f, 0xa07964, 0xace092, 0x2aac69, 0xb5d37e, 0x339f85, 0x3f0673, 0xb94a88,
-        /* e8 */ 0x87b4a6, 0x01f85d, 0x0d61ab, 0x8b2d50, 0x145247, 0x921ebc, 0x9e874a, 0x18cbb1,
-        /* f0 */ 0xe37b16, 0x6537ed, 0x69ae1b, 0xefe2e0, 0x709df7, 0xf6d10c, 0xfa48fa, 0x7c0401,
-        /* f8 */ 0x42fa2f, 0xc4b6d4, 0xc82f22, 0x4e63d9, 0xd11cce, 0x575035, 0x5bc9c3, 0xdd8538
-    };
-#define RTCM_CRC(crc, by) (crc << 8) ^ _crc24qTable[(by ^ (crc >> 16)) & 0xff]
-    // CRC is over the entire message, 0xD3 included
-    crc = RTCM_CRC(crc, by);
-    if (!uRingBufferGetByteUnprotected(parseHandle, &by)) {
-        return U_ERROR_COMMON_TIMEOUT;
-    }
-    if ((0xFC & by) != 0) {
-        return U_ERROR_COMMON_NOT_FOUND;
-    }
-    uint16_t l = (uint16_t) ((by & 0x3) << 8);
-    crc = RTCM_CRC(crc, by);
-    if (!uRingBufferGetByteUnprotected(parseHandle, &by)) {
-        return U_ERROR_COMMON_TIMEOUT;
-    }
-    l += by;
-    // Length includes the two-byte message ID and the message
-    // body, i.e. up to the start of the 3-byte CRC, i.e.
-    // the total message length - 6.
-    if (l > uRingBufferBytesAvailableUnprotected(parseHandle) + 3) {
-        return U_ERROR_COMMON_TIMEOUT;
-    }
-    crc = RTCM_CRC(crc, by);
-    uint8_t idLo, idHi;
-    if (!uRingBufferGetByteUnprotected(parseHandle, &idLo)) {
-        return U_ERROR_COMMON_TIMEOUT;
-    }
-    l--;
-    crc = RTCM_CRC(crc, idLo);
-    if (!uRingBufferGetByteUnprotected(parseHandle, &idHi)) {
-        return U_ERROR_COMMON_TIMEOUT;
-    }
-    l--;
-    crc = RTCM_CRC(crc, idHi);
-    pMsgId->id.rtcm = (idHi >> 4) + (uint16_t) (idLo << 4);
-    while (l--) {
-        uRingBufferGetByteUnprotected(parseHandle, &by);
-        crc = RTCM_CRC(crc, by);
-    }
-    // Compare CRC
-    for (int32_t x = 2; (x >= 0) && uRingBufferGetByteUnprotected(parseHandle, &by); x--) {
-        if (by != (uint8_t) (crc >> (8 * x))) {
-            return U_ERROR_COMMON_TIMEOUT;
-        }
-    }
-    // We can only claim this as an RTCM-format message if
-    // there was nothing that needed discarding first.
-    if (uRingBufferBytesDiscardUnprotected(parseHandle) == 0) {
-        pMsgId->type = U_GNSS_PROTOCOL_RTCM;
-    }
-    return U_ERROR_COMMON_SUCCESS;
+    return errorCodeOrLength;
 }
 
 /* ----------------------------------------------------------------
@@ -1760,8 +1645,16 @@ void uGnssPrivateStopMsgReceive(uGnssPrivateInstance_t *pInstance)
     if ((pInstance != NULL) && (pInstance->pMsgReceive != NULL)) {
         pMsgReceive = pInstance->pMsgReceive;
 
-        // Sending the task anything will cause it to exit
+        if (pMsgReceive->dataEventIsSet) {
+            // Stop the transport waking the task before anything goes
+            uGnssPrivateStreamDataEventRemove(pInstance);
+        }
+        // Sending the task anything will cause it to exit, giving the
+        // semaphore in case it is waiting for data to arrive
         uPortQueueSend(pMsgReceive->taskExitQueueHandle, queueItem);
+        if (pMsgReceive->dataEventSemaphoreHandle != NULL) {
+            uPortSemaphoreGive(pMsgReceive->dataEventSemaphoreHandle);
+        }
         U_PORT_MUTEX_LOCK(pMsgReceive->taskRunningMutexHandle);
         U_PORT_MUTEX_UNLOCK(pMsgReceive->taskRunningMutexHandle);
         // Wait for the task to actually exit: the STM32F4 platform
@@ -1775,11 +1668,15 @@ void uGnssPrivateStopMsgReceive(uGnssPrivateInstance_t *pInstance)
             uPortFree(pMsgReceive->pReaderList);
             pMsgReceive->pReaderList = pNext;
         }
+        uPortFree(pMsgReceive->pReaderIndex);
 
         // Free all the other OS resources
         uPortMutexDelete(pMsgReceive->taskRunningMutexHandle);
         uPortQueueDelete(pMsgReceive->taskExitQueueHandle);
         uPortMutexDelete(pMsgReceive->readerMutexHandle);
+        if (pMsgReceive->dataEventSemaphoreHandle != NULL) {
+            uPortSemaphoreDelete(pMsgReceive->dataEventSemaphoreHandle);
+        }
 
         // Pause here to allow the deletions
         // to actually occur in the idle thread,
@@ -1910,6 +1807,178 @@ bool uGnssPrivateMessageIdIsWanted(uGnssPrivateMessageId_t *pMessageId,
     return isWanted;
 }
 
+// Create an index of a list of message readers.
+uGnssPrivateMsgIndex_t *pUGnssPrivateMsgIndexCreate(uGnssPrivateMsgReader_t *pReaderList)
+{
+    uGnssPrivateMsgIndex_t *pIndex = NULL;
+    uGnssPrivateMsgReader_t *pReader;
+    uGnssPrivateMsgIndexEntry_t *pEntry;
+    uGnssPrivateMsgIndexNode_t *pNodes;
+    size_t numReaders = 0;
+    size_t numKeyed = 0;
+    size_t numNodes = 1; // The root
+    size_t hashTableSize = 0;
+    size_t order = 0;
+    uint32_t key;
+    int32_t node;
+    int32_t child;
+    const char *pNmea;
+
+    // Work out how big everything needs to be
+    for (pReader = pReaderList; pReader != NULL; pReader = pReader->pNext) {
+        numReaders++;
+        if ((pReader->privateMessageId.type == U_GNSS_PROTOCOL_UBX) ||
+            (pReader->privateMessageId.type == U_GNSS_PROTOCOL_RTCM)) {
+            numKeyed++;
+        } else if (pReader->privateMessageId.type == U_GNSS_PROTOCOL_NMEA) {
+            numNodes += strlen(pReader->privateMessageId.id.nmea);
+        }
+    }
+    if (numKeyed > 0) {
+        // Keep the hash table no more than half full
+        hashTableSize = 1;
+        while (hashTableSize < numKeyed * 2) {
+            hashTableSize <<= 1;
+        }
+    }
+
+    if (numNodes <= INT16_MAX) {
+        // Everything is pointer-aligned so the arrays can simply follow
+        // on from the index structure in the same block
+        pIndex = (uGnssPrivateMsgIndex_t *) pUPortMalloc(sizeof(uGnssPrivateMsgIndex_t) +
+                                                         (hashTableSize * sizeof(uGnssPrivateMsgIndexEntry_t)) +
+                                                         (numNodes * sizeof(uGnssPrivateMsgIndexNode_t)) +
+                                                         (numReaders * sizeof(uGnssPrivateMsgReader_t *)));
+    }
+    if (pIndex != NULL) {
+        memset(pIndex, 0, sizeof(*pIndex));
+        pIndex->numReaders = numReaders;
+        pIndex->hashTableSize = hashTableSize;
+        pIndex->pHashTable = (uGnssPrivateMsgIndexEntry_t *) (pIndex + 1);
+        memset(pIndex->pHashTable, 0, hashTableSize * sizeof(uGnssPrivateMsgIndexEntry_t));
+        pIndex->pNodes = (uGnssPrivateMsgIndexNode_t *) (pIndex->pHashTable + hashTableSize);
+        pIndex->ppMatched = (uGnssPrivateMsgReader_t **) (pIndex->pNodes + numNodes);
+        pNodes = pIndex->pNodes;
+        pNodes[0].character = 0;
+        pNodes[0].child = -1;
+        pNodes[0].sibling = -1;
+        pNodes[0].pReaders = NULL;
+        pIndex->numNodes = 1;
+
+        // Now put each reader where it belongs; they are added to the
+        // front of each set, uGnssPrivateMsgIndexMatch() sorting them
+        // back into list order
+        for (pReader = pReaderList; pReader != NULL; pReader = pReader->pNext) {
+            pReader->indexOrder = order;
+            order++;
+            pReader->pNextIndexed = NULL;
+            switch (pReader->privateMessageId.type) {
+                case U_GNSS_PROTOCOL_ANY:
+                case U_GNSS_PROTOCOL_ALL:
+                    pReader->pNextIndexed = pIndex->pReadersAll;
+                    pIndex->pReadersAll = pReader;
+                    break;
+                case U_GNSS_PROTOCOL_UNKNOWN:
+                    pReader->pNextIndexed = pIndex->pReadersUnknown;
+                    pIndex->pReadersUnknown = pReader;
+                    break;
+                case U_GNSS_PROTOCOL_UBX:
+                case U_GNSS_PROTOCOL_RTCM:
+                    key = msgIndexKey(pReader->privateMessageId.type,
+                                      (pReader->privateMessageId.type == U_GNSS_PROTOCOL_UBX) ?
+                                      pReader->privateMessageId.id.ubx :
+                                      pReader->privateMessageId.id.rtcm);
+                    pEntry = pMsgIndexEntry(pIndex, key);
+                    pEntry->key = key;
+                    pReader->pNextIndexed = pEntry->pReaders;
+                    pEntry->pReaders = pReader;
+                    break;
+                case U_GNSS_PROTOCOL_NMEA:
+                    // Walk down the trie, adding nodes as necessary
+                    node = 0;
+                    for (pNmea = pReader->privateMessageId.id.nmea; *pNmea != 0; pNmea++) {
+                        child = pNodes[node].child;
+                        while ((child >= 0) && (pNodes[child].character != *pNmea)) {
+                            child = pNodes[child].sibling;
+                        }
+                        if (child < 0) {
+                            child = (int32_t) pIndex->numNodes;
+                            pIndex->numNodes++;
+                            pNodes[child].character = *pNmea;
+                            pNodes[child].child = -1;
+                            pNodes[child].sibling = pNodes[node].child;
+                            pNodes[child].pReaders = NULL;
+                            pNodes[node].child = (int16_t) child;
+                        }
+                        node = child;
+                    }
+                    pReader->pNextIndexed = pNodes[node].pReaders;
+                    pNodes[node].pReaders = pReader;
+                    break;
+                default:
+                    // Nothing else is ever wanted
+                    break;
+            }
+        }
+    }
+
+    return pIndex;
+}
+
+// Find the readers in an index that want a given message ID.
+size_t uGnssPrivateMsgIndexMatch(uGnssPrivateMsgIndex_t *pIndex,
+                                 const uGnssPrivateMessageId_t *pMessageId)
+{
+    size_t numMatched;
+    uint16_t id;
+    uint32_t keys[4];
+    size_t numKeys = 0;
+    bool duplicate;
+
+    numMatched = msgIndexCollect(pIndex, 0, pIndex->pReadersAll);
+    switch (pMessageId->type) {
+        case U_GNSS_PROTOCOL_UNKNOWN:
+            numMatched = msgIndexCollect(pIndex, numMatched, pIndex->pReadersUnknown);
+            break;
+        case U_GNSS_PROTOCOL_UBX:
+            // A wanted UBX message ID may have a wildcard class, ID or both
+            id = pMessageId->id.ubx;
+            keys[0] = msgIndexKey(U_GNSS_PROTOCOL_UBX, id);
+            keys[1] = msgIndexKey(U_GNSS_PROTOCOL_UBX, id | U_GNSS_UBX_MESSAGE_ID_ALL);
+            keys[2] = msgIndexKey(U_GNSS_PROTOCOL_UBX, id | (U_GNSS_UBX_MESSAGE_CLASS_ALL << 8));
+            keys[3] = msgIndexKey(U_GNSS_PROTOCOL_UBX, id | U_GNSS_UBX_MESSAGE_ID_ALL |
+                                  (U_GNSS_UBX_MESSAGE_CLASS_ALL << 8));
+            numKeys = 4;
+            break;
+        case U_GNSS_PROTOCOL_RTCM:
+            keys[0] = msgIndexKey(U_GNSS_PROTOCOL_RTCM, pMessageId->id.rtcm);
+            keys[1] = msgIndexKey(U_GNSS_PROTOCOL_RTCM, U_GNSS_RTCM_MESSAGE_ID_ALL);
+            numKeys = 2;
+            break;
+        case U_GNSS_PROTOCOL_NMEA:
+            numMatched = msgIndexNmeaCollect(pIndex, numMatched, 0, pMessageId->id.nmea);
+            break;
+        default:
+            break;
+    }
+    if (pIndex->hashTableSize > 0) {
+        for (size_t x = 0; x < numKeys; x++) {
+            // A message ID that is itself a wildcard gives the same key
+            // more than once, only look it up once
+            duplicate = false;
+            for (size_t y = 0; (y < x) && !duplicate; y++) {
+                duplicate = (keys[y] == keys[x]);
+            }
+            if (!duplicate) {
+                numMatched = msgIndexCollect(pIndex, numMatched,
+                                             pMsgIndexEntry(pIndex, keys[x])->pReaders);
+            }
+        }
+    }
+
+    return numMatched;
+}
+
 int32_t uGnssPrivateInfoGetVersions(uGnssPrivateInstance_t *pInstance,
                                     uGnssVersionType_t *pVer)
 {
@@ -2064,16 +2133,17 @@ int32_t uGnssPrivateStreamDecodeRingBuffer(uRingBuffer_t *pRingBuffer,
 
     if ((pRingBuffer != NULL) && (pPrivateMessageId != NULL)) {
         while (1) {
-            U_RING_BUFFER_PARSER_f parserList[] = {
-                parseUbx,
-                parseNmea,
-                parseRtcm,
-                NULL
+            // Static as the ring buffer remembers the progress
+            // of the parsers against the list
+            static const uRingBufferBlockParser_t parserList[] = {
+                // The sync bytes of UBX, NMEA and RTCM
+                {parseFrame, "\xb5$\xd3", 3, sizeof(uGnssFramer_t)},
+                {NULL, NULL, 0, 0}
             };
             uGnssPrivateMessageId_t msg;
             memset(&msg, 0, sizeof(msg));
             msg.type = U_GNSS_PROTOCOL_UNKNOWN;
-            errorCodeOrLength = uRingBufferParseHandle(pRingBuffer, readHandle, parserList, &msg);
+            errorCodeOrLength = uRingBufferParseBlockHandle(pRingBuffer, readHandle, parserList, &msg);
             if (errorCodeOrLength <= 0) {
                 break;
             } else if (uGnssPrivateMessageIdIsWanted(&msg, pPrivateMessageId)) {
@@ -2247,6 +2317,72 @@ int32_t uGnssPrivateStreamFillRingBuffer(uGnssPrivateInstance_t *pInstance,
     return errorCodeOrLength;
 }
 
+// Have the streaming transport give a semaphore when data arrives.
+int32_t uGnssPrivateStreamDataEventSet(uGnssPrivateInstance_t *pInstance,
+                                       uPortSemaphoreHandle_t semaphoreHandle,
+                                       size_t stackSizeBytes, int32_t priority)
+{
+    int32_t errorCode = (int32_t) U_ERROR_COMMON_INVALID_PARAMETER;
+    uDeviceSerial_t *pDeviceSerial;
+
+    if ((pInstance != NULL) && (semaphoreHandle != NULL)) {
+        // I2C and SPI have no such event, the GNSS chip has to be polled
+        errorCode = (int32_t) U_ERROR_COMMON_NOT_SUPPORTED;
+        switch (uGnssPrivateGetStreamType(pInstance->transportType)) {
+            case U_GNSS_PRIVATE_STREAM_TYPE_UART:
+                // There can only be one event callback: if someone
+                // else has one then leave well alone
+                errorCode = (int32_t) U_ERROR_COMMON_BUSY;
+                if (uPortUartEventCallbackFilterGet(pInstance->transportHandle.uart) == 0) {
+                    errorCode = uPortUartEventCallbackSet(pInstance->transportHandle.uart,
+                                                          U_PORT_UART_EVENT_BITMASK_DATA_RECEIVED,
+                                                          dataEventCallbackUart,
+                                                          (void *) semaphoreHandle,
+                                                          stackSizeBytes, priority);
+                }
+                break;
+            case U_GNSS_PRIVATE_STREAM_TYPE_VIRTUAL_SERIAL:
+                pDeviceSerial = pInstance->transportHandle.pDeviceSerial;
+                errorCode = (int32_t) U_ERROR_COMMON_BUSY;
+                if ((pDeviceSerial != NULL) &&
+                    (pDeviceSerial->eventCallbackFilterGet(pDeviceSerial) == 0)) {
+                    errorCode = pDeviceSerial->eventCallbackSet(pDeviceSerial,
+                                                                U_DEVICE_SERIAL_EVENT_BITMASK_DATA_RECEIVED,
+                                                                dataEventCallbackDeviceSerial,
+                                                                (void *) semaphoreHandle,
+                                                                stackSizeBytes, priority);
+                }
+                break;
+            default:
+                break;
+        }
+    }
+
+    return errorCode;
+}
+
+// Remove what uGnssPrivateStreamDataEventSet() set.
+void uGnssPrivateStreamDataEventRemove(uGnssPrivateInstance_t *pInstance)
+{
+    uDeviceSerial_t *pDeviceSerial;
+
+    if (pInstance != NULL) {
+        switch (uGnssPrivateGetStreamType(pInstance->transportType)) {
+            case U_GNSS_PRIVATE_STREAM_TYPE_UART:
+                uPortUartEventCallbackRemove(pInstance->transportHandle.uart);
+                break;
+            case U_GNSS_PRIVATE_STREAM_TYPE_VIRTUAL_SERIAL:
+                pDeviceSerial = pInstance->transportHandle.pDeviceSerial;
+                if (pDeviceSerial != NULL) {
+                    pDeviceSerial->eventCallbackRemove(pDeviceSerial);
+                }
+                break;
+            default:
+                break;
+        }
+    }
+}
+
 // Read data from the internal ring buffer into the given linear buffer.
 int32_t uGnssPrivateStreamReadRingBuffer(uGnssPrivateInstance_t *pInstance,
                                          int32_t readHandle,
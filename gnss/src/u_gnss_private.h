@@ -179,10 +179,68 @@ typedef struct uGnssPrivateMsgReader_t {
     void *pCallback; /**< stored as a void * to avoid having to bring
                           all the types of uGnssMsgReceiveCallback_t
                           into everything. */
+    bool isSpanCallback; /**< true if pCallback is a
+                              uGnssMsgReceiveSpanCallback_t,
+                              else it is a uGnssMsgReceiveCallback_t. */
     void *pCallbackParam;
     struct uGnssPrivateMsgReader_t *pNext;
+    size_t indexOrder; /**< the position of this reader in the list,
+                            set by pUGnssPrivateMsgIndexCreate(). */
+    struct uGnssPrivateMsgReader_t *pNextIndexed; /**< the next reader
+                                                       wanting exactly
+                                                       the same message
+                                                       ID, set by
+                                                       pUGnssPrivateMsgIndexCreate(). */
 } uGnssPrivateMsgReader_t;
 
+/** An entry in the hash table of a message reader index, for UBX
+ * and RTCM message IDs.
+ */
+typedef struct {
+    uint32_t key; /**< the protocol type in the upper 16 bits and the
+                       wanted UBX or RTCM message ID, which may include
+                       wildcards, in the lower 16 bits. */
+    uGnssPrivateMsgReader_t *pReaders; /**< the readers that want exactly
+                                            key, linked by pNextIndexed,
+                                            NULL if the entry is empty. */
+} uGnssPrivateMsgIndexEntry_t;
+
+/** A node in the trie of a message reader index, for NMEA message IDs;
+ * node zero is the root.
+ */
+typedef struct {
+    char character; /**< the character at this node, may be '?'. */
+    int16_t child; /**< the index of the first child of this node,
+                        -1 if there is none. */
+    int16_t sibling; /**< the index of the next sibling of this node,
+                          -1 if there is none. */
+    uGnssPrivateMsgReader_t *pReaders; /**< the readers whose wanted NMEA
+                                            ID ends at this node, linked
+                                            by pNextIndexed. */
+} uGnssPrivateMsgIndexNode_t;
+
+/** An index of the readers in a list, built so that the readers
+ * interested in a message can be found without checking every
+ * reader; allocated, along with the arrays it points to, as a single
+ * block by pUGnssPrivateMsgIndexCreate() and hence freed with a single
+ * call to uPortFree().
+ */
+typedef struct {
+    size_t numReaders;
+    uGnssPrivateMsgReader_t *pReadersAll; /**< readers of
+                                               #U_GNSS_PROTOCOL_ANY or
+                                               #U_GNSS_PROTOCOL_ALL. */
+    uGnssPrivateMsgReader_t *pReadersUnknown; /**< readers of
+                                                   #U_GNSS_PROTOCOL_UNKNOWN. */
+    size_t hashTableSize; /**< always a power of two, may be zero. */
+    uGnssPrivateMsgIndexEntry_t *pHashTable;
+    size_t numNodes;
+    uGnssPrivateMsgIndexNode_t *pNodes;
+    uGnssPrivateMsgReader_t **ppMatched; /**< room for numReaders pointers,
+                                              filled in by
+                                              uGnssPrivateMsgIndexMatch(). */
+} uGnssPrivateMsgIndex_t;
+
 /** Structure to hold the data associated with the task running
  * the non-blocking message receive utility functions.
  */
@@ -196,6 +254,16 @@ typedef struct {
     int32_t ringBufferReadHandle;
     size_t msgBytesLeftToRead;
     uGnssPrivateMsgReader_t *pReaderList;
+    uPortSemaphoreHandle_t dataEventSemaphoreHandle; /**< given by the transport
+                                                          when data arrives. */
+    bool dataEventIsSet; /**< true if the transport will give
+                              dataEventSemaphoreHandle, else the task
+                              must poll. */
+    uGnssPrivateMsgIndex_t *pReaderIndex; /**< an index of pReaderList,
+                                               rebuilt whenever it changes;
+                                               NULL if there was not the
+                                               memory, in which case
+                                               pReaderList is searched. */
 } uGnssPrivateMsgReceive_t;
 
 /** Parameters to pass to the streamed position callback.
@@ -568,6 +636,36 @@ int32_t uGnssPrivateMessageIdToPublic(const uGnssPrivateMessageId_t *pPrivateMes
 bool uGnssPrivateMessageIdIsWanted(uGnssPrivateMessageId_t *pMessageId,
                                    uGnssPrivateMessageId_t *pMessageIdWanted);
 
+/** Create an index of a list of message readers, such that the
+ * readers that want a given message ID can be found with
+ * uGnssPrivateMsgIndexMatch() without calling
+ * uGnssPrivateMessageIdIsWanted() for every reader in the list.
+ * The indexOrder and pNextIndexed fields of the readers are
+ * overwritten, so the readers in the list can be in only one index
+ * at a time; the index must be recreated whenever the list changes.
+ *
+ * @param[in] pReaderList the first in a list of readers, may be NULL.
+ * @return                a pointer to the index, which must be freed
+ *                        with uPortFree() when done, or NULL if
+ *                        there was not enough memory.
+ */
+uGnssPrivateMsgIndex_t *pUGnssPrivateMsgIndexCreate(uGnssPrivateMsgReader_t *pReaderList);
+
+/** Find the readers in an index that want a given message ID, i.e.
+ * those for which uGnssPrivateMessageIdIsWanted() would return true.
+ *
+ * @param[in] pIndex     the index, created by
+ *                       pUGnssPrivateMsgIndexCreate(); cannot be NULL.
+ * @param[in] pMessageId the message ID; cannot be NULL.
+ * @return               the number of readers that want the message
+ *                       ID; the readers are put into pIndex->ppMatched
+ *                       in the order they appear in the list the
+ *                       index was created from, where they remain
+ *                       until the next call.
+ */
+size_t uGnssPrivateMsgIndexMatch(uGnssPrivateMsgIndex_t *pIndex,
+                                 const uGnssPrivateMessageId_t *pMessageId);
+
 /** Get the various information from the GNSS chip.
  *
  * @param[in] pInstance  a pointer to the GNSS instance, cannot be NULL.
@@ -636,6 +734,32 @@ int32_t uGnssPrivateStreamGetReceiveSize(uGnssPrivateInstance_t *pInstance);
 int32_t uGnssPrivateStreamFillRingBuffer(uGnssPrivateInstance_t *pInstance,
                                          int32_t timeoutMs, int32_t maxTimeMs);
 
+/** Ask the streaming transport to give the given semaphore whenever
+ * data arrives from the GNSS chip, so that a task may block on the
+ * semaphore rather than polling.  This is only possible for UART
+ * and virtual serial transports and only if no-one else has set
+ * an event callback on the transport already; remove it with
+ * uGnssPrivateStreamDataEventRemove().
+ *
+ * @param[in] pInstance      a pointer to the GNSS instance, cannot be NULL.
+ * @param semaphoreHandle    the semaphore to give.
+ * @param stackSizeBytes     the stack size of the task in which the
+ *                           semaphore is given, must be at least
+ *                           #U_PORT_EVENT_QUEUE_MIN_TASK_STACK_SIZE_BYTES.
+ * @param priority           the priority of that task.
+ * @return                   zero on success else negative error code,
+ *                           in which case the caller will have to poll.
+ */
+int32_t uGnssPrivateStreamDataEventSet(uGnssPrivateInstance_t *pInstance,
+                                       uPortSemaphoreHandle_t semaphoreHandle,
+                                       size_t stackSizeBytes, int32_t priority);
+
+/** Remove the event set by uGnssPrivateStreamDataEventSet().
+ *
+ * @param[in] pInstance  a pointer to the GNSS instance, cannot be NULL.
+ */
+void uGnssPrivateStreamDataEventRemove(uGnssPrivateInstance_t *pInstance);
+
 /** Examine the given ring buffer, for the given read handle, and determine
  * if it contains the given message ID, or even the sniff of a possibility
  * of it.  If a message header is matched the read pointer for the given
@@ -0,0 +1,428 @@
+/*
+ * Copyright 2019-2024 u-blox
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* Only #includes of u_* and the C standard library are allowed here,
+ * no platform stuff and no OS stuff.  Anything required from
+ * the platform/OS must be brought in through u_port* to maintain
+ * portability.
+ */
+
+/** @file
+ * @brief Implementation of the streaming decoder for UBX-RXM-RAWX
+ * and UBX-RXM-SFRBX messages.  The framer finds the messages and
+ * the fields of each are written straight from the message into the
+ * arrays of the epoch that is being built, in the ring supplied by
+ * the caller.
+ */
+
+#ifdef U_CFG_OVERRIDE
+# include "u_cfg_override.h" // For a customer's configuration override
+#endif
+
+#include "stddef.h"    // NULL, size_t etc.
+#include "stdint.h"    // int32_t etc.
+#include "stdbool.h"
+#include "string.h"    // memset(), memcpy()
+
+#include "u_error_common.h"
+
+#include "u_ubx_protocol.h"
+
+#include "u_gnss_type.h"
+#include "u_gnss_framer.h"
+#include "u_gnss_dec_ubx_rxm_rawx.h"
+#include "u_gnss_raw.h"
+
+/* ----------------------------------------------------------------
+ * COMPILE-TIME MACROS
+ * -------------------------------------------------------------- */
+
+/** The message class and ID of UBX-RXM-RAWX, as they appear in
+ * the id of a #uGnssFramerFrame_t.
+ */
+#define U_GNSS_RAW_UBX_RXM_RAWX U_GNSS_UBX_MESSAGE(U_GNSS_DEC_UBX_RXM_RAWX_MESSAGE_CLASS, \
+                                                   U_GNSS_DEC_UBX_RXM_RAWX_MESSAGE_ID)
+
+/** The message class and ID of UBX-RXM-SFRBX, as they appear in
+ * the id of a #uGnssFramerFrame_t.
+ */
+#define U_GNSS_RAW_UBX_RXM_SFRBX U_GNSS_UBX_MESSAGE(U_GNSS_RAW_UBX_RXM_SFRBX_MESSAGE_CLASS, \
+                                                    U_GNSS_RAW_UBX_RXM_SFRBX_MESSAGE_ID)
+
+/** The length of the fixed part of the body of a UBX-RXM-SFRBX
+ * message, before the data words.
+ */
+#define U_GNSS_RAW_UBX_RXM_SFRBX_BODY_MIN_LENGTH 8
+
+/* ----------------------------------------------------------------
+ * TYPES
+ * -------------------------------------------------------------- */
+
+/* ----------------------------------------------------------------
+ * VARIABLES
+ * -------------------------------------------------------------- */
+
+/* ----------------------------------------------------------------
+ * STATIC FUNCTIONS
+ * -------------------------------------------------------------- */
+
+// Decode a U2 from a message body; this and u4Decode()/u8Decode()
+// do what uUbxProtocolUint16Decode() etc. do but, being static,
+// can be inlined into the per-measurement loop, where the function
+// call would otherwise cost more than the decode.
+static uint16_t u2Decode(const char *pByte)
+{
+    const uint8_t *pInput = (const uint8_t *) pByte;
+
+    return (uint16_t) (pInput[0] | (((uint16_t) pInput[1]) << 8));
+}
+
+// Decode a U4 from a message body.
+static uint32_t u4Decode(const char *pByte)
+{
+    const uint8_t *pInput = (const uint8_t *) pByte;
+
+    return ((uint32_t) pInput[0]) | (((uint32_t) pInput[1]) << 8) |
+           (((uint32_t) pInput[2]) << 16) | (((uint32_t) pInput[3]) << 24);
+}
+
+// Decode a U8 from a message body.
+static uint64_t u8Decode(const char *pByte)
+{
+    return ((uint64_t) u4Decode(pByte)) | (((uint64_t) u4Decode(pByte + 4)) << 32);
+}
+
+// Decode an R8 from a message body.
+static double r8Decode(const char *pByte)
+{
+    uint64_t uint64 = u8Decode(pByte);
+    double real;
+
+    memcpy(&real, &uint64, sizeof(real));
+
+    return real;
+}
+
+// Decode an R4 from a message body.
+static float r4Decode(const char *pByte)
+{
+    uint32_t uint32 = u4Decode(pByte);
+    float real;
+
+    memcpy(&real, &uint32, sizeof(real));
+
+    return real;
+}
+
+// Get the epoch that is being built, beginning it if need be,
+// NULL if the ring is full.
+static uGnssRawEpoch_t *pEpochBuilding(uGnssRaw_t *pRaw)
+{
+    uGnssRawEpoch_t *pEpoch = NULL;
+
+    if (pRaw->numComplete < pRaw->numEpochs) {
+        pEpoch = pRaw->pEpoch + ((pRaw->readIndex + pRaw->numComplete) % pRaw->numEpochs);
+        if (!pRaw->building) {
+            // Only the counts need to be reset, nothing beyond
+            // them is ever read
+            pEpoch->numMeas = 0;
+            pEpoch->numSubframes = 0;
+            pRaw->building = true;
+        }
+    }
+
+    return pEpoch;
+}
+
+// Complete the epoch that is being built.
+static void epochComplete(uGnssRaw_t *pRaw)
+{
+    pRaw->numComplete++;
+    pRaw->building = false;
+}
+
+// Decode the body of a UBX-RXM-RAWX message, completing an epoch.
+static int32_t rawxDecode(uGnssRaw_t *pRaw, const char *pBody, size_t length)
+{
+    int32_t errorCode = (int32_t) U_ERROR_COMMON_TRUNCATED;
+    uGnssRawEpoch_t *pEpoch;
+    size_t numMeas;
+    const char *pBlock;
+
+    if (length >= U_GNSS_DEC_UBX_RXM_RAWX_BODY_MIN_LENGTH) {
+        numMeas = (uint8_t) pBody[11];
+        if (U_GNSS_DEC_UBX_RXM_RAWX_BODY_MIN_LENGTH +
+            (numMeas * U_GNSS_DEC_UBX_RXM_RAWX_BLOCK_LENGTH) <= length) {
+            errorCode = (int32_t) U_ERROR_COMMON_SUCCESS;
+            pRaw->stats.rawxCount++;
+            pEpoch = pEpochBuilding(pRaw);
+            if (pEpoch != NULL) {
+                pEpoch->rcvTow = r8Decode(pBody);
+                pEpoch->week = u2Decode(pBody + 8);
+                pEpoch->leapS = (int8_t) pBody[10];
+                pEpoch->recStat = (uint8_t) pBody[12];
+                if (numMeas > U_GNSS_RAW_MEAS_MAX_NUM) {
+                    pRaw->stats.measDropped += numMeas - U_GNSS_RAW_MEAS_MAX_NUM;
+                    numMeas = U_GNSS_RAW_MEAS_MAX_NUM;
+                }
+                pBlock = pBody + U_GNSS_DEC_UBX_RXM_RAWX_BODY_MIN_LENGTH;
+                for (size_t x = 0; x < numMeas; x++) {
+                    pEpoch->prMes[x] = r8Decode(pBlock);
+                    pEpoch->cpMes[x] = r8Decode(pBlock + 8);
+                    pEpoch->doMes[x] = r4Decode(pBlock + 16);
+                    pEpoch->gnssId[x] = (uint8_t) pBlock[20];
+                    pEpoch->svId[x] = (uint8_t) pBlock[21];
+                    pEpoch->sigId[x] = (uint8_t) pBlock[22];
+                    pEpoch->freqId[x] = (uint8_t) pBlock[23];
+                    pEpoch->locktime[x] = u2Decode(pBlock + 24);
+                    pEpoch->cno[x] = (uint8_t) pBlock[26];
+                    pEpoch->prStdev[x] = (uint8_t) pBlock[27] & 0x0f;
+                    pEpoch->cpStdev[x] = (uint8_t) pBlock[28] & 0x0f;
+                    pEpoch->doStdev[x] = (uint8_t) pBlock[29] & 0x0f;
+                    pEpoch->trkStat[x] = (uint8_t) pBlock[30];
+                    pBlock += U_GNSS_DEC_UBX_RXM_RAWX_BLOCK_LENGTH;
+                }
+                pEpoch->numMeas = (uint8_t) numMeas;
+                epochComplete(pRaw);
+            } else {
+                pRaw->stats.epochsDropped++;
+            }
+        }
+    }
+    if (errorCode != 0) {
+        pRaw->stats.badCount++;
+    }
+
+    return errorCode;
+}
+
+// Decode the body of a UBX-RXM-SFRBX message into the epoch
+// that is being built.
+static int32_t sfrbxDecode(uGnssRaw_t *pRaw, const char *pBody, size_t length)
+{
+    int32_t errorCode = (int32_t) U_ERROR_COMMON_TRUNCATED;
+    uGnssRawEpoch_t *pEpoch;
+    size_t numWords;
+    size_t x;
+
+    if (length >= U_GNSS_RAW_UBX_RXM_SFRBX_BODY_MIN_LENGTH) {
+        numWords = (uint8_t) pBody[4];
+        if (U_GNSS_RAW_UBX_RXM_SFRBX_BODY_MIN_LENGTH + (numWords * 4) <= length) {
+            errorCode = (int32_t) U_ERROR_COMMON_SUCCESS;
+            pRaw->stats.sfrbxCount++;
+            pEpoch = pEpochBuilding(pRaw);
+            if ((pEpoch != NULL) && (pEpoch->numSubframes < U_GNSS_RAW_SUBFRAMES_MAX_NUM)) {
+                x = pEpoch->numSubframes;
+                pEpoch->sfGnssId[x] = (uint8_t) pBody[0];
+                pEpoch->sfSvId[x] = (uint8_t) pBody[1];
+                pEpoch->sfSigId[x] = (uint8_t) pBody[2];
+                pEpoch->sfFreqId[x] = (uint8_t) pBody[3];
+                pEpoch->sfChn[x] = (uint8_t) pBody[5];
+                if (numWords > U_GNSS_RAW_SUBFRAME_WORDS_MAX_NUM) {
+                    numWords = U_GNSS_RAW_SUBFRAME_WORDS_MAX_NUM;
+                }
+                pEpoch->sfNumWords[x] = (uint8_t) numWords;
+                pBody += U_GNSS_RAW_UBX_RXM_SFRBX_BODY_MIN_LENGTH;
+                for (size_t y = 0; y < numWords; y++) {
+                    pEpoch->sfDwrd[x][y] = u4Decode(pBody);
+                    pBody += 4;
+                }
+                pEpoch->numSubframes++;
+            } else {
+                pRaw->stats.subframesDropped++;
+            }
+        }
+    }
+    if (errorCode != 0) {
+        pRaw->stats.badCount++;
+    }
+
+    return errorCode;
+}
+
+// Decode a UBX message of the given ID, with the body of the
+// given length starting at pBody.
+static int32_t messageDecode(uGnssRaw_t *pRaw, uint16_t id,
+                             const char *pBody, size_t length)
+{
+    int32_t errorCode = (int32_t) U_ERROR_COMMON_SUCCESS;
+
+    switch (id) {
+        case U_GNSS_RAW_UBX_RXM_RAWX:
+            errorCode = rawxDecode(pRaw, pBody, length);
+            break;
+        case U_GNSS_RAW_UBX_RXM_SFRBX:
+            errorCode = sfrbxDecode(pRaw, pBody, length);
+            break;
+        default:
+            break;
+    }
+
+    return errorCode;
+}
+
+// Decode a frame from the framer.
+static void frameDecode(uGnssRaw_t *pRaw, const uGnssFramerFrame_t *pFrame)
+{
+    if ((pFrame->protocol == U_GNSS_FRAMER_PROTOCOL_UBX) &&
+        ((pFrame->id.ubx == U_GNSS_RAW_UBX_RXM_RAWX) ||
+         (pFrame->id.ubx == U_GNSS_RAW_UBX_RXM_SFRBX))) {
+        if (pFrame->pData != NULL) {
+            messageDecode(pRaw, pFrame->id.ubx,
+                          pFrame->pData + U_UBX_PROTOCOL_HEADER_LENGTH_BYTES,
+                          pFrame->length - U_UBX_PROTOCOL_OVERHEAD_LENGTH_BYTES);
+        } else {
+            // Split across calls and too long for the buffer
+            pRaw->stats.badCount++;
+        }
+    }
+}
+
+/* ----------------------------------------------------------------
+ * PUBLIC FUNCTIONS
+ * -------------------------------------------------------------- */
+
+// Initialise a decoder.
+int32_t uGnssRawInit(uGnssRaw_t *pRaw, uGnssRawEpoch_t *pEpochs,
+                     size_t numEpochs, char *pBuffer, size_t bufferSize)
+{
+    int32_t errorCode = (int32_t) U_ERROR_COMMON_INVALID_PARAMETER;
+
+    if ((pRaw != NULL) && (pEpochs != NULL) && (numEpochs > 0)) {
+        memset(pRaw, 0, sizeof(*pRaw));
+        pRaw->pEpoch = pEpochs;
+        pRaw->numEpochs = numEpochs;
+        errorCode = uGnssFramerInit(&(pRaw->framer),
+                                    U_GNSS_FRAMER_PROTOCOL_BIT(U_GNSS_FRAMER_PROTOCOL_UBX),
+                                    pBuffer, bufferSize);
+    }
+
+    return errorCode;
+}
+
+// Feed a stream of data to a decoder.
+int32_t uGnssRawFeed(uGnssRaw_t *pRaw, const char *pData, size_t length)
+{
+    int32_t errorCodeOrCount = (int32_t) U_ERROR_COMMON_INVALID_PARAMETER;
+    uGnssFramerFrame_t frame;
+
+    if ((pRaw != NULL) && ((pData != NULL) || (length == 0))) {
+        do {
+            errorCodeOrCount = uGnssFramerFeed(&(pRaw->framer), pData, length, &frame);
+            if (errorCodeOrCount >= 0) {
+                frameDecode(pRaw, &frame);
+                pData += errorCodeOrCount;
+                length -= errorCodeOrCount;
+            }
+        } while ((errorCodeOrCount >= 0) &&
+                 ((length > 0) || (frame.protocol != U_GNSS_FRAMER_PROTOCOL_NONE)));
+        if (errorCodeOrCount >= 0) {
+            errorCodeOrCount = (int32_t) pRaw->numComplete;
+        }
+    }
+
+    return errorCodeOrCount;
+}
+
+// Decode a single, whole, UBX message.
+int32_t uGnssRawDecode(uGnssRaw_t *pRaw, const char *pMessage, size_t size)
+{
+    int32_t errorCodeOrCount = (int32_t) U_ERROR_COMMON_INVALID_PARAMETER;
+    size_t length;
+
+    if ((pRaw != NULL) && (pMessage != NULL) &&
+        ((size < 2) || (((uint8_t) pMessage[0] == 0xb5) && ((uint8_t) pMessage[1] == 0x62)))) {
+        errorCodeOrCount = (int32_t) U_ERROR_COMMON_TRUNCATED;
+        if (size >= U_UBX_PROTOCOL_HEADER_LENGTH_BYTES) {
+            length = uUbxProtocolUint16Decode(pMessage + 4);
+            if (length <= size - U_UBX_PROTOCOL_HEADER_LENGTH_BYTES) {
+                errorCodeOrCount = messageDecode(pRaw,
+                                                 U_GNSS_UBX_MESSAGE((uint8_t) pMessage[2],
+                                                                    (uint8_t) pMessage[3]),
+                                                 pMessage + U_UBX_PROTOCOL_HEADER_LENGTH_BYTES,
+                                                 length);
+            }
+        }
+        if (errorCodeOrCount == 0) {
+            errorCodeOrCount = (int32_t) pRaw->numComplete;
+        }
+    }
+
+    return errorCodeOrCount;
+}
+
+// Tell a decoder that the data has ended.
+int32_t uGnssRawFlush(uGnssRaw_t *pRaw)
+{
+    int32_t errorCodeOrCount = (int32_t) U_ERROR_COMMON_INVALID_PARAMETER;
+    uGnssFramerFrame_t frame;
+    uGnssRawEpoch_t *pEpoch;
+
+    if (pRaw != NULL) {
+        do {
+            errorCodeOrCount = uGnssFramerFlush(&(pRaw->framer), &frame);
+            if (errorCodeOrCount == 0) {
+                frameDecode(pRaw, &frame);
+            }
+        } while ((errorCodeOrCount == 0) && (frame.protocol != U_GNSS_FRAMER_PROTOCOL_NONE));
+        if (errorCodeOrCount == 0) {
+            if (pRaw->building) {
+                // Subframes with no epoch: complete them as an
+                // epoch with no measurements
+                pEpoch = pEpochBuilding(pRaw);
+                pEpoch->rcvTow = 0;
+                pEpoch->week = 0;
+                pEpoch->leapS = 0;
+                pEpoch->recStat = 0;
+                epochComplete(pRaw);
+            }
+            errorCodeOrCount = (int32_t) pRaw->numComplete;
+        }
+    }
+
+    return errorCodeOrCount;
+}
+
+// Get the oldest complete epoch.
+const uGnssRawEpoch_t *pUGnssRawEpochGet(const uGnssRaw_t *pRaw)
+{
+    const uGnssRawEpoch_t *pEpoch = NULL;
+
+    if ((pRaw != NULL) && (pRaw->numComplete > 0)) {
+        pEpoch = pRaw->pEpoch + pRaw->readIndex;
+    }
+
+    return pEpoch;
+}
+
+// Release the oldest complete epoch.
+void uGnssRawEpochRelease(uGnssRaw_t *pRaw)
+{
+    if ((pRaw != NULL) && (pRaw->numComplete > 0)) {
+        pRaw->readIndex = (pRaw->readIndex + 1) % pRaw->numEpochs;
+        pRaw->numComplete--;
+    }
+}
+
+// Get the statistics of a decoder.
+void uGnssRawGetStats(const uGnssRaw_t *pRaw, uGnssRawStats_t *pStats)
+{
+    if ((pRaw != NULL) && (pStats != NULL)) {
+        *pStats = pRaw->stats;
+    }
+}
+
+// End of file
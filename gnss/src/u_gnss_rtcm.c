@@ -0,0 +1,491 @@
+/*
+ * Copyright 2019-2024 u-blox
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* Only #includes of u_* and the C standard library are allowed here,
+ * no platform stuff and no OS stuff.  Anything required from
+ * the platform/OS must be brought in through u_port* to maintain
+ * portability.
+ */
+
+/** @file
+ * @brief Implementation of the RTCM3 message decoder.  Bit-fields
+ * are extracted by loading the eight bytes that contain them as a
+ * single big-endian 64-bit word and shifting, rather than a bit or
+ * a byte at a time; the CRC-24Q is calculated by the common CRC
+ * code, u_crc.
+ */
+
+#ifdef U_CFG_OVERRIDE
+# include "u_cfg_override.h" // For a customer's configuration override
+#endif
+
+#include "stddef.h"    // NULL, size_t etc.
+#include "stdint.h"    // int32_t etc.
+#include "stdbool.h"
+#include "string.h"    // memset()
+
+#include "u_error_common.h"
+
+#include "u_crc.h"
+
+#include "u_gnss_rtcm.h"
+
+/* ----------------------------------------------------------------
+ * COMPILE-TIME MACROS
+ * -------------------------------------------------------------- */
+
+/** The number of bits in the message type, DF002, at the start of
+ * the body of every RTCM3 message.
+ */
+#define U_GNSS_RTCM_MESSAGE_TYPE_BITS 12
+
+/** The number of bits in the body of an RTCM3 1005 message.
+ */
+#define U_GNSS_RTCM_1005_BITS 152
+
+/** The number of bits in the body of an RTCM3 1006 message.
+ */
+#define U_GNSS_RTCM_1006_BITS (U_GNSS_RTCM_1005_BITS + 16)
+
+/** The number of bits in the body of an RTCM3 1230 message before
+ * the biases.
+ */
+#define U_GNSS_RTCM_1230_HEADER_BITS 32
+
+/** The number of bits in the header of an MSM, up to but not
+ * including the cell mask.
+ */
+#define U_GNSS_RTCM_MSM_HEADER_BITS 169
+
+/** The first MSM message type, MSM1 of GPS.
+ */
+#define U_GNSS_RTCM_MSM_FIRST 1071
+
+/** The last MSM message type, MSM7 of NavIC.
+ */
+#define U_GNSS_RTCM_MSM_LAST 1137
+
+/* ----------------------------------------------------------------
+ * TYPES
+ * -------------------------------------------------------------- */
+
+/** A reader of the bit-fields of a message body.
+ */
+typedef struct {
+    const uint8_t *pBuffer;
+    size_t size;
+    size_t offsetBits;
+} uGnssRtcmBitReader_t;
+
+/** The widths of the fields that vary between types of MSM.
+ */
+typedef struct {
+    uint8_t pseudorangeBits;
+    uint8_t phaseRangeBits;
+    uint8_t lockTimeBits;
+    uint8_t cnrBits;
+    bool rates;              /**< true if the extended satellite
+                                  information, rough phase-range rate
+                                  and fine phase-range rate are
+                                  present. */
+} uGnssRtcmMsmFormat_t;
+
+/* ----------------------------------------------------------------
+ * VARIABLES
+ * -------------------------------------------------------------- */
+
+/** The formats of MSM4 to MSM7.
+ */
+static const uGnssRtcmMsmFormat_t gMsmFormat[] = {
+    {15, 22, 4, 6, false},   // MSM4
+    {15, 22, 4, 6, true},    // MSM5
+    {20, 24, 10, 10, false}, // MSM6
+    {20, 24, 10, 10, true}   // MSM7
+};
+
+/* ----------------------------------------------------------------
+ * STATIC FUNCTIONS
+ * -------------------------------------------------------------- */
+
+// Load eight bytes as a big-endian 64-bit word; written out so that
+// it works on any alignment and endianness, compilers recognise it
+// as a load and, where necessary, a byte swap.
+static uint64_t load64(const uint8_t *pByte)
+{
+    return (((uint64_t) pByte[0]) << 56) | (((uint64_t) pByte[1]) << 48) |
+           (((uint64_t) pByte[2]) << 40) | (((uint64_t) pByte[3]) << 32) |
+           (((uint64_t) pByte[4]) << 24) | (((uint64_t) pByte[5]) << 16) |
+           (((uint64_t) pByte[6]) << 8) | ((uint64_t) pByte[7]);
+}
+
+// Get numBits, 1 to 64, from offsetBits in pBuffer; the bits must
+// be within the buffer.
+static uint64_t bitsGet(const uint8_t *pBuffer, size_t size,
+                        size_t offsetBits, size_t numBits)
+{
+    const uint8_t *pByte = pBuffer + (offsetBits >> 3);
+    size_t remaining = size - (offsetBits >> 3);
+    size_t shift = offsetBits & 7;
+    uint64_t value = 0;
+
+    if (remaining >= 8) {
+        // The usual case: one load covers it, unless this is a
+        // long field that starts part-way through a byte, in which
+        // case the bits in a ninth byte are needed and, since the
+        // field is within the buffer, that byte must be there
+        value = load64(pByte) << shift;
+        if (shift + numBits > 64) {
+            value |= (uint64_t) (pByte[8] >> (8 - shift));
+        }
+    } else {
+        // Near the end of the buffer, where a load would run off it
+        for (size_t x = 0; x < remaining; x++) {
+            value |= ((uint64_t) pByte[x]) << (56 - (x * 8));
+        }
+        value <<= shift;
+    }
+
+    return value >> (64 - numBits);
+}
+
+// Sign-extend a two's complement value of numBits, 1 to 64.
+static int64_t signExtend(uint64_t value, size_t numBits)
+{
+    if ((numBits < 64) && (((value >> (numBits - 1)) & 1) != 0)) {
+        value |= UINT64_MAX << numBits;
+    }
+
+    return (int64_t) value;
+}
+
+// Read an unsigned bit-field and move the reader on.
+static uint64_t readUint(uGnssRtcmBitReader_t *pReader, size_t numBits)
+{
+    uint64_t value = bitsGet(pReader->pBuffer, pReader->size,
+                             pReader->offsetBits, numBits);
+
+    pReader->offsetBits += numBits;
+
+    return value;
+}
+
+// Read a signed bit-field and move the reader on.
+static int64_t readInt(uGnssRtcmBitReader_t *pReader, size_t numBits)
+{
+    return signExtend(readUint(pReader, numBits), numBits);
+}
+
+// Decode the body of a 1005 or 1006 message, after the message
+// type; returns false if the body is too short.
+static bool stationDecode(uGnssRtcmBitReader_t *pReader, bool is1006,
+                          uGnssRtcmStation_t *pStation)
+{
+    bool success = false;
+
+    if (pReader->size * 8 >= (is1006 ? U_GNSS_RTCM_1006_BITS : U_GNSS_RTCM_1005_BITS)) {
+        pStation->stationId = (uint16_t) readUint(pReader, 12);
+        pStation->itrfYear = (uint8_t) readUint(pReader, 6);
+        pStation->gps = (readUint(pReader, 1) != 0);
+        pStation->glonass = (readUint(pReader, 1) != 0);
+        pStation->galileo = (readUint(pReader, 1) != 0);
+        pStation->referenceStation = (readUint(pReader, 1) != 0);
+        pStation->ecefX = readInt(pReader, 38);
+        pStation->singleOscillator = (readUint(pReader, 1) != 0);
+        // DF001, reserved
+        pReader->offsetBits++;
+        pStation->ecefY = readInt(pReader, 38);
+        pStation->quarterCycle = (uint8_t) readUint(pReader, 2);
+        pStation->ecefZ = readInt(pReader, 38);
+        pStation->antennaHeight = 0;
+        if (is1006) {
+            pStation->antennaHeight = (uint16_t) readUint(pReader, 16);
+        }
+        success = true;
+    }
+
+    return success;
+}
+
+// Decode the body of a 1230 message, after the message type;
+// returns false if the body is too short.
+static bool glonassBiasDecode(uGnssRtcmBitReader_t *pReader,
+                              uGnssRtcmGlonassBias_t *pGlonassBias)
+{
+    bool success = false;
+    int16_t *pBias[] = {&pGlonassBias->l1Ca, &pGlonassBias->l1P,
+                        &pGlonassBias->l2Ca, &pGlonassBias->l2P
+                       };
+    size_t numBits = U_GNSS_RTCM_1230_HEADER_BITS;
+
+    if (pReader->size * 8 >= numBits) {
+        pGlonassBias->stationId = (uint16_t) readUint(pReader, 12);
+        pGlonassBias->aligned = (readUint(pReader, 1) != 0);
+        // DF001, reserved
+        pReader->offsetBits += 3;
+        pGlonassBias->signalMask = (uint8_t) readUint(pReader, 4);
+        for (size_t x = 0; x < sizeof(pBias) / sizeof(pBias[0]); x++) {
+            if (pGlonassBias->signalMask & (0x08 >> x)) {
+                numBits += 16;
+            }
+        }
+        if (pReader->size * 8 >= numBits) {
+            for (size_t x = 0; x < sizeof(pBias) / sizeof(pBias[0]); x++) {
+                *pBias[x] = 0;
+                if (pGlonassBias->signalMask & (0x08 >> x)) {
+                    *pBias[x] = (int16_t) readInt(pReader, 16);
+                }
+            }
+            success = true;
+        }
+    }
+
+    return success;
+}
+
+// Decode the body of an MSM4 to MSM7, after the message type;
+// returns false if the body is too short or the masks are not
+// consistent.
+static bool msmDecode(uGnssRtcmBitReader_t *pReader, uint8_t msmType,
+                      uGnssRtcmMsm_t *pMsm)
+{
+    bool success = false;
+    const uGnssRtcmMsmFormat_t *pFormat = &(gMsmFormat[msmType - 4]);
+    size_t numSatellites = 0;
+    size_t numSignals = 0;
+    size_t numCells = 0;
+    size_t numCellMaskBits;
+    size_t numBits;
+    uint64_t bit;
+
+    if (pReader->size * 8 >= U_GNSS_RTCM_MSM_HEADER_BITS) {
+        pMsm->msmType = msmType;
+        pMsm->stationId = (uint16_t) readUint(pReader, 12);
+        pMsm->epochTime = (uint32_t) readUint(pReader, 30);
+        pMsm->multipleMessage = (readUint(pReader, 1) != 0);
+        pMsm->iods = (uint8_t) readUint(pReader, 3);
+        // DF001, reserved
+        pReader->offsetBits += 7;
+        pMsm->clockSteering = (uint8_t) readUint(pReader, 2);
+        pMsm->externalClock = (uint8_t) readUint(pReader, 2);
+        pMsm->smoothing = (readUint(pReader, 1) != 0);
+        pMsm->smoothingInterval = (uint8_t) readUint(pReader, 3);
+        pMsm->satelliteMask = readUint(pReader, 64);
+        pMsm->signalMask = (uint32_t) readUint(pReader, 32);
+        for (size_t x = 0; x < U_GNSS_RTCM_MSM_SATELLITES_MAX_NUM; x++) {
+            if ((pMsm->satelliteMask >> (63 - x)) & 1) {
+                pMsm->satelliteId[numSatellites] = (uint8_t) (x + 1);
+                numSatellites++;
+            }
+        }
+        for (size_t x = 0; x < U_GNSS_RTCM_MSM_SIGNALS_MAX_NUM; x++) {
+            if ((pMsm->signalMask >> (31 - x)) & 1) {
+                pMsm->signalId[numSignals] = (uint8_t) (x + 1);
+                numSignals++;
+            }
+        }
+        numCellMaskBits = numSatellites * numSignals;
+        if ((numCellMaskBits > 0) && (numCellMaskBits <= U_GNSS_RTCM_MSM_CELLS_MAX_NUM) &&
+            (pReader->size * 8 >= pReader->offsetBits + numCellMaskBits)) {
+            pMsm->cellMask = readUint(pReader, numCellMaskBits);
+            bit = ((uint64_t) 1) << (numCellMaskBits - 1);
+            for (size_t x = 0; x < numSatellites; x++) {
+                for (size_t y = 0; y < numSignals; y++) {
+                    if (pMsm->cellMask & bit) {
+                        pMsm->cellSatellite[numCells] = (uint8_t) x;
+                        pMsm->cellSignal[numCells] = (uint8_t) y;
+                        numCells++;
+                    }
+                    bit >>= 1;
+                }
+            }
+            pMsm->numSatellites = (uint8_t) numSatellites;
+            pMsm->numSignals = (uint8_t) numSignals;
+            pMsm->numCells = (uint8_t) numCells;
+            // Now that the counts are known, check the length once
+            // so that the loops below need not
+            numBits = numSatellites * (8 + 10);
+            numBits += numCells * (pFormat->pseudorangeBits + pFormat->phaseRangeBits +
+                                   pFormat->lockTimeBits + 1 + pFormat->cnrBits);
+            if (pFormat->rates) {
+                numBits += (numSatellites * (4 + 14)) + (numCells * 15);
+            }
+            if (pReader->size * 8 >= pReader->offsetBits + numBits) {
+                // Satellite data, one field for all satellites at a time
+                for (size_t x = 0; x < numSatellites; x++) {
+                    pMsm->roughRangeMs[x] = (uint8_t) readUint(pReader, 8);
+                }
+                if (pFormat->rates) {
+                    for (size_t x = 0; x < numSatellites; x++) {
+                        pMsm->extendedInfo[x] = (uint8_t) readUint(pReader, 4);
+                    }
+                } else {
+                    memset(pMsm->extendedInfo, 0, numSatellites * sizeof(pMsm->extendedInfo[0]));
+                }
+                for (size_t x = 0; x < numSatellites; x++) {
+                    pMsm->roughRangeModuloMs[x] = (uint16_t) readUint(pReader, 10);
+                }
+                if (pFormat->rates) {
+                    for (size_t x = 0; x < numSatellites; x++) {
+                        pMsm->roughPhaseRangeRate[x] = (int16_t) readInt(pReader, 14);
+                    }
+                } else {
+                    memset(pMsm->roughPhaseRangeRate, 0,
+                           numSatellites * sizeof(pMsm->roughPhaseRangeRate[0]));
+                }
+                // Signal data, one field for all cells at a time
+                for (size_t x = 0; x < numCells; x++) {
+                    pMsm->finePseudorange[x] = (int32_t) readInt(pReader, pFormat->pseudorangeBits);
+                }
+                for (size_t x = 0; x < numCells; x++) {
+                    pMsm->finePhaseRange[x] = (int32_t) readInt(pReader, pFormat->phaseRangeBits);
+                }
+                for (size_t x = 0; x < numCells; x++) {
+                    pMsm->lockTime[x] = (uint16_t) readUint(pReader, pFormat->lockTimeBits);
+                }
+                for (size_t x = 0; x < numCells; x++) {
+                    pMsm->halfCycleAmbiguity[x] = (readUint(pReader, 1) != 0);
+                }
+                for (size_t x = 0; x < numCells; x++) {
+                    pMsm->cnr[x] = (uint16_t) readUint(pReader, pFormat->cnrBits);
+                }
+                if (pFormat->rates) {
+                    for (size_t x = 0; x < numCells; x++) {
+                        pMsm->finePhaseRangeRate[x] = (int16_t) readInt(pReader, 15);
+                    }
+                } else {
+                    memset(pMsm->finePhaseRangeRate, 0,
+                           numCells * sizeof(pMsm->finePhaseRangeRate[0]));
+                }
+                success = true;
+            }
+        }
+    }
+
+    return success;
+}
+
+// Return the MSM type, 4 to 7, of a message type, zero if it is
+// not an MSM4 to MSM7.
+static uint8_t msmType(uint16_t messageType)
+{
+    uint8_t type = 0;
+
+    if ((messageType >= U_GNSS_RTCM_MSM_FIRST) && (messageType <= U_GNSS_RTCM_MSM_LAST) &&
+        ((messageType % 10) >= 4) && ((messageType % 10) <= 7)) {
+        type = (uint8_t) (messageType % 10);
+    }
+
+    return type;
+}
+
+/* ----------------------------------------------------------------
+ * PUBLIC FUNCTIONS
+ * -------------------------------------------------------------- */
+
+// Calculate a CRC-24Q.
+uint32_t uGnssRtcmCrc24q(const char *pData, size_t length, uint32_t crc)
+{
+    return uCrc24q(pData, length, crc);
+}
+
+// Get an unsigned bit-field.
+uint64_t uGnssRtcmBitsGet(const char *pBuffer, size_t size,
+                          size_t offsetBits, size_t numBits)
+{
+    uint64_t value = 0;
+
+    if ((pBuffer != NULL) && (numBits > 0) && (numBits <= 64) &&
+        (offsetBits + numBits <= size * 8)) {
+        value = bitsGet((const uint8_t *) pBuffer, size, offsetBits, numBits);
+    }
+
+    return value;
+}
+
+// Get a signed bit-field.
+int64_t uGnssRtcmBitsGetSigned(const char *pBuffer, size_t size,
+                               size_t offsetBits, size_t numBits)
+{
+    int64_t value = 0;
+
+    if ((pBuffer != NULL) && (numBits > 0) && (numBits <= 64) &&
+        (offsetBits + numBits <= size * 8)) {
+        value = signExtend(bitsGet((const uint8_t *) pBuffer, size,
+                                   offsetBits, numBits), numBits);
+    }
+
+    return value;
+}
+
+// Decode an RTCM3 message.
+int32_t uGnssRtcmDecode(const char *pBuffer, size_t size,
+                        uGnssRtcmMessage_t *pMessage)
+{
+    int32_t errorCodeOrType = (int32_t) U_ERROR_COMMON_INVALID_PARAMETER;
+    const uint8_t *pBufferUint8 = (const uint8_t *) pBuffer;
+    uGnssRtcmBitReader_t reader;
+    size_t bodyLength;
+    uint32_t crc;
+    uint8_t type;
+    bool success = false;
+
+    if ((pBuffer != NULL) && (pMessage != NULL)) {
+        errorCodeOrType = (int32_t) U_ERROR_COMMON_BAD_DATA;
+        if ((size >= U_GNSS_RTCM_HEADER_LENGTH_BYTES + U_GNSS_RTCM_CRC_LENGTH_BYTES) &&
+            (pBufferUint8[0] == 0xD3) && ((pBufferUint8[1] & 0xFC) == 0)) {
+            bodyLength = (((size_t) (pBufferUint8[1] & 0x03)) << 8) | pBufferUint8[2];
+            if ((bodyLength * 8 >= U_GNSS_RTCM_MESSAGE_TYPE_BITS) &&
+                (size >= U_GNSS_RTCM_HEADER_LENGTH_BYTES + bodyLength +
+                 U_GNSS_RTCM_CRC_LENGTH_BYTES)) {
+                crc = uGnssRtcmCrc24q(pBuffer, U_GNSS_RTCM_HEADER_LENGTH_BYTES + bodyLength, 0);
+                pBufferUint8 += U_GNSS_RTCM_HEADER_LENGTH_BYTES + bodyLength;
+                if ((pBufferUint8[0] == (uint8_t) (crc >> 16)) &&
+                    (pBufferUint8[1] == (uint8_t) (crc >> 8)) &&
+                    (pBufferUint8[2] == (uint8_t) crc)) {
+                    reader.pBuffer = (const uint8_t *) pBuffer + U_GNSS_RTCM_HEADER_LENGTH_BYTES;
+                    reader.size = bodyLength;
+                    reader.offsetBits = 0;
+                    pMessage->messageType = (uint16_t) readUint(&reader, U_GNSS_RTCM_MESSAGE_TYPE_BITS);
+                    type = msmType(pMessage->messageType);
+                    if (type > 0) {
+                        success = msmDecode(&reader, type, &(pMessage->msm));
+                    } else {
+                        switch (pMessage->messageType) {
+                            case 1005:
+                            case 1006:
+                                success = stationDecode(&reader, (pMessage->messageType == 1006),
+                                                        &(pMessage->station));
+                                break;
+                            case 1230:
+                                success = glonassBiasDecode(&reader, &(pMessage->glonassBias));
+                                break;
+                            default:
+                                errorCodeOrType = (int32_t) U_ERROR_COMMON_NOT_SUPPORTED;
+                                break;
+                        }
+                    }
+                    if (success) {
+                        errorCodeOrType = (int32_t) pMessage->messageType;
+                    }
+                }
+            }
+        }
+    }
+
+    return errorCodeOrType;
+}
+
+// End of file
@@ -53,6 +53,8 @@
 
 #include "u_test_util_resource_check.h"
 
+#include "u_ubx_protocol.h"
+
 #include "u_gnss_module_type.h"
 #include "u_gnss_type.h"
 #include "u_gnss.h"
@@ -102,6 +104,20 @@
 # define U_GNSS_DEC_TEST_HEX_DUMP_WIDTH 16
 #endif
 
+#ifndef U_GNSS_DEC_TEST_POOL_NUM_SLOTS
+/** The number of slots in the pool used when testing
+ * uGnssDecPoolInit().
+ */
+# define U_GNSS_DEC_TEST_POOL_NUM_SLOTS 2
+#endif
+
+#ifndef U_GNSS_DEC_TEST_BENCHMARK_ITERATIONS
+/** The number of times each message is decoded, in each way, by
+ * the benchmark.
+ */
+# define U_GNSS_DEC_TEST_BENCHMARK_ITERATIONS 10000
+#endif
+
 /* ----------------------------------------------------------------
  * TYPES
  * -------------------------------------------------------------- */
@@ -224,11 +240,234 @@ static const uGnssDecTestDataKnown_t gUbxNavHpposllh[] = {
     }
 };
 
+/** Decoded test data for UBX-NAV-DOP, to be used by gUbxNavDop (item 0).
+ */
+static const uGnssDecUbxNavDop_t gUbxNavDopDecoded0 = {
+    477230000 /* iTOW */, 156 /* gDOP */, 118 /* pDOP */, 88 /* tDOP */,
+    97 /* vDOP */, 67 /* hDOP */, 49 /* nDOP */, 46 /* eDOP */
+};
+
+/** Array of test data for UBX-NAV-DOP.
+ */
+static const uGnssDecTestDataKnown_t gUbxNavDop[] = {
+    {
+        {
+            "\xb5\x62\x01\x04\x12\x00\xb0\xf3\x71\x1c\x9c\x00\x76\x00\x58\x00"
+            "\x61\x00\x43\x00\x31\x00\x2e\x00\xb4\x43", 26
+        },
+        {
+            U_GNSS_PROTOCOL_UBX, 0x0104, NULL
+        },
+        (void *) &gUbxNavDopDecoded0
+    }
+};
+
+/** Decoded test data for UBX-NAV-STATUS, to be used by gUbxNavStatus (item 0).
+ */
+static const uGnssDecUbxNavStatus_t gUbxNavStatusDecoded0 = {
+    477230000 /* iTOW */, U_GNSS_DEC_UBX_NAV_STATUS_GPS_FIX_3D /* gpsFix */,
+    0xdd /* flags */, 0x00 /* fixStat */, 0x08 /* flags2 */,
+    27312 /* ttff */, 1325640 /* msss */
+};
+
+/** Array of test data for UBX-NAV-STATUS.
+ */
+static const uGnssDecTestDataKnown_t gUbxNavStatus[] = {
+    {
+        {
+            "\xb5\x62\x01\x03\x10\x00\xb0\xf3\x71\x1c\x03\xdd\x00\x08\xb0\x6a"
+            "\x00\x00\x48\x3a\x14\x00\xdc\x8b", 24
+        },
+        {
+            U_GNSS_PROTOCOL_UBX, 0x0103, NULL
+        },
+        (void *) &gUbxNavStatusDecoded0
+    }
+};
+
+/** Decoded test data for UBX-NAV-TIMEUTC, to be used by gUbxNavTimeutc (item 0).
+ */
+static const uGnssDecUbxNavTimeutc_t gUbxNavTimeutcDecoded0 = {
+    477230000 /* iTOW */, 17 /* tAcc */, -73790 /* nano */, 2023 /* year */,
+    8 /* month */, 11 /* day */, 12 /* hour */, 33 /* min */, 32 /* sec */,
+    0x37 /* valid */
+};
+
+/** Array of test data for UBX-NAV-TIMEUTC.
+ */
+static const uGnssDecTestDataKnown_t gUbxNavTimeutc[] = {
+    {
+        {
+            "\xb5\x62\x01\x21\x14\x00\xb0\xf3\x71\x1c\x11\x00\x00\x00\xc2\xdf"
+            "\xfe\xff\xe7\x07\x08\x0b\x0c\x21\x20\x37\x9a\xd8", 28
+        },
+        {
+            U_GNSS_PROTOCOL_UBX, 0x0121, NULL
+        },
+        (void *) &gUbxNavTimeutcDecoded0
+    }
+};
+
+/** Decoded test data for UBX-NAV-SAT, to be used by gUbxNavSat (item 0).
+ */
+static const uGnssDecUbxNavSat_t gUbxNavSatDecoded0 = {
+    477230000 /* iTOW */, 1 /* version */, 3 /* numSvs */,
+    {
+        // gnssId, svId, cno, elev, azim, prRes, flags
+        {0, 2, 42, 61, 296, -5, 0x1f5f},
+        {2, 11, 38, -3, 1, 12, 0x195f},
+        {6, 20, 0, -91, 0, 0, 0x12}
+    }
+};
+
+/** Array of test data for UBX-NAV-SAT.
+ */
+static const uGnssDecTestDataKnown_t gUbxNavSat[] = {
+    {
+        {
+            "\xb5\x62\x01\x35\x2c\x00\xb0\xf3\x71\x1c\x01\x03\x00\x00\x00\x02"
+            "\x2a\x3d\x28\x01\xfb\xff\x5f\x1f\x00\x00\x02\x0b\x26\xfd\x01\x00"
+            "\x0c\x00\x5f\x19\x00\x00\x06\x14\x00\xa5\x00\x00\x00\x00\x12\x00"
+            "\x00\x00\x26\x11", 52
+        },
+        {
+            U_GNSS_PROTOCOL_UBX, 0x0135, NULL
+        },
+        (void *) &gUbxNavSatDecoded0
+    }
+};
+
+/** Decoded test data for UBX-NAV-SIG, to be used by gUbxNavSig (item 0).
+ */
+static const uGnssDecUbxNavSig_t gUbxNavSigDecoded0 = {
+    477230000 /* iTOW */, 0 /* version */, 3 /* numSigs */,
+    {
+        // gnssId, svId, sigId, freqId, prRes, cno, qualityInd,
+        // corrSource, ionoModel, sigFlags
+        {0, 2, 0, 0, -5, 42, 7, 0, 1, 0x0029},
+        {0, 2, 3, 0, 12, 35, 5, 0, 1, 0x0009},
+        {6, 20, 0, 9, -31, 28, 4, 1, 0, 0x01e9}
+    }
+};
+
+/** Array of test data for UBX-NAV-SIG.
+ */
+static const uGnssDecTestDataKnown_t gUbxNavSig[] = {
+    {
+        {
+            "\xb5\x62\x01\x43\x38\x00\xb0\xf3\x71\x1c\x00\x03\x00\x00\x00\x02"
+            "\x00\x00\xfb\xff\x2a\x07\x00\x01\x29\x00\x00\x00\x00\x00\x00\x02"
+            "\x03\x00\x0c\x00\x23\x05\x00\x01\x09\x00\x00\x00\x00\x00\x06\x14"
+            "\x00\x09\xe1\xff\x1c\x04\x01\x00\xe9\x01\x00\x00\x00\x00\x57\xf5", 64
+        },
+        {
+            U_GNSS_PROTOCOL_UBX, 0x0143, NULL
+        },
+        (void *) &gUbxNavSigDecoded0
+    }
+};
+
+/** Decoded test data for UBX-ESF-MEAS, to be used by gUbxEsfMeas (item 0).
+ */
+static const uGnssDecUbxEsfMeas_t gUbxEsfMeasDecoded0 = {
+    0x00123456 /* timeTag */, 0x1808 /* flags */, 0 /* id */, 3 /* numMeas */,
+    {
+        // Gyroscope X-axis angular rate -1234, gyroscope temperature
+        // 1000 and rear-left wheel ticks 5
+        {0x0efffb2e}, {0x100003e8}, {0x0b000005}
+    },
+    477230123 /* calibTtag */
+};
+
+/** Array of test data for UBX-ESF-MEAS.
+ */
+static const uGnssDecTestDataKnown_t gUbxEsfMeas[] = {
+    {
+        {
+            "\xb5\x62\x10\x02\x18\x00\x56\x34\x12\x00\x08\x18\x00\x00\x2e\xfb"
+            "\xff\x0e\xe8\x03\x00\x10\x05\x00\x00\x0b\x2b\xf4\x71\x1c\xd3\xc9", 32
+        },
+        {
+            U_GNSS_PROTOCOL_UBX, 0x1002, NULL
+        },
+        (void *) &gUbxEsfMeasDecoded0
+    }
+};
+
+/** Decoded test data for UBX-RXM-RAWX, to be used by gUbxRxmRawx (item 0).
+ */
+static const uGnssDecUbxRxmRawx_t gUbxRxmRawxDecoded0 = {
+    477230.0 /* rcvTow */, 2274 /* week */, 18 /* leapS */, 2 /* numMeas */,
+    0x01 /* recStat */, 1 /* version */,
+    {
+        // prMes, cpMes, doMes, gnssId, svId, sigId, freqId, locktime,
+        // cno, prStdev, cpStdev, doStdev, trkStat
+        {21234567.890625, 111588123.4375, -1234.5f, 0, 5, 0, 0, 64500, 45, 5, 3, 6, 0x07},
+        {19876543.25, 106123456.125, 2500.25f, 6, 12, 0, 9, 1200, 38, 6, 4, 7, 0x03}
+    }
+};
+
+/** Array of test data for UBX-RXM-RAWX.
+ */
+static const uGnssDecTestDataKnown_t gUbxRxmRawx[] = {
+    {
+        {
+            "\xb5\x62\x02\x15\x50\x00\x00\x00\x00\x00\xb8\x20\x1d\x41\xe2\x08"
+            "\x12\x02\x01\x01\x00\x00\x00\x00\x40\x7e\x38\x40\x74\x41\x00\x00"
+            "\xc0\x6d\xcc\x9a\x9a\x41\x00\x50\x9a\xc4\x00\x05\x00\x00\xf4\xfb"
+            "\x2d\x05\x03\x06\x07\x00\x00\x00\x00\xf4\xab\xf4\x72\x41\x00\x00"
+            "\x80\x00\x43\x4d\x99\x41\x00\x44\x1c\x45\x06\x0c\x00\x09\xb0\x04"
+            "\x26\x06\x04\x07\x03\x00\xb8\x2b", 88
+        },
+        {
+            U_GNSS_PROTOCOL_UBX, 0x0215, NULL
+        },
+        (void *) &gUbxRxmRawxDecoded0
+    }
+};
+
+/** Decoded test data for UBX-MON-RF, to be used by gUbxMonRf (item 0).
+ */
+static const uGnssDecUbxMonRf_t gUbxMonRfDecoded0 = {
+    0 /* version */, 2 /* nBlocks */,
+    {
+        // blockId, flags, antStatus, antPower, postStatus, noisePerMS,
+        // agcCnt, jamInd, ofsI, magI, ofsQ, magQ
+        {0, 0x01, U_GNSS_DEC_UBX_MON_RF_ANT_STATUS_OK, U_GNSS_DEC_UBX_MON_RF_ANT_POWER_ON, 0, 86, 5243, 12, 3, 118, -2, 121},
+        {1, 0x01, U_GNSS_DEC_UBX_MON_RF_ANT_STATUS_OK, U_GNSS_DEC_UBX_MON_RF_ANT_POWER_ON, 0, 72, 4920, 9, -1, 110, 4, 115}
+    }
+};
+
+/** Array of test data for UBX-MON-RF.
+ */
+static const uGnssDecTestDataKnown_t gUbxMonRf[] = {
+    {
+        {
+            "\xb5\x62\x0a\x38\x34\x00\x00\x02\x00\x00\x00\x01\x02\x01\x00\x00"
+            "\x00\x00\x00\x00\x00\x00\x56\x00\x7b\x14\x0c\x03\x76\xfe\x79\x00"
+            "\x00\x00\x01\x01\x02\x01\x00\x00\x00\x00\x00\x00\x00\x00\x48\x00"
+            "\x38\x13\x09\xff\x6e\x04\x73\x00\x00\x00\xe2\x63", 60
+        },
+        {
+            U_GNSS_PROTOCOL_UBX, 0x0a38, NULL
+        },
+        (void *) &gUbxMonRfDecoded0
+    }
+};
+
 /** Array of arrays of test vectors for all known message types.
  */
 static const uGnssDecTestDataKnownSet_t gTestDataKnownSet[] = {
     {gUbxNavPvt, sizeof(gUbxNavPvt) / sizeof(gUbxNavPvt[0]), sizeof(gUbxNavPvtDecoded0)},
-    {gUbxNavHpposllh, sizeof(gUbxNavHpposllh) / sizeof(gUbxNavHpposllh[0]), sizeof(gUbxNavHpposllhDecoded0)}
+    {gUbxNavHpposllh, sizeof(gUbxNavHpposllh) / sizeof(gUbxNavHpposllh[0]), sizeof(gUbxNavHpposllhDecoded0)},
+    {gUbxNavDop, sizeof(gUbxNavDop) / sizeof(gUbxNavDop[0]), sizeof(gUbxNavDopDecoded0)},
+    {gUbxNavStatus, sizeof(gUbxNavStatus) / sizeof(gUbxNavStatus[0]), sizeof(gUbxNavStatusDecoded0)},
+    {gUbxNavTimeutc, sizeof(gUbxNavTimeutc) / sizeof(gUbxNavTimeutc[0]), sizeof(gUbxNavTimeutcDecoded0)},
+    {gUbxNavSat, sizeof(gUbxNavSat) / sizeof(gUbxNavSat[0]), sizeof(gUbxNavSatDecoded0)},
+    {gUbxNavSig, sizeof(gUbxNavSig) / sizeof(gUbxNavSig[0]), sizeof(gUbxNavSigDecoded0)},
+    {gUbxEsfMeas, sizeof(gUbxEsfMeas) / sizeof(gUbxEsfMeas[0]), sizeof(gUbxEsfMeasDecoded0)},
+    {gUbxRxmRawx, sizeof(gUbxRxmRawx) / sizeof(gUbxRxmRawx[0]), sizeof(gUbxRxmRawxDecoded0)},
+    {gUbxMonRf, sizeof(gUbxMonRf) / sizeof(gUbxMonRf[0]), sizeof(gUbxMonRfDecoded0)}
 };
 
 /** Flag to share with the user callback.
@@ -501,6 +740,18 @@ static void testHelperFunctions(const uGnssMessageId_t *pId,
                         }
                     }
                     break;
+                case U_GNSS_UBX_MESSAGE(U_GNSS_DEC_UBX_ESF_MEAS_MESSAGE_CLASS,
+                                        U_GNSS_DEC_UBX_ESF_MEAS_MESSAGE_ID): {
+                        // Check the data type/field macros using the
+                        // first item in the gUbxEsfMeas array
+                        if (pRaw == &(gUbxEsfMeas[0].raw)) {
+                            U_PORT_TEST_ASSERT(U_GNSS_DEC_UBX_ESF_MEAS_DATA_TYPE(pBody->ubxEsfMeas.data[0].data) == 14);
+                            U_PORT_TEST_ASSERT(U_GNSS_DEC_UBX_ESF_MEAS_DATA_FIELD(pBody->ubxEsfMeas.data[0].data) == -1234);
+                            U_PORT_TEST_ASSERT(U_GNSS_DEC_UBX_ESF_MEAS_DATA_TYPE(pBody->ubxEsfMeas.data[1].data) == 16);
+                            U_PORT_TEST_ASSERT(U_GNSS_DEC_UBX_ESF_MEAS_DATA_FIELD(pBody->ubxEsfMeas.data[1].data) == 1000);
+                        }
+                    }
+                    break;
                 default:
                     break;
             }
@@ -707,4 +958,301 @@ U_PORT_TEST_FUNCTION("[gnssDec]", "gnssDecKnown")
     U_PORT_TEST_ASSERT(resourceCount <= 0);
 }
 
+/** Test decoding of messages with repeated blocks where the
+ * number of blocks is more than will fit or more than are present,
+ * and of a message that is too short to decode at all.
+ */
+U_PORT_TEST_FUNCTION("[gnssDec]", "gnssDecRepeated")
+{
+    int32_t resourceCount;
+    uGnssDec_t *pDec;
+    size_t numSvs = U_GNSS_DEC_UBX_NAV_SAT_SVS_MAX_NUM + 2;
+    size_t bodyLength = U_GNSS_DEC_UBX_NAV_SAT_BODY_MIN_LENGTH +
+                        (numSvs * U_GNSS_DEC_UBX_NAV_SAT_BLOCK_LENGTH);
+    char *pBody;
+    char *pMessage;
+    int32_t messageLength;
+
+    // Get the initial resource count
+    resourceCount = uTestUtilGetDynamicResourceCount();
+
+    pBody = (char *) pUPortMalloc(bodyLength);
+    U_PORT_TEST_ASSERT(pBody != NULL);
+    pMessage = (char *) pUPortMalloc(bodyLength + U_UBX_PROTOCOL_OVERHEAD_LENGTH_BYTES);
+    U_PORT_TEST_ASSERT(pMessage != NULL);
+
+    // A UBX-NAV-SAT message with more satellites than will fit,
+    // the svId of each being its index
+    memset(pBody, 0, bodyLength);
+    *(pBody + 5) = (char) numSvs;
+    for (size_t x = 0; x < numSvs; x++) {
+        *(pBody + U_GNSS_DEC_UBX_NAV_SAT_BODY_MIN_LENGTH +
+          (x * U_GNSS_DEC_UBX_NAV_SAT_BLOCK_LENGTH) + 1) = (char) x;
+    }
+    messageLength = uUbxProtocolEncode(U_GNSS_DEC_UBX_NAV_SAT_MESSAGE_CLASS,
+                                       U_GNSS_DEC_UBX_NAV_SAT_MESSAGE_ID,
+                                       pBody, bodyLength, pMessage);
+    U_PORT_TEST_ASSERT(messageLength == (int32_t) (bodyLength + U_UBX_PROTOCOL_OVERHEAD_LENGTH_BYTES));
+    U_TEST_PRINT_LINE("decoding UBX-NAV-SAT with %d satellites, maximum %d.",
+                      numSvs, U_GNSS_DEC_UBX_NAV_SAT_SVS_MAX_NUM);
+    pDec = pUGnssDecAlloc(pMessage, messageLength);
+    U_PORT_TEST_ASSERT(pDec != NULL);
+    U_PORT_TEST_ASSERT(pDec->errorCode == 0);
+    U_PORT_TEST_ASSERT(pDec->pBody != NULL);
+    U_PORT_TEST_ASSERT(pDec->pBody->ubxNavSat.numSvs == U_GNSS_DEC_UBX_NAV_SAT_SVS_MAX_NUM);
+    for (size_t x = 0; x < U_GNSS_DEC_UBX_NAV_SAT_SVS_MAX_NUM; x++) {
+        U_PORT_TEST_ASSERT(pDec->pBody->ubxNavSat.sv[x].svId == x);
+    }
+    uGnssDecFree(pDec);
+
+    // The same message claiming more satellites than it contains:
+    // what is there should be decoded but flagged as bad data
+    numSvs = 3;
+    bodyLength = U_GNSS_DEC_UBX_NAV_SAT_BODY_MIN_LENGTH + (numSvs * U_GNSS_DEC_UBX_NAV_SAT_BLOCK_LENGTH);
+    *(pBody + 5) = (char) (numSvs + 1);
+    messageLength = uUbxProtocolEncode(U_GNSS_DEC_UBX_NAV_SAT_MESSAGE_CLASS,
+                                       U_GNSS_DEC_UBX_NAV_SAT_MESSAGE_ID,
+                                       pBody, bodyLength, pMessage);
+    U_PORT_TEST_ASSERT(messageLength == (int32_t) (bodyLength + U_UBX_PROTOCOL_OVERHEAD_LENGTH_BYTES));
+    U_TEST_PRINT_LINE("decoding UBX-NAV-SAT with %d satellites that claims %d.",
+                      numSvs, numSvs + 1);
+    pDec = pUGnssDecAlloc(pMessage, messageLength);
+    U_PORT_TEST_ASSERT(pDec != NULL);
+    U_PORT_TEST_ASSERT(pDec->errorCode == (int32_t) U_ERROR_COMMON_BAD_DATA);
+    U_PORT_TEST_ASSERT(pDec->pBody != NULL);
+    U_PORT_TEST_ASSERT(pDec->pBody->ubxNavSat.numSvs == numSvs);
+    for (size_t x = 0; x < numSvs; x++) {
+        U_PORT_TEST_ASSERT(pDec->pBody->ubxNavSat.sv[x].svId == x);
+    }
+    uGnssDecFree(pDec);
+
+    // A UBX-NAV-DOP message that is too short
+    bodyLength = U_GNSS_DEC_UBX_NAV_DOP_BODY_MIN_LENGTH - 1;
+    messageLength = uUbxProtocolEncode(U_GNSS_DEC_UBX_NAV_DOP_MESSAGE_CLASS,
+                                       U_GNSS_DEC_UBX_NAV_DOP_MESSAGE_ID,
+                                       pBody, bodyLength, pMessage);
+    U_PORT_TEST_ASSERT(messageLength == (int32_t) (bodyLength + U_UBX_PROTOCOL_OVERHEAD_LENGTH_BYTES));
+    U_TEST_PRINT_LINE("decoding a truncated UBX-NAV-DOP.");
+    pDec = pUGnssDecAlloc(pMessage, messageLength);
+    U_PORT_TEST_ASSERT(pDec != NULL);
+    U_PORT_TEST_ASSERT(pDec->errorCode == (int32_t) U_ERROR_COMMON_TRUNCATED);
+    U_PORT_TEST_ASSERT(pDec->pBody == NULL);
+    uGnssDecFree(pDec);
+
+    uPortFree(pMessage);
+    uPortFree(pBody);
+
+    // Check for resource leaks
+    uTestUtilResourceCheck(U_TEST_PREFIX, NULL, true);
+    resourceCount = uTestUtilGetDynamicResourceCount() - resourceCount;
+    U_TEST_PRINT_LINE("we have leaked %d resources(s).", resourceCount);
+    U_PORT_TEST_ASSERT(resourceCount <= 0);
+}
+
+/** Test of decoding into caller storage with uGnssDecInto() and
+ * into a pool of slots with uGnssDecPoolInit().
+ */
+U_PORT_TEST_FUNCTION("[gnssDec]", "gnssDecIntoPool")
+{
+    int32_t resourceCount;
+    int32_t heapAllocCount;
+    uGnssDec_t dec;
+    uGnssDec_t *pDec[U_GNSS_DEC_TEST_POOL_NUM_SLOTS + 1];
+    uGnssDecUnion_t *pBody;
+    uGnssDecSlot_t *pSlots;
+    const uGnssDecTestDataKnown_t *pTestData = NULL;
+    size_t decodedStructureSize;
+    size_t length;
+
+    // Get the initial resource count
+    resourceCount = uTestUtilGetDynamicResourceCount();
+
+    pBody = (uGnssDecUnion_t *) pUPortMalloc(sizeof(*pBody));
+    U_PORT_TEST_ASSERT(pBody != NULL);
+
+    // For each item of test data for each message type, decode
+    // into our storage, checking that nothing is allocated
+    for (size_t x = 0; x < sizeof(gTestDataKnownSet) / sizeof(gTestDataKnownSet[0]); x++) {
+        decodedStructureSize = gTestDataKnownSet[x].decodedStructureSize;
+        for (size_t y = 0; y < gTestDataKnownSet[x].size; y++) {
+            pTestData = gTestDataKnownSet[x].pTestData + y;
+            length = pTestData->raw.length - gCrcLength[pTestData->id.type];
+            U_TEST_PRINT_LINE_X_Y("test decode into caller storage, ID 0x%04x.",
+                                  x, y, pTestData->id.idUbxOrRtcm);
+            heapAllocCount = uPortHeapAllocCount();
+            memset(pBody, 0xFF, sizeof(*pBody));
+            U_PORT_TEST_ASSERT(uGnssDecInto(pTestData->raw.p, length, &dec,
+                                            pBody, sizeof(*pBody)) == 0);
+            U_PORT_TEST_ASSERT(uPortHeapAllocCount() == heapAllocCount);
+            U_PORT_TEST_ASSERT(dec.errorCode == 0);
+            U_PORT_TEST_ASSERT(dec.id.type == pTestData->id.type);
+            U_PORT_TEST_ASSERT(dec.id.id.ubx == pTestData->id.idUbxOrRtcm);
+            U_PORT_TEST_ASSERT(dec.pBody == pBody);
+            U_PORT_TEST_ASSERT(memcmp(pBody, pTestData->pDecoded, decodedStructureSize) == 0);
+            // Storage of exactly the size of the message structure is fine
+            U_PORT_TEST_ASSERT(uGnssDecInto(pTestData->raw.p, length, &dec,
+                                            pBody, decodedStructureSize) == 0);
+            // ...but one byte less is not, though the ID is still decoded
+            U_PORT_TEST_ASSERT(uGnssDecInto(pTestData->raw.p, length, &dec, pBody,
+                                            decodedStructureSize - 1) == (int32_t) U_ERROR_COMMON_NO_MEMORY);
+            U_PORT_TEST_ASSERT(dec.errorCode == (int32_t) U_ERROR_COMMON_NO_MEMORY);
+            U_PORT_TEST_ASSERT(dec.id.id.ubx == pTestData->id.idUbxOrRtcm);
+            U_PORT_TEST_ASSERT(dec.pBody == NULL);
+        }
+    }
+
+    // Messages that are not supported return just the ID
+    U_TEST_PRINT_LINE("test decode into caller storage of unsupported messages.");
+    for (size_t x = 0; x < sizeof(gTestDataCallback) / sizeof(gTestDataCallback[0]); x++) {
+        if (gTestDataCallback[x].id.type == U_GNSS_PROTOCOL_NMEA) {
+            U_PORT_TEST_ASSERT(uGnssDecInto(gTestDataCallback[x].raw.p,
+                                            gTestDataCallback[x].raw.length, &dec,
+                                            pBody, sizeof(*pBody)) == (int32_t) U_ERROR_COMMON_NOT_SUPPORTED);
+            U_PORT_TEST_ASSERT(dec.id.type == U_GNSS_PROTOCOL_NMEA);
+            U_PORT_TEST_ASSERT(strcmp(dec.id.id.pNmea, gTestDataCallback[x].id.pIdNmea) == 0);
+            U_PORT_TEST_ASSERT(dec.pBody == NULL);
+        }
+    }
+    U_PORT_TEST_ASSERT(uGnssDecInto(gUbxNavPvt[0].raw.p, gUbxNavPvt[0].raw.length,
+                                    NULL, pBody, sizeof(*pBody)) < 0);
+    uPortFree(pBody);
+
+    // Now the pool
+    U_TEST_PRINT_LINE("test decode into a pool of %d slot(s).", U_GNSS_DEC_TEST_POOL_NUM_SLOTS);
+    pSlots = (uGnssDecSlot_t *) pUPortMalloc(sizeof(*pSlots) * U_GNSS_DEC_TEST_POOL_NUM_SLOTS);
+    U_PORT_TEST_ASSERT(pSlots != NULL);
+    U_PORT_TEST_ASSERT(uGnssDecPoolInit(NULL, U_GNSS_DEC_TEST_POOL_NUM_SLOTS) < 0);
+    U_PORT_TEST_ASSERT(uGnssDecPoolInit(pSlots, 0) < 0);
+    U_PORT_TEST_ASSERT(uGnssDecPoolInit(pSlots, U_GNSS_DEC_TEST_POOL_NUM_SLOTS) == 0);
+    U_PORT_TEST_ASSERT(uGnssDecPoolInit(pSlots, U_GNSS_DEC_TEST_POOL_NUM_SLOTS) < 0);
+    length = gUbxNavPvt[0].raw.length - gCrcLength[U_GNSS_PROTOCOL_UBX];
+    heapAllocCount = uPortHeapAllocCount();
+    for (size_t x = 0; x < sizeof(pDec) / sizeof(pDec[0]); x++) {
+        pDec[x] = pUGnssDecAlloc(gUbxNavPvt[0].raw.p, length);
+        U_PORT_TEST_ASSERT(pDec[x] != NULL);
+        U_PORT_TEST_ASSERT(pDec[x]->errorCode == 0);
+        U_PORT_TEST_ASSERT(memcmp(pDec[x]->pBody, gUbxNavPvt[0].pDecoded, sizeof(uGnssDecUbxNavPvt_t)) == 0);
+        if (x < U_GNSS_DEC_TEST_POOL_NUM_SLOTS) {
+            // Should be in the pool, no heap involved
+            U_PORT_TEST_ASSERT(pDec[x] == &(pSlots[x].dec));
+            U_PORT_TEST_ASSERT(uPortHeapAllocCount() == heapAllocCount);
+        } else {
+            // Should have fallen back to the heap
+            U_PORT_TEST_ASSERT(uPortHeapAllocCount() == heapAllocCount + 2);
+        }
+    }
+    U_PORT_TEST_ASSERT(uGnssDecPoolDeinit() == (int32_t) U_ERROR_COMMON_BUSY);
+    // Free one slot and the next decode should go back into it
+    uGnssDecFree(pDec[0]);
+    pDec[0] = pUGnssDecAlloc(gUbxNavPvt[0].raw.p, length);
+    U_PORT_TEST_ASSERT(pDec[0] == &(pSlots[0].dec));
+    for (size_t x = 0; x < sizeof(pDec) / sizeof(pDec[0]); x++) {
+        uGnssDecFree(pDec[x]);
+    }
+    U_PORT_TEST_ASSERT(uPortHeapAllocCount() == heapAllocCount);
+    U_PORT_TEST_ASSERT(uGnssDecPoolDeinit() == 0);
+    U_PORT_TEST_ASSERT(uGnssDecPoolDeinit() == 0);
+    uPortFree(pSlots);
+
+    // Check for resource leaks
+    uTestUtilResourceCheck(U_TEST_PREFIX, NULL, true);
+    resourceCount = uTestUtilGetDynamicResourceCount() - resourceCount;
+    U_TEST_PRINT_LINE("we have leaked %d resources(s).", resourceCount);
+    U_PORT_TEST_ASSERT(resourceCount <= 0);
+}
+
+/** Benchmark of decoding each message type: the heap allocations
+ * made and the time taken per decode, using pUGnssDecAlloc() with
+ * the heap, pUGnssDecAlloc() with a pool and uGnssDecInto().
+ */
+U_PORT_TEST_FUNCTION("[gnssDec]", "gnssDecBenchmark")
+{
+    int32_t resourceCount;
+    int32_t heapAllocCount[3];
+    int32_t durationMs[3];
+    int64_t startTimeMs;
+    uGnssDec_t dec;
+    uGnssDec_t *pDec;
+    uGnssDecUnion_t *pBody;
+    uGnssDecSlot_t *pSlots;
+    const uGnssDecTestDataKnown_t *pTestData = NULL;
+    size_t length;
+
+    // Get the initial resource count
+    resourceCount = uTestUtilGetDynamicResourceCount();
+
+    pBody = (uGnssDecUnion_t *) pUPortMalloc(sizeof(*pBody));
+    U_PORT_TEST_ASSERT(pBody != NULL);
+    pSlots = (uGnssDecSlot_t *) pUPortMalloc(sizeof(*pSlots));
+    U_PORT_TEST_ASSERT(pSlots != NULL);
+
+    U_TEST_PRINT_LINE("%d decodes of each message, allocations held per"
+                      " decode and nanoseconds per decode:",
+                      U_GNSS_DEC_TEST_BENCHMARK_ITERATIONS);
+    U_TEST_PRINT_LINE("        ID     heap allocs/ns   pool allocs/ns   into allocs/ns");
+    for (size_t x = 0; x < sizeof(gTestDataKnownSet) / sizeof(gTestDataKnownSet[0]); x++) {
+        pTestData = gTestDataKnownSet[x].pTestData;
+        length = pTestData->raw.length - gCrcLength[pTestData->id.type];
+
+        // Before: pUGnssDecAlloc() using the heap
+        heapAllocCount[0] = uPortHeapAllocCount();
+        pDec = pUGnssDecAlloc(pTestData->raw.p, length);
+        heapAllocCount[0] = uPortHeapAllocCount() - heapAllocCount[0];
+        U_PORT_TEST_ASSERT((pDec != NULL) && (pDec->errorCode == 0));
+        uGnssDecFree(pDec);
+        startTimeMs = uPortGetTickTimeMs();
+        for (size_t y = 0; y < U_GNSS_DEC_TEST_BENCHMARK_ITERATIONS; y++) {
+            pDec = pUGnssDecAlloc(pTestData->raw.p, length);
+            uGnssDecFree(pDec);
+        }
+        durationMs[0] = (int32_t) (uPortGetTickTimeMs() - startTimeMs);
+
+        // After: pUGnssDecAlloc() using a pool
+        U_PORT_TEST_ASSERT(uGnssDecPoolInit(pSlots, 1) == 0);
+        heapAllocCount[1] = uPortHeapAllocCount();
+        pDec = pUGnssDecAlloc(pTestData->raw.p, length);
+        heapAllocCount[1] = uPortHeapAllocCount() - heapAllocCount[1];
+        U_PORT_TEST_ASSERT((pDec != NULL) && (pDec->errorCode == 0));
+        uGnssDecFree(pDec);
+        startTimeMs = uPortGetTickTimeMs();
+        for (size_t y = 0; y < U_GNSS_DEC_TEST_BENCHMARK_ITERATIONS; y++) {
+            pDec = pUGnssDecAlloc(pTestData->raw.p, length);
+            uGnssDecFree(pDec);
+        }
+        durationMs[1] = (int32_t) (uPortGetTickTimeMs() - startTimeMs);
+        U_PORT_TEST_ASSERT(uGnssDecPoolDeinit() == 0);
+
+        // After: uGnssDecInto()
+        heapAllocCount[2] = uPortHeapAllocCount();
+        U_PORT_TEST_ASSERT(uGnssDecInto(pTestData->raw.p, length, &dec, pBody, sizeof(*pBody)) == 0);
+        heapAllocCount[2] = uPortHeapAllocCount() - heapAllocCount[2];
+        startTimeMs = uPortGetTickTimeMs();
+        for (size_t y = 0; y < U_GNSS_DEC_TEST_BENCHMARK_ITERATIONS; y++) {
+            uGnssDecInto(pTestData->raw.p, length, &dec, pBody, sizeof(*pBody));
+        }
+        durationMs[2] = (int32_t) (uPortGetTickTimeMs() - startTimeMs);
+
+        U_TEST_PRINT_LINE("    0x%04x     %6d/%-8d     %6d/%-8d     %6d/%-8d",
+                          pTestData->id.idUbxOrRtcm,
+                          heapAllocCount[0],
+                          (int32_t) (((int64_t) durationMs[0] * 1000000) / U_GNSS_DEC_TEST_BENCHMARK_ITERATIONS),
+                          heapAllocCount[1],
+                          (int32_t) (((int64_t) durationMs[1] * 1000000) / U_GNSS_DEC_TEST_BENCHMARK_ITERATIONS),
+                          heapAllocCount[2],
+                          (int32_t) (((int64_t) durationMs[2] * 1000000) / U_GNSS_DEC_TEST_BENCHMARK_ITERATIONS));
+        // The pool and uGnssDecInto() should not touch the heap
+        U_PORT_TEST_ASSERT(heapAllocCount[1] == 0);
+        U_PORT_TEST_ASSERT(heapAllocCount[2] == 0);
+    }
+
+    uPortFree(pSlots);
+    uPortFree(pBody);
+
+    // Check for resource leaks
+    uTestUtilResourceCheck(U_TEST_PREFIX, NULL, true);
+    resourceCount = uTestUtilGetDynamicResourceCount() - resourceCount;
+    U_TEST_PRINT_LINE("we have leaked %d resources(s).", resourceCount);
+    U_PORT_TEST_ASSERT(resourceCount <= 0);
+}
+
 // End of file
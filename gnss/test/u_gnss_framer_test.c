@@ -0,0 +1,748 @@
+/*
+ * Copyright 2019-2024 u-blox
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* Only #includes of u_* and the C standard library are allowed here,
+ * no platform stuff and no OS stuff.  Anything required from
+ * the platform/OS must be brought in through u_port* to maintain
+ * portability.
+ */
+
+/** @file
+ * @brief Tests for the GNSS framer API: they do not require a GNSS
+ * module to run, hence these should pass on all platforms.
+ * IMPORTANT: see notes in u_cfg_test_platform_specific.h for the
+ * naming rules that must be followed when using the U_PORT_TEST_FUNCTION()
+ * macro.
+ */
+
+# ifdef U_CFG_OVERRIDE
+#  include "u_cfg_override.h" // For a customer's configuration override
+# endif
+
+#include "stddef.h"    // NULL, size_t etc.
+#include "stdint.h"    // int32_t etc.
+#include "stdbool.h"
+#include "string.h"    // memset(), memcmp(), strcmp()
+#include "stdio.h"     // snprintf()
+
+#include "u_cfg_sw.h"
+#include "u_cfg_os_platform_specific.h"
+#include "u_cfg_app_platform_specific.h"
+#include "u_cfg_test_platform_specific.h"
+
+#include "u_error_common.h"
+
+#include "u_port.h"
+#include "u_port_os.h"
+#include "u_port_heap.h"
+#include "u_port_debug.h"
+
+#include "u_test_util_resource_check.h"
+
+#include "u_ubx_protocol.h"
+
+#include "u_spartn.h"
+#include "u_spartn_crc.h"
+
+#include "u_gnss_type.h"
+#include "u_gnss_framer.h"
+
+/* ----------------------------------------------------------------
+ * COMPILE-TIME MACROS
+ * -------------------------------------------------------------- */
+
+/** The string to put at the start of all prints from this test.
+ */
+#define U_TEST_PREFIX "U_GNSS_FRAMER_TEST: "
+
+/** Print a whole line, with terminator, prefixed for this test file.
+ */
+#define U_TEST_PRINT_LINE(format, ...) uPortLog(U_TEST_PREFIX format "\n", ##__VA_ARGS__)
+
+#ifndef U_GNSS_FRAMER_TEST_CORPUS_LENGTH_BYTES
+/** The size of the corpus of test data.
+ */
+# define U_GNSS_FRAMER_TEST_CORPUS_LENGTH_BYTES (1024 * 32)
+#endif
+
+#ifndef U_GNSS_FRAMER_TEST_MAX_NUM_FRAMES
+/** The maximum number of frames in the corpus.
+ */
+# define U_GNSS_FRAMER_TEST_MAX_NUM_FRAMES 256
+#endif
+
+/** The largest amount of corpus that one frame, plus the rubbish
+ * that may precede it, can occupy.
+ */
+#define U_GNSS_FRAMER_TEST_FRAME_LENGTH_MAX_BYTES 1024
+
+/** The size of buffer to give the framer: comfortably larger than
+ * the largest frame in the corpus, see buildCorpus().
+ */
+#define U_GNSS_FRAMER_TEST_BUFFER_LENGTH_BYTES 2048
+
+#ifndef U_GNSS_FRAMER_TEST_BENCHMARK_LENGTH_BYTES
+/** The number of bytes to frame for each chunk size when measuring
+ * throughput.
+ */
+# define U_GNSS_FRAMER_TEST_BENCHMARK_LENGTH_BYTES (1024 * 1024)
+#endif
+
+/* ----------------------------------------------------------------
+ * TYPES
+ * -------------------------------------------------------------- */
+
+/** A frame that has been put into the corpus, see buildCorpus().
+ */
+typedef struct {
+    uGnssFramerProtocol_t protocol;
+    uint16_t id; // For all but NMEA
+    char nmea[U_GNSS_NMEA_MESSAGE_MATCH_LENGTH_CHARACTERS + 1];
+    size_t offset;
+    size_t length;
+} uGnssFramerTestFrame_t;
+
+/* ----------------------------------------------------------------
+ * VARIABLES
+ * -------------------------------------------------------------- */
+
+/** The seed for randomNumber(), which is used in place of rand() so
+ * that the corpus is the same on all platforms.
+ */
+static uint32_t gSeed = 0;
+
+/** The corpus.
+ */
+static char *gpCorpus = NULL;
+
+/** The frames in the corpus.
+ */
+static uGnssFramerTestFrame_t *gpFrames = NULL;
+
+/** A buffer for the framer.
+ */
+static char *gpBuffer = NULL;
+
+/* ----------------------------------------------------------------
+ * STATIC FUNCTIONS
+ * -------------------------------------------------------------- */
+
+// A predictable random number.
+static uint32_t randomNumber(uint32_t range)
+{
+    gSeed = (gSeed * 1103515245UL) + 12345UL;
+
+    return ((gSeed >> 8) & 0xFFFFFF) % range;
+}
+
+// Fill a buffer with random bytes.
+static void fillRandom(char *pBuffer, size_t length)
+{
+    for (size_t x = 0; x < length; x++) {
+        pBuffer[x] = (char) randomNumber(256);
+    }
+}
+
+// CRC24Q, done the long way as a check on the framer.
+static uint32_t rtcmCrc24q(const char *pBuffer, size_t length)
+{
+    uint32_t crc = 0;
+
+    for (size_t x = 0; x < length; x++) {
+        crc ^= ((uint32_t) (uint8_t) pBuffer[x]) << 16;
+        for (size_t y = 0; y < 8; y++) {
+            crc <<= 1;
+            if (crc & 0x1000000) {
+                crc ^= 0x1864CFB;
+            }
+        }
+    }
+
+    return crc & 0xFFFFFF;
+}
+
+// Write a UBX message to pBuffer, returning its length.
+static size_t writeUbx(char *pBuffer, uGnssFramerTestFrame_t *pFrame)
+{
+    char body[256];
+    size_t bodyLength = randomNumber(sizeof(body));
+    int32_t messageClass = (int32_t) randomNumber(256);
+    int32_t messageId = (int32_t) randomNumber(256);
+
+    fillRandom(body, bodyLength);
+    pFrame->protocol = U_GNSS_FRAMER_PROTOCOL_UBX;
+    pFrame->id = (uint16_t) ((messageClass << 8) | messageId);
+
+    return (size_t) uUbxProtocolEncode(messageClass, messageId, body, bodyLength, pBuffer);
+}
+
+// Write an NMEA sentence to pBuffer, returning its length.
+static size_t writeNmea(char *pBuffer, uGnssFramerTestFrame_t *pFrame)
+{
+    const char *pTalker[] = {"GP", "GN", "GA", "GB", "P"};
+    const char *pHex = "0123456789ABCDEF";
+    const char *pTalkerChosen = pTalker[randomNumber(sizeof(pTalker) / sizeof(pTalker[0]))];
+    const char *pStart = pBuffer;
+    size_t length = strlen(pTalkerChosen);
+    uint8_t crc = 0;
+
+    pFrame->protocol = U_GNSS_FRAMER_PROTOCOL_NMEA;
+    memcpy(pFrame->nmea, pTalkerChosen, length);
+    for (size_t x = 0; x < 3; x++) {
+        pFrame->nmea[length] = (char) ('A' + randomNumber(26));
+        length++;
+    }
+    pFrame->nmea[length] = '\0';
+    *pBuffer++ = '$';
+    memcpy(pBuffer, pFrame->nmea, length);
+    pBuffer += length;
+    *pBuffer++ = ',';
+    // Printable characters, other than '*', with plenty of ','
+    length = 10 + randomNumber(80);
+    for (size_t x = 0; x < length; x++) {
+        *pBuffer = (char) (' ' + randomNumber('~' - ' ' + 1));
+        if ((*pBuffer == '*') || (randomNumber(4) == 0)) {
+            *pBuffer = ',';
+        }
+        pBuffer++;
+    }
+    for (const char *pTmp = pStart + 1; pTmp < pBuffer; pTmp++) {
+        crc ^= (uint8_t) *pTmp;
+    }
+    *pBuffer++ = '*';
+    *pBuffer++ = pHex[crc >> 4];
+    *pBuffer++ = pHex[crc & 0x0F];
+    *pBuffer++ = '\r';
+    *pBuffer++ = '\n';
+
+    return pBuffer - pStart;
+}
+
+// Write an RTCM3 message to pBuffer, returning its length.
+static size_t writeRtcm(char *pBuffer, uGnssFramerTestFrame_t *pFrame)
+{
+    size_t length = 2 + randomNumber(256); // Message ID plus body
+    uint32_t crc;
+
+    pFrame->protocol = U_GNSS_FRAMER_PROTOCOL_RTCM;
+    pFrame->id = (uint16_t) randomNumber(4096);
+    pBuffer[0] = (char) 0xD3;
+    pBuffer[1] = (char) (length >> 8);
+    pBuffer[2] = (char) length;
+    fillRandom(pBuffer + 3, length);
+    pBuffer[3] = (char) (pFrame->id >> 4);
+    pBuffer[4] = (char) ((pFrame->id << 4) | (pBuffer[4] & 0x0F));
+    crc = rtcmCrc24q(pBuffer, 3 + length);
+    pBuffer[3 + length] = (char) (crc >> 16);
+    pBuffer[3 + length + 1] = (char) (crc >> 8);
+    pBuffer[3 + length + 2] = (char) crc;
+
+    return 3 + length + 3;
+}
+
+// Write a SPARTN message to pBuffer, returning its length; if
+// crcType is not U_SPARTN_CRC_TYPE_NONE it is used, else one
+// is picked at random.
+static size_t writeSpartn(char *pBuffer, uGnssFramerTestFrame_t *pFrame,
+                          uSpartnCrcType_t crcType)
+{
+    const size_t authLength[] = {8, 12, 16, 32, 64};
+    size_t payloadLength = randomNumber(200);
+    size_t messageType = randomNumber(128);
+    size_t subType = randomNumber(16);
+    bool encrypted = (randomNumber(2) == 0);
+    size_t length = 8;
+    uint8_t frameStart[3];
+    uint32_t crc;
+    size_t crcLength;
+    size_t authIndicator;
+    size_t authLengthIndex = 0;
+
+    if (crcType == U_SPARTN_CRC_TYPE_NONE) {
+        crcType = (uSpartnCrcType_t) randomNumber(4);
+    }
+    pFrame->protocol = U_GNSS_FRAMER_PROTOCOL_SPARTN;
+    pFrame->id = (uint16_t) ((messageType << 8) | subType);
+    // FRAME START
+    pBuffer[0] = 0x73;
+    pBuffer[1] = (char) ((messageType << 1) | ((payloadLength >> 9) & 0x01));
+    pBuffer[2] = (char) (payloadLength >> 1);
+    pBuffer[3] = (char) (((payloadLength & 0x01) << 7) | (encrypted << 6) | (crcType << 4));
+    frameStart[0] = (uint8_t) pBuffer[1];
+    frameStart[1] = (uint8_t) pBuffer[2];
+    frameStart[2] = (uint8_t) pBuffer[3];
+    pBuffer[3] = (char) (pBuffer[3] | uSpartnCrc4((const char *) frameStart, sizeof(frameStart)));
+    // PAYLOAD DESCRIPTION, the rest of which may be anything
+    fillRandom(pBuffer + 4, 8);
+    pBuffer[4] = (char) ((subType << 4) | (pBuffer[4] & 0x07));
+    if (randomNumber(2) == 0) {
+        // 32-bit time tag
+        pBuffer[4] |= 0x08;
+        length += 2;
+    }
+    if (encrypted) {
+        length += 2;
+        authIndicator = randomNumber(8);
+        if (authIndicator > 1) {
+            authLengthIndex = randomNumber(sizeof(authLength) / sizeof(authLength[0]));
+            payloadLength += authLength[authLengthIndex];
+        }
+        pBuffer[length - 1] = (char) ((pBuffer[length - 1] & 0xC0) |
+                                      (authIndicator << 3) | authLengthIndex);
+    }
+    // PAYLOAD and AUTHENTICATION
+    fillRandom(pBuffer + length, payloadLength);
+    length += payloadLength;
+    // Message CRC
+    crcLength = ((size_t) crcType) + 1;
+    switch (crcType) {
+        case U_SPARTN_CRC_TYPE_8:
+            crc = uSpartnCrc8(pBuffer + 1, length - 1);
+            break;
+        case U_SPARTN_CRC_TYPE_16:
+            crc = uSpartnCrc16(pBuffer + 1, length - 1);
+            break;
+        case U_SPARTN_CRC_TYPE_24:
+            crc = uSpartnCrc24(pBuffer + 1, length - 1);
+            break;
+        default:
+            crc = uSpartnCrc32(pBuffer + 1, length - 1);
+            break;
+    }
+    for (size_t x = 0; x < crcLength; x++) {
+        pBuffer[length + x] = (char) (crc >> (8 * (crcLength - 1 - x)));
+    }
+    length += crcLength;
+
+    // The SPARTN API must agree that this is a valid message
+    U_PORT_TEST_ASSERT(uSpartnValidate(pBuffer, length, NULL) == (int32_t) length);
+
+    return length;
+}
+
+// Write rubbish to pBuffer, returning its length: random bytes,
+// including the sync bytes of UBX, NMEA and RTCM, and the beginnings
+// of UBX, RTCM and SPARTN messages, which may claim to be longer than
+// the corpus that follows them.  The rubbish is chosen such that it
+// can't ever form a valid frame, even with the frames that follow.
+static size_t writeRubbish(char *pBuffer)
+{
+    const char syncBytes[] = {(char) 0xB5, '$', (char) 0xD3};
+    uGnssFramerTestFrame_t frame;
+    size_t length = 0;
+    size_t x;
+
+    switch (randomNumber(4)) {
+        case 0:
+            length = writeUbx(pBuffer, &frame);
+            break;
+        case 1:
+            length = writeRtcm(pBuffer, &frame);
+            break;
+        case 2:
+            // CRC-32 so that there can be no accidental match
+            length = writeSpartn(pBuffer, &frame, U_SPARTN_CRC_TYPE_32);
+            break;
+        default:
+            break;
+    }
+    if (length > 0) {
+        // Cut the message short
+        length = 1 + randomNumber(length - 1);
+    }
+    x = 1 + randomNumber(40);
+    fillRandom(pBuffer + length, x);
+    for (size_t y = length; y < length + x; y++) {
+        if (randomNumber(4) == 0) {
+            pBuffer[y] = syncBytes[randomNumber(sizeof(syncBytes))];
+        }
+        // Avoid the second byte of a UBX message, the end of an
+        // NMEA sentence and the SPARTN preamble
+        if ((pBuffer[y] == 0x62) || (pBuffer[y] == '\n') || (pBuffer[y] == 0x73)) {
+            pBuffer[y] = 0;
+        }
+    }
+
+    return length + x;
+}
+
+// Build the corpus, returning the number of frames in it; the
+// length of the corpus is written to pLength.
+static size_t buildCorpus(char *pCorpus, size_t size,
+                          uGnssFramerTestFrame_t *pFrames, size_t maxNumFrames,
+                          bool withRubbish, size_t *pLength)
+{
+    size_t numFrames = 0;
+    size_t length = 0;
+    uGnssFramerTestFrame_t *pFrame;
+
+    gSeed = 0;
+    while ((numFrames < maxNumFrames) &&
+           (length + U_GNSS_FRAMER_TEST_FRAME_LENGTH_MAX_BYTES <= size)) {
+        if (withRubbish && (randomNumber(3) == 0)) {
+            length += writeRubbish(pCorpus + length);
+        }
+        pFrame = &(pFrames[numFrames]);
+        memset(pFrame, 0, sizeof(*pFrame));
+        pFrame->offset = length;
+        switch (randomNumber(4)) {
+            case 0:
+                pFrame->length = writeUbx(pCorpus + length, pFrame);
+                break;
+            case 1:
+                pFrame->length = writeNmea(pCorpus + length, pFrame);
+                break;
+            case 2:
+                pFrame->length = writeRtcm(pCorpus + length, pFrame);
+                break;
+            default:
+                pFrame->length = writeSpartn(pCorpus + length, pFrame,
+                                             U_SPARTN_CRC_TYPE_NONE);
+                break;
+        }
+        length += pFrame->length;
+        numFrames++;
+    }
+    if (withRubbish) {
+        length += writeRubbish(pCorpus + length);
+    }
+    *pLength = length;
+
+    return numFrames;
+}
+
+// Return true if a frame matches one expected.
+static bool frameMatches(const uGnssFramerFrame_t *pFrame,
+                         const uGnssFramerTestFrame_t *pExpected,
+                         const char *pCorpus)
+{
+    bool matches = (pFrame->protocol == pExpected->protocol) &&
+                   (pFrame->length == pExpected->length);
+
+    if (matches) {
+        if (pFrame->protocol == U_GNSS_FRAMER_PROTOCOL_NMEA) {
+            matches = (strcmp(pFrame->id.nmea, pExpected->nmea) == 0);
+        } else {
+            // All of the uint16_t IDs are in the same place
+            matches = (pFrame->id.ubx == pExpected->id);
+        }
+    }
+    if (matches && (pFrame->pData != NULL)) {
+        matches = (memcmp(pFrame->pData, pCorpus + pExpected->offset,
+                          pFrame->length) == 0);
+    }
+
+    return matches;
+}
+
+// Check that a frame is the next one expected or, if exact is false,
+// one of those that follow; pIndex is the index of the next expected.
+static void checkFrame(const uGnssFramerFrame_t *pFrame, const char *pCorpus,
+                       const uGnssFramerTestFrame_t *pFrames, size_t numFrames,
+                       size_t *pIndex, bool exact)
+{
+    const uGnssFramerTestFrame_t *pExpected = NULL;
+
+    if (exact) {
+        U_PORT_TEST_ASSERT(pFrame->pData != NULL);
+    }
+    while ((pExpected == NULL) && (*pIndex < numFrames)) {
+        if (frameMatches(pFrame, &(pFrames[*pIndex]), pCorpus)) {
+            pExpected = &(pFrames[*pIndex]);
+        } else {
+            U_PORT_TEST_ASSERT(!exact);
+        }
+        (*pIndex)++;
+    }
+    U_PORT_TEST_ASSERT(pExpected != NULL);
+}
+
+// Feed the corpus to a framer in chunks of chunkSize, or random
+// sizes up to 300 if chunkSize is 0, and check that the frames
+// that come out are those expected; if exact is false the frames
+// must only be a subset, in order, of those expected. Returns the
+// number of frames found.
+static size_t feedAndCheck(uGnssFramer_t *pFramer, const char *pCorpus,
+                           size_t length, const uGnssFramerTestFrame_t *pFrames,
+                           size_t numFrames, size_t chunkSize, bool exact)
+{
+    uGnssFramerFrame_t frame;
+    size_t chunkStart = 0;
+    size_t chunkLength = 0;
+    size_t numFound = 0;
+    size_t y = 0;
+    int32_t x;
+
+    gSeed = 1;
+    while (chunkStart < length) {
+        chunkLength = chunkSize;
+        if (chunkLength == 0) {
+            chunkLength = 1 + randomNumber(300);
+        }
+        if (chunkLength > length - chunkStart) {
+            chunkLength = length - chunkStart;
+        }
+        do {
+            x = uGnssFramerFeed(pFramer, pCorpus + chunkStart, chunkLength, &frame);
+            U_PORT_TEST_ASSERT((x >= 0) && ((size_t) x <= chunkLength));
+            if (frame.protocol != U_GNSS_FRAMER_PROTOCOL_NONE) {
+                checkFrame(&frame, pCorpus, pFrames, numFrames, &y, exact);
+                numFound++;
+            }
+            chunkStart += x;
+            chunkLength -= x;
+        } while ((chunkLength > 0) || (frame.protocol != U_GNSS_FRAMER_PROTOCOL_NONE));
+    }
+    // Flush out anything held back by a partial frame at the end
+    do {
+        U_PORT_TEST_ASSERT(uGnssFramerFlush(pFramer, &frame) == 0);
+        if (frame.protocol != U_GNSS_FRAMER_PROTOCOL_NONE) {
+            checkFrame(&frame, pCorpus, pFrames, numFrames, &y, exact);
+            numFound++;
+        }
+    } while (frame.protocol != U_GNSS_FRAMER_PROTOCOL_NONE);
+
+    if (exact) {
+        U_PORT_TEST_ASSERT(numFound == numFrames);
+    }
+
+    return numFound;
+}
+
+// Print a throughput in Mbytes per second.
+static void printThroughput(const char *pName, size_t length, int32_t timeMs)
+{
+    int32_t kBytesPerSecond;
+
+    if (timeMs <= 0) {
+        timeMs = 1;
+    }
+    kBytesPerSecond = (int32_t) (((int64_t) length * 1000) / ((int64_t) timeMs * 1024));
+    U_TEST_PRINT_LINE("%s: %d byte(s) in %d ms, %d.%03d Mbytes/s.", pName,
+                      length, timeMs, kBytesPerSecond / 1024,
+                      ((kBytesPerSecond % 1024) * 1000) / 1024);
+}
+
+/* ----------------------------------------------------------------
+ * PUBLIC FUNCTIONS
+ * -------------------------------------------------------------- */
+
+/** Check that the framer finds all of the frames in a corpus of
+ * UBX, NMEA, RTCM and SPARTN messages interleaved with rubbish,
+ * however the corpus is chopped up.
+ */
+U_PORT_TEST_FUNCTION("[gnssFramer]", "gnssFramerBasic")
+{
+    int32_t resourceCount;
+    uGnssFramer_t framer;
+    uGnssFramerFrame_t frame;
+    size_t length = 0;
+    size_t numFrames;
+    size_t numFound;
+    const size_t chunkSize[] = {SIZE_MAX, 0, 1, 7, 64};
+
+    // Whatever called us likely initialised the
+    // port so deinitialise it here to obtain the
+    // correct initial heap size
+    uPortDeinit();
+    resourceCount = uTestUtilGetDynamicResourceCount();
+    U_PORT_TEST_ASSERT(uPortInit() == 0);
+
+    gpCorpus = (char *) pUPortMalloc(U_GNSS_FRAMER_TEST_CORPUS_LENGTH_BYTES);
+    U_PORT_TEST_ASSERT(gpCorpus != NULL);
+    gpFrames = (uGnssFramerTestFrame_t *) pUPortMalloc(sizeof(uGnssFramerTestFrame_t) *
+                                                       U_GNSS_FRAMER_TEST_MAX_NUM_FRAMES);
+    U_PORT_TEST_ASSERT(gpFrames != NULL);
+    gpBuffer = (char *) pUPortMalloc(U_GNSS_FRAMER_TEST_BUFFER_LENGTH_BYTES);
+    U_PORT_TEST_ASSERT(gpBuffer != NULL);
+
+    // Parameter checking
+    U_PORT_TEST_ASSERT(uGnssFramerInit(NULL, U_GNSS_FRAMER_PROTOCOLS_ALL, NULL, 0) < 0);
+    U_PORT_TEST_ASSERT(uGnssFramerInit(&framer, U_GNSS_FRAMER_PROTOCOLS_ALL, NULL, 1) < 0);
+    U_PORT_TEST_ASSERT(uGnssFramerInit(&framer, U_GNSS_FRAMER_PROTOCOLS_ALL, NULL, 0) == 0);
+    U_PORT_TEST_ASSERT(uGnssFramerFeed(&framer, NULL, 1, &frame) < 0);
+    U_PORT_TEST_ASSERT(uGnssFramerFeed(&framer, gpCorpus, 1, NULL) < 0);
+    U_PORT_TEST_ASSERT(uGnssFramerFeed(&framer, NULL, 0, &frame) == 0);
+    U_PORT_TEST_ASSERT(frame.protocol == U_GNSS_FRAMER_PROTOCOL_NONE);
+
+    numFrames = buildCorpus(gpCorpus, U_GNSS_FRAMER_TEST_CORPUS_LENGTH_BYTES,
+                            gpFrames, U_GNSS_FRAMER_TEST_MAX_NUM_FRAMES, true, &length);
+    U_TEST_PRINT_LINE("corpus is %d byte(s) containing %d frame(s).", length, numFrames);
+
+    // With a buffer, however the data is chopped up, all of the
+    // frames must be found
+    for (size_t x = 0; x < sizeof(chunkSize) / sizeof(chunkSize[0]); x++) {
+        U_TEST_PRINT_LINE("feeding %d byte(s) at a time (0 means random).",
+                          chunkSize[x] == SIZE_MAX ? (int32_t) length : (int32_t) chunkSize[x]);
+        U_PORT_TEST_ASSERT(uGnssFramerInit(&framer, U_GNSS_FRAMER_PROTOCOLS_ALL, gpBuffer,
+                                           U_GNSS_FRAMER_TEST_BUFFER_LENGTH_BYTES) == 0);
+        feedAndCheck(&framer, gpCorpus, length, gpFrames, numFrames,
+                     chunkSize[x] == SIZE_MAX ? length : chunkSize[x], true);
+    }
+
+    // Without a buffer, frames may be missed after rubbish but those
+    // that are found must be correct
+    U_PORT_TEST_ASSERT(uGnssFramerInit(&framer, U_GNSS_FRAMER_PROTOCOLS_ALL, NULL, 0) == 0);
+    numFound = feedAndCheck(&framer, gpCorpus, length, gpFrames, numFrames, 0, false);
+    U_TEST_PRINT_LINE("without a buffer %d of %d frame(s) found.", numFound, numFrames);
+    U_PORT_TEST_ASSERT(numFound > 0);
+
+    // Only find one protocol at a time: the frame count must match
+    for (int32_t x = 0; x < (int32_t) U_GNSS_FRAMER_PROTOCOL_MAX_NUM; x++) {
+        size_t numExpected = 0;
+        for (size_t y = 0; y < numFrames; y++) {
+            if (gpFrames[y].protocol == (uGnssFramerProtocol_t) x) {
+                numExpected++;
+            }
+        }
+        U_PORT_TEST_ASSERT(uGnssFramerInit(&framer, U_GNSS_FRAMER_PROTOCOL_BIT(x), gpBuffer,
+                                           U_GNSS_FRAMER_TEST_BUFFER_LENGTH_BYTES) == 0);
+        numFound = feedAndCheck(&framer, gpCorpus, length, gpFrames, numFrames, 0, false);
+        U_TEST_PRINT_LINE("protocol %d only: %d frame(s), expected %d.", x, numFound, numExpected);
+        U_PORT_TEST_ASSERT(numFound == numExpected);
+    }
+
+    // A reset part way through a frame loses only that frame
+    U_PORT_TEST_ASSERT(uGnssFramerInit(&framer, U_GNSS_FRAMER_PROTOCOLS_ALL, gpBuffer,
+                                       U_GNSS_FRAMER_TEST_BUFFER_LENGTH_BYTES) == 0);
+    U_PORT_TEST_ASSERT(uGnssFramerFeed(&framer, gpCorpus + gpFrames[1].offset,
+                                       gpFrames[1].length - 1, &frame) == (int32_t) gpFrames[1].length - 1);
+    U_PORT_TEST_ASSERT(frame.protocol == U_GNSS_FRAMER_PROTOCOL_NONE);
+    uGnssFramerReset(&framer);
+    U_PORT_TEST_ASSERT(uGnssFramerFeed(&framer, gpCorpus + gpFrames[2].offset,
+                                       gpFrames[2].length, &frame) == (int32_t) gpFrames[2].length);
+    U_PORT_TEST_ASSERT(frame.protocol == gpFrames[2].protocol);
+    U_PORT_TEST_ASSERT(frame.pData == gpCorpus + gpFrames[2].offset);
+
+    uPortFree(gpBuffer);
+    gpBuffer = NULL;
+    uPortFree(gpFrames);
+    gpFrames = NULL;
+    uPortFree(gpCorpus);
+    gpCorpus = NULL;
+
+    uPortDeinit();
+
+    // Check for resource leaks
+    uTestUtilResourceCheck(U_TEST_PREFIX, NULL, true);
+    resourceCount = uTestUtilGetDynamicResourceCount() - resourceCount;
+    U_TEST_PRINT_LINE("we have leaked %d resources(s).", resourceCount);
+    U_PORT_TEST_ASSERT(resourceCount <= 0);
+}
+
+/** Measure the throughput of the framer on a corpus of valid
+ * frames, fed to it in chunks of various sizes.
+ */
+U_PORT_TEST_FUNCTION("[gnssFramer]", "gnssFramerThroughput")
+{
+    int32_t resourceCount;
+    uGnssFramer_t framer;
+    uGnssFramerFrame_t frame;
+    size_t length = 0;
+    size_t numFrames;
+    size_t numFound;
+    size_t done;
+    size_t offset;
+    size_t chunkLength;
+    int32_t x;
+    int32_t startTimeMs;
+    const size_t chunkSize[] = {4096, 256, 16, 1};
+    char name[32];
+
+    // Whatever called us likely initialised the
+    // port so deinitialise it here to obtain the
+    // correct initial heap size
+    uPortDeinit();
+    resourceCount = uTestUtilGetDynamicResourceCount();
+    U_PORT_TEST_ASSERT(uPortInit() == 0);
+
+    gpCorpus = (char *) pUPortMalloc(U_GNSS_FRAMER_TEST_CORPUS_LENGTH_BYTES);
+    U_PORT_TEST_ASSERT(gpCorpus != NULL);
+    gpFrames = (uGnssFramerTestFrame_t *) pUPortMalloc(sizeof(uGnssFramerTestFrame_t) *
+                                                       U_GNSS_FRAMER_TEST_MAX_NUM_FRAMES);
+    U_PORT_TEST_ASSERT(gpFrames != NULL);
+    gpBuffer = (char *) pUPortMalloc(U_GNSS_FRAMER_TEST_BUFFER_LENGTH_BYTES);
+    U_PORT_TEST_ASSERT(gpBuffer != NULL);
+
+    numFrames = buildCorpus(gpCorpus, U_GNSS_FRAMER_TEST_CORPUS_LENGTH_BYTES,
+                            gpFrames, U_GNSS_FRAMER_TEST_MAX_NUM_FRAMES, false, &length);
+    U_TEST_PRINT_LINE("corpus is %d byte(s) containing %d frame(s), framing %d byte(s)"
+                      " for each chunk size.", length, numFrames,
+                      U_GNSS_FRAMER_TEST_BENCHMARK_LENGTH_BYTES);
+
+    for (size_t y = 0; y < sizeof(chunkSize) / sizeof(chunkSize[0]); y++) {
+        U_PORT_TEST_ASSERT(uGnssFramerInit(&framer, U_GNSS_FRAMER_PROTOCOLS_ALL, gpBuffer,
+                                           U_GNSS_FRAMER_TEST_BUFFER_LENGTH_BYTES) == 0);
+        numFound = 0;
+        done = 0;
+        startTimeMs = uPortGetTickTimeMs();
+        while (done < U_GNSS_FRAMER_TEST_BENCHMARK_LENGTH_BYTES) {
+            offset = 0;
+            while (offset < length) {
+                chunkLength = chunkSize[y];
+                if (chunkLength > length - offset) {
+                    chunkLength = length - offset;
+                }
+                do {
+                    x = uGnssFramerFeed(&framer, gpCorpus + offset, chunkLength, &frame);
+                    if (frame.protocol != U_GNSS_FRAMER_PROTOCOL_NONE) {
+                        numFound++;
+                    }
+                    offset += x;
+                    chunkLength -= x;
+                } while ((chunkLength > 0) || (frame.protocol != U_GNSS_FRAMER_PROTOCOL_NONE));
+            }
+            done += length;
+        }
+        snprintf(name, sizeof(name), "chunks of %d byte(s)", (int32_t) chunkSize[y]);
+        printThroughput(name, done, uPortGetTickTimeMs() - startTimeMs);
+        U_PORT_TEST_ASSERT(numFound == (done / length) * numFrames);
+    }
+
+    uPortFree(gpBuffer);
+    gpBuffer = NULL;
+    uPortFree(gpFrames);
+    gpFrames = NULL;
+    uPortFree(gpCorpus);
+    gpCorpus = NULL;
+
+    uPortDeinit();
+
+    // Check for resource leaks
+    uTestUtilResourceCheck(U_TEST_PREFIX, NULL, true);
+    resourceCount = uTestUtilGetDynamicResourceCount() - resourceCount;
+    U_TEST_PRINT_LINE("we have leaked %d resources(s).", resourceCount);
+    U_PORT_TEST_ASSERT(resourceCount <= 0);
+}
+
+/** Clean-up to be run at the end of this round of tests, just
+ * in case there were test failures which would have resulted
+ * in the deinitialisation being skipped.
+ */
+U_PORT_TEST_FUNCTION("[gnssFramer]", "gnssFramerCleanUp")
+{
+    uPortFree(gpBuffer);
+    gpBuffer = NULL;
+    uPortFree(gpFrames);
+    gpFrames = NULL;
+    uPortFree(gpCorpus);
+    gpCorpus = NULL;
+    uPortDeinit();
+    // Printed for information: asserting happens in the postamble
+    uTestUtilResourceCheck(U_TEST_PREFIX, NULL, true);
+}
+
+// End of file
@@ -0,0 +1,571 @@
+/*
+ * Copyright 2019-2024 u-blox
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* Only #includes of u_* and the C standard library are allowed here,
+ * no platform stuff and no OS stuff.  Anything required from
+ * the platform/OS must be brought in through u_port* to maintain
+ * portability.
+ */
+
+/** @file
+ * @brief Tests for the GNSS NMEA decoder API: they do not require
+ * a GNSS module to run, hence these should pass on all platforms.
+ * IMPORTANT: see notes in u_cfg_test_platform_specific.h for the
+ * naming rules that must be followed when using the U_PORT_TEST_FUNCTION()
+ * macro.
+ */
+
+# ifdef U_CFG_OVERRIDE
+#  include "u_cfg_override.h" // For a customer's configuration override
+# endif
+
+#include "stddef.h"    // NULL, size_t etc.
+#include "stdint.h"    // int32_t etc.
+#include "stdbool.h"
+#include "stdlib.h"    // strtod()
+#include "string.h"    // memset(), memcpy(), strlen(), strtok_r()
+
+#include "u_cfg_sw.h"
+#include "u_cfg_os_platform_specific.h"
+#include "u_cfg_app_platform_specific.h"
+#include "u_cfg_test_platform_specific.h"
+
+#include "u_error_common.h"
+
+#include "u_port_clib_platform_specific.h" /* strtok_r and integer stdio, must
+                                              be included before the other port
+                                              files if any print or scan function
+                                              is used. */
+#include "u_port.h"
+#include "u_port_os.h"
+#include "u_port_heap.h"
+#include "u_port_debug.h"
+
+#include "u_test_util_resource_check.h"
+
+#include "u_gnss_nmea.h"
+
+/* ----------------------------------------------------------------
+ * COMPILE-TIME MACROS
+ * -------------------------------------------------------------- */
+
+/** The string to put at the start of all prints from this test.
+ */
+#define U_TEST_PREFIX "U_GNSS_NMEA_TEST: "
+
+/** Print a whole line, with terminator, prefixed for this test file.
+ */
+#define U_TEST_PRINT_LINE(format, ...) uPortLog(U_TEST_PREFIX format "\n", ##__VA_ARGS__)
+
+#ifndef U_GNSS_NMEA_TEST_BENCHMARK_NUM_PASSES
+/** The number of times the stream is passed through each decoder
+ * in the benchmark.
+ */
+# define U_GNSS_NMEA_TEST_BENCHMARK_NUM_PASSES 1000
+#endif
+
+/** The size of chunk in which the benchmark feeds the stream to
+ * the decoder, like a UART read.
+ */
+#define U_GNSS_NMEA_TEST_BENCHMARK_CHUNK_LENGTH_BYTES 256
+
+/** The time 14:38:58 in milliseconds.
+ */
+#define U_GNSS_NMEA_TEST_TIME_MS (((14 * 3600) + (38 * 60) + 58) * 1000)
+
+/* ----------------------------------------------------------------
+ * TYPES
+ * -------------------------------------------------------------- */
+
+/* ----------------------------------------------------------------
+ * VARIABLES
+ * -------------------------------------------------------------- */
+
+/** A stream of NMEA sentences recorded from a ZED-F9P (the same as
+ * in the comment above uGnssTestPrivateNmeaComprehender() in
+ * u_gnss_test_private.c) plus, on the end, some sentences it wasn't
+ * emitting: a GST, a ZDA, a GGA in the south-west and a GGA with no
+ * fix.
+ */
+static const char *const gpStream[] = {
+    "$GNRMC,143858.00,A,4710.5737891,N,00825.4665003,E,0.009,,180922,2.83,E,D,V*40\r\n",
+    "$GNVTG,,T,,M,0.009,N,0.016,K,D*36\r\n",
+    "$GNGGA,143858.00,4710.5737891,N,00825.4665003,E,2,12,0.58,459.860,M,47.319,M,,0123*4B\r\n",
+    "$GNGSA,A,3,02,05,06,09,11,20,07,30,,,,,1.24,0.58,1.10,1*05\r\n",
+    "$GNGSA,A,3,76,67,82,81,75,65,66,,,,,,1.24,0.58,1.10,2*0A\r\n",
+    "$GNGSA,A,3,30,33,12,26,19,07,,,,,,,1.24,0.58,1.10,3*02\r\n",
+    "$GNGSA,A,3,20,32,37,46,19,,,,,,,,1.24,0.58,1.10,4*03\r\n",
+    "$GNGSA,A,3,,,,,,,,,,,,,1.24,0.58,1.10,5*0F\r\n",
+    "$GPGSV,3,1,11,02,26,307,37,05,16,309,45,06,30,212,43,07,73,126,48,1*60\r\n",
+    "$GPGSV,3,2,11,09,48,072,41,11,44,251,46,13,07,259,31,20,54,298,43,1*6A\r\n",
+    "$GPGSV,3,3,11,30,50,195,46,36,31,150,45,49,36,185,44,1*5B\r\n",
+    "$GPGSV,2,1,08,04,12,077,23,05,16,309,46,06,30,212,41,07,73,126,43,6*64\r\n",
+    "$GPGSV,2,2,08,09,48,072,40,11,44,251,38,29,03,323,26,30,50,195,47,6*64\r\n",
+    "$GLGSV,3,1,09,65,37,088,48,66,66,346,42,67,21,297,50,75,44,053,32,1*71\r\n",
+    "$GLGSV,3,2,09,76,45,141,48,77,08,177,35,81,20,246,47,82,29,299,50,1*79\r\n",
+    "$GLGSV,3,3,09,83,13,343,16,1*4B\r\n",
+    "$GLGSV,3,1,09,65,37,088,41,66,66,346,39,67,21,297,42,75,44,053,37,3*70\r\n",
+    "$GLGSV,3,2,09,76,45,141,44,77,08,177,28,81,20,246,46,82,29,299,40,3*7B\r\n",
+    "$GLGSV,3,3,09,83,13,343,23,3*4F\r\n",
+    "$GLGSV,1,1,01,74,02,018,,0*40\r\n",
+    "$GAGSV,2,1,08,07,54,073,40,10,08,335,37,12,23,316,47,19,22,272,36,2*7C\r\n",
+    "$GAGSV,2,2,08,26,19,204,43,27,21,142,30,30,32,083,47,33,39,256,46,2*72\r\n",
+    "$GAGSV,3,1,09,07,54,073,34,10,08,335,38,12,23,316,38,19,22,272,41,7*7D\r\n",
+    "$GAGSV,3,2,09,20,,,34,26,19,204,42,27,21,142,18,30,32,083,44,7*43\r\n",
+    "$GAGSV,3,3,09,33,39,256,44,7*41\r\n",
+    "$GAGSV,1,1,01,08,04,085,,0*44\r\n",
+    "$GBGSV,2,1,07,19,36,297,41,20,84,015,43,32,32,108,50,37,55,118,46,1*79\r\n",
+    "$GBGSV,2,2,07,46,22,183,43,56,,,38,57,,,44,1*44\r\n",
+    "$GQGSV,1,1,00,0*64\r\n",
+    "$GNGLL,4710.5737891,N,00825.4665003,E,143858.00,A,D*78\r\n",
+    "$GNGST,143858.00,12.3,1.25,0.845,83.51,1.05,1.1,2.358*72\r\n",
+    "$GNZDA,143858.00,18,09,2022,-02,30*55\r\n",
+    "$GNGGA,143858.00,3342.6618,S,07036.3120,W,1,08,1.01,-12.5,M,-3.2,M,,*4C\r\n",
+    "$GPGGA,143858.00,,,,,0,00,99.99,,,,,,*65\r\n"
+};
+
+/** The number of sentences of each #uGnssNmeaSentenceType_t in
+ * gpStream.
+ */
+static const size_t gNumSentences[U_GNSS_NMEA_SENTENCE_TYPE_MAX_NUM] = {
+    3,  // U_GNSS_NMEA_SENTENCE_TYPE_GGA
+    1,  // U_GNSS_NMEA_SENTENCE_TYPE_RMC
+    5,  // U_GNSS_NMEA_SENTENCE_TYPE_GSA
+    21, // U_GNSS_NMEA_SENTENCE_TYPE_GSV
+    1,  // U_GNSS_NMEA_SENTENCE_TYPE_VTG
+    1,  // U_GNSS_NMEA_SENTENCE_TYPE_GST
+    1   // U_GNSS_NMEA_SENTENCE_TYPE_ZDA
+};
+
+/** The stream, concatenated.
+ */
+static char *gpBuffer = NULL;
+
+/* ----------------------------------------------------------------
+ * STATIC FUNCTIONS
+ * -------------------------------------------------------------- */
+
+// Concatenate gpStream into gpBuffer, returning the length.
+static size_t streamBuild()
+{
+    size_t length = 0;
+
+    for (size_t x = 0; x < sizeof(gpStream) / sizeof(gpStream[0]); x++) {
+        length += strlen(gpStream[x]);
+    }
+    gpBuffer = (char *) pUPortMalloc(length);
+    U_PORT_TEST_ASSERT(gpBuffer != NULL);
+    length = 0;
+    for (size_t x = 0; x < sizeof(gpStream) / sizeof(gpStream[0]); x++) {
+        memcpy(gpBuffer + length, gpStream[x], strlen(gpStream[x]));
+        length += strlen(gpStream[x]);
+    }
+
+    return length;
+}
+
+// Decode a sentence of gpStream, checking that it is of the given type.
+static void decode(size_t index, uGnssNmeaSentenceType_t type,
+                   uGnssNmeaSentence_t *pSentence)
+{
+    U_PORT_TEST_ASSERT(uGnssNmeaDecode(gpStream[index], strlen(gpStream[index]),
+                                       pSentence) == 0);
+    U_PORT_TEST_ASSERT(pSentence->type == type);
+}
+
+// Print a result of the benchmark.
+static void printResult(const char *pName, size_t numSentences,
+                        size_t length, int32_t timeMs)
+{
+    int32_t kBytesPerSecond;
+
+    if (timeMs <= 0) {
+        timeMs = 1;
+    }
+    kBytesPerSecond = (int32_t) (((int64_t) length * 1000) / ((int64_t) timeMs * 1024));
+    U_TEST_PRINT_LINE("%s: %d sentence(s), %d byte(s) in %d ms, %d ns per sentence,"
+                      " %d.%03d Mbytes/s.", pName, numSentences, length, timeMs,
+                      (int32_t) (((int64_t) timeMs * 1000000) / numSentences),
+                      kBytesPerSecond / 1024, ((kBytesPerSecond % 1024) * 1000) / 1024);
+}
+
+// The way it would be done without uGnssNmeaFeed(): find each
+// sentence, copy it, check the checksum, split it with strtok_r()
+// and convert every field with strtod(), returning the number of
+// sentences.
+static size_t baseline(const char *pData, size_t length, double *pSum)
+{
+    char sentence[U_GNSS_NMEA_SENTENCE_LENGTH_MAX_BYTES + 1];
+    size_t numSentences = 0;
+    const char *pEnd;
+    const char *pStar;
+    char *pField;
+    char *pSaved = NULL;
+    uint8_t checksum;
+    size_t sentenceLength;
+
+    while (length > 0) {
+        pEnd = (const char *) memchr(pData, '\n', length);
+        if (pEnd == NULL) {
+            break;
+        }
+        sentenceLength = pEnd - pData + 1;
+        if ((*pData == '$') && (sentenceLength < sizeof(sentence))) {
+            memcpy(sentence, pData, sentenceLength);
+            sentence[sentenceLength] = 0;
+            pStar = strchr(sentence, '*');
+            if (pStar != NULL) {
+                checksum = 0;
+                for (const char *pChar = sentence + 1; pChar < pStar; pChar++) {
+                    checksum ^= (uint8_t) *pChar;
+                }
+                if (checksum == (uint8_t) strtol(pStar + 1, NULL, 16)) {
+                    numSentences++;
+                    for (pField = strtok_r(sentence + 1, ",*", &pSaved);
+                         (pField != NULL) && (pField < pStar);
+                         pField = strtok_r(NULL, ",*", &pSaved)) {
+                        *pSum += strtod(pField, NULL);
+                    }
+                }
+            }
+        }
+        pData += sentenceLength;
+        length -= sentenceLength;
+    }
+
+    return numSentences;
+}
+
+/* ----------------------------------------------------------------
+ * PUBLIC FUNCTIONS
+ * -------------------------------------------------------------- */
+
+/** Decode a recorded NMEA stream, chopped up in various ways, and
+ * check the contents of each type of sentence.
+ */
+U_PORT_TEST_FUNCTION("[gnssNmea]", "gnssNmeaBasic")
+{
+    int32_t resourceCount;
+    uGnssNmea_t nmea;
+    uGnssNmeaSentence_t sentence;
+    size_t numSentences[U_GNSS_NMEA_SENTENCE_TYPE_MAX_NUM];
+    size_t length;
+    size_t offset;
+    size_t chunkLength;
+    size_t y;
+    int32_t x;
+    const size_t chunkSize[] = {0 /* all in one */, 64, 7, 1};
+    const char *pRmc = gpStream[0];
+    const char *pBad;
+
+    // Get the initial resource count
+    resourceCount = uTestUtilGetDynamicResourceCount();
+
+    U_PORT_TEST_ASSERT(uGnssNmeaInit(NULL) < 0);
+    U_PORT_TEST_ASSERT(uGnssNmeaInit(&nmea) == 0);
+    U_PORT_TEST_ASSERT(uGnssNmeaFeed(NULL, "$", 1, &sentence) < 0);
+    U_PORT_TEST_ASSERT(uGnssNmeaFeed(&nmea, "$", 1, NULL) < 0);
+    U_PORT_TEST_ASSERT(uGnssNmeaFeed(&nmea, NULL, 1, &sentence) < 0);
+    U_PORT_TEST_ASSERT(uGnssNmeaDecode(NULL, 1, &sentence) < 0);
+
+    length = streamBuild();
+
+    // Feed the stream in chunks, counting the sentences of each type
+    for (size_t z = 0; z < sizeof(chunkSize) / sizeof(chunkSize[0]); z++) {
+        U_TEST_PRINT_LINE("feeding %d byte(s) of NMEA in chunks of %d byte(s).",
+                          length, chunkSize[z] > 0 ? chunkSize[z] : length);
+        U_PORT_TEST_ASSERT(uGnssNmeaInit(&nmea) == 0);
+        memset(numSentences, 0, sizeof(numSentences));
+        for (offset = 0; offset < length; offset += chunkLength) {
+            chunkLength = chunkSize[z] > 0 ? chunkSize[z] : length;
+            if (chunkLength > length - offset) {
+                chunkLength = length - offset;
+            }
+            for (y = 0; y < chunkLength; y += x) {
+                x = uGnssNmeaFeed(&nmea, gpBuffer + offset + y, chunkLength - y, &sentence);
+                U_PORT_TEST_ASSERT(x >= 0);
+                if (sentence.type != U_GNSS_NMEA_SENTENCE_TYPE_NONE) {
+                    U_PORT_TEST_ASSERT(sentence.type < U_GNSS_NMEA_SENTENCE_TYPE_MAX_NUM);
+                    numSentences[sentence.type]++;
+                }
+            }
+        }
+        for (y = 0; y < U_GNSS_NMEA_SENTENCE_TYPE_MAX_NUM; y++) {
+            U_PORT_TEST_ASSERT(numSentences[y] == gNumSentences[y]);
+        }
+        U_PORT_TEST_ASSERT(nmea.errorCount == 0);
+    }
+
+    // Check the contents of each type
+    U_TEST_PRINT_LINE("checking sentence contents.");
+    decode(0, U_GNSS_NMEA_SENTENCE_TYPE_RMC, &sentence);
+    U_PORT_TEST_ASSERT(strcmp(sentence.talker, "GN") == 0);
+    U_PORT_TEST_ASSERT(sentence.fieldsPresent == 0x1F7F);
+    U_PORT_TEST_ASSERT(sentence.rmc.timeMs == U_GNSS_NMEA_TEST_TIME_MS);
+    U_PORT_TEST_ASSERT(sentence.rmc.status == 'A');
+    U_PORT_TEST_ASSERT(sentence.rmc.latitudeX1e7 == 471762298);
+    U_PORT_TEST_ASSERT(sentence.rmc.longitudeX1e7 == 84244417);
+    U_PORT_TEST_ASSERT(sentence.rmc.speedKnotsX1000 == 9);
+    U_PORT_TEST_ASSERT(!U_GNSS_NMEA_FIELD_PRESENT(&sentence, 7));
+    U_PORT_TEST_ASSERT(sentence.rmc.day == 18);
+    U_PORT_TEST_ASSERT(sentence.rmc.month == 9);
+    U_PORT_TEST_ASSERT(sentence.rmc.year == 2022);
+    U_PORT_TEST_ASSERT(sentence.rmc.magneticVariationX100 == 283);
+    U_PORT_TEST_ASSERT(sentence.rmc.posMode == 'D');
+    U_PORT_TEST_ASSERT(sentence.rmc.navStatus == 'V');
+
+    decode(1, U_GNSS_NMEA_SENTENCE_TYPE_VTG, &sentence);
+    U_PORT_TEST_ASSERT(sentence.fieldsPresent == 0x1FA);
+    U_PORT_TEST_ASSERT(sentence.vtg.speedKnotsX1000 == 9);
+    U_PORT_TEST_ASSERT(sentence.vtg.speedKilometresPerHourX1000 == 16);
+    U_PORT_TEST_ASSERT(sentence.vtg.posMode == 'D');
+
+    decode(2, U_GNSS_NMEA_SENTENCE_TYPE_GGA, &sentence);
+    U_PORT_TEST_ASSERT(sentence.fieldsPresent == 0x2FFF);
+    U_PORT_TEST_ASSERT(sentence.gga.timeMs == U_GNSS_NMEA_TEST_TIME_MS);
+    U_PORT_TEST_ASSERT(sentence.gga.latitudeX1e7 == 471762298);
+    U_PORT_TEST_ASSERT(sentence.gga.longitudeX1e7 == 84244417);
+    U_PORT_TEST_ASSERT(sentence.gga.quality == 2);
+    U_PORT_TEST_ASSERT(sentence.gga.numSv == 12);
+    U_PORT_TEST_ASSERT(sentence.gga.hdopX100 == 58);
+    U_PORT_TEST_ASSERT(sentence.gga.altitudeMillimetres == 459860);
+    U_PORT_TEST_ASSERT(sentence.gga.separationMillimetres == 47319);
+    U_PORT_TEST_ASSERT(sentence.gga.diffStation == 123);
+
+    decode(3, U_GNSS_NMEA_SENTENCE_TYPE_GSA, &sentence);
+    U_PORT_TEST_ASSERT(sentence.gsa.opMode == 'A');
+    U_PORT_TEST_ASSERT(sentence.gsa.navMode == 3);
+    U_PORT_TEST_ASSERT(sentence.gsa.numSv == 8);
+    U_PORT_TEST_ASSERT((sentence.gsa.svId[0] == 2) && (sentence.gsa.svId[7] == 30));
+    U_PORT_TEST_ASSERT(sentence.gsa.pdopX100 == 124);
+    U_PORT_TEST_ASSERT(sentence.gsa.hdopX100 == 58);
+    U_PORT_TEST_ASSERT(sentence.gsa.vdopX100 == 110);
+    U_PORT_TEST_ASSERT(sentence.gsa.systemId == 1);
+    decode(7, U_GNSS_NMEA_SENTENCE_TYPE_GSA, &sentence);
+    U_PORT_TEST_ASSERT(sentence.gsa.numSv == 0);
+    U_PORT_TEST_ASSERT(sentence.gsa.systemId == 5);
+
+    decode(10, U_GNSS_NMEA_SENTENCE_TYPE_GSV, &sentence);
+    U_PORT_TEST_ASSERT(strcmp(sentence.talker, "GP") == 0);
+    U_PORT_TEST_ASSERT(sentence.gsv.numMsg == 3);
+    U_PORT_TEST_ASSERT(sentence.gsv.msgNum == 3);
+    U_PORT_TEST_ASSERT(sentence.gsv.numSvInView == 11);
+    U_PORT_TEST_ASSERT(sentence.gsv.numSat == 3);
+    U_PORT_TEST_ASSERT(sentence.gsv.sat[2].svId == 49);
+    U_PORT_TEST_ASSERT(sentence.gsv.sat[2].elevation == 36);
+    U_PORT_TEST_ASSERT(sentence.gsv.sat[2].azimuth == 185);
+    U_PORT_TEST_ASSERT(sentence.gsv.sat[2].cno == 44);
+    U_PORT_TEST_ASSERT(sentence.gsv.sat[3].svId == 0);
+    U_PORT_TEST_ASSERT(sentence.gsv.signalId == 1);
+    decode(11, U_GNSS_NMEA_SENTENCE_TYPE_GSV, &sentence);
+    U_PORT_TEST_ASSERT(sentence.gsv.numSat == 4);
+    U_PORT_TEST_ASSERT(sentence.gsv.sat[3].svId == 7);
+    U_PORT_TEST_ASSERT(sentence.gsv.signalId == 6);
+    decode(19, U_GNSS_NMEA_SENTENCE_TYPE_GSV, &sentence);
+    U_PORT_TEST_ASSERT(sentence.gsv.numSat == 1);
+    U_PORT_TEST_ASSERT(sentence.gsv.sat[0].svId == 74);
+    U_PORT_TEST_ASSERT(!U_GNSS_NMEA_FIELD_PRESENT(&sentence, 6));
+    U_PORT_TEST_ASSERT(U_GNSS_NMEA_FIELD_PRESENT(&sentence, 7));
+    U_PORT_TEST_ASSERT(sentence.gsv.signalId == 0);
+    decode(23, U_GNSS_NMEA_SENTENCE_TYPE_GSV, &sentence);
+    U_PORT_TEST_ASSERT(sentence.gsv.sat[0].svId == 20);
+    U_PORT_TEST_ASSERT(!U_GNSS_NMEA_FIELD_PRESENT(&sentence, 4));
+    U_PORT_TEST_ASSERT(!U_GNSS_NMEA_FIELD_PRESENT(&sentence, 5));
+    U_PORT_TEST_ASSERT(sentence.gsv.sat[0].cno == 34);
+    decode(28, U_GNSS_NMEA_SENTENCE_TYPE_GSV, &sentence);
+    U_PORT_TEST_ASSERT(sentence.gsv.numSvInView == 0);
+    U_PORT_TEST_ASSERT(sentence.gsv.numSat == 0);
+    U_PORT_TEST_ASSERT(U_GNSS_NMEA_FIELD_PRESENT(&sentence, 3));
+
+    decode(30, U_GNSS_NMEA_SENTENCE_TYPE_GST, &sentence);
+    U_PORT_TEST_ASSERT(sentence.fieldsPresent == 0xFF);
+    U_PORT_TEST_ASSERT(sentence.gst.timeMs == U_GNSS_NMEA_TEST_TIME_MS);
+    U_PORT_TEST_ASSERT(sentence.gst.rangeRmsMillimetres == 12300);
+    U_PORT_TEST_ASSERT(sentence.gst.stdMajorMillimetres == 1250);
+    U_PORT_TEST_ASSERT(sentence.gst.stdMinorMillimetres == 845);
+    U_PORT_TEST_ASSERT(sentence.gst.orientationX100 == 8351);
+    U_PORT_TEST_ASSERT(sentence.gst.stdLatitudeMillimetres == 1050);
+    U_PORT_TEST_ASSERT(sentence.gst.stdLongitudeMillimetres == 1100);
+    U_PORT_TEST_ASSERT(sentence.gst.stdAltitudeMillimetres == 2358);
+
+    decode(31, U_GNSS_NMEA_SENTENCE_TYPE_ZDA, &sentence);
+    U_PORT_TEST_ASSERT(sentence.zda.timeMs == U_GNSS_NMEA_TEST_TIME_MS);
+    U_PORT_TEST_ASSERT(sentence.zda.day == 18);
+    U_PORT_TEST_ASSERT(sentence.zda.month == 9);
+    U_PORT_TEST_ASSERT(sentence.zda.year == 2022);
+    U_PORT_TEST_ASSERT(sentence.zda.localZoneHours == -2);
+    U_PORT_TEST_ASSERT(sentence.zda.localZoneMinutes == 30);
+
+    decode(32, U_GNSS_NMEA_SENTENCE_TYPE_GGA, &sentence);
+    U_PORT_TEST_ASSERT(sentence.gga.latitudeX1e7 == -337110300);
+    U_PORT_TEST_ASSERT(sentence.gga.longitudeX1e7 == -706052000);
+    U_PORT_TEST_ASSERT(sentence.gga.altitudeMillimetres == -12500);
+    U_PORT_TEST_ASSERT(sentence.gga.separationMillimetres == -3200);
+    U_PORT_TEST_ASSERT(!U_GNSS_NMEA_FIELD_PRESENT(&sentence, 13));
+
+    decode(33, U_GNSS_NMEA_SENTENCE_TYPE_GGA, &sentence);
+    U_PORT_TEST_ASSERT(sentence.fieldsPresent == 0xE1);
+    U_PORT_TEST_ASSERT(sentence.gga.latitudeX1e7 == 0);
+    U_PORT_TEST_ASSERT(sentence.gga.hdopX100 == 9999);
+
+    // A sentence we don't decode
+    U_PORT_TEST_ASSERT(uGnssNmeaDecode(gpStream[29], strlen(gpStream[29]),
+                                       &sentence) == (int32_t) U_ERROR_COMMON_NOT_FOUND);
+    U_PORT_TEST_ASSERT(sentence.type == U_GNSS_NMEA_SENTENCE_TYPE_NONE);
+
+    // Split the RMC sentence in two at every point, as the spans of a
+    // ring buffer might, and check that it is the same each time; the
+    // sentence is complete at the last checksum digit, before the CR LF
+    U_TEST_PRINT_LINE("feeding an RMC sentence split in two.");
+    for (size_t z = 0; z < strlen(pRmc) - 2; z++) {
+        U_PORT_TEST_ASSERT(uGnssNmeaInit(&nmea) == 0);
+        x = uGnssNmeaFeed(&nmea, pRmc, z, &sentence);
+        U_PORT_TEST_ASSERT((x == (int32_t) z) && (sentence.type == U_GNSS_NMEA_SENTENCE_TYPE_NONE));
+        x = uGnssNmeaFeed(&nmea, pRmc + z, strlen(pRmc) - z, &sentence);
+        U_PORT_TEST_ASSERT(x == (int32_t) (strlen(pRmc) - z - 2));
+        U_PORT_TEST_ASSERT(sentence.type == U_GNSS_NMEA_SENTENCE_TYPE_RMC);
+        U_PORT_TEST_ASSERT(sentence.rmc.longitudeX1e7 == 84244417);
+        U_PORT_TEST_ASSERT(sentence.fieldsPresent == 0x1F7F);
+    }
+
+    // Broken sentences
+    U_TEST_PRINT_LINE("feeding broken sentences.");
+    U_PORT_TEST_ASSERT(uGnssNmeaInit(&nmea) == 0);
+    // Bad checksum
+    pBad = "$GNZDA,143858.00,18,09,2022,-02,30*56\r\n";
+    U_PORT_TEST_ASSERT(uGnssNmeaFeed(&nmea, pBad, strlen(pBad), &sentence) == (int32_t) strlen(pBad));
+    U_PORT_TEST_ASSERT(sentence.type == U_GNSS_NMEA_SENTENCE_TYPE_NONE);
+    U_PORT_TEST_ASSERT(nmea.errorCount == 1);
+    // No checksum
+    pBad = "$GNZDA,143858.00,18,09,2022,-02,30\r\n";
+    U_PORT_TEST_ASSERT(uGnssNmeaFeed(&nmea, pBad, strlen(pBad), &sentence) == (int32_t) strlen(pBad));
+    U_PORT_TEST_ASSERT(sentence.type == U_GNSS_NMEA_SENTENCE_TYPE_NONE);
+    U_PORT_TEST_ASSERT(nmea.errorCount == 2);
+    // Cut short by the start of another sentence
+    pBad = "$GNGGA,1438\xb5\x62$GNZDA,143858.00,18,09,2022,-02,30*55\r\n";
+    U_PORT_TEST_ASSERT(uGnssNmeaFeed(&nmea, pBad, strlen(pBad), &sentence) == (int32_t) strlen(pBad) - 2);
+    U_PORT_TEST_ASSERT(sentence.type == U_GNSS_NMEA_SENTENCE_TYPE_ZDA);
+    U_PORT_TEST_ASSERT(sentence.zda.year == 2022);
+    // Nonsense in a field, which is treated as not present
+    pBad = "$GNZDA,143858.00,1x,09,2022,-02,30*15\r\n";
+    U_PORT_TEST_ASSERT(uGnssNmeaDecode(pBad, strlen(pBad), &sentence) == 0);
+    U_PORT_TEST_ASSERT(sentence.fieldsPresent == 0x3D);
+    U_PORT_TEST_ASSERT(sentence.zda.day == 0);
+    // Too long
+    pBad = "$GNZDA,00000000000000000000000000000000000000000000000000000000000000000000000000000000"
+           "0000000000000000000000000000000000000000000000000000000000000000*55\r\n";
+    U_PORT_TEST_ASSERT(uGnssNmeaDecode(pBad, strlen(pBad), &sentence) == (int32_t) U_ERROR_COMMON_NOT_FOUND);
+
+    uPortFree(gpBuffer);
+    gpBuffer = NULL;
+
+    // Check for resource leaks
+    uTestUtilResourceCheck(U_TEST_PREFIX, NULL, true);
+    resourceCount = uTestUtilGetDynamicResourceCount() - resourceCount;
+    U_TEST_PRINT_LINE("we have leaked %d resources(s).", resourceCount);
+    U_PORT_TEST_ASSERT(resourceCount <= 0);
+}
+
+/** Benchmark decoding the recorded NMEA stream: first the way an
+ * application would do it without this code, finding each sentence,
+ * copying it, splitting it with strtok_r() and converting every field
+ * with strtod(), then with uGnssNmeaFeed().
+ */
+U_PORT_TEST_FUNCTION("[gnssNmea]", "gnssNmeaBenchmark")
+{
+    int32_t resourceCount;
+    uGnssNmea_t nmea;
+    uGnssNmeaSentence_t sentence;
+    size_t length;
+    size_t numSentences;
+    size_t numSentencesBaseline;
+    size_t offset;
+    size_t chunkLength;
+    size_t y;
+    int32_t x;
+    int32_t startTimeMs;
+    double sum = 0;
+
+    // Get the initial resource count
+    resourceCount = uTestUtilGetDynamicResourceCount();
+
+    length = streamBuild();
+    U_TEST_PRINT_LINE("decoding %d byte(s) of NMEA %d time(s).", length,
+                      U_GNSS_NMEA_TEST_BENCHMARK_NUM_PASSES);
+
+    // Before
+    numSentencesBaseline = 0;
+    startTimeMs = uPortGetTickTimeMs();
+    for (size_t z = 0; z < U_GNSS_NMEA_TEST_BENCHMARK_NUM_PASSES; z++) {
+        numSentencesBaseline += baseline(gpBuffer, length, &sum);
+    }
+    printResult("strtok_r()/strtod()", numSentencesBaseline,
+                length * U_GNSS_NMEA_TEST_BENCHMARK_NUM_PASSES,
+                uPortGetTickTimeMs() - startTimeMs);
+    U_PORT_TEST_ASSERT(numSentencesBaseline == (sizeof(gpStream) / sizeof(gpStream[0])) *
+                       U_GNSS_NMEA_TEST_BENCHMARK_NUM_PASSES);
+
+    // After: all of the sentences are passed through, though only
+    // those of a known type are decoded
+    uGnssNmeaInit(&nmea);
+    numSentences = 0;
+    startTimeMs = uPortGetTickTimeMs();
+    for (size_t z = 0; z < U_GNSS_NMEA_TEST_BENCHMARK_NUM_PASSES; z++) {
+        for (offset = 0; offset < length; offset += chunkLength) {
+            chunkLength = U_GNSS_NMEA_TEST_BENCHMARK_CHUNK_LENGTH_BYTES;
+            if (chunkLength > length - offset) {
+                chunkLength = length - offset;
+            }
+            for (y = 0; y < chunkLength; y += x) {
+                x = uGnssNmeaFeed(&nmea, gpBuffer + offset + y, chunkLength - y, &sentence);
+                if (sentence.type != U_GNSS_NMEA_SENTENCE_TYPE_NONE) {
+                    sum += sentence.fieldsPresent;
+                    numSentences++;
+                }
+            }
+        }
+    }
+    printResult("uGnssNmeaFeed()", numSentencesBaseline,
+                length * U_GNSS_NMEA_TEST_BENCHMARK_NUM_PASSES,
+                uPortGetTickTimeMs() - startTimeMs);
+    U_PORT_TEST_ASSERT(numSentences == numSentencesBaseline -
+                       U_GNSS_NMEA_TEST_BENCHMARK_NUM_PASSES /* the GLL */);
+    // Just so that the compiler can't optimise away the reads
+    U_PORT_TEST_ASSERT(sum > 0);
+
+    uPortFree(gpBuffer);
+    gpBuffer = NULL;
+
+    // Check for resource leaks
+    uTestUtilResourceCheck(U_TEST_PREFIX, NULL, true);
+    resourceCount = uTestUtilGetDynamicResourceCount() - resourceCount;
+    U_TEST_PRINT_LINE("we have leaked %d resources(s).", resourceCount);
+    U_PORT_TEST_ASSERT(resourceCount <= 0);
+}
+
+/** Clean-up to be run at the end of this round of tests, just
+ * in case there were test failures which would have resulted
+ * in the deinitialisation being skipped.
+ */
+U_PORT_TEST_FUNCTION("[gnssNmea]", "gnssNmeaCleanUp")
+{
+    uPortFree(gpBuffer);
+    gpBuffer = NULL;
+    // Printed for information: asserting happens in the postamble
+    uTestUtilResourceCheck(U_TEST_PREFIX, NULL, true);
+}
+
+// End of file
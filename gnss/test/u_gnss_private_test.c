@@ -61,9 +61,13 @@
 
 #include "u_ringbuffer.h"
 
+#include "u_interface.h"
+#include "u_device_serial.h"
+
 #include "u_gnss_module_type.h"
 #include "u_gnss_type.h"
 #include "u_gnss.h"
+#include "u_gnss_msg.h"
 #include "u_gnss_private.h"
 
 /* ----------------------------------------------------------------
@@ -110,6 +114,52 @@
 # define U_GNSS_PRIVATE_TEST_RINGBUFFER_SIZE 2048
 #endif
 
+#ifndef U_GNSS_PRIVATE_TEST_MSG_INDEX_MAX_NUM_READERS
+/** The maximum number of message readers to index in the
+ * message reader index test.
+ */
+# define U_GNSS_PRIVATE_TEST_MSG_INDEX_MAX_NUM_READERS 24
+#endif
+
+#ifndef U_GNSS_PRIVATE_TEST_MSG_INDEX_NUM_MESSAGES
+/** The number of message IDs to match against each index in the
+ * message reader index test.
+ */
+# define U_GNSS_PRIVATE_TEST_MSG_INDEX_NUM_MESSAGES 100
+#endif
+
+#ifndef U_GNSS_PRIVATE_TEST_MSG_SPAN_NUM_MESSAGES
+/** The number of UBX-NAV-PVT messages to stream in the message
+ * receive span test.
+ */
+# define U_GNSS_PRIVATE_TEST_MSG_SPAN_NUM_MESSAGES 60
+#endif
+
+#ifndef U_GNSS_PRIVATE_TEST_MSG_SPAN_NUM_ACCESSES
+/** The number of times each callback in the message receive span
+ * test gets at the fields of each message, so that the time taken
+ * doing that, rather than the pace of the message receive task,
+ * is what is measured.
+ */
+# define U_GNSS_PRIVATE_TEST_MSG_SPAN_NUM_ACCESSES 10000
+#endif
+
+#ifndef U_GNSS_PRIVATE_TEST_MSG_SPAN_TIMEOUT_MS
+/** How long to wait for all of the messages to arrive in the
+ * message receive span test.
+ */
+# define U_GNSS_PRIVATE_TEST_MSG_SPAN_TIMEOUT_MS 60000
+#endif
+
+/** The length of the body of a UBX-NAV-PVT message.
+ */
+#define U_GNSS_PRIVATE_TEST_NAV_PVT_BODY_LENGTH_BYTES 92
+
+/** The NMEA sentence streamed before each UBX-NAV-PVT message in
+ * the message receive span test.
+ */
+#define U_GNSS_PRIVATE_TEST_MSG_SPAN_NMEA "$GNGGA,092725.00,4717.11399,N,00833.91590,E,1,08,1.01,499.6,M,48.0,M,,*5B\r\n"
+
 /* ----------------------------------------------------------------
  * TYPES
  * -------------------------------------------------------------- */
@@ -139,6 +189,28 @@ typedef struct {
     uint16_t id;
 } uGnssPrivateTestRtcmMatch_t;
 
+/** The context of the virtual serial device used in the message
+ * receive span test.
+ */
+typedef struct {
+    const char *pStream;
+    size_t length;
+    size_t offset;
+    volatile bool released; /**< nothing is received until this is set. */
+} uGnssPrivateTestSerial_t;
+
+/** What a callback in the message receive span test has seen.
+ */
+typedef struct {
+    char message[U_GNSS_PRIVATE_TEST_NAV_PVT_BODY_LENGTH_BYTES +
+                                                               U_UBX_PROTOCOL_OVERHEAD_LENGTH_BYTES];
+    int32_t numReceived;
+    int32_t numBad;
+    int32_t numSplit;
+    int32_t timeMs;
+    uint32_t sum; /**< of the fields read, so that the reads can't be optimised out. */
+} uGnssPrivateTestMsgSpan_t;
+
 /* ----------------------------------------------------------------
  * VARIABLES
  * -------------------------------------------------------------- */
@@ -159,6 +231,32 @@ static uRingBuffer_t gRingBuffer = {0};
  */
 static char *gpBody = NULL;
 
+/** A place to hook the stream of data to be received in the message
+ * receive span test.
+ */
+static char *gpStream = NULL;
+
+/** The virtual serial device used in the message receive span test.
+ */
+static uDeviceSerial_t *gpDeviceSerial = NULL;
+
+/** What the copying callback in the message receive span test has seen.
+ */
+static uGnssPrivateTestMsgSpan_t gMsgCopy = {0};
+
+/** What the span callback in the message receive span test has seen.
+ */
+static uGnssPrivateTestMsgSpan_t gMsgSpan = {0};
+
+/** A place to hook the message readers used in the message reader
+ * index test.
+ */
+static uGnssPrivateMsgReader_t *gpReaders = NULL;
+
+/** A place to hook a message reader index.
+ */
+static uGnssPrivateMsgIndex_t *gpReaderIndex = NULL;
+
 # ifndef __ZEPHYR__
 
 /** Some sample NMEA message strings, taken from
@@ -297,12 +395,185 @@ static const uGnssPrivateTestRtcmMatch_t gRtcmTestMessage[] = {
     }
 };
 
+/** UBX message classes used in the message reader index test,
+ * including the wildcard; few, so that readers and messages collide.
+ */
+static const uint8_t gMsgIndexUbxClass[] = {0x01, 0x02, 0x0a, U_GNSS_UBX_MESSAGE_CLASS_ALL};
+
+/** UBX message IDs used in the message reader index test,
+ * including the wildcard.
+ */
+static const uint8_t gMsgIndexUbxId[] = {0x07, 0x35, 0x04, U_GNSS_UBX_MESSAGE_ID_ALL};
+
+/** RTCM message IDs used in the message reader index test,
+ * including the wildcard.
+ */
+static const uint16_t gMsgIndexRtcmId[] = {1005, 1077, 4072, U_GNSS_RTCM_MESSAGE_ID_ALL};
+
+/** NMEA talker/sentence strings used in the message reader index
+ * test, including partial ones and ones with wildcards.
+ */
+static const char *const gpMsgIndexNmea[] = {"", "G", "GP", "GPGGA", "GNGGA", "??GGA",
+                                             "G?RMC", "GNRMC", "GPRMC", "GNGSV", "?",
+                                             "PUBX", "PUBX?", "GNGGAX"
+                                            };
+
 #endif // #ifndef __ZEPHYR__
 
 /* ----------------------------------------------------------------
  * STATIC FUNCTIONS
  * -------------------------------------------------------------- */
 
+// Get the number of bytes waiting at the virtual serial device
+// of the message receive span test.
+static int32_t serialGetReceiveSize(struct uDeviceSerial_t *pDeviceSerial)
+{
+    uGnssPrivateTestSerial_t *pContext = (uGnssPrivateTestSerial_t *)
+                                         pUInterfaceContext(pDeviceSerial);
+    int32_t receiveSize = 0;
+
+    if (pContext->released) {
+        receiveSize = (int32_t) (pContext->length - pContext->offset);
+    }
+
+    return receiveSize;
+}
+
+// Read from the virtual serial device of the message receive span test.
+static int32_t serialRead(struct uDeviceSerial_t *pDeviceSerial,
+                          void *pBuffer, size_t sizeBytes)
+{
+    uGnssPrivateTestSerial_t *pContext = (uGnssPrivateTestSerial_t *)
+                                         pUInterfaceContext(pDeviceSerial);
+    int32_t receiveSize = serialGetReceiveSize(pDeviceSerial);
+
+    if (sizeBytes < (size_t) receiveSize) {
+        receiveSize = (int32_t) sizeBytes;
+    }
+    memcpy(pBuffer, pContext->pStream + pContext->offset, receiveSize);
+    pContext->offset += receiveSize;
+
+    return receiveSize;
+}
+
+// Write to the virtual serial device of the message receive span
+// test: nothing is listening so just throw it away.
+static int32_t serialWrite(struct uDeviceSerial_t *pDeviceSerial,
+                           const void *pBuffer, size_t sizeBytes)
+{
+    (void) pDeviceSerial;
+    (void) pBuffer;
+
+    return (int32_t) sizeBytes;
+}
+
+// Initialise the virtual serial device of the message receive span test.
+static void serialInit(struct uDeviceSerial_t *pDeviceSerial)
+{
+    pDeviceSerial->getReceiveSize = serialGetReceiveSize;
+    pDeviceSerial->read = serialRead;
+    pDeviceSerial->write = serialWrite;
+}
+
+// Get the fields at offset 0 (iTOW), 24 (lon) and 28 (lat) of the
+// body of a UBX-NAV-PVT message, adding them up.
+static uint32_t navPvtSum(const char *pBody)
+{
+    return uUbxProtocolUint32Decode(pBody) +
+           uUbxProtocolUint32Decode(pBody + 24) +
+           uUbxProtocolUint32Decode(pBody + 28);
+}
+
+// Copy length bytes from offset into a message held in two spans.
+static void spansCopy(const uRingBufferSpan_t *pSpans, size_t offset,
+                      char *pBuffer, size_t length)
+{
+    size_t thisLength;
+
+    if (offset < pSpans[0].length) {
+        thisLength = pSpans[0].length - offset;
+        if (thisLength > length) {
+            thisLength = length;
+        }
+        memcpy(pBuffer, pSpans[0].pData + offset, thisLength);
+        pBuffer += thisLength;
+        length -= thisLength;
+        offset += thisLength;
+    }
+    if (length > 0) {
+        memcpy(pBuffer, pSpans[1].pData + (offset - pSpans[0].length), length);
+    }
+}
+
+// Callback for the message receive span test that copies the
+// message out of the ring buffer.
+static void msgCopyCallback(uDeviceHandle_t gnssHandle,
+                            const uGnssMessageId_t *pMessageId,
+                            int32_t errorCodeOrLength,
+                            void *pCallbackParam)
+{
+    uGnssPrivateTestMsgSpan_t *pMsg = (uGnssPrivateTestMsgSpan_t *) pCallbackParam;
+    int32_t startTimeMs;
+    int32_t x = 0;
+
+    (void) pMessageId;
+    if (errorCodeOrLength == sizeof(pMsg->message)) {
+        startTimeMs = uPortGetTickTimeMs();
+        for (size_t y = 0; y < U_GNSS_PRIVATE_TEST_MSG_SPAN_NUM_ACCESSES; y++) {
+            x = uGnssMsgReceiveCallbackRead(gnssHandle, pMsg->message, sizeof(pMsg->message));
+            pMsg->sum += navPvtSum(pMsg->message + U_UBX_PROTOCOL_HEADER_LENGTH_BYTES);
+        }
+        pMsg->timeMs += uPortGetTickTimeMs() - startTimeMs;
+    }
+    if ((x == sizeof(pMsg->message)) &&
+        (uUbxProtocolUint32Decode(pMsg->message + U_UBX_PROTOCOL_HEADER_LENGTH_BYTES) ==
+         (uint32_t) pMsg->numReceived)) {
+        pMsg->numReceived++;
+    } else {
+        pMsg->numBad++;
+    }
+}
+
+// Callback for the message receive span test that reads the
+// message in place; this is called after msgCopyCallback(),
+// which has put the message into gMsgCopy.
+static void msgSpanCallback(uDeviceHandle_t gnssHandle,
+                            const uGnssMessageId_t *pMessageId,
+                            int32_t errorCodeOrLength,
+                            const uRingBufferSpan_t *pSpans,
+                            void *pCallbackParam)
+{
+    uGnssPrivateTestMsgSpan_t *pMsg = (uGnssPrivateTestMsgSpan_t *) pCallbackParam;
+    char body[U_GNSS_PRIVATE_TEST_NAV_PVT_BODY_LENGTH_BYTES];
+    int32_t startTimeMs;
+
+    (void) gnssHandle;
+    (void) pMessageId;
+    if ((errorCodeOrLength == sizeof(pMsg->message)) &&
+        (pSpans[0].length + pSpans[1].length == sizeof(pMsg->message))) {
+        if (pSpans[1].length > 0) {
+            pMsg->numSplit++;
+        }
+        startTimeMs = uPortGetTickTimeMs();
+        for (size_t y = 0; y < U_GNSS_PRIVATE_TEST_MSG_SPAN_NUM_ACCESSES; y++) {
+            // Only get the fields we want, as a real callback would
+            spansCopy(pSpans, U_UBX_PROTOCOL_HEADER_LENGTH_BYTES, body, 4);
+            spansCopy(pSpans, U_UBX_PROTOCOL_HEADER_LENGTH_BYTES + 24, body + 24, 8);
+            pMsg->sum += navPvtSum(body);
+        }
+        pMsg->timeMs += uPortGetTickTimeMs() - startTimeMs;
+        // Check the whole message against what the copying callback got
+        spansCopy(pSpans, 0, pMsg->message, sizeof(pMsg->message));
+        if (memcmp(pMsg->message, gMsgCopy.message, sizeof(pMsg->message)) == 0) {
+            pMsg->numReceived++;
+        } else {
+            pMsg->numBad++;
+        }
+    } else {
+        pMsg->numBad++;
+    }
+}
+
 # ifndef __ZEPHYR__
 
 // Fill a buffer with safe randomness: avoiding dollar (start of an
@@ -756,6 +1027,36 @@ U_PORT_TEST_FUNCTION("[gnss]", "gnssPrivateRtcm")
     U_PORT_TEST_ASSERT(resourceCount <= 0);
 }
 
+// Fill in a random message ID, drawn from a small set so that
+// there are plenty of matches, for the message reader index test.
+static void msgIndexRandomId(uGnssPrivateMessageId_t *pId)
+{
+    const uGnssProtocol_t types[] = {U_GNSS_PROTOCOL_UBX, U_GNSS_PROTOCOL_UBX,
+                                     U_GNSS_PROTOCOL_NMEA, U_GNSS_PROTOCOL_NMEA,
+                                     U_GNSS_PROTOCOL_RTCM, U_GNSS_PROTOCOL_UNKNOWN,
+                                     U_GNSS_PROTOCOL_ALL, U_GNSS_PROTOCOL_ANY
+                                    };
+    const char *pNmea;
+
+    memset(pId, 0, sizeof(*pId));
+    pId->type = types[rand() % (sizeof(types) / sizeof(types[0]))];
+    switch (pId->type) {
+        case U_GNSS_PROTOCOL_UBX:
+            pId->id.ubx = (uint16_t) ((((uint16_t) gMsgIndexUbxClass[rand() % sizeof(gMsgIndexUbxClass)]) << 8) |
+                                      gMsgIndexUbxId[rand() % sizeof(gMsgIndexUbxId)]);
+            break;
+        case U_GNSS_PROTOCOL_NMEA:
+            pNmea = gpMsgIndexNmea[rand() % (sizeof(gpMsgIndexNmea) / sizeof(gpMsgIndexNmea[0]))];
+            strncpy(pId->id.nmea, pNmea, sizeof(pId->id.nmea) - 1);
+            break;
+        case U_GNSS_PROTOCOL_RTCM:
+            pId->id.rtcm = gMsgIndexRtcmId[rand() % (sizeof(gMsgIndexRtcmId) / sizeof(gMsgIndexRtcmId[0]))];
+            break;
+        default:
+            break;
+    }
+}
+
 /** Test the UBX message decode function; not tested on Zephyr for
  * the same reasons as the test gnssPrivateNmea.
  */
@@ -888,8 +1189,212 @@ U_PORT_TEST_FUNCTION("[gnss]", "gnssPrivateUbx")
     U_PORT_TEST_ASSERT(resourceCount <= 0);
 }
 
+/** Test that the message reader index finds exactly the readers,
+ * in the same order, that checking every reader with
+ * uGnssPrivateMessageIdIsWanted() would; not tested on Zephyr for
+ * the same reasons as the test gnssPrivateNmea.
+ */
+U_PORT_TEST_FUNCTION("[gnss]", "gnssPrivateMsgIndex")
+{
+    uGnssPrivateMessageId_t messageId;
+    uGnssPrivateMsgReader_t *pReaderList;
+    uGnssPrivateMsgReader_t *pReader;
+    size_t numReaders;
+    size_t numMatched;
+    size_t numWanted;
+    int32_t resourceCount;
+
+    // Whatever called us likely initialised the
+    // port so deinitialise it here to obtain the
+    // correct initial heap size
+    uPortDeinit();
+    resourceCount = uTestUtilGetDynamicResourceCount();
+
+    U_PORT_TEST_ASSERT(uPortInit() == 0);
+
+    gpReaders = (uGnssPrivateMsgReader_t *) pUPortMalloc(U_GNSS_PRIVATE_TEST_MSG_INDEX_MAX_NUM_READERS *
+                                                         sizeof(uGnssPrivateMsgReader_t));
+    U_PORT_TEST_ASSERT(gpReaders != NULL);
+
+    // An empty list should give an index that matches nothing
+    gpReaderIndex = pUGnssPrivateMsgIndexCreate(NULL);
+    U_PORT_TEST_ASSERT(gpReaderIndex != NULL);
+    msgIndexRandomId(&messageId);
+    U_PORT_TEST_ASSERT(uGnssPrivateMsgIndexMatch(gpReaderIndex, &messageId) == 0);
+    uPortFree(gpReaderIndex);
+    gpReaderIndex = NULL;
+
+    for (size_t x = 0; x < U_GNSS_PRIVATE_TEST_NUM_LOOPS; x++) {
+        // Make a list of a random number of readers with random
+        // wanted message IDs, likely with duplicates
+        memset(gpReaders, 0, U_GNSS_PRIVATE_TEST_MSG_INDEX_MAX_NUM_READERS *
+               sizeof(uGnssPrivateMsgReader_t));
+        numReaders = 1 + (rand() % U_GNSS_PRIVATE_TEST_MSG_INDEX_MAX_NUM_READERS);
+        pReaderList = NULL;
+        for (size_t y = 0; y < numReaders; y++) {
+            pReader = gpReaders + y;
+            pReader->handle = (int32_t) y;
+            msgIndexRandomId(&(pReader->privateMessageId));
+            pReader->pNext = pReaderList;
+            pReaderList = pReader;
+        }
+        gpReaderIndex = pUGnssPrivateMsgIndexCreate(pReaderList);
+        U_PORT_TEST_ASSERT(gpReaderIndex != NULL);
+        U_PORT_TEST_ASSERT(gpReaderIndex->numReaders == numReaders);
+
+        for (size_t y = 0; y < U_GNSS_PRIVATE_TEST_MSG_INDEX_NUM_MESSAGES; y++) {
+            msgIndexRandomId(&messageId);
+            numMatched = uGnssPrivateMsgIndexMatch(gpReaderIndex, &messageId);
+            // Check against the list, in order
+            numWanted = 0;
+            for (pReader = pReaderList; pReader != NULL; pReader = pReader->pNext) {
+                if (uGnssPrivateMessageIdIsWanted(&messageId, &(pReader->privateMessageId))) {
+                    U_PORT_TEST_ASSERT(numWanted < numMatched);
+                    U_PORT_TEST_ASSERT(gpReaderIndex->ppMatched[numWanted] == pReader);
+                    numWanted++;
+                }
+            }
+            U_PORT_TEST_ASSERT(numWanted == numMatched);
+        }
+
+        uPortFree(gpReaderIndex);
+        gpReaderIndex = NULL;
+
+        if ((x % 100) == 0) {
+            // Give any task watchdog a bone, as in gnssPrivateUbx
+            uPortTaskBlock(U_CFG_OS_YIELD_MS);
+        }
+    }
+
+    uPortFree(gpReaders);
+    gpReaders = NULL;
+
+    uPortDeinit();
+
+    // Check for resource leaks
+    uTestUtilResourceCheck(U_TEST_PREFIX, NULL, true);
+    resourceCount = uTestUtilGetDynamicResourceCount() - resourceCount;
+    U_TEST_PRINT_LINE("we have leaked %d resources(s).", resourceCount);
+    U_PORT_TEST_ASSERT(resourceCount <= 0);
+}
+
 #endif // #ifndef __ZEPHYR__
 
+/** Test uGnssMsgReceiveStartSpan() against uGnssMsgReceiveStart(),
+ * streaming UBX-NAV-PVT messages through a virtual serial device so
+ * that no GNSS module is required, and compare the time the two
+ * take to get at a few fields of each message.
+ */
+U_PORT_TEST_FUNCTION("[gnss]", "gnssPrivateMsgSpan")
+{
+    uGnssPrivateTestSerial_t *pContext;
+    uGnssTransportHandle_t transportHandle;
+    uDeviceHandle_t gnssHandle = NULL;
+    uGnssMessageId_t messageId = {.type = U_GNSS_PROTOCOL_UBX,
+                                  .id.ubx = 0x0107 // UBX-NAV-PVT
+                                 };
+    char body[U_GNSS_PRIVATE_TEST_NAV_PVT_BODY_LENGTH_BYTES] = {0};
+    size_t nmeaLength = sizeof(U_GNSS_PRIVATE_TEST_MSG_SPAN_NMEA) - 1;
+    size_t length = 0;
+    uint32_t value;
+    int32_t spanHandle;
+    int32_t copyHandle;
+    int32_t startTimeMs;
+    int64_t numAccesses;
+    int32_t resourceCount;
+
+    // Whatever called us likely initialised the
+    // port so deinitialise it here to obtain the
+    // correct initial heap size
+    uPortDeinit();
+    resourceCount = uTestUtilGetDynamicResourceCount();
+
+    U_PORT_TEST_ASSERT(uPortInit() == 0);
+    U_PORT_TEST_ASSERT(uGnssInit() == 0);
+    memset(&gMsgCopy, 0, sizeof(gMsgCopy));
+    memset(&gMsgSpan, 0, sizeof(gMsgSpan));
+
+    // Make the stream: NMEA and UBX-NAV-PVT messages, the iTOW
+    // of each UBX-NAV-PVT message being its index
+    gpStream = (char *) pUPortMalloc(U_GNSS_PRIVATE_TEST_MSG_SPAN_NUM_MESSAGES *
+                                     (nmeaLength + sizeof(gMsgCopy.message)));
+    U_PORT_TEST_ASSERT(gpStream != NULL);
+    for (size_t x = 0; x < U_GNSS_PRIVATE_TEST_MSG_SPAN_NUM_MESSAGES; x++) {
+        memcpy(gpStream + length, U_GNSS_PRIVATE_TEST_MSG_SPAN_NMEA, nmeaLength);
+        length += nmeaLength;
+        value = uUbxProtocolUint32Encode((uint32_t) x);
+        memcpy(body, &value, sizeof(value));
+        value = uUbxProtocolUint32Encode((uint32_t) (x * 3));
+        memcpy(body + 24, &value, sizeof(value));
+        value = uUbxProtocolUint32Encode((uint32_t) (x * 7));
+        memcpy(body + 28, &value, sizeof(value));
+        length += uUbxProtocolEncode(0x01, 0x07, body, sizeof(body), gpStream + length);
+    }
+
+    // Make the virtual serial device that serves it up
+    gpDeviceSerial = pUDeviceSerialCreate(serialInit, sizeof(uGnssPrivateTestSerial_t));
+    U_PORT_TEST_ASSERT(gpDeviceSerial != NULL);
+    pContext = (uGnssPrivateTestSerial_t *) pUInterfaceContext(gpDeviceSerial);
+    memset(pContext, 0, sizeof(*pContext));
+    pContext->pStream = gpStream;
+    pContext->length = length;
+
+    transportHandle.pDeviceSerial = gpDeviceSerial;
+    U_PORT_TEST_ASSERT(uGnssAdd(U_GNSS_MODULE_TYPE_M9, U_GNSS_TRANSPORT_VIRTUAL_SERIAL,
+                                transportHandle, -1, false, &gnssHandle) == 0);
+
+    // Callbacks are called most-recently-added first, so add the
+    // span one first in order that the copying one has got the
+    // message for comparison by the time the span one is called
+    spanHandle = uGnssMsgReceiveStartSpan(gnssHandle, &messageId, msgSpanCallback, &gMsgSpan);
+    U_PORT_TEST_ASSERT(spanHandle >= 0);
+    copyHandle = uGnssMsgReceiveStart(gnssHandle, &messageId, msgCopyCallback, &gMsgCopy);
+    U_PORT_TEST_ASSERT(copyHandle >= 0);
+
+    // Let the data flow
+    pContext->released = true;
+    startTimeMs = uPortGetTickTimeMs();
+    while (((gMsgCopy.numReceived + gMsgCopy.numBad < U_GNSS_PRIVATE_TEST_MSG_SPAN_NUM_MESSAGES) ||
+            (gMsgSpan.numReceived + gMsgSpan.numBad < U_GNSS_PRIVATE_TEST_MSG_SPAN_NUM_MESSAGES)) &&
+           (uPortGetTickTimeMs() - startTimeMs < U_GNSS_PRIVATE_TEST_MSG_SPAN_TIMEOUT_MS)) {
+        uPortTaskBlock(100);
+    }
+
+    U_PORT_TEST_ASSERT(uGnssMsgReceiveStop(gnssHandle, copyHandle) == 0);
+    U_PORT_TEST_ASSERT(uGnssMsgReceiveStop(gnssHandle, spanHandle) == 0);
+
+    numAccesses = ((int64_t) U_GNSS_PRIVATE_TEST_MSG_SPAN_NUM_MESSAGES) *
+                  U_GNSS_PRIVATE_TEST_MSG_SPAN_NUM_ACCESSES;
+    U_TEST_PRINT_LINE("copy: %d message(s), %d bad, %d ms for %d field accesses (%d ns each).",
+                      gMsgCopy.numReceived, gMsgCopy.numBad, gMsgCopy.timeMs,
+                      (int32_t) numAccesses, (int32_t) ((gMsgCopy.timeMs * 1000000LL) / numAccesses));
+    U_TEST_PRINT_LINE("span: %d message(s), %d bad, %d split, %d ms for %d field accesses"
+                      " (%d ns each).", gMsgSpan.numReceived, gMsgSpan.numBad,
+                      gMsgSpan.numSplit, gMsgSpan.timeMs, (int32_t) numAccesses,
+                      (int32_t) ((gMsgSpan.timeMs * 1000000LL) / numAccesses));
+    U_PORT_TEST_ASSERT(gMsgCopy.numReceived == U_GNSS_PRIVATE_TEST_MSG_SPAN_NUM_MESSAGES);
+    U_PORT_TEST_ASSERT(gMsgCopy.numBad == 0);
+    U_PORT_TEST_ASSERT(gMsgSpan.numReceived == U_GNSS_PRIVATE_TEST_MSG_SPAN_NUM_MESSAGES);
+    U_PORT_TEST_ASSERT(gMsgSpan.numBad == 0);
+    // Both read the same fields the same number of times
+    U_PORT_TEST_ASSERT(gMsgSpan.sum == gMsgCopy.sum);
+
+    uGnssRemove(gnssHandle);
+    uGnssDeinit();
+    uDeviceSerialDelete(gpDeviceSerial);
+    gpDeviceSerial = NULL;
+    uPortFree(gpStream);
+    gpStream = NULL;
+
+    uPortDeinit();
+
+    // Check for resource leaks
+    uTestUtilResourceCheck(U_TEST_PREFIX, NULL, true);
+    resourceCount = uTestUtilGetDynamicResourceCount() - resourceCount;
+    U_TEST_PRINT_LINE("we have leaked %d resources(s).", resourceCount);
+    U_PORT_TEST_ASSERT(resourceCount <= 0);
+}
+
 /** Clean-up to be run at the end of this round of tests, just
  * in case there were test failures which would have resulted
  * in the deinitialisation being skipped.
@@ -900,8 +1405,14 @@ U_PORT_TEST_FUNCTION("[gnss]", "gnssPrivateCleanUp")
     uPortFree(gpBuffer);
     uRingBufferDelete(&gRingBuffer);
     uPortFree(gpLinearBuffer);
+    uPortFree(gpReaderIndex);
+    uPortFree(gpReaders);
 
     uGnssDeinit();
+    if (gpDeviceSerial != NULL) {
+        uDeviceSerialDelete(gpDeviceSerial);
+    }
+    uPortFree(gpStream);
     uPortDeinit();
     // Printed for information: asserting happens in the postamble
     uTestUtilResourceCheck(U_TEST_PREFIX, NULL, true);
@@ -0,0 +1,704 @@
+/*
+ * Copyright 2019-2024 u-blox
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* Only #includes of u_* and the C standard library are allowed here,
+ * no platform stuff and no OS stuff.  Anything required from
+ * the platform/OS must be brought in through u_port* to maintain
+ * portability.
+ */
+
+/** @file
+ * @brief Tests for the GNSS raw measurement decoder API: they do not
+ * require a GNSS module to run, hence these should pass on all
+ * platforms.
+ * IMPORTANT: see notes in u_cfg_test_platform_specific.h for the
+ * naming rules that must be followed when using the U_PORT_TEST_FUNCTION()
+ * macro.
+ */
+
+# ifdef U_CFG_OVERRIDE
+#  include "u_cfg_override.h" // For a customer's configuration override
+# endif
+
+#include "stddef.h"    // NULL, size_t etc.
+#include "stdint.h"    // int32_t etc.
+#include "stdbool.h"
+#include "string.h"    // memset(), memcpy()
+
+#include "u_cfg_sw.h"
+#include "u_cfg_os_platform_specific.h"
+#include "u_cfg_app_platform_specific.h"
+#include "u_cfg_test_platform_specific.h"
+
+#include "u_error_common.h"
+
+#include "u_port.h"
+#include "u_port_os.h"
+#include "u_port_heap.h"
+#include "u_port_debug.h"
+
+#include "u_test_util_resource_check.h"
+
+#include "u_ubx_protocol.h"
+
+#include "u_gnss_module_type.h"
+#include "u_gnss_type.h"
+#include "u_gnss_dec.h"
+#include "u_gnss_framer.h"
+#include "u_gnss_raw.h"
+
+/* ----------------------------------------------------------------
+ * COMPILE-TIME MACROS
+ * -------------------------------------------------------------- */
+
+/** The string to put at the start of all prints from this test.
+ */
+#define U_TEST_PREFIX "U_GNSS_RAW_TEST: "
+
+/** Print a whole line, with terminator, prefixed for this test file.
+ */
+#define U_TEST_PRINT_LINE(format, ...) uPortLog(U_TEST_PREFIX format "\n", ##__VA_ARGS__)
+
+#ifndef U_GNSS_RAW_TEST_NUM_EPOCHS
+/** The number of epochs in the log of test data.
+ */
+# define U_GNSS_RAW_TEST_NUM_EPOCHS 16
+#endif
+
+/** The smallest number of measurements in an epoch of the log of
+ * test data; each epoch has up to eight more than this.
+ */
+#define U_GNSS_RAW_TEST_NUM_MEAS_MIN 40
+
+/** The number of measurements in the UBX-RXM-RAWX message that
+ * has more measurements than will fit into a #uGnssRawEpoch_t.
+ */
+#define U_GNSS_RAW_TEST_NUM_MEAS_TOO_MANY (U_GNSS_RAW_MEAS_MAX_NUM + 6)
+
+/** The size of the log of test data; big enough for
+ * #U_GNSS_RAW_TEST_NUM_EPOCHS epochs, see logBuild().
+ */
+#define U_GNSS_RAW_TEST_LOG_LENGTH_BYTES (U_GNSS_RAW_TEST_NUM_EPOCHS * 2048)
+
+/** The size of a buffer that will hold any single message written
+ * by this test.
+ */
+#define U_GNSS_RAW_TEST_MESSAGE_LENGTH_BYTES (U_GNSS_DEC_UBX_RXM_RAWX_BODY_MIN_LENGTH +   \
+                                              (U_GNSS_RAW_TEST_NUM_MEAS_TOO_MANY *         \
+                                               U_GNSS_DEC_UBX_RXM_RAWX_BLOCK_LENGTH) +     \
+                                              U_UBX_PROTOCOL_OVERHEAD_LENGTH_BYTES)
+
+/** The size of the buffer to give the framer.
+ */
+#define U_GNSS_RAW_TEST_BUFFER_LENGTH_BYTES 2048
+
+/** The number of epochs in the ring.
+ */
+#define U_GNSS_RAW_TEST_RING_NUM_EPOCHS 3
+
+#ifndef U_GNSS_RAW_TEST_BENCHMARK_NUM_PASSES
+/** The number of times the log is passed through each decoder in
+ * the benchmark.
+ */
+# define U_GNSS_RAW_TEST_BENCHMARK_NUM_PASSES 50
+#endif
+
+/** The size of chunk in which the benchmark feeds the log to
+ * the decoder, like a UART read.
+ */
+#define U_GNSS_RAW_TEST_BENCHMARK_CHUNK_LENGTH_BYTES 256
+
+/* ----------------------------------------------------------------
+ * TYPES
+ * -------------------------------------------------------------- */
+
+/** Where a UBX-RXM-RAWX or UBX-RXM-SFRBX message is in the log.
+ */
+typedef struct {
+    size_t offset;
+    size_t length;
+} uGnssRawTestMessage_t;
+
+/* ----------------------------------------------------------------
+ * VARIABLES
+ * -------------------------------------------------------------- */
+
+/** The GNSS IDs used, in turn, in the log: GPS, Galileo, BeiDou,
+ * GLONASS, SBAS and QZSS.
+ */
+static const uint8_t gGnssId[] = {0, 2, 3, 6, 1, 5};
+
+/** The number of data words in a subframe of each GNSS in gGnssId.
+ */
+static const uint8_t gNumWords[] = {10, 8, 10, 4, 8, 10};
+
+/** The log of test data.
+ */
+static char *gpLog = NULL;
+
+/** The UBX-RXM-RAWX and UBX-RXM-SFRBX messages in the log.
+ */
+static uGnssRawTestMessage_t *gpMessage = NULL;
+
+/** Somewhere to build the body of a message.
+ */
+static char *gpBody = NULL;
+
+/** A buffer for a single message.
+ */
+static char *gpMessageBuffer = NULL;
+
+/** A buffer for the framer.
+ */
+static char *gpBuffer = NULL;
+
+/** The ring of epochs.
+ */
+static uGnssRawEpoch_t *gpEpochs = NULL;
+
+/* ----------------------------------------------------------------
+ * STATIC FUNCTIONS
+ * -------------------------------------------------------------- */
+
+// Write a uint16_t into a message body.
+static void putU2(char *pBuffer, uint16_t value)
+{
+    value = uUbxProtocolUint16Encode(value);
+    memcpy(pBuffer, &value, sizeof(value));
+}
+
+// Write a uint32_t into a message body.
+static void putU4(char *pBuffer, uint32_t value)
+{
+    value = uUbxProtocolUint32Encode(value);
+    memcpy(pBuffer, &value, sizeof(value));
+}
+
+// Write a double into a message body.
+static void putR8(char *pBuffer, double value)
+{
+    uint64_t uint64;
+
+    memcpy(&uint64, &value, sizeof(uint64));
+    uint64 = uUbxProtocolUint64Encode(uint64);
+    memcpy(pBuffer, &uint64, sizeof(uint64));
+}
+
+// Write a float into a message body.
+static void putR4(char *pBuffer, float value)
+{
+    uint32_t uint32;
+
+    memcpy(&uint32, &value, sizeof(uint32));
+    putU4(pBuffer, uint32);
+}
+
+// The number of measurements in the given epoch of the log.
+static size_t numMeasLog(size_t epoch)
+{
+    return U_GNSS_RAW_TEST_NUM_MEAS_MIN + (epoch % 9);
+}
+
+// The number of subframes in the given epoch of the log.
+static size_t numSubframesLog(size_t epoch)
+{
+    return epoch % 4;
+}
+
+// Write the UBX-RXM-RAWX message of the given epoch, with numMeas
+// measurements, to pBuffer, returning its length.
+static size_t writeRawx(char *pBuffer, size_t epoch, size_t numMeas)
+{
+    char *pBody = gpBody;
+    char *pBlock;
+
+    memset(pBody, 0, U_GNSS_RAW_TEST_MESSAGE_LENGTH_BYTES);
+    putR8(pBody, 345600.0 + epoch);
+    putU2(pBody + 8, 2300);
+    *(pBody + 10) = 18;
+    *(pBody + 11) = (char) numMeas;
+    *(pBody + 12) = 0x01;
+    *(pBody + 13) = 0x01;
+    for (size_t x = 0; x < numMeas; x++) {
+        pBlock = pBody + U_GNSS_DEC_UBX_RXM_RAWX_BODY_MIN_LENGTH +
+                 (x * U_GNSS_DEC_UBX_RXM_RAWX_BLOCK_LENGTH);
+        putR8(pBlock, 2.0e7 + (epoch * 100.0) + (x * 0.5));
+        putR8(pBlock + 8, 1.0e8 + epoch + (x * 0.25));
+        putR4(pBlock + 16, -1000.0f + x);
+        *(pBlock + 20) = (char) gGnssId[x % sizeof(gGnssId)];
+        *(pBlock + 21) = (char) (1 + ((x / 2) % 32));
+        *(pBlock + 22) = (char) ((x & 1) ? 4 : 0);
+        *(pBlock + 23) = (char) ((gGnssId[x % sizeof(gGnssId)] == 6) ? x % 14 : 0);
+        putU2(pBlock + 24, (uint16_t) (1000 + (x * 10)));
+        *(pBlock + 26) = (char) (20 + (x % 30));
+        // Upper bits of the standard deviations are reserved,
+        // set them to check that they are masked
+        *(pBlock + 27) = (char) (0xF0 | (x % 16));
+        *(pBlock + 28) = (char) (0xF0 | ((x + 1) % 16));
+        *(pBlock + 29) = (char) (0xF0 | ((x + 2) % 16));
+        *(pBlock + 30) = (char) (x % 16);
+    }
+
+    return (size_t) uUbxProtocolEncode(U_GNSS_DEC_UBX_RXM_RAWX_MESSAGE_CLASS,
+                                       U_GNSS_DEC_UBX_RXM_RAWX_MESSAGE_ID, pBody,
+                                       U_GNSS_DEC_UBX_RXM_RAWX_BODY_MIN_LENGTH +
+                                       (numMeas * U_GNSS_DEC_UBX_RXM_RAWX_BLOCK_LENGTH),
+                                       pBuffer);
+}
+
+// Write UBX-RXM-SFRBX message number subframe of the given epoch
+// to pBuffer, returning its length.
+static size_t writeSfrbx(char *pBuffer, size_t epoch, size_t subframe)
+{
+    char body[8 + (U_GNSS_RAW_SUBFRAME_WORDS_MAX_NUM * 4)];
+    size_t numWords = gNumWords[subframe % sizeof(gNumWords)];
+
+    memset(body, 0, sizeof(body));
+    body[0] = (char) gGnssId[subframe % sizeof(gGnssId)];
+    body[1] = (char) (1 + (epoch % 32));
+    body[3] = (char) ((gGnssId[subframe % sizeof(gGnssId)] == 6) ? 7 : 0);
+    body[4] = (char) numWords;
+    body[5] = (char) subframe;
+    body[6] = 0x02;
+    for (size_t x = 0; x < numWords; x++) {
+        putU4(body + 8 + (x * 4), (uint32_t) ((epoch << 16) | (subframe << 8) | x));
+    }
+
+    return (size_t) uUbxProtocolEncode(U_GNSS_RAW_UBX_RXM_SFRBX_MESSAGE_CLASS,
+                                       U_GNSS_RAW_UBX_RXM_SFRBX_MESSAGE_ID,
+                                       body, 8 + (numWords * 4), pBuffer);
+}
+
+// Build a log such as a multi-constellation receiver would emit
+// with raw measurements switched on: for each epoch an NMEA
+// sentence, a UBX-NAV-PVT message, the UBX-RXM-SFRBX messages and
+// then the UBX-RXM-RAWX message.  The position of each RXM message
+// is put into pMessage and the number of them returned.
+static size_t logBuild(char *pLog, size_t *pLength,
+                       uGnssRawTestMessage_t *pMessage)
+{
+    const char *pNmea = "$GNGGA,092725.00,4717.11399,N,00833.91590,E,1,08,1.01,499.6,M,48.0,M,,*5B\r\n";
+    char navPvt[92] = {0};
+    size_t length = 0;
+    size_t numMessages = 0;
+
+    for (size_t x = 0; x < U_GNSS_RAW_TEST_NUM_EPOCHS; x++) {
+        memcpy(pLog + length, pNmea, strlen(pNmea));
+        length += strlen(pNmea);
+        length += uUbxProtocolEncode(0x01, 0x07, navPvt, sizeof(navPvt), pLog + length);
+        for (size_t y = 0; y < numSubframesLog(x); y++) {
+            pMessage[numMessages].offset = length;
+            pMessage[numMessages].length = writeSfrbx(pLog + length, x, y);
+            length += pMessage[numMessages].length;
+            numMessages++;
+        }
+        pMessage[numMessages].offset = length;
+        pMessage[numMessages].length = writeRawx(pLog + length, x, numMeasLog(x));
+        length += pMessage[numMessages].length;
+        numMessages++;
+        U_PORT_TEST_ASSERT(length < U_GNSS_RAW_TEST_LOG_LENGTH_BYTES);
+    }
+    *pLength = length;
+
+    return numMessages;
+}
+
+// Check that an epoch is epoch number epoch of the log.
+static void epochCheck(const uGnssRawEpoch_t *pEpoch, size_t epoch)
+{
+    size_t numMeas = numMeasLog(epoch);
+    size_t numSubframes = numSubframesLog(epoch);
+
+    U_PORT_TEST_ASSERT(pEpoch->rcvTow == 345600.0 + epoch);
+    U_PORT_TEST_ASSERT(pEpoch->week == 2300);
+    U_PORT_TEST_ASSERT(pEpoch->leapS == 18);
+    U_PORT_TEST_ASSERT(pEpoch->recStat == 0x01);
+    U_PORT_TEST_ASSERT(pEpoch->numMeas == numMeas);
+    for (size_t x = 0; x < numMeas; x++) {
+        U_PORT_TEST_ASSERT(pEpoch->prMes[x] == 2.0e7 + (epoch * 100.0) + (x * 0.5));
+        U_PORT_TEST_ASSERT(pEpoch->cpMes[x] == 1.0e8 + epoch + (x * 0.25));
+        U_PORT_TEST_ASSERT(pEpoch->doMes[x] == -1000.0f + x);
+        U_PORT_TEST_ASSERT(pEpoch->gnssId[x] == gGnssId[x % sizeof(gGnssId)]);
+        U_PORT_TEST_ASSERT(pEpoch->svId[x] == 1 + ((x / 2) % 32));
+        U_PORT_TEST_ASSERT(pEpoch->sigId[x] == ((x & 1) ? 4 : 0));
+        U_PORT_TEST_ASSERT(pEpoch->freqId[x] == ((gGnssId[x % sizeof(gGnssId)] == 6) ? x % 14 : 0));
+        U_PORT_TEST_ASSERT(pEpoch->locktime[x] == 1000 + (x * 10));
+        U_PORT_TEST_ASSERT(pEpoch->cno[x] == 20 + (x % 30));
+        U_PORT_TEST_ASSERT(pEpoch->prStdev[x] == x % 16);
+        U_PORT_TEST_ASSERT(pEpoch->cpStdev[x] == (x + 1) % 16);
+        U_PORT_TEST_ASSERT(pEpoch->doStdev[x] == (x + 2) % 16);
+        U_PORT_TEST_ASSERT(pEpoch->trkStat[x] == x % 16);
+    }
+    U_PORT_TEST_ASSERT(pEpoch->numSubframes == numSubframes);
+    for (size_t x = 0; x < numSubframes; x++) {
+        U_PORT_TEST_ASSERT(pEpoch->sfGnssId[x] == gGnssId[x % sizeof(gGnssId)]);
+        U_PORT_TEST_ASSERT(pEpoch->sfSvId[x] == 1 + (epoch % 32));
+        U_PORT_TEST_ASSERT(pEpoch->sfSigId[x] == 0);
+        U_PORT_TEST_ASSERT(pEpoch->sfFreqId[x] == ((gGnssId[x % sizeof(gGnssId)] == 6) ? 7 : 0));
+        U_PORT_TEST_ASSERT(pEpoch->sfChn[x] == x);
+        U_PORT_TEST_ASSERT(pEpoch->sfNumWords[x] == gNumWords[x % sizeof(gNumWords)]);
+        for (size_t y = 0; y < pEpoch->sfNumWords[x]; y++) {
+            U_PORT_TEST_ASSERT(pEpoch->sfDwrd[x][y] == ((epoch << 16) | (x << 8) | y));
+        }
+    }
+}
+
+// Total the subframes in the log from the given epoch onwards.
+static size_t numSubframesLogFrom(size_t epoch)
+{
+    size_t numSubframes = 0;
+
+    for (size_t x = epoch; x < U_GNSS_RAW_TEST_NUM_EPOCHS; x++) {
+        numSubframes += numSubframesLog(x);
+    }
+
+    return numSubframes;
+}
+
+// Free the memory used by these tests.
+static void freeAll()
+{
+    uPortFree(gpEpochs);
+    gpEpochs = NULL;
+    uPortFree(gpBuffer);
+    gpBuffer = NULL;
+    uPortFree(gpMessageBuffer);
+    gpMessageBuffer = NULL;
+    uPortFree(gpBody);
+    gpBody = NULL;
+    uPortFree(gpMessage);
+    gpMessage = NULL;
+    uPortFree(gpLog);
+    gpLog = NULL;
+}
+
+// Allocate the memory used by these tests and build the log,
+// returning the number of RXM messages in it.
+static size_t allocAll(size_t *pLength)
+{
+    gpLog = (char *) pUPortMalloc(U_GNSS_RAW_TEST_LOG_LENGTH_BYTES);
+    U_PORT_TEST_ASSERT(gpLog != NULL);
+    gpMessage = (uGnssRawTestMessage_t *) pUPortMalloc(sizeof(uGnssRawTestMessage_t) *
+                                                       U_GNSS_RAW_TEST_NUM_EPOCHS * 4);
+    U_PORT_TEST_ASSERT(gpMessage != NULL);
+    gpBody = (char *) pUPortMalloc(U_GNSS_RAW_TEST_MESSAGE_LENGTH_BYTES);
+    U_PORT_TEST_ASSERT(gpBody != NULL);
+    gpMessageBuffer = (char *) pUPortMalloc(U_GNSS_RAW_TEST_MESSAGE_LENGTH_BYTES);
+    U_PORT_TEST_ASSERT(gpMessageBuffer != NULL);
+    gpBuffer = (char *) pUPortMalloc(U_GNSS_RAW_TEST_BUFFER_LENGTH_BYTES);
+    U_PORT_TEST_ASSERT(gpBuffer != NULL);
+    gpEpochs = (uGnssRawEpoch_t *) pUPortMalloc(sizeof(uGnssRawEpoch_t) *
+                                                U_GNSS_RAW_TEST_RING_NUM_EPOCHS);
+    U_PORT_TEST_ASSERT(gpEpochs != NULL);
+
+    return logBuild(gpLog, pLength, gpMessage);
+}
+
+/* ----------------------------------------------------------------
+ * PUBLIC FUNCTIONS
+ * -------------------------------------------------------------- */
+
+/** Feed a log through the raw measurement decoder in chunks of
+ * various sizes, check the epochs that come out, what happens
+ * when the ring is full, and decoding of single messages.
+ */
+U_PORT_TEST_FUNCTION("[gnssRaw]", "gnssRawBasic")
+{
+    int32_t resourceCount;
+    uGnssRaw_t raw;
+    uGnssRawStats_t stats;
+    const uGnssRawEpoch_t *pEpoch;
+    size_t length = 0;
+    size_t numMessages;
+    size_t epoch;
+    size_t offset;
+    size_t chunkLength;
+    int32_t x;
+    const size_t chunkSize[] = {4096, 256, 7, 1};
+
+    // Get the initial resource count
+    resourceCount = uTestUtilGetDynamicResourceCount();
+
+    numMessages = allocAll(&length);
+    U_TEST_PRINT_LINE("log is %d byte(s) containing %d epoch(s), %d RXM message(s).",
+                      length, U_GNSS_RAW_TEST_NUM_EPOCHS, numMessages);
+
+    U_PORT_TEST_ASSERT(uGnssRawInit(NULL, gpEpochs, U_GNSS_RAW_TEST_RING_NUM_EPOCHS,
+                                    gpBuffer, U_GNSS_RAW_TEST_BUFFER_LENGTH_BYTES) < 0);
+    U_PORT_TEST_ASSERT(uGnssRawInit(&raw, NULL, U_GNSS_RAW_TEST_RING_NUM_EPOCHS,
+                                    gpBuffer, U_GNSS_RAW_TEST_BUFFER_LENGTH_BYTES) < 0);
+    U_PORT_TEST_ASSERT(uGnssRawInit(&raw, gpEpochs, 0,
+                                    gpBuffer, U_GNSS_RAW_TEST_BUFFER_LENGTH_BYTES) < 0);
+
+    // Feed the log in chunks, reading epochs as they appear; the
+    // largest chunk holds fewer epochs than the ring
+    for (size_t y = 0; y < sizeof(chunkSize) / sizeof(chunkSize[0]); y++) {
+        U_TEST_PRINT_LINE("feeding the log in chunks of %d byte(s).", chunkSize[y]);
+        U_PORT_TEST_ASSERT(uGnssRawInit(&raw, gpEpochs, U_GNSS_RAW_TEST_RING_NUM_EPOCHS,
+                                        gpBuffer, U_GNSS_RAW_TEST_BUFFER_LENGTH_BYTES) == 0);
+        U_PORT_TEST_ASSERT(pUGnssRawEpochGet(&raw) == NULL);
+        epoch = 0;
+        for (offset = 0; offset < length; offset += chunkLength) {
+            chunkLength = chunkSize[y];
+            if (chunkLength > length - offset) {
+                chunkLength = length - offset;
+            }
+            x = uGnssRawFeed(&raw, gpLog + offset, chunkLength);
+            U_PORT_TEST_ASSERT(x >= 0);
+            for (pEpoch = pUGnssRawEpochGet(&raw); pEpoch != NULL; pEpoch = pUGnssRawEpochGet(&raw)) {
+                epochCheck(pEpoch, epoch);
+                epoch++;
+                uGnssRawEpochRelease(&raw);
+                x--;
+            }
+            U_PORT_TEST_ASSERT(x == 0);
+        }
+        U_PORT_TEST_ASSERT(uGnssRawFlush(&raw) == 0);
+        U_PORT_TEST_ASSERT(epoch == U_GNSS_RAW_TEST_NUM_EPOCHS);
+        uGnssRawGetStats(&raw, &stats);
+        U_PORT_TEST_ASSERT(stats.rawxCount == U_GNSS_RAW_TEST_NUM_EPOCHS);
+        U_PORT_TEST_ASSERT(stats.sfrbxCount == numSubframesLogFrom(0));
+        U_PORT_TEST_ASSERT(stats.badCount == 0);
+        U_PORT_TEST_ASSERT(stats.epochsDropped == 0);
+        U_PORT_TEST_ASSERT(stats.measDropped == 0);
+        U_PORT_TEST_ASSERT(stats.subframesDropped == 0);
+    }
+
+    // Feed the whole log without reading any epochs: the ring
+    // fills up and the rest are dropped
+    U_TEST_PRINT_LINE("feeding the log into a ring of %d epoch(s) without reading.",
+                      U_GNSS_RAW_TEST_RING_NUM_EPOCHS);
+    U_PORT_TEST_ASSERT(uGnssRawInit(&raw, gpEpochs, U_GNSS_RAW_TEST_RING_NUM_EPOCHS,
+                                    gpBuffer, U_GNSS_RAW_TEST_BUFFER_LENGTH_BYTES) == 0);
+    U_PORT_TEST_ASSERT(uGnssRawFeed(&raw, gpLog, length) == U_GNSS_RAW_TEST_RING_NUM_EPOCHS);
+    uGnssRawGetStats(&raw, &stats);
+    U_PORT_TEST_ASSERT(stats.rawxCount == U_GNSS_RAW_TEST_NUM_EPOCHS);
+    U_PORT_TEST_ASSERT(stats.epochsDropped == U_GNSS_RAW_TEST_NUM_EPOCHS - U_GNSS_RAW_TEST_RING_NUM_EPOCHS);
+    U_PORT_TEST_ASSERT(stats.subframesDropped == numSubframesLogFrom(U_GNSS_RAW_TEST_RING_NUM_EPOCHS));
+    for (size_t y = 0; y < U_GNSS_RAW_TEST_RING_NUM_EPOCHS; y++) {
+        pEpoch = pUGnssRawEpochGet(&raw);
+        U_PORT_TEST_ASSERT(pEpoch != NULL);
+        epochCheck(pEpoch, y);
+        uGnssRawEpochRelease(&raw);
+    }
+    U_PORT_TEST_ASSERT(pUGnssRawEpochGet(&raw) == NULL);
+
+    // Now decode the RXM messages one at a time, without their
+    // checksums, with no framer buffer
+    U_TEST_PRINT_LINE("decoding %d RXM message(s) one at a time.", numMessages);
+    U_PORT_TEST_ASSERT(uGnssRawInit(&raw, gpEpochs, U_GNSS_RAW_TEST_RING_NUM_EPOCHS, NULL, 0) == 0);
+    epoch = 0;
+    for (size_t y = 0; y < numMessages; y++) {
+        x = uGnssRawDecode(&raw, gpLog + gpMessage[y].offset, gpMessage[y].length - 2);
+        U_PORT_TEST_ASSERT(x >= 0);
+        if (x > 0) {
+            U_PORT_TEST_ASSERT(x == 1);
+            epochCheck(pUGnssRawEpochGet(&raw), epoch);
+            uGnssRawEpochRelease(&raw);
+            epoch++;
+        }
+    }
+    U_PORT_TEST_ASSERT(epoch == U_GNSS_RAW_TEST_NUM_EPOCHS);
+    // Messages that are not RXM messages are ignored, anything
+    // that is not a UBX message is an error
+    length = uUbxProtocolEncode(0x01, 0x07, gpBody, 92, gpMessageBuffer);
+    U_PORT_TEST_ASSERT(uGnssRawDecode(&raw, gpMessageBuffer, length) == 0);
+    U_PORT_TEST_ASSERT(uGnssRawDecode(&raw, gpLog, length) < 0);
+
+    // A RAWX message that is cut short, and one that claims to have
+    // more measurements than it carries
+    U_TEST_PRINT_LINE("decoding bad RXM messages.");
+    length = writeRawx(gpMessageBuffer, 0, 1);
+    U_PORT_TEST_ASSERT(uGnssRawDecode(&raw, gpMessageBuffer,
+                                      length - 3) == (int32_t) U_ERROR_COMMON_TRUNCATED);
+    *(gpMessageBuffer + U_UBX_PROTOCOL_HEADER_LENGTH_BYTES + 11) = 2;
+    U_PORT_TEST_ASSERT(uGnssRawDecode(&raw, gpMessageBuffer, length) == (int32_t) U_ERROR_COMMON_TRUNCATED);
+    U_PORT_TEST_ASSERT(uGnssRawDecode(&raw, gpMessageBuffer, 4) == (int32_t) U_ERROR_COMMON_TRUNCATED);
+    uGnssRawGetStats(&raw, &stats);
+    U_PORT_TEST_ASSERT(stats.badCount == 1);
+    U_PORT_TEST_ASSERT(pUGnssRawEpochGet(&raw) == NULL);
+
+    // A RAWX message with more measurements than will fit
+    U_TEST_PRINT_LINE("decoding a RAWX message with %d measurements.",
+                      U_GNSS_RAW_TEST_NUM_MEAS_TOO_MANY);
+    length = writeRawx(gpMessageBuffer, 0, U_GNSS_RAW_TEST_NUM_MEAS_TOO_MANY);
+    U_PORT_TEST_ASSERT(uGnssRawDecode(&raw, gpMessageBuffer, length) == 1);
+    pEpoch = pUGnssRawEpochGet(&raw);
+    U_PORT_TEST_ASSERT(pEpoch->numMeas == U_GNSS_RAW_MEAS_MAX_NUM);
+    U_PORT_TEST_ASSERT(pEpoch->prMes[U_GNSS_RAW_MEAS_MAX_NUM - 1] == 2.0e7 + ((U_GNSS_RAW_MEAS_MAX_NUM - 1) * 0.5));
+    uGnssRawEpochRelease(&raw);
+    uGnssRawGetStats(&raw, &stats);
+    U_PORT_TEST_ASSERT(stats.measDropped == U_GNSS_RAW_TEST_NUM_MEAS_TOO_MANY - U_GNSS_RAW_MEAS_MAX_NUM);
+
+    // A subframe with no epoch is completed by a flush
+    U_TEST_PRINT_LINE("flushing a subframe with no epoch.");
+    length = writeSfrbx(gpMessageBuffer, 0, 0);
+    U_PORT_TEST_ASSERT(uGnssRawDecode(&raw, gpMessageBuffer, length) == 0);
+    U_PORT_TEST_ASSERT(pUGnssRawEpochGet(&raw) == NULL);
+    U_PORT_TEST_ASSERT(uGnssRawFlush(&raw) == 1);
+    pEpoch = pUGnssRawEpochGet(&raw);
+    U_PORT_TEST_ASSERT(pEpoch->numMeas == 0);
+    U_PORT_TEST_ASSERT(pEpoch->numSubframes == 1);
+    U_PORT_TEST_ASSERT(pEpoch->sfDwrd[0][9] == 9);
+    uGnssRawEpochRelease(&raw);
+    U_PORT_TEST_ASSERT(uGnssRawFlush(&raw) == 0);
+
+    freeAll();
+
+    // Check for resource leaks
+    uTestUtilResourceCheck(U_TEST_PREFIX, NULL, true);
+    resourceCount = uTestUtilGetDynamicResourceCount() - resourceCount;
+    U_TEST_PRINT_LINE("we have leaked %d resources(s).", resourceCount);
+    U_PORT_TEST_ASSERT(resourceCount <= 0);
+}
+
+/** Benchmark decoding a log of raw measurements: the time and heap
+ * allocations per epoch, first the way it had to be done before,
+ * framing the messages then copying each into allocated memory and
+ * decoding UBX-RXM-RAWX with pUGnssDecAlloc(), then with
+ * uGnssRawFeed().
+ */
+U_PORT_TEST_FUNCTION("[gnssRaw]", "gnssRawBenchmark")
+{
+    int32_t resourceCount;
+    uGnssRaw_t raw;
+    uGnssFramer_t framer;
+    uGnssFramerFrame_t frame;
+    uGnssDec_t *pDec;
+    const uGnssRawEpoch_t *pEpoch;
+    char *pCopy;
+    size_t length = 0;
+    size_t numEpochs;
+    size_t numAllocs;
+    size_t offset;
+    size_t chunkLength;
+    int32_t x;
+    int32_t heapAllocCount;
+    int32_t startTimeMs;
+    int32_t durationMs;
+    double sum = 0;
+
+    // Get the initial resource count
+    resourceCount = uTestUtilGetDynamicResourceCount();
+
+    allocAll(&length);
+    U_TEST_PRINT_LINE("decoding a log of %d byte(s), %d epoch(s), %d time(s), in %d"
+                      " byte chunks.", length, U_GNSS_RAW_TEST_NUM_EPOCHS,
+                      U_GNSS_RAW_TEST_BENCHMARK_NUM_PASSES,
+                      U_GNSS_RAW_TEST_BENCHMARK_CHUNK_LENGTH_BYTES);
+
+    // Before: frame, copy each RXM message into allocated memory,
+    // as uGnssMsgReceive() would, and decode RAWX with pUGnssDecAlloc()
+    U_PORT_TEST_ASSERT(uGnssFramerInit(&framer, U_GNSS_FRAMER_PROTOCOLS_ALL,
+                                       gpBuffer, U_GNSS_RAW_TEST_BUFFER_LENGTH_BYTES) == 0);
+    numEpochs = 0;
+    numAllocs = 0;
+    startTimeMs = uPortGetTickTimeMs();
+    for (size_t y = 0; y < U_GNSS_RAW_TEST_BENCHMARK_NUM_PASSES; y++) {
+        for (offset = 0; offset < length; offset += chunkLength) {
+            chunkLength = U_GNSS_RAW_TEST_BENCHMARK_CHUNK_LENGTH_BYTES;
+            if (chunkLength > length - offset) {
+                chunkLength = length - offset;
+            }
+            do {
+                x = uGnssFramerFeed(&framer, gpLog + offset, chunkLength, &frame);
+                if ((frame.protocol == U_GNSS_FRAMER_PROTOCOL_UBX) &&
+                    ((frame.id.ubx >> 8) == U_GNSS_DEC_UBX_RXM_RAWX_MESSAGE_CLASS)) {
+                    heapAllocCount = uPortHeapAllocCount();
+                    pCopy = (char *) pUPortMalloc(frame.length);
+                    U_PORT_TEST_ASSERT(pCopy != NULL);
+                    memcpy(pCopy, frame.pData, frame.length);
+                    if ((frame.id.ubx & 0xFF) == U_GNSS_DEC_UBX_RXM_RAWX_MESSAGE_ID) {
+                        pDec = pUGnssDecAlloc(pCopy, frame.length);
+                        U_PORT_TEST_ASSERT((pDec != NULL) && (pDec->errorCode == 0));
+                        sum += pDec->pBody->ubxRxmRawx.meas[0].prMes;
+                        numEpochs++;
+                        numAllocs += uPortHeapAllocCount() - heapAllocCount;
+                        uGnssDecFree(pDec);
+                    } else {
+                        numAllocs += uPortHeapAllocCount() - heapAllocCount;
+                    }
+                    uPortFree(pCopy);
+                }
+                offset += x;
+                chunkLength -= x;
+            } while ((chunkLength > 0) || (frame.protocol != U_GNSS_FRAMER_PROTOCOL_NONE));
+        }
+    }
+    durationMs = uPortGetTickTimeMs() - startTimeMs;
+    if (durationMs <= 0) {
+        durationMs = 1;
+    }
+    U_PORT_TEST_ASSERT(numEpochs == U_GNSS_RAW_TEST_NUM_EPOCHS * U_GNSS_RAW_TEST_BENCHMARK_NUM_PASSES);
+    U_TEST_PRINT_LINE("before: %d epoch(s) in %d ms, %d us per epoch, %d heap"
+                      " allocation(s) per epoch.", numEpochs, durationMs,
+                      (int32_t) (((int64_t) durationMs * 1000) / numEpochs),
+                      numAllocs / numEpochs);
+
+    // After: uGnssRawFeed()
+    U_PORT_TEST_ASSERT(uGnssRawInit(&raw, gpEpochs, U_GNSS_RAW_TEST_RING_NUM_EPOCHS,
+                                    gpBuffer, U_GNSS_RAW_TEST_BUFFER_LENGTH_BYTES) == 0);
+    numEpochs = 0;
+    heapAllocCount = uPortHeapAllocCount();
+    startTimeMs = uPortGetTickTimeMs();
+    for (size_t y = 0; y < U_GNSS_RAW_TEST_BENCHMARK_NUM_PASSES; y++) {
+        for (offset = 0; offset < length; offset += chunkLength) {
+            chunkLength = U_GNSS_RAW_TEST_BENCHMARK_CHUNK_LENGTH_BYTES;
+            if (chunkLength > length - offset) {
+                chunkLength = length - offset;
+            }
+            if (uGnssRawFeed(&raw, gpLog + offset, chunkLength) > 0) {
+                for (pEpoch = pUGnssRawEpochGet(&raw); pEpoch != NULL; pEpoch = pUGnssRawEpochGet(&raw)) {
+                    sum += pEpoch->prMes[0];
+                    numEpochs++;
+                    uGnssRawEpochRelease(&raw);
+                }
+            }
+        }
+    }
+    durationMs = uPortGetTickTimeMs() - startTimeMs;
+    if (durationMs <= 0) {
+        durationMs = 1;
+    }
+    U_PORT_TEST_ASSERT(uPortHeapAllocCount() == heapAllocCount);
+    U_PORT_TEST_ASSERT(numEpochs == U_GNSS_RAW_TEST_NUM_EPOCHS * U_GNSS_RAW_TEST_BENCHMARK_NUM_PASSES);
+    U_TEST_PRINT_LINE("after: %d epoch(s) in %d ms, %d us per epoch, 0 heap"
+                      " allocation(s) per epoch.", numEpochs, durationMs,
+                      (int32_t) (((int64_t) durationMs * 1000) / numEpochs));
+    // Just so that the compiler can't optimise away the reads
+    U_PORT_TEST_ASSERT(sum > 0);
+
+    freeAll();
+
+    // Check for resource leaks
+    uTestUtilResourceCheck(U_TEST_PREFIX, NULL, true);
+    resourceCount = uTestUtilGetDynamicResourceCount() - resourceCount;
+    U_TEST_PRINT_LINE("we have leaked %d resources(s).", resourceCount);
+    U_PORT_TEST_ASSERT(resourceCount <= 0);
+}
+
+/** Clean-up to be run at the end of this round of tests, just
+ * in case there were test failures which would have resulted
+ * in the deinitialisation being skipped.
+ */
+U_PORT_TEST_FUNCTION("[gnssRaw]", "gnssRawCleanUp")
+{
+    freeAll();
+    // Printed for information: asserting happens in the postamble
+    uTestUtilResourceCheck(U_TEST_PREFIX, NULL, true);
+}
+
+// End of file
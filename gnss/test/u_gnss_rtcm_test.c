@@ -0,0 +1,725 @@
+/*
+ * Copyright 2019-2024 u-blox
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* Only #includes of u_* and the C standard library are allowed here,
+ * no platform stuff and no OS stuff.  Anything required from
+ * the platform/OS must be brought in through u_port* to maintain
+ * portability.
+ */
+
+/** @file
+ * @brief Tests for the GNSS RTCM3 decoder API: they do not require
+ * a GNSS module to run, hence these should pass on all platforms.
+ * IMPORTANT: see notes in u_cfg_test_platform_specific.h for the
+ * naming rules that must be followed when using the U_PORT_TEST_FUNCTION()
+ * macro.
+ */
+
+# ifdef U_CFG_OVERRIDE
+#  include "u_cfg_override.h" // For a customer's configuration override
+# endif
+
+#include "stddef.h"    // NULL, size_t etc.
+#include "stdint.h"    // int32_t etc.
+#include "stdbool.h"
+#include "string.h"    // memset(), memcpy()
+
+#include "u_cfg_sw.h"
+#include "u_cfg_os_platform_specific.h"
+#include "u_cfg_app_platform_specific.h"
+#include "u_cfg_test_platform_specific.h"
+
+#include "u_error_common.h"
+
+#include "u_port.h"
+#include "u_port_os.h"
+#include "u_port_heap.h"
+#include "u_port_debug.h"
+
+#include "u_test_util_resource_check.h"
+
+#include "u_gnss_rtcm.h"
+
+/* ----------------------------------------------------------------
+ * COMPILE-TIME MACROS
+ * -------------------------------------------------------------- */
+
+/** The string to put at the start of all prints from this test.
+ */
+#define U_TEST_PREFIX "U_GNSS_RTCM_TEST: "
+
+/** Print a whole line, with terminator, prefixed for this test file.
+ */
+#define U_TEST_PRINT_LINE(format, ...) uPortLog(U_TEST_PREFIX format "\n", ##__VA_ARGS__)
+
+#ifndef U_GNSS_RTCM_TEST_BENCHMARK_NUM_PASSES
+/** The number of times each message is decoded in the benchmark.
+ */
+# define U_GNSS_RTCM_TEST_BENCHMARK_NUM_PASSES 1000
+#endif
+
+/** Room for the largest RTCM3 message.
+ */
+#define U_GNSS_RTCM_TEST_MESSAGE_LENGTH_MAX_BYTES (U_GNSS_RTCM_HEADER_LENGTH_BYTES +  \
+                                                   U_GNSS_RTCM_BODY_LENGTH_MAX_BYTES + \
+                                                   U_GNSS_RTCM_CRC_LENGTH_BYTES)
+
+/* ----------------------------------------------------------------
+ * TYPES
+ * -------------------------------------------------------------- */
+
+/** An MSM to build for testing.
+ */
+typedef struct {
+    uint16_t messageType;
+    uint64_t satelliteMask;
+    uint32_t signalMask;
+    uint64_t cellMask; /**< right-aligned, as in #uGnssRtcmMsm_t. */
+} uGnssRtcmTestMsm_t;
+
+/* ----------------------------------------------------------------
+ * VARIABLES
+ * -------------------------------------------------------------- */
+
+/** An RTCM3 1005 message, from the documentation of pyrtcm.
+ */
+static const uint8_t g1005[] = {0xd3, 0x00, 0x13, 0x3e, 0xd0, 0x00, 0x03, 0x8a,
+                                0x58, 0xd9, 0x49, 0x3c, 0x87, 0x2f, 0x34, 0x10,
+                                0x9d, 0x07, 0xd6, 0xaf, 0x48, 0x20, 0x5a, 0xd7,
+                                0xf7
+                               };
+
+/** The MSMs to build and decode.
+ */
+static const uGnssRtcmTestMsm_t gTestMsm[] = {
+    // GPS MSM7, 5 satellites, 3 signals, 13 cells
+    {1077, 0x4808001080000000ULL, 0x40010400, 0x7f7bULL},
+    // GLONASS MSM4, the same
+    {1084, 0x4808001080000000ULL, 0x40010400, 0x7f7bULL},
+    // Galileo MSM5, 1 satellite, 1 signal
+    {1095, 0x0000000000000001ULL, 0x00000001, 0x1ULL},
+    // BeiDou MSM6, 8 satellites, 8 signals, all 64 cells
+    {1126, 0x8040201008040201ULL, 0x88888888, 0xffffffffffffffffULL},
+    // NavIC MSM7, 8 satellites, 8 signals, all 64 cells
+    {1137, 0xff00000000000000ULL, 0x000000ff, 0xffffffffffffffffULL}
+};
+
+/** Buffer for a message.
+ */
+static uint8_t *gpBuffer = NULL;
+
+/** The MSM that is encoded.
+ */
+static uGnssRtcmMsm_t *gpMsmExpected = NULL;
+
+/** The decoded message.
+ */
+static uGnssRtcmMessage_t *gpMessage = NULL;
+
+/** The state of the pseudo-random number generator.
+ */
+static uint32_t gRandom = 0;
+
+/* ----------------------------------------------------------------
+ * STATIC FUNCTIONS
+ * -------------------------------------------------------------- */
+
+// A simple pseudo-random number generator, so that the test is
+// the same on all platforms.
+static uint32_t randomGet()
+{
+    gRandom = (gRandom * 1103515245UL) + 12345;
+
+    return gRandom >> 1;
+}
+
+// A signed pseudo-random number of numBits.
+static int32_t randomSigned(size_t numBits)
+{
+    return (int32_t) (randomGet() % (1UL << numBits)) - (int32_t) (1UL << (numBits - 1));
+}
+
+// Get a bit-field the slow way, a bit at a time.
+static uint64_t naiveBitsGet(const uint8_t *pBuffer, size_t offsetBits, size_t numBits)
+{
+    uint64_t value = 0;
+
+    for (size_t x = offsetBits; x < offsetBits + numBits; x++) {
+        value = (value << 1) | ((pBuffer[x >> 3] >> (7 - (x & 7))) & 1);
+    }
+
+    return value;
+}
+
+// Put a bit-field the slow way, a bit at a time, returning the
+// new offset.
+static size_t naiveBitsPut(uint8_t *pBuffer, size_t offsetBits, size_t numBits,
+                           uint64_t value)
+{
+    uint8_t mask;
+
+    for (size_t x = 0; x < numBits; x++, offsetBits++) {
+        mask = (uint8_t) (0x80 >> (offsetBits & 7));
+        if ((value >> (numBits - 1 - x)) & 1) {
+            pBuffer[offsetBits >> 3] |= mask;
+        } else {
+            pBuffer[offsetBits >> 3] &= (uint8_t) ~mask;
+        }
+    }
+
+    return offsetBits;
+}
+
+// Calculate a CRC-24Q the slow way, a bit at a time.
+static uint32_t naiveCrc24q(const uint8_t *pData, size_t length)
+{
+    uint32_t crc = 0;
+
+    for (size_t x = 0; x < length; x++) {
+        crc ^= ((uint32_t) pData[x]) << 16;
+        for (size_t y = 0; y < 8; y++) {
+            crc <<= 1;
+            if (crc & 0x1000000) {
+                crc ^= 0x1864cfb;
+            }
+        }
+    }
+
+    return crc & 0xffffff;
+}
+
+// Put the header and CRC around a message body of the given number
+// of bits, already written at gpBuffer + U_GNSS_RTCM_HEADER_LENGTH_BYTES,
+// returning the length of the message.
+static size_t messageComplete(size_t numBits)
+{
+    size_t bodyLength = (numBits + 7) / 8;
+    uint32_t crc;
+
+    // Zero any padding bits
+    naiveBitsPut(gpBuffer + U_GNSS_RTCM_HEADER_LENGTH_BYTES, numBits,
+                 (bodyLength * 8) - numBits, 0);
+    gpBuffer[0] = 0xd3;
+    gpBuffer[1] = (uint8_t) (bodyLength >> 8);
+    gpBuffer[2] = (uint8_t) bodyLength;
+    crc = naiveCrc24q(gpBuffer, U_GNSS_RTCM_HEADER_LENGTH_BYTES + bodyLength);
+    gpBuffer[U_GNSS_RTCM_HEADER_LENGTH_BYTES + bodyLength] = (uint8_t) (crc >> 16);
+    gpBuffer[U_GNSS_RTCM_HEADER_LENGTH_BYTES + bodyLength + 1] = (uint8_t) (crc >> 8);
+    gpBuffer[U_GNSS_RTCM_HEADER_LENGTH_BYTES + bodyLength + 2] = (uint8_t) crc;
+
+    return U_GNSS_RTCM_HEADER_LENGTH_BYTES + bodyLength + U_GNSS_RTCM_CRC_LENGTH_BYTES;
+}
+
+// Fill gpMsmExpected with random values for the given MSM and encode
+// it into gpBuffer, returning the length of the message.
+static size_t msmBuild(const uGnssRtcmTestMsm_t *pTestMsm)
+{
+    uGnssRtcmMsm_t *pMsm = gpMsmExpected;
+    uint8_t *pBody = gpBuffer + U_GNSS_RTCM_HEADER_LENGTH_BYTES;
+    size_t offset = 0;
+    size_t numSatellites = 0;
+    size_t numSignals = 0;
+    size_t numCells = 0;
+    size_t numCellMaskBits;
+    bool highResolution;
+    bool rates;
+
+    memset(pMsm, 0, sizeof(*pMsm));
+    pMsm->msmType = (uint8_t) (pTestMsm->messageType % 10);
+    highResolution = (pMsm->msmType >= 6);
+    rates = ((pMsm->msmType == 5) || (pMsm->msmType == 7));
+    pMsm->stationId = (uint16_t) (randomGet() & 0xfff);
+    pMsm->epochTime = randomGet() & 0x3fffffff;
+    pMsm->multipleMessage = true;
+    pMsm->iods = 5;
+    pMsm->clockSteering = 1;
+    pMsm->externalClock = 2;
+    pMsm->smoothing = true;
+    pMsm->smoothingInterval = 3;
+    pMsm->satelliteMask = pTestMsm->satelliteMask;
+    pMsm->signalMask = pTestMsm->signalMask;
+    pMsm->cellMask = pTestMsm->cellMask;
+    for (size_t x = 0; x < U_GNSS_RTCM_MSM_SATELLITES_MAX_NUM; x++) {
+        if ((pMsm->satelliteMask >> (63 - x)) & 1) {
+            pMsm->satelliteId[numSatellites] = (uint8_t) (x + 1);
+            numSatellites++;
+        }
+    }
+    for (size_t x = 0; x < U_GNSS_RTCM_MSM_SIGNALS_MAX_NUM; x++) {
+        if ((pMsm->signalMask >> (31 - x)) & 1) {
+            pMsm->signalId[numSignals] = (uint8_t) (x + 1);
+            numSignals++;
+        }
+    }
+    numCellMaskBits = numSatellites * numSignals;
+    for (size_t x = 0; x < numCellMaskBits; x++) {
+        if ((pMsm->cellMask >> (numCellMaskBits - 1 - x)) & 1) {
+            pMsm->cellSatellite[numCells] = (uint8_t) (x / numSignals);
+            pMsm->cellSignal[numCells] = (uint8_t) (x % numSignals);
+            numCells++;
+        }
+    }
+    pMsm->numSatellites = (uint8_t) numSatellites;
+    pMsm->numSignals = (uint8_t) numSignals;
+    pMsm->numCells = (uint8_t) numCells;
+    for (size_t x = 0; x < numSatellites; x++) {
+        pMsm->roughRangeMs[x] = (uint8_t) randomGet();
+        pMsm->roughRangeModuloMs[x] = (uint16_t) (randomGet() & 0x3ff);
+        if (rates) {
+            pMsm->extendedInfo[x] = (uint8_t) (randomGet() & 0x0f);
+            pMsm->roughPhaseRangeRate[x] = (int16_t) randomSigned(14);
+        }
+    }
+    for (size_t x = 0; x < numCells; x++) {
+        pMsm->finePseudorange[x] = randomSigned(highResolution ? 20 : 15);
+        pMsm->finePhaseRange[x] = randomSigned(highResolution ? 24 : 22);
+        pMsm->lockTime[x] = (uint16_t) (randomGet() & (highResolution ? 0x3ff : 0x0f));
+        pMsm->halfCycleAmbiguity[x] = ((randomGet() & 1) != 0);
+        pMsm->cnr[x] = (uint16_t) (randomGet() & (highResolution ? 0x3ff : 0x3f));
+        if (rates) {
+            pMsm->finePhaseRangeRate[x] = (int16_t) randomSigned(15);
+        }
+    }
+
+    // Now encode it, the slow way
+    offset = naiveBitsPut(pBody, offset, 12, pTestMsm->messageType);
+    offset = naiveBitsPut(pBody, offset, 12, pMsm->stationId);
+    offset = naiveBitsPut(pBody, offset, 30, pMsm->epochTime);
+    offset = naiveBitsPut(pBody, offset, 1, pMsm->multipleMessage);
+    offset = naiveBitsPut(pBody, offset, 3, pMsm->iods);
+    offset = naiveBitsPut(pBody, offset, 7, 0);
+    offset = naiveBitsPut(pBody, offset, 2, pMsm->clockSteering);
+    offset = naiveBitsPut(pBody, offset, 2, pMsm->externalClock);
+    offset = naiveBitsPut(pBody, offset, 1, pMsm->smoothing);
+    offset = naiveBitsPut(pBody, offset, 3, pMsm->smoothingInterval);
+    offset = naiveBitsPut(pBody, offset, 64, pMsm->satelliteMask);
+    offset = naiveBitsPut(pBody, offset, 32, pMsm->signalMask);
+    offset = naiveBitsPut(pBody, offset, numCellMaskBits, pMsm->cellMask);
+    for (size_t x = 0; x < numSatellites; x++) {
+        offset = naiveBitsPut(pBody, offset, 8, pMsm->roughRangeMs[x]);
+    }
+    for (size_t x = 0; rates && (x < numSatellites); x++) {
+        offset = naiveBitsPut(pBody, offset, 4, pMsm->extendedInfo[x]);
+    }
+    for (size_t x = 0; x < numSatellites; x++) {
+        offset = naiveBitsPut(pBody, offset, 10, pMsm->roughRangeModuloMs[x]);
+    }
+    for (size_t x = 0; rates && (x < numSatellites); x++) {
+        offset = naiveBitsPut(pBody, offset, 14, (uint64_t) (int64_t) pMsm->roughPhaseRangeRate[x]);
+    }
+    for (size_t x = 0; x < numCells; x++) {
+        offset = naiveBitsPut(pBody, offset, highResolution ? 20 : 15,
+                              (uint64_t) (int64_t) pMsm->finePseudorange[x]);
+    }
+    for (size_t x = 0; x < numCells; x++) {
+        offset = naiveBitsPut(pBody, offset, highResolution ? 24 : 22,
+                              (uint64_t) (int64_t) pMsm->finePhaseRange[x]);
+    }
+    for (size_t x = 0; x < numCells; x++) {
+        offset = naiveBitsPut(pBody, offset, highResolution ? 10 : 4, pMsm->lockTime[x]);
+    }
+    for (size_t x = 0; x < numCells; x++) {
+        offset = naiveBitsPut(pBody, offset, 1, pMsm->halfCycleAmbiguity[x]);
+    }
+    for (size_t x = 0; x < numCells; x++) {
+        offset = naiveBitsPut(pBody, offset, highResolution ? 10 : 6, pMsm->cnr[x]);
+    }
+    for (size_t x = 0; rates && (x < numCells); x++) {
+        offset = naiveBitsPut(pBody, offset, 15, (uint64_t) (int64_t) pMsm->finePhaseRangeRate[x]);
+    }
+
+    return messageComplete(offset);
+}
+
+// Check that a decoded MSM matches gpMsmExpected.
+static void msmCheck(const uGnssRtcmMsm_t *pMsm)
+{
+    const uGnssRtcmMsm_t *pExpected = gpMsmExpected;
+
+    U_PORT_TEST_ASSERT(pMsm->msmType == pExpected->msmType);
+    U_PORT_TEST_ASSERT(pMsm->stationId == pExpected->stationId);
+    U_PORT_TEST_ASSERT(pMsm->epochTime == pExpected->epochTime);
+    U_PORT_TEST_ASSERT(pMsm->multipleMessage == pExpected->multipleMessage);
+    U_PORT_TEST_ASSERT(pMsm->iods == pExpected->iods);
+    U_PORT_TEST_ASSERT(pMsm->clockSteering == pExpected->clockSteering);
+    U_PORT_TEST_ASSERT(pMsm->externalClock == pExpected->externalClock);
+    U_PORT_TEST_ASSERT(pMsm->smoothing == pExpected->smoothing);
+    U_PORT_TEST_ASSERT(pMsm->smoothingInterval == pExpected->smoothingInterval);
+    U_PORT_TEST_ASSERT(pMsm->satelliteMask == pExpected->satelliteMask);
+    U_PORT_TEST_ASSERT(pMsm->signalMask == pExpected->signalMask);
+    U_PORT_TEST_ASSERT(pMsm->cellMask == pExpected->cellMask);
+    U_PORT_TEST_ASSERT(pMsm->numSatellites == pExpected->numSatellites);
+    U_PORT_TEST_ASSERT(pMsm->numSignals == pExpected->numSignals);
+    U_PORT_TEST_ASSERT(pMsm->numCells == pExpected->numCells);
+    for (size_t x = 0; x < pMsm->numSignals; x++) {
+        U_PORT_TEST_ASSERT(pMsm->signalId[x] == pExpected->signalId[x]);
+    }
+    for (size_t x = 0; x < pMsm->numSatellites; x++) {
+        U_PORT_TEST_ASSERT(pMsm->satelliteId[x] == pExpected->satelliteId[x]);
+        U_PORT_TEST_ASSERT(pMsm->roughRangeMs[x] == pExpected->roughRangeMs[x]);
+        U_PORT_TEST_ASSERT(pMsm->extendedInfo[x] == pExpected->extendedInfo[x]);
+        U_PORT_TEST_ASSERT(pMsm->roughRangeModuloMs[x] == pExpected->roughRangeModuloMs[x]);
+        U_PORT_TEST_ASSERT(pMsm->roughPhaseRangeRate[x] == pExpected->roughPhaseRangeRate[x]);
+    }
+    for (size_t x = 0; x < pMsm->numCells; x++) {
+        U_PORT_TEST_ASSERT(pMsm->cellSatellite[x] == pExpected->cellSatellite[x]);
+        U_PORT_TEST_ASSERT(pMsm->cellSignal[x] == pExpected->cellSignal[x]);
+        U_PORT_TEST_ASSERT(pMsm->finePseudorange[x] == pExpected->finePseudorange[x]);
+        U_PORT_TEST_ASSERT(pMsm->finePhaseRange[x] == pExpected->finePhaseRange[x]);
+        U_PORT_TEST_ASSERT(pMsm->finePhaseRangeRate[x] == pExpected->finePhaseRangeRate[x]);
+        U_PORT_TEST_ASSERT(pMsm->lockTime[x] == pExpected->lockTime[x]);
+        U_PORT_TEST_ASSERT(pMsm->cnr[x] == pExpected->cnr[x]);
+        U_PORT_TEST_ASSERT(pMsm->halfCycleAmbiguity[x] == pExpected->halfCycleAmbiguity[x]);
+    }
+}
+
+// Decode the satellite and signal data of an MSM7 the slow way, with
+// a bit-at-a-time CRC and bit-at-a-time bit-field extraction, as
+// an implementation which did not care about performance might;
+// returns the sum of the fine pseudoranges, to have something
+// to return.
+static int32_t naiveMsm7Decode(const uint8_t *pMessage, uGnssRtcmMsm_t *pMsm)
+{
+    size_t bodyLength = (((size_t) pMessage[1] & 0x03) << 8) | pMessage[2];
+    const uint8_t *pBody = pMessage + U_GNSS_RTCM_HEADER_LENGTH_BYTES;
+    size_t offset = 12 + 12 + 30 + 1 + 3 + 7 + 2 + 2 + 1 + 3;
+    size_t numSatellites = 0;
+    size_t numSignals = 0;
+    size_t numCells = 0;
+    int32_t sum = 0;
+
+    if (naiveCrc24q(pMessage, U_GNSS_RTCM_HEADER_LENGTH_BYTES + bodyLength) ==
+        naiveBitsGet(pBody + bodyLength, 0, 24)) {
+        pMsm->satelliteMask = naiveBitsGet(pBody, offset, 64);
+        offset += 64;
+        pMsm->signalMask = (uint32_t) naiveBitsGet(pBody, offset, 32);
+        offset += 32;
+        for (size_t x = 0; x < 64; x++) {
+            numSatellites += (pMsm->satelliteMask >> x) & 1;
+        }
+        for (size_t x = 0; x < 32; x++) {
+            numSignals += (pMsm->signalMask >> x) & 1;
+        }
+        pMsm->cellMask = naiveBitsGet(pBody, offset, numSatellites * numSignals);
+        offset += numSatellites * numSignals;
+        for (size_t x = 0; x < 64; x++) {
+            numCells += (pMsm->cellMask >> x) & 1;
+        }
+        for (size_t x = 0; x < numSatellites; x++) {
+            pMsm->roughRangeMs[x] = (uint8_t) naiveBitsGet(pBody, offset + (x * 8), 8);
+            pMsm->extendedInfo[x] = (uint8_t) naiveBitsGet(pBody, offset + (numSatellites * 8) +
+                                                           (x * 4), 4);
+            pMsm->roughRangeModuloMs[x] = (uint16_t) naiveBitsGet(pBody, offset + (numSatellites * 12) +
+                                                                  (x * 10), 10);
+            pMsm->roughPhaseRangeRate[x] = (int16_t) (naiveBitsGet(pBody, offset + (numSatellites * 22) +
+                                                                   (x * 14), 14) << 2) / 4;
+        }
+        offset += numSatellites * (8 + 4 + 10 + 14);
+        for (size_t x = 0; x < numCells; x++) {
+            pMsm->finePseudorange[x] = ((int32_t) (naiveBitsGet(pBody, offset + (x * 20),
+                                                                20) << 12)) / 4096;
+            pMsm->finePhaseRange[x] = ((int32_t) (naiveBitsGet(pBody, offset + (numCells * 20) +
+                                                               (x * 24), 24) << 8)) / 256;
+            pMsm->lockTime[x] = (uint16_t) naiveBitsGet(pBody, offset + (numCells * 44) +
+                                                        (x * 10), 10);
+            pMsm->halfCycleAmbiguity[x] = (naiveBitsGet(pBody, offset + (numCells * 54) + x, 1) != 0);
+            pMsm->cnr[x] = (uint16_t) naiveBitsGet(pBody, offset + (numCells * 55) + (x * 10), 10);
+            pMsm->finePhaseRangeRate[x] = (int16_t) (naiveBitsGet(pBody, offset + (numCells * 65) +
+                                                                  (x * 15), 15) << 1) / 2;
+            sum += pMsm->finePseudorange[x];
+        }
+    }
+
+    return sum;
+}
+
+/* ----------------------------------------------------------------
+ * PUBLIC FUNCTIONS
+ * -------------------------------------------------------------- */
+
+/** Test the CRC and bit-field extraction and decode RTCM3 messages.
+ */
+U_PORT_TEST_FUNCTION("[gnssRtcm]", "gnssRtcmBasic")
+{
+    int32_t resourceCount;
+    uGnssRtcmMessage_t *pMessage;
+    size_t length;
+    size_t offset;
+    uint32_t crc;
+    int64_t value;
+
+    // Get the initial resource count
+    resourceCount = uTestUtilGetDynamicResourceCount();
+
+    gpBuffer = (uint8_t *) pUPortMalloc(U_GNSS_RTCM_TEST_MESSAGE_LENGTH_MAX_BYTES);
+    U_PORT_TEST_ASSERT(gpBuffer != NULL);
+    gpMsmExpected = (uGnssRtcmMsm_t *) pUPortMalloc(sizeof(*gpMsmExpected));
+    U_PORT_TEST_ASSERT(gpMsmExpected != NULL);
+    gpMessage = (uGnssRtcmMessage_t *) pUPortMalloc(sizeof(*gpMessage));
+    U_PORT_TEST_ASSERT(gpMessage != NULL);
+    pMessage = gpMessage;
+    gRandom = 0;
+
+    // The CRC, all at once and in pieces of every alignment
+    U_TEST_PRINT_LINE("testing CRC-24Q.");
+    U_PORT_TEST_ASSERT(uGnssRtcmCrc24q((const char *) g1005, sizeof(g1005) - 3, 0) == 0x5ad7f7);
+    for (size_t x = 0; x < U_GNSS_RTCM_TEST_MESSAGE_LENGTH_MAX_BYTES; x++) {
+        gpBuffer[x] = (uint8_t) randomGet();
+    }
+    for (size_t x = 0; x < 64; x++) {
+        crc = uGnssRtcmCrc24q((const char *) gpBuffer, x, 0);
+        crc = uGnssRtcmCrc24q((const char *) gpBuffer + x, 100 - x, crc);
+        U_PORT_TEST_ASSERT(crc == naiveCrc24q(gpBuffer, 100));
+    }
+    U_PORT_TEST_ASSERT(uGnssRtcmCrc24q(NULL, 0, 0x123456) == 0x123456);
+
+    // Bit-fields, of every length at every offset near both ends
+    // of the buffer
+    U_TEST_PRINT_LINE("testing bit-field extraction.");
+    length = 32;
+    for (size_t numBits = 1; numBits <= 64; numBits++) {
+        for (offset = 0; offset + numBits <= length * 8; offset++) {
+            U_PORT_TEST_ASSERT(uGnssRtcmBitsGet((const char *) gpBuffer, length,
+                                                offset, numBits) == naiveBitsGet(gpBuffer, offset, numBits));
+            value = uGnssRtcmBitsGetSigned((const char *) gpBuffer, length, offset, numBits);
+            if ((numBits < 64) && ((naiveBitsGet(gpBuffer, offset, 1)) != 0)) {
+                U_PORT_TEST_ASSERT(value < 0);
+                U_PORT_TEST_ASSERT((uint64_t) value == (naiveBitsGet(gpBuffer, offset, numBits) |
+                                                        (UINT64_MAX << numBits)));
+            } else {
+                U_PORT_TEST_ASSERT((uint64_t) value == naiveBitsGet(gpBuffer, offset, numBits));
+            }
+        }
+        // Off the end
+        U_PORT_TEST_ASSERT(uGnssRtcmBitsGet((const char *) gpBuffer, length,
+                                            (length * 8) - numBits + 1, numBits) == 0);
+    }
+    U_PORT_TEST_ASSERT(uGnssRtcmBitsGet((const char *) gpBuffer, length, 0, 0) == 0);
+    U_PORT_TEST_ASSERT(uGnssRtcmBitsGet((const char *) gpBuffer, length, 0, 65) == 0);
+    U_PORT_TEST_ASSERT(uGnssRtcmBitsGet(NULL, length, 0, 1) == 0);
+
+    // A recorded 1005 message
+    U_TEST_PRINT_LINE("decoding RTCM3 1005, 1006 and 1230.");
+    U_PORT_TEST_ASSERT(uGnssRtcmDecode(NULL, sizeof(g1005), pMessage) < 0);
+    U_PORT_TEST_ASSERT(uGnssRtcmDecode((const char *) g1005, sizeof(g1005), NULL) < 0);
+    U_PORT_TEST_ASSERT(uGnssRtcmDecode((const char *) g1005, sizeof(g1005), pMessage) == 1005);
+    U_PORT_TEST_ASSERT(pMessage->messageType == 1005);
+    U_PORT_TEST_ASSERT(pMessage->station.stationId == 0);
+    U_PORT_TEST_ASSERT(pMessage->station.itrfYear == 0);
+    U_PORT_TEST_ASSERT(pMessage->station.gps);
+    U_PORT_TEST_ASSERT(pMessage->station.glonass);
+    U_PORT_TEST_ASSERT(pMessage->station.galileo);
+    U_PORT_TEST_ASSERT(!pMessage->station.referenceStation);
+    U_PORT_TEST_ASSERT(pMessage->station.ecefX == 44440308028LL);
+    U_PORT_TEST_ASSERT(pMessage->station.singleOscillator);
+    U_PORT_TEST_ASSERT(pMessage->station.ecefY == 30856712349LL);
+    U_PORT_TEST_ASSERT(pMessage->station.quarterCycle == 0);
+    U_PORT_TEST_ASSERT(pMessage->station.ecefZ == 33666582560LL);
+    U_PORT_TEST_ASSERT(pMessage->station.antennaHeight == 0);
+    // Longer buffer is fine, shorter is not, nor is a bad CRC
+    memcpy(gpBuffer, g1005, sizeof(g1005));
+    U_PORT_TEST_ASSERT(uGnssRtcmDecode((const char *) gpBuffer, sizeof(g1005) + 10, pMessage) == 1005);
+    U_PORT_TEST_ASSERT(uGnssRtcmDecode((const char *) gpBuffer, sizeof(g1005) - 1,
+                                       pMessage) == (int32_t) U_ERROR_COMMON_BAD_DATA);
+    gpBuffer[10] ^= 0x01;
+    U_PORT_TEST_ASSERT(uGnssRtcmDecode((const char *) gpBuffer, sizeof(g1005),
+                                       pMessage) == (int32_t) U_ERROR_COMMON_BAD_DATA);
+
+    // A 1006 message with negative coordinates
+    offset = naiveBitsPut(gpBuffer + U_GNSS_RTCM_HEADER_LENGTH_BYTES, 0, 12, 1006);
+    offset = naiveBitsPut(gpBuffer + U_GNSS_RTCM_HEADER_LENGTH_BYTES, offset, 12 + 6 + 4,
+                          (0xabc << 10) | 0x5);
+    offset = naiveBitsPut(gpBuffer + U_GNSS_RTCM_HEADER_LENGTH_BYTES, offset, 38, (uint64_t) (-12345678901LL));
+    offset = naiveBitsPut(gpBuffer + U_GNSS_RTCM_HEADER_LENGTH_BYTES, offset, 2, 0);
+    offset = naiveBitsPut(gpBuffer + U_GNSS_RTCM_HEADER_LENGTH_BYTES, offset, 38, (uint64_t) (-1LL));
+    offset = naiveBitsPut(gpBuffer + U_GNSS_RTCM_HEADER_LENGTH_BYTES, offset, 2, 3);
+    offset = naiveBitsPut(gpBuffer + U_GNSS_RTCM_HEADER_LENGTH_BYTES, offset, 38, (1ULL << 37) - 1);
+    offset = naiveBitsPut(gpBuffer + U_GNSS_RTCM_HEADER_LENGTH_BYTES, offset, 16, 15000);
+    length = messageComplete(offset);
+    U_PORT_TEST_ASSERT(uGnssRtcmDecode((const char *) gpBuffer, length, pMessage) == 1006);
+    U_PORT_TEST_ASSERT(pMessage->station.stationId == 0xabc);
+    U_PORT_TEST_ASSERT(!pMessage->station.gps);
+    U_PORT_TEST_ASSERT(pMessage->station.glonass);
+    U_PORT_TEST_ASSERT(!pMessage->station.galileo);
+    U_PORT_TEST_ASSERT(pMessage->station.referenceStation);
+    U_PORT_TEST_ASSERT(pMessage->station.ecefX == -12345678901LL);
+    U_PORT_TEST_ASSERT(pMessage->station.ecefY == -1);
+    U_PORT_TEST_ASSERT(pMessage->station.quarterCycle == 3);
+    U_PORT_TEST_ASSERT(pMessage->station.ecefZ == (1LL << 37) - 1);
+    U_PORT_TEST_ASSERT(pMessage->station.antennaHeight == 15000);
+    // Too short for a 1006
+    length = messageComplete(offset - 16);
+    U_PORT_TEST_ASSERT(uGnssRtcmDecode((const char *) gpBuffer, length,
+                                       pMessage) == (int32_t) U_ERROR_COMMON_BAD_DATA);
+
+    // A 1230 message with L1 C/A and L2 P biases only
+    offset = naiveBitsPut(gpBuffer + U_GNSS_RTCM_HEADER_LENGTH_BYTES, 0, 12, 1230);
+    offset = naiveBitsPut(gpBuffer + U_GNSS_RTCM_HEADER_LENGTH_BYTES, offset, 12, 4095);
+    offset = naiveBitsPut(gpBuffer + U_GNSS_RTCM_HEADER_LENGTH_BYTES, offset, 4, 0x08);
+    offset = naiveBitsPut(gpBuffer + U_GNSS_RTCM_HEADER_LENGTH_BYTES, offset, 4, 0x09);
+    offset = naiveBitsPut(gpBuffer + U_GNSS_RTCM_HEADER_LENGTH_BYTES, offset, 16, (uint64_t) (-500LL));
+    offset = naiveBitsPut(gpBuffer + U_GNSS_RTCM_HEADER_LENGTH_BYTES, offset, 16, 32767);
+    length = messageComplete(offset);
+    U_PORT_TEST_ASSERT(uGnssRtcmDecode((const char *) gpBuffer, length, pMessage) == 1230);
+    U_PORT_TEST_ASSERT(pMessage->glonassBias.stationId == 4095);
+    U_PORT_TEST_ASSERT(pMessage->glonassBias.aligned);
+    U_PORT_TEST_ASSERT(pMessage->glonassBias.signalMask == 0x09);
+    U_PORT_TEST_ASSERT(pMessage->glonassBias.l1Ca == -500);
+    U_PORT_TEST_ASSERT(pMessage->glonassBias.l1P == 0);
+    U_PORT_TEST_ASSERT(pMessage->glonassBias.l2Ca == 0);
+    U_PORT_TEST_ASSERT(pMessage->glonassBias.l2P == 32767);
+    length = messageComplete(offset - 16);
+    U_PORT_TEST_ASSERT(uGnssRtcmDecode((const char *) gpBuffer, length,
+                                       pMessage) == (int32_t) U_ERROR_COMMON_BAD_DATA);
+
+    // A message we don't decode still has its type returned
+    offset = naiveBitsPut(gpBuffer + U_GNSS_RTCM_HEADER_LENGTH_BYTES, 0, 12, 1019);
+    length = messageComplete(offset + 100);
+    U_PORT_TEST_ASSERT(uGnssRtcmDecode((const char *) gpBuffer, length,
+                                       pMessage) == (int32_t) U_ERROR_COMMON_NOT_SUPPORTED);
+    U_PORT_TEST_ASSERT(pMessage->messageType == 1019);
+    // ...and MSM1 to 3 are not decoded
+    offset = naiveBitsPut(gpBuffer + U_GNSS_RTCM_HEADER_LENGTH_BYTES, 0, 12, 1073);
+    length = messageComplete(offset + 300);
+    U_PORT_TEST_ASSERT(uGnssRtcmDecode((const char *) gpBuffer, length,
+                                       pMessage) == (int32_t) U_ERROR_COMMON_NOT_SUPPORTED);
+
+    // MSMs
+    for (size_t x = 0; x < sizeof(gTestMsm) / sizeof(gTestMsm[0]); x++) {
+        U_TEST_PRINT_LINE("decoding RTCM3 %d.", gTestMsm[x].messageType);
+        length = msmBuild(&(gTestMsm[x]));
+        memset(pMessage, 0xa5, sizeof(*pMessage));
+        U_PORT_TEST_ASSERT(uGnssRtcmDecode((const char *) gpBuffer, length,
+                                           pMessage) == gTestMsm[x].messageType);
+        msmCheck(&(pMessage->msm));
+        // One byte less must fail
+        length = messageComplete((length - U_GNSS_RTCM_HEADER_LENGTH_BYTES -
+                                  U_GNSS_RTCM_CRC_LENGTH_BYTES - 1) * 8);
+        U_PORT_TEST_ASSERT(uGnssRtcmDecode((const char *) gpBuffer, length,
+                                           pMessage) == (int32_t) U_ERROR_COMMON_BAD_DATA);
+    }
+    // Too many cells
+    offset = naiveBitsPut(gpBuffer + U_GNSS_RTCM_HEADER_LENGTH_BYTES, 0, 12, 1077);
+    offset = naiveBitsPut(gpBuffer + U_GNSS_RTCM_HEADER_LENGTH_BYTES, offset, 12 + 30 + 1 + 3 + 7 + 2 + 2 + 1 + 3, 0);
+    offset = naiveBitsPut(gpBuffer + U_GNSS_RTCM_HEADER_LENGTH_BYTES, offset, 64, 0xff80000000000000ULL);
+    offset = naiveBitsPut(gpBuffer + U_GNSS_RTCM_HEADER_LENGTH_BYTES, offset, 32, 0xff000000);
+    length = messageComplete(offset + 800);
+    U_PORT_TEST_ASSERT(uGnssRtcmDecode((const char *) gpBuffer, length,
+                                       pMessage) == (int32_t) U_ERROR_COMMON_BAD_DATA);
+
+    uPortFree(gpMessage);
+    gpMessage = NULL;
+    uPortFree(gpMsmExpected);
+    gpMsmExpected = NULL;
+    uPortFree(gpBuffer);
+    gpBuffer = NULL;
+
+    // Check for resource leaks
+    uTestUtilResourceCheck(U_TEST_PREFIX, NULL, true);
+    resourceCount = uTestUtilGetDynamicResourceCount() - resourceCount;
+    U_TEST_PRINT_LINE("we have leaked %d resources(s).", resourceCount);
+    U_PORT_TEST_ASSERT(resourceCount <= 0);
+}
+
+/** Benchmark decoding a full MSM7: first the way an implementation
+ * that works a bit at a time would do it, then with
+ * uGnssRtcmDecode().
+ */
+U_PORT_TEST_FUNCTION("[gnssRtcm]", "gnssRtcmBenchmark")
+{
+    int32_t resourceCount;
+    size_t length;
+    int32_t startTimeMs;
+    int32_t timeMs;
+    int32_t sum = 0;
+    int32_t sumNaive = 0;
+
+    // Get the initial resource count
+    resourceCount = uTestUtilGetDynamicResourceCount();
+
+    gpBuffer = (uint8_t *) pUPortMalloc(U_GNSS_RTCM_TEST_MESSAGE_LENGTH_MAX_BYTES);
+    U_PORT_TEST_ASSERT(gpBuffer != NULL);
+    gpMsmExpected = (uGnssRtcmMsm_t *) pUPortMalloc(sizeof(*gpMsmExpected));
+    U_PORT_TEST_ASSERT(gpMsmExpected != NULL);
+    gpMessage = (uGnssRtcmMessage_t *) pUPortMalloc(sizeof(*gpMessage));
+    U_PORT_TEST_ASSERT(gpMessage != NULL);
+    gRandom = 0;
+
+    // An MSM7 with 64 cells
+    length = msmBuild(&(gTestMsm[4]));
+    U_TEST_PRINT_LINE("decoding a %d byte MSM7 with %d cells %d time(s).",
+                      length, gpMsmExpected->numCells,
+                      U_GNSS_RTCM_TEST_BENCHMARK_NUM_PASSES);
+
+    // Before
+    startTimeMs = uPortGetTickTimeMs();
+    for (size_t x = 0; x < U_GNSS_RTCM_TEST_BENCHMARK_NUM_PASSES; x++) {
+        sumNaive += naiveMsm7Decode(gpBuffer, &(gpMessage->msm));
+    }
+    timeMs = uPortGetTickTimeMs() - startTimeMs;
+    U_TEST_PRINT_LINE("bit at a time: %d ms, %d ns per message.", timeMs,
+                      (int32_t) (((int64_t) timeMs * 1000000) / U_GNSS_RTCM_TEST_BENCHMARK_NUM_PASSES));
+    for (size_t x = 0; x < gpMsmExpected->numCells; x++) {
+        U_PORT_TEST_ASSERT(gpMessage->msm.finePseudorange[x] == gpMsmExpected->finePseudorange[x]);
+        U_PORT_TEST_ASSERT(gpMessage->msm.finePhaseRange[x] == gpMsmExpected->finePhaseRange[x]);
+        U_PORT_TEST_ASSERT(gpMessage->msm.finePhaseRangeRate[x] == gpMsmExpected->finePhaseRangeRate[x]);
+    }
+
+    // After
+    startTimeMs = uPortGetTickTimeMs();
+    for (size_t x = 0; x < U_GNSS_RTCM_TEST_BENCHMARK_NUM_PASSES; x++) {
+        U_PORT_TEST_ASSERT(uGnssRtcmDecode((const char *) gpBuffer, length, gpMessage) == 1137);
+        for (size_t y = 0; y < gpMessage->msm.numCells; y++) {
+            sum += gpMessage->msm.finePseudorange[y];
+        }
+    }
+    timeMs = uPortGetTickTimeMs() - startTimeMs;
+    U_TEST_PRINT_LINE("uGnssRtcmDecode(): %d ms, %d ns per message.", timeMs,
+                      (int32_t) (((int64_t) timeMs * 1000000) / U_GNSS_RTCM_TEST_BENCHMARK_NUM_PASSES));
+    msmCheck(&(gpMessage->msm));
+    U_PORT_TEST_ASSERT(sum == sumNaive);
+
+    uPortFree(gpMessage);
+    gpMessage = NULL;
+    uPortFree(gpMsmExpected);
+    gpMsmExpected = NULL;
+    uPortFree(gpBuffer);
+    gpBuffer = NULL;
+
+    // Check for resource leaks
+    uTestUtilResourceCheck(U_TEST_PREFIX, NULL, true);
+    resourceCount = uTestUtilGetDynamicResourceCount() - resourceCount;
+    U_TEST_PRINT_LINE("we have leaked %d resources(s).", resourceCount);
+    U_PORT_TEST_ASSERT(resourceCount <= 0);
+}
+
+/** Clean-up to be run at the end of this round of tests, just
+ * in case there were test failures which would have resulted
+ * in the deinitialisation being skipped.
+ */
+U_PORT_TEST_FUNCTION("[gnssRtcm]", "gnssRtcmCleanUp")
+{
+    uPortFree(gpMessage);
+    gpMessage = NULL;
+    uPortFree(gpMsmExpected);
+    gpMsmExpected = NULL;
+    uPortFree(gpBuffer);
+    gpBuffer = NULL;
+    // Printed for information: asserting happens in the postamble
+    uTestUtilResourceCheck(U_TEST_PREFIX, NULL, true);
+}
+
+// End of file
@@ -68,5 +68,7 @@ message("UBXLIB_COMPILE_OPTIONS will be \"${UBXLIB_COMPILE_OPTIONS}\"")
 target_compile_options(ubxlib PUBLIC ${UBXLIB_COMPILE_OPTIONS})
 target_include_directories(ubxlib PUBLIC ${UBXLIB_INC} ${UBXLIB_PUBLIC_INC_PORT})
 target_include_directories(ubxlib PRIVATE ${UBXLIB_PRIVATE_INC} ${UBXLIB_PRIVATE_INC_PORT})
+# Flash is not a concern here so calculate CRCs eight bytes at a time
+target_compile_definitions(ubxlib PRIVATE U_CRC_SLICING_BY_8_ENABLE)
 
 
@@ -0,0 +1,243 @@
+/*
+ * Copyright 2019-2024 u-blox
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** @file
+ * @brief Replay captured AT traffic through the AT client on Linux
+ * and report throughput, CPU cost and latency; see README.md.
+ */
+
+#ifdef U_CFG_OVERRIDE
+# include "u_cfg_override.h" // For a customer's configuration override
+#endif
+
+#include "stddef.h"    // NULL, size_t etc.
+#include "stdint.h"    // int32_t etc.
+#include "stdbool.h"
+#include "stdlib.h"    // malloc(), free(), atoi()
+#include "stdio.h"     // printf(), fopen()
+#include "string.h"    // strcmp(), strrchr()
+#include "time.h"      // clock_gettime()
+
+#include "u_cfg_sw.h"
+#include "u_cfg_os_platform_specific.h"
+
+#include "u_error_common.h"
+
+#include "u_port.h"
+#include "u_port_os.h"
+
+#include "u_at_client.h"
+#include "u_at_client_replay.h"
+
+/* ----------------------------------------------------------------
+ * COMPILE-TIME MACROS
+ * -------------------------------------------------------------- */
+
+/** The default number of times each transcript is played back
+ * as fast as possible.
+ */
+#define U_AT_REPLAY_DEFAULT_NUM_PASSES 100
+
+/* ----------------------------------------------------------------
+ * TYPES
+ * -------------------------------------------------------------- */
+
+/** The command-line, passed to appTask().
+ */
+typedef struct {
+    int argc;
+    char **argv;
+    int exitCode;
+} uAtReplayArgs_t;
+
+/* ----------------------------------------------------------------
+ * STATIC FUNCTIONS
+ * -------------------------------------------------------------- */
+
+// Read a whole file into a malloc()ed buffer.
+static char *pReadFile(const char *pFileName, size_t *pLength)
+{
+    char *pText = NULL;
+    FILE *pFile = fopen(pFileName, "rb");
+    long length;
+
+    if (pFile != NULL) {
+        if ((fseek(pFile, 0, SEEK_END) == 0) &&
+            ((length = ftell(pFile)) >= 0) &&
+            (fseek(pFile, 0, SEEK_SET) == 0)) {
+            pText = (char *) malloc(length + 1);
+            if ((pText != NULL) &&
+                (fread(pText, 1, length, pFile) != (size_t) length)) {
+                free(pText);
+                pText = NULL;
+            }
+            *pLength = (size_t) length;
+        }
+        fclose(pFile);
+    }
+
+    return pText;
+}
+
+// Get the time from the given clock in nanoseconds.
+static int64_t timeNs(clockid_t clock)
+{
+    struct timespec t;
+
+    clock_gettime(clock, &t);
+
+    return (((int64_t) t.tv_sec) * 1000000000LL) + t.tv_nsec;
+}
+
+// Replay one transcript, returning the number of problems.
+static int replay(const char *pFileName, int32_t numPasses, bool timed)
+{
+    int numProblems = 1;
+    uAtClientReplayTranscript_t transcript;
+    uAtClientReplayResults_t results;
+    const char *pName = strrchr(pFileName, '/');
+    char *pText;
+    size_t length = 0;
+    int32_t errorCode = 0;
+    int64_t numCommands = 0;
+    int64_t numUrcs = 0;
+    int64_t numBytes = 0;
+    int64_t startNs;
+    int64_t durationUs;
+    int64_t cpuNs;
+
+    pName = (pName != NULL) ? pName + 1 : pFileName;
+    pText = pReadFile(pFileName, &length);
+    if (pText == NULL) {
+        printf("%s: unable to read file.\n", pName);
+    } else if (uAtClientReplayTranscriptParse(pText, length, &transcript) <= 0) {
+        printf("%s: not a transcript.\n", pName);
+        free(pText);
+    } else {
+        free(pText);
+        numProblems = 0;
+        // The per-run durations are only milliseconds, too coarse
+        // when replaying at full speed, so time all of the passes
+        startNs = timeNs(CLOCK_MONOTONIC);
+        cpuNs = timeNs(CLOCK_PROCESS_CPUTIME_ID);
+        for (int32_t x = 0; (x < numPasses) && (errorCode == 0); x++) {
+            errorCode = uAtClientReplayRun(&transcript, false, &results);
+            if (errorCode == 0) {
+                numCommands += results.numCommands;
+                numUrcs += results.numUrcs;
+                numBytes += results.bytesSent + results.bytesReceived;
+                numProblems += (int) results.numMismatches;
+                uAtClientReplayResultsFree(&results);
+            }
+        }
+        cpuNs = timeNs(CLOCK_PROCESS_CPUTIME_ID) - cpuNs;
+        durationUs = (timeNs(CLOCK_MONOTONIC) - startNs) / 1000;
+        if (durationUs <= 0) {
+            durationUs = 1;
+        }
+        if (errorCode == 0) {
+            printf("%s: %d pass(es), %lld AT command(s), %lld URC(s), %lld byte(s)"
+                   " in %lld us: %lld AT commands/s, %lld URCs/s, %lld ns of CPU per"
+                   " byte.\n", pName, (int) numPasses, (long long) numCommands,
+                   (long long) numUrcs, (long long) numBytes, (long long) durationUs,
+                   (long long) (numCommands * 1000000 / durationUs),
+                   (long long) (numUrcs * 1000000 / durationUs),
+                   (long long) (numBytes > 0 ? cpuNs / numBytes : 0));
+        }
+        if ((errorCode == 0) && timed) {
+            errorCode = uAtClientReplayRun(&transcript, true, &results);
+            if (errorCode == 0) {
+                numProblems += (int) results.numMismatches;
+                printf("%s: timed, %d AT command(s) in %d ms, %d error(s), latency"
+                       " p50 %d ms, p90 %d ms, p99 %d ms, p99.9 %d ms, max %d ms.\n",
+                       pName, (int) results.numCommands, (int) results.durationMs,
+                       (int) results.numDeviceErrors,
+                       (int) uAtClientReplayLatencyPercentile(&results, 500),
+                       (int) uAtClientReplayLatencyPercentile(&results, 900),
+                       (int) uAtClientReplayLatencyPercentile(&results, 990),
+                       (int) uAtClientReplayLatencyPercentile(&results, 999),
+                       (int) uAtClientReplayLatencyPercentile(&results, 1000));
+                uAtClientReplayResultsFree(&results);
+            }
+        }
+        if (errorCode != 0) {
+            printf("%s: replay failed (%d).\n", pName, (int) errorCode);
+            numProblems++;
+        } else if (numProblems > 0) {
+            printf("%s: *** %d mismatch(es) with the transcript.\n", pName,
+                   numProblems);
+        }
+        uAtClientReplayTranscriptFree(&transcript);
+    }
+
+    return numProblems;
+}
+
+// The task within which the replay runs.
+static void appTask(void *pParam)
+{
+    uAtReplayArgs_t *pArgs = (uAtReplayArgs_t *) pParam;
+    int32_t numPasses = U_AT_REPLAY_DEFAULT_NUM_PASSES;
+    bool timed = true;
+    int numProblems = 0;
+    int numFiles = 0;
+
+    uPortInit();
+    uAtClientInit();
+
+    for (int x = 1; x < pArgs->argc; x++) {
+        if ((strcmp(pArgs->argv[x], "-n") == 0) && (x + 1 < pArgs->argc)) {
+            x++;
+            numPasses = atoi(pArgs->argv[x]);
+        } else if (strcmp(pArgs->argv[x], "-f") == 0) {
+            timed = false;
+        } else {
+            numProblems += replay(pArgs->argv[x], numPasses, timed);
+            numFiles++;
+        }
+    }
+    if (numFiles == 0) {
+        printf("usage: %s [-n passes] [-f] transcript...\n"
+               "  -n  the number of times to replay each transcript as fast"
+               " as possible, default %d.\n"
+               "  -f  fast only: don't replay with the recorded timing.\n",
+               pArgs->argv[0], U_AT_REPLAY_DEFAULT_NUM_PASSES);
+        numProblems++;
+    }
+
+    uAtClientDeinit();
+    uPortDeinit();
+
+    pArgs->exitCode = (numProblems > 0) ? 1 : 0;
+}
+
+/* ----------------------------------------------------------------
+ * PUBLIC FUNCTIONS
+ * -------------------------------------------------------------- */
+
+// Entry point
+int main(int argc, char *argv[])
+{
+    uAtReplayArgs_t args = {.argc = argc, .argv = argv, .exitCode = 1};
+
+    uPortPlatformStart(appTask, &args,
+                       U_CFG_OS_APP_TASK_STACK_SIZE_BYTES,
+                       U_CFG_OS_APP_TASK_PRIORITY);
+
+    return args.exitCode;
+}
+
+// End of file
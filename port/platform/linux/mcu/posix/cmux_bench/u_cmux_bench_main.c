@@ -0,0 +1,1002 @@
+/*
+ * Copyright 2019-2024 u-blox
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** @file
+ * @brief Measure the throughput and latency of the cellular CMUX
+ * code on Linux against a simulated 3GPP 27.010 peer on the far
+ * side of a pseudo-terminal; see README.md.
+ */
+
+#ifdef U_CFG_OVERRIDE
+# include "u_cfg_override.h" // For a customer's configuration override
+#endif
+
+#define _GNU_SOURCE    // posix_openpt() etc.
+#include "stddef.h"    // NULL, size_t etc.
+#include "stdint.h"    // int32_t etc.
+#include "stdbool.h"
+#include "stdlib.h"    // malloc(), free(), atoi(), qsort(), posix_openpt()
+#include "stdio.h"     // printf()
+#include "string.h"    // memset(), memcpy(), strcmp(), strncmp()
+#include "time.h"      // clock_gettime(), clock_nanosleep()
+#include "fcntl.h"     // O_RDWR
+#include "unistd.h"    // read(), write(), close()
+#include "poll.h"      // poll()
+
+#include "u_cfg_sw.h"
+#include "u_cfg_os_platform_specific.h"
+
+#include "u_error_common.h"
+
+#include "u_port.h"
+#include "u_port_os.h"
+#include "u_port_uart.h"
+
+#include "u_crc.h"
+#include "u_ringbuffer.h"
+#include "u_device_serial.h"
+
+#include "u_at_client.h"
+
+#include "u_cell_module_type.h"
+#include "u_cell.h"
+#include "u_cell_file.h"
+#include "u_cell_net.h"     // Required by u_cell_private.h
+#include "u_cell_private.h" // Required by u_cell_mux_private.h
+#include "u_cell_mux.h"
+#include "u_cell_mux_private.h"
+
+/* ----------------------------------------------------------------
+ * COMPILE-TIME MACROS
+ * -------------------------------------------------------------- */
+
+/** The default number of kbytes to send in each direction on each
+ * data channel.
+ */
+#define U_CMUX_BENCH_DEFAULT_KBYTES 128
+
+/** The default bit rate of the emulated UART, 10 bits per byte.
+ */
+#define U_CMUX_BENCH_DEFAULT_BAUD_RATE 921600
+
+/** The module type to pretend to be: one with CMUX support that
+ * does not need to be asked which serial interface is in use.
+ */
+#define U_CMUX_BENCH_MODULE_TYPE U_CELL_MODULE_TYPE_SARA_R422
+
+/** The first CMUX channel used for bulk data; the number of data
+ * channels is limited by #U_CELL_MUX_MAX_CHANNELS, which includes
+ * the control and AT channels.
+ */
+#define U_CMUX_BENCH_FIRST_DATA_CHANNEL 2
+
+/** The maximum number of data channels.
+ */
+#define U_CMUX_BENCH_MAX_DATA_CHANNELS (U_CELL_MUX_MAX_CHANNELS - 2)
+
+/** The length of a record in the bulk data: a sequence number,
+ * the time the record was sent and a pattern to check.
+ */
+#define U_CMUX_BENCH_RECORD_LENGTH_BYTES 32
+
+/** The number of bytes written by the MCU side in one go;
+ * must be a multiple of #U_CMUX_BENCH_RECORD_LENGTH_BYTES.
+ */
+#define U_CMUX_BENCH_WRITE_LENGTH_BYTES (U_CMUX_BENCH_RECORD_LENGTH_BYTES * 8)
+
+/** The amount read from the pseudo-terminal by the peer in one go.
+ */
+#define U_CMUX_BENCH_PEER_READ_LENGTH_BYTES 256
+
+/** The size of the receive buffer of the peer.
+ */
+#define U_CMUX_BENCH_PEER_BUFFER_LENGTH_BYTES 2048
+
+/** The size of the buffer in which the receive task of the peer
+ * leaves replies for the transmit task of the peer to send.
+ */
+#define U_CMUX_BENCH_PEER_REPLY_LENGTH_BYTES 512
+
+/** Give up if no data has moved for this long.
+ */
+#define U_CMUX_BENCH_STALL_MS 3000
+
+/** The number of iterations when timing the encoder, the decoder
+ * and the FCS.
+ */
+#define U_CMUX_BENCH_FCS_ITERATIONS 100000
+
+/* ----------------------------------------------------------------
+ * TYPES
+ * -------------------------------------------------------------- */
+
+/** The command-line, passed to appTask().
+ */
+typedef struct {
+    int argc;
+    char **argv;
+    int exitCode;
+} uCmuxBenchArgs_t;
+
+/** The receiving end of a stream of records in one direction on
+ * one channel.
+ */
+typedef struct {
+    char record[U_CMUX_BENCH_RECORD_LENGTH_BYTES]; /**< a record being reassembled. */
+    size_t recordIndex;       /**< the number of bytes in record[]. */
+    uint32_t nextSequence;    /**< the sequence number expected next. */
+    volatile size_t numBytes; /**< the number of bytes received. */
+    volatile int32_t numBad;  /**< the number of records that were wrong. */
+    int64_t *pLatencyUs;      /**< the latency of each record received. */
+    int32_t numLatencies;     /**< the number of entries in pLatencyUs. */
+    int32_t maxLatencies;     /**< the number of entries pLatencyUs can hold. */
+    int64_t endNs;            /**< the time the last record was received. */
+    size_t numFrames;         /**< the number of CMUX frames carrying the stream. */
+    size_t numWireBytes;      /**< the number of bytes of those frames. */
+} uCmuxBenchStream_t;
+
+/** A data channel.
+ */
+typedef struct {
+    uint8_t channel;                /**< the CMUX address. */
+    uDeviceSerial_t *pDeviceSerial; /**< the virtual serial port on the MCU side. */
+    size_t numBytes;                /**< the number of bytes to send each way. */
+    uCmuxBenchStream_t uplink;      /**< MCU to peer, received by the peer. */
+    uCmuxBenchStream_t downlink;    /**< peer to MCU, received by the MCU. */
+    volatile bool writerRunning;    /**< true while the MCU writer task runs. */
+    volatile int32_t writerErrorCode; /**< non-zero if the MCU writer failed. */
+    volatile bool downlinkStopped;  /**< set by the MCU with an MSC. */
+    size_t downlinkBytesSent;       /**< the number of bytes the peer has sent. */
+    uint32_t downlinkSequence;      /**< the sequence number of downlinkRecord. */
+    char downlinkRecord[U_CMUX_BENCH_RECORD_LENGTH_BYTES]; /**< being sent by the peer. */
+    size_t downlinkRecordIndex;     /**< the number of bytes of it already sent. */
+} uCmuxBenchChannel_t;
+
+/** The simulated 27.010 peer, i.e. the module.
+ */
+typedef struct {
+    int fd;                            /**< the master side of the pseudo-terminal. */
+    uPortMutexHandle_t mutexReply;     /**< protects reply[] and replyLength. */
+    char reply[U_CMUX_BENCH_PEER_REPLY_LENGTH_BYTES]; /**< replies waiting to be sent. */
+    size_t replyLength;                /**< the number of bytes in reply[]. */
+    int64_t byteNs;                    /**< the time for a byte at the baud rate, 0 for no limit. */
+    int64_t rxLineNs;                  /**< when the MCU to peer line is next free. */
+    int64_t txLineNs;                  /**< when the peer to MCU line is next free. */
+    volatile bool cmuxMode;            /**< true once AT+CMUX has been answered. */
+    volatile bool downlinkGo;          /**< true to start sending bulk data. */
+    volatile bool stop;                /**< true to stop the peer tasks. */
+    volatile bool rxRunning;           /**< true while the receive task runs. */
+    volatile bool txRunning;           /**< true while the transmit task runs. */
+    volatile int32_t numUnexpected;    /**< the number of unexpected things received. */
+    char atLine[64];                   /**< an AT command being received. */
+    size_t atLineLength;               /**< the number of characters in atLine[]. */
+    uCmuxBenchChannel_t *pChannel;     /**< the data channels. */
+    size_t numChannels;                /**< the number of entries in pChannel. */
+} uCmuxBenchPeer_t;
+
+/* ----------------------------------------------------------------
+ * STATIC FUNCTIONS: MISC
+ * -------------------------------------------------------------- */
+
+// Get the time from the given clock in nanoseconds.
+static int64_t timeNs(clockid_t clock)
+{
+    struct timespec t;
+
+    clock_gettime(clock, &t);
+
+    return (((int64_t) t.tv_sec) * 1000000000LL) + t.tv_nsec;
+}
+
+// Sleep until the given monotonic time in nanoseconds.
+static void sleepUntilNs(int64_t thenNs)
+{
+    struct timespec t;
+
+    t.tv_sec = thenNs / 1000000000LL;
+    t.tv_nsec = thenNs % 1000000000LL;
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &t, NULL) != 0) {}
+}
+
+// Compare two int64_t's for qsort().
+static int compareInt64(const void *pA, const void *pB)
+{
+    int64_t a = *((const int64_t *) pA);
+    int64_t b = *((const int64_t *) pB);
+
+    return (a > b) - (a < b);
+}
+
+// Fill a record with its sequence number, the time and its pattern.
+static void recordFill(char *pRecord, uint32_t sequence, int64_t timeNowNs)
+{
+    memcpy(pRecord, &sequence, sizeof(sequence));
+    memcpy(pRecord + sizeof(sequence), &timeNowNs, sizeof(timeNowNs));
+    for (size_t x = sizeof(sequence) + sizeof(timeNowNs); x < U_CMUX_BENCH_RECORD_LENGTH_BYTES; x++) {
+        pRecord[x] = (char) ((sequence * 7) + x);
+    }
+}
+
+// Add received data to a stream, checking each record as it
+// completes and noting its latency.
+static void streamReceive(uCmuxBenchStream_t *pStream, const char *pData, size_t length)
+{
+    int64_t nowNs = timeNs(CLOCK_MONOTONIC);
+    char expected[U_CMUX_BENCH_RECORD_LENGTH_BYTES];
+    uint32_t sequence;
+    int64_t sentNs;
+    size_t x;
+
+    pStream->numBytes += length;
+    while (length > 0) {
+        x = sizeof(pStream->record) - pStream->recordIndex;
+        if (x > length) {
+            x = length;
+        }
+        memcpy(pStream->record + pStream->recordIndex, pData, x);
+        pStream->recordIndex += x;
+        pData += x;
+        length -= x;
+        if (pStream->recordIndex == sizeof(pStream->record)) {
+            memcpy(&sequence, pStream->record, sizeof(sequence));
+            memcpy(&sentNs, pStream->record + sizeof(sequence), sizeof(sentNs));
+            recordFill(expected, sequence, sentNs);
+            if ((sequence == pStream->nextSequence) &&
+                (memcmp(expected, pStream->record, sizeof(expected)) == 0) &&
+                (pStream->numLatencies < pStream->maxLatencies)) {
+                pStream->pLatencyUs[pStream->numLatencies] = (nowNs - sentNs) / 1000;
+                pStream->numLatencies++;
+            } else {
+                pStream->numBad++;
+            }
+            pStream->nextSequence = sequence + 1;
+            pStream->recordIndex = 0;
+            pStream->endNs = nowNs;
+        }
+    }
+}
+
+/* ----------------------------------------------------------------
+ * STATIC FUNCTIONS: THE PEER
+ * -------------------------------------------------------------- */
+
+// Write to the pseudo-terminal as the peer, taking as long as the
+// emulated line would; only the transmit task of the peer does this.
+static void peerWrite(uCmuxBenchPeer_t *pPeer, const char *pData, size_t length)
+{
+    int64_t nowNs;
+    ssize_t x;
+
+    if (pPeer->byteNs > 0) {
+        // Wait for the line to become free
+        sleepUntilNs(pPeer->txLineNs);
+        nowNs = timeNs(CLOCK_MONOTONIC);
+        if (pPeer->txLineNs < nowNs) {
+            pPeer->txLineNs = nowNs;
+        }
+        pPeer->txLineNs += pPeer->byteNs * length;
+    }
+    while (length > 0) {
+        x = write(pPeer->fd, pData, length);
+        if (x > 0) {
+            pData += x;
+            length -= x;
+        } else {
+            pPeer->numUnexpected++;
+            length = 0;
+        }
+    }
+}
+
+// Leave a reply for the transmit task of the peer to send.  A real
+// module carries on receiving while it is transmitting, so the
+// receive task must not block on the line: if it did, the MCU could
+// end up stuck writing to the module while the module is stuck
+// writing to the MCU.
+static void peerReply(uCmuxBenchPeer_t *pPeer, const char *pData, size_t length)
+{
+    bool done = false;
+
+    while (!done && !pPeer->stop) {
+        U_PORT_MUTEX_LOCK(pPeer->mutexReply);
+        if (length <= sizeof(pPeer->reply) - pPeer->replyLength) {
+            memcpy(pPeer->reply + pPeer->replyLength, pData, length);
+            pPeer->replyLength += length;
+            done = true;
+        }
+        U_PORT_MUTEX_UNLOCK(pPeer->mutexReply);
+        if (!done) {
+            uPortTaskBlock(1);
+        }
+    }
+}
+
+// Encode a frame and leave it as a reply.  Note that the C/R
+// bit is set as the MCU would set it, which the CMUX decoder of
+// ubxlib does not check.
+static void peerReplyFrame(uCmuxBenchPeer_t *pPeer, uint8_t address,
+                           uCellMuxPrivateFrameType_t type,
+                           const char *pInformation, size_t length)
+{
+    char buffer[U_CELL_MUX_PRIVATE_TX_FRAME_LENGTH_MAX_BYTES];
+    int32_t x;
+
+    x = uCellMuxPrivateEncode(address, type, type != U_CELL_MUX_PRIVATE_FRAME_TYPE_UIH,
+                              pInformation, length, buffer);
+    if (x > 0) {
+        peerReply(pPeer, buffer, x);
+    } else {
+        pPeer->numUnexpected++;
+    }
+}
+
+// Find a data channel by address.
+static uCmuxBenchChannel_t *pPeerGetChannel(uCmuxBenchPeer_t *pPeer, uint8_t address)
+{
+    uCmuxBenchChannel_t *pChannel = NULL;
+
+    for (size_t x = 0; (x < pPeer->numChannels) && (pChannel == NULL); x++) {
+        if (pPeer->pChannel[x].channel == address) {
+            pChannel = &(pPeer->pChannel[x]);
+        }
+    }
+
+    return pChannel;
+}
+
+// Handle AT command characters arriving at the peer, outside
+// CMUX mode or on the AT channel: everything gets "OK".
+static void peerAt(uCmuxBenchPeer_t *pPeer, const char *pData, size_t length, bool cmux)
+{
+    const char *pOk = "\r\nOK\r\n";
+
+    for (size_t x = 0; x < length; x++) {
+        if (pData[x] == '\r') {
+            pPeer->atLine[pPeer->atLineLength] = 0;
+            if (cmux) {
+                peerReplyFrame(pPeer, U_CELL_MUX_PRIVATE_CHANNEL_ID_AT,
+                               U_CELL_MUX_PRIVATE_FRAME_TYPE_UIH, pOk, strlen(pOk));
+            } else {
+                peerReply(pPeer, pOk, strlen(pOk));
+                if (strncmp(pPeer->atLine, "AT+CMUX=", 8) == 0) {
+                    pPeer->cmuxMode = true;
+                }
+            }
+            pPeer->atLineLength = 0;
+        } else if ((pData[x] != '\n') && (pPeer->atLineLength < sizeof(pPeer->atLine) - 1)) {
+            pPeer->atLine[pPeer->atLineLength] = pData[x];
+            pPeer->atLineLength++;
+        }
+    }
+}
+
+// Handle the information field of a frame arriving on the control
+// channel at the peer: an MSC command is obeyed and answered, a
+// close-down command is answered and ends CMUX mode.
+static void peerControl(uCmuxBenchPeer_t *pPeer, char *pInformation, size_t length)
+{
+    uCmuxBenchChannel_t *pChannel;
+
+    if ((length >= 4) && (pInformation[0] == (char) 0xe3)) {
+        pChannel = pPeerGetChannel(pPeer, ((uint8_t) pInformation[2]) >> 2);
+        if (pChannel != NULL) {
+            pChannel->downlinkStopped = ((pInformation[3] & 0x02) == 0x02);
+        }
+        // Respond with the same with the C/R bit cleared
+        pInformation[0] = (char) 0xe1;
+        peerReplyFrame(pPeer, U_CELL_MUX_PRIVATE_CHANNEL_ID_CONTROL,
+                       U_CELL_MUX_PRIVATE_FRAME_TYPE_UIH, pInformation, length);
+    } else if ((length == 2) && (pInformation[0] == (char) 0xc3) &&
+               (pInformation[1] == 0x01)) {
+        pInformation[0] = (char) 0xc1;
+        peerReplyFrame(pPeer, U_CELL_MUX_PRIVATE_CHANNEL_ID_CONTROL,
+                       U_CELL_MUX_PRIVATE_FRAME_TYPE_UIH, pInformation, length);
+        pPeer->cmuxMode = false;
+    } else if ((length < 1) || (pInformation[0] != (char) 0xe1)) {
+        pPeer->numUnexpected++;
+    }
+}
+
+// Handle a frame arriving at the peer.
+static void peerFrame(uCmuxBenchPeer_t *pPeer, uCellMuxPrivateParserContext_t *pParser,
+                      size_t frameLength)
+{
+    uCmuxBenchChannel_t *pChannel;
+    size_t length = pParser->informationLengthBytes;
+
+    switch (pParser->type) {
+        case U_CELL_MUX_PRIVATE_FRAME_TYPE_SABM_COMMAND:
+        case U_CELL_MUX_PRIVATE_FRAME_TYPE_DISC_COMMAND:
+            peerReplyFrame(pPeer, pParser->address,
+                           U_CELL_MUX_PRIVATE_FRAME_TYPE_UA_RESPONSE, NULL, 0);
+            break;
+        case U_CELL_MUX_PRIVATE_FRAME_TYPE_UIH:
+            if (pParser->address == U_CELL_MUX_PRIVATE_CHANNEL_ID_CONTROL) {
+                peerControl(pPeer, pParser->pInformation, length);
+            } else if (pParser->address == U_CELL_MUX_PRIVATE_CHANNEL_ID_AT) {
+                peerAt(pPeer, pParser->pInformation, length, true);
+            } else {
+                pChannel = pPeerGetChannel(pPeer, pParser->address);
+                if (pChannel != NULL) {
+                    pChannel->uplink.numFrames++;
+                    pChannel->uplink.numWireBytes += frameLength;
+                    streamReceive(&(pChannel->uplink), pParser->pInformation, length);
+                } else {
+                    pPeer->numUnexpected++;
+                }
+            }
+            break;
+        default:
+            pPeer->numUnexpected++;
+            break;
+    }
+}
+
+// The receive task of the peer: read the pseudo-terminal at the
+// emulated baud rate and act on what arrives.
+static void peerRxTask(void *pParam)
+{
+    uCmuxBenchPeer_t *pPeer = (uCmuxBenchPeer_t *) pParam;
+    char buffer[U_CMUX_BENCH_PEER_BUFFER_LENGTH_BYTES];
+    char information[U_CELL_MUX_PRIVATE_INFORMATION_LENGTH_MAX_BYTES];
+    uCellMuxPrivateParserContext_t parser;
+    struct pollfd pollFd = {.fd = pPeer->fd, .events = POLLIN};
+    size_t bufferLength = 0;
+    size_t frameStart;
+    int64_t nowNs;
+    ssize_t x;
+    int32_t errorCode;
+
+    while (!pPeer->stop) {
+        x = 0;
+        if (poll(&pollFd, 1, 10) > 0) {
+            x = U_CMUX_BENCH_PEER_READ_LENGTH_BYTES;
+            if (x > (ssize_t) (sizeof(buffer) - bufferLength)) {
+                x = sizeof(buffer) - bufferLength;
+            }
+            x = read(pPeer->fd, buffer + bufferLength, x);
+        }
+        if (x > 0) {
+            if (pPeer->byteNs > 0) {
+                // Take as long as the line would have
+                nowNs = timeNs(CLOCK_MONOTONIC);
+                if (pPeer->rxLineNs < nowNs) {
+                    pPeer->rxLineNs = nowNs;
+                }
+                pPeer->rxLineNs += pPeer->byteNs * x;
+                sleepUntilNs(pPeer->rxLineNs);
+            }
+            if (!pPeer->cmuxMode) {
+                peerAt(pPeer, buffer + bufferLength, x, false);
+            } else {
+                bufferLength += x;
+                memset(&parser, 0, sizeof(parser));
+                parser.pBuffer = buffer;
+                parser.bufferSize = bufferLength;
+                do {
+                    frameStart = parser.bufferIndex;
+                    parser.address = U_CELL_MUX_PRIVATE_ADDRESS_ANY;
+                    parser.type = U_CELL_MUX_PRIVATE_FRAME_TYPE_NONE;
+                    parser.pInformation = information;
+                    parser.informationLengthBytes = sizeof(information);
+                    errorCode = uCellMuxPrivateParseCmux(&parser);
+                    if (errorCode == 0) {
+                        peerFrame(pPeer, &parser, parser.bufferIndex - frameStart);
+                    }
+                } while ((errorCode != (int32_t) U_ERROR_COMMON_TIMEOUT) &&
+                         (parser.bufferIndex < bufferLength) && pPeer->cmuxMode);
+                if (!pPeer->cmuxMode) {
+                    // Close-down: anything further is AT commands
+                    parser.bufferIndex = bufferLength;
+                }
+                // Keep any partial frame for next time
+                bufferLength -= parser.bufferIndex;
+                memmove(buffer, buffer + parser.bufferIndex, bufferLength);
+            }
+        }
+    }
+
+    pPeer->rxRunning = false;
+    uPortTaskDelete(NULL);
+}
+
+// Send any replies the receive task of the peer has left,
+// returning true if there were some.
+static bool peerSendReplies(uCmuxBenchPeer_t *pPeer)
+{
+    char buffer[U_CMUX_BENCH_PEER_REPLY_LENGTH_BYTES];
+    size_t length;
+
+    U_PORT_MUTEX_LOCK(pPeer->mutexReply);
+    length = pPeer->replyLength;
+    memcpy(buffer, pPeer->reply, length);
+    pPeer->replyLength = 0;
+    U_PORT_MUTEX_UNLOCK(pPeer->mutexReply);
+
+    if (length > 0) {
+        peerWrite(pPeer, buffer, length);
+    }
+
+    return (length > 0);
+}
+
+// The transmit task of the peer: send the replies of the receive
+// task and, once told to go, the bulk data of each data channel,
+// a full frame from each in turn, obeying flow control from the MCU.
+static void peerTxTask(void *pParam)
+{
+    uCmuxBenchPeer_t *pPeer = (uCmuxBenchPeer_t *) pParam;
+    char information[U_CELL_MUX_PRIVATE_INFORMATION_LENGTH_MAX_BYTES];
+    char buffer[U_CELL_MUX_PRIVATE_TX_FRAME_LENGTH_MAX_BYTES];
+    uCmuxBenchChannel_t *pChannel;
+    size_t length;
+    size_t x;
+    int32_t frameLength;
+    bool sent;
+
+    while (!pPeer->stop) {
+        sent = peerSendReplies(pPeer);
+        for (size_t y = 0; (y < pPeer->numChannels) && pPeer->downlinkGo; y++) {
+            // Replies go ahead of bulk data
+            sent = peerSendReplies(pPeer) || sent;
+            pChannel = &(pPeer->pChannel[y]);
+            length = 0;
+            while (!pChannel->downlinkStopped && (length < sizeof(information)) &&
+                   (pChannel->downlinkBytesSent < pChannel->numBytes)) {
+                if (pChannel->downlinkRecordIndex == 0) {
+                    // Stamp a new record with the time it starts going out
+                    recordFill(pChannel->downlinkRecord, pChannel->downlinkSequence,
+                               timeNs(CLOCK_MONOTONIC));
+                }
+                x = sizeof(pChannel->downlinkRecord) - pChannel->downlinkRecordIndex;
+                if (x > sizeof(information) - length) {
+                    x = sizeof(information) - length;
+                }
+                memcpy(information + length,
+                       pChannel->downlinkRecord + pChannel->downlinkRecordIndex, x);
+                length += x;
+                pChannel->downlinkBytesSent += x;
+                pChannel->downlinkRecordIndex += x;
+                if (pChannel->downlinkRecordIndex == sizeof(pChannel->downlinkRecord)) {
+                    pChannel->downlinkRecordIndex = 0;
+                    pChannel->downlinkSequence++;
+                }
+            }
+            if (length > 0) {
+                frameLength = uCellMuxPrivateEncode(pChannel->channel,
+                                                    U_CELL_MUX_PRIVATE_FRAME_TYPE_UIH,
+                                                    false, information, length, buffer);
+                if (frameLength > 0) {
+                    pChannel->downlink.numFrames++;
+                    pChannel->downlink.numWireBytes += frameLength;
+                    peerWrite(pPeer, buffer, frameLength);
+                    sent = true;
+                }
+            }
+        }
+        if (!sent) {
+            uPortTaskBlock(1);
+        }
+    }
+
+    pPeer->txRunning = false;
+    uPortTaskDelete(NULL);
+}
+
+/* ----------------------------------------------------------------
+ * STATIC FUNCTIONS: THE MCU SIDE
+ * -------------------------------------------------------------- */
+
+// Callback for data arriving on a data channel at the MCU.
+static void downlinkCallback(uDeviceSerial_t *pDeviceSerial,
+                             uint32_t eventBitmask, void *pParam)
+{
+    uCmuxBenchChannel_t *pChannel = (uCmuxBenchChannel_t *) pParam;
+    char buffer[U_CMUX_BENCH_WRITE_LENGTH_BYTES];
+    int32_t x;
+
+    if ((eventBitmask & U_DEVICE_SERIAL_EVENT_BITMASK_DATA_RECEIVED) != 0) {
+        do {
+            x = pDeviceSerial->read(pDeviceSerial, buffer, sizeof(buffer));
+            if (x > 0) {
+                streamReceive(&(pChannel->downlink), buffer, x);
+            }
+        } while (x > 0);
+    }
+}
+
+// Task that writes the bulk data of a data channel at the MCU.
+static void uplinkTask(void *pParam)
+{
+    uCmuxBenchChannel_t *pChannel = (uCmuxBenchChannel_t *) pParam;
+    uDeviceSerial_t *pDeviceSerial = pChannel->pDeviceSerial;
+    char buffer[U_CMUX_BENCH_WRITE_LENGTH_BYTES];
+    uint32_t sequence = 0;
+    size_t length;
+    int64_t nowNs;
+    int32_t x;
+
+    for (size_t sent = 0; (sent < pChannel->numBytes) &&
+         (pChannel->writerErrorCode == 0); sent += length) {
+        length = pChannel->numBytes - sent;
+        if (length > sizeof(buffer)) {
+            length = sizeof(buffer);
+        }
+        nowNs = timeNs(CLOCK_MONOTONIC);
+        for (size_t y = 0; y < length; y += U_CMUX_BENCH_RECORD_LENGTH_BYTES) {
+            recordFill(buffer + y, sequence, nowNs);
+            sequence++;
+        }
+        x = pDeviceSerial->write(pDeviceSerial, buffer, length);
+        if (x != (int32_t) length) {
+            pChannel->writerErrorCode = (x < 0) ? x : (int32_t) U_ERROR_COMMON_TIMEOUT;
+        }
+    }
+
+    pChannel->writerRunning = false;
+    uPortTaskDelete(NULL);
+}
+
+// Print the results for one direction of one channel, returning
+// the number of problems.
+static int printStream(uCmuxBenchStream_t *pStream, const char *pName,
+                       uint8_t channel, size_t numBytes, int64_t startNs)
+{
+    int numProblems = 0;
+    int64_t durationNs = pStream->endNs - startNs;
+    int32_t n = pStream->numLatencies;
+
+    qsort(pStream->pLatencyUs, n, sizeof(int64_t), compareInt64);
+    if ((n > 0) && (durationNs > 0) && (pStream->numFrames > 0)) {
+        printf("channel %d %s: %d byte(s) in %lld ms, %lld byte(s)/s, %d frame(s)"
+               " of %d byte(s) on average, overhead %d.%d%%, latency p50 %lld us,"
+               " p90 %lld us, p99 %lld us, max %lld us.\n",
+               channel, pName, (int) pStream->numBytes, (long long) (durationNs / 1000000),
+               (long long) ((((int64_t) pStream->numBytes) * 1000000000LL) / durationNs),
+               (int) pStream->numFrames, (int) (pStream->numBytes / pStream->numFrames),
+               (int) (((pStream->numWireBytes - pStream->numBytes) * 100) / pStream->numBytes),
+               (int) ((((pStream->numWireBytes - pStream->numBytes) * 1000) / pStream->numBytes) % 10),
+               (long long) pStream->pLatencyUs[(n * 50) / 100],
+               (long long) pStream->pLatencyUs[(n * 90) / 100],
+               (long long) pStream->pLatencyUs[(n * 99) / 100],
+               (long long) pStream->pLatencyUs[n - 1]);
+    }
+    if ((pStream->numBytes != numBytes) || (pStream->numBad > 0) ||
+        (n != (int32_t) (numBytes / U_CMUX_BENCH_RECORD_LENGTH_BYTES))) {
+        printf("*** channel %d %s: %d byte(s) of %d received, %d bad record(s).\n",
+               channel, pName, (int) pStream->numBytes, (int) numBytes,
+               (int) pStream->numBad);
+        numProblems++;
+    }
+
+    return numProblems;
+}
+
+// Time the encoder, the decoder and the FCS calculation over a
+// full-length UIH frame.
+static void printFcsCost()
+{
+    char information[U_CELL_MUX_PRIVATE_INFORMATION_LENGTH_MAX_BYTES];
+    char buffer[U_CELL_MUX_PRIVATE_TX_FRAME_LENGTH_MAX_BYTES];
+    uCellMuxPrivateParserContext_t parser;
+    volatile uint8_t fcs = 0;
+    int32_t frameLength;
+    size_t headerLength;
+    int64_t encodeNs;
+    int64_t parseNs;
+    int64_t fcsNs;
+    int64_t startNs;
+
+    for (size_t x = 0; x < sizeof(information); x++) {
+        information[x] = (char) x;
+    }
+    frameLength = uCellMuxPrivateEncode(U_CMUX_BENCH_FIRST_DATA_CHANNEL,
+                                        U_CELL_MUX_PRIVATE_FRAME_TYPE_UIH, false,
+                                        information, sizeof(information), buffer);
+    // The FCS of a UIH frame covers the address, control and
+    // length fields only: everything bar the opening flag, the
+    // information field, the FCS and the closing flag
+    headerLength = frameLength - sizeof(information) - 3;
+
+    startNs = timeNs(CLOCK_PROCESS_CPUTIME_ID);
+    for (int32_t x = 0; x < U_CMUX_BENCH_FCS_ITERATIONS; x++) {
+        information[0] = (char) x;
+        uCellMuxPrivateEncode(U_CMUX_BENCH_FIRST_DATA_CHANNEL,
+                              U_CELL_MUX_PRIVATE_FRAME_TYPE_UIH, false,
+                              information, sizeof(information), buffer);
+    }
+    encodeNs = timeNs(CLOCK_PROCESS_CPUTIME_ID) - startNs;
+
+    startNs = timeNs(CLOCK_PROCESS_CPUTIME_ID);
+    for (int32_t x = 0; x < U_CMUX_BENCH_FCS_ITERATIONS; x++) {
+        memset(&parser, 0, sizeof(parser));
+        parser.address = U_CELL_MUX_PRIVATE_ADDRESS_ANY;
+        parser.pInformation = information;
+        parser.informationLengthBytes = sizeof(information);
+        parser.pBuffer = buffer;
+        parser.bufferSize = frameLength;
+        uCellMuxPrivateParseCmux(&parser);
+    }
+    parseNs = timeNs(CLOCK_PROCESS_CPUTIME_ID) - startNs;
+
+    startNs = timeNs(CLOCK_PROCESS_CPUTIME_ID);
+    for (int32_t x = 0; x < U_CMUX_BENCH_FCS_ITERATIONS; x++) {
+        buffer[1 + headerLength] = (char) fcs;
+        // Over the header plus the FCS, as a receiver checks it
+        fcs = uCrc8Reflected(buffer + 1, headerLength + 1, 0xFF);
+    }
+    fcsNs = timeNs(CLOCK_PROCESS_CPUTIME_ID) - startNs;
+
+    printf("%d-byte UIH frame: encode %d ns, decode %d ns, FCS %d ns (%d%% of encode + decode).\n",
+           (int) frameLength, (int) (encodeNs / U_CMUX_BENCH_FCS_ITERATIONS),
+           (int) (parseNs / U_CMUX_BENCH_FCS_ITERATIONS),
+           (int) (fcsNs / U_CMUX_BENCH_FCS_ITERATIONS),
+           (int) ((fcsNs * 2 * 100) / (encodeNs + parseNs)));
+}
+
+// Bring up CMUX with the simulated peer on the far side of a
+// pseudo-terminal, run bulk data both ways on the given number
+// of data channels and print the results, returning the number
+// of problems.
+static int run(size_t numChannels, size_t numBytes, int32_t baudRate)
+{
+    int numProblems = 1;
+    uCmuxBenchPeer_t peer = {0};
+    uCmuxBenchChannel_t channel[U_CMUX_BENCH_MAX_DATA_CHANNELS] = {0};
+    uCmuxBenchChannel_t *pChannel;
+    int32_t uartHandle = -1;
+    uAtClientStreamHandle_t stream = U_AT_CLIENT_STREAM_HANDLE_DEFAULTS;
+    uAtClientHandle_t atHandle = NULL;
+    uDeviceHandle_t cellHandle = NULL;
+    uPortTaskHandle_t taskHandle;
+    uCellMuxTxStatistics_t statistics;
+    size_t numRecords = numBytes / U_CMUX_BENCH_RECORD_LENGTH_BYTES;
+    size_t totalBytes;
+    size_t lastTotalBytes = 0;
+    int64_t startNs;
+    int64_t progressNs;
+    int64_t cpuNs;
+    bool done = false;
+
+    peer.fd = -1;
+    peer.pChannel = channel;
+    peer.numChannels = numChannels;
+    if (baudRate > 0) {
+        peer.byteNs = 10000000000LL / baudRate;
+    }
+    for (size_t x = 0; x < numChannels; x++) {
+        channel[x].channel = (uint8_t) (U_CMUX_BENCH_FIRST_DATA_CHANNEL + x);
+        channel[x].numBytes = numBytes;
+        channel[x].uplink.maxLatencies = (int32_t) numRecords;
+        channel[x].uplink.pLatencyUs = (int64_t *) calloc(numRecords, sizeof(int64_t));
+        channel[x].downlink.maxLatencies = (int32_t) numRecords;
+        channel[x].downlink.pLatencyUs = (int64_t *) calloc(numRecords, sizeof(int64_t));
+        if ((channel[x].uplink.pLatencyUs == NULL) || (channel[x].downlink.pLatencyUs == NULL)) {
+            numChannels = 0;
+        }
+    }
+    if ((numChannels > 0) && (uPortMutexCreate(&peer.mutexReply) == 0)) {
+        peer.fd = posix_openpt(O_RDWR | O_NOCTTY);
+    }
+    if ((peer.fd >= 0) && (grantpt(peer.fd) == 0) && (unlockpt(peer.fd) == 0) &&
+        (uPortUartPrefix(ptsname(peer.fd)) == 0)) {
+        // The name of the slave is the whole of the prefix
+        uartHandle = uPortUartOpen(-1, 115200, NULL, U_CELL_UART_BUFFER_LENGTH_BYTES,
+                                   -1, -1, -1, -1);
+    }
+    if (uartHandle >= 0) {
+        stream.handle.int32 = uartHandle;
+        stream.type = U_AT_CLIENT_STREAM_TYPE_UART;
+        atHandle = uAtClientAddExt(&stream, NULL, U_CELL_AT_BUFFER_LENGTH_BYTES);
+    }
+    if (atHandle != NULL) {
+        peer.rxRunning = true;
+        if (uPortTaskCreate(peerRxTask, "peerRx", U_CFG_OS_APP_TASK_STACK_SIZE_BYTES,
+                            &peer, U_CFG_OS_APP_TASK_PRIORITY, &taskHandle) != 0) {
+            peer.rxRunning = false;
+        }
+        peer.txRunning = true;
+        if (uPortTaskCreate(peerTxTask, "peerTx", U_CFG_OS_APP_TASK_STACK_SIZE_BYTES,
+                            &peer, U_CFG_OS_APP_TASK_PRIORITY, &taskHandle) != 0) {
+            peer.txRunning = false;
+        }
+        if (peer.rxRunning && peer.txRunning &&
+            (uCellAdd(U_CMUX_BENCH_MODULE_TYPE, atHandle, -1, -1, -1, false, &cellHandle) == 0) &&
+            (uCellMuxEnable(cellHandle) == 0)) {
+            numProblems = 0;
+            for (size_t x = 0; x < numChannels; x++) {
+                pChannel = &(channel[x]);
+                if ((uCellMuxAddChannel(cellHandle, pChannel->channel,
+                                        &(pChannel->pDeviceSerial)) != 0) ||
+                    (pChannel->pDeviceSerial->eventCallbackSet(pChannel->pDeviceSerial,
+                                                               U_DEVICE_SERIAL_EVENT_BITMASK_DATA_RECEIVED,
+                                                               downlinkCallback, pChannel,
+                                                               U_CFG_OS_APP_TASK_STACK_SIZE_BYTES,
+                                                               U_CFG_OS_APP_TASK_PRIORITY) != 0)) {
+                    printf("unable to add CMUX channel %d.\n", pChannel->channel);
+                    numProblems++;
+                }
+            }
+            if (numProblems == 0) {
+                cpuNs = timeNs(CLOCK_PROCESS_CPUTIME_ID);
+                startNs = timeNs(CLOCK_MONOTONIC);
+                progressNs = startNs;
+                peer.downlinkGo = true;
+                for (size_t x = 0; x < numChannels; x++) {
+                    channel[x].writerRunning = true;
+                    if (uPortTaskCreate(uplinkTask, "uplink", U_CFG_OS_APP_TASK_STACK_SIZE_BYTES,
+                                        &(channel[x]), U_CFG_OS_APP_TASK_PRIORITY,
+                                        &taskHandle) != 0) {
+                        channel[x].writerRunning = false;
+                        numProblems++;
+                    }
+                }
+                // Wait until everything has arrived or nothing is moving
+                while (!done && (timeNs(CLOCK_MONOTONIC) - progressNs < U_CMUX_BENCH_STALL_MS * 1000000LL)) {
+                    uPortTaskBlock(10);
+                    done = true;
+                    totalBytes = 0;
+                    for (size_t x = 0; x < numChannels; x++) {
+                        totalBytes += channel[x].uplink.numBytes + channel[x].downlink.numBytes;
+                        if (channel[x].writerRunning || (channel[x].uplink.numBytes < numBytes) ||
+                            (channel[x].downlink.numBytes < numBytes)) {
+                            done = false;
+                        }
+                    }
+                    if (totalBytes != lastTotalBytes) {
+                        lastTotalBytes = totalBytes;
+                        progressNs = timeNs(CLOCK_MONOTONIC);
+                    }
+                }
+                cpuNs = timeNs(CLOCK_PROCESS_CPUTIME_ID) - cpuNs;
+                peer.downlinkGo = false;
+                printf("%d data channel(s), %d byte(s) each way on each, %d bits/s%s.\n",
+                       (int) numChannels, (int) numBytes, (int) baudRate,
+                       (baudRate > 0) ? "" : " (no limit)");
+                for (size_t x = 0; x < numChannels; x++) {
+                    pChannel = &(channel[x]);
+                    numProblems += printStream(&(pChannel->uplink), "MCU->module",
+                                               pChannel->channel, numBytes, startNs);
+                    numProblems += printStream(&(pChannel->downlink), "module->MCU",
+                                               pChannel->channel, numBytes, startNs);
+                    if (uCellMuxGetTxStatistics(cellHandle, pChannel->channel, &statistics) == 0) {
+                        printf("channel %d transmit queue: %d frame(s), max %d frame(s) queued,"
+                               " average %d ms queued, max %d ms.\n", pChannel->channel,
+                               (int) statistics.numFrames, (int) statistics.queueLengthMaxFrames,
+                               (int) statistics.latencyAverageMs, (int) statistics.latencyMaxMs);
+                    }
+                    if (pChannel->writerErrorCode != 0) {
+                        printf("*** channel %d write failed (%d).\n", pChannel->channel,
+                               (int) pChannel->writerErrorCode);
+                        numProblems++;
+                    }
+                }
+                if (lastTotalBytes > 0) {
+                    printf("%lld us of CPU per kbyte.\n",
+                           (long long) ((cpuNs / 1000) * 1024 / (int64_t) lastTotalBytes));
+                }
+            }
+            for (size_t x = 0; x < numChannels; x++) {
+                // Let any writer that is stuck give up
+                while (channel[x].writerRunning) {
+                    uPortTaskBlock(10);
+                }
+                if (channel[x].pDeviceSerial != NULL) {
+                    channel[x].pDeviceSerial->eventCallbackRemove(channel[x].pDeviceSerial);
+                }
+            }
+            if (uCellMuxDisable(cellHandle) != 0) {
+                numProblems++;
+            }
+        } else {
+            printf("unable to start CMUX.\n");
+        }
+        if (peer.numUnexpected > 0) {
+            printf("*** %d unexpected thing(s) arrived at the peer.\n", (int) peer.numUnexpected);
+            numProblems++;
+        }
+        if (cellHandle != NULL) {
+            uCellRemove(cellHandle);
+        }
+        peer.stop = true;
+        while (peer.rxRunning || peer.txRunning) {
+            uPortTaskBlock(10);
+        }
+        uAtClientRemove(atHandle);
+    } else {
+        printf("unable to open a pseudo-terminal.\n");
+    }
+    if (uartHandle >= 0) {
+        uPortUartClose(uartHandle);
+    }
+    if (peer.fd >= 0) {
+        close(peer.fd);
+    }
+    if (peer.mutexReply != NULL) {
+        uPortMutexDelete(peer.mutexReply);
+    }
+    for (size_t x = 0; x < sizeof(channel) / sizeof(channel[0]); x++) {
+        free(channel[x].uplink.pLatencyUs);
+        free(channel[x].downlink.pLatencyUs);
+    }
+
+    return numProblems;
+}
+
+// The task within which the benchmark runs.
+static void appTask(void *pParam)
+{
+    uCmuxBenchArgs_t *pArgs = (uCmuxBenchArgs_t *) pParam;
+    int32_t numChannels = U_CMUX_BENCH_MAX_DATA_CHANNELS;
+    int32_t numKbytes = U_CMUX_BENCH_DEFAULT_KBYTES;
+    int32_t baudRate = U_CMUX_BENCH_DEFAULT_BAUD_RATE;
+    int numProblems = 0;
+
+    for (int x = 1; x < pArgs->argc; x++) {
+        if ((strcmp(pArgs->argv[x], "-c") == 0) && (x + 1 < pArgs->argc)) {
+            x++;
+            numChannels = atoi(pArgs->argv[x]);
+        } else if ((strcmp(pArgs->argv[x], "-k") == 0) && (x + 1 < pArgs->argc)) {
+            x++;
+            numKbytes = atoi(pArgs->argv[x]);
+        } else if ((strcmp(pArgs->argv[x], "-b") == 0) && (x + 1 < pArgs->argc)) {
+            x++;
+            baudRate = atoi(pArgs->argv[x]);
+        } else {
+            numProblems++;
+        }
+    }
+    if ((numProblems > 0) || (numChannels <= 0) ||
+        (numChannels > U_CMUX_BENCH_MAX_DATA_CHANNELS) ||
+        (numKbytes <= 0) || (baudRate < 0)) {
+        printf("usage: %s [-c channels] [-k kbytes] [-b baud]\n"
+               "  -c  the number of data channels, 1 to %d, default %d.\n"
+               "  -k  the kbytes to send each way on each channel, default %d.\n"
+               "  -b  the bit rate of the emulated UART, 0 for no limit, default %d.\n",
+               pArgs->argv[0], U_CMUX_BENCH_MAX_DATA_CHANNELS, U_CMUX_BENCH_MAX_DATA_CHANNELS,
+               U_CMUX_BENCH_DEFAULT_KBYTES, U_CMUX_BENCH_DEFAULT_BAUD_RATE);
+        numProblems++;
+    } else {
+        uPortInit();
+        uAtClientInit();
+        uCellInit();
+        printFcsCost();
+        numProblems += run(numChannels, numKbytes * 1024, baudRate);
+        uCellDeinit();
+        uAtClientDeinit();
+        uPortDeinit();
+    }
+
+    pArgs->exitCode = (numProblems > 0) ? 1 : 0;
+}
+
+/* ----------------------------------------------------------------
+ * PUBLIC FUNCTIONS
+ * -------------------------------------------------------------- */
+
+// Entry point
+int main(int argc, char *argv[])
+{
+    uCmuxBenchArgs_t args = {.argc = argc, .argv = argv, .exitCode = 1};
+
+    uPortPlatformStart(appTask, &args,
+                       U_CFG_OS_APP_TASK_STACK_SIZE_BYTES,
+                       U_CFG_OS_APP_TASK_PRIORITY);
+
+    return args.exitCode;
+}
+
+// End of file
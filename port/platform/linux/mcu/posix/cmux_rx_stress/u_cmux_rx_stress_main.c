@@ -0,0 +1,530 @@
+/*
+ * Copyright 2019-2024 u-blox
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** @file
+ * @brief Stress the receive path of the cellular CMUX code on Linux
+ * by feeding pseudo-random frames for several channels straight into
+ * the decoder while one of the readers lags; see README.md.
+ */
+
+#ifdef U_CFG_OVERRIDE
+# include "u_cfg_override.h" // For a customer's configuration override
+#endif
+
+// The decoder and the channel set-up are static, hence the CMUX code
+// is built here rather than as part of ubxlib (see CMakeLists.txt);
+// it brings in everything else the CMUX code needs
+#include "u_cell_mux.c"
+
+#include "stdlib.h"    // malloc(), free(), atoi()
+#include "stdio.h"     // printf()
+
+/* ----------------------------------------------------------------
+ * COMPILE-TIME MACROS
+ * -------------------------------------------------------------- */
+
+/** The default number of kbytes of frames to decode.
+ */
+#define U_CMUX_RX_STRESS_DEFAULT_KBYTES 400
+
+/** The maximum number of data channels: #U_CELL_MUX_MAX_CHANNELS
+ * includes the control channel.
+ */
+#define U_CMUX_RX_STRESS_MAX_DATA_CHANNELS (U_CELL_MUX_MAX_CHANNELS - 1)
+
+/** The slow reader, the last data channel, reads only once in this
+ * many goes, so that it falls behind the decoder.
+ */
+#define U_CMUX_RX_STRESS_SLOW_READER_DIVISOR 50
+
+/** The largest amount a reader asks for in one go.
+ */
+#define U_CMUX_RX_STRESS_READ_LENGTH_MAX_BYTES 600
+
+/** The largest amount added to the ring buffer in one go.
+ */
+#define U_CMUX_RX_STRESS_ADD_LENGTH_MAX_BYTES 200
+
+/** One frame in this many is preceded by a junk byte.
+ */
+#define U_CMUX_RX_STRESS_JUNK_DIVISOR 10
+
+/** Give up if the data has not all arrived in this time.
+ */
+#define U_CMUX_RX_STRESS_TIMEOUT_MS 30000
+
+/** The stack size of the reader task.
+ */
+#define U_CMUX_RX_STRESS_READER_TASK_STACK_SIZE_BYTES (1024 * 16)
+
+/* ----------------------------------------------------------------
+ * TYPES
+ * -------------------------------------------------------------- */
+
+/** The command-line, passed to appTask().
+ */
+typedef struct {
+    int argc;
+    char **argv;
+    int exitCode;
+} uCmuxRxStressArgs_t;
+
+/** A data channel.
+ */
+typedef struct {
+    uint8_t channel;                /**< the CMUX address. */
+    uDeviceSerial_t *pDeviceSerial; /**< the virtual serial port. */
+    char *pExpected;                /**< the data that was encoded for the channel. */
+    size_t expectedLength;          /**< the number of bytes at pExpected. */
+    volatile size_t numBytes;       /**< the number of bytes read so far. */
+    volatile bool bad;              /**< true if something read was wrong. */
+} uCmuxRxStressChannel_t;
+
+/** The test, shared between the decoder and the reader task.
+ */
+typedef struct {
+    uCmuxRxStressChannel_t channel[U_CMUX_RX_STRESS_MAX_DATA_CHANNELS]; /**< the data channels. */
+    size_t numChannels;             /**< the number of entries in channel[] that are used. */
+    uint32_t seed;                  /**< the state of the pseudo-random number generator. */
+    volatile bool stop;             /**< true to stop the reader task. */
+    volatile bool readerRunning;    /**< true while the reader task runs. */
+} uCmuxRxStress_t;
+
+/* ----------------------------------------------------------------
+ * STATIC FUNCTIONS
+ * -------------------------------------------------------------- */
+
+// A pseudo-random number from 0 to 32767, repeatable for a given seed.
+static uint32_t randomNumber(uint32_t *pSeed)
+{
+    *pSeed = (*pSeed * 1103515245UL) + 12345UL;
+    return (*pSeed >> 16) & 0x7fff;
+}
+
+// Read up to length bytes from a channel and check them against
+// what was encoded for it.
+static void channelRead(uCmuxRxStressChannel_t *pChannel, size_t length)
+{
+    char buffer[U_CMUX_RX_STRESS_READ_LENGTH_MAX_BYTES];
+    int32_t sizeOrErrorCode;
+
+    if (length > sizeof(buffer)) {
+        length = sizeof(buffer);
+    }
+    sizeOrErrorCode = pChannel->pDeviceSerial->read(pChannel->pDeviceSerial, buffer, length);
+    if (sizeOrErrorCode > 0) {
+        if ((pChannel->numBytes + sizeOrErrorCode > pChannel->expectedLength) ||
+            (memcmp(buffer, pChannel->pExpected + pChannel->numBytes, sizeOrErrorCode) != 0)) {
+            if (!pChannel->bad) {
+                printf("channel %d: %d byte(s) read at offset %d are wrong.\n",
+                       pChannel->channel, (int) sizeOrErrorCode, (int) pChannel->numBytes);
+            }
+            pChannel->bad = true;
+        }
+        pChannel->numBytes += sizeOrErrorCode;
+    } else if (sizeOrErrorCode < 0) {
+        if (!pChannel->bad) {
+            printf("channel %d: read returned %d.\n", pChannel->channel,
+                   (int) sizeOrErrorCode);
+        }
+        pChannel->bad = true;
+    }
+}
+
+// Have a go at reading from each channel, the last one only
+// occasionally.
+static void readersRun(uCmuxRxStress_t *pStress, uint32_t iteration, uint32_t *pSeed)
+{
+    for (size_t x = 0; x < pStress->numChannels; x++) {
+        if ((x < pStress->numChannels - 1) ||
+            ((iteration % U_CMUX_RX_STRESS_SLOW_READER_DIVISOR) == 0)) {
+            channelRead(&(pStress->channel[x]),
+                        1 + (randomNumber(pSeed) % U_CMUX_RX_STRESS_READ_LENGTH_MAX_BYTES));
+        }
+    }
+}
+
+// The reader task, used when reading is not done in-line with
+// decoding, so that the reader/decoder locking is exercised.
+static void readerTask(void *pParam)
+{
+    uCmuxRxStress_t *pStress = (uCmuxRxStress_t *) pParam;
+    uint32_t seed = pStress->seed;
+    uint32_t iteration = 0;
+
+    while (!pStress->stop) {
+        readersRun(pStress, iteration, &seed);
+        iteration++;
+    }
+
+    pStress->readerRunning = false;
+    uPortTaskDelete(NULL);
+}
+
+// Check what the decoder promises about the span readers once it
+// has returned: that their spans add up, fit in the receive buffer
+// of the channel and are not too far behind the decoder; returns
+// true if all is well.
+static bool readersCheck(uCellMuxPrivateContext_t *pContext)
+{
+    bool good = true;
+    uCellMuxPrivateChannelContext_t *pChannelContext;
+    uCellMuxPrivateRxReader_t *pRxReader;
+    size_t spanBytes;
+
+    for (size_t x = 0; x < sizeof(pContext->pDeviceSerial) / sizeof(pContext->pDeviceSerial[0]);
+         x++) {
+        pChannelContext = (uCellMuxPrivateChannelContext_t *) pUInterfaceContext(
+                              pContext->pDeviceSerial[x]);
+        if ((pChannelContext != NULL) &&
+            (pChannelContext->channel != U_CELL_MUX_PRIVATE_CHANNEL_ID_CONTROL)) {
+
+            U_PORT_MUTEX_LOCK(pChannelContext->mutexRx);
+
+            pRxReader = pChannelContext->traffic.pRxReader;
+            spanBytes = 0;
+            for (size_t y = 0; y < pRxReader->numSpans; y++) {
+                spanBytes += pRxReader->span[(pRxReader->spanIndex + y) %
+                                             U_CELL_MUX_PRIVATE_RX_SPANS_MAX].length;
+            }
+            if ((pRxReader->numSpans > U_CELL_MUX_PRIVATE_RX_SPANS_MAX) ||
+                (spanBytes != pRxReader->spanBytes) ||
+                (rxBufferDataSize(&(pChannelContext->traffic)) + spanBytes >=
+                 pChannelContext->traffic.rxBufferSizeBytes) ||
+                ((pRxReader->numSpans > 0) &&
+                 (pContext->readPosition - pRxReader->position >
+                  U_CELL_MUX_PRIVATE_RX_SPAN_LAG_MAX_BYTES))) {
+                printf("channel %d: %d span(s) of %d byte(s) (%d counted), %d byte(s)"
+                       " in the receive buffer, %d byte(s) behind the decoder.\n",
+                       pChannelContext->channel, (int) pRxReader->numSpans,
+                       (int) spanBytes, (int) pRxReader->spanBytes,
+                       (int) rxBufferDataSize(&(pChannelContext->traffic)),
+                       (int) (pContext->readPosition - pRxReader->position));
+                good = false;
+            }
+
+            U_PORT_MUTEX_UNLOCK(pChannelContext->mutexRx);
+        }
+    }
+
+    return good;
+}
+
+// Free a CMUX context set up by pContextCreate(), with the serial
+// devices of its channels.
+static void contextDelete(uCellMuxPrivateContext_t *pContext)
+{
+    uCellMuxPrivateChannelContext_t *pChannelContext;
+
+    for (size_t x = 0; x < sizeof(pContext->pDeviceSerial) / sizeof(pContext->pDeviceSerial[0]);
+         x++) {
+        if (pContext->pDeviceSerial[x] != NULL) {
+            pChannelContext = (uCellMuxPrivateChannelContext_t *) pUInterfaceContext(
+                                  pContext->pDeviceSerial[x]);
+            free(pChannelContext->traffic.pRxBufferStart);
+            uPortMutexDelete(pChannelContext->mutex);
+            uPortMutexDelete(pChannelContext->mutexUserDataWrite);
+            uPortMutexDelete(pChannelContext->mutexUserDataRead);
+            uPortMutexDelete(pChannelContext->mutexRx);
+            uDeviceSerialDelete(pContext->pDeviceSerial[x]);
+        }
+    }
+    uRingBufferDelete(&(pContext->ringBuffer));
+    if (pContext->mutexTxScheduler != NULL) {
+        uPortMutexDelete(pContext->mutexTxScheduler);
+    }
+    if (pContext->mutexTx != NULL) {
+        uPortMutexDelete(pContext->mutexTx);
+    }
+    free(pContext);
+}
+
+// Set up a CMUX context with the given number of data channels open,
+// without an AT client or a UART underneath it.
+static uCellMuxPrivateContext_t *pContextCreate(uCellPrivateInstance_t *pInstance,
+                                                uCmuxRxStress_t *pStress)
+{
+    uCellMuxPrivateContext_t *pContext;
+    uCellMuxPrivateChannelContext_t *pChannelContext;
+    bool success = false;
+
+    pContext = (uCellMuxPrivateContext_t *) malloc(sizeof(*pContext));
+    if (pContext != NULL) {
+        memset(pContext, 0, sizeof(*pContext));
+        pContext->pInstance = pInstance;
+        pContext->underlyingStreamHandle = -1;
+        success = (uPortMutexCreate(&(pContext->mutexTx)) == 0) &&
+                  (uPortMutexCreate(&(pContext->mutexTxScheduler)) == 0) &&
+                  (uRingBufferCreateWithReadHandle(&(pContext->ringBuffer),
+                                                   pContext->linearBuffer,
+                                                   sizeof(pContext->linearBuffer),
+                                                   1 + U_CELL_MUX_MAX_CHANNELS) == 0);
+        if (success) {
+            uRingBufferSetReadRequiresHandle(&(pContext->ringBuffer), true);
+            pContext->readHandle = uRingBufferTakeReadHandle(&(pContext->ringBuffer));
+            for (size_t x = 0; x < sizeof(pContext->rxReader) / sizeof(pContext->rxReader[0]);
+                 x++) {
+                pContext->rxReader[x].readHandle =
+                    uRingBufferTakeReadHandle(&(pContext->ringBuffer));
+            }
+            // There is no module to answer the SABM that opening a
+            // channel sends, so the outcome of openChannel() is ignored:
+            // all that is needed is the serial device it sets up
+            openChannel(pContext, U_CELL_MUX_PRIVATE_CHANNEL_ID_CONTROL, 0);
+            success = (pUCellMuxPrivateGetDeviceSerial(pContext,
+                                                       U_CELL_MUX_PRIVATE_CHANNEL_ID_CONTROL) !=
+                       NULL);
+        }
+        for (size_t x = 0; success && (x < pStress->numChannels); x++) {
+            openChannel(pContext, pStress->channel[x].channel, 0);
+            pStress->channel[x].pDeviceSerial =
+                pUCellMuxPrivateGetDeviceSerial(pContext, pStress->channel[x].channel);
+            success = (pStress->channel[x].pDeviceSerial != NULL);
+            if (success) {
+                // Do what serialOpen() would have done had the SABM
+                // been answered
+                pChannelContext = (uCellMuxPrivateChannelContext_t *) pUInterfaceContext(
+                                      pStress->channel[x].pDeviceSerial);
+                pChannelContext->traffic.rxBufferSizeBytes =
+                    U_CELL_MUX_PRIVATE_VIRTUAL_SERIAL_BUFFER_LENGTH_BYTES;
+                pChannelContext->traffic.pRxBufferStart =
+                    (char *) malloc(pChannelContext->traffic.rxBufferSizeBytes);
+                pChannelContext->traffic.pRxBufferWrite = pChannelContext->traffic.pRxBufferStart;
+                pChannelContext->traffic.pRxBufferRead = pChannelContext->traffic.pRxBufferStart;
+                pChannelContext->state = U_CELL_MUX_PRIVATE_CHANNEL_STATE_OPEN;
+                success = (pChannelContext->traffic.pRxBufferStart != NULL);
+            }
+        }
+    }
+
+    if (!success && (pContext != NULL)) {
+        contextDelete(pContext);
+        pContext = NULL;
+    }
+
+    return pContext;
+}
+
+// Encode pseudo-random UIH frames for the data channels, with the odd
+// junk byte between them, recording the information fields sent to
+// each channel; returns the length of the stream or zero on failure.
+static size_t streamCreate(uCmuxRxStress_t *pStress, char *pStream, size_t length)
+{
+    char information[U_CELL_MUX_PRIVATE_INFORMATION_LENGTH_MAX_BYTES];
+    uCmuxRxStressChannel_t *pChannel;
+    size_t streamLength = 0;
+    size_t informationLength;
+    int32_t frameLength = 0;
+
+    for (size_t x = 0; x < pStress->numChannels; x++) {
+        pStress->channel[x].pExpected = (char *) malloc(length);
+        if (pStress->channel[x].pExpected == NULL) {
+            frameLength = -1;
+        }
+    }
+    // Leave room for a junk byte and a whole frame
+    while ((frameLength >= 0) && (streamLength + sizeof(information) + 16 < length)) {
+        pChannel = &(pStress->channel[randomNumber(&(pStress->seed)) % pStress->numChannels]);
+        informationLength = 1 + (randomNumber(&(pStress->seed)) % sizeof(information));
+        for (size_t x = 0; x < informationLength; x++) {
+            information[x] = (char) randomNumber(&(pStress->seed));
+        }
+        if ((randomNumber(&(pStress->seed)) % U_CMUX_RX_STRESS_JUNK_DIVISOR) == 0) {
+            pStream[streamLength] = (char) randomNumber(&(pStress->seed));
+            streamLength++;
+        }
+        frameLength = uCellMuxPrivateEncode(pChannel->channel,
+                                            U_CELL_MUX_PRIVATE_FRAME_TYPE_UIH,
+                                            false, information, informationLength,
+                                            pStream + streamLength);
+        if (frameLength > 0) {
+            streamLength += frameLength;
+            memcpy(pChannel->pExpected + pChannel->expectedLength, information, informationLength);
+            pChannel->expectedLength += informationLength;
+        } else {
+            frameLength = -1;
+        }
+    }
+
+    return (frameLength >= 0) ? streamLength : 0;
+}
+
+// Run the stress test, returning the number of problems found.
+static int run(uCmuxRxStress_t *pStress, size_t length, bool inLine)
+{
+    int numProblems = 1;
+    uCellPrivateInstance_t instance = {0};
+    uCellMuxPrivateContext_t *pContext;
+    uPortTaskHandle_t readerTaskHandle = NULL;
+    char *pStream;
+    size_t streamLength;
+    size_t streamIndex = 0;
+    size_t thisSize;
+    size_t expectedLength = 0;
+    size_t numBytes = 0;
+    uint32_t iteration = 0;
+    uint32_t seed;
+    int32_t startTimeMs;
+
+    instance.pinDtrPowerSaving = -1;
+    pStream = (char *) malloc(length);
+    pContext = pContextCreate(&instance, pStress);
+    if ((pStream != NULL) && (pContext != NULL)) {
+        streamLength = streamCreate(pStress, pStream, length);
+        seed = pStress->seed;
+        for (size_t x = 0; x < pStress->numChannels; x++) {
+            expectedLength += pStress->channel[x].expectedLength;
+        }
+        printf("%d byte(s) of frames carrying %d byte(s) for %d channel(s), reading %s.\n",
+               (int) streamLength, (int) expectedLength, (int) pStress->numChannels,
+               inLine ? "in-line" : "from a task");
+        if ((streamLength > 0) &&
+            (inLine || (uPortTaskCreate(readerTask, "cmuxRxStress",
+                                        U_CMUX_RX_STRESS_READER_TASK_STACK_SIZE_BYTES,
+                                        pStress, U_CFG_OS_APP_TASK_PRIORITY,
+                                        &readerTaskHandle) == 0))) {
+            pStress->readerRunning = !inLine;
+            numProblems = 0;
+            startTimeMs = uPortGetTickTimeMs();
+            while ((numBytes < expectedLength) && (numProblems == 0)) {
+                // Add what will fit to the ring buffer, as
+                // cmuxReceiveCallback() would, and decode it
+                thisSize = 1 + (randomNumber(&seed) % U_CMUX_RX_STRESS_ADD_LENGTH_MAX_BYTES);
+                if (thisSize > uRingBufferAvailableSize(&(pContext->ringBuffer))) {
+                    thisSize = uRingBufferAvailableSize(&(pContext->ringBuffer));
+                }
+                if (thisSize > streamLength - streamIndex) {
+                    thisSize = streamLength - streamIndex;
+                }
+                if ((thisSize > 0) &&
+                    uRingBufferAdd(&(pContext->ringBuffer), pStream + streamIndex, thisSize)) {
+                    streamIndex += thisSize;
+                }
+                cmuxDecode(pContext, U_DEVICE_SERIAL_EVENT_BITMASK_DATA_RECEIVED);
+                if (!readersCheck(pContext)) {
+                    numProblems++;
+                }
+                if (inLine) {
+                    readersRun(pStress, iteration, &seed);
+                }
+                iteration++;
+                numBytes = 0;
+                for (size_t x = 0; x < pStress->numChannels; x++) {
+                    numBytes += pStress->channel[x].numBytes;
+                    if (pStress->channel[x].bad) {
+                        numProblems++;
+                    }
+                }
+                if (uPortGetTickTimeMs() - startTimeMs > U_CMUX_RX_STRESS_TIMEOUT_MS) {
+                    printf("stuck after %d ms, %d of %d byte(s) of frames added to the"
+                           " ring buffer.\n",
+                           U_CMUX_RX_STRESS_TIMEOUT_MS, (int) streamIndex, (int) streamLength);
+                    numProblems++;
+                }
+            }
+            pStress->stop = true;
+            while (pStress->readerRunning) {
+                uPortTaskBlock(10);
+            }
+            for (size_t x = 0; x < pStress->numChannels; x++) {
+                printf("channel %d: %d of %d byte(s) read%s.\n",
+                       pStress->channel[x].channel, (int) pStress->channel[x].numBytes,
+                       (int) pStress->channel[x].expectedLength,
+                       pStress->channel[x].bad ? ", BAD" : "");
+            }
+            printf("%d decode(s), %s.\n", (int) iteration, (numProblems == 0) ? "OK" : "FAILED");
+        }
+    }
+
+    if (pContext != NULL) {
+        contextDelete(pContext);
+    }
+    free(pStream);
+    for (size_t x = 0; x < pStress->numChannels; x++) {
+        free(pStress->channel[x].pExpected);
+    }
+
+    return numProblems;
+}
+
+// The task within which the test runs.
+static void appTask(void *pParam)
+{
+    uCmuxRxStressArgs_t *pArgs = (uCmuxRxStressArgs_t *) pParam;
+    static uCmuxRxStress_t stress = {0};
+    int32_t numChannels = U_CMUX_RX_STRESS_MAX_DATA_CHANNELS;
+    int32_t numKbytes = U_CMUX_RX_STRESS_DEFAULT_KBYTES;
+    int32_t seed = 1;
+    bool inLine = true;
+    int numProblems = 0;
+
+    for (int x = 1; x < pArgs->argc; x++) {
+        if ((strcmp(pArgs->argv[x], "-c") == 0) && (x + 1 < pArgs->argc)) {
+            x++;
+            numChannels = atoi(pArgs->argv[x]);
+        } else if ((strcmp(pArgs->argv[x], "-k") == 0) && (x + 1 < pArgs->argc)) {
+            x++;
+            numKbytes = atoi(pArgs->argv[x]);
+        } else if ((strcmp(pArgs->argv[x], "-s") == 0) && (x + 1 < pArgs->argc)) {
+            x++;
+            seed = atoi(pArgs->argv[x]);
+        } else if (strcmp(pArgs->argv[x], "-t") == 0) {
+            inLine = false;
+        } else {
+            numProblems++;
+        }
+    }
+    if ((numProblems > 0) || (numChannels < 2) ||
+        (numChannels > U_CMUX_RX_STRESS_MAX_DATA_CHANNELS) || (numKbytes <= 0)) {
+        printf("usage: %s [-c channels] [-k kbytes] [-s seed] [-t]\n"
+               "  -c  the number of data channels, 2 to %d, default %d; the last is read slowly.\n"
+               "  -k  the kbytes of frames to decode, default %d.\n"
+               "  -s  the seed for the pseudo-random frames, default 1.\n"
+               "  -t  read from a separate task rather than in-line with decoding.\n",
+               pArgs->argv[0], U_CMUX_RX_STRESS_MAX_DATA_CHANNELS,
+               U_CMUX_RX_STRESS_MAX_DATA_CHANNELS, U_CMUX_RX_STRESS_DEFAULT_KBYTES);
+        numProblems++;
+    } else {
+        stress.numChannels = numChannels;
+        stress.seed = (uint32_t) seed;
+        for (size_t x = 0; x < stress.numChannels; x++) {
+            stress.channel[x].channel = (uint8_t) (x + 1);
+        }
+        uPortInit();
+        numProblems += run(&stress, numKbytes * 1024, inLine);
+        uPortDeinit();
+    }
+
+    pArgs->exitCode = (numProblems > 0) ? 1 : 0;
+}
+
+/* ----------------------------------------------------------------
+ * PUBLIC FUNCTIONS
+ * -------------------------------------------------------------- */
+
+// Entry point
+int main(int argc, char *argv[])
+{
+    uCmuxRxStressArgs_t args = {.argc = argc, .argv = argv, .exitCode = 1};
+
+    uPortPlatformStart(appTask, &args,
+                       U_CFG_OS_APP_TASK_STACK_SIZE_BYTES,
+                       U_CFG_OS_APP_TASK_PRIORITY);
+
+    return args.exitCode;
+}
+
+// End of file
@@ -0,0 +1,477 @@
+/*
+ * Copyright 2019-2024 u-blox
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** @file
+ * @brief A fuzz target for the GNSS framer, u_gnss_framer.c; see
+ * README.md.
+ */
+
+#include "stddef.h"    // NULL, size_t etc.
+#include "stdint.h"    // int32_t etc.
+#include "stdbool.h"
+#include "stdlib.h"    // malloc(), free(), abort(), atoi()
+#include "stdio.h"     // printf(), fopen()
+#include "string.h"    // memcmp(), strcmp()
+
+#include "u_error_common.h"
+
+#include "u_spartn.h"
+
+#include "u_gnss_type.h"
+#include "u_gnss_framer.h"
+
+/* ----------------------------------------------------------------
+ * COMPILE-TIME MACROS
+ * -------------------------------------------------------------- */
+
+/** The most frames that are compared for one input.
+ */
+#define U_GNSS_FRAMER_FUZZ_MAX_NUM_FRAMES 1024
+
+/** The largest input that is tested: the whole of it must fit in
+ * the framer's buffer for feeding in chunks to be guaranteed to
+ * give the same result as feeding it all at once.
+ */
+#define U_GNSS_FRAMER_FUZZ_INPUT_MAX_BYTES U_GNSS_FRAMER_LENGTH_MAX_BYTES
+
+/** The default number of random inputs tried by the standalone
+ * driver.
+ */
+#define U_GNSS_FRAMER_FUZZ_DEFAULT_ITERATIONS 100000
+
+/** Check a condition, aborting (so that the fuzzer or sanitizer
+ * reports the input) if it is false.
+ */
+#define U_GNSS_FRAMER_FUZZ_CHECK(x) if (!(x)) {                              \
+                                        fprintf(stderr, "%s:%d: check \"%s\" failed.\n", \
+                                                __FILE__, __LINE__, #x);     \
+                                        abort();                             \
+                                    }
+
+/* ----------------------------------------------------------------
+ * TYPES
+ * -------------------------------------------------------------- */
+
+/** What is remembered of a frame for comparison.
+ */
+typedef struct {
+    uGnssFramerFrame_t frame;
+    uint32_t hash; /**< of the frame's contents. */
+} uGnssFramerFuzzFrame_t;
+
+/* ----------------------------------------------------------------
+ * VARIABLES
+ * -------------------------------------------------------------- */
+
+/** The framer's buffer.
+ */
+static char gBuffer[U_GNSS_FRAMER_LENGTH_MAX_BYTES];
+
+/** The frames found by feeding the input all at once.
+ */
+static uGnssFramerFuzzFrame_t gFramesWhole[U_GNSS_FRAMER_FUZZ_MAX_NUM_FRAMES];
+
+/** The frames found by feeding the input in chunks.
+ */
+static uGnssFramerFuzzFrame_t gFramesChunked[U_GNSS_FRAMER_FUZZ_MAX_NUM_FRAMES];
+
+/** The total number of frames found, for information.
+ */
+static size_t gNumFramesTotal = 0;
+
+/* ----------------------------------------------------------------
+ * STATIC FUNCTIONS
+ * -------------------------------------------------------------- */
+
+// FNV-1a.
+static uint32_t hash(const char *pData, size_t length)
+{
+    uint32_t h = 2166136261UL;
+
+    for (size_t x = 0; x < length; x++) {
+        h = (h ^ (uint8_t) pData[x]) * 16777619UL;
+    }
+
+    return h;
+}
+
+// Compare the IDs of two frames of the same protocol; only the
+// member of the union for the protocol is populated.
+static bool idEqual(const uGnssFramerFrame_t *pFrameA,
+                    const uGnssFramerFrame_t *pFrameB)
+{
+    bool equal = false;
+
+    switch (pFrameA->protocol) {
+        case U_GNSS_FRAMER_PROTOCOL_UBX:
+            equal = (pFrameA->id.ubx == pFrameB->id.ubx);
+            break;
+        case U_GNSS_FRAMER_PROTOCOL_NMEA:
+            equal = (strcmp(pFrameA->id.nmea, pFrameB->id.nmea) == 0);
+            break;
+        case U_GNSS_FRAMER_PROTOCOL_RTCM:
+            equal = (pFrameA->id.rtcm == pFrameB->id.rtcm);
+            break;
+        case U_GNSS_FRAMER_PROTOCOL_SPARTN:
+            equal = (pFrameA->id.spartn == pFrameB->id.spartn);
+            break;
+        default:
+            break;
+    }
+
+    return equal;
+}
+
+// Check that a frame is what it claims to be.
+static void checkFrame(const uGnssFramerFrame_t *pFrame)
+{
+    const uint8_t *pByte = (const uint8_t *) pFrame->pData;
+    uGnssFramerFrame_t frame;
+    uGnssFramer_t framer;
+    uint8_t ckA = 0;
+    uint8_t ckB = 0;
+    const char *pMessage = NULL;
+
+    // With a buffer big enough for anything there is always data
+    U_GNSS_FRAMER_FUZZ_CHECK(pByte != NULL);
+    switch (pFrame->protocol) {
+        case U_GNSS_FRAMER_PROTOCOL_UBX:
+            U_GNSS_FRAMER_FUZZ_CHECK((pFrame->length >= 8) &&
+                                     (pByte[0] == 0xB5) && (pByte[1] == 0x62));
+            U_GNSS_FRAMER_FUZZ_CHECK(pFrame->length == (size_t) pByte[4] +
+                                     ((size_t) pByte[5] << 8) + 8);
+            U_GNSS_FRAMER_FUZZ_CHECK(pFrame->id.ubx == (((uint16_t) pByte[2] << 8) | pByte[3]));
+            for (size_t x = 2; x < pFrame->length - 2; x++) {
+                ckA += pByte[x];
+                ckB += ckA;
+            }
+            U_GNSS_FRAMER_FUZZ_CHECK((ckA == pByte[pFrame->length - 2]) &&
+                                     (ckB == pByte[pFrame->length - 1]));
+            break;
+        case U_GNSS_FRAMER_PROTOCOL_NMEA:
+            U_GNSS_FRAMER_FUZZ_CHECK((pFrame->length <= U_GNSS_FRAMER_NMEA_LENGTH_MAX_BYTES) &&
+                                     (pByte[0] == '$') &&
+                                     (pByte[pFrame->length - 2] == '\r') &&
+                                     (pByte[pFrame->length - 1] == '\n'));
+            U_GNSS_FRAMER_FUZZ_CHECK(memcmp(pFrame->id.nmea, pByte + 1,
+                                            strlen(pFrame->id.nmea)) == 0);
+            break;
+        case U_GNSS_FRAMER_PROTOCOL_RTCM:
+            U_GNSS_FRAMER_FUZZ_CHECK((pFrame->length >= 6) && (pByte[0] == 0xD3));
+            U_GNSS_FRAMER_FUZZ_CHECK(pFrame->length == ((((size_t) pByte[1] & 0x03) << 8) |
+                                                        pByte[2]) + 6);
+            break;
+        case U_GNSS_FRAMER_PROTOCOL_SPARTN:
+            U_GNSS_FRAMER_FUZZ_CHECK(uSpartnValidate(pFrame->pData, pFrame->length,
+                                                     &pMessage) == (int32_t) pFrame->length);
+            U_GNSS_FRAMER_FUZZ_CHECK(pMessage == pFrame->pData);
+            break;
+        default:
+            U_GNSS_FRAMER_FUZZ_CHECK(false);
+            break;
+    }
+
+    // The block-parser form must agree
+    memset(&framer, 0, sizeof(framer));
+    U_GNSS_FRAMER_FUZZ_CHECK(uGnssFramerParseBlock(&framer, pFrame->pData, pFrame->length,
+                                                   &frame) == (int32_t) pFrame->length);
+    U_GNSS_FRAMER_FUZZ_CHECK((frame.protocol == pFrame->protocol) &&
+                             (frame.length == pFrame->length) &&
+                             idEqual(&frame, pFrame));
+}
+
+// Remember a frame, checking it on the way.
+static void addFrame(uGnssFramerFuzzFrame_t *pFrames, size_t *pNumFrames,
+                     const uGnssFramerFrame_t *pFrame)
+{
+    checkFrame(pFrame);
+    if (*pNumFrames < U_GNSS_FRAMER_FUZZ_MAX_NUM_FRAMES) {
+        pFrames[*pNumFrames].frame = *pFrame;
+        pFrames[*pNumFrames].hash = hash(pFrame->pData, pFrame->length);
+        (*pNumFrames)++;
+    }
+}
+
+// Frame the input, in chunks of the given sizes (used round-robin)
+// or all at once if pChunkSizes is NULL, returning the number of
+// frames found.
+static size_t frameInput(const char *pData, size_t length,
+                         const uint8_t *pChunkSizes, size_t numChunkSizes,
+                         uGnssFramerFuzzFrame_t *pFrames)
+{
+    uGnssFramer_t framer;
+    uGnssFramerFrame_t frame;
+    size_t numFrames = 0;
+    size_t chunk = 0;
+    size_t thisLength = length;
+    int32_t x;
+
+    U_GNSS_FRAMER_FUZZ_CHECK(uGnssFramerInit(&framer, U_GNSS_FRAMER_PROTOCOLS_ALL,
+                                             gBuffer, sizeof(gBuffer)) == 0);
+    while (length > 0) {
+        if (pChunkSizes != NULL) {
+            thisLength = pChunkSizes[chunk % numChunkSizes] + 1;
+            chunk++;
+            if (thisLength > length) {
+                thisLength = length;
+            }
+        }
+        do {
+            x = uGnssFramerFeed(&framer, pData, thisLength, &frame);
+            U_GNSS_FRAMER_FUZZ_CHECK((x >= 0) && ((size_t) x <= thisLength));
+            if (frame.protocol != U_GNSS_FRAMER_PROTOCOL_NONE) {
+                addFrame(pFrames, &numFrames, &frame);
+            }
+            pData += x;
+            thisLength -= x;
+            length -= x;
+        } while ((thisLength > 0) || (frame.protocol != U_GNSS_FRAMER_PROTOCOL_NONE));
+    }
+    do {
+        U_GNSS_FRAMER_FUZZ_CHECK(uGnssFramerFlush(&framer, &frame) == 0);
+        if (frame.protocol != U_GNSS_FRAMER_PROTOCOL_NONE) {
+            addFrame(pFrames, &numFrames, &frame);
+        }
+    } while (frame.protocol != U_GNSS_FRAMER_PROTOCOL_NONE);
+
+    return numFrames;
+}
+
+#ifndef U_GNSS_FRAMER_FUZZ_LIBFUZZER
+
+// Linear congruential, as in the tests.
+static uint32_t randomNumber(uint32_t *pSeed, uint32_t range)
+{
+    *pSeed = (*pSeed * 1103515245UL) + 12345UL;
+    return (*pSeed >> 16) % range;
+}
+
+// Write a valid UBX, NMEA or RTCM frame with a body of random bytes,
+// so that the standalone driver exercises complete frames as well as
+// broken ones, returning the length written.
+static size_t writeFrame(uint32_t *pSeed, uint8_t *pBuffer, size_t size)
+{
+    size_t length = 0;
+    size_t bodyLength = randomNumber(pSeed, 64);
+    uint32_t crc = 0;
+    uint8_t ckA = 0;
+    uint8_t ckB = 0;
+
+    switch (randomNumber(pSeed, 3)) {
+        case 0:
+            length = bodyLength + 8;
+            if (length <= size) {
+                pBuffer[0] = 0xB5;
+                pBuffer[1] = 0x62;
+                pBuffer[2] = (uint8_t) randomNumber(pSeed, 256);
+                pBuffer[3] = (uint8_t) randomNumber(pSeed, 256);
+                pBuffer[4] = (uint8_t) bodyLength;
+                pBuffer[5] = 0;
+                for (size_t x = 6; x < length - 2; x++) {
+                    pBuffer[x] = (uint8_t) randomNumber(pSeed, 256);
+                }
+                for (size_t x = 2; x < length - 2; x++) {
+                    ckA += pBuffer[x];
+                    ckB += ckA;
+                }
+                pBuffer[length - 2] = ckA;
+                pBuffer[length - 1] = ckB;
+            }
+            break;
+        case 1:
+            length = bodyLength + 6;
+            if (length <= size) {
+                pBuffer[0] = '$';
+                for (size_t x = 1; x < length - 5; x++) {
+                    // Printable but not '$' or '*'
+                    pBuffer[x] = (uint8_t) ('+' + randomNumber(pSeed, 80));
+                    ckA ^= pBuffer[x];
+                }
+                snprintf((char *) pBuffer + length - 5, 6, "*%02X\r\n", ckA);
+            }
+            break;
+        default:
+            length = bodyLength + 6;
+            if (length <= size) {
+                pBuffer[0] = 0xD3;
+                pBuffer[1] = 0;
+                pBuffer[2] = (uint8_t) bodyLength;
+                for (size_t x = 3; x < length - 3; x++) {
+                    pBuffer[x] = (uint8_t) randomNumber(pSeed, 256);
+                }
+                // CRC-24Q, bitwise
+                for (size_t x = 0; x < length - 3; x++) {
+                    crc ^= ((uint32_t) pBuffer[x]) << 16;
+                    for (size_t y = 0; y < 8; y++) {
+                        crc <<= 1;
+                        if (crc & 0x1000000) {
+                            crc ^= 0x1864CFB;
+                        }
+                    }
+                }
+                pBuffer[length - 3] = (uint8_t) (crc >> 16);
+                pBuffer[length - 2] = (uint8_t) (crc >> 8);
+                pBuffer[length - 1] = (uint8_t) crc;
+            }
+            break;
+    }
+
+    return (length <= size) ? length : 0;
+}
+
+#endif // #ifndef U_GNSS_FRAMER_FUZZ_LIBFUZZER
+
+/* ----------------------------------------------------------------
+ * PUBLIC FUNCTIONS
+ * -------------------------------------------------------------- */
+
+// The libFuzzer entry point: frame the input all at once and then
+// again in chunks, the sizes of which are taken from the input
+// itself, and check that the frames are the same.
+int LLVMFuzzerTestOneInput(const uint8_t *pData, size_t length)
+{
+    size_t numFramesWhole;
+    size_t numFramesChunked;
+    size_t numChunkSizes = 8;
+
+    if (length > U_GNSS_FRAMER_FUZZ_INPUT_MAX_BYTES) {
+        length = U_GNSS_FRAMER_FUZZ_INPUT_MAX_BYTES;
+    }
+    if (numChunkSizes > length) {
+        numChunkSizes = length;
+    }
+
+    numFramesWhole = frameInput((const char *) pData, length, NULL, 0, gFramesWhole);
+    gNumFramesTotal += numFramesWhole;
+    if (numChunkSizes > 0) {
+        numFramesChunked = frameInput((const char *) pData, length,
+                                      pData, numChunkSizes, gFramesChunked);
+        U_GNSS_FRAMER_FUZZ_CHECK(numFramesChunked == numFramesWhole);
+        for (size_t x = 0; x < numFramesWhole; x++) {
+            U_GNSS_FRAMER_FUZZ_CHECK((gFramesChunked[x].frame.protocol ==
+                                      gFramesWhole[x].frame.protocol) &&
+                                     (gFramesChunked[x].frame.length ==
+                                      gFramesWhole[x].frame.length) &&
+                                     idEqual(&(gFramesChunked[x].frame),
+                                             &(gFramesWhole[x].frame)) &&
+                                     (gFramesChunked[x].hash == gFramesWhole[x].hash));
+        }
+        // And a byte at a time, the worst case for carrying state
+        numFramesChunked = frameInput((const char *) pData, length,
+                                      (const uint8_t *) "", 1, gFramesChunked);
+        U_GNSS_FRAMER_FUZZ_CHECK(numFramesChunked == numFramesWhole);
+        for (size_t x = 0; x < numFramesWhole; x++) {
+            U_GNSS_FRAMER_FUZZ_CHECK(gFramesChunked[x].hash == gFramesWhole[x].hash);
+        }
+    }
+
+    return 0;
+}
+
+#ifndef U_GNSS_FRAMER_FUZZ_LIBFUZZER
+
+// Without libFuzzer, run the files named on the command line through
+// the fuzz target or, if there are none, pseudo-random inputs that
+// are rich in sync bytes.
+int main(int argc, char *argv[])
+{
+    int32_t iterations = U_GNSS_FRAMER_FUZZ_DEFAULT_ITERATIONS;
+    uint32_t seed = 1;
+    int32_t numFiles = 0;
+    uint8_t *pInput = (uint8_t *) malloc(U_GNSS_FRAMER_FUZZ_INPUT_MAX_BYTES);
+    size_t length;
+    FILE *pFile;
+
+    if (pInput == NULL) {
+        return 1;
+    }
+    for (int x = 1; x < argc; x++) {
+        if ((strcmp(argv[x], "-n") == 0) && (x + 1 < argc)) {
+            x++;
+            iterations = atoi(argv[x]);
+        } else if ((strcmp(argv[x], "-s") == 0) && (x + 1 < argc)) {
+            x++;
+            seed = (uint32_t) atoi(argv[x]);
+        } else {
+            pFile = fopen(argv[x], "rb");
+            if (pFile == NULL) {
+                printf("unable to open \"%s\".\n", argv[x]);
+                free(pInput);
+                return 1;
+            }
+            length = fread(pInput, 1, U_GNSS_FRAMER_FUZZ_INPUT_MAX_BYTES, pFile);
+            fclose(pFile);
+            LLVMFuzzerTestOneInput(pInput, length);
+            numFiles++;
+        }
+    }
+
+    if (numFiles == 0) {
+        for (int32_t y = 0; y < iterations; y++) {
+            // A short input mostly, with the occasional long one
+            length = randomNumber(&seed, (y % 64 == 0) ? 8192 : 512);
+            for (size_t x = 0; x < length; x++) {
+                switch (randomNumber(&seed, 24)) {
+                    case 0:
+                        pInput[x] = 0xB5;
+                        break;
+                    case 1:
+                        pInput[x] = 0x62;
+                        break;
+                    case 2:
+                        pInput[x] = '$';
+                        break;
+                    case 3:
+                        pInput[x] = '\n';
+                        break;
+                    case 4:
+                        pInput[x] = 0xD3;
+                        break;
+                    case 5:
+                        pInput[x] = 0x73;
+                        break;
+                    case 6:
+                        // Small lengths, so that frames can complete
+                        pInput[x] = 0;
+                        break;
+                    case 7:
+                    case 8:
+                        x += writeFrame(&seed, pInput + x, length - x);
+                        if (x < length) {
+                            pInput[x] = (uint8_t) randomNumber(&seed, 256);
+                        }
+                        break;
+                    default:
+                        pInput[x] = (uint8_t) randomNumber(&seed, 256);
+                        break;
+                }
+            }
+            LLVMFuzzerTestOneInput(pInput, length);
+        }
+        printf("%d pseudo-random input(s) passed", (int) iterations);
+    } else {
+        printf("%d file(s) passed", (int) numFiles);
+    }
+    printf(", %d frame(s) found.\n", (int) gNumFramesTotal);
+
+    free(pInput);
+
+    return 0;
+}
+
+#endif // #ifndef U_GNSS_FRAMER_FUZZ_LIBFUZZER
+
+// End of file
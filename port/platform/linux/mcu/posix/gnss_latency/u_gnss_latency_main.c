@@ -0,0 +1,343 @@
+/*
+ * Copyright 2019-2024 u-blox
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** @file
+ * @brief Measure the latency of uGnssMsgReceiveStart() callbacks on
+ * Linux by feeding a UBX stream into the GNSS code through a
+ * pseudo-terminal; see README.md.
+ */
+
+#ifdef U_CFG_OVERRIDE
+# include "u_cfg_override.h" // For a customer's configuration override
+#endif
+
+#define _GNU_SOURCE    // posix_openpt() etc.
+#include "stddef.h"    // NULL, size_t etc.
+#include "stdint.h"    // int32_t etc.
+#include "stdbool.h"
+#include "stdlib.h"    // malloc(), free(), atoi(), qsort(), posix_openpt()
+#include "stdio.h"     // printf()
+#include "string.h"    // memset(), strcmp()
+#include "time.h"      // clock_gettime()
+#include "fcntl.h"     // O_RDWR
+#include "unistd.h"    // write(), close()
+
+#include "u_cfg_sw.h"
+#include "u_cfg_os_platform_specific.h"
+
+#include "u_error_common.h"
+
+#include "u_port.h"
+#include "u_port_os.h"
+#include "u_port_uart.h"
+#include "u_port_event_queue.h" // U_PORT_EVENT_QUEUE_MIN_TASK_STACK_SIZE_BYTES
+
+#include "u_ubx_protocol.h"
+
+#include "u_gnss_module_type.h"
+#include "u_gnss_type.h"
+#include "u_gnss.h"
+#include "u_gnss_msg.h"
+
+/* ----------------------------------------------------------------
+ * COMPILE-TIME MACROS
+ * -------------------------------------------------------------- */
+
+/** The default number of NAV-PVT messages to send.
+ */
+#define U_GNSS_LATENCY_DEFAULT_NUM_MESSAGES 200
+
+/** The default rate at which NAV-PVT messages are sent.
+ */
+#define U_GNSS_LATENCY_DEFAULT_RATE_HZ 20
+
+/** The length of the body of a UBX-NAV-PVT message.
+ */
+#define U_GNSS_LATENCY_NAV_PVT_BODY_LENGTH_BYTES 92
+
+/** An NMEA sentence sent before each NAV-PVT message, as a receiver
+ * would, so that the message is not the only thing on the stream.
+ */
+#define U_GNSS_LATENCY_NMEA "$GNGGA,092725.00,4717.11399,N,00833.91590,E,1,08,1.01,499.6,M,48.0,M,,*5B\r\n"
+
+/** How long to wait for the last callback once everything is sent.
+ */
+#define U_GNSS_LATENCY_WAIT_MS 1000
+
+/* ----------------------------------------------------------------
+ * TYPES
+ * -------------------------------------------------------------- */
+
+/** The command-line, passed to appTask().
+ */
+typedef struct {
+    int argc;
+    char **argv;
+    int exitCode;
+} uGnssLatencyArgs_t;
+
+/** The time each NAV-PVT message was sent and when its callback
+ * was called; the iTOW field of each message is its index.
+ */
+typedef struct {
+    int64_t *pSentNs;
+    int64_t *pReceivedNs;
+    int32_t numMessages;
+    volatile int32_t numReceived;
+    volatile int32_t numBad;
+} uGnssLatencyContext_t;
+
+/* ----------------------------------------------------------------
+ * STATIC FUNCTIONS
+ * -------------------------------------------------------------- */
+
+// Get the time from the given clock in nanoseconds.
+static int64_t timeNs(clockid_t clock)
+{
+    struct timespec t;
+
+    clock_gettime(clock, &t);
+
+    return (((int64_t) t.tv_sec) * 1000000000LL) + t.tv_nsec;
+}
+
+// Compare two int64_t's for qsort().
+static int compareInt64(const void *pA, const void *pB)
+{
+    int64_t a = *((const int64_t *) pA);
+    int64_t b = *((const int64_t *) pB);
+
+    return (a > b) - (a < b);
+}
+
+// Event callback that does nothing, used to occupy that of the UART.
+static void dummyUartCallback(int32_t uartHandle, uint32_t eventBitmask,
+                              void *pParam)
+{
+    (void) uartHandle;
+    (void) eventBitmask;
+    (void) pParam;
+}
+
+// Callback for NAV-PVT messages.
+static void navPvtCallback(uDeviceHandle_t gnssHandle,
+                           const uGnssMessageId_t *pMessageId,
+                           int32_t errorCodeOrLength,
+                           void *pCallbackParam)
+{
+    uGnssLatencyContext_t *pContext = (uGnssLatencyContext_t *) pCallbackParam;
+    int64_t nowNs = timeNs(CLOCK_MONOTONIC);
+    char buffer[U_GNSS_LATENCY_NAV_PVT_BODY_LENGTH_BYTES + U_UBX_PROTOCOL_OVERHEAD_LENGTH_BYTES];
+    uint32_t iTow;
+
+    (void) pMessageId;
+    if ((errorCodeOrLength == sizeof(buffer)) &&
+        (uGnssMsgReceiveCallbackRead(gnssHandle, buffer, sizeof(buffer)) == sizeof(buffer))) {
+        // iTOW is the first field of the body, little-endian
+        iTow = uUbxProtocolUint32Decode(buffer + U_UBX_PROTOCOL_HEADER_LENGTH_BYTES);
+        if ((iTow < (uint32_t) pContext->numMessages) &&
+            (pContext->pReceivedNs[iTow] == 0)) {
+            pContext->pReceivedNs[iTow] = nowNs;
+            pContext->numReceived++;
+        } else {
+            pContext->numBad++;
+        }
+    } else {
+        pContext->numBad++;
+    }
+}
+
+// Send numMessages NAV-PVT messages at the given rate into the
+// master side of a pseudo-terminal whose slave is the GNSS UART,
+// returning the number of problems.
+static int run(int32_t numMessages, int32_t rateHz, bool poll)
+{
+    int numProblems = 1;
+    uGnssLatencyContext_t context = {0};
+    int masterFd;
+    int32_t uartHandle = -1;
+    uGnssTransportHandle_t transportHandle;
+    uDeviceHandle_t gnssHandle = NULL;
+    uGnssMessageId_t messageId = {.type = U_GNSS_PROTOCOL_UBX, .id.ubx = 0x0107};
+    char body[U_GNSS_LATENCY_NAV_PVT_BODY_LENGTH_BYTES] = {0};
+    char message[sizeof(U_GNSS_LATENCY_NMEA) + sizeof(body) + U_UBX_PROTOCOL_OVERHEAD_LENGTH_BYTES];
+    size_t nmeaLength = sizeof(U_GNSS_LATENCY_NMEA) - 1;
+    int32_t length;
+    int64_t periodNs = 1000000000LL / rateHz;
+    int64_t startNs;
+    int64_t cpuNs;
+    int64_t *pLatencyUs;
+    int32_t numLatencies = 0;
+    int32_t asyncHandle = -1;
+
+    context.numMessages = numMessages;
+    context.pSentNs = (int64_t *) calloc(numMessages, sizeof(int64_t));
+    context.pReceivedNs = (int64_t *) calloc(numMessages, sizeof(int64_t));
+    pLatencyUs = (int64_t *) calloc(numMessages, sizeof(int64_t));
+    masterFd = posix_openpt(O_RDWR | O_NOCTTY);
+    if ((context.pSentNs != NULL) && (context.pReceivedNs != NULL) &&
+        (pLatencyUs != NULL) && (masterFd >= 0) &&
+        (grantpt(masterFd) == 0) && (unlockpt(masterFd) == 0) &&
+        (uPortUartPrefix(ptsname(masterFd)) == 0)) {
+        // The name of the slave is the whole of the prefix
+        uartHandle = uPortUartOpen(-1, 115200, NULL, U_GNSS_UART_BUFFER_LENGTH_BYTES,
+                                   -1, -1, -1, -1);
+    }
+    if (uartHandle >= 0) {
+        if (poll) {
+            // Occupy the event callback of the UART so that the
+            // GNSS code has no choice but to poll it
+            uPortUartEventCallbackSet(uartHandle, U_PORT_UART_EVENT_BITMASK_DATA_RECEIVED,
+                                      dummyUartCallback, NULL, U_PORT_EVENT_QUEUE_MIN_TASK_STACK_SIZE_BYTES,
+                                      U_CFG_OS_PRIORITY_MAX - 5);
+        }
+        transportHandle.uart = uartHandle;
+        if ((uGnssAdd(U_GNSS_MODULE_TYPE_M9, U_GNSS_TRANSPORT_UART, transportHandle,
+                      -1, false, &gnssHandle) == 0) &&
+            ((asyncHandle = uGnssMsgReceiveStart(gnssHandle, &messageId,
+                                                 navPvtCallback, &context)) >= 0)) {
+            numProblems = 0;
+            memcpy(message, U_GNSS_LATENCY_NMEA, nmeaLength);
+            cpuNs = timeNs(CLOCK_PROCESS_CPUTIME_ID);
+            startNs = timeNs(CLOCK_MONOTONIC);
+            for (int32_t x = 0; x < numMessages; x++) {
+                // Wait until it's time to send the next one
+                while (timeNs(CLOCK_MONOTONIC) < startNs + (x * periodNs)) {
+                    uPortTaskBlock(1);
+                }
+                // iTOW is the message index
+                *((uint32_t *) body) = uUbxProtocolUint32Encode((uint32_t) x);
+                length = uUbxProtocolEncode(0x01, 0x07, body, sizeof(body),
+                                            message + nmeaLength);
+                context.pSentNs[x] = timeNs(CLOCK_MONOTONIC);
+                if (write(masterFd, message, nmeaLength + length) != (ssize_t) (nmeaLength + length)) {
+                    numProblems++;
+                }
+            }
+            startNs = timeNs(CLOCK_MONOTONIC);
+            while ((context.numReceived + context.numBad < numMessages) &&
+                   (timeNs(CLOCK_MONOTONIC) - startNs < U_GNSS_LATENCY_WAIT_MS * 1000000LL)) {
+                uPortTaskBlock(10);
+            }
+            cpuNs = timeNs(CLOCK_PROCESS_CPUTIME_ID) - cpuNs;
+            uGnssMsgReceiveStop(gnssHandle, asyncHandle);
+            for (int32_t x = 0; x < numMessages; x++) {
+                if (context.pReceivedNs[x] > 0) {
+                    pLatencyUs[numLatencies] = (context.pReceivedNs[x] - context.pSentNs[x]) / 1000;
+                    numLatencies++;
+                }
+            }
+            qsort(pLatencyUs, numLatencies, sizeof(int64_t), compareInt64);
+            if (numLatencies > 0) {
+                printf("%s: %d NAV-PVT message(s) at %d Hz, %d received, latency p50 %lld us,"
+                       " p90 %lld us, p99 %lld us, max %lld us, %lld us of CPU per message.\n",
+                       poll ? "polled" : "event-driven", (int) numMessages, (int) rateHz,
+                       (int) numLatencies,
+                       (long long) pLatencyUs[(numLatencies * 50) / 100],
+                       (long long) pLatencyUs[(numLatencies * 90) / 100],
+                       (long long) pLatencyUs[(numLatencies * 99) / 100],
+                       (long long) pLatencyUs[numLatencies - 1],
+                       (long long) (cpuNs / 1000 / numMessages));
+            }
+            if ((numLatencies < numMessages) || (context.numBad > 0)) {
+                printf("*** %d message(s) lost, %d bad.\n",
+                       (int) (numMessages - numLatencies), (int) context.numBad);
+                numProblems++;
+            }
+        } else {
+            printf("unable to start GNSS.\n");
+        }
+        if (gnssHandle != NULL) {
+            uGnssRemove(gnssHandle);
+        }
+        if (poll) {
+            uPortUartEventCallbackRemove(uartHandle);
+        }
+        uPortUartClose(uartHandle);
+    } else {
+        printf("unable to open a pseudo-terminal.\n");
+    }
+    if (masterFd >= 0) {
+        close(masterFd);
+    }
+    free(pLatencyUs);
+    free(context.pReceivedNs);
+    free(context.pSentNs);
+
+    return numProblems;
+}
+
+// The task within which the benchmark runs.
+static void appTask(void *pParam)
+{
+    uGnssLatencyArgs_t *pArgs = (uGnssLatencyArgs_t *) pParam;
+    int32_t numMessages = U_GNSS_LATENCY_DEFAULT_NUM_MESSAGES;
+    int32_t rateHz = U_GNSS_LATENCY_DEFAULT_RATE_HZ;
+    bool polledAlso = false;
+    int numProblems = 0;
+
+    for (int x = 1; x < pArgs->argc; x++) {
+        if ((strcmp(pArgs->argv[x], "-n") == 0) && (x + 1 < pArgs->argc)) {
+            x++;
+            numMessages = atoi(pArgs->argv[x]);
+        } else if ((strcmp(pArgs->argv[x], "-r") == 0) && (x + 1 < pArgs->argc)) {
+            x++;
+            rateHz = atoi(pArgs->argv[x]);
+        } else if (strcmp(pArgs->argv[x], "-p") == 0) {
+            polledAlso = true;
+        } else {
+            numProblems++;
+        }
+    }
+    if ((numProblems > 0) || (numMessages <= 0) || (rateHz <= 0)) {
+        printf("usage: %s [-n messages] [-r rate] [-p]\n"
+               "  -n  the number of NAV-PVT messages to send, default %d.\n"
+               "  -r  the rate at which to send them in Hz, default %d.\n"
+               "  -p  also measure with the message receive task polling.\n",
+               pArgs->argv[0], U_GNSS_LATENCY_DEFAULT_NUM_MESSAGES,
+               U_GNSS_LATENCY_DEFAULT_RATE_HZ);
+        numProblems++;
+    } else {
+        uPortInit();
+        uGnssInit();
+        numProblems += run(numMessages, rateHz, false);
+        if (polledAlso) {
+            numProblems += run(numMessages, rateHz, true);
+        }
+        uGnssDeinit();
+        uPortDeinit();
+    }
+
+    pArgs->exitCode = (numProblems > 0) ? 1 : 0;
+}
+
+/* ----------------------------------------------------------------
+ * PUBLIC FUNCTIONS
+ * -------------------------------------------------------------- */
+
+// Entry point
+int main(int argc, char *argv[])
+{
+    uGnssLatencyArgs_t args = {.argc = argc, .argv = argv, .exitCode = 1};
+
+    uPortPlatformStart(appTask, &args,
+                       U_CFG_OS_APP_TASK_STACK_SIZE_BYTES,
+                       U_CFG_OS_APP_TASK_PRIORITY);
+
+    return args.exitCode;
+}
+
+// End of file
@@ -0,0 +1,253 @@
+/*
+ * Copyright 2019-2024 u-blox
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** @file
+ * @brief A benchmark of the GNSS raw measurement decoder,
+ * u_gnss_raw.c, against a recorded log; see README.md.
+ */
+
+#include "stddef.h"    // NULL, size_t etc.
+#include "stdint.h"    // int32_t etc.
+#include "stdbool.h"
+#include "stdlib.h"    // malloc(), free(), atoi()
+#include "stdio.h"     // printf(), fopen()
+#include "string.h"    // memcpy(), strcmp()
+#include "time.h"      // clock_gettime()
+
+#include "u_error_common.h"
+
+#include "u_gnss_type.h"
+#include "u_gnss_framer.h"
+#include "u_gnss_dec_ubx_rxm_rawx.h"
+#include "u_gnss_raw.h"
+
+/* ----------------------------------------------------------------
+ * COMPILE-TIME MACROS
+ * -------------------------------------------------------------- */
+
+/** The number of epochs in the ring.
+ */
+#define U_GNSS_RAW_BENCH_RING_NUM_EPOCHS 4
+
+/** The default size of chunk in which the log is fed to the decoder.
+ */
+#define U_GNSS_RAW_BENCH_DEFAULT_CHUNK_LENGTH_BYTES 256
+
+/** The default number of passes through the log.
+ */
+#define U_GNSS_RAW_BENCH_DEFAULT_NUM_PASSES 10
+
+/* ----------------------------------------------------------------
+ * VARIABLES
+ * -------------------------------------------------------------- */
+
+/** The framer's buffer.
+ */
+static char gBuffer[U_GNSS_FRAMER_LENGTH_MAX_BYTES];
+
+/** The ring of epochs.
+ */
+static uGnssRawEpoch_t gEpochs[U_GNSS_RAW_BENCH_RING_NUM_EPOCHS];
+
+/* ----------------------------------------------------------------
+ * STATIC FUNCTIONS
+ * -------------------------------------------------------------- */
+
+// Get the time in nanoseconds.
+static int64_t timeNs()
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return ((int64_t) now.tv_sec * 1000000000LL) + now.tv_nsec;
+}
+
+// Print a result.
+static void printResult(const char *pName, size_t numEpochs,
+                        size_t numBytes, int64_t durationNs)
+{
+    if (durationNs <= 0) {
+        durationNs = 1;
+    }
+    printf("%-8s %8zu epoch(s), %8.1f MBytes/s", pName, numEpochs,
+           ((double) numBytes * 1000) / durationNs);
+    if (numEpochs > 0) {
+        printf(", %8lld ns per epoch", (long long) (durationNs / (int64_t) numEpochs));
+    }
+    printf(".\n");
+}
+
+// The baseline: frame the log and copy every UBX-RXM message into
+// memory allocated for it, as a message receive callback would,
+// without decoding anything; returns the number of UBX-RXM-RAWX
+// messages.
+static size_t baseline(const char *pLog, size_t length, size_t chunkLength,
+                       double *pSum)
+{
+    uGnssFramer_t framer;
+    uGnssFramerFrame_t frame;
+    size_t numEpochs = 0;
+    size_t thisLength;
+    int32_t x;
+    char *pCopy;
+
+    uGnssFramerInit(&framer, U_GNSS_FRAMER_PROTOCOL_BIT(U_GNSS_FRAMER_PROTOCOL_UBX),
+                    gBuffer, sizeof(gBuffer));
+    while (length > 0) {
+        thisLength = chunkLength;
+        if (thisLength > length) {
+            thisLength = length;
+        }
+        do {
+            x = uGnssFramerFeed(&framer, pLog, thisLength, &frame);
+            if ((frame.protocol == U_GNSS_FRAMER_PROTOCOL_UBX) && (frame.pData != NULL) &&
+                ((frame.id.ubx >> 8) == U_GNSS_RAW_UBX_RXM_SFRBX_MESSAGE_CLASS)) {
+                pCopy = (char *) malloc(frame.length);
+                if (pCopy != NULL) {
+                    memcpy(pCopy, frame.pData, frame.length);
+                    *pSum += (uint8_t) pCopy[frame.length - 1];
+                    free(pCopy);
+                }
+                if ((frame.id.ubx & 0xff) == U_GNSS_DEC_UBX_RXM_RAWX_MESSAGE_ID) {
+                    numEpochs++;
+                }
+            }
+            pLog += x;
+            length -= x;
+            thisLength -= x;
+        } while ((thisLength > 0) || (frame.protocol != U_GNSS_FRAMER_PROTOCOL_NONE));
+    }
+
+    return numEpochs;
+}
+
+// Decode the log with uGnssRawFeed(), returning the number of epochs.
+static size_t raw(const char *pLog, size_t length, size_t chunkLength,
+                  double *pSum, uGnssRawStats_t *pStats)
+{
+    uGnssRaw_t raw;
+    const uGnssRawEpoch_t *pEpoch;
+    size_t numEpochs = 0;
+    size_t thisLength;
+
+    uGnssRawInit(&raw, gEpochs, U_GNSS_RAW_BENCH_RING_NUM_EPOCHS,
+                 gBuffer, sizeof(gBuffer));
+    while (length > 0) {
+        thisLength = chunkLength;
+        if (thisLength > length) {
+            thisLength = length;
+        }
+        uGnssRawFeed(&raw, pLog, thisLength);
+        for (pEpoch = pUGnssRawEpochGet(&raw); pEpoch != NULL; pEpoch = pUGnssRawEpochGet(&raw)) {
+            if (pEpoch->numMeas > 0) {
+                *pSum += pEpoch->prMes[0];
+            }
+            numEpochs++;
+            uGnssRawEpochRelease(&raw);
+        }
+        pLog += thisLength;
+        length -= thisLength;
+    }
+    uGnssRawFlush(&raw);
+    for (pEpoch = pUGnssRawEpochGet(&raw); pEpoch != NULL; pEpoch = pUGnssRawEpochGet(&raw)) {
+        numEpochs++;
+        uGnssRawEpochRelease(&raw);
+    }
+    uGnssRawGetStats(&raw, pStats);
+
+    return numEpochs;
+}
+
+/* ----------------------------------------------------------------
+ * PUBLIC FUNCTIONS
+ * -------------------------------------------------------------- */
+
+// Read a recorded log and decode it a number of times, printing
+// the results.
+int main(int argc, char *argv[])
+{
+    size_t chunkLength = U_GNSS_RAW_BENCH_DEFAULT_CHUNK_LENGTH_BYTES;
+    int32_t numPasses = U_GNSS_RAW_BENCH_DEFAULT_NUM_PASSES;
+    const char *pFileName = NULL;
+    FILE *pFile;
+    char *pLog;
+    long length;
+    size_t numEpochs = 0;
+    uGnssRawStats_t stats = {0};
+    double sum = 0;
+    int64_t startTimeNs;
+
+    for (int x = 1; x < argc; x++) {
+        if ((strcmp(argv[x], "-c") == 0) && (x + 1 < argc)) {
+            x++;
+            chunkLength = (size_t) atoi(argv[x]);
+        } else if ((strcmp(argv[x], "-n") == 0) && (x + 1 < argc)) {
+            x++;
+            numPasses = atoi(argv[x]);
+        } else {
+            pFileName = argv[x];
+        }
+    }
+    if ((pFileName == NULL) || (chunkLength == 0) || (numPasses <= 0)) {
+        printf("usage: %s [-c chunk_size] [-n passes] log.ubx\n", argv[0]);
+        return 1;
+    }
+
+    pFile = fopen(pFileName, "rb");
+    if (pFile == NULL) {
+        printf("unable to open \"%s\".\n", pFileName);
+        return 1;
+    }
+    fseek(pFile, 0, SEEK_END);
+    length = ftell(pFile);
+    fseek(pFile, 0, SEEK_SET);
+    pLog = (char *) malloc(length > 0 ? length : 1);
+    if ((pLog == NULL) || (fread(pLog, 1, length, pFile) != (size_t) length)) {
+        printf("unable to read \"%s\".\n", pFileName);
+        fclose(pFile);
+        free(pLog);
+        return 1;
+    }
+    fclose(pFile);
+    printf("\"%s\": %ld byte(s), %d pass(es) in %zu byte chunks.\n",
+           pFileName, length, numPasses, chunkLength);
+
+    startTimeNs = timeNs();
+    for (int32_t x = 0; x < numPasses; x++) {
+        numEpochs += baseline(pLog, length, chunkLength, &sum);
+    }
+    printResult("copy", numEpochs, (size_t) length * numPasses, timeNs() - startTimeNs);
+
+    numEpochs = 0;
+    startTimeNs = timeNs();
+    for (int32_t x = 0; x < numPasses; x++) {
+        numEpochs += raw(pLog, length, chunkLength, &sum, &stats);
+    }
+    printResult("raw", numEpochs, (size_t) length * numPasses, timeNs() - startTimeNs);
+
+    printf("per pass: %u RAWX, %u SFRBX, %u bad, %u epoch(s) dropped, %u measurement(s)"
+           " dropped, %u subframe(s) dropped (checksum %g).\n",
+           (unsigned) stats.rawxCount, (unsigned) stats.sfrbxCount,
+           (unsigned) stats.badCount, (unsigned) stats.epochsDropped,
+           (unsigned) stats.measDropped, (unsigned) stats.subframesDropped, sum);
+
+    free(pLog);
+
+    return 0;
+}
+
+// End of file
@@ -262,8 +262,8 @@ static uErrorCode_t readFromQueue(uPortQueue_t *pQueue,
     MTX_FN(uPortMutexLock(pQueue->mutex));
     if (pQueue->readCount >= pQueue->itemSizeBytes) {
         errorCode = U_ERROR_COMMON_TRUNCATED;
-        size_t readCount = read(pQueue->fd[0], pEventData, pQueue->itemSizeBytes);
-        if (readCount == pQueue->itemSizeBytes) {
+        ssize_t readCount = read(pQueue->fd[0], pEventData, pQueue->itemSizeBytes);
+        if (readCount == (ssize_t) pQueue->itemSizeBytes) {
             errorCode = U_ERROR_COMMON_SUCCESS;
         }
         if (readCount >= 0) {
@@ -479,7 +479,13 @@ bool uPortTaskIsThis(const uPortTaskHandle_t taskHandle)
 // Block the current task for a time.
 void uPortTaskBlock(int32_t delayMs)
 {
-    usleep(delayMs * 1000);
+    if (delayMs > 0) {
+        usleep(delayMs * 1000);
+    } else {
+        // usleep(0) would still sleep for the timer slack,
+        // typically 50 microseconds, just yield instead
+        sched_yield();
+    }
 }
 
 // Get the minimum free stack for a given task.
@@ -569,8 +575,11 @@ int32_t uPortQueueSend(const uPortQueueHandle_t queueHandle,
     if (pQueue != NULL) {
         errorCode = U_ERROR_COMMON_TRUNCATED;
         MTX_FN(uPortMutexLock(pQueue->mutex));
-        size_t writeCount = write(pQueue->fd[1], pEventData, pQueue->itemSizeBytes);
-        if (writeCount == pQueue->itemSizeBytes) {
+        // Note: write() returns -1 if the pipe is full, which must
+        // not be counted, else readCount is left out of step with
+        // what is in the pipe and the last item is never read
+        ssize_t writeCount = write(pQueue->fd[1], pEventData, pQueue->itemSizeBytes);
+        if (writeCount == (ssize_t) pQueue->itemSizeBytes) {
             errorCode = U_ERROR_COMMON_SUCCESS;
         }
         if (writeCount >= 0) {
@@ -579,7 +588,9 @@ int32_t uPortQueueSend(const uPortQueueHandle_t queueHandle,
             errorCode = U_ERROR_COMMON_PLATFORM;
         }
         MTX_FN(uPortMutexUnlock(pQueue->mutex));
-        uPortSemaphoreGive(pQueue->semHandle);
+        if (writeCount > 0) {
+            uPortSemaphoreGive(pQueue->semHandle);
+        }
     }
     return (int32_t)errorCode;
 }
@@ -180,6 +180,9 @@ static void readTask(void *pParam)
                     if (cnt > 0) {
                         available -= cnt;
                         p->writePos = (p->writePos + cnt) % p->bufferSize;
+                        // If the read pointer is at the start of the buffer
+                        // then wrapping will have filled it up
+                        p->bufferFull = p->writePos == readPos;
                     }
                     tot = cnt;
                 }
@@ -626,18 +629,25 @@ int32_t uPortUartWrite(int32_t handle, const void *pBuffer,
                        size_t sizeBytes)
 {
     int32_t sizeOrErrorCode = (int32_t)U_ERROR_COMMON_NOT_INITIALISED;
+    int uartFd = -1;
     if (gMutex != NULL) {
         U_PORT_MUTEX_LOCK(gMutex);
         sizeOrErrorCode = (int32_t) U_ERROR_COMMON_INVALID_PARAMETER;
         uPortUartData_t *pUartData = findUart(handle);
         if ((pBuffer != NULL) && (sizeBytes > 0) &&
             (pUartData != NULL) && !pUartData->markedForDeletion) {
-            sizeOrErrorCode = write(pUartData->uartFd, pBuffer, sizeBytes);
+            uartFd = pUartData->uartFd;
+        }
+        U_PORT_MUTEX_UNLOCK(gMutex);
+        if (uartFd >= 0) {
+            // Write outside the mutex: write() blocks while the
+            // transmit side of the UART is full and that must
+            // not stop the receive side being read
+            sizeOrErrorCode = write(uartFd, pBuffer, sizeBytes);
             if (sizeOrErrorCode < 0) {
                 sizeOrErrorCode = (int32_t)U_ERROR_COMMON_PLATFORM;
             }
         }
-        U_PORT_MUTEX_UNLOCK(gMutex);
     }
     return sizeOrErrorCode;
 }
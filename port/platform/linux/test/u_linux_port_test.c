@@ -0,0 +1,412 @@
+/*
+ * Copyright 2019-2024 u-blox
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** @file
+ * @brief Tests of behaviour specific to the Linux port, i.e. that
+ * of the way it implements things on top of Linux, which the
+ * platform-independent tests in port/test cannot reach.  These
+ * tests need no HW.
+ *
+ * IMPORTANT: see notes in u_cfg_test_platform_specific.h for the
+ * naming rules that must be followed when using the U_PORT_TEST_FUNCTION()
+ * macro.
+ */
+
+#ifdef U_CFG_OVERRIDE
+# include "u_cfg_override.h" // For a customer's configuration override
+#endif
+
+#define _GNU_SOURCE    // posix_openpt() etc.
+#include "stddef.h"    // NULL, size_t etc.
+#include "stdint.h"    // int32_t etc.
+#include "stdbool.h"
+#include "stdlib.h"    // posix_openpt(), grantpt(), unlockpt(), ptsname()
+#include "string.h"    // memset(), memcmp()
+#include "fcntl.h"     // O_RDWR, O_NOCTTY, fcntl()
+#include "unistd.h"    // read(), write(), close()
+
+#include "u_cfg_sw.h"
+#include "u_cfg_app_platform_specific.h"
+#include "u_cfg_test_platform_specific.h"
+#include "u_cfg_os_platform_specific.h"
+
+#include "u_error_common.h"
+
+#include "u_port.h"
+#include "u_port_os.h"
+#include "u_port_debug.h"
+#include "u_port_uart.h"
+
+#include "u_test_util_resource_check.h"
+
+/* ----------------------------------------------------------------
+ * COMPILE-TIME MACROS
+ * -------------------------------------------------------------- */
+
+/** The string to put at the start of all prints from this test.
+ */
+#define U_TEST_PREFIX "U_LINUX_PORT_TEST: "
+
+/** Print a whole line, with terminator, prefixed for this test file.
+ */
+#define U_TEST_PRINT_LINE(format, ...) uPortLog(U_TEST_PREFIX format "\n", ##__VA_ARGS__)
+
+#ifndef U_LINUX_PORT_TEST_QUEUE_LENGTH
+/** The length of the queue used for testing.
+ */
+# define U_LINUX_PORT_TEST_QUEUE_LENGTH 10
+#endif
+
+#ifndef U_LINUX_PORT_TEST_QUEUE_ITEMS_MAX
+/** A guard on the number of items sent when trying to fill a
+ * queue; the pipe behind it should be full long before this.
+ */
+# define U_LINUX_PORT_TEST_QUEUE_ITEMS_MAX 1000000
+#endif
+
+#ifndef U_LINUX_PORT_TEST_UART_BUFFER_LENGTH_BYTES
+/** The receive buffer length to open a UART with for testing.
+ */
+# define U_LINUX_PORT_TEST_UART_BUFFER_LENGTH_BYTES 256
+#endif
+
+#ifndef U_LINUX_PORT_TEST_UART_WAIT_MS
+/** How long to wait for data to arrive at a UART.
+ */
+# define U_LINUX_PORT_TEST_UART_WAIT_MS 1000
+#endif
+
+#ifndef U_LINUX_PORT_TEST_UART_WRITE_LENGTH_BYTES
+/** The amount of data to write to a UART in one go when the
+ * far end isn't reading; must be more than a pseudo-terminal
+ * will hold, so that the write blocks.
+ */
+# define U_LINUX_PORT_TEST_UART_WRITE_LENGTH_BYTES (1024 * 256)
+#endif
+
+/* ----------------------------------------------------------------
+ * TYPES
+ * -------------------------------------------------------------- */
+
+/* ----------------------------------------------------------------
+ * VARIABLES
+ * -------------------------------------------------------------- */
+
+/** Buffer for data to and from a UART.
+ */
+static char gUartBuffer[U_LINUX_PORT_TEST_UART_BUFFER_LENGTH_BYTES];
+
+/** Buffer of data to write to a UART that will block.
+ */
+static char gUartWriteBuffer[U_LINUX_PORT_TEST_UART_WRITE_LENGTH_BYTES];
+
+/** The handle of the UART that the tasks below use.
+ */
+static int32_t gUartHandle = -1;
+
+/** The return value of uPortUartWrite() in uartWriteTask(),
+ * INT32_MIN while the write has not returned.
+ */
+static volatile int32_t gUartWriteResult = INT32_MIN;
+
+/** The return value of uPortUartRead() in uartReadTask(),
+ * INT32_MIN while the read has not returned.
+ */
+static volatile int32_t gUartReadResult = INT32_MIN;
+
+/* ----------------------------------------------------------------
+ * STATIC FUNCTIONS
+ * -------------------------------------------------------------- */
+
+// Open a pseudo-terminal and a UART on its slave side, returning
+// the file descriptor of the master side.
+static int openPtyUart(int32_t *pUartHandle)
+{
+    int fd = posix_openpt(O_RDWR | O_NOCTTY);
+
+    *pUartHandle = -1;
+    if ((fd >= 0) && (grantpt(fd) == 0) && (unlockpt(fd) == 0) &&
+        (uPortUartPrefix(ptsname(fd)) == 0)) {
+        // The name of the slave is the whole of the prefix
+        *pUartHandle = uPortUartOpen(-1, 115200, NULL,
+                                     U_LINUX_PORT_TEST_UART_BUFFER_LENGTH_BYTES,
+                                     -1, -1, -1, -1);
+    }
+
+    return fd;
+}
+
+// Wait for the given number of bytes to be waiting at a UART,
+// returning the number that are.
+static int32_t uartWaitReceive(int32_t uartHandle, int32_t sizeBytes)
+{
+    int32_t startTimeMs = uPortGetTickTimeMs();
+    int32_t x = uPortUartGetReceiveSize(uartHandle);
+
+    while ((x < sizeBytes) &&
+           (uPortGetTickTimeMs() - startTimeMs < U_LINUX_PORT_TEST_UART_WAIT_MS)) {
+        uPortTaskBlock(10);
+        x = uPortUartGetReceiveSize(uartHandle);
+    }
+
+    return x;
+}
+
+// Task to write a lot of data to a UART.
+static void uartWriteTask(void *pParameters)
+{
+    (void) pParameters;
+
+    gUartWriteResult = uPortUartWrite(gUartHandle, gUartWriteBuffer,
+                                      sizeof(gUartWriteBuffer));
+    uPortTaskDelete(NULL);
+}
+
+// Task to read from a UART.
+static void uartReadTask(void *pParameters)
+{
+    (void) pParameters;
+
+    gUartReadResult = uPortUartRead(gUartHandle, gUartBuffer,
+                                    sizeof(gUartBuffer));
+    uPortTaskDelete(NULL);
+}
+
+/* ----------------------------------------------------------------
+ * PUBLIC FUNCTIONS: TESTS
+ * -------------------------------------------------------------- */
+
+/** A queue on Linux is a pipe, which will take more than the length
+ * of the queue: send to one until the pipe is full and check that
+ * a send failing does not upset what can be received.
+ */
+U_PORT_TEST_FUNCTION("[linuxPort]", "linuxPortQueueFull")
+{
+    int32_t resourceCount;
+    uPortQueueHandle_t queueHandle = NULL;
+    int32_t item;
+    int32_t numItems = 0;
+    int32_t errorCode = 0;
+
+    // Whatever called us likely initialised the
+    // port so deinitialise it here to obtain the
+    // correct initial heap size
+    uPortDeinit();
+    resourceCount = uTestUtilGetDynamicResourceCount();
+    U_PORT_TEST_ASSERT(uPortInit() == 0);
+
+    U_PORT_TEST_ASSERT(uPortQueueCreate(U_LINUX_PORT_TEST_QUEUE_LENGTH,
+                                        sizeof(item), &queueHandle) == 0);
+    while ((errorCode == 0) && (numItems < U_LINUX_PORT_TEST_QUEUE_ITEMS_MAX)) {
+        item = numItems;
+        errorCode = uPortQueueSend(queueHandle, &item);
+        if (errorCode == 0) {
+            numItems++;
+        }
+    }
+    U_TEST_PRINT_LINE("%d item(s) sent before the queue was full (%d).",
+                      numItems, errorCode);
+    U_PORT_TEST_ASSERT(errorCode < 0);
+
+    // Everything that was sent must come out, in order, and nothing else
+    for (int32_t x = 0; x < numItems; x++) {
+        item = -1;
+        errorCode = uPortQueueTryReceive(queueHandle, 100, &item);
+        if ((errorCode != 0) || (item != x)) {
+            U_TEST_PRINT_LINE("item %d: receive returned %d, item %d.",
+                              x, errorCode, item);
+        }
+        U_PORT_TEST_ASSERT(errorCode == 0);
+        U_PORT_TEST_ASSERT(item == x);
+    }
+    U_PORT_TEST_ASSERT(uPortQueueTryReceive(queueHandle, 10, &item) < 0);
+
+    // The queue should still work
+    item = 0x5a;
+    U_PORT_TEST_ASSERT(uPortQueueSend(queueHandle, &item) == 0);
+    item = 0;
+    U_PORT_TEST_ASSERT(uPortQueueTryReceive(queueHandle, 100, &item) == 0);
+    U_PORT_TEST_ASSERT(item == 0x5a);
+
+    U_PORT_TEST_ASSERT(uPortQueueDelete(queueHandle) == 0);
+
+    uPortDeinit();
+
+    // Check for resource leaks
+    uTestUtilResourceCheck(U_TEST_PREFIX, NULL, true);
+    resourceCount = uTestUtilGetDynamicResourceCount() - resourceCount;
+    U_TEST_PRINT_LINE("we have leaked %d resources(s).", resourceCount);
+    U_PORT_TEST_ASSERT(resourceCount <= 0);
+}
+
+/** Send to a UART exactly as much as its receive buffer holds, so
+ * that the write position wraps around onto the read position, and
+ * check that it all arrives; then do the same from a read position
+ * part-way through the buffer.
+ */
+U_PORT_TEST_FUNCTION("[linuxPort]", "linuxPortUartWrap")
+{
+    int32_t resourceCount;
+    int32_t uartHandle;
+    int fd;
+    char buffer[U_LINUX_PORT_TEST_UART_BUFFER_LENGTH_BYTES];
+    size_t offset = sizeof(buffer) / 3;
+    int32_t x;
+
+    // Whatever called us likely initialised the
+    // port so deinitialise it here to obtain the
+    // correct initial heap size
+    uPortDeinit();
+    resourceCount = uTestUtilGetDynamicResourceCount();
+    U_PORT_TEST_ASSERT(uPortInit() == 0);
+
+    fd = openPtyUart(&uartHandle);
+    U_PORT_TEST_ASSERT(fd >= 0);
+    U_PORT_TEST_ASSERT(uartHandle >= 0);
+
+    for (size_t y = 0; y < sizeof(gUartBuffer); y++) {
+        gUartBuffer[y] = (char) y;
+    }
+
+    // From the start of the buffer
+    U_PORT_TEST_ASSERT(write(fd, gUartBuffer, sizeof(gUartBuffer)) == sizeof(gUartBuffer));
+    x = uartWaitReceive(uartHandle, sizeof(gUartBuffer));
+    U_TEST_PRINT_LINE("%d byte(s) received of %d.", x, sizeof(gUartBuffer));
+    U_PORT_TEST_ASSERT(x == sizeof(gUartBuffer));
+    memset(buffer, 0, sizeof(buffer));
+    U_PORT_TEST_ASSERT(uPortUartRead(uartHandle, buffer, sizeof(buffer)) == sizeof(buffer));
+    U_PORT_TEST_ASSERT(memcmp(buffer, gUartBuffer, sizeof(buffer)) == 0);
+
+    // Move the read position on and do it again
+    U_PORT_TEST_ASSERT(write(fd, gUartBuffer, offset) == offset);
+    U_PORT_TEST_ASSERT(uartWaitReceive(uartHandle, offset) == offset);
+    U_PORT_TEST_ASSERT(uPortUartRead(uartHandle, buffer, offset) == offset);
+    U_PORT_TEST_ASSERT(write(fd, gUartBuffer, sizeof(gUartBuffer)) == sizeof(gUartBuffer));
+    x = uartWaitReceive(uartHandle, sizeof(gUartBuffer));
+    U_TEST_PRINT_LINE("%d byte(s) received of %d.", x, sizeof(gUartBuffer));
+    U_PORT_TEST_ASSERT(x == sizeof(gUartBuffer));
+    memset(buffer, 0, sizeof(buffer));
+    U_PORT_TEST_ASSERT(uPortUartRead(uartHandle, buffer, sizeof(buffer)) == sizeof(buffer));
+    U_PORT_TEST_ASSERT(memcmp(buffer, gUartBuffer, sizeof(buffer)) == 0);
+
+    uPortUartClose(uartHandle);
+    close(fd);
+
+    uPortDeinit();
+
+    // Check for resource leaks
+    uTestUtilResourceCheck(U_TEST_PREFIX, NULL, true);
+    resourceCount = uTestUtilGetDynamicResourceCount() - resourceCount;
+    U_TEST_PRINT_LINE("we have leaked %d resources(s).", resourceCount);
+    U_PORT_TEST_ASSERT(resourceCount <= 0);
+}
+
+/** Check that a write to a UART that is blocked, because the far
+ * end is not reading, does not stop data being read from that UART.
+ */
+U_PORT_TEST_FUNCTION("[linuxPort]", "linuxPortUartWriteBlocked")
+{
+    int32_t resourceCount;
+    int fd;
+    uPortTaskHandle_t taskHandle;
+    const char *pMessage = "hello";
+    size_t messageLength = strlen(pMessage);
+    char buffer[U_LINUX_PORT_TEST_UART_BUFFER_LENGTH_BYTES];
+    int32_t startTimeMs;
+    bool readWhileWriteBlocked;
+    size_t bytesDrained = 0;
+    int x;
+
+    // Whatever called us likely initialised the
+    // port so deinitialise it here to obtain the
+    // correct initial heap size
+    uPortDeinit();
+    resourceCount = uTestUtilGetDynamicResourceCount();
+    U_PORT_TEST_ASSERT(uPortInit() == 0);
+
+    fd = openPtyUart(&gUartHandle);
+    U_PORT_TEST_ASSERT(fd >= 0);
+    U_PORT_TEST_ASSERT(gUartHandle >= 0);
+    gUartWriteResult = INT32_MIN;
+    gUartReadResult = INT32_MIN;
+
+    // Get something waiting to be read
+    U_PORT_TEST_ASSERT(write(fd, pMessage, messageLength) == messageLength);
+    U_PORT_TEST_ASSERT(uartWaitReceive(gUartHandle, messageLength) == messageLength);
+
+    // Start a write that will block since nothing is reading the far end
+    U_PORT_TEST_ASSERT(uPortTaskCreate(uartWriteTask, "uartWriteTask",
+                                       U_CFG_TEST_OS_TASK_STACK_SIZE_BYTES,
+                                       NULL, U_CFG_TEST_OS_TASK_PRIORITY,
+                                       &taskHandle) == 0);
+    uPortTaskBlock(200);
+    U_PORT_TEST_ASSERT(gUartWriteResult == INT32_MIN);
+
+    // Read what was waiting
+    U_PORT_TEST_ASSERT(uPortTaskCreate(uartReadTask, "uartReadTask",
+                                       U_CFG_TEST_OS_TASK_STACK_SIZE_BYTES,
+                                       NULL, U_CFG_TEST_OS_TASK_PRIORITY,
+                                       &taskHandle) == 0);
+    startTimeMs = uPortGetTickTimeMs();
+    while ((gUartReadResult == INT32_MIN) &&
+           (uPortGetTickTimeMs() - startTimeMs < U_LINUX_PORT_TEST_UART_WAIT_MS)) {
+        uPortTaskBlock(10);
+    }
+    readWhileWriteBlocked = (gUartReadResult != INT32_MIN);
+    U_TEST_PRINT_LINE("read %s while the write was blocked (%d).",
+                      readWhileWriteBlocked ? "returned" : "did NOT return",
+                      gUartReadResult);
+
+    // Unblock the write, whatever happened, so that the tasks end,
+    // and collect everything it wrote; don't block in read() as
+    // the write may have completed but not yet returned
+    U_PORT_TEST_ASSERT(fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK) == 0);
+    while ((gUartWriteResult == INT32_MIN) || (bytesDrained < gUartWriteResult)) {
+        x = read(fd, buffer, sizeof(buffer));
+        if (x > 0) {
+            bytesDrained += x;
+        } else {
+            uPortTaskBlock(10);
+        }
+    }
+    U_TEST_PRINT_LINE("write returned %d, %d byte(s) received.",
+                      gUartWriteResult, bytesDrained);
+    while (gUartReadResult == INT32_MIN) {
+        uPortTaskBlock(10);
+    }
+    // Let the tasks finish deleting themselves
+    uPortTaskBlock(U_CFG_OS_YIELD_MS + 100);
+
+    U_PORT_TEST_ASSERT(readWhileWriteBlocked);
+    U_PORT_TEST_ASSERT(gUartReadResult == messageLength);
+    U_PORT_TEST_ASSERT(memcmp(gUartBuffer, pMessage, messageLength) == 0);
+    U_PORT_TEST_ASSERT(gUartWriteResult == sizeof(gUartWriteBuffer));
+    U_PORT_TEST_ASSERT(bytesDrained == sizeof(gUartWriteBuffer));
+
+    uPortUartClose(gUartHandle);
+    gUartHandle = -1;
+    close(fd);
+
+    uPortDeinit();
+
+    // Check for resource leaks
+    uTestUtilResourceCheck(U_TEST_PREFIX, NULL, true);
+    resourceCount = uTestUtilGetDynamicResourceCount() - resourceCount;
+    U_TEST_PRINT_LINE("we have leaked %d resources(s).", resourceCount);
+    U_PORT_TEST_ASSERT(resourceCount <= 0);
+}
+
+// End of file
@@ -86,6 +86,7 @@
 #include <u_ringbuffer.h>
 #include <u_linked_list.h>
 #include <u_time.h>
+#include <u_crc.h>
 #include <u_debug_utils.h>
 #include <u_at_client.h>
 #include <u_security.h>
@@ -145,9 +146,21 @@
 #include <u_gnss_dec.h>
 #include <u_gnss_dec_ubx_nav_pvt.h>
 #include <u_gnss_dec_ubx_nav_hpposllh.h>
+#include <u_gnss_dec_ubx_nav_dop.h>
+#include <u_gnss_dec_ubx_nav_status.h>
+#include <u_gnss_dec_ubx_nav_timeutc.h>
+#include <u_gnss_dec_ubx_nav_sat.h>
+#include <u_gnss_dec_ubx_nav_sig.h>
+#include <u_gnss_dec_ubx_esf_meas.h>
+#include <u_gnss_dec_ubx_rxm_rawx.h>
+#include <u_gnss_dec_ubx_mon_rf.h>
 #include <u_gnss_mga.h>
 #include <u_gnss_geofence.h>
 #include <u_gnss_util.h>
+#include <u_gnss_framer.h>
+#include <u_gnss_raw.h>
+#include <u_gnss_nmea.h>
+#include <u_gnss_rtcm.h>
 #include <u_wifi.h>
 #include <u_wifi_cfg.h>
 #include <u_wifi_mqtt.h>